@@ -0,0 +1,98 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#ifndef SENSOR_PROCESSOR_ABSTRACT_PIPELINE_H
+#define SENSOR_PROCESSOR_ABSTRACT_PIPELINE_H
+
+#include <typeinfo>
+#include <boost/shared_ptr.hpp>
+
+namespace sensor_processor
+{
+  class LatencyTracer;
+
+  /**
+   * @class AbstractPipeline Type-erased handle to a typed pipeline, kept by
+   * the Handler next to the AbstractProcessor pointers
+   */
+  class AbstractPipeline
+  {
+   public:
+    virtual
+    ~AbstractPipeline() {}
+
+    /**
+      * @brief Type of the message the pipeline's preprocessor subscribes to
+      */
+    virtual const std::type_info&
+    getInputType() const = 0;
+
+   protected:
+    AbstractPipeline() {}
+  };
+
+  typedef boost::shared_ptr<AbstractPipeline> AbstractPipelinePtr;
+
+  /**
+   * @class InputPipeline Pipeline entry point for a given subscribed type
+   */
+  template <class Input>
+  class InputPipeline : public AbstractPipeline
+  {
+   public:
+    virtual const std::type_info&
+    getInputType() const
+    {
+      return typeid(Input);
+    }
+
+    /**
+      * @brief Runs preprocess, process and postprocess on a frame
+      * @param input [const boost::shared_ptr<Input const>&] subscribed message
+      * @param failedStage [const char**] set to the name of the stage that
+      * returned false, if any
+      * @param tracer [LatencyTracer*] records the stage calls, may be NULL
+      * @return [bool] whether all stages succeeded
+      */
+    virtual bool
+    process(const boost::shared_ptr<Input const>& input, const char** failedStage,
+        LatencyTracer* tracer) = 0;
+  };
+}  // namespace sensor_processor
+
+#endif  // SENSOR_PROCESSOR_ABSTRACT_PIPELINE_H
@@ -40,6 +40,7 @@
 #ifndef SENSOR_PROCESSOR_ABSTRACT_PROCESSOR_H
 #define SENSOR_PROCESSOR_ABSTRACT_PROCESSOR_H
 
+#include <stdint.h>
 #include <string>
 #include <boost/any.hpp>
 #include <boost/shared_ptr.hpp>
@@ -56,6 +57,29 @@ namespace sensor_processor
         boost::shared_ptr<boost::any> output) = 0;
     virtual void
     initialize(const std::string& ns, Handler* handler) = 0;
+    /**
+      * @brief Called when a processor kept warm by a DynamicHandler becomes
+      * one of the handler's stages again
+      */
+    virtual void
+    activate() {}
+    /**
+      * @brief Called when a processor kept warm by a DynamicHandler stops
+      * being one of the handler's stages; it should stop producing input
+      */
+    virtual void
+    park() {}
+    /**
+      * @brief Takes a serialized input message as if it had arrived on one of
+      * the processor's input topics; only preprocessors take input
+      * @param md5sum [const std::string&] MD5 sum of the message's type
+      * @return [bool] false if the processor does not take such messages
+      */
+    virtual bool
+    feedSerialized(const std::string& md5sum, uint8_t* data, uint32_t size)
+    {
+      return false;
+    }
     virtual
     ~AbstractProcessor() {};
 
@@ -0,0 +1,185 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#ifndef SENSOR_PROCESSOR_BOUNDED_QUEUE_H
+#define SENSOR_PROCESSOR_BOUNDED_QUEUE_H
+
+#include <deque>
+#include <string>
+#include <boost/cstdint.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace sensor_processor
+{
+  /**
+   * @brief What a BoundedQueue does when an item is pushed while it is full
+   */
+  enum OverflowPolicy
+  {
+    LATEST_WINS,  //!< discard everything queued, keep only the new item
+    BLOCK,  //!< wait until the consumer makes room
+    DROP_OLDEST  //!< discard the oldest queued item
+  };
+
+  /**
+    * @brief Parses an overflow policy as given in a parameter server
+    * @param policy [const std::string&] one of "latest_wins", "block" or
+    * "drop_oldest"
+    * @param defaultPolicy [OverflowPolicy] returned if policy is not recognized
+    */
+  inline OverflowPolicy
+  overflowPolicyFromString(const std::string& policy, OverflowPolicy defaultPolicy)
+  {
+    if (policy == "latest_wins")
+      return LATEST_WINS;
+    if (policy == "block")
+      return BLOCK;
+    if (policy == "drop_oldest")
+      return DROP_OLDEST;
+    return defaultPolicy;
+  }
+
+  /**
+   * @class BoundedQueue Thread safe FIFO of fixed capacity which connects two
+   * pipeline stages. Keeps count of the items it had to drop on overflow.
+   */
+  template <class T>
+  class BoundedQueue
+  {
+   public:
+    BoundedQueue(size_t capacity, OverflowPolicy policy) :
+      capacity_(capacity > 0 ? capacity : 1), policy_(policy),
+      dropped_(0), closed_(false) {}
+
+    /**
+      * @brief Enqueues an item, applying the overflow policy if full
+      * @return [bool] false if the queue has been closed
+      */
+    bool
+    push(const T& item)
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      if (policy_ == BLOCK)
+      {
+        while (!closed_ && queue_.size() >= capacity_)
+          notFull_.wait(lock);
+      }
+      if (closed_)
+        return false;
+      if (queue_.size() >= capacity_)
+      {
+        if (policy_ == LATEST_WINS)
+        {
+          dropped_ += queue_.size();
+          queue_.clear();
+        }
+        else
+        {
+          dropped_ += 1;
+          queue_.pop_front();
+        }
+      }
+      queue_.push_back(item);
+      lock.unlock();
+      notEmpty_.notify_one();
+      return true;
+    }
+
+    /**
+      * @brief Dequeues the oldest item, waiting for one if empty
+      * @return [bool] false if the queue has been closed
+      */
+    bool
+    pop(T* item)
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      while (!closed_ && queue_.empty())
+        notEmpty_.wait(lock);
+      if (closed_)
+        return false;
+      *item = queue_.front();
+      queue_.pop_front();
+      lock.unlock();
+      notFull_.notify_one();
+      return true;
+    }
+
+    /**
+      * @brief Wakes up and releases every producer and consumer; queued items
+      * are discarded
+      */
+    void
+    close()
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      closed_ = true;
+      queue_.clear();
+      lock.unlock();
+      notEmpty_.notify_all();
+      notFull_.notify_all();
+    }
+
+    size_t
+    size() const
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      return queue_.size();
+    }
+
+    boost::uint64_t
+    getDropped() const
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      return dropped_;
+    }
+
+   private:
+    mutable boost::mutex mutex_;
+    boost::condition_variable notEmpty_;
+    boost::condition_variable notFull_;
+    std::deque<T> queue_;
+
+    size_t capacity_;
+    OverflowPolicy policy_;
+    boost::uint64_t dropped_;
+    bool closed_;
+  };
+}  // namespace sensor_processor
+
+#endif  // SENSOR_PROCESSOR_BOUNDED_QUEUE_H
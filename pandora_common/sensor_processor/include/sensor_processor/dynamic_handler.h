@@ -41,6 +41,7 @@
 
 #include <string>
 #include <map>
+#include <typeinfo>
 #include <vector>
 
 #include <ros/ros.h>
@@ -51,6 +52,7 @@
 
 #include "sensor_processor/handler.h"
 #include "sensor_processor/abstract_processor.h"
+#include "sensor_processor/typed_pipeline.h"
 
 namespace sensor_processor
 {
@@ -97,6 +99,17 @@ namespace sensor_processor
     void
     unloadPostProcessor();
 
+    /**
+      * @brief Chains the currently loaded stages into a typed pipeline, so that
+      * frames are passed between them without boost::any boxing. The template
+      * arguments must be the concrete types the stages were loaded with.
+      */
+    template <class PreProcessor, class Processor, class PostProcessor>
+    void
+    loadPipeline();
+    void
+    unloadPipeline();
+
    protected:
     /**
       * @brief Function that performs all the needed procedures when the robot's
@@ -121,6 +134,62 @@ namespace sensor_processor
     loadProcessor(AbstractProcessorPtr& processorPtr,
                   const std::string& processor_name, const std::string& processor_type);
 
+    /**
+      * @brief Constructs and parks a processor in the warm pool, if not
+      * already there. Plugin processors are put under their own namespace,
+      * the slot's namespace followed by their type (see warmNamespace)
+      * @param name [const std::string&] namespace of the processor's slot
+      */
+    template <class AnyProcessor>
+    void
+    warmUp(const std::string& processor_name);
+    void
+    warmUp(const std::string& processor_name, const std::string& processor_type);
+
+    /**
+      * @brief Logs and records how long a state transition took
+      */
+    void
+    reportTransition(const ros::WallTime& begin);
+
+   private:
+    /**
+      * @brief Makes a processor a stage, parking the one it replaces if the
+      * warm pool is enabled. A newly initialized processor is already active
+      */
+    void
+    replaceStage(AbstractProcessorPtr* stagePtr, const AbstractProcessorPtr& processorPtr);
+
+    /**
+      * @brief Makes a warm processor a stage
+      * @return [bool] false if the pool does not hold such a processor
+      */
+    bool
+    activateWarm(AbstractProcessorPtr* stagePtr, const std::string& key);
+
+    /**
+      * @brief Returns the namespace of a warm plugin processor, i.e. the
+      * slot's namespace followed by the processor's type, so that processors
+      * sharing a slot do not share dynamic_reconfigure servers and topics
+      * @param processor_name [const std::string&] namespace of the slot
+      * @param processor_type [const std::string&] plugin type
+      */
+    static std::string
+    warmNamespace(const std::string& processor_name, const std::string& processor_type);
+
+    /**
+      * @brief Records that a warm processor lives in a namespace, breaks if
+      * a processor of another type already lives there
+      */
+    void
+    claimNamespace(const std::string& processor_ns, const std::string& key);
+
+    /**
+      * @brief Creates a processor through pluginlib, breaks on failure
+      */
+    AbstractProcessorPtr
+    createProcessor(const std::string& processor_type);
+
    protected:
     //!< States in which node is active
     std::vector<std::string> activeStates_;
@@ -128,6 +197,16 @@ namespace sensor_processor
     int currentState_;
     int previousState_;
 
+    //!< Whether handlers with statically known stages should chain them
+    //!< through a typed pipeline
+    bool typedPipeline_;
+
+    //!< Whether processors are constructed once and parked, instead of
+    //!< destroyed, when the robot leaves the states they are used in. Plugin
+    //!< processors then read their parameters from their warm namespace,
+    //!< e.g. ~processor/pkg_Type for the plugin pkg/Type
+    bool warmPool_;
+
    private:
     //!< Plugin PostProcessor loader
     boost::shared_ptr< pluginlib::ClassLoader<AbstractProcessor> > processor_loader_ptr_;
@@ -137,6 +216,11 @@ namespace sensor_processor
     std::string previousPreProcessorType_;
     std::string previousProcessorType_;
     std::string previousPostProcessorType_;
+
+    //!< Warm processors, keyed by plugin type (or C++ type for templated loads)
+    std::map<std::string, AbstractProcessorPtr> warmProcessors_;
+    //!< Key of the warm processor living in each namespace
+    std::map<std::string, std::string> warmNamespaces_;
   };
 }  // namespace sensor_processor
 
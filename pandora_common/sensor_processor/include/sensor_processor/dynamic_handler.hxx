@@ -39,7 +39,9 @@
 #ifndef SENSOR_PROCESSOR_DYNAMIC_HANDLER_HXX
 #define SENSOR_PROCESSOR_DYNAMIC_HANDLER_HXX
 
+#include <cctype>
 #include <string>
+#include <typeinfo>
 #include <vector>
 
 #include <ros/ros.h>
@@ -53,7 +55,7 @@ namespace sensor_processor
 {
 
   DynamicHandler::
-  DynamicHandler() {}
+  DynamicHandler() : typedPipeline_(true), warmPool_(false) {}
 
   DynamicHandler::
   ~DynamicHandler() {}
@@ -85,6 +87,9 @@ namespace sensor_processor
       activeStates_.push_back(static_cast<std::string>(active_states[ii]));
     }
 
+    private_nh_.param("typed_pipeline", typedPipeline_, true);
+    private_nh_.param("warm_pool", warmPool_, false);
+
     bool load;
     private_nh_.param("load_processors", load, false);
 
@@ -108,6 +113,13 @@ namespace sensor_processor
         }
         state_to_processor_map_.insert(std::make_pair(
               ROBOT_STATES(activeStates_[ii]), processors_of_state));
+
+        if (warmPool_)
+        {
+          warmUp("~preprocessor", processors_of_state[0]);
+          warmUp("~processor", processors_of_state[1]);
+          warmUp("~postprocessor", processors_of_state[2]);
+        }
       }
     }
   }
@@ -117,8 +129,16 @@ namespace sensor_processor
   DynamicHandler::
   loadPreProcessor(const std::string& processor_name)
   {
-    this->preProcPtr_.reset( new PreProcessor );
-    this->preProcPtr_->initialize(processor_name, this);
+    unloadPipeline();
+    if (activateWarm(&this->preProcPtr_, typeid(PreProcessor).name()))
+      return;
+    if (warmPool_)
+      claimNamespace(processor_name, typeid(PreProcessor).name());
+    AbstractProcessorPtr processorPtr( new PreProcessor );
+    replaceStage(&this->preProcPtr_, processorPtr);
+    processorPtr->initialize(processor_name, this);
+    if (warmPool_)
+      warmProcessors_[typeid(PreProcessor).name()] = processorPtr;
   }
 
   void
@@ -142,7 +162,8 @@ namespace sensor_processor
   DynamicHandler::
   unloadPreProcessor()
   {
-    this->preProcPtr_.reset();
+    unloadPipeline();
+    replaceStage(&this->preProcPtr_, AbstractProcessorPtr());
   }
 
   template <class Processor>
@@ -150,8 +171,16 @@ namespace sensor_processor
   DynamicHandler::
   loadProcessor(const std::string& processor_name)
   {
-    this->processorPtr_.reset( new Processor );
-    this->processorPtr_->initialize(processor_name, this);
+    unloadPipeline();
+    if (activateWarm(&this->processorPtr_, typeid(Processor).name()))
+      return;
+    if (warmPool_)
+      claimNamespace(processor_name, typeid(Processor).name());
+    AbstractProcessorPtr processorPtr( new Processor );
+    replaceStage(&this->processorPtr_, processorPtr);
+    processorPtr->initialize(processor_name, this);
+    if (warmPool_)
+      warmProcessors_[typeid(Processor).name()] = processorPtr;
   }
 
   void
@@ -175,7 +204,8 @@ namespace sensor_processor
   DynamicHandler::
   unloadProcessor()
   {
-    this->processorPtr_.reset();
+    unloadPipeline();
+    replaceStage(&this->processorPtr_, AbstractProcessorPtr());
   }
 
   template <class PostProcessor>
@@ -183,8 +213,16 @@ namespace sensor_processor
   DynamicHandler::
   loadPostProcessor(const std::string& processor_name)
   {
-    this->postProcPtr_.reset( new PostProcessor );
-    this->postProcPtr_->initialize(processor_name, this);
+    unloadPipeline();
+    if (activateWarm(&this->postProcPtr_, typeid(PostProcessor).name()))
+      return;
+    if (warmPool_)
+      claimNamespace(processor_name, typeid(PostProcessor).name());
+    AbstractProcessorPtr processorPtr( new PostProcessor );
+    replaceStage(&this->postProcPtr_, processorPtr);
+    processorPtr->initialize(processor_name, this);
+    if (warmPool_)
+      warmProcessors_[typeid(PostProcessor).name()] = processorPtr;
   }
 
   void
@@ -208,13 +246,31 @@ namespace sensor_processor
   DynamicHandler::
   unloadPostProcessor()
   {
-    this->postProcPtr_.reset();
+    unloadPipeline();
+    replaceStage(&this->postProcPtr_, AbstractProcessorPtr());
+  }
+
+  template <class PreProcessor, class Processor, class PostProcessor>
+  void
+  DynamicHandler::
+  loadPipeline()
+  {
+    this->pipelinePtr_.reset( new TypedPipeline<PreProcessor, Processor, PostProcessor>(
+          this->preProcPtr_, this->processorPtr_, this->postProcPtr_) );
+  }
+
+  void
+  DynamicHandler::
+  unloadPipeline()
+  {
+    this->pipelinePtr_.reset();
   }
 
   void
   DynamicHandler::
   startTransition(int newState)
   {
+    ros::WallTime begin = ros::WallTime::now();
     this->previousState_ = this->currentState_;
     this->currentState_ = newState;
 
@@ -259,6 +315,7 @@ namespace sensor_processor
       return;
     }
 
+    reportTransition(begin);
     transitionComplete(this->currentState_);
   }
 
@@ -266,15 +323,127 @@ namespace sensor_processor
   DynamicHandler::
   completeTransition() {}
 
+  void
+  DynamicHandler::
+  reportTransition(const ros::WallTime& begin)
+  {
+    double duration = (ros::WallTime::now() - begin).toSec();
+    setTransitionDuration(duration);
+    ROS_INFO("[%s] Transition to %s took %.3f ms", name_.c_str(),
+        ROBOT_STATES(this->currentState_).c_str(), duration * 1000);
+  }
+
   void
   DynamicHandler::
   loadProcessor(AbstractProcessorPtr& processorPtr,
                 const std::string& processor_name, const std::string& processor_type)
   {
+    unloadPipeline();
+    if (activateWarm(&processorPtr, processor_type))
+      return;
+    AbstractProcessorPtr newProcessorPtr = createProcessor(processor_type);
+    replaceStage(&processorPtr, newProcessorPtr);
+    if (warmPool_)
+    {
+      std::string processor_ns = warmNamespace(processor_name, processor_type);
+      claimNamespace(processor_ns, processor_type);
+      newProcessorPtr->initialize(processor_ns, this);
+      warmProcessors_[processor_type] = newProcessorPtr;
+    }
+    else
+    {
+      newProcessorPtr->initialize(processor_name, this);
+    }
+  }
+
+  template <class AnyProcessor>
+  void
+  DynamicHandler::
+  warmUp(const std::string& processor_name)
+  {
+    std::string key = typeid(AnyProcessor).name();
+    if (warmProcessors_.count(key) > 0)
+      return;
+    claimNamespace(processor_name, key);
+    AbstractProcessorPtr processorPtr( new AnyProcessor );
+    processorPtr->initialize(processor_name, this);
+    processorPtr->park();
+    warmProcessors_[key] = processorPtr;
+  }
+
+  void
+  DynamicHandler::
+  warmUp(const std::string& processor_name, const std::string& processor_type)
+  {
+    if (warmProcessors_.count(processor_type) > 0)
+      return;
+    std::string processor_ns = warmNamespace(processor_name, processor_type);
+    claimNamespace(processor_ns, processor_type);
+    AbstractProcessorPtr processorPtr = createProcessor(processor_type);
+    processorPtr->initialize(processor_ns, this);
+    processorPtr->park();
+    warmProcessors_[processor_type] = processorPtr;
+  }
+
+  void
+  DynamicHandler::
+  replaceStage(AbstractProcessorPtr* stagePtr, const AbstractProcessorPtr& processorPtr)
+  {
+    if (warmPool_ && *stagePtr && *stagePtr != processorPtr)
+      (*stagePtr)->park();
+    setStage(stagePtr, processorPtr);
+  }
+
+  bool
+  DynamicHandler::
+  activateWarm(AbstractProcessorPtr* stagePtr, const std::string& key)
+  {
+    if (!warmPool_)
+      return false;
+    std::map<std::string, AbstractProcessorPtr>::iterator it = warmProcessors_.find(key);
+    if (it == warmProcessors_.end())
+      return false;
+    if (*stagePtr != it->second)
+      it->second->activate();
+    replaceStage(stagePtr, it->second);
+    return true;
+  }
+
+  std::string
+  DynamicHandler::
+  warmNamespace(const std::string& processor_name, const std::string& processor_type)
+  {
+    std::string name = processor_type;
+    for (int ii = 0; ii < name.size(); ++ii)
+    {
+      if (!isalnum(name[ii]))
+        name[ii] = '_';
+    }
+    return processor_name + "/" + name;
+  }
+
+  void
+  DynamicHandler::
+  claimNamespace(const std::string& processor_ns, const std::string& key)
+  {
+    std::map<std::string, std::string>::iterator it = warmNamespaces_.find(processor_ns);
+    if (it != warmNamespaces_.end() && it->second != key)
+    {
+      ROS_FATAL("[%s] Two different processors cannot be kept warm in %s",
+          name_.c_str(), processor_ns.c_str());
+      ROS_BREAK();
+    }
+    warmNamespaces_[processor_ns] = key;
+  }
+
+  AbstractProcessorPtr
+  DynamicHandler::
+  createProcessor(const std::string& processor_type)
+  {
+    AbstractProcessorPtr processorPtr;
     try
     {
       processorPtr = processor_loader_ptr_->createInstance(processor_type);
-      processorPtr->initialize(processor_name, this);
     }
     catch (const pluginlib::PluginlibException& ex)
     {
@@ -283,6 +452,7 @@ namespace sensor_processor
                 "Exception: %s", name_.c_str(), processor_type.c_str(), ex.what());
       ROS_BREAK();
     }
+    return processorPtr;
   }
 
 }  // namespace sensor_processor
@@ -42,12 +42,17 @@
 
 #include <string>
 #include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include <ros/ros.h>
 #include <ros/forwards.h>
 
 #include "state_manager/state_client_nodelet.h"
 
+#include "sensor_processor/abstract_pipeline.h"
 #include "sensor_processor/abstract_processor.h"
+#include "sensor_processor/latency_tracer.h"
+#include "sensor_processor/pipelined_executor.h"
+#include "sensor_processor/DumpTrace.h"
 
 namespace sensor_processor
 {
@@ -65,14 +70,69 @@ namespace sensor_processor
     void
     completeProcessCallback(const boost::shared_ptr<SubType const>& subscribedTypePtr);
 
+    /**
+      * @brief Hands a serialized message to the preprocessor, as if it had
+      * arrived on one of its input topics, so that bags can be replayed
+      * through the handler in-process
+      * @param md5sum [const std::string&] MD5 sum of the message's type
+      * @return [bool] false if no preprocessor is loaded or it does not take
+      * messages of this type
+      */
+    bool
+    feedSerializedInput(const std::string& md5sum, uint8_t* data, uint32_t size);
+
+    /**
+      * @brief Stage latency statistics, NULL if tracing is disabled
+      */
+    const LatencyTracerPtr&
+    getLatencyTracer() const;
+
    private:
     void
     completeProcessFinish(bool success, const std::string& logInfo);
 
+    /**
+      * @brief Thread safe access to the stages, used by the pipelined workers
+      * @param stage [int] 0: preprocessor, 1: processor, 2: postprocessor
+      */
+    AbstractProcessorPtr
+    getStage(int stage);
+
+    /**
+      * @brief Publishes the rolling latency percentiles of the stages
+      */
+    void
+    publishLatencyReport(const ros::WallTimerEvent& event);
+
+    /**
+      * @brief Dumps the latest stage events as a Chrome trace JSON file
+      */
+    bool
+    dumpTraceCallback(DumpTrace::Request& request, DumpTrace::Response& response);
+
+   protected:
+    /**
+      * @brief Replaces one of the stage pointers below, safely with respect
+      * to the pipelined workers
+      */
+    void
+    setStage(AbstractProcessorPtr* stagePtr, const AbstractProcessorPtr& processorPtr);
+
+    /**
+      * @brief Records how long the latest state transition took, for the
+      * latency report
+      */
+    void
+    setTransitionDuration(double seconds);
+
    protected:
     AbstractProcessorPtr preProcPtr_;
     AbstractProcessorPtr processorPtr_;
     AbstractProcessorPtr postProcPtr_;
+    //!< Typed chain of the above stages, used instead of them if set
+    AbstractPipelinePtr pipelinePtr_;
+    //!< Guards replacing the stages while pipelined workers may read them
+    boost::mutex stagesMutex_;
 
     ros::NodeHandle nh_;
     ros::NodeHandle private_nh_;
@@ -80,6 +140,15 @@ namespace sensor_processor
 
    private:
     ros::Publisher operation_report_;
+    //!< Set if the stages run on their own threads (param 'pipelined')
+    boost::shared_ptr<PipelinedExecutor> executorPtr_;
+
+    //!< Set if stage latencies are traced (param 'latency_tracing')
+    LatencyTracerPtr tracerPtr_;
+    ros::Publisher latency_report_;
+    ros::WallTimer latency_report_timer_;
+    ros::ServiceServer dump_trace_service_;
+    double transitionDuration_;
   };
 }  // namespace sensor_processor
 
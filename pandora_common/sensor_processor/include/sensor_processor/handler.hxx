@@ -41,9 +41,14 @@
 #define SENSOR_PROCESSOR_HANDLER_HXX
 
 #include <string>
+#include <typeinfo>
 #include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+
+#include <ros/message_traits.h>
 
 #include "sensor_processor/ProcessorLogInfo.h"
+#include "sensor_processor/ProcessorLatencyInfo.h"
 #include "sensor_processor/handler.h"
 #include "sensor_processor/processor_error.h"
 
@@ -51,7 +56,7 @@ namespace sensor_processor
 {
 
   Handler::
-  Handler() {}
+  Handler() : transitionDuration_(0) {}
 
   void
   Handler::
@@ -68,13 +73,58 @@ namespace sensor_processor
     private_nh_.param<std::string>("op_report_topic", reportTopicName, "processor_log");
     operation_report_ = private_nh_.advertise<ProcessorLogInfo>(reportTopicName, 1);
 
-    clientInitialize();
+    bool tracing;
+    private_nh_.param("latency_tracing", tracing, true);
+    if (tracing)
+    {
+      int window, traceSize;
+      double reportRate;
+      std::string latencyTopicName;
+      private_nh_.param("latency_window", window, 300);
+      private_nh_.param("trace_buffer_size", traceSize, 10000);
+      private_nh_.param("latency_report_rate", reportRate, 1.0);
+      private_nh_.param<std::string>("latency_report_topic", latencyTopicName, "processor_latency");
+      tracerPtr_.reset( new LatencyTracer(window, traceSize) );
+      if (reportRate > 0)
+      {
+        latency_report_ = private_nh_.advertise<ProcessorLatencyInfo>(latencyTopicName, 1);
+        latency_report_timer_ = private_nh_.createWallTimer(ros::WallDuration(1.0 / reportRate),
+            &Handler::publishLatencyReport, this);
+      }
+      dump_trace_service_ = private_nh_.advertiseService("dump_trace",
+          &Handler::dumpTraceCallback, this);
+    }
+
+    bool pipelined;
+    private_nh_.param("pipelined", pipelined, false);
+    if (pipelined)
+    {
+      int queueSize;
+      std::string overflowPolicy;
+      private_nh_.param("pipeline_queue_size", queueSize, 1);
+      private_nh_.param<std::string>("pipeline_overflow_policy", overflowPolicy, "latest_wins");
+      executorPtr_.reset( new PipelinedExecutor(
+            boost::bind(&Handler::getStage, this, _1),
+            boost::bind(&Handler::completeProcessFinish, this, _1, _2),
+            tracerPtr_.get(), queueSize, overflowPolicyFromString(overflowPolicy, LATEST_WINS)) );
+      ROS_INFO("[%s] Running pipelined, queue size %d, %s policy",
+          name_.c_str(), queueSize, overflowPolicy.c_str());
+    }
+
+    // Handlers run outside the state manager (e.g. by the batch runner)
+    // neither register nor report initialization
+    bool registerClient;
+    private_nh_.param("register_client", registerClient, true);
+    if (registerClient)
+      clientInitialize();
     ROS_INFO("[%s] initialized", name_.c_str());
   }
 
   Handler::
   ~Handler()
   {
+    // Workers must be joined before the stages they use are destroyed
+    executorPtr_.reset();
     ROS_INFO("[%s] terminated", name_.c_str());
   }
 
@@ -83,6 +133,36 @@ namespace sensor_processor
       const boost::shared_ptr<SubType const>& subscribedTypePtr)
   {
     bool success = true;  //!< checker for success of operations
+    LatencyTracer* tracer = tracerPtr_.get();
+
+    if (tracer)
+    {
+      const ros::Time* stamp = ros::message_traits::TimeStamp<SubType>::pointer(*subscribedTypePtr);
+      if (stamp != NULL && !stamp->isZero())
+        tracer->recordInputAge((ros::Time::now() - *stamp).toSec());
+    }
+
+    if (executorPtr_)
+    {
+      executorPtr_->push(boost::shared_ptr<boost::any>( new boost::any(subscribedTypePtr) ));
+      return;
+    }
+
+    if (pipelinePtr_ && pipelinePtr_->getInputType() == typeid(SubType))
+    {
+      const char* failedStage = "finished";
+      try {
+        success = static_cast<InputPipeline<SubType>&>(*pipelinePtr_).process(
+            subscribedTypePtr, &failedStage, tracer);
+      }
+      catch (processor_error& e) {
+        completeProcessFinish(false, e.what());
+        return;
+      }
+      completeProcessFinish(success, failedStage);
+      return;
+    }
+
     boost::shared_ptr<boost::any> subTypePtr( new boost::any(subscribedTypePtr) );
     boost::shared_ptr<boost::any> processorInputPtr( new boost::any );
     boost::shared_ptr<boost::any> processorOutputPtr( new boost::any );
@@ -90,6 +170,7 @@ namespace sensor_processor
 
     // First a preprocessing operation happens
     try {
+      ScopedStageTimer timer(tracer, TRACE_PRE_PROCESSOR);
       success = preProcPtr_->process(subTypePtr, processorInputPtr);
     }
     catch (processor_error& e) {
@@ -102,6 +183,7 @@ namespace sensor_processor
     }
 
     try {
+      ScopedStageTimer timer(tracer, TRACE_PROCESSOR);
       success = processorPtr_->process(processorInputPtr, processorOutputPtr);
     }
     catch (processor_error& e) {
@@ -114,6 +196,7 @@ namespace sensor_processor
     }
 
     try {
+      ScopedStageTimer timer(tracer, TRACE_POST_PROCESSOR);
       success = postProcPtr_->process(processorOutputPtr, processorResultPtr);
     }
     catch (processor_error& e) {
@@ -123,12 +206,84 @@ namespace sensor_processor
     completeProcessFinish(success, "finished");
   }
 
+  bool
+  Handler::
+  feedSerializedInput(const std::string& md5sum, uint8_t* data, uint32_t size)
+  {
+    AbstractProcessorPtr preProcessor = getStage(0);
+    return preProcessor && preProcessor->feedSerialized(md5sum, data, size);
+  }
+
   void Handler::completeProcessFinish(bool success, const std::string& logInfo)
   {
     ProcessorLogInfoPtr processorLogInfo( new ProcessorLogInfo );
     processorLogInfo->success = success;
     processorLogInfo->logInfo = logInfo;
-    operation_report_.publish(processorLogInfo);
+    if (executorPtr_)
+      executorPtr_->getQueueStatistics(&processorLogInfo->queueDepth,
+          &processorLogInfo->queueDrops);
+    if (operation_report_)
+      operation_report_.publish(processorLogInfo);
+  }
+
+  void
+  Handler::
+  setStage(AbstractProcessorPtr* stagePtr, const AbstractProcessorPtr& processorPtr)
+  {
+    boost::mutex::scoped_lock lock(stagesMutex_);
+    *stagePtr = processorPtr;
+  }
+
+  void
+  Handler::
+  publishLatencyReport(const ros::WallTimerEvent& event)
+  {
+    ProcessorLatencyInfoPtr latencyInfo( new ProcessorLatencyInfo );
+    latencyInfo->header.stamp = ros::Time::now();
+    tracerPtr_->fillReport(latencyInfo.get());
+    latencyInfo->transitionDuration = transitionDuration_;
+    latency_report_.publish(latencyInfo);
+  }
+
+  bool
+  Handler::
+  dumpTraceCallback(DumpTrace::Request& request, DumpTrace::Response& response)
+  {
+    response.success = tracerPtr_->dumpChromeTrace(request.filename);
+    response.message = response.success ? "Trace written to " + request.filename :
+      "Could not write " + request.filename;
+    ROS_INFO("[%s] %s", name_.c_str(), response.message.c_str());
+    return true;
+  }
+
+  const LatencyTracerPtr&
+  Handler::
+  getLatencyTracer() const
+  {
+    return tracerPtr_;
+  }
+
+  void
+  Handler::
+  setTransitionDuration(double seconds)
+  {
+    transitionDuration_ = seconds;
+  }
+
+  AbstractProcessorPtr
+  Handler::
+  getStage(int stage)
+  {
+    boost::mutex::scoped_lock lock(stagesMutex_);
+    switch (stage)
+    {
+      case 0:
+        return preProcPtr_;
+      case 1:
+        return processorPtr_;
+      default:
+        return postProcPtr_;
+    }
   }
 }  // namespace sensor_processor
 
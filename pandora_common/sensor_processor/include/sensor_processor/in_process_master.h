@@ -0,0 +1,195 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+
+#ifndef SENSOR_PROCESSOR_IN_PROCESS_MASTER_H
+#define SENSOR_PROCESSOR_IN_PROCESS_MASTER_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <XmlRpc.h>
+
+namespace sensor_processor
+{
+  /**
+   * @class InProcessMaster Serves the ROS master API from inside the process,
+   * so that roscpp code such as a handler nodelet can be run without a
+   * rosmaster. It keeps the parameters and the registrations of the process
+   * in memory; nobody else connects to it, so topics are only ever connected
+   * within the process.
+   */
+  class InProcessMaster
+  {
+   public:
+    InProcessMaster();
+    ~InProcessMaster();
+
+    /**
+      * @brief Listens on a free local port and serves requests on a thread
+      * of its own
+      * @return [bool] false if no port could be bound
+      */
+    bool
+    start();
+
+    /**
+      * @brief Stops serving, the master cannot be started again
+      */
+    void
+    shutdown();
+
+    /**
+      * @brief URI to give to roscpp as ROS_MASTER_URI
+      */
+    std::string
+    getUri() const;
+
+   private:
+    typedef void (InProcessMaster::*Call)(XmlRpc::XmlRpcValue& params,
+        XmlRpc::XmlRpcValue& result);
+
+    /**
+      * @class Method Dispatches an XML-RPC method to a member of the master
+      */
+    class Method : public XmlRpc::XmlRpcServerMethod
+    {
+     public:
+      Method(const std::string& name, Call call, InProcessMaster* master);
+      void
+      execute(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+
+     private:
+      Call call_;
+      InProcessMaster* master_;
+    };
+
+    //!< Callers' XML-RPC URIs, keyed by caller id
+    typedef std::map<std::string, std::string> Callers;
+
+    void
+    serve();
+
+    void
+    getPid(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    getMasterUri(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    lookupNode(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+
+    void
+    registerPublisher(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    unregisterPublisher(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    registerSubscriber(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    unregisterSubscriber(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    getTopicTypes(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    getSystemState(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+
+    void
+    registerService(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    unregisterService(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    lookupService(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+
+    void
+    getParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    setParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    hasParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    deleteParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    searchParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    subscribeParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    unsubscribeParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+    void
+    getParamNames(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result);
+
+    /**
+      * @brief Finds a parameter, NULL if it is not set
+      */
+    XmlRpc::XmlRpcValue*
+    findParam(const std::string& key);
+
+    static std::vector<std::string>
+    splitKey(const std::string& key);
+
+    static void
+    collectParamNames(const std::string& prefix, XmlRpc::XmlRpcValue& value,
+        XmlRpc::XmlRpcValue* names);
+
+    static XmlRpc::XmlRpcValue
+    makeUriList(const Callers& callers);
+
+    static void
+    reply(XmlRpc::XmlRpcValue& result, int code, const std::string& status,
+        const XmlRpc::XmlRpcValue& value);
+
+   private:
+    XmlRpc::XmlRpcServer server_;
+    std::vector< boost::shared_ptr<Method> > methods_;
+    boost::thread thread_;
+    volatile bool running_;
+    int port_;
+
+    //!< Guards everything below, which the XML-RPC thread changes
+    boost::mutex mutex_;
+    XmlRpc::XmlRpcValue params_;
+    Callers nodes_;
+    std::map<std::string, Callers> publishers_;
+    std::map<std::string, Callers> subscribers_;
+    std::map<std::string, std::string> topicTypes_;
+    //!< Service URI and provider's caller id, keyed by service
+    std::map<std::string, std::pair<std::string, std::string> > services_;
+  };
+}  // namespace sensor_processor
+
+#endif  // SENSOR_PROCESSOR_IN_PROCESS_MASTER_H
@@ -0,0 +1,256 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#ifndef SENSOR_PROCESSOR_LATENCY_TRACER_H
+#define SENSOR_PROCESSOR_LATENCY_TRACER_H
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <boost/array.hpp>
+#include <boost/circular_buffer.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <ros/ros.h>
+
+#include "sensor_processor/ProcessorLatencyInfo.h"
+
+namespace sensor_processor
+{
+  /**
+   * @brief Quantities a LatencyTracer keeps statistics for. Stages keep the
+   * indices used by the PipelinedExecutor.
+   */
+  enum TracedQuantity
+  {
+    TRACE_PRE_PROCESSOR = 0,
+    TRACE_PROCESSOR = 1,
+    TRACE_POST_PROCESSOR = 2,
+    TRACE_INPUT_AGE = 3,
+    TRACE_COUNT = 4
+  };
+
+  /**
+   * @class LatencyTracer Records the wall time of every stage call and the age
+   * of each input, keeps rolling windows of them for percentile reports and
+   * a bounded log of stage events that can be dumped as a Chrome trace.
+   * Safe to use from the pipelined workers.
+   */
+  class LatencyTracer
+  {
+   public:
+    /**
+      * @param window [size_t] number of latest samples percentiles are computed on
+      * @param traceSize [size_t] number of latest stage events kept for
+      * dumping, 0 disables the event log
+      */
+    LatencyTracer(size_t window, size_t traceSize);
+
+    /**
+      * @brief Records a call of a stage, which run from begin to end
+      */
+    void
+    recordStage(int stage, const ros::WallTime& begin, const ros::WallTime& end);
+
+    /**
+      * @brief Records how old an input was when it reached the handler
+      */
+    void
+    recordInputAge(double seconds);
+
+    /**
+      * @brief Fills a report with p50/p95/p99/max of the current windows
+      */
+    void
+    fillReport(ProcessorLatencyInfo* report) const;
+
+    /**
+      * @brief Writes the event log in Chrome trace event JSON format, which
+      * chrome://tracing and Perfetto can open
+      * @return [bool] false if the file could not be written
+      */
+    bool
+    dumpChromeTrace(const std::string& filename) const;
+
+   private:
+    struct TraceEvent
+    {
+      int stage;
+      ros::WallTime begin;
+      ros::WallTime end;
+    };
+
+    static const char*
+    getName(int quantity);
+
+   private:
+    mutable boost::mutex mutex_;
+    boost::array<boost::circular_buffer<double>, TRACE_COUNT> windows_;
+    boost::circular_buffer<TraceEvent> events_;
+  };
+
+  /**
+   * @class ScopedStageTimer Records the lifetime of the enclosing scope as a
+   * stage call. Does nothing if no tracer is given.
+   */
+  class ScopedStageTimer
+  {
+   public:
+    ScopedStageTimer(LatencyTracer* tracer, int stage) :
+      tracer_(tracer), stage_(stage)
+    {
+      if (tracer_)
+        begin_ = ros::WallTime::now();
+    }
+
+    ~ScopedStageTimer()
+    {
+      if (tracer_)
+        tracer_->recordStage(stage_, begin_, ros::WallTime::now());
+    }
+
+   private:
+    LatencyTracer* tracer_;
+    int stage_;
+    ros::WallTime begin_;
+  };
+
+  typedef boost::shared_ptr<LatencyTracer> LatencyTracerPtr;
+
+  inline const char*
+  LatencyTracer::
+  getName(int quantity)
+  {
+    static const char* const names[TRACE_COUNT] =
+      {"pre_processor", "processor", "post_processor", "input_age"};
+    return names[quantity];
+  }
+
+  inline
+  LatencyTracer::
+  LatencyTracer(size_t window, size_t traceSize) :
+    events_(traceSize)
+  {
+    for (int ii = 0; ii < TRACE_COUNT; ++ii)
+      windows_[ii].set_capacity(window > 0 ? window : 1);
+  }
+
+  inline void
+  LatencyTracer::
+  recordStage(int stage, const ros::WallTime& begin, const ros::WallTime& end)
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    windows_[stage].push_back((end - begin).toSec());
+    if (events_.capacity() > 0)
+    {
+      TraceEvent event;
+      event.stage = stage;
+      event.begin = begin;
+      event.end = end;
+      events_.push_back(event);
+    }
+  }
+
+  inline void
+  LatencyTracer::
+  recordInputAge(double seconds)
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    windows_[TRACE_INPUT_AGE].push_back(seconds);
+  }
+
+  inline void
+  LatencyTracer::
+  fillReport(ProcessorLatencyInfo* report) const
+  {
+    report->stages.resize(TRACE_COUNT);
+    std::vector<double> samples;
+    for (int ii = 0; ii < TRACE_COUNT; ++ii) {
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        samples.assign(windows_[ii].begin(), windows_[ii].end());
+      }
+      StageLatency& stage = report->stages[ii];
+      stage.name = getName(ii);
+      stage.samples = samples.size();
+      if (samples.empty())
+      {
+        stage.p50 = stage.p95 = stage.p99 = stage.max = 0;
+        continue;
+      }
+      std::sort(samples.begin(), samples.end());
+      size_t last = samples.size() - 1;
+      stage.p50 = samples[last * 50 / 100];
+      stage.p95 = samples[last * 95 / 100];
+      stage.p99 = samples[last * 99 / 100];
+      stage.max = samples[last];
+    }
+  }
+
+  inline bool
+  LatencyTracer::
+  dumpChromeTrace(const std::string& filename) const
+  {
+    std::vector<TraceEvent> events;
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      events.assign(events_.begin(), events_.end());
+    }
+
+    std::ofstream file(filename.c_str());
+    if (!file.is_open())
+      return false;
+
+    file << "{\"traceEvents\":[";
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    for (size_t ii = 0; ii < events.size(); ++ii) {
+      // Timestamps and durations are in microseconds
+      file << (ii == 0 ? "" : ",") << "\n{\"name\":\"" << getName(events[ii].stage)
+           << "\",\"cat\":\"sensor_processor\",\"ph\":\"X\",\"pid\":0,\"tid\":"
+           << events[ii].stage
+           << ",\"ts\":" << events[ii].begin.toNSec() / 1000.0
+           << ",\"dur\":" << (events[ii].end - events[ii].begin).toNSec() / 1000.0 << "}";
+    }
+    file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return file.good();
+  }
+}  // namespace sensor_processor
+
+#endif  // SENSOR_PROCESSOR_LATENCY_TRACER_H
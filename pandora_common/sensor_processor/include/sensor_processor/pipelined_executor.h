@@ -0,0 +1,191 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#ifndef SENSOR_PROCESSOR_PIPELINED_EXECUTOR_H
+#define SENSOR_PROCESSOR_PIPELINED_EXECUTOR_H
+
+#include <string>
+#include <vector>
+#include <boost/any.hpp>
+#include <boost/array.hpp>
+#include <boost/bind.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+#include "sensor_processor/abstract_processor.h"
+#include "sensor_processor/bounded_queue.h"
+#include "sensor_processor/latency_tracer.h"
+#include "sensor_processor/processor_error.h"
+
+namespace sensor_processor
+{
+  /**
+   * @class PipelinedExecutor Runs preprocessor, processor and postprocessor
+   * each on its own worker thread, joined by bounded queues, so that stage N
+   * of frame k overlaps stage N-1 of frame k+1.
+   */
+  class PipelinedExecutor
+  {
+   public:
+    typedef boost::shared_ptr<boost::any> AnyPtr;
+    //!< Returns the processor currently loaded for a stage (0: pre, 1: main, 2: post)
+    typedef boost::function<AbstractProcessorPtr (int)> StageGetter;
+    //!< Called from the worker threads whenever a frame leaves the pipeline
+    typedef boost::function<void (bool, const std::string&)> FinishCallback;
+
+    static const int NUM_STAGES = 3;
+
+   public:
+    /**
+      * @param tracer [LatencyTracer*] records the stage calls, may be NULL;
+      * must outlive the executor
+      */
+    PipelinedExecutor(const StageGetter& getStage, const FinishCallback& finish,
+        LatencyTracer* tracer, size_t queueSize, OverflowPolicy policy);
+    ~PipelinedExecutor();
+
+    /**
+      * @brief Hands a subscribed message to the preprocessing worker
+      * @param input [const AnyPtr&] the message, boxed as the preprocessor expects it
+      */
+    void
+    push(const AnyPtr& input);
+
+    /**
+      * @brief Current depth and number of frames dropped so far, per stage queue
+      */
+    void
+    getQueueStatistics(std::vector<boost::uint32_t>* depths,
+        std::vector<boost::uint64_t>* drops) const;
+
+   private:
+    void
+    stageLoop(int stage);
+
+   private:
+    StageGetter getStage_;
+    FinishCallback finish_;
+    LatencyTracer* tracer_;
+
+    //!< queues_[ii] feeds the worker of stage ii
+    boost::array<boost::shared_ptr< BoundedQueue<AnyPtr> >, NUM_STAGES> queues_;
+    boost::thread_group workers_;
+  };
+
+  inline
+  PipelinedExecutor::
+  PipelinedExecutor(const StageGetter& getStage, const FinishCallback& finish,
+      LatencyTracer* tracer, size_t queueSize, OverflowPolicy policy) :
+    getStage_(getStage), finish_(finish), tracer_(tracer)
+  {
+    for (int ii = 0; ii < NUM_STAGES; ++ii)
+      queues_[ii].reset( new BoundedQueue<AnyPtr>(queueSize, policy) );
+    for (int ii = 0; ii < NUM_STAGES; ++ii)
+      workers_.create_thread(boost::bind(&PipelinedExecutor::stageLoop, this, ii));
+  }
+
+  inline
+  PipelinedExecutor::
+  ~PipelinedExecutor()
+  {
+    for (int ii = 0; ii < NUM_STAGES; ++ii)
+      queues_[ii]->close();
+    workers_.join_all();
+  }
+
+  inline void
+  PipelinedExecutor::
+  push(const AnyPtr& input)
+  {
+    queues_[0]->push(input);
+  }
+
+  inline void
+  PipelinedExecutor::
+  getQueueStatistics(std::vector<boost::uint32_t>* depths,
+      std::vector<boost::uint64_t>* drops) const
+  {
+    depths->resize(NUM_STAGES);
+    drops->resize(NUM_STAGES);
+    for (int ii = 0; ii < NUM_STAGES; ++ii) {
+      (*depths)[ii] = queues_[ii]->size();
+      (*drops)[ii] = queues_[ii]->getDropped();
+    }
+  }
+
+  inline void
+  PipelinedExecutor::
+  stageLoop(int stage)
+  {
+    static const char* failLogInfo[NUM_STAGES] = {"pre_processor", "processor", "finished"};
+
+    AnyPtr input;
+    while (queues_[stage]->pop(&input))
+    {
+      AbstractProcessorPtr processor = getStage_(stage);
+      // The stage has been unloaded by a state transition, drop the frame
+      if (!processor)
+        continue;
+
+      AnyPtr output( new boost::any );
+      bool success;
+      try {
+        ScopedStageTimer timer(tracer_, stage);
+        success = processor->process(input, output);
+      }
+      catch (processor_error& e) {
+        finish_(false, e.what());
+        continue;
+      }
+      if (!success)
+      {
+        finish_(false, failLogInfo[stage]);
+        continue;
+      }
+
+      if (stage + 1 < NUM_STAGES)
+        queues_[stage + 1]->push(output);
+      else
+        finish_(true, "finished");
+    }
+  }
+}  // namespace sensor_processor
+
+#endif  // SENSOR_PROCESSOR_PIPELINED_EXECUTOR_H
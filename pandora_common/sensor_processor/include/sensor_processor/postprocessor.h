@@ -57,6 +57,9 @@ namespace sensor_processor
     typedef boost::shared_ptr<Output> OutputPtr;
 
    public:
+    typedef Input InputType;
+    typedef Output OutputType;
+
     PostProcessor(const std::string& ns, Handler* handler)
     {
       initialize(ns, handler);
@@ -74,13 +77,32 @@ namespace sensor_processor
 
       ros::NodeHandle private_nh = handler->getPrivateNh();
 
-      std::string outputTopic;
-      if (!private_nh.getParam("published_topics", outputTopic))
+      if (!private_nh.getParam("published_topics", outputTopic_))
       {
         ROS_FATAL("[%s] 'published_topics:' param not found", this->getName().c_str());
         ROS_BREAK();
       }
-      nPublisher_ = this->getPublicNodeHandle().template advertise<Output>(outputTopic, 1);
+      nPublisher_ = this->getPublicNodeHandle().template advertise<Output>(outputTopic_, 1);
+    }
+
+    /**
+      * @brief Advertises the output topic again, unless already advertised
+      */
+    virtual void
+    activate()
+    {
+      if (!nPublisher_)
+        nPublisher_ = this->getPublicNodeHandle().template advertise<Output>(outputTopic_, 1);
+    }
+
+    /**
+      * @brief Unadvertises the output topic, so that a parked postprocessor
+      * does not keep it advertised next to the active one
+      */
+    virtual void
+    park()
+    {
+      nPublisher_.shutdown();
     }
 
     bool
@@ -100,15 +122,29 @@ namespace sensor_processor
         ROS_BREAK();
       }
 
-      bool success = postProcess(in, out);
-      if (success)
+      return postProcessAndPublish(in, out);
+    }
+
+    /**
+      * @brief Runs the postprocessing step and publishes its output on
+      * success. Used both by the type-erased and the typed pipeline.
+      * @param input [const InputConstPtr&] processor's result
+      * @param output [const OutputPtr&] message to fill and publish
+      * @return [bool] whether postprocessing succeeded
+      */
+    bool
+    postProcessAndPublish(const InputConstPtr& input, const OutputPtr& output)
+    {
+      bool success = postProcess(input, output);
+      if (success && nPublisher_)
       {
-        nPublisher_.publish(out);
+        nPublisher_.publish(output);
       }
       return success;
     }
 
    private:
+    std::string outputTopic_;
     ros::Publisher nPublisher_;
   };
 }  // namespace sensor_processor
@@ -44,6 +44,7 @@
 #include <vector>
 
 #include <boost/shared_ptr.hpp>
+#include <ros/serialization.h>
 #include "sensor_processor/general_processor.h"
 #include "sensor_processor/handler.h"
 
@@ -58,12 +59,15 @@ namespace sensor_processor
     typedef boost::shared_ptr<Output> OutputPtr;
 
    public:
+    typedef Input InputType;
+    typedef Output OutputType;
+
     PreProcessor(const std::string& ns, Handler* handler)
     {
       initialize(ns, handler);
     }
 
-    PreProcessor() {}
+    PreProcessor() : handler_(NULL) {}
 
     virtual bool
     preProcess(const InputConstPtr& input, const OutputPtr& output) = 0;
@@ -82,20 +86,16 @@ namespace sensor_processor
         ROS_BREAK();
       }
 
+      inputTopics_.clear();
       if (inputTopics.getType() == XmlRpc::XmlRpcValue::TypeString)
       {
-        nSubscribers_.push_back(this->getPublicNodeHandle().subscribe(
-              static_cast<std::string>(inputTopics), 1,
-              static_cast<void(Handler::*)(const InputConstPtr&)>(&Handler::completeProcessCallback),
-              handler));
+        inputTopics_.push_back(static_cast<std::string>(inputTopics));
       }
       else if (inputTopics.getType() == XmlRpc::XmlRpcValue::TypeArray)
       {
         for (int ii = 0; ii < inputTopics.size(); ii++) {
           ROS_ASSERT(inputTopics[ii].getType() == XmlRpc::XmlRpcValue::TypeString);
-          nSubscribers_.push_back(this->getPublicNodeHandle().subscribe(inputTopics[ii], 1,
-            static_cast<void(Handler::*)(const InputConstPtr&)>(&Handler::completeProcessCallback),
-            handler));
+          inputTopics_.push_back(static_cast<std::string>(inputTopics[ii]));
         }
       }
       else
@@ -104,6 +104,52 @@ namespace sensor_processor
           "or a list of strings (many topics)!", this->getName().c_str());
         ROS_ASSERT(false);
       }
+
+      handler_ = handler;
+      activate();
+    }
+
+    /**
+      * @brief Subscribes to the input topics, unless already subscribed
+      */
+    virtual void
+    activate()
+    {
+      if (!nSubscribers_.empty())
+        return;
+      for (int ii = 0; ii < inputTopics_.size(); ii++) {
+        nSubscribers_.push_back(this->getPublicNodeHandle().subscribe(inputTopics_[ii], 1,
+          static_cast<void(Handler::*)(const InputConstPtr&)>(&Handler::completeProcessCallback),
+          handler_));
+      }
+    }
+
+    /**
+      * @brief Unsubscribes from the input topics, so that a parked preprocessor
+      * does not feed the handler
+      */
+    virtual void
+    park()
+    {
+      for (int ii = 0; ii < nSubscribers_.size(); ii++)
+        nSubscribers_[ii].shutdown();
+      nSubscribers_.clear();
+    }
+
+    /**
+      * @brief Deserializes an input message and hands it to the handler, as
+      * if it had arrived on one of the input topics
+      */
+    virtual bool
+    feedSerialized(const std::string& md5sum, uint8_t* data, uint32_t size)
+    {
+      if (handler_ == NULL || md5sum != ros::message_traits::md5sum<Input>())
+        return false;
+      InputPtr input( new Input );
+      ros::serialization::IStream stream(data, size);
+      ros::serialization::deserialize(stream, *input);
+      handler_->completeProcessCallback<Input>(InputConstPtr(input));
+      return true;
     }
 
     bool
@@ -127,6 +173,8 @@ namespace sensor_processor
     }
 
    private:
+    std::vector<std::string> inputTopics_;
+    Handler* handler_;
     std::vector<ros::Subscriber> nSubscribers_;
   };
 }  // namespace sensor_processor
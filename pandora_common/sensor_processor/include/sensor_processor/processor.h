@@ -57,6 +57,9 @@ namespace sensor_processor
     typedef boost::shared_ptr<Output> OutputPtr;
 
    public:
+    typedef Input InputType;
+    typedef Output OutputType;
+
     Processor(const std::string& ns, Handler* handler)
     {
       initialize(ns, handler);
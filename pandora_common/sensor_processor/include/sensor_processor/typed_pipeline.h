@@ -0,0 +1,150 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#ifndef SENSOR_PROCESSOR_TYPED_PIPELINE_H
+#define SENSOR_PROCESSOR_TYPED_PIPELINE_H
+
+#include <boost/shared_ptr.hpp>
+
+#include "sensor_processor/abstract_pipeline.h"
+#include "sensor_processor/abstract_processor.h"
+#include "sensor_processor/latency_tracer.h"
+#include "sensor_processor/preprocessor.h"
+#include "sensor_processor/processor.h"
+#include "sensor_processor/postprocessor.h"
+
+namespace sensor_processor
+{
+  /**
+   * @class TypedPipeline Chains the stages of a handler whose processor types
+   * are known at compile time. Outputs are handed from stage to stage through
+   * slots that are reused across frames, so no boost::any boxing or any_cast
+   * happens per frame. A slot is reallocated only when someone else still
+   * holds the previous frame's object (e.g. an intraprocess subscriber).
+   */
+  template <class PreProc, class Proc, class PostProc>
+  class TypedPipeline : public InputPipeline<typename PreProc::InputType>
+  {
+   public:
+    typedef typename PreProc::InputType Input;
+    typedef typename PreProc::OutputType PreProcOutput;
+    typedef typename Proc::OutputType ProcOutput;
+    typedef typename PostProc::OutputType PostProcOutput;
+
+   private:
+    typedef PreProcessor<Input, PreProcOutput> PreProcessorType;
+    typedef Processor<PreProcOutput, ProcOutput> ProcessorType;
+    typedef PostProcessor<ProcOutput, PostProcOutput> PostProcessorType;
+
+   public:
+    TypedPipeline(const AbstractProcessorPtr& preProcPtr,
+        const AbstractProcessorPtr& processorPtr,
+        const AbstractProcessorPtr& postProcPtr) :
+      preProcPtr_(boost::static_pointer_cast<PreProc>(preProcPtr)),
+      processorPtr_(boost::static_pointer_cast<Proc>(processorPtr)),
+      postProcPtr_(boost::static_pointer_cast<PostProc>(postProcPtr)),
+      preProcOutput_(new PreProcOutput),
+      procOutput_(new ProcOutput),
+      postProcOutput_(new PostProcOutput)
+    {}
+
+    virtual bool
+    process(const boost::shared_ptr<Input const>& input, const char** failedStage,
+        LatencyTracer* tracer)
+    {
+      bool success;
+      {
+        ScopedStageTimer timer(tracer, TRACE_PRE_PROCESSOR);
+        success = preProcPtr_->preProcess(input, acquire(preProcOutput_));
+      }
+      if (!success)
+      {
+        *failedStage = "pre_processor";
+        return false;
+      }
+      {
+        ScopedStageTimer timer(tracer, TRACE_PROCESSOR);
+        success = processorPtr_->process(preProcOutput_, acquire(procOutput_));
+      }
+      if (!success)
+      {
+        *failedStage = "processor";
+        return false;
+      }
+      {
+        ScopedStageTimer timer(tracer, TRACE_POST_PROCESSOR);
+        success = postProcPtr_->postProcessAndPublish(procOutput_, acquire(postProcOutput_));
+      }
+      if (!success)
+      {
+        *failedStage = "finished";
+        return false;
+      }
+      return true;
+    }
+
+   private:
+    /**
+      * @brief Prepares a slot for the next frame: the object is reset in place
+      * if nobody else references it, otherwise a fresh one is allocated
+      */
+    template <class T>
+    static const boost::shared_ptr<T>&
+    acquire(boost::shared_ptr<T>& slot)
+    {
+      if (slot.unique())
+        *slot = T();
+      else
+        slot.reset(new T);
+      return slot;
+    }
+
+   private:
+    // Held through the generic stage interfaces, whose typed entry points
+    // are public even if a concrete processor redeclares them privately.
+    boost::shared_ptr<PreProcessorType> preProcPtr_;
+    boost::shared_ptr<ProcessorType> processorPtr_;
+    boost::shared_ptr<PostProcessorType> postProcPtr_;
+
+    boost::shared_ptr<PreProcOutput> preProcOutput_;
+    boost::shared_ptr<ProcOutput> procOutput_;
+    boost::shared_ptr<PostProcOutput> postProcOutput_;
+  };
+}  // namespace sensor_processor
+
+#endif  // SENSOR_PROCESSOR_TYPED_PIPELINE_H
@@ -0,0 +1,420 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+/**
+ * Offline batch runner for sensor_processor handlers.
+ *
+ * Loads a handler nodelet by its plugin name, configures it from the same
+ * YAML files its launch file loads, and reads every message of a bag on the
+ * handler's subscribed topics, handing each one straight to the handler's
+ * preprocessor, one frame at a time and as fast as the handler can process
+ * them. Reports frames per second and per-stage latency percentiles and
+ * records everything the handler publishes to an output bag.
+ *
+ * No roscore needs to be running: the parameters and registrations the
+ * handler makes are served by an InProcessMaster, and no message is sent
+ * over the network, which keeps the runner usable in CI.
+ *
+ * Example:
+ *   rosrun sensor_processor sensor_processor_batch_runner
+ *     --handler pandora_vision/pandora_vision_qrcode
+ *     --config `rospack find pandora_vision_qrcode`/config/qrcode_topics.yaml
+ *     --config `rospack find pandora_vision_qrcode`/config/qrcode_params.yaml:detector
+ *     --bag qr_run.bag --output qr_alerts.bag
+ */
+
+#include <stdint.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/foreach.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/program_options.hpp>
+#include <boost/shared_ptr.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <ros/serialization.h>
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <topic_tools/shape_shifter.h>
+#include <nodelet/nodelet.h>
+#include <pluginlib/class_loader.h>
+
+#include "sensor_processor/handler.h"
+#include "sensor_processor/in_process_master.h"
+#include "sensor_processor/ProcessorLogInfo.h"
+#include "sensor_processor/ProcessorLatencyInfo.h"
+
+namespace po = boost::program_options;
+
+namespace sensor_processor
+{
+  /**
+    * @brief Converts a YAML document to the XmlRpc representation used by the
+    * parameter server
+    */
+  XmlRpc::XmlRpcValue
+  yamlToXmlRpc(const YAML::Node& node)
+  {
+    XmlRpc::XmlRpcValue value;
+    if (node.IsMap())
+    {
+      for (YAML::const_iterator it = node.begin(); it != node.end(); ++it)
+        value[it->first.as<std::string>()] = yamlToXmlRpc(it->second);
+    }
+    else if (node.IsSequence())
+    {
+      value.setSize(node.size());
+      for (size_t ii = 0; ii < node.size(); ++ii)
+        value[ii] = yamlToXmlRpc(node[ii]);
+    }
+    else if (node.IsScalar())
+    {
+      // Try the narrowest type first, as rosparam does
+      std::string scalar = node.as<std::string>();
+      try { return XmlRpc::XmlRpcValue(boost::lexical_cast<int>(scalar)); }
+      catch (boost::bad_lexical_cast&) {}
+      try { return XmlRpc::XmlRpcValue(boost::lexical_cast<double>(scalar)); }
+      catch (boost::bad_lexical_cast&) {}
+      if (scalar == "true" || scalar == "True")
+        return XmlRpc::XmlRpcValue(true);
+      if (scalar == "false" || scalar == "False")
+        return XmlRpc::XmlRpcValue(false);
+      return XmlRpc::XmlRpcValue(scalar);
+    }
+    return value;
+  }
+
+  /**
+   * @class BatchRunner Drives a single handler nodelet with messages from a bag
+   */
+  class BatchRunner
+  {
+   public:
+    BatchRunner(const std::string& handlerType, const std::string& name) :
+      handlerType_(handlerType), name_(name),
+      nodeletLoader_("nodelet", "nodelet::Nodelet"),
+      outputs_(0), succeeded_(0), failed_(0)
+    {
+      nh_.setCallbackQueue(&queue_);
+    }
+
+    /**
+      * @brief Loads a YAML file under the handler's private namespace
+      * @param ns [const std::string&] sub-namespace, like rosparam's ns attribute
+      */
+    void
+    loadConfig(const std::string& filename, const std::string& ns)
+    {
+      std::string target = "/" + name_ + (ns.empty() ? "" : "/" + ns);
+      YAML::Node doc = YAML::LoadFile(filename);
+      XmlRpc::XmlRpcValue params = yamlToXmlRpc(doc);
+      if (params.getType() != XmlRpc::XmlRpcValue::TypeStruct)
+      {
+        ROS_FATAL("[BatchRunner] %s does not contain a dictionary", filename.c_str());
+        ROS_BREAK();
+      }
+      for (XmlRpc::XmlRpcValue::iterator it = params.begin(); it != params.end(); ++it)
+        ros::param::set(target + "/" + it->first, it->second);
+    }
+
+    /**
+      * @brief Feeds the bag through the handler
+      * @return [int] process exit status
+      */
+    int
+    run(const std::string& bagFile, const std::string& state,
+        const std::string& outputFile, const std::string& traceFile)
+    {
+      std::vector<std::string> inputTopics = getTopicsParam("subscribed_topics");
+      std::vector<std::string> outputTopics = getTopicsParam("published_topics");
+
+      rosbag::Bag bag(bagFile, rosbag::bagmode::Read);
+      rosbag::View view(bag, rosbag::TopicQuery(inputTopics));
+      if (view.size() == 0)
+      {
+        ROS_ERROR("[BatchRunner] %s has no messages on the subscribed topics", bagFile.c_str());
+        return 1;
+      }
+
+      // Statistics over the whole run instead of a rolling window, stages run
+      // synchronously so that every frame is processed
+      std::string privateNs = "/" + name_ + "/";
+      ros::param::set(privateNs + "register_client", false);
+      ros::param::set(privateNs + "pipelined", false);
+      ros::param::set(privateNs + "latency_tracing", true);
+      ros::param::set(privateNs + "latency_window", static_cast<int>(view.size()));
+      ros::param::set(privateNs + "latency_report_rate", 0.0);
+      ros::param::set(privateNs + "trace_buffer_size",
+          traceFile.empty() ? 0 : static_cast<int>(TRACE_COUNT * view.size()));
+
+      boost::shared_ptr<nodelet::Nodelet> nodelet;
+      try
+      {
+        nodelet = nodeletLoader_.createInstance(handlerType_);
+      }
+      catch (const pluginlib::PluginlibException& ex)
+      {
+        ROS_ERROR("[BatchRunner] Could not load %s: %s", handlerType_.c_str(), ex.what());
+        return 1;
+      }
+      nodelet->init("/" + name_, nodelet::M_string(), nodelet::V_string(), &queue_, &queue_);
+      Handler* handler = dynamic_cast<Handler*>(nodelet.get());
+      if (handler == NULL)
+      {
+        ROS_ERROR("[BatchRunner] %s is not a sensor_processor handler", handlerType_.c_str());
+        return 1;
+      }
+
+      // What the handler publishes is only ever received by the subscriptions
+      // below, which roscpp connects within the process
+      if (!outputFile.empty())
+        outputBag_.open(outputFile, rosbag::bagmode::Write);
+      std::vector<ros::Subscriber> subscribers;
+      BOOST_FOREACH(const std::string& topic, outputTopics)
+      {
+        subscribers.push_back(nh_.subscribe<topic_tools::ShapeShifter>(topic, 100,
+              boost::bind(&BatchRunner::outputCallback, this, topic, _1)));
+      }
+      std::string logTopic;
+      ros::param::param<std::string>(privateNs + "op_report_topic", logTopic, "processor_log");
+      subscribers.push_back(nh_.subscribe(privateNs + logTopic, 100,
+            &BatchRunner::logCallback, this));
+
+      handler->startTransition(state_manager::StateClientNodelet::ROBOT_STATES(state));
+      drain();
+
+      ros::WallTime begin = ros::WallTime::now();
+      size_t frames = 0, skipped = 0;
+      std::vector<uint8_t> buffer;
+      BOOST_FOREACH(const rosbag::MessageInstance& message, view)
+      {
+        if (!ros::ok())
+          break;
+        buffer.resize(message.size());
+        uint8_t* data = buffer.empty() ? NULL : &buffer[0];
+        ros::serialization::OStream stream(data, buffer.size());
+        message.write(stream);
+        if (!handler->feedSerializedInput(message.getMD5Sum(), data, buffer.size()))
+        {
+          ++skipped;
+          continue;
+        }
+        drain();
+        ++frames;
+      }
+      double elapsed = (ros::WallTime::now() - begin).toSec();
+
+      if (skipped > 0)
+        ROS_WARN("[BatchRunner] %zu messages were not of the preprocessor's input type", skipped);
+      report(handler, frames, elapsed);
+      if (!traceFile.empty() && handler->getLatencyTracer())
+        handler->getLatencyTracer()->dumpChromeTrace(traceFile);
+
+      subscribers.clear();
+      if (!outputFile.empty())
+        outputBag_.close();
+      nodelet.reset();
+      return 0;
+    }
+
+   private:
+    /**
+      * @brief Runs callbacks until the handler has nothing left to process
+      */
+    void
+    drain()
+    {
+      while (!queue_.isEmpty())
+        queue_.callAvailable();
+    }
+
+    std::vector<std::string>
+    getTopicsParam(const std::string& param)
+    {
+      std::vector<std::string> topics;
+      XmlRpc::XmlRpcValue value;
+      if (!ros::param::get("/" + name_ + "/" + param, value))
+      {
+        ROS_FATAL("[BatchRunner] '%s' param not found, did you pass the topics config?",
+            param.c_str());
+        ROS_BREAK();
+      }
+      if (value.getType() == XmlRpc::XmlRpcValue::TypeString)
+      {
+        topics.push_back(static_cast<std::string>(value));
+      }
+      else
+      {
+        ROS_ASSERT(value.getType() == XmlRpc::XmlRpcValue::TypeArray);
+        for (int ii = 0; ii < value.size(); ++ii)
+          topics.push_back(static_cast<std::string>(value[ii]));
+      }
+      return topics;
+    }
+
+    void
+    outputCallback(const std::string& topic,
+        const boost::shared_ptr<topic_tools::ShapeShifter const>& message)
+    {
+      ++outputs_;
+      if (outputBag_.isOpen())
+        outputBag_.write(topic, ros::Time::now(), *message);
+    }
+
+    void
+    logCallback(const ProcessorLogInfoConstPtr& logInfo)
+    {
+      if (logInfo->success)
+        ++succeeded_;
+      else
+        ++failed_;
+    }
+
+    void
+    report(Handler* handler, size_t frames, double elapsed)
+    {
+      printf("\n%s: %zu frames in %.3f s, %.2f frames/s\n", handlerType_.c_str(),
+          frames, elapsed, elapsed > 0 ? frames / elapsed : 0.0);
+      printf("  frames processed successfully: %d, failed or rejected: %d\n",
+          succeeded_, failed_);
+      printf("  messages published: %d\n", outputs_);
+
+      if (!handler->getLatencyTracer())
+        return;
+      ProcessorLatencyInfo latency;
+      handler->getLatencyTracer()->fillReport(&latency);
+      printf("  %-16s %8s %10s %10s %10s %10s\n", "stage (ms)", "samples",
+          "p50", "p95", "p99", "max");
+      BOOST_FOREACH(const StageLatency& stage, latency.stages)
+      {
+        printf("  %-16s %8u %10.3f %10.3f %10.3f %10.3f\n", stage.name.c_str(),
+            stage.samples, stage.p50 * 1000, stage.p95 * 1000, stage.p99 * 1000,
+            stage.max * 1000);
+      }
+    }
+
+   private:
+    std::string handlerType_;
+    std::string name_;
+
+    ros::NodeHandle nh_;
+    ros::CallbackQueue queue_;
+    pluginlib::ClassLoader<nodelet::Nodelet> nodeletLoader_;
+
+    rosbag::Bag outputBag_;
+    int outputs_;
+    int succeeded_;
+    int failed_;
+  };
+}  // namespace sensor_processor
+
+int main(int argc, char** argv)
+{
+  std::string handlerType, name, bagFile, state, outputFile, traceFile;
+  std::vector<std::string> configs;
+
+  po::options_description description("Feeds a bag through a sensor_processor handler "
+      "as fast as possible");
+  description.add_options()
+    ("help,h", "print this message")
+    ("handler", po::value<std::string>(&handlerType)->required(),
+     "nodelet plugin name of the handler, e.g. pandora_vision/pandora_vision_qrcode")
+    ("config,c", po::value< std::vector<std::string> >(&configs),
+     "YAML file to load in the handler's namespace, as file[:sub_namespace]")
+    ("bag,b", po::value<std::string>(&bagFile)->required(), "input bag")
+    ("state,s", po::value<std::string>(&state)->default_value("EXPLORATION_RESCUE"),
+     "robot state to run the handler in")
+    ("name,n", po::value<std::string>(&name)->default_value("batch_handler"),
+     "name given to the handler nodelet")
+    ("output,o", po::value<std::string>(&outputFile), "bag to record the handler's output to")
+    ("trace,t", po::value<std::string>(&traceFile), "Chrome trace file to dump stage events to");
+
+  po::variables_map vm;
+  try
+  {
+    po::store(po::parse_command_line(argc, argv, description), vm);
+    if (vm.count("help"))
+    {
+      std::cout << description << std::endl;
+      return 0;
+    }
+    po::notify(vm);
+  }
+  catch (const po::error& e)
+  {
+    std::cerr << e.what() << std::endl << description << std::endl;
+    return 1;
+  }
+
+  // roscpp reads the master's URI when it is initialized
+  sensor_processor::InProcessMaster master;
+  if (!master.start())
+  {
+    std::cerr << "Could not serve the in-process master" << std::endl;
+    return 1;
+  }
+  setenv("ROS_MASTER_URI", master.getUri().c_str(), 1);
+  ros::init(argc, argv, "sensor_processor_batch_runner", ros::init_options::NoSigintHandler);
+
+  int status;
+  {
+    sensor_processor::BatchRunner runner(handlerType, name);
+    BOOST_FOREACH(const std::string& config, configs)
+    {
+      size_t colon = config.find(':');
+      if (colon == std::string::npos)
+        runner.loadConfig(config, "");
+      else
+        runner.loadConfig(config.substr(0, colon), config.substr(colon + 1));
+    }
+    status = runner.run(bagFile, state, outputFile, traceFile);
+  }
+
+  ros::shutdown();
+  master.shutdown();
+  return status;
+}
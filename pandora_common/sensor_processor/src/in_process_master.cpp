@@ -0,0 +1,515 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/bind.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "sensor_processor/in_process_master.h"
+
+namespace sensor_processor
+{
+  namespace
+  {
+    XmlRpc::XmlRpcValue
+    emptyStruct()
+    {
+      int offset = 0;
+      return XmlRpc::XmlRpcValue("<value><struct></struct></value>", &offset);
+    }
+
+    XmlRpc::XmlRpcValue
+    emptyArray()
+    {
+      XmlRpc::XmlRpcValue value;
+      value.setSize(0);
+      return value;
+    }
+  }  // namespace
+
+  InProcessMaster::Method::
+  Method(const std::string& name, Call call, InProcessMaster* master) :
+    XmlRpc::XmlRpcServerMethod(name, &master->server_), call_(call), master_(master) {}
+
+  void
+  InProcessMaster::Method::
+  execute(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    boost::mutex::scoped_lock lock(master_->mutex_);
+    (master_->*call_)(params, result);
+  }
+
+  InProcessMaster::
+  InProcessMaster() : running_(false), port_(0), params_(emptyStruct())
+  {
+    const std::pair<const char*, Call> calls[] = {
+      std::make_pair("getPid", &InProcessMaster::getPid),
+      std::make_pair("getUri", &InProcessMaster::getMasterUri),
+      std::make_pair("lookupNode", &InProcessMaster::lookupNode),
+      std::make_pair("registerPublisher", &InProcessMaster::registerPublisher),
+      std::make_pair("unregisterPublisher", &InProcessMaster::unregisterPublisher),
+      std::make_pair("registerSubscriber", &InProcessMaster::registerSubscriber),
+      std::make_pair("unregisterSubscriber", &InProcessMaster::unregisterSubscriber),
+      std::make_pair("getPublishedTopics", &InProcessMaster::getTopicTypes),
+      std::make_pair("getTopicTypes", &InProcessMaster::getTopicTypes),
+      std::make_pair("getSystemState", &InProcessMaster::getSystemState),
+      std::make_pair("registerService", &InProcessMaster::registerService),
+      std::make_pair("unregisterService", &InProcessMaster::unregisterService),
+      std::make_pair("lookupService", &InProcessMaster::lookupService),
+      std::make_pair("getParam", &InProcessMaster::getParam),
+      std::make_pair("setParam", &InProcessMaster::setParam),
+      std::make_pair("hasParam", &InProcessMaster::hasParam),
+      std::make_pair("deleteParam", &InProcessMaster::deleteParam),
+      std::make_pair("searchParam", &InProcessMaster::searchParam),
+      std::make_pair("subscribeParam", &InProcessMaster::subscribeParam),
+      std::make_pair("unsubscribeParam", &InProcessMaster::unsubscribeParam),
+      std::make_pair("getParamNames", &InProcessMaster::getParamNames)
+    };
+    for (size_t ii = 0; ii < sizeof(calls) / sizeof(calls[0]); ++ii)
+      methods_.push_back(boost::shared_ptr<Method>( new Method(calls[ii].first, calls[ii].second, this) ));
+  }
+
+  InProcessMaster::
+  ~InProcessMaster()
+  {
+    shutdown();
+  }
+
+  bool
+  InProcessMaster::
+  start()
+  {
+    if (!server_.bindAndListen(0))
+      return false;
+    port_ = server_.get_port();
+    running_ = true;
+    thread_ = boost::thread(boost::bind(&InProcessMaster::serve, this));
+    return true;
+  }
+
+  void
+  InProcessMaster::
+  shutdown()
+  {
+    if (!running_)
+      return;
+    running_ = false;
+    thread_.join();
+    server_.shutdown();
+  }
+
+  std::string
+  InProcessMaster::
+  getUri() const
+  {
+    return "http://localhost:" + boost::lexical_cast<std::string>(port_) + "/";
+  }
+
+  void
+  InProcessMaster::
+  serve()
+  {
+    while (running_)
+      server_.work(0.1);
+  }
+
+  void
+  InProcessMaster::
+  getPid(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    reply(result, 1, "", static_cast<int>(::getpid()));
+  }
+
+  void
+  InProcessMaster::
+  getMasterUri(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    reply(result, 1, "", getUri());
+  }
+
+  void
+  InProcessMaster::
+  lookupNode(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    Callers::iterator it = nodes_.find(static_cast<std::string>(params[1]));
+    if (it == nodes_.end())
+      reply(result, -1, "unknown node", "");
+    else
+      reply(result, 1, "", it->second);
+  }
+
+  void
+  InProcessMaster::
+  registerPublisher(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::string callerId = static_cast<std::string>(params[0]);
+    std::string topic = static_cast<std::string>(params[1]);
+    nodes_[callerId] = static_cast<std::string>(params[3]);
+    publishers_[topic][callerId] = nodes_[callerId];
+    topicTypes_[topic] = static_cast<std::string>(params[2]);
+    reply(result, 1, "", makeUriList(subscribers_[topic]));
+  }
+
+  void
+  InProcessMaster::
+  unregisterPublisher(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::string topic = static_cast<std::string>(params[1]);
+    reply(result, 1, "", static_cast<int>(
+          publishers_[topic].erase(static_cast<std::string>(params[0]))));
+  }
+
+  void
+  InProcessMaster::
+  registerSubscriber(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::string callerId = static_cast<std::string>(params[0]);
+    std::string topic = static_cast<std::string>(params[1]);
+    nodes_[callerId] = static_cast<std::string>(params[3]);
+    subscribers_[topic][callerId] = nodes_[callerId];
+    if (topicTypes_.count(topic) == 0)
+      topicTypes_[topic] = static_cast<std::string>(params[2]);
+    reply(result, 1, "", makeUriList(publishers_[topic]));
+  }
+
+  void
+  InProcessMaster::
+  unregisterSubscriber(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::string topic = static_cast<std::string>(params[1]);
+    reply(result, 1, "", static_cast<int>(
+          subscribers_[topic].erase(static_cast<std::string>(params[0]))));
+  }
+
+  void
+  InProcessMaster::
+  getTopicTypes(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    XmlRpc::XmlRpcValue topics = emptyArray();
+    int ii = 0;
+    for (std::map<std::string, std::string>::iterator it = topicTypes_.begin();
+        it != topicTypes_.end(); ++it, ++ii)
+    {
+      topics[ii][0] = it->first;
+      topics[ii][1] = it->second;
+    }
+    reply(result, 1, "", topics);
+  }
+
+  void
+  InProcessMaster::
+  getSystemState(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    XmlRpc::XmlRpcValue state;
+    const std::map<std::string, Callers>* registrations[] = {&publishers_, &subscribers_};
+    for (int kk = 0; kk < 2; ++kk)
+    {
+      state[kk] = emptyArray();
+      int ii = 0;
+      for (std::map<std::string, Callers>::const_iterator it = registrations[kk]->begin();
+          it != registrations[kk]->end(); ++it)
+      {
+        if (it->second.empty())
+          continue;
+        state[kk][ii][0] = it->first;
+        state[kk][ii][1] = emptyArray();
+        int jj = 0;
+        for (Callers::const_iterator caller = it->second.begin();
+            caller != it->second.end(); ++caller, ++jj)
+          state[kk][ii][1][jj] = caller->first;
+        ++ii;
+      }
+    }
+    state[2] = emptyArray();
+    int ii = 0;
+    for (std::map<std::string, std::pair<std::string, std::string> >::iterator it =
+        services_.begin(); it != services_.end(); ++it, ++ii)
+    {
+      state[2][ii][0] = it->first;
+      state[2][ii][1][0] = it->second.second;
+    }
+    reply(result, 1, "", state);
+  }
+
+  void
+  InProcessMaster::
+  registerService(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::string callerId = static_cast<std::string>(params[0]);
+    nodes_[callerId] = static_cast<std::string>(params[3]);
+    services_[static_cast<std::string>(params[1])] =
+      std::make_pair(static_cast<std::string>(params[2]), callerId);
+    reply(result, 1, "", 0);
+  }
+
+  void
+  InProcessMaster::
+  unregisterService(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::map<std::string, std::pair<std::string, std::string> >::iterator it =
+      services_.find(static_cast<std::string>(params[1]));
+    if (it == services_.end() || it->second.first != static_cast<std::string>(params[2]))
+    {
+      reply(result, 1, "", 0);
+      return;
+    }
+    services_.erase(it);
+    reply(result, 1, "", 1);
+  }
+
+  void
+  InProcessMaster::
+  lookupService(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::map<std::string, std::pair<std::string, std::string> >::iterator it =
+      services_.find(static_cast<std::string>(params[1]));
+    if (it == services_.end())
+      reply(result, -1, "no provider", "");
+    else
+      reply(result, 1, "", it->second.first);
+  }
+
+  void
+  InProcessMaster::
+  getParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    XmlRpc::XmlRpcValue* value = findParam(static_cast<std::string>(params[1]));
+    if (value == NULL)
+      reply(result, -1, "Parameter [" + static_cast<std::string>(params[1]) + "] is not set", 0);
+    else
+      reply(result, 1, "", *value);
+  }
+
+  void
+  InProcessMaster::
+  setParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::vector<std::string> names = splitKey(static_cast<std::string>(params[1]));
+    if (names.empty())
+    {
+      if (params[2].getType() != XmlRpc::XmlRpcValue::TypeStruct)
+      {
+        reply(result, -1, "The root namespace can only be set to a dictionary", 0);
+        return;
+      }
+      params_ = params[2];
+      reply(result, 1, "", 0);
+      return;
+    }
+    // Like rosmaster, setting a dictionary replaces the whole subtree
+    XmlRpc::XmlRpcValue* node = &params_;
+    for (size_t ii = 0; ii + 1 < names.size(); ++ii)
+    {
+      if (!node->hasMember(names[ii]) ||
+          (*node)[names[ii]].getType() != XmlRpc::XmlRpcValue::TypeStruct)
+        (*node)[names[ii]] = emptyStruct();
+      node = &(*node)[names[ii]];
+    }
+    (*node)[names.back()] = params[2];
+    reply(result, 1, "", 0);
+  }
+
+  void
+  InProcessMaster::
+  hasParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    reply(result, 1, "", findParam(static_cast<std::string>(params[1])) != NULL);
+  }
+
+  void
+  InProcessMaster::
+  deleteParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::vector<std::string> names = splitKey(static_cast<std::string>(params[1]));
+    if (names.empty())
+    {
+      params_ = emptyStruct();
+      reply(result, 1, "", 0);
+      return;
+    }
+    std::string parentKey;
+    for (size_t ii = 0; ii + 1 < names.size(); ++ii)
+      parentKey += "/" + names[ii];
+    XmlRpc::XmlRpcValue* parent = findParam(parentKey);
+    if (parent == NULL || parent->getType() != XmlRpc::XmlRpcValue::TypeStruct ||
+        !parent->hasMember(names.back()))
+    {
+      reply(result, -1, "Parameter [" + static_cast<std::string>(params[1]) + "] is not set", 0);
+      return;
+    }
+    // XmlRpcValue cannot erase a member, so the dictionary is rebuilt
+    XmlRpc::XmlRpcValue remaining = emptyStruct();
+    for (XmlRpc::XmlRpcValue::iterator it = parent->begin(); it != parent->end(); ++it)
+    {
+      if (it->first != names.back())
+        remaining[it->first] = it->second;
+    }
+    *parent = remaining;
+    reply(result, 1, "", 0);
+  }
+
+  void
+  InProcessMaster::
+  searchParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    std::string key = static_cast<std::string>(params[1]);
+    if (!key.empty() && key[0] == '/')
+    {
+      if (findParam(key) != NULL)
+        reply(result, 1, "", key);
+      else
+        reply(result, -1, "Cannot find parameter [" + key + "]", "");
+      return;
+    }
+    // The first name of the key is looked up in the caller's namespace and
+    // then in each of its parents
+    std::vector<std::string> names = splitKey(key);
+    std::vector<std::string> ns = splitKey(static_cast<std::string>(params[0]));
+    while (!names.empty())
+    {
+      std::string prefix;
+      for (size_t ii = 0; ii < ns.size(); ++ii)
+        prefix += "/" + ns[ii];
+      if (findParam(prefix + "/" + names[0]) != NULL)
+      {
+        reply(result, 1, "", prefix + "/" + boost::join(names, "/"));
+        return;
+      }
+      if (ns.empty())
+        break;
+      ns.pop_back();
+    }
+    reply(result, -1, "Cannot find parameter [" + key + "]", "");
+  }
+
+  void
+  InProcessMaster::
+  subscribeParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    // Parameters only change before the runner starts the handler, so
+    // subscribers are never notified
+    XmlRpc::XmlRpcValue* value = findParam(static_cast<std::string>(params[2]));
+    reply(result, 1, "", value == NULL ? emptyStruct() : *value);
+  }
+
+  void
+  InProcessMaster::
+  unsubscribeParam(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    reply(result, 1, "", 1);
+  }
+
+  void
+  InProcessMaster::
+  getParamNames(XmlRpc::XmlRpcValue& params, XmlRpc::XmlRpcValue& result)
+  {
+    XmlRpc::XmlRpcValue names = emptyArray();
+    collectParamNames("", params_, &names);
+    reply(result, 1, "", names);
+  }
+
+  XmlRpc::XmlRpcValue*
+  InProcessMaster::
+  findParam(const std::string& key)
+  {
+    std::vector<std::string> names = splitKey(key);
+    XmlRpc::XmlRpcValue* node = &params_;
+    for (size_t ii = 0; ii < names.size(); ++ii)
+    {
+      if (node->getType() != XmlRpc::XmlRpcValue::TypeStruct || !node->hasMember(names[ii]))
+        return NULL;
+      node = &(*node)[names[ii]];
+    }
+    return node;
+  }
+
+  std::vector<std::string>
+  InProcessMaster::
+  splitKey(const std::string& key)
+  {
+    std::vector<std::string> names;
+    boost::split(names, key, boost::is_any_of("/"));
+    names.erase(std::remove(names.begin(), names.end(), std::string()), names.end());
+    return names;
+  }
+
+  void
+  InProcessMaster::
+  collectParamNames(const std::string& prefix, XmlRpc::XmlRpcValue& value,
+      XmlRpc::XmlRpcValue* names)
+  {
+    for (XmlRpc::XmlRpcValue::iterator it = value.begin(); it != value.end(); ++it)
+    {
+      std::string name = prefix + "/" + it->first;
+      if (it->second.getType() == XmlRpc::XmlRpcValue::TypeStruct)
+        collectParamNames(name, it->second, names);
+      else
+        (*names)[names->size()] = name;
+    }
+  }
+
+  XmlRpc::XmlRpcValue
+  InProcessMaster::
+  makeUriList(const Callers& callers)
+  {
+    XmlRpc::XmlRpcValue uris = emptyArray();
+    int ii = 0;
+    for (Callers::const_iterator it = callers.begin(); it != callers.end(); ++it, ++ii)
+      uris[ii] = it->second;
+    return uris;
+  }
+
+  void
+  InProcessMaster::
+  reply(XmlRpc::XmlRpcValue& result, int code, const std::string& status,
+      const XmlRpc::XmlRpcValue& value)
+  {
+    result[0] = code;
+    result[1] = status;
+    result[2] = value;
+  }
+}  // namespace sensor_processor
@@ -0,0 +1,183 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#include <iostream>
+#include <string>
+
+#include <ros/ros.h>
+#include <std_msgs/Int32.h>
+#include <gtest/gtest.h>
+
+#include "sensor_processor/handler.h"
+#include "sensor_processor/preprocessor.h"
+#include "sensor_processor/processor.h"
+#include "sensor_processor/postprocessor.h"
+#include "sensor_processor/typed_pipeline.h"
+
+/**
+ * Measures the per frame overhead of chaining the stages of a handler,
+ * through boost::any (AbstractProcessor path) and through a TypedPipeline.
+ * The stages themselves do trivial work, so the difference between the two
+ * figures is the cost of the chaining itself.
+ */
+
+namespace sensor_processor
+{
+  typedef std_msgs::Int32 Int32;
+
+  // Stages are never initialized, so they neither subscribe nor advertise.
+  class BenchmarkPreProcessor : public PreProcessor<Int32, Int32>
+  {
+   public:
+    virtual void
+    initialize(const std::string& ns, Handler* handler) {}
+
+    virtual bool
+    preProcess(const std_msgs::Int32ConstPtr& input, const std_msgs::Int32Ptr& output)
+    {
+      output->data = input->data + 1;
+      return true;
+    }
+  };
+
+  class BenchmarkProcessor : public Processor<Int32, Int32>
+  {
+   public:
+    virtual bool
+    process(const std_msgs::Int32ConstPtr& input, const std_msgs::Int32Ptr& output)
+    {
+      output->data = input->data * 2;
+      return true;
+    }
+  };
+
+  class BenchmarkPostProcessor : public PostProcessor<Int32, Int32>
+  {
+   public:
+    BenchmarkPostProcessor() : last_(0) {}
+
+    virtual void
+    initialize(const std::string& ns, Handler* handler) {}
+
+    virtual bool
+    postProcess(const std_msgs::Int32ConstPtr& input, const std_msgs::Int32Ptr& output)
+    {
+      output->data = input->data - 1;
+      last_ = output->data;
+      return true;
+    }
+
+    int last_;
+  };
+
+  class BenchmarkHandler : public Handler
+  {
+   public:
+    BenchmarkHandler()
+    {
+      preProcPtr_.reset( new BenchmarkPreProcessor );
+      processorPtr_.reset( new BenchmarkProcessor );
+      postProcPtr_.reset( new BenchmarkPostProcessor );
+    }
+
+    void
+    setTyped(bool typed)
+    {
+      if (typed)
+        pipelinePtr_.reset( new TypedPipeline<BenchmarkPreProcessor,
+            BenchmarkProcessor, BenchmarkPostProcessor>(preProcPtr_, processorPtr_, postProcPtr_) );
+      else
+        pipelinePtr_.reset();
+    }
+
+    int
+    getLastResult()
+    {
+      return boost::static_pointer_cast<BenchmarkPostProcessor>(postProcPtr_)->last_;
+    }
+
+    /**
+      * @brief Feeds the same message to the handler for a number of frames
+      * @return [double] mean time per frame in nanoseconds
+      */
+    double
+    run(int frames)
+    {
+      std_msgs::Int32Ptr msg( new Int32 );
+      msg->data = 20;
+      std_msgs::Int32ConstPtr constMsg = msg;
+
+      ros::WallTime begin = ros::WallTime::now();
+      for (int ii = 0; ii < frames; ++ii)
+        completeProcessCallback<Int32>(constMsg);
+      return (ros::WallTime::now() - begin).toNSec() / static_cast<double>(frames);
+    }
+
+   protected:
+    virtual void
+    startTransition(int newState) {}
+    virtual void
+    completeTransition() {}
+  };
+
+  TEST(TypedPipelineBenchmark, perFrameOverhead)
+  {
+    const int frames = 1000000;
+    BenchmarkHandler handler;
+
+    handler.setTyped(false);
+    handler.run(frames / 10);  // warm up
+    double anyTime = handler.run(frames);
+    EXPECT_EQ(41, handler.getLastResult());
+
+    handler.setTyped(true);
+    handler.run(frames / 10);
+    double typedTime = handler.run(frames);
+    EXPECT_EQ(41, handler.getLastResult());
+
+    std::cout << "[ BENCHMARK ] boost::any chaining: " << anyTime << " ns/frame" << std::endl;
+    std::cout << "[ BENCHMARK ] typed pipeline:      " << typedTime << " ns/frame" << std::endl;
+  }
+}  // namespace sensor_processor
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "typed_pipeline_benchmark");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -40,6 +40,7 @@
 #define FRAME_MATCHER_KEYPOINT_TRANSFORMER_H
 
 #include <string>
+#include <vector>
 #include <boost/scoped_ptr.hpp>
 
 #include <ros/ros.h>
@@ -73,6 +74,20 @@ namespace frame_matcher
                       const cv::Point2f& pointFrom,
                       const sensor_msgs::Image& imageTo);
 
+    /**
+     * @brief Transforms a set of points seen in one image to the other. Frames
+     * and transforms are resolved once for the whole set
+     * @param imageFrom [const sensor_msgs::Image&] The image the points are on
+     * @param pointsFrom [const std::vector<cv::Point2f>&] The points to transform
+     * @param imageTo [const sensor_msgs::Image&] The image to transform them to
+     * @param pointsTo [std::vector<cv::Point2f>*] The transformed points, in order
+     */
+    void
+    transformKeypoints(const sensor_msgs::Image& imageFrom,
+                       const std::vector<cv::Point2f>& pointsFrom,
+                       const sensor_msgs::Image& imageTo,
+                       std::vector<cv::Point2f>* pointsTo);
+
    private:
     ros::NodeHandle nh_;
 
@@ -37,6 +37,7 @@
  *********************************************************************/
 
 #include <string>
+#include <vector>
 
 #include <ros/ros.h>
 #include <opencv2/opencv.hpp>
@@ -48,6 +49,7 @@
 #include "pandora_vision_common/pandora_vision_utilities/general_alert_converter.h"
 #include "pandora_vision_common/poi_stamped.h"
 #include "pandora_common_msgs/GeneralAlert.h"
+#include "pandora_common_msgs/GeneralAlertVector.h"
 
 #include "frame_matcher/keypoint_transformer.h"
 #include "frame_matcher/view_pose_finder.h"
@@ -107,5 +109,46 @@ namespace frame_matcher
     return poiOnTargetCamera.getPoint();
   }
 
+  void
+  KeypointTransformer::
+  transformKeypoints(
+      const sensor_msgs::Image& imageFrom,
+      const std::vector<cv::Point2f>& pointsFrom,
+      const sensor_msgs::Image& imageTo,
+      std::vector<cv::Point2f>* pointsTo)
+  {
+    // #1 Calculate yaw and pitch from origin camera frame towards every point
+    pandora_common_msgs::GeneralAlertVector originCameraAlerts;
+    generalAlertConverter_.getGeneralAlerts(nh_, imageFrom.header, pointsFrom,
+        imageFrom.width, imageFrom.height, &originCameraAlerts);
+
+    // #2 Look up both camera frames in the world once for the whole set
+    tf::Transform originCameraFrame = viewPoseFinderPtr_->lookupTransformFromWorld(
+        global_frame_, originCameraAlerts.header);
+    std_msgs::Header targetCameraHeader;
+    targetCameraHeader.frame_id = generalAlertConverter_.findParentFrameId(nh_,
+        imageTo.header.frame_id, "/robot_description");
+    targetCameraHeader.stamp = imageTo.header.stamp;  // change this later
+    tf::Transform targetCameraFrame = viewPoseFinderPtr_->lookupTransformFromWorld(
+        global_frame_, targetCameraHeader);
+
+    // #3 Calculate yaw and pitch from target camera frame towards the position
+    // of every point in the world
+    std::vector<pandora_common_msgs::GeneralAlertInfo> targetCameraAlerts(
+        originCameraAlerts.alerts.size());
+    for (int ii = 0; ii < originCameraAlerts.alerts.size(); ++ii) {
+      geometry_msgs::Point pointInWorld = viewPoseFinderPtr_->findAlertPosition(
+          originCameraAlerts.alerts[ii].yaw, originCameraAlerts.alerts[ii].pitch,
+          originCameraFrame);
+      viewPoseFinderPtr_->findViewOrientation(pointInWorld, targetCameraFrame,
+          &targetCameraAlerts[ii].yaw, &targetCameraAlerts[ii].pitch);
+    }
+
+    // #4 Calculate points on target camera frame on which we see the same
+    // objects in the world
+    generalAlertConverter_.getPOIs(nh_, imageTo.header.frame_id, targetCameraAlerts,
+        imageTo.width, imageTo.height, pointsTo);
+  }
+
 }  // namespace frame_matcher
 }  // namespace pandora_data_fusion
@@ -65,10 +65,9 @@ namespace frame_matcher
                   const sensor_msgs::Image& imageTo,
                   std::vector<cv::Point2f>* roiToPtr)
   {
-    for (int ii = 0; ii < roiFrom.size(); ++ii) {
-      roiToPtr->push_back(keypointTransformer_.transformKeypoint(
-            imageFrom, roiFrom.at(ii), imageTo));
-    }
+    std::vector<cv::Point2f> roiTo;
+    keypointTransformer_.transformKeypoints(imageFrom, roiFrom, imageTo, &roiTo);
+    roiToPtr->insert(roiToPtr->end(), roiTo.begin(), roiTo.end());
     changeIntoOrthogonalBox(roiToPtr);
   }
 
@@ -68,9 +68,12 @@ namespace pandora_vision_color
 
       /**
         @brief Function that detects color
+        @param frame [const cv::Mat&] BGR frame
+        @param hsvFrame [const cv::Mat&] HSV version of the frame, if already
+        available. It is not modified
         @return void
       */
-      void detectColor(const cv::Mat& frame);
+      void detectColor(const cv::Mat& frame, const cv::Mat& hsvFrame = cv::Mat());
 
       bool visualization_;
 
@@ -80,7 +80,7 @@ namespace pandora_vision_color
     @param frame [&cv::Mat] current frame to be processed
     @return void.
   */
-  void ColorDetector::detectColor(const cv::Mat& frame)
+  void ColorDetector::detectColor(const cv::Mat& frame, const cv::Mat& hsvFrame)
   {
     frame_ = frame.clone();
     /// Check that frame has data and that image has 3 channels
@@ -90,7 +90,16 @@ namespace pandora_vision_color
       GaussianBlur(frame_, frame_, cv::Size(3, 3), 0, 0, cv::BORDER_DEFAULT);
 
       /// convert RGB image into HSV image
-      cvtColor(frame, hsvFrame_, CV_BGR2HSV);
+      if (hsvFrame.empty())
+      {
+        // Never convert into a buffer shared with other nodes
+        hsvFrame_.release();
+        cvtColor(frame, hsvFrame_, CV_BGR2HSV);
+      }
+      else
+      {
+        hsvFrame_ = hsvFrame;
+      }
 
       /// get binary image
       inRange(hsvFrame_, cv::Scalar(iLowH, iLowS, iLowV), cv::Scalar(iHighH, iHighS, iHighV), binary_);  // pink*/
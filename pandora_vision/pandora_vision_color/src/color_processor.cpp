@@ -86,7 +86,11 @@ namespace pandora_vision_color
   bool ColorProcessor::process(const CVMatStampedConstPtr& input, const POIsStampedPtr& output)
   {
     output->header = input->getHeader();
-    colorDetectorPtr_->detectColor(input->getImage());
+    // The HSV frame may have been already computed by another node
+    if (input->derivatives)
+      colorDetectorPtr_->detectColor(input->getImage(), input->derivatives->getHsv());
+    else
+      colorDetectorPtr_->detectColor(input->getImage());
     bounding_boxes_ = colorDetectorPtr_->getColorPosition();
     output->frameWidth = input->getImage().cols;
     output->frameHeight = input->getImage().rows;
@@ -44,6 +44,8 @@
 
 #include <std_msgs/Header.h>
 
+#include "pandora_vision_common/pandora_vision_utilities/frame_derivative_cache.h"
+
 namespace pandora_vision
 {
   class CVMatStamped
@@ -61,9 +63,20 @@ namespace pandora_vision
     /// to a frame
     std_msgs::Header header;
 
-    /// OpenCV matrix that corresponds to the current frame to be processed
+    /// OpenCV matrix that corresponds to the current frame to be processed.
+    /// Unless the preprocessor was asked for a mutable image, it may refer
+    /// to the buffer of the image message it came from and must be treated
+    /// as read-only
     cv::Mat image;
 
+    /// Keeps alive the buffer that image refers to, if it was not copied
+    boost::shared_ptr<void const> imageOwner;
+
+    /// Grayscale, HSV, pyramid and gradient images of the frame, shared
+    /// with the other nodes that process it. Set only for read-only BGR
+    /// images
+    pandora_vision_common::FrameDerivativesPtr derivatives;
+
    public:
     void setHeader(const std_msgs::Header&);
     std_msgs::Header getHeader() const;
@@ -78,6 +78,18 @@ namespace pandora_vision
       encoding_ = encoding;
     }
 
+    /**
+      * @brief Sets whether the output image is a private copy that the
+      * detector may modify in place. Otherwise it shares the buffer of the
+      * incoming message whenever no conversion is needed.
+      * @param mutableImage [bool] true if the detector writes to its input
+      **/
+    void
+    setMutableImage(bool mutableImage)
+    {
+      mutableImage_ = mutableImage;
+    }
+
     /**
       * @brief Function that gets a message containing an image and converts it to a matrix
       * also considering the image's timestamp
@@ -92,12 +104,14 @@ namespace pandora_vision
 
    protected:
     std::string encoding_;
+    bool mutableImage_;
   };
 
   VisionPreProcessor::
   VisionPreProcessor() :
     sensor_processor::PreProcessor<sensor_msgs::Image, CVMatStamped>(),
-    encoding_("")
+    encoding_(""),
+    mutableImage_(false)
   {}
 
   bool
@@ -105,18 +119,36 @@ namespace pandora_vision
   preProcess(const ImageConstPtr& input, const CVMatStampedPtr& output)
   {
     // ROS_DEBUG_STREAM("["+this->accessPublicNh()->getNamespace()+"] Calling vision preprocessor.");
-    cv_bridge::CvImagePtr inMsg;
-    if (encoding_ == "")
+    const std::string& encoding = (encoding_ == "") ? input->encoding : encoding_;
+    if (mutableImage_)
     {
-      inMsg = cv_bridge::toCvCopy(*input, input->encoding);
+      output->image = cv_bridge::toCvCopy(input, encoding)->image;
+      output->imageOwner.reset();
+      output->derivatives.reset();
     }
     else
     {
-      inMsg = cv_bridge::toCvCopy(*input, encoding_);
+      // Converts only if the encodings differ, otherwise wraps the message
+      cv_bridge::CvImageConstPtr inMsg = cv_bridge::toCvShare(input, encoding);
+      if (inMsg->image.isContinuous())
+      {
+        output->image = inMsg->image;
+        output->imageOwner = inMsg;
+        if (encoding == sensor_msgs::image_encodings::BGR8)
+          output->derivatives = pandora_vision_common::FrameDerivativeCache::getInstance().get(
+              input->header, encoding, output->image, inMsg);
+        else
+          output->derivatives.reset();
+      }
+      else
+      {
+        // Padded rows, detectors assume continuous data
+        output->image = inMsg->image.clone();
+        output->imageOwner.reset();
+        output->derivatives.reset();
+      }
     }
 
-    output->image = inMsg->image.clone();
-
     output->header = input->header;
 
     if (output->image.empty())
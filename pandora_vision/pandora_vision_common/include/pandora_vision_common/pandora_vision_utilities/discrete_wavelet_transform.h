@@ -48,6 +48,12 @@ namespace pandora_vision
 {
 namespace pandora_vision_common
 {
+  /**
+   * @class DiscreteWaveletTransform Separable 2D DWT. Each level is computed
+   * in a single pass that filters only at the positions kept after
+   * downsampling, using buffers that are reused across calls. An instance
+   * must therefore not be used from several threads at once.
+   */
   class DiscreteWaveletTransform
   {
     public:
@@ -131,6 +137,32 @@ namespace pandora_vision_common
       std::vector<MatPtr> dwt2D(const cv::Mat& inImage, int level = 1);
 
     private:
+      /**
+       * @brief Runs the transform for a number of levels, the LL subband of
+       * each level being the input of the next one
+       * @param inImage [const cv::Mat&] The image to which the transform is
+       * performed
+       * @param level [int] The number of stages of the DWT
+       * @param subbands [int] Bit mask of the subbands to return, bit 0 for
+       * LL, 1 for LH, 2 for HL and 3 for HH
+       * @return [std::vector<MatPtr>] The requested subbands of each level,
+       * in the order LL, LH, HL, HH
+       **/
+      std::vector<MatPtr> transform(const cv::Mat& inImage, int level, int subbands);
+
+      /**
+       * @brief Computes the subbands of a single level in one pass. Each
+       * output row is produced from a vertically filtered row pair that is
+       * then filtered horizontally only at the kept columns
+       * @param inImage [const cv::Mat&] The CV_32F image to be transformed
+       * @param lowLow [cv::Mat*] The output LL subband, NULL to skip
+       * @param lowHigh [cv::Mat*] The output LH subband, NULL to skip
+       * @param highLow [cv::Mat*] The output HL subband, NULL to skip
+       * @param highHigh [cv::Mat*] The output HH subband, NULL to skip
+       **/
+      void transformLevel(const cv::Mat& inImage, cv::Mat* lowLow,
+          cv::Mat* lowHigh, cv::Mat* highLow, cv::Mat* highHigh);
+
       /**
        * @brief Perform convolution with a vector kernel
        * @param inImage [const cv::Mat&] The image to be convolved
@@ -195,6 +227,13 @@ namespace pandora_vision_common
       /// the band - pass filter used for high frequencies
       cv::Mat columnKernelHigh_;
 
+      /// Workspace of the single pass transform, kept across calls so that
+      /// no buffer is allocated per frame once the image size is stable
+      cv::Mat floatInput_;
+      std::vector<cv::Mat> levelBuffers_;
+      std::vector<float> rowLow_;
+      std::vector<float> rowHigh_;
+
       friend class DiscreteWaveletTransformTest;
   };
   typedef DiscreteWaveletTransform::MatPtr MatPtr;
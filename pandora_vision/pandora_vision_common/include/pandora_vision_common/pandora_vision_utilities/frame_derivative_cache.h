@@ -0,0 +1,179 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_COMMON_PANDORA_VISION_UTILITIES_FRAME_DERIVATIVE_CACHE_H
+#define PANDORA_VISION_COMMON_PANDORA_VISION_UTILITIES_FRAME_DERIVATIVE_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <opencv2/opencv.hpp>
+
+#include <ros/time.h>
+#include <std_msgs/Header.h>
+
+namespace pandora_vision
+{
+namespace pandora_vision_common
+{
+  /**
+   * @class FrameDerivatives Images derived from a single BGR frame, computed
+   * lazily the first time any node asks for them. All returned matrices are
+   * shared between the nodes that process the frame and must be treated as
+   * read-only.
+   */
+  class FrameDerivatives
+  {
+   public:
+    /**
+     * @brief Constructor
+     * @param frame [const cv::Mat&] 8-bit BGR frame
+     * @param frameOwner [const boost::shared_ptr<void const>&] keeps alive
+     * the buffer of the frame, if it does not own it
+     **/
+    FrameDerivatives(const cv::Mat& frame,
+        const boost::shared_ptr<void const>& frameOwner);
+
+    const cv::Mat&
+    getFrame() const
+    {
+      return frame_;
+    }
+
+    /**
+     * @brief Grayscale version of the frame
+     **/
+    const cv::Mat& getGray();
+
+    /**
+     * @brief HSV version of the frame
+     **/
+    const cv::Mat& getHsv();
+
+    /**
+     * @brief Level of the Gaussian pyramid of the grayscale frame
+     * @param level [int] 0 is the grayscale frame itself, each following
+     * level halves its dimensions
+     **/
+    const cv::Mat& getPyramidLevel(int level);
+
+    /**
+     * @brief Horizontal Sobel derivative (3x3, CV_32F) of the grayscale frame
+     **/
+    const cv::Mat& getGradientX();
+
+    /**
+     * @brief Vertical Sobel derivative (3x3, CV_32F) of the grayscale frame
+     **/
+    const cv::Mat& getGradientY();
+
+   private:
+    const cv::Mat& computeGray();
+
+   private:
+    //!< Guards the lazy computations, which may be asked from several nodes
+    boost::mutex mutex_;
+
+    cv::Mat frame_;
+    boost::shared_ptr<void const> frameOwner_;
+    cv::Mat gray_;
+    cv::Mat hsv_;
+    std::vector<cv::Mat> pyramid_;
+    cv::Mat gradientX_;
+    cv::Mat gradientY_;
+  };
+  typedef boost::shared_ptr<FrameDerivatives> FrameDerivativesPtr;
+
+  /**
+   * @class FrameDerivativeCache Process wide registry of the derivatives of
+   * the frames currently being processed. Vision nodelets loaded in the same
+   * manager that receive the same frame get the same FrameDerivatives, so
+   * each derivative is computed once per frame regardless of the number of
+   * detectors. Entries live as long as some node still references them.
+   */
+  class FrameDerivativeCache
+  {
+   public:
+    static FrameDerivativeCache&
+    getInstance();
+
+    /**
+     * @brief Returns the derivatives of a frame, shared with every other
+     * holder of the same frame
+     * @param header [const std_msgs::Header&] header of the frame's message,
+     * whose stamp and frame_id identify the frame
+     * @param encoding [const std::string&] encoding of the frame
+     * @param frame [const cv::Mat&] the frame itself, 8-bit BGR
+     * @param frameOwner [const boost::shared_ptr<void const>&] keeps alive
+     * the buffer of the frame, if it does not own it
+     * @return [FrameDerivativesPtr] derivatives of the frame, not shared if
+     * the frame cannot be identified by its header
+     **/
+    FrameDerivativesPtr
+    get(const std_msgs::Header& header, const std::string& encoding,
+        const cv::Mat& frame, const boost::shared_ptr<void const>& frameOwner);
+
+    /**
+     * @brief Number of frames that are currently referenced
+     **/
+    size_t
+    size();
+
+   private:
+    FrameDerivativeCache() {}
+
+    FrameDerivativeCache(const FrameDerivativeCache&);
+    FrameDerivativeCache& operator=(const FrameDerivativeCache&);
+
+   private:
+    typedef boost::tuple<ros::Time, std::string, std::string> Key;
+    typedef std::map<Key, boost::weak_ptr<FrameDerivatives> > EntryMap;
+
+    boost::mutex mutex_;
+    EntryMap entries_;
+  };
+}  // namespace pandora_vision_common
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_COMMON_PANDORA_VISION_UTILITIES_FRAME_DERIVATIVE_CACHE_H
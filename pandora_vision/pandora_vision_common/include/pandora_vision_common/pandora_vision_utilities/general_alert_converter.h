@@ -39,9 +39,12 @@
 #ifndef PANDORA_VISION_COMMON_PANDORA_VISION_UTILITIES_GENERAL_ALERT_CONVERTER_H
 #define PANDORA_VISION_COMMON_PANDORA_VISION_UTILITIES_GENERAL_ALERT_CONVERTER_H
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/shared_ptr.hpp>
 #include <urdf_parser/urdf_parser.h>
@@ -61,6 +64,42 @@ namespace pandora_vision
 {
   class GeneralAlertConverter
   {
+   public:
+    /**
+     * @brief What the conversions need to know about a camera at a given
+     * resolution, resolved once: its parent frame, its fields of view and
+     * the yaw of every column and the pitch of every row
+     **/
+    struct CameraTable
+    {
+      std::string parentFrameId;
+      double frameWidth;
+      double frameHeight;
+      /// tan(fov / 2), for points between pixel centers and the inverse
+      double tanHalfHfov;
+      double tanHalfVfov;
+      std::vector<double> columnYaw;
+      std::vector<double> rowPitch;
+
+      double
+      yaw(double x) const
+      {
+        int column = static_cast<int>(x);
+        if (column == x && column >= 0 && column < static_cast<int>(columnYaw.size()))
+          return columnYaw[column];
+        return atan(2 * (frameWidth / 2 - x) / frameWidth * tanHalfHfov);
+      }
+
+      double
+      pitch(double y) const
+      {
+        int row = static_cast<int>(y);
+        if (row == y && row >= 0 && row < static_cast<int>(rowPitch.size()))
+          return rowPitch[row];
+        return atan(2 * (y - frameHeight / 2) / frameHeight * tanHalfVfov);
+      }
+    };
+
    public:
     /**
      * @brief Constructor
@@ -92,6 +131,53 @@ namespace pandora_vision
     getPOI(const ros::NodeHandle& nh, const pandora_common_msgs::GeneralAlert& result,
            double frameWidth, double frameHeight);
 
+    /**
+     * @brief Batch version of getGeneralAlert for the points of a frame. The
+     * camera's parameters and parent frame are resolved once and yaw and
+     * pitch are looked up per column and row
+     * @param nh [ros::NodeHandle const&] The NodeHandle of the node using this function
+     * @param header [const std_msgs::Header&] The header of the frame
+     * @param points [const std::vector<cv::Point2f>&] The points on the frame
+     * @param frameWidth [double] The width of the frame
+     * @param frameHeight [double] The height of the frame
+     * @param alerts [pandora_common_msgs::GeneralAlertVector*] The alerts, one per
+     * point, with the parent frame in their header and zero probability
+     **/
+    void
+    getGeneralAlerts(const ros::NodeHandle& nh, const std_msgs::Header& header,
+                     const std::vector<cv::Point2f>& points,
+                     double frameWidth, double frameHeight,
+                     pandora_common_msgs::GeneralAlertVector* alerts);
+
+    /**
+     * @brief Batch version of getPOI, the inverse of getGeneralAlerts
+     * @param nh [ros::NodeHandle const&] The NodeHandle of the node using this function
+     * @param frameId [const std::string&] The frame id of the camera
+     * @param alerts [const std::vector<pandora_common_msgs::GeneralAlertInfo>&] The
+     * yaw and pitch of each point, relative to the camera's parent frame
+     * @param frameWidth [double] The width of the frame
+     * @param frameHeight [double] The height of the frame
+     * @param points [std::vector<cv::Point2f>*] The points on the frame, clamped to it
+     **/
+    void
+    getPOIs(const ros::NodeHandle& nh, const std::string& frameId,
+            const std::vector<pandora_common_msgs::GeneralAlertInfo>& alerts,
+            double frameWidth, double frameHeight,
+            std::vector<cv::Point2f>* points);
+
+    /**
+     * @brief Finds the table of a camera at a resolution, building it the first
+     * time the camera is met at that resolution
+     * @param nh [ros::NodeHandle const&] The NodeHandle of the node using this function
+     * @param frameId [const std::string&] The frame id of the camera
+     * @param frameWidth [double] The width of the frame
+     * @param frameHeight [double] The height of the frame
+     * @return [const CameraTable&] The table, valid as long as the converter
+     **/
+    const CameraTable&
+    getCameraTable(const ros::NodeHandle& nh, const std::string& frameId,
+                   double frameWidth, double frameHeight);
+
     /**
      * @brief Function that finds in a dictionary the parent frame id with the frame id
      * as key. If the parameter is not found there, the robot model is searched and when
@@ -136,6 +222,10 @@ namespace pandora_vision
     /// A dictionary that includes Vertical Fields Of View for every camera
     /// with frame id as key
     std::map<std::string, double> vfovDict_;
+
+    /// The tables of every camera and resolution met, with frame id, width
+    /// and height as key
+    std::map<std::pair<std::string, std::pair<int, int> >, CameraTable> cameraTables_;
   };
 
   pandora_common_msgs::GeneralAlert
@@ -144,16 +234,13 @@ namespace pandora_vision
                   double frameWidth, double frameHeight)
   {
     pandora_common_msgs::GeneralAlert alert;
-    double hfov = findHfov(nh, result.header.frame_id);
-    double vfov = findVfov(nh, result.header.frame_id);
+    const CameraTable& table = getCameraTable(nh, result.header.frame_id,
+                                              frameWidth, frameHeight);
     alert.header = result.header;
-    alert.header.frame_id = findParentFrameId(nh, result.header.frame_id,
-                                              "/robot_description");
-    double x = frameWidth / 2 - result.point.x;
-    double y = result.point.y - frameHeight / 2;
+    alert.header.frame_id = table.parentFrameId;
 
-    alert.info.yaw = atan(2 * x / frameWidth * tan(hfov * CV_PI / 360.0f));
-    alert.info.pitch = atan(2 * y / frameHeight * tan(vfov * CV_PI / 360.0f));
+    alert.info.yaw = table.yaw(result.point.x);
+    alert.info.pitch = table.pitch(result.point.y);
     alert.info.probability = result.probability;
 
     return alert;
@@ -164,25 +251,49 @@ namespace pandora_vision
   getGeneralAlertVector(const ros::NodeHandle& nh, const POIsStamped& result)
   {
     pandora_common_msgs::GeneralAlertVector generalAlertInfos;
+    generalAlertInfos.header = result.header;
 
-    std::string parentFrameId = findParentFrameId(nh, result.header.frame_id, "/robot_description");
+    if (result.pois.empty())
+    {
+      generalAlertInfos.header.frame_id = findParentFrameId(nh, result.header.frame_id,
+                                                            "/robot_description");
+      return generalAlertInfos;
+    }
 
-    generalAlertInfos.header = result.header;
-    generalAlertInfos.header.frame_id = parentFrameId;
+    const CameraTable& table = getCameraTable(nh, result.header.frame_id,
+                                              result.frameWidth, result.frameHeight);
+    generalAlertInfos.header.frame_id = table.parentFrameId;
 
+    generalAlertInfos.alerts.resize(result.pois.size());
     for (int i = 0; i < result.pois.size(); ++i) {
-      POIStamped poiStamped;
-      poiStamped.point = result.pois[i]->point;
-      poiStamped.probability = result.pois[i]->probability;
-      poiStamped.header = result.header;
-      pandora_common_msgs::GeneralAlert alert;
-      alert = getGeneralAlert(nh, poiStamped, result.frameWidth, result.frameHeight);
-      generalAlertInfos.alerts.push_back(alert.info);
+      pandora_common_msgs::GeneralAlertInfo& info = generalAlertInfos.alerts[i];
+      info.yaw = table.yaw(result.pois[i]->point.x);
+      info.pitch = table.pitch(result.pois[i]->point.y);
+      info.probability = result.pois[i]->probability;
     }
 
     return generalAlertInfos;
   }
 
+  void
+  GeneralAlertConverter::
+  getGeneralAlerts(const ros::NodeHandle& nh, const std_msgs::Header& header,
+                   const std::vector<cv::Point2f>& points,
+                   double frameWidth, double frameHeight,
+                   pandora_common_msgs::GeneralAlertVector* alerts)
+  {
+    const CameraTable& table = getCameraTable(nh, header.frame_id, frameWidth, frameHeight);
+    alerts->header = header;
+    alerts->header.frame_id = table.parentFrameId;
+
+    alerts->alerts.resize(points.size());
+    for (int i = 0; i < points.size(); ++i) {
+      alerts->alerts[i].yaw = table.yaw(points[i].x);
+      alerts->alerts[i].pitch = table.pitch(points[i].y);
+      alerts->alerts[i].probability = 0;
+    }
+  }
+
   POI
   GeneralAlertConverter::
   getPOI(const ros::NodeHandle& nh, const pandora_common_msgs::GeneralAlert& result,
@@ -191,7 +302,7 @@ namespace pandora_vision
     POI poi;
     std::string child_frame_id;
     std::map<std::string, std::string>::const_iterator iter;
-    for (iter = parentFrameDict_.begin(); iter == parentFrameDict_.end(); ++iter) {
+    for (iter = parentFrameDict_.begin(); iter != parentFrameDict_.end(); ++iter) {
       if (iter->second == result.header.frame_id)
       {
         child_frame_id = iter->first;
@@ -220,6 +331,62 @@ namespace pandora_vision
     return poi;
   }
 
+  void
+  GeneralAlertConverter::
+  getPOIs(const ros::NodeHandle& nh, const std::string& frameId,
+          const std::vector<pandora_common_msgs::GeneralAlertInfo>& alerts,
+          double frameWidth, double frameHeight,
+          std::vector<cv::Point2f>* points)
+  {
+    const CameraTable& table = getCameraTable(nh, frameId, frameWidth, frameHeight);
+    const double xScale = (frameWidth / 2) / table.tanHalfHfov;
+    const double yScale = (frameHeight / 2) / table.tanHalfVfov;
+    const float maxX = static_cast<int>(frameWidth) - 1;
+    const float maxY = static_cast<int>(frameHeight) - 1;
+
+    points->resize(alerts.size());
+    for (int i = 0; i < alerts.size(); ++i) {
+      cv::Point2f& point = (*points)[i];
+      point.x = frameWidth / 2 - tan(alerts[i].yaw) * xScale;
+      point.y = frameHeight / 2 + tan(alerts[i].pitch) * yScale;
+
+      point.x = std::min(std::max(point.x, 0.0f), maxX);
+      point.y = std::min(std::max(point.y, 0.0f), maxY);
+    }
+  }
+
+  const GeneralAlertConverter::CameraTable&
+  GeneralAlertConverter::
+  getCameraTable(const ros::NodeHandle& nh, const std::string& frameId,
+                 double frameWidth, double frameHeight)
+  {
+    std::pair<std::string, std::pair<int, int> > key(frameId,
+        std::make_pair(static_cast<int>(frameWidth), static_cast<int>(frameHeight)));
+    std::map<std::pair<std::string, std::pair<int, int> >, CameraTable>::iterator iter =
+      cameraTables_.find(key);
+    if (iter != cameraTables_.end())
+    {
+      return iter->second;
+    }
+
+    CameraTable table;
+    table.parentFrameId = findParentFrameId(nh, frameId, "/robot_description");
+    table.frameWidth = frameWidth;
+    table.frameHeight = frameHeight;
+    table.tanHalfHfov = tan(findHfov(nh, frameId) * CV_PI / 360.0f);
+    table.tanHalfVfov = tan(findVfov(nh, frameId) * CV_PI / 360.0f);
+
+    table.columnYaw.resize(static_cast<int>(frameWidth));
+    for (int x = 0; x < table.columnYaw.size(); ++x) {
+      table.columnYaw[x] = atan(2 * (frameWidth / 2 - x) / frameWidth * table.tanHalfHfov);
+    }
+    table.rowPitch.resize(static_cast<int>(frameHeight));
+    for (int y = 0; y < table.rowPitch.size(); ++y) {
+      table.rowPitch[y] = atan(2 * (y - frameHeight / 2) / frameHeight * table.tanHalfVfov);
+    }
+    return cameraTables_.insert(std::make_pair(key, table)).first->second;
+  }
+
   double
   GeneralAlertConverter::
   findHfov(const ros::NodeHandle& nh, const std::string& frame_id)
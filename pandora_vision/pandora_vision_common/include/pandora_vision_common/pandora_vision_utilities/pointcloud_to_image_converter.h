@@ -41,6 +41,7 @@
 
 #include <boost/shared_ptr.hpp>
 #include <opencv2/opencv.hpp>
+#include <pcl/point_cloud.h>
 #include <sensor_msgs/PointCloud2.h>
 
 namespace pandora_vision
@@ -58,8 +59,69 @@ namespace pandora_vision
    public:
     cv::Mat convertPclToImage(const sensor_msgs::PointCloud2ConstPtr& pclPtr,
                               int encoding);
+
+    /**
+     * @brief Extracts the color image, the depth image and the validity mask
+     * of a point cloud in a single pass over its buffer. Field offsets are
+     * resolved once, before the pass.
+     * @param cloud [const sensor_msgs::PointCloud2&] cloud with a float32
+     * 'z' field and a packed 'rgb' or 'rgba' field
+     * @param bgr [cv::Mat*] CV_8UC3 output image, NULL to skip
+     * @param depth [cv::Mat*] CV_32FC1 output image, where NaN depths are
+     * set to zero. NULL to skip
+     * @param valid [cv::Mat*] CV_8UC1 output mask, 255 where the depth is
+     * not NaN. NULL to skip
+     * @return [bool] false if the cloud lacks a requested field
+     */
+    static bool
+    extractImages(const sensor_msgs::PointCloud2& cloud,
+        cv::Mat* bgr, cv::Mat* depth, cv::Mat* valid);
+
+    /**
+     * @brief Same as above, for the points of a pcl::PointCloud with 'z' and
+     * 'rgb' members, e.g. pcl::PointXYZRGB
+     */
+    template <class PointT>
+    static void
+    extractImages(const pcl::PointCloud<PointT>& cloud,
+        cv::Mat* bgr, cv::Mat* depth, cv::Mat* valid);
+
+    /**
+     * @brief The extraction kernel, for points laid out with a fixed stride
+     * @param data [const uint8_t*] first point of the cloud
+     * @param rows [int] height of the cloud
+     * @param cols [int] width of the cloud
+     * @param rowStep [size_t] bytes between the first points of two rows
+     * @param pointStep [size_t] bytes between two points of a row
+     * @param depthOffset [size_t] offset of the float depth in a point
+     * @param rgbOffset [size_t] offset of the packed color in a point, whose
+     * bytes are in blue, green, red order
+     */
+    static void
+    extractImages(const uint8_t* data, int rows, int cols,
+        size_t rowStep, size_t pointStep, size_t depthOffset, size_t rgbOffset,
+        cv::Mat* bgr, cv::Mat* depth, cv::Mat* valid);
   };
 
+  template <class PointT>
+  void
+  PointCloudToImageConverter::
+  extractImages(const pcl::PointCloud<PointT>& cloud,
+      cv::Mat* bgr, cv::Mat* depth, cv::Mat* valid)
+  {
+    if (cloud.points.empty())
+    {
+      extractImages(NULL, 0, 0, 0, 0, 0, 0, bgr, depth, valid);
+      return;
+    }
+    const PointT& first = cloud.points[0];
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(&first);
+    size_t depthOffset = reinterpret_cast<const uint8_t*>(&first.z) - data;
+    size_t rgbOffset = reinterpret_cast<const uint8_t*>(&first.rgb) - data;
+    extractImages(data, cloud.height, cloud.width, cloud.width * sizeof(PointT),
+        sizeof(PointT), depthOffset, rgbOffset, bgr, depth, valid);
+  }
+
   typedef PointCloudToImageConverter::Ptr PointCloudToImageConverterPtr;
   typedef PointCloudToImageConverter::ConstPtr PointCloudToImageConverterConstPtr;
 }  // namespace pandora_vision
@@ -63,6 +63,22 @@ namespace pandora_vision
     VisionHandler() {}
     virtual ~VisionHandler() {}
 
+    /**
+      * @brief Constructs and parks the processors up front if the warm pool
+      * is enabled, so that state transitions do not reload them
+      **/
+    virtual void
+    onInit()
+    {
+      DynamicHandler::onInit();
+      if (this->warmPool_)
+      {
+        warmUp<PreProc>("~preprocessor");
+        warmUp<Proc>("~detector");
+        warmUp<PostProc>("~postprocessor");
+      }
+    }
+
    protected:
     /**
       * @brief Function that performs all the needed procedures when the robot's
@@ -72,6 +88,7 @@ namespace pandora_vision
     virtual void
     startTransition(int newState)
     {
+      ros::WallTime begin = ros::WallTime::now();
       this->previousState_ = this->currentState_;
       this->currentState_ = newState;
 
@@ -94,6 +111,8 @@ namespace pandora_vision
         loadPreProcessor<PreProc>("~preprocessor");
         loadProcessor<Proc>("~detector");
         loadPostProcessor<PostProc>("~postprocessor");
+        if (this->typedPipeline_)
+          loadPipeline<PreProc, Proc, PostProc>();
       }
 
       if (this->currentState_ == state_manager_msgs::RobotModeMsg::MODE_TERMINATING)
@@ -107,6 +126,7 @@ namespace pandora_vision
         return;
       }
 
+      reportTransition(begin);
       transitionComplete(this->currentState_);
     }
   };
@@ -37,6 +37,7 @@
  *   Kofinas Miltiadis <mkofinas@gmail.com>
  *********************************************************************/
 
+#include <algorithm>
 #include <vector>
 #include "pandora_vision_common/pandora_vision_utilities/discrete_wavelet_transform.h"
 
@@ -51,11 +52,13 @@ namespace pandora_vision_common
   DiscreteWaveletTransform::DiscreteWaveletTransform(const cv::Mat& columnKernelLow,
       const cv::Mat& columnKernelHigh)
   {
-    columnKernelLow_ = columnKernelLow;
-    cv::transpose(columnKernelLow, rowKernelLow_);
+    CV_Assert(columnKernelLow.rows == columnKernelHigh.rows);
 
-    columnKernelHigh_ = columnKernelHigh;
-    cv::transpose(columnKernelHigh, rowKernelHigh_);
+    columnKernelLow.convertTo(columnKernelLow_, CV_32F);
+    cv::transpose(columnKernelLow_, rowKernelLow_);
+
+    columnKernelHigh.convertTo(columnKernelHigh_, CV_32F);
+    cv::transpose(columnKernelHigh_, rowKernelHigh_);
   }
 
   DiscreteWaveletTransform::~DiscreteWaveletTransform()
@@ -136,146 +139,207 @@ namespace pandora_vision_common
     subSample(imageConvHigh, !rows, subImageHigh);
   }
 
-  std::vector<MatPtr> DiscreteWaveletTransform::getLowLow(const cv::Mat& inImage, int level)
+  namespace
   {
-    std::vector<MatPtr> LLImages;
-    cv::Mat input = inImage.clone();
-
-    for (int ii = 0; ii < level; ii++)
+    /**
+     * @brief Filters a row at every other position, starting from the
+     * second one, i.e. only where the downsampled output keeps a value
+     **/
+    void filterRowAndSubSample(const float* row, const float* kernel,
+        int kernelSize, int channels, int outCols, float* out)
     {
-      cv::Mat imageConvLow = convCols(input, true);
-
-      MatPtr subImageL(new cv::Mat);
-      subSample(imageConvLow, true, subImageL);
-
-      imageConvLow = convRows(*subImageL, true);
-
-      MatPtr subImageLL(new cv::Mat);
-      subSample(imageConvLow, false, subImageLL);
-
-      LLImages.push_back(subImageLL);
-
-      if (ii < level - 1)
+      for (int jj = 0; jj < outCols; jj++)
       {
-        input = subImageLL->clone();
+        const float* taps = row + (2 * jj + 1) * channels;
+        for (int cc = 0; cc < channels; cc++)
+        {
+          float sum = 0.0f;
+          for (int mm = 0; mm < kernelSize; mm++)
+          {
+            sum += kernel[mm] * taps[mm * channels + cc];
+          }
+          out[jj * channels + cc] = sum;
+        }
       }
     }
-    return LLImages;
-  }
 
-  std::vector<MatPtr> DiscreteWaveletTransform::getLowHigh(const cv::Mat& inImage, int level)
-  {
-    std::vector<MatPtr> LHImages;
-    cv::Mat input = inImage.clone();
-
-    for (int ii = 0; ii < level; ii++)
+    /**
+     * @brief Pads a vertically filtered row like the reference transform
+     * pads its input: zeros before, replicated last pixel for kernelSize - 1
+     * pixels after, zeros beyond
+     **/
+    void extendRow(float* row, int anchor, int cols, int kernelSize,
+        int channels, int length)
     {
-      cv::Mat imageConvLow = convCols(input, true);
-
-      MatPtr subImageL(new cv::Mat);
-      subSample(imageConvLow, true, subImageL);
-
-      MatPtr subImageLL(new cv::Mat), subImageLH(new cv::Mat);
-      convAndSubSample(*subImageL, true, subImageLL, subImageLH);
-
-      LHImages.push_back(subImageLH);
-
-      if (ii < level - 1)
+      std::fill(row, row + anchor * channels, 0.0f);
+      const float* last = row + (anchor + cols - 1) * channels;
+      float* pad = row + (anchor + cols) * channels;
+      for (int pp = 0; pp < kernelSize - 1; pp++, pad += channels)
       {
-        input = subImageLL->clone();
+        std::copy(last, last + channels, pad);
       }
+      std::fill(pad, row + length, 0.0f);
     }
-    return LHImages;
-  }
+  }  // namespace
 
-  std::vector<MatPtr> DiscreteWaveletTransform::getHighLow(const cv::Mat& inImage, int level)
+  void DiscreteWaveletTransform::transformLevel(const cv::Mat& inImage,
+      cv::Mat* lowLow, cv::Mat* lowHigh, cv::Mat* highLow, cv::Mat* highHigh)
   {
-    std::vector<MatPtr> HLImages;
-    cv::Mat input = inImage.clone();
-
-    for (int ii = 0; ii < level; ii++)
+    const int kernelSize = columnKernelLow_.rows;
+    const int anchor = kernelSize / 2;
+    const int channels = inImage.channels();
+    const int rowLength = inImage.cols * channels;
+    // The image is filtered as if extended by kernelSize - 1 replicated
+    // rows and columns, keeping every odd row and column of the result
+    const int paddedRows = inImage.rows + kernelSize - 1;
+    const int paddedCols = inImage.cols + kernelSize - 1;
+    const int outRows = paddedRows / 2;
+    const int outCols = paddedCols / 2;
+
+    const float* kernelLow = columnKernelLow_.ptr<float>();
+    const float* kernelHigh = columnKernelHigh_.ptr<float>();
+
+    cv::Mat* outputs[4] = {lowLow, lowHigh, highLow, highHigh};
+    for (int band = 0; band < 4; band++)
     {
-      MatPtr subImageL(new cv::Mat), subImageH(new cv::Mat);
-      convAndSubSample(input, false, subImageL, subImageH);
-
-      cv::Mat imageConvLow = convRows(*subImageH, true);
+      if (outputs[band])
+        outputs[band]->create(outRows, outCols, CV_32FC(channels));
+    }
+    const bool low = lowLow || lowHigh;
+    const bool high = highLow || highHigh;
 
-      MatPtr subImageHL(new cv::Mat);
-      subSample(imageConvLow, false, subImageHL);
+    // Vertically filtered rows, holding pixel x at x + anchor
+    const int extendedLength = (2 * outCols + kernelSize) * channels;
+    rowLow_.resize(extendedLength);
+    rowHigh_.resize(extendedLength);
+    float* rowLowBody = &rowLow_[anchor * channels];
+    float* rowHighBody = &rowHigh_[anchor * channels];
 
-      HLImages.push_back(subImageHL);
+    for (int ii = 0; ii < outRows; ii++)
+    {
+      if (low)
+        std::fill(rowLowBody, rowLowBody + rowLength, 0.0f);
+      if (high)
+        std::fill(rowHighBody, rowHighBody + rowLength, 0.0f);
 
-      if (ii < level - 1)
+      // Only the kept output row is filtered, row by row so that the inner
+      // loops are contiguous and get vectorized
+      for (int kk = 0; kk < kernelSize; kk++)
       {
-        imageConvLow = convRows(*subImageL, true);
-
-        MatPtr subImageLL(new cv::Mat);
-        subSample(imageConvLow, false, subImageLL);
+        int yy = 2 * ii + 1 + kk - anchor;
+        if (yy < 0 || yy >= paddedRows)
+          continue;
+        const float* src = inImage.ptr<float>(std::min(yy, inImage.rows - 1));
+        if (low)
+        {
+          const float weight = kernelLow[kk];
+          for (int xx = 0; xx < rowLength; xx++)
+            rowLowBody[xx] += weight * src[xx];
+        }
+        if (high)
+        {
+          const float weight = kernelHigh[kk];
+          for (int xx = 0; xx < rowLength; xx++)
+            rowHighBody[xx] += weight * src[xx];
+        }
+      }
 
-        input = subImageLL->clone();
+      if (low)
+      {
+        extendRow(&rowLow_[0], anchor, inImage.cols, kernelSize, channels, extendedLength);
+        if (lowLow)
+          filterRowAndSubSample(&rowLow_[0], kernelLow, kernelSize, channels,
+              outCols, lowLow->ptr<float>(ii));
+        if (lowHigh)
+          filterRowAndSubSample(&rowLow_[0], kernelHigh, kernelSize, channels,
+              outCols, lowHigh->ptr<float>(ii));
+      }
+      if (high)
+      {
+        extendRow(&rowHigh_[0], anchor, inImage.cols, kernelSize, channels, extendedLength);
+        if (highLow)
+          filterRowAndSubSample(&rowHigh_[0], kernelLow, kernelSize, channels,
+              outCols, highLow->ptr<float>(ii));
+        if (highHigh)
+          filterRowAndSubSample(&rowHigh_[0], kernelHigh, kernelSize, channels,
+              outCols, highHigh->ptr<float>(ii));
       }
     }
-    return HLImages;
   }
 
-  std::vector<MatPtr> DiscreteWaveletTransform::getHighHigh(const cv::Mat& inImage, int level)
+  std::vector<MatPtr> DiscreteWaveletTransform::transform(const cv::Mat& inImage,
+      int level, int subbands)
   {
-    std::vector<MatPtr> HHImages;
-    cv::Mat input = inImage.clone();
+    std::vector<MatPtr> result;
+    cv::Mat input = inImage;
+    if (inImage.depth() != CV_32F)
+    {
+      inImage.convertTo(floatInput_, CV_32F);
+      input = floatInput_;
+    }
+    if (static_cast<int>(levelBuffers_.size()) < level)
+    {
+      levelBuffers_.resize(level);
+    }
 
     for (int ii = 0; ii < level; ii++)
     {
-      MatPtr subImageL(new cv::Mat), subImageH(new cv::Mat);
-      convAndSubSample(input, false, subImageL, subImageH);
-
-      cv::Mat imageConvHigh = convRows(*subImageH, false);
-
-      MatPtr subImageHH(new cv::Mat);
-      subSample(imageConvHigh, false, subImageHH);
+      MatPtr bands[4];
+      cv::Mat* outputs[4];
+      for (int band = 0; band < 4; band++)
+      {
+        outputs[band] = NULL;
+        if (subbands & (1 << band))
+        {
+          bands[band].reset(new cv::Mat);
+          outputs[band] = bands[band].get();
+        }
+      }
+      // The LL subband feeds the next level even if it is not returned, in
+      // which case it lives in a buffer of this level
+      if (outputs[0] == NULL && ii < level - 1)
+      {
+        outputs[0] = &levelBuffers_[ii];
+      }
 
-      HHImages.push_back(subImageHH);
+      transformLevel(input, outputs[0], outputs[1], outputs[2], outputs[3]);
 
+      for (int band = 0; band < 4; band++)
+      {
+        if (bands[band])
+          result.push_back(bands[band]);
+      }
       if (ii < level - 1)
       {
-        cv::Mat imageConvLow = convRows(*subImageL, true);
-
-        MatPtr subImageLL(new cv::Mat);
-        subSample(imageConvLow, false, subImageLL);
-
-        input = subImageLL->clone();
+        input = *outputs[0];
       }
     }
-    return HHImages;
+    return result;
   }
 
-  std::vector<MatPtr> DiscreteWaveletTransform::dwt2D(const cv::Mat& inImage, int level)
+  std::vector<MatPtr> DiscreteWaveletTransform::getLowLow(const cv::Mat& inImage, int level)
   {
-    std::vector<MatPtr> dwtImages;
-    cv::Mat input = inImage.clone();
-
-    for (int ii = 0; ii < level; ii++)
-    {
-      MatPtr subImageL(new cv::Mat), subImageH(new cv::Mat);
-      convAndSubSample(input, false, subImageL, subImageH);
-
-      MatPtr subImageLL(new cv::Mat), subImageLH(new cv::Mat);
-      convAndSubSample(*subImageL, true, subImageLL, subImageLH);
+    return transform(inImage, level, 1);
+  }
 
-      dwtImages.push_back(subImageLL);
-      dwtImages.push_back(subImageLH);
+  std::vector<MatPtr> DiscreteWaveletTransform::getLowHigh(const cv::Mat& inImage, int level)
+  {
+    return transform(inImage, level, 1 << 1);
+  }
 
-      MatPtr subImageHL(new cv::Mat), subImageHH(new cv::Mat);
-      convAndSubSample(*subImageH, true, subImageHL, subImageHH);
+  std::vector<MatPtr> DiscreteWaveletTransform::getHighLow(const cv::Mat& inImage, int level)
+  {
+    return transform(inImage, level, 1 << 2);
+  }
 
-      dwtImages.push_back(subImageHL);
-      dwtImages.push_back(subImageHH);
+  std::vector<MatPtr> DiscreteWaveletTransform::getHighHigh(const cv::Mat& inImage, int level)
+  {
+    return transform(inImage, level, 1 << 3);
+  }
 
-      if (ii < level - 1)
-      {
-        input = subImageLL->clone();
-      }
-    }
-    return dwtImages;
+  std::vector<MatPtr> DiscreteWaveletTransform::dwt2D(const cv::Mat& inImage, int level)
+  {
+    return transform(inImage, level, 0xF);
   }
 
 }  // namespace pandora_vision_common
@@ -0,0 +1,152 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#include <string>
+#include "pandora_vision_common/pandora_vision_utilities/frame_derivative_cache.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_common
+{
+  FrameDerivatives::FrameDerivatives(const cv::Mat& frame,
+      const boost::shared_ptr<void const>& frameOwner) :
+    frame_(frame), frameOwner_(frameOwner)
+  {
+  }
+
+  const cv::Mat& FrameDerivatives::computeGray()
+  {
+    if (gray_.empty())
+      cv::cvtColor(frame_, gray_, CV_BGR2GRAY);
+    return gray_;
+  }
+
+  const cv::Mat& FrameDerivatives::getGray()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    return computeGray();
+  }
+
+  const cv::Mat& FrameDerivatives::getHsv()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (hsv_.empty())
+      cv::cvtColor(frame_, hsv_, CV_BGR2HSV);
+    return hsv_;
+  }
+
+  const cv::Mat& FrameDerivatives::getPyramidLevel(int level)
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (pyramid_.empty())
+      pyramid_.push_back(computeGray());
+    // Each level is built from the previous one, so only the missing
+    // levels are computed
+    while (static_cast<int>(pyramid_.size()) <= level)
+    {
+      cv::Mat next;
+      cv::pyrDown(pyramid_.back(), next);
+      pyramid_.push_back(next);
+    }
+    return pyramid_[level];
+  }
+
+  const cv::Mat& FrameDerivatives::getGradientX()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (gradientX_.empty())
+      cv::Sobel(computeGray(), gradientX_, CV_32F, 1, 0, 3);
+    return gradientX_;
+  }
+
+  const cv::Mat& FrameDerivatives::getGradientY()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (gradientY_.empty())
+      cv::Sobel(computeGray(), gradientY_, CV_32F, 0, 1, 3);
+    return gradientY_;
+  }
+
+  FrameDerivativeCache& FrameDerivativeCache::getInstance()
+  {
+    // Lives in this library, so it is shared by all the vision nodelets
+    // loaded in the same manager
+    static FrameDerivativeCache instance;
+    return instance;
+  }
+
+  FrameDerivativesPtr FrameDerivativeCache::get(const std_msgs::Header& header,
+      const std::string& encoding, const cv::Mat& frame,
+      const boost::shared_ptr<void const>& frameOwner)
+  {
+    // Unstamped frames cannot be told apart from each other
+    if (header.stamp.isZero())
+      return FrameDerivativesPtr(new FrameDerivatives(frame, frameOwner));
+
+    boost::mutex::scoped_lock lock(mutex_);
+    Key key(header.stamp, header.frame_id, encoding);
+    EntryMap::iterator it = entries_.find(key);
+    if (it != entries_.end())
+    {
+      FrameDerivativesPtr derivatives = it->second.lock();
+      if (derivatives && derivatives->getFrame().size() == frame.size())
+        return derivatives;
+    }
+
+    FrameDerivativesPtr derivatives(new FrameDerivatives(frame, frameOwner));
+    entries_[key] = derivatives;
+
+    // Entries of frames that nobody processes anymore are dropped here, the
+    // map holds only as many frames as are in flight
+    for (it = entries_.begin(); it != entries_.end(); )
+    {
+      if (it->second.expired())
+        entries_.erase(it++);
+      else
+        ++it;
+    }
+    return derivatives;
+  }
+
+  size_t FrameDerivativeCache::size()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    return entries_.size();
+  }
+}  // namespace pandora_vision_common
+}  // namespace pandora_vision
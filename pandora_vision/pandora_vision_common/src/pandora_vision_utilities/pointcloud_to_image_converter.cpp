@@ -38,8 +38,9 @@
  *   Chatzieleftheriou Eirini <eirini.ch0@gmail.com>
  *********************************************************************/
 
-#include <cv_bridge/cv_bridge.h>
-#include <pcl_conversions/pcl_conversions.h>
+#include <cstring>
+
+#include <ros/ros.h>
 #include <sensor_msgs/Image.h>
 
 #include "pandora_vision_common/pandora_vision_utilities/pointcloud_to_image_converter.h"
@@ -57,41 +58,115 @@ namespace pandora_vision
   cv::Mat PointCloudToImageConverter::convertPclToImage(const sensor_msgs::PointCloud2ConstPtr& pclPtr,
       int encoding)
   {
-    pcl::PointCloud<pcl::PointXYZRGB>::Ptr pointCloud(new pcl::PointCloud<pcl::PointXYZRGB>);
-    pcl::fromROSMsg<pcl::PointXYZRGB>(*pclPtr, *pointCloud);
-
-    // Prepare the output image
-    cv::Mat image(pointCloud->height, pointCloud->width, encoding);
-
+    cv::Mat image;
     // For the depth image
     if (encoding == CV_32FC1)
     {
-      for (unsigned int row = 0; row < pointCloud->height; ++row) {
-        for (unsigned int col = 0; col < pointCloud->width; ++col) {
-          image.at<float>(row, col) =
-            pointCloud->points[col + pointCloud->width * row].z;
-
-          // if element is nan make it a zero
-          if (image.at<float>(row, col) != image.at<float>(row, col))
-          {
-            image.at<float>(row, col) = 0.0;
-          }
-        }
-      }
+      extractImages(*pclPtr, NULL, &image, NULL);
     }
     else if (encoding == CV_8UC3)  // For the rgb image
     {
-      for (unsigned int row = 0; row < pointCloud->height; ++row) {
-        for (unsigned int col = 0; col < pointCloud->width; ++col) {
-          image.at<unsigned char>(row, 3 * col + 2) =
-            pointCloud->points[col + pointCloud->width * row].r;
-          image.at<unsigned char>(row, 3 * col + 1) =
-            pointCloud->points[col + pointCloud->width * row].g;
-          image.at<unsigned char>(row, 3 * col + 0) =
-            pointCloud->points[col + pointCloud->width * row].b;
+      extractImages(*pclPtr, &image, NULL, NULL);
+    }
+    else
+    {
+      image.create(pclPtr->height, pclPtr->width, encoding);
+    }
+    return image;
+  }
+
+  bool PointCloudToImageConverter::extractImages(const sensor_msgs::PointCloud2& cloud,
+      cv::Mat* bgr, cv::Mat* depth, cv::Mat* valid)
+  {
+    int depthIndex = -1, rgbIndex = -1;
+    for (size_t ii = 0; ii < cloud.fields.size(); ++ii)
+    {
+      if (cloud.fields[ii].name == "z")
+        depthIndex = ii;
+      else if (cloud.fields[ii].name == "rgb" || cloud.fields[ii].name == "rgba")
+        rgbIndex = ii;
+    }
+    if ((depth || valid) && (depthIndex < 0 ||
+          cloud.fields[depthIndex].datatype != sensor_msgs::PointField::FLOAT32))
+    {
+      ROS_ERROR("[PointCloudToImageConverter] Point cloud has no float32 'z' field");
+      return false;
+    }
+    if (bgr && rgbIndex < 0)
+    {
+      ROS_ERROR("[PointCloudToImageConverter] Point cloud has no 'rgb' field");
+      return false;
+    }
+    if (cloud.data.empty())
+    {
+      extractImages(NULL, 0, 0, 0, 0, 0, 0, bgr, depth, valid);
+      return true;
+    }
+
+    extractImages(&cloud.data[0], cloud.height, cloud.width, cloud.row_step, cloud.point_step,
+        depthIndex < 0 ? 0 : cloud.fields[depthIndex].offset,
+        rgbIndex < 0 ? 0 : cloud.fields[rgbIndex].offset,
+        bgr, depth, valid);
+    return true;
+  }
+
+  void PointCloudToImageConverter::extractImages(const uint8_t* data, int rows, int cols,
+      size_t rowStep, size_t pointStep, size_t depthOffset, size_t rgbOffset,
+      cv::Mat* bgr, cv::Mat* depth, cv::Mat* valid)
+  {
+    if (bgr)
+      bgr->create(rows, cols, CV_8UC3);
+    // The mask needs the depth values, so they are extracted anyway
+    cv::Mat depthBuffer;
+    if (depth)
+      depth->create(rows, cols, CV_32FC1);
+    else if (valid)
+      depthBuffer.create(1, cols, CV_32FC1);
+    if (valid)
+      valid->create(rows, cols, CV_8UC1);
+
+    for (int row = 0; row < rows; ++row)
+    {
+      const uint8_t* point = data + row * rowStep;
+      uint8_t* color = bgr ? bgr->ptr<uint8_t>(row) : NULL;
+      float* z = depth ? depth->ptr<float>(row) :
+        (valid ? depthBuffer.ptr<float>() : NULL);
+      uint8_t* mask = valid ? valid->ptr<uint8_t>(row) : NULL;
+
+      // Gather both fields of each point while it is in cache
+      for (int col = 0; col < cols; ++col, point += pointStep)
+      {
+        if (z)
+          memcpy(z + col, point + depthOffset, sizeof(float));
+        if (color)
+        {
+          const uint8_t* rgb = point + rgbOffset;
+          color[3 * col + 0] = rgb[0];
+          color[3 * col + 1] = rgb[1];
+          color[3 * col + 2] = rgb[2];
+        }
+      }
+
+      if (z == NULL)
+        continue;
+      // NaN depths become zeros. Contiguous and branch free, so that the
+      // compiler vectorizes it
+      if (mask)
+      {
+        for (int col = 0; col < cols; ++col)
+        {
+          const bool isValid = (z[col] == z[col]);
+          mask[col] = isValid ? 255 : 0;
+          z[col] = isValid ? z[col] : 0.0f;
+        }
+      }
+      else
+      {
+        for (int col = 0; col < cols; ++col)
+        {
+          z[col] = (z[col] == z[col]) ? z[col] : 0.0f;
         }
       }
     }
-    return image;
   }
 }  // namespace pandora_vision
@@ -39,7 +39,9 @@
 
 #include <vector>
 #include <cmath>
+#include <iostream>
 #include <gtest/gtest.h>
+#include <ros/time.h>
 #include "pandora_vision_common/pandora_vision_utilities/discrete_wavelet_transform.h"
 
 namespace pandora_vision
@@ -72,6 +74,49 @@ namespace pandora_vision_common
         return dwtPtr_->subSample(image, rows, subImage);
       }
 
+      /**
+       * @brief The transform computed step by step, filtering the whole
+       * image and downsampling afterwards, as a reference for the single
+       * pass implementation
+       **/
+      std::vector<MatPtr> referenceDwt2D(DiscreteWaveletTransform* dwt,
+          const cv::Mat& inImage, int level)
+      {
+        std::vector<MatPtr> dwtImages;
+        cv::Mat input = inImage.clone();
+
+        for (int ii = 0; ii < level; ii++)
+        {
+          MatPtr subImageL(new cv::Mat), subImageH(new cv::Mat);
+          dwt->convAndSubSample(input, false, subImageL, subImageH);
+
+          MatPtr subImageLL(new cv::Mat), subImageLH(new cv::Mat);
+          dwt->convAndSubSample(*subImageL, true, subImageLL, subImageLH);
+          MatPtr subImageHL(new cv::Mat), subImageHH(new cv::Mat);
+          dwt->convAndSubSample(*subImageH, true, subImageHL, subImageHH);
+
+          dwtImages.push_back(subImageLL);
+          dwtImages.push_back(subImageLH);
+          dwtImages.push_back(subImageHL);
+          dwtImages.push_back(subImageHH);
+
+          input = subImageLL->clone();
+        }
+        return dwtImages;
+      }
+
+      void expectEqual(const std::vector<MatPtr>& expected,
+          const std::vector<MatPtr>& actual)
+      {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (int ii = 0; ii < expected.size(); ii++)
+        {
+          ASSERT_EQ(expected[ii]->size(), actual[ii]->size());
+          ASSERT_EQ(expected[ii]->type(), actual[ii]->type());
+          EXPECT_NEAR(0, cv::norm(*expected[ii], *actual[ii], cv::NORM_INF), 1e-2);
+        }
+      }
+
     protected:
       virtual void SetUp() {}
 
@@ -298,5 +343,66 @@ namespace pandora_vision_common
       }
     }
   }
+
+  TEST_F(DiscreteWaveletTransformTest, isSinglePassEqualToReference)
+  {
+    // Odd sizes, several channels and a longer kernel exercise the borders
+    cv::Mat image(61, 83, CV_32FC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+    expectEqual(referenceDwt2D(dwtPtr_.get(), image, 3), dwtPtr_->dwt2D(image, 3));
+
+    cv::Mat kernelLow = (cv::Mat_<float>(4, 1) << 0.4829629f, 0.8365163f,
+        0.2241439f, - 0.1294095f);
+    cv::Mat kernelHigh = (cv::Mat_<float>(4, 1) << - 0.1294095f, - 0.2241439f,
+        0.8365163f, - 0.4829629f);
+    DiscreteWaveletTransform daubechies(kernelLow, kernelHigh);
+    std::vector<MatPtr> expected = referenceDwt2D(&daubechies, image, 3);
+    expectEqual(expected, daubechies.dwt2D(image, 3));
+
+    // The single subband accessors return the same levels
+    std::vector<MatPtr> lowHigh = daubechies.getLowHigh(image, 3);
+    ASSERT_EQ(3, lowHigh.size());
+    for (int ii = 0; ii < lowHigh.size(); ii++)
+    {
+      EXPECT_NEAR(0, cv::norm(*expected[4 * ii + 1], *lowHigh[ii], cv::NORM_INF), 1e-2);
+    }
+  }
+
+  TEST_F(DiscreteWaveletTransformTest, benchmarkMultiLevelThroughput)
+  {
+    const int frames = 20;
+    const int level = 3;
+    cv::Mat image(480, 640, CV_32FC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(255));
+
+    ros::WallTime begin = ros::WallTime::now();
+    for (int ii = 0; ii < frames; ii++)
+    {
+      referenceDwt2D(dwtPtr_.get(), image, level);
+    }
+    double referenceTime = (ros::WallTime::now() - begin).toSec() / frames;
+
+    begin = ros::WallTime::now();
+    for (int ii = 0; ii < frames; ii++)
+    {
+      dwtPtr_->dwt2D(image, level);
+    }
+    double dwtTime = (ros::WallTime::now() - begin).toSec() / frames;
+
+    begin = ros::WallTime::now();
+    for (int ii = 0; ii < frames; ii++)
+    {
+      dwtPtr_->getLowHigh(image, level);
+    }
+    double lowHighTime = (ros::WallTime::now() - begin).toSec() / frames;
+
+    std::cout << "[ BENCHMARK ] 640x480, " << level << " levels" << std::endl;
+    std::cout << "[ BENCHMARK ] filter and downsample: " << 1.0 / referenceTime
+      << " frames/s" << std::endl;
+    std::cout << "[ BENCHMARK ] single pass dwt2D:     " << 1.0 / dwtTime
+      << " frames/s" << std::endl;
+    std::cout << "[ BENCHMARK ] single pass LH only:   " << 1.0 / lowHighTime
+      << " frames/s" << std::endl;
+  }
 }  // namespace pandora_vision_common
 }  // namespace pandora_vision
@@ -0,0 +1,124 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Tsirigotis Christos <tsirif@gmail.com>
+ *********************************************************************/
+
+#include <string>
+#include <gtest/gtest.h>
+#include "pandora_vision_common/pandora_vision_utilities/frame_derivative_cache.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_common
+{
+  class FrameDerivativeCacheTest : public ::testing::Test
+  {
+    protected:
+      virtual void SetUp()
+      {
+        frame_ = cv::Mat(48, 64, CV_8UC3);
+        cv::randu(frame_, cv::Scalar::all(0), cv::Scalar::all(255));
+        header_.stamp = ros::Time(10, 0);
+        header_.frame_id = "camera";
+      }
+
+      FrameDerivativesPtr get(const std_msgs::Header& header)
+      {
+        return FrameDerivativeCache::getInstance().get(header, "bgr8", frame_,
+            boost::shared_ptr<void const>());
+      }
+
+      cv::Mat frame_;
+      std_msgs::Header header_;
+  };
+
+  TEST_F(FrameDerivativeCacheTest, sameFrameIsShared)
+  {
+    FrameDerivativesPtr first = get(header_);
+    FrameDerivativesPtr second = get(header_);
+    EXPECT_EQ(first.get(), second.get());
+
+    std_msgs::Header otherHeader = header_;
+    otherHeader.stamp = ros::Time(10, 1);
+    FrameDerivativesPtr third = get(otherHeader);
+    EXPECT_NE(first.get(), third.get());
+
+    // Unstamped frames are never shared
+    std_msgs::Header unstamped = header_;
+    unstamped.stamp = ros::Time();
+    EXPECT_NE(get(unstamped).get(), get(unstamped).get());
+  }
+
+  TEST_F(FrameDerivativeCacheTest, releasedFramesAreDropped)
+  {
+    std_msgs::Header header = header_;
+    header.stamp = ros::Time(20, 0);
+    FrameDerivativesPtr held = get(header);
+    size_t size = FrameDerivativeCache::getInstance().size();
+
+    for (int ii = 1; ii < 10; ++ii)
+    {
+      header.stamp = ros::Time(20, ii);
+      get(header);
+    }
+    EXPECT_GE(size + 1, FrameDerivativeCache::getInstance().size());
+
+    header.stamp = ros::Time(20, 0);
+    EXPECT_EQ(held.get(), get(header).get());
+  }
+
+  TEST_F(FrameDerivativeCacheTest, derivativesAreCorrect)
+  {
+    FrameDerivativesPtr derivatives = get(header_);
+
+    cv::Mat gray, hsv, gradientX, halfGray;
+    cv::cvtColor(frame_, gray, CV_BGR2GRAY);
+    cv::cvtColor(frame_, hsv, CV_BGR2HSV);
+    cv::Sobel(gray, gradientX, CV_32F, 1, 0, 3);
+    cv::pyrDown(gray, halfGray);
+
+    EXPECT_EQ(0, cv::norm(gray, derivatives->getGray(), cv::NORM_INF));
+    EXPECT_EQ(0, cv::norm(hsv, derivatives->getHsv(), cv::NORM_INF));
+    EXPECT_EQ(0, cv::norm(gradientX, derivatives->getGradientX(), cv::NORM_INF));
+    EXPECT_EQ(0, cv::norm(halfGray, derivatives->getPyramidLevel(1), cv::NORM_INF));
+    EXPECT_EQ(12, derivatives->getPyramidLevel(2).rows);
+    EXPECT_EQ(16, derivatives->getPyramidLevel(2).cols);
+
+    // Computed once, then handed out as is
+    EXPECT_EQ(derivatives->getGray().data, derivatives->getGray().data);
+  }
+}  // namespace pandora_vision_common
+}  // namespace pandora_vision
@@ -46,6 +46,7 @@
 #include "depth_node/utils/message_conversions.h"
 #include "depth_node/utils/wavelets.h"
 #include "pandora_vision_hole/CandidateHolesVectorMsg.h"
+#include "synchronizer/synchronized_frame.h"
 
 /**
   @namespace pandora_vision
@@ -83,17 +84,19 @@ namespace depth
     onInit();
 
     /**
-      @brief Callback for the depth image received by the synchronizer node.
+      @brief Callback for the frame published by the synchronizer node.
 
-      The depth image message received by the synchronizer node is unpacked
-      in a cv::Mat image and stripped of its noise.
+      The frame's interpolated depth image is viewed as a cv::Mat image,
+      without being copied.
       Holes are then located inside this image and information about them,
       along with the denoised image, is then sent to the hole fusion node
-      @param msg [const sensor_msgs::Image&] The depth image message
+      @param msg [const SynchronizedFrameConstPtr&]
+      The synchronized frame
       @return void
       **/
     void
-    inputDepthImageCallback(const sensor_msgs::ImageConstPtr& msg);
+    inputDepthImageCallback(
+        const SynchronizedFrameConstPtr& msg);
 
     /**
       @brief The function called when a parameter is changed
@@ -122,10 +125,11 @@ namespace depth
     // The private ROS node handle
     ros::NodeHandle privateNodeHandle_;
 
-    // Subscriber of Kinect point cloud
+    // Subscriber of the synchronized frames
     ros::Subscriber depthImageSubscriber_;
 
-    // The name of the topic where the depth image is acquired from
+    // The name of the topic where the synchronized frames, and so the
+    // depth image, are acquired from
     std::string depthImageTopic_;
 
     // ROS publisher for the candidate holes
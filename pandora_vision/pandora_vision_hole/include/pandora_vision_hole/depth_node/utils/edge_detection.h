@@ -259,23 +259,11 @@ namespace depth
        **/
       static void floodFillPostprocess(cv::Mat* image);
 
-      /**
-        @brief Identifies in which curve a point lies on and returns the
-        curve's two end points.
-        @param[in] img [cv::Mat*] The input binary image
-        @param[in] x_ [const int&] The x coordinate of the point
-        @param[in] y_ [const int&] The y coordinate of the point
-        @param[out] ret [std::set<unsigned int>&] The points that represent the
-        curve on which the point lies on
-        @return edgePoints [std::pair<GraphNode, GraphNode>*] The curve's pair
-        of end points
-       **/
-      static std::pair<GraphNode, GraphNode> identifyCurveAndEndpoints(
-        cv::Mat* img, const int& x_, const int& y_, std::set<unsigned int>* ret);
-
       /**
         @brief Given an image of CV_8UC1 format, this method locates and
         identifies all continuous curves, along with their end-points.
+        Curves are labelled in a single pass over the image and the end-points
+        of each are the two lying the farthest apart along it.
         CAUTION: the length of each curve must exceed a certain threshold.
         @param[in,out] image [cv::Mat*] The image whose curves and their
         endpoints one wishes to locate and identify. CAUTION: image is cleared
@@ -39,11 +39,14 @@
 #define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_DEPTH_FILTERS_H
 
 #include <math.h>
+#include <string>
+#include <vector>
 #include "hole_fusion_node/utils/holes_conveyor.h"
 #include "hole_fusion_node/utils/outline_discovery.h"
 #include "hole_fusion_node/utils/edge_detection.h"
 #include "hole_fusion_node/utils/visualization.h"
 #include "hole_fusion_node/planes_detection.h"
+#include "utils/region.h"
 
 /**
   @namespace pandora_vision
@@ -67,10 +70,9 @@ namespace hole_fusion
         @brief Checks for valid holes by area / depth comparison
         @param[in] conveyor [const HolesConveyor&] The candidate holes
         @param[in] depthImage [const cv::Mat&] The depth image
-        @param[in] holesMasksSetVector
-        [const std::vector<std::set<unsigned int> >&]
-        A vector that holds sets of points; each point is internal to its
-        respective hole
+        @param[in] holesMasksRegionVector
+        [const std::vector<Region>&]
+        A vector that holds the region of the points inside each hole
         @param[out] msgs [std::vector<std::string>*] Messages for debug
         reasons
         @param[out] probabilitiesVector [std::vector<float>*] A vector
@@ -79,14 +81,17 @@ namespace hole_fusion
         While the returned set may be reduced in size, the size of this vector
         is the same throughout and equal to the number of keypoints found and
         published by the rgb node
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesDepthArea(
         const HolesConveyor& conveyor,
         const cv::Mat& depthImage,
-        const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+        const std::vector<Region>& holesMasksRegionVector,
         std::vector<std::string>* msgs,
-        std::vector<float>* probabilitiesVector);
+        std::vector<float>* probabilitiesVector,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief Checks for valid holes just by the depth difference between
@@ -109,6 +114,8 @@ namespace hole_fusion
         While the returned set may be reduced in size, the size of this vector
         is the same throughout and equal to the number of keypoints found and
         published by the rgb node
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesDepthDiff(
@@ -117,19 +124,19 @@ namespace hole_fusion
         const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
         const std::vector<int>& inflatedRectanglesIndices,
         std::vector<std::string>* msgs,
-        std::vector<float>* probabilitiesVector);
+        std::vector<float>* probabilitiesVector,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief Checks the homogeneity of the gradient of an interpolated
         depth image in areas denoted by the points inside the
-        holesMasksSetVector vector
+        holesMasksRegionVector vector
         @param[in] conveyor [const HolesConveyor&] The candidate holes
         @param[in] interpolatedDepthImage [const cv::Mat&] The input
         interpolated depth image
-        @param[in] holesMasksSetVector
-        [const std::vector<std::set<unsigned int> >&]
-        A vector that holds sets of points; each point is internal to its
-        respective hole
+        @param[in] holesMasksRegionVector
+        [const std::vector<Region>&]
+        A vector that holds the region of the points inside each hole
         @param[out] msgs [std::vector<std::string>*] Debug messages
         @param[out] probabilitiesVector [std::vector<float>*] A vector
         of probabilities, each position of which hints to the certainty degree
@@ -137,14 +144,17 @@ namespace hole_fusion
         While the returned set may be reduced in size, the size of this vector
         is the same throughout and equal to the number of keypoints found and
         published by the rgb node
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesDepthHomogeneity(
         const HolesConveyor& conveyor,
         const cv::Mat& interpolatedDepthImage,
-        const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+        const std::vector<Region>& holesMasksRegionVector,
         std::vector<std::string>* msgs,
-        std::vector<float>* probabilitiesVector);
+        std::vector<float>* probabilitiesVector,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief If the intermediate points (points between a hole's outline
@@ -153,11 +163,11 @@ namespace hole_fusion
         considered valid, the @param probabilitiesVector hint to the
         validity of the candidate hole through this filter
         @param[in] inImage [const cv::Mat&] The input depth image
-        @param[in] initialPointCloud [const PointCloudPtr&]
+        @param[in] initialPointCloud [const PointCloudConstPtr&]
         The point cloud acquired from the depth sensor, interpolated
-        @param[in] intermediatePointsSetVector
-        [const std::vector<std::set<unsigned int> >& ] A vector that holds for
-        each hole a set of points;
+        @param[in] intermediatePointsRegionVector
+        [const std::vector<Region>& ] A vector that holds for
+        each hole a region of points;
         these points are the points between the hole's outline and its
         bounding rectangle
         @param[in] inflatedRectanglesIndices [const std::vector<int>&] Because
@@ -173,15 +183,18 @@ namespace hole_fusion
         published by the rgb node
         @param[out] msgs [std::vector<std::string>*] Messages for
         debug reasons
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesOutlineToRectanglePlaneConstitution(
         const cv::Mat& inImage,
-        const PointCloudPtr& initialPointCloud,
-        const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+        const PointCloudConstPtr& initialPointCloud,
+        const std::vector<Region>& intermediatePointsRegionVector,
         const std::vector<int>& inflatedRectanglesIndices,
         std::vector<float>* probabilitiesVector,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief All the points that lie on the (edges of the) rectangle should
@@ -189,7 +202,7 @@ namespace hole_fusion
         planes are considered valid, the @param probabilitiesVector hint
         to the validity of the candidate hole through this filter
         @param[in] inImage [const cv::Mat&] The input depth image
-        @param[in] initialPointCloud [const PointCloudPtr&]
+        @param[in] initialPointCloud [const PointCloudConstPtr&]
         The point cloud acquired from the depth sensor, interpolated
         @param[in] inflatedRectanglesVector
         [const std::vector<std::vector<cv::Point2f> >&] A vector that holds
@@ -208,15 +221,18 @@ namespace hole_fusion
         published by the rgb node
         @param[out] msgs [std::vector<std::string>*] Messages for
         debug reasons
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesRectangleEdgesPlaneConstitution(
         const cv::Mat& inImage,
-        const PointCloudPtr& initialPointCloud,
+        const PointCloudConstPtr& initialPointCloud,
         const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
         const std::vector<int>& inflatedRectanglesIndices,
         std::vector<float>* probabilitiesVector,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
   };
 
 }  // namespace hole_fusion
@@ -39,8 +39,11 @@
 #define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_FILTERS_H
 
 #include <math.h>
+#include <string>
+#include <vector>
 #include "hole_fusion_node/planes_detection.h"
 #include "hole_fusion_node/depth_filters.h"
+#include "hole_fusion_node/hole_validation.h"
 #include "hole_fusion_node/rgb_filters.h"
 #include "hole_fusion_node/utils/edge_detection.h"
 #include "hole_fusion_node/utils/histogram.h"
@@ -48,6 +51,7 @@
 #include "hole_fusion_node/utils/morphological_operators.h"
 #include "hole_fusion_node/utils/outline_discovery.h"
 #include "hole_fusion_node/utils/parameters.h"
+#include "utils/region.h"
 #include "hole_fusion_node/utils/visualization.h"
 
 /**
@@ -68,6 +72,29 @@ namespace hole_fusion
   class Filters
   {
     public:
+      //  The largest filter identifier
+      static const int NUMBER_OF_FILTERS = 9;
+
+      /**
+        @brief The running totals of a filter, since the statistics were
+        last reset
+       **/
+      struct FilterStatistics
+      {
+        //  The number of frames the filter was applied to
+        unsigned int frames;
+
+        //  The time spent applying it, in milliseconds
+        double milliseconds;
+
+        //  The number of candidate holes it was applied to
+        unsigned int evaluated;
+
+        //  The number of candidate holes found unable to be valid right
+        //  after it was applied, which no later filter was applied to
+        unsigned int rejected;
+      };
+
       /**
         @brief Applies a specific active filter, either from an RGB
         or a Depth sources.
@@ -81,10 +108,10 @@ namespace hole_fusion
         The rgb image
         @param[in] inHistogram [const std::vector<cv::MatND>&]
         The vector of model histograms
-        @param[in] pointCloud [const PointCloudPtr&]
+        @param[in] pointCloud [const PointCloudConstPtr&]
         The original point cloud that corresponds to the input depth image
-        @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-        A vector that holds sets of points's indices;
+        @param[in] holesMasksRegionVector [const std::vector<Region>&]
+        A vector that holds a region of points for each hole;
         each point is internal to its respective hole
         @param[in] holesMasksImageVector [const std::vector<cv::Mat>&]
         A vector containing masks of the points inside each hole's outline
@@ -96,9 +123,9 @@ namespace hole_fusion
         A vector that is used to identify a hole's corresponding rectangle.
         Used primarily because the rectangles used are inflated rectangles;
         not all holes possess an inflated rectangle
-        @param[in] intermediatePointsSetVector
-        [const std::vector<std::set<unsigned int> >& ] A vector that holds for
-        each hole a set of points' indices; these points are the points
+        @param[in] intermediatePointsRegionVector
+        [const std::vector<Region>& ] A vector that holds for
+        each hole a region of points; these points are the points
         between the hole's outline and its bounding rectangle
         @param[in] intermediatePointsImageVector [const std::vector<cv::Mat>&]
         A vector containing masks of the points outside each hole's outline,
@@ -114,6 +141,8 @@ namespace hole_fusion
         valid by each filter
         @param[out] msgs [std::vector<std::string>*]
         Debug messages
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void applyFilter(
@@ -122,21 +151,25 @@ namespace hole_fusion
         const cv::Mat& depthImage,
         const cv::Mat& rgbImage,
         const std::vector<cv::MatND>& inHistogram,
-        const PointCloudPtr& pointCloud,
-        const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+        const PointCloudConstPtr& pointCloud,
+        const std::vector<Region>& holesMasksRegionVector,
         const std::vector<cv::Mat>& holesMasksImageVector,
         const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
         const std::vector<int>& inflatedRectanglesIndices,
-        const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+        const std::vector<Region>& intermediatePointsRegionVector,
         const std::vector<cv::Mat>& intermediatePointsImageVector,
         std::vector<float>* probabilitiesVector,
         std::vector<cv::Mat>* imgs,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief Applies all active filters, from both RGB and Depth sources.
         The order of execution is derived from the dynamic reconfigure
-        facility.
+        facility. Unless disabled through the short_circuit_filters
+        parameter, once a candidate hole cannot be found valid by
+        HoleValidation::validateHoles, no more filters are applied to it;
+        its remaining probabilities stay as they were.
         @param[in] conveyor [const HolesConveyor&]
         The conveyor of candidateholes
         @param[in] filteringMode [const int&]
@@ -151,10 +184,10 @@ namespace hole_fusion
         The rgb image
         @param[in] inHistogram [const std::vector<cv::MatND>&]
         The vector of model histograms
-        @param[in] pointCloud [const PointCloudPtr&]
+        @param[in] pointCloud [const PointCloudConstPtr&]
         The original point cloud that corresponds to the input depth image
-        @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-        A vector that holds sets of points's indices;
+        @param[in] holesMasksRegionVector [const std::vector<Region>&]
+        A vector that holds a region of points for each hole;
         each point is internal to its respective hole
         @param[in] holesMasksImageVector [const std::vector<cv::Mat>&]
         A vector containing masks of the points inside each hole's outline
@@ -166,9 +199,9 @@ namespace hole_fusion
         A vector that is used to identify a hole's corresponding rectangle.
         Used primarily because the rectangles used are inflated rectangles;
         not all holes possess an inflated rectangle
-        @param[in] intermediatePointsSetVector
-        [const std::vector<std::set<unsigned int> >& ] A vector that holds for
-        each hole a set of points' indices; these points are the points
+        @param[in] intermediatePointsRegionVector
+        [const std::vector<Region>& ] A vector that holds for
+        each hole a region of points; these points are the points
         between the hole's outline and its bounding rectangle
         @param[in] intermediatePointsImageVector [const std::vector<cv::Mat>&]
         A vector containing masks of the points outside each hole's outline,
@@ -187,14 +220,39 @@ namespace hole_fusion
         const cv::Mat& depthImage,
         const cv::Mat& rgbImage,
         const std::vector<cv::MatND>& inHistogram,
-        const PointCloudPtr& pointCloud,
-        const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+        const PointCloudConstPtr& pointCloud,
+        const std::vector<Region>& holesMasksRegionVector,
         const std::vector<cv::Mat>& holesMasksImageVector,
         const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
         const std::vector<int>& inflatedRectanglesIndices,
-        const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+        const std::vector<Region>& intermediatePointsRegionVector,
         const std::vector<cv::Mat>& intermediatePointsImageVector,
         std::vector<std::vector<float> >* probabilitiesVector);
+
+      /**
+        @brief The running totals of a filter
+        @param[in] filter [const int&] The identifier of the filter, as in
+        applyFilter
+        @return [const FilterStatistics&] The totals
+       **/
+      static const FilterStatistics& getStatistics(const int& filter);
+
+      /**
+        @brief Zeroes the running totals of all filters
+        @return void
+       **/
+      static void resetStatistics();
+
+    private:
+      /**
+        @brief A one line summary of the running totals of all filters
+        applied so far, for logging
+        @return [std::string] The summary
+       **/
+      static std::string describeStatistics();
+
+      //  The running totals of each filter, by filter identifier
+      static FilterStatistics statistics_[NUMBER_OF_FILTERS + 1];
   };
 
 }  // namespace hole_fusion
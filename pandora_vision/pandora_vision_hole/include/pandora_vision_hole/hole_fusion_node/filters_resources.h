@@ -42,6 +42,8 @@
 #include "hole_fusion_node/utils/outline_discovery.h"
 #include "hole_fusion_node/utils/holes_conveyor.h"
 #include "hole_fusion_node/utils/parameters.h"
+#include "hole_fusion_node/resources_cache.h"
+#include "utils/region.h"
 
 /**
   @namespace pandora_vision
@@ -55,7 +57,11 @@ namespace hole_fusion
 {
   /**
     @class FiltersResources
-    @brief Provides methods for obtaining hole-related resources
+    @brief Provides methods for obtaining hole-related resources.
+    The masks, inflated rectangles and intermediate points of the holes
+    seen in recent frames are kept in a ResourcesCache of
+    Parameters::HoleFusion::resources_cache_size holes, so that they are
+    not computed again for a hole that reappears unchanged
    **/
   class FiltersResources
   {
@@ -80,9 +86,9 @@ namespace hole_fusion
         needed to be constructed.
         @param[out] holesMasksImageVector [std::vector<cv::Mat>*]
         A vector containing an image (the mask) for each hole
-        @param[out] holesMasksSetVector [std::vector<std::set<unsigned int> >*]
-        A vector that holds sets of points's indices; each set holds the
-        indices of the points inside the outline of each hole
+        @param[out] holesMasksRegionVector [std::vector<Region>*]
+        A vector that holds a region for each hole; each region holds the
+        points inside the outline of each hole
         @param[out] inflatedRectanglesVector
         [std::vector<std::vector<cv::Point2f> >*] The vector that holds the
         vertices of the in-image-bounds inflated rectangles
@@ -93,7 +99,7 @@ namespace hole_fusion
         A vector that holds the image of the intermediate points between
         a hole's outline and its bounding box, for each hole whose identifier
         exists in the @param inflatedRectanglesIndices vector
-        @param[out] intermediatePointsSetVector [std::vector<std::set<int> >*]
+        @param[out] intermediatePointsRegionVector [std::vector<Region>*]
         A vector that holds the intermediate points' between a hole's outline
         and its bounding box, for each hole whose identifier
         exists in the @param inflatedRectanglesIndices vector
@@ -105,11 +111,11 @@ namespace hole_fusion
         const int& inflationSize,
         const int& filteringMode,
         std::vector<cv::Mat>* holesMasksImageVector,
-        std::vector<std::set<unsigned int> >* holesMasksSetVector,
+        std::vector<Region>* holesMasksRegionVector,
         std::vector<std::vector<cv::Point2f> >* inflatedRectanglesVector,
         std::vector<int>* inflatedRectanglesIndices,
         std::vector<cv::Mat>* intermediatePointsImageVector,
-        std::vector<std::set<unsigned int> >* intermediatePointsSetVector);
+        std::vector<Region>* intermediatePointsRegionVector);
 
       /**
         @brief Some hole checkers require the construction of a hole's mask,
@@ -123,16 +129,16 @@ namespace hole_fusion
         masks' size
         @param[out] holesMasksImageVector [std::vector<cv::Mat>*]
         A vector containing an image (the mask) for each hole
-        @param[out] holesMasksSetVector [std::vector<std::set<unsigned int> >*]
-        A vector that holds sets of points;
-        each set holds the inside points of each hole
+        @param[out] holesMasksRegionVector [std::vector<Region>*]
+        A vector that holds a region of points for each hole;
+        each region holds the inside points of each hole
         @return void
        **/
       static void createHolesMasksVectors(
         const HolesConveyor& conveyor,
         const cv::Mat& image,
         std::vector<cv::Mat>* holesMasksImageVector,
-        std::vector<std::set<unsigned int> >* holesMasksSetVector);
+        std::vector<Region>* holesMasksRegionVector);
 
       /**
         @brief Some hole checkers require the construction of a hole's mask,
@@ -158,14 +164,14 @@ namespace hole_fusion
         @param[in] conveyor [const HolesConveyor&] The conveyor of holes
         @param[in] image [const cv::Mat&] An image required to access
         each hole
-        @param[out] holesMasksSetVector [std::vector<unsigned int>*] A vector
-        that holds sets of points; each set holds the inside points of each hole
+        @param[out] holesMasksRegionVector [std::vector<Region>*] A vector
+        that holds the region of the points inside each hole
         @return void
        **/
-      static void createHolesMasksSetVector(
+      static void createHolesMasksRegionVector(
         const HolesConveyor& conveyor,
         const cv::Mat& image,
-        std::vector<std::set<unsigned int> >* holesMasksSetVector);
+        std::vector<Region>* holesMasksRegionVector);
 
       /**
         @brief Some checkers require the construction of a hole's inflated
@@ -220,8 +226,8 @@ namespace hole_fusion
         A vector that holds the image of the intermediate points between
         a hole's outline and its bounding box, for each hole whose identifier
         exists in the @param inflatedRectanglesIndices vector
-        @param[out] intermediatePointsSetVector [std::vector<std::set<int> >*]
-        A vector that holds the intermediate points' indices between a hole's
+        @param[out] intermediatePointsRegionVector [std::vector<Region>*]
+        A vector that holds the intermediate points between a hole's
         outline and its bounding box, for each hole whose identifier
         exists in the @param inflatedRectanglesIndices vector
         @return void
@@ -232,7 +238,7 @@ namespace hole_fusion
         const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
         const std::vector<int>& inflatedRectanglesIndices,
         std::vector<cv::Mat>* intermediatePointsImageVector,
-        std::vector<std::set<unsigned int> >* intermediatePointsSetVector);
+        std::vector<Region>* intermediatePointsRegionVector);
 
       /**
         @brief For each hole, this function finds the points between the hole's
@@ -265,7 +271,7 @@ namespace hole_fusion
       /**
         @brief For each hole, this function finds the points between the hole's
         outline and the rectangle (inflated or not) that corrensponds to it.
-        These points are then stored in a std::set of ints.
+        These points are then stored in a run-length Region.
         @param[in] conveyor [const HolesConveyor&] The conveyor of holes
         @param[in] image [const cv::Mat&] An image needed only for
         its size
@@ -277,18 +283,48 @@ namespace hole_fusion
         that is used to identify a hole's corresponding rectangle.
         Used primarily because the rectangles used are inflated rectangles;
         not all holes possess an inflated rectangle
-        @param[out] intermediatePointsSetVector
-        [std::vector<std::set<unsigned int> >*]
-        A vector that holds the intermediate points' indices for each hole
+        @param[out] intermediatePointsRegionVector
+        [std::vector<Region>*]
+        A vector that holds the intermediate points for each hole
         whose identifier exists in the @param inflatedRectanglesIndices vector
         @return void
        **/
-      static void createIntermediateHolesPointsSetVector(
+      static void createIntermediateHolesPointsRegionVector(
         const HolesConveyor& conveyor,
         const cv::Mat& image,
         const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
         const std::vector<int>& inflatedRectanglesIndices,
-        std::vector<std::set<unsigned int> >* intermediatePointsSetVector);
+        std::vector<Region>* intermediatePointsRegionVector);
+
+      /**
+        @brief The running totals of the cache of holes' resources
+        @return [const ResourcesCache::Statistics&] The totals
+       **/
+      static const ResourcesCache::Statistics& getCacheStatistics();
+
+      /**
+        @brief Forgets the resources of every hole seen so far and zeroes
+        the running totals of the cache
+        @return void
+       **/
+      static void clearCache();
+
+    private:
+      /**
+        @brief Finds the cached resources of a hole. The cache is resized to
+        Parameters::HoleFusion::resources_cache_size first
+        @param[in] hole [const HoleConveyor&] The hole
+        @param[in] size [const cv::Size&] The size of the image the resources
+        are computed for
+        @param[in] scratch [ResourcesCache::Entry*] An empty entry, returned
+        when the cache is disabled
+        @return [ResourcesCache::Entry*] The hole's entry
+       **/
+      static ResourcesCache::Entry* lookup(const HoleConveyor& hole,
+        const cv::Size& size, ResourcesCache::Entry* scratch);
+
+      //  The resources of the holes seen in recent frames
+      static ResourcesCache cache_;
   };
 
 }  // namespace hole_fusion
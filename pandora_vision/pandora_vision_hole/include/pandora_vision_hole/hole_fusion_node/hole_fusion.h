@@ -49,6 +49,7 @@
 #include "sensor_processor/ProcessorLogInfo.h"
 #include "pandora_vision_hole/CandidateHolesVectorMsg.h"
 #include "pandora_vision_hole/CandidateHoleMsg.h"
+#include "synchronizer/synchronized_frame.h"
 #include "pandora_vision_msgs/HoleDirectionAlertVector.h"
 #include "pandora_vision_msgs/HoleDirectionAlert.h"
 #include "pandora_vision_msgs/EnhancedImage.h"
@@ -217,12 +218,12 @@ namespace hole_fusion
       // node
       std::string rgbCandidateHolesTopic_;
 
-      // The ROS subscriber for acquisition of the point cloud originated
-      // from the synchronizer node
+      // The ROS subscriber for acquisition of the synchronized frames,
+      // holding the point cloud, originated from the synchronizer node
       ros::Subscriber pointCloudSubscriber_;
 
       // The name of the topic where the Hole Fusion node is subscribed to
-      // where it acquires the point cloud from the Synchronizer node
+      // where it acquires the synchronized frames from the Synchronizer node
       std::string pointCloudTopic_;
 
       // The ROS subscriber for acquisition of candidate holes originated
@@ -258,8 +259,9 @@ namespace hole_fusion
       // The rgb received by the RGB node
       cv::Mat rgbImage_;
 
-      // The point cloud received by the synchronizer node
-      PointCloudPtr pointCloud_;
+      // The point cloud received by the synchronizer node, shared with
+      // the frame it came in
+      PointCloudConstPtr pointCloud_;
 
       // The interpolated depth image received by the depth node
       cv::Mat interpolatedDepthImage_;
@@ -508,21 +510,22 @@ namespace hole_fusion
           const uint32_t& level);
 
       /**
-        @brief Callback for the point cloud that the synchronizer node
+        @brief Callback for the frame that the synchronizer node
         publishes.
 
-        This method interpolates the input point cloud so that depth-based
-        filters using it have an integral input and sets it and header-related
-        variables.
+        This method keeps the frame's point cloud, whose depth the
+        synchronizer has already set to that of the interpolated depth
+        image, and sets header-related variables.
         If the depth and RGB callback counterparts have done
         what must be, it resets the number of ready nodes, unlocks
         the synchronizer and calls for processing of the candidate
         holes.
-        @param[in] msg [const PointCloudPtr&] The message containing
-        the point cloud
+        @param[in] msg [const SynchronizedFrameConstPtr&]
+        The synchronized frame, containing the point cloud
         @return void
        **/
-      void pointCloudCallback(const PointCloudConstPtr& msg);
+      void pointCloudCallback(
+        const SynchronizedFrameConstPtr& msg);
 
       /**
         @brief Implements a strategy to combine information from both
@@ -612,24 +615,6 @@ namespace hole_fusion
           const ::pandora_vision_hole::CandidateHolesVectorMsgConstPtr&
           rgbCandidateHolesVector);
 
-      /**
-        @brief Sets the depth values of a point cloud according to the
-        values of a depth image.
-
-        Needed by the depth-based filters that employ a point cloud analysis.
-        The values of the point cloud published by the synchronizer node to
-        the hole fusion node contain the unadulterated values of the point
-        cloud directly obtained by the depth sensor,
-        hence they contain NaNs and zero-value pixels that
-        would otherwise, if not for this method, obstruct the function of the
-        above filters.
-        @param[in] inImage [const cv::Mat&] The depth image in CV_32FC1 format
-        @param[out] pointCloudPtr [PointCloudPtr*] The point cloud
-        @return void
-       **/
-      void setDepthValuesInPointCloud(const cv::Mat& inImage,
-          PointCloudPtr* pointCloudPtr);
-
       /**
         @brief Requests from the synchronizer to process a new point cloud
         @return void
@@ -0,0 +1,157 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_HOLE_FUSION_NODE_HOLE_GRID_H
+#define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_HOLE_GRID_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <opencv2/opencv.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  /**
+    @class HoleGrid
+    @brief A uniform grid of square cells over the plane, indexing holes
+    by an axis aligned bounding box, so that the holes whose boxes lie near
+    a given box are found without visiting every hole. Boxes are closed:
+    a box of zero width or height is a segment or a point.
+    The coordinates are those of the boxes, pixels or meters alike; only
+    the cells are kept, so the plane need not be bounded.
+   **/
+  class HoleGrid
+  {
+    public:
+      /**
+        @param cellSize [float] The side of a cell, in the units of the
+        boxes. A side near the size of the boxes indexed keeps both the
+        number of cells per box and the number of boxes per cell small
+       **/
+      explicit HoleGrid(float cellSize);
+
+      /**
+        @brief Indexes a hole. A hole that is already indexed is moved
+        @param[in] id [int] The non-negative identifier of the hole
+        @param[in] box [const cv::Rect_<float>&] The hole's bounding box
+        @return void
+       **/
+      void insert(int id, const cv::Rect_<float>& box);
+
+      /**
+        @brief Forgets a hole, if it is indexed
+        @param[in] id [int] The identifier of the hole
+        @return void
+       **/
+      void remove(int id);
+
+      /**
+        @brief Finds the holes whose boxes lie within a distance of a box,
+        measured along each axis separately
+        @param[in] box [const cv::Rect_<float>&] The box
+        @param[in] margin [float] The distance
+        @param[out] ids [std::vector<int>*] The identifiers of the holes
+        found, in no particular order
+        @return void
+       **/
+      void query(const cv::Rect_<float>& box, float margin,
+        std::vector<int>* ids) const;
+
+      /**
+        @brief Forgets every hole
+        @return void
+       **/
+      void clear();
+
+      std::size_t size() const
+      {
+        return size_;
+      }
+
+    private:
+      typedef std::pair<int, int> Cell;
+      typedef boost::unordered_map<Cell, std::vector<int> > CellMap;
+
+      /**
+        @brief The first and last cells, per axis, that a box spans
+        @return [bool] False if the box spans more than maxCells_ cells,
+        or its coordinates are not finite
+       **/
+      bool cellRange(const cv::Rect_<float>& box,
+        int* x0, int* y0, int* x1, int* y1) const;
+
+      //  Whether two closed boxes, one of them grown by margin, meet
+      static bool near(const cv::Rect_<float>& a,
+        const cv::Rect_<float>& b, float margin);
+
+      float cellSize_;
+
+      //  The boxes that span too many cells to be spread over them.
+      //  They are tested against every query
+      std::vector<int> oversized_;
+
+      CellMap cells_;
+
+      //  By identifier: the box of each hole and whether it is indexed
+      std::vector<cv::Rect_<float> > boxes_;
+      std::vector<char> indexed_;
+
+      std::size_t size_;
+
+      //  Marks the holes already reported by the current query
+      mutable std::vector<unsigned int> stamps_;
+      mutable unsigned int stamp_;
+
+      //  Beyond this many cells a box goes to oversized_, and a query
+      //  visits every hole instead of the cells
+      static const int maxCells_ = 1024;
+  };
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_HOLE_FUSION_NODE_HOLE_GRID_H
@@ -85,7 +85,7 @@ namespace hole_fusion
         candidate holes conveyor
         @param[in] image [const cv::Mat&] An image used for filters' resources
         creation and size usage
-        @param[in] pointCloud [const PointCloudPtr] An interpolated point
+        @param[in] pointCloud [const PointCloudConstPtr] An interpolated point
         cloud used in the connection operation; it is used to obtain real world
         distances between holes
         @param[in] operationId [const int&] The identifier of the merging
@@ -96,7 +96,7 @@ namespace hole_fusion
       static void applyMergeOperation(
         HolesConveyor* rgbdHolesConveyor,
         const cv::Mat& image,
-        const PointCloudPtr& pointCloud,
+        const PointCloudConstPtr& pointCloud,
         const int& operationId);
 
       /**
@@ -124,18 +124,18 @@ namespace hole_fusion
         is capable of assimilating another hole assigned the role of
         the assimilable. It checks whether the assimilable's outline
         points reside entirely inside the assimilator's outline.
-        @param[in] assimilatorHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the assimilator's
+        @param[in] assimilatorHoleMaskRegion [const Region&]
+        A region that includes the points inside the assimilator's
         outline
-        @param[in] assimilableHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the assimilable's
+        @param[in] assimilableHoleMaskRegion [const Region&]
+        A region that includes the points inside the assimilable's
         outline
         @return [bool] True if all of the outline points of the assimilable
         hole are inside the outline of the assimilator
        **/
       static bool isCapableOfAssimilating(
-        const std::set<unsigned int>& assimilatorHoleMaskSet,
-        const std::set<unsigned int>& assimilableHoleMaskSet);
+        const Region& assimilatorHoleMaskRegion,
+        const Region& assimilableHoleMaskRegion);
 
       /**
         @brief Indicates whether a hole assigned the role of the amalgamator
@@ -145,18 +145,18 @@ namespace hole_fusion
         points intersect with the amalgamator's outline, but not in their
         entirety, and the area of the amalgamator is larger than the area
         of the amalgamatable
-        @param[in] amalgamatorHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the amalgamator's
+        @param[in] amalgamatorHoleMaskRegion [const Region&]
+        A region that includes the points inside the amalgamator's
         outline
-        @param[in] amalgamatableHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the amalgamatable's
+        @param[in] amalgamatableHoleMaskRegion [const Region&]
+        A region that includes the points inside the amalgamatable's
         outline
         @return [bool] True if the amalgamator is capable of amalgamating
         the amalgamatable
        **/
       static bool isCapableOfAmalgamating(
-        const std::set<unsigned int>& amalgamatorHoleMaskSet,
-        const std::set<unsigned int>& amalgamatableHoleMaskSet);
+        const Region& amalgamatorHoleMaskRegion,
+        const Region& amalgamatableHoleMaskRegion);
 
       /**
         @brief Intended to use after the check of the
@@ -171,11 +171,11 @@ namespace hole_fusion
         amalgamation, only the internals of the amalgamator are modified
         @param[in] amalgamatorId [const int&] The identifier of the
         hole inside the HolesConveyor amalgamator struct
-        @param[in,out] amalgamatorHoleMaskSet [std::set<unsigned int>*]
-        A set that includes the indices of points inside the amalgamator's
+        @param[in,out] amalgamatorHoleMaskRegion [Region*]
+        A region that includes the points inside the amalgamator's
         outline
-        @param[in] amalgamatableHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the amalgamatable's
+        @param[in] amalgamatableHoleMaskRegion [const Region&]
+        A region that includes the points inside the amalgamatable's
         outline
         @param[in] image [const cv::Mat&] An image used for its size
         @return void
@@ -183,8 +183,8 @@ namespace hole_fusion
       static void amalgamateOnce(
         HolesConveyor* conveyor,
         const int& amalgamatorId,
-        std::set<unsigned int>* amalgamatorHoleMaskSet,
-        const std::set<unsigned int>& amalgamatableHoleMaskSet,
+        Region* amalgamatorHoleMaskRegion,
+        const Region& amalgamatableHoleMaskRegion,
         const cv::Mat& image);
 
       /**
@@ -202,13 +202,13 @@ namespace hole_fusion
         that acts as the connector inside the connectors HolesConveyor
         @param[in] connectableId [const int&] The index of the specific hole
         that acts as the connectable inside the connectables HolesConveyor
-        @param[in] connectorHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the connector's
+        @param[in] connectorHoleMaskRegion [const Region&]
+        A region that includes the points inside the connector's
         outline
-        @param[in] connectableHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the connectable's
+        @param[in] connectableHoleMaskRegion [const Region&]
+        A region that includes the points inside the connectable's
         outline
-        @param[in] pointCloud [const PointCloudPtr&] The point cloud
+        @param[in] pointCloud [const PointCloudConstPtr&] The point cloud
         obtained from the depth sensor, used to measure distances in real
         space
         @return [bool] True if the connectable is capable of being connected
@@ -218,9 +218,9 @@ namespace hole_fusion
         const HolesConveyor& conveyor,
         const int& connectorId,
         const int& connectableId,
-        const std::set<unsigned int>& connectorHoleMaskSet,
-        const std::set<unsigned int>& connectableHoleMaskSet,
-        const PointCloudPtr& pointCloud);
+        const Region& connectorHoleMaskRegion,
+        const Region& connectableHoleMaskRegion,
+        const PointCloudConstPtr& pointCloud);
 
       /**
         @brief Intended to use after the check of the
@@ -236,8 +236,8 @@ namespace hole_fusion
         the HolesConveyor connectables struct
         @param[in] connectableId [const int&] The identifier of the hole inside
         the HolesConveyor connectables struct
-        @param[in] connectorHoleMaskSet [const std::set<unsigned int>&]
-        A set that includes the indices of points inside the connector's
+        @param[in] connectorHoleMaskRegion [const Region&]
+        A region that includes the points inside the connector's
         outline
         @param[in] image [const cv::Mat&] An image required only for its size
         @return void
@@ -246,7 +246,7 @@ namespace hole_fusion
         HolesConveyor* conveyor,
         const int& connectorId,
         const int& connectableId,
-        std::set<unsigned int>* connectorHoleMaskSet,
+        Region* connectorHoleMaskRegion,
         const cv::Mat& image);
 
       /**
@@ -269,14 +269,14 @@ namespace hole_fusion
         not possible, and so merges will happen unconditionally.
         @param[in] interpolatedDepthImage [const cv::Mat&]
         The interpolated depth image
-        @param[in] pointCloud [const PointCloudPtr&]
+        @param[in] pointCloud [const PointCloudConstPtr&]
         The interpolated point cloud. Needed in the connection process.
         @return void
        **/
       static void mergeHoles(HolesConveyor* conveyor,
         const int& filteringMethod,
         const cv::Mat& interpolatedDepthImage,
-        const PointCloudPtr& pointCloud);
+        const PointCloudConstPtr& pointCloud);
   };
 
 }  // namespace hole_fusion
@@ -159,6 +159,45 @@ namespace hole_fusion
       static std::map<int, float> validateHolesViaThresholding(
         const std::vector<std::vector<float> >& probabilitiesVector2D,
         const int& filteringMode);
+
+      /**
+        @brief Tells whether a candidate hole is bound to be found invalid
+        by validateHoles, whatever the probabilities of the filters not yet
+        applied to it turn out to be. All probabilities are taken to be at
+        most 1. Filters that have not been applied yet need not be applied
+        to a hole for which this returns true
+        @param[in] probabilitiesVector2D
+        [const std::vector<std::vector<float> >&]
+        A two dimensional vector containing the probabilities of
+        validity of each candidate hole. Each row of it pertains to a specific
+        filter applied, in order of priority, each column to a particular hole
+        @param[in] filters [const std::vector<int>&] The identifiers of all
+        the active filters, in order of priority, as in Filters::applyFilter
+        @param[in] applied [const int&] The number of filters applied so far
+        @param[in] hole [const int&] The index of the candidate hole
+        @param[in] filteringMode [const int&] 0 for when Depth and RGB analysis
+        is applicable, 1 for when only RGB analysis is applicable
+        @return [bool] True if the candidate hole cannot be valid
+       **/
+      static bool isRejected(
+        const std::vector<std::vector<float> >& probabilitiesVector2D,
+        const std::vector<int>& filters,
+        const int& applied,
+        const int& hole,
+        const int& filteringMode);
+
+      /**
+        @brief The threshold that the probability of a filter is compared
+        against, when validating via (thresholded weighting) thresholding
+        @param[in] filter [const int&] The identifier of the filter, as in
+        Filters::applyFilter
+        @param[in] filteringMode [const int&] 0 for when Depth and RGB analysis
+        is applicable, 1 for when only RGB analysis is applicable
+        @return [float] The threshold, 0 for an unknown filter
+       **/
+      static float filterThreshold(
+        const int& filter,
+        const int& filteringMode);
   };
 
 }  // namespace hole_fusion
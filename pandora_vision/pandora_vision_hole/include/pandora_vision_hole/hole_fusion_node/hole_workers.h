@@ -0,0 +1,159 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_HOLE_FUSION_NODE_HOLE_WORKERS_H
+#define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_HOLE_WORKERS_H
+
+#include <string>
+#include <vector>
+#include <boost/function.hpp>
+#include <boost/thread.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  /**
+    @class HoleWorkers
+    @brief A pool of threads that shares the per hole work of a filter.
+    Tasks are claimed one index at a time, so holes of very different
+    sizes balance themselves, and the calling thread claims tasks too.
+   **/
+  class HoleWorkers
+  {
+    public:
+      //!< Processes the task of a specific index
+      typedef boost::function<void (int)> Task;
+
+      //!< Processes the entry of a specific index of a filter and writes
+      //!< its debug message
+      typedef boost::function<void (int, std::string*)> EntryTask;
+
+      /**
+        @brief Starts a number of worker threads
+        @param threads [int] The number of threads besides the caller's
+       **/
+      explicit HoleWorkers(int threads);
+
+      ~HoleWorkers();
+
+      /**
+        @brief The pool shared by the filters of the Hole Fusion node,
+        sized to the hardware concurrency
+       **/
+      static HoleWorkers& instance();
+
+      /**
+        @brief Runs a task for the indices 0 .. count - 1 and returns when
+        all of them are done. Concurrent calls are served one after the other
+        @param count [int] The number of indices
+        @param task [const Task&] The task. It is called from several threads
+        at once, so it must only write to state of its own index
+        @return void
+       **/
+      void run(int count, const Task& task);
+
+      /**
+        @brief Runs the task of a filter for those of its entries whose
+        hole is still pending, and appends the entries' messages to msgs
+        in the order of the entries. Skipped entries get a "-" message and
+        entries that leave their message empty get none
+        @param count [int] The number of entries
+        @param holes [const std::vector<int>*] The hole of each entry,
+        e.g. the inflated rectangles' indices. If NULL, entry i is hole i
+        @param pending [const std::vector<bool>*] Which holes still need to
+        be evaluated. If NULL, all of them do
+        @param task [const EntryTask&] The task of each entry
+        @param msgs [std::vector<std::string>*] The messages
+        @return void
+       **/
+      void runEntries(int count, const std::vector<int>* holes,
+        const std::vector<bool>* pending, const EntryTask& task,
+        std::vector<std::string>* msgs);
+
+      /**
+        @brief The number of threads that run tasks, the caller's included
+       **/
+      int size() const
+      {
+        return threads_.size() + 1;
+      }
+
+    private:
+      /**
+        @brief The loop of each worker thread
+        @return void
+       **/
+      void work();
+
+      /**
+        @brief Claims and runs the tasks of the current batch until none
+        is left
+        @return void
+       **/
+      void drain();
+
+    private:
+      boost::thread_group threads_;
+
+      //!< Serializes calls to run()
+      boost::mutex runMutex_;
+
+      //!< Guards the members that follow
+      boost::mutex mutex_;
+      boost::condition_variable wake_;
+      boost::condition_variable done_;
+
+      const Task* task_;
+      int count_;
+      int next_;
+      int pending_;
+      unsigned long batch_;
+      bool stopping_;
+  };
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_HOLE_FUSION_NODE_HOLE_WORKERS_H
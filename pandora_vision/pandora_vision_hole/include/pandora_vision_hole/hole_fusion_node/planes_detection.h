@@ -38,6 +38,8 @@
 #ifndef PANDORA_VISION_HOLE_HOLE_FUSION_NODE_PLANES_DETECTION_H
 #define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_PLANES_DETECTION_H
 
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
 #include "hole_fusion_node/utils/parameters.h"
 
 /**
@@ -57,6 +59,24 @@ namespace hole_fusion
   class PlanesDetection
   {
     public:
+      /**
+        @brief The planes of an organized point cloud, as one label per
+        point: 0 for points on no plane, k for points on the k-th plane
+       **/
+      struct PlaneLabels
+      {
+        //  The point cloud the planes were segmented from
+        const PointCloud* cloud;
+
+        //  A CV_32SC1 image of the point cloud's size
+        cv::Mat labels;
+
+        //  The number of planes
+        int planes;
+      };
+
+      typedef boost::shared_ptr<const PlaneLabels> PlaneLabelsConstPtr;
+
       /**
         @brief Applies a voxel grid filtering
         (http://pointclouds.org/documentation/tutorials/voxel_grid.php)
@@ -102,6 +122,48 @@ namespace hole_fusion
          std::vector<PointCloudXYZPtr>* planesVector,
          std::vector<pcl::ModelCoefficients>* coefficientsVector,
          std::vector<pcl::PointIndices::Ptr>* inliersVector);
+
+      /**
+        @brief Segments the planes of a whole organized point cloud in one
+        pass, from the normals found over its integral images. Clouds that
+        are not organized get no planes
+        @param[in] cloud [const PointCloudConstPtr&] The point cloud
+        @return [PlaneLabelsConstPtr] The plane of each point
+       **/
+      static PlaneLabelsConstPtr segmentOrganizedPlanes(
+        const PointCloudConstPtr& cloud);
+
+      /**
+        @brief Segments the planes of the point cloud of the current frame,
+        for getFramePlanes to return them. The point cloud is not to be
+        changed until the next call
+        @param[in] cloud [const PointCloudConstPtr&] The point cloud
+        @return void
+       **/
+      static void setFramePlanes(const PointCloudConstPtr& cloud);
+
+      /**
+        @brief Forgets the planes of the current frame
+        @return void
+       **/
+      static void clearFramePlanes();
+
+      /**
+        @brief The planes of the current frame
+        @param[in] cloud [const PointCloudConstPtr&] The point cloud whose
+        planes are needed
+        @return [PlaneLabelsConstPtr] The planes set by setFramePlanes,
+        or NULL if they were not segmented from this point cloud
+       **/
+      static PlaneLabelsConstPtr getFramePlanes(
+        const PointCloudConstPtr& cloud);
+
+    private:
+      //  Guards framePlanes_
+      static boost::mutex framePlanesMutex_;
+
+      //  The planes of the current frame
+      static PlaneLabelsConstPtr framePlanes_;
   };
 
 }  // namespace hole_fusion
@@ -0,0 +1,221 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_HOLE_FUSION_NODE_RESOURCES_CACHE_H
+#define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_RESOURCES_CACHE_H
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <vector>
+#include "hole_fusion_node/utils/holes_conveyor.h"
+#include "utils/region.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  /**
+    @class ResourcesCache
+    @brief Keeps the geometric resources of the holes seen in recent frames,
+    so that a hole that reappears unchanged is not flood filled again.
+    A hole is described by the image size, its outline, its bounding
+    rectangle and its keypoint, quantized to the pixel that the flood fills
+    are seeded from; apart from the inflation size, which is kept with the
+    inflated rectangle, the resources depend on nothing else.
+    The least recently used holes are evicted once the capacity is reached.
+    It is not thread safe.
+   **/
+  class ResourcesCache
+  {
+    public:
+      /**
+        @brief The resources of a single hole. Each one is computed the
+        first time it is asked for
+       **/
+      struct Entry
+      {
+        Entry();
+
+        //  The points inside the hole's outline
+        bool hasMask;
+        Region mask;
+
+        //  The vertices of the hole's bounding rectangle, inflated by
+        //  inflationSize. inflatedRectangleInBounds is false if the rectangle
+        //  does not fit in the image, in which case there are no vertices
+        bool hasInflatedRectangle;
+        int inflationSize;
+        bool inflatedRectangleInBounds;
+        std::vector<cv::Point2f> inflatedRectangle;
+
+        //  The points between the hole's outline and intermediateRectangle,
+        //  the rectangle they were computed for
+        bool hasIntermediatePoints;
+        std::vector<cv::Point2f> intermediateRectangle;
+        Region intermediatePoints;
+      };
+
+      /**
+        @brief The running totals of the cache, since they were last reset
+       **/
+      struct Statistics
+      {
+        Statistics();
+
+        //  The number of lookups of a hole found in the cache
+        unsigned long hits;
+
+        //  The number of lookups of a hole not found in the cache
+        unsigned long misses;
+
+        //  The number of holes evicted to make room for others
+        unsigned long evictions;
+
+        /**
+          @brief The fraction of the lookups that were hits
+          @return [double] The hit rate, or 0 if there were no lookups
+         **/
+        double hitRate() const;
+      };
+
+      /**
+        @param capacity [std::size_t] The maximum number of holes kept.
+        Zero disables the cache
+       **/
+      explicit ResourcesCache(std::size_t capacity);
+
+      /**
+        @brief Finds the entry of a hole, creating an empty one if the hole
+        has not been seen recently. The entry stays valid until the next
+        call of lookup, setCapacity or clear
+        @param[in] hole [const HoleConveyor&] The hole
+        @param[in] imageSize [const cv::Size&] The size of the images the
+        resources are computed for
+        @return [Entry*] The hole's entry, or NULL if the cache is disabled
+       **/
+      Entry* lookup(const HoleConveyor& hole, const cv::Size& imageSize);
+
+      /**
+        @brief Changes the maximum number of holes kept, evicting the least
+        recently used ones if there are more
+        @param capacity [std::size_t] The new capacity. Zero disables the
+        cache
+        @return void
+       **/
+      void setCapacity(std::size_t capacity);
+
+      /**
+        @brief Forgets every hole
+        @return void
+       **/
+      void clear();
+
+      std::size_t size() const
+      {
+        return entries_.size();
+      }
+
+      std::size_t capacity() const
+      {
+        return capacity_;
+      }
+
+      const Statistics& getStatistics() const
+      {
+        return statistics_;
+      }
+
+      void resetStatistics()
+      {
+        statistics_ = Statistics();
+      }
+
+    private:
+      /**
+        @brief What the resources of a hole are computed from
+       **/
+      struct Descriptor
+      {
+        cv::Size imageSize;
+        cv::Point seed;
+        std::vector<cv::Point2f> rectangle;
+        std::vector<cv::Point2f> outline;
+
+        bool operator==(const Descriptor& other) const;
+      };
+
+      struct Node
+      {
+        std::size_t key;
+        Descriptor descriptor;
+        Entry entry;
+      };
+
+      typedef std::list<Node> NodeList;
+      typedef std::map<std::size_t, NodeList::iterator> NodeIndex;
+
+      /**
+        @brief Evicts the least recently used holes until at most capacity
+        of them are left
+        @param capacity [std::size_t] The number of holes to keep
+        @return void
+       **/
+      void shrink(std::size_t capacity);
+
+      std::size_t capacity_;
+
+      //  The holes, the most recently used first
+      NodeList entries_;
+
+      //  The holes by the hash of their descriptor
+      NodeIndex index_;
+
+      Statistics statistics_;
+  };
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_HOLE_FUSION_NODE_RESOURCES_CACHE_H
@@ -39,11 +39,14 @@
 #define PANDORA_VISION_HOLE_HOLE_FUSION_NODE_RGB_FILTERS_H
 
 #include <math.h>
+#include <string>
+#include <vector>
 #include "hole_fusion_node/utils/edge_detection.h"
 #include "hole_fusion_node/utils/histogram.h"
 #include "hole_fusion_node/utils/holes_conveyor.h"
 #include "hole_fusion_node/utils/morphological_operators.h"
 #include "hole_fusion_node/utils/parameters.h"
+#include "utils/region.h"
 #include "hole_fusion_node/utils/visualization.h"
 
 /**
@@ -80,13 +83,16 @@ namespace hole_fusion
         number of keypoints found and published by the rgb node
         @param[in,out] msgs [std::vector<std::string>*] Messages for
         debug reasons
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesColorHomogeneity(
         const cv::Mat& inImage,
         const std::vector<cv::Mat>& holesMasksVector,
         std::vector<float>* probabilitiesVector,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief Checks for difference in mean value of luminosity between
@@ -94,13 +100,13 @@ namespace hole_fusion
         outside the hole's outline and
         (2) the points inside the hole's outline.
         @param[in] inImage [const cv::Mat&] The RGB image in CV_8UC3 format
-        @param[in] holesMasksSetVector
-        [const std::vector<std::set<unsigned int> >&]
-        A vector that holds sets of points's indices;
+        @param[in] holesMasksRegionVector
+        [const std::vector<Region>&]
+        A vector that holds a region of points for each hole;
         each point is internal to its respective hole
-        @param[in] intermediatePointsSetVector
-        [const std::vector<std::set<unsigned int> >& ] A vector that holds
-        for each hole a set of points;
+        @param[in] intermediatePointsRegionVector
+        [const std::vector<Region>& ] A vector that holds
+        for each hole a region of points;
         these points are the points between the hole's outline and its
         bounding rectangle
         @param[in] rectanglesIndices [const std::vector<int>&] A vector that
@@ -114,15 +120,18 @@ namespace hole_fusion
         number of keypoints found and published by the rgb node
         @param[out] msgs [std::vector<std::string>*] Messages for
         debug reasons
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesLuminosityDiff(
         const cv::Mat& inImage,
-        const std::vector<std::set<unsigned int> >& holesMasksSetVector,
-        const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+        const std::vector<Region>& holesMasksRegionVector,
+        const std::vector<Region>& intermediatePointsRegionVector,
         const std::vector<int>& rectanglesIndices,
         std::vector<float>* probabilitiesVector,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief Given a set of keypoints, their respective outline and
@@ -151,6 +160,8 @@ namespace hole_fusion
         number of keypoints found and published by the rgb node
         @param[in,out] msgs [std::vector<std::string>*] Messages for
         debug reasons
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesTextureDiff(
@@ -160,7 +171,8 @@ namespace hole_fusion
         const std::vector<cv::Mat>& intermediatePointsImageVector,
         const std::vector<int>& rectanglesIndices,
         std::vector<float>* probabilitiesVector,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
 
       /**
         @brief Given a set of keypoints, their respective outline and
@@ -174,13 +186,12 @@ namespace hole_fusion
         @param[in] inImage [const cv::Mat&] The RGB image in CV_8UC3 format
         @param[in] inHistogram [const std::vector<cv::MatND>&]
         The vector of model histograms
-        @param[in] holesMasksSetVector
-        [const std::vector<std::set<unsigned int> >&]
-        A vector that holds sets of points; each point is internal to its
-        respective hole
-        @param[in] intermediatePointsSetVector
-        [const std::vector<std::set<unsigned int> >& ] A vector that holds
-        for each hole a set of points' indices;
+        @param[in] holesMasksRegionVector
+        [const std::vector<Region>&]
+        A vector that holds the region of the points inside each hole
+        @param[in] intermediatePointsRegionVector
+        [const std::vector<Region>& ] A vector that holds
+        for each hole a region of points;
         these points are the points between the hole's outline and its
         bounding rectangle
         @param[in] rectanglesIndices [const std::vector<int>&] A vector that
@@ -194,16 +205,19 @@ namespace hole_fusion
         number of keypoints found and published by the rgb node
         @param[in,out] msgs [std::vector<std::string>*] Messages for
         debug reasons
+        @param[in] pending [const std::vector<bool>*] Which holes still need
+        to be evaluated; the rest keep their probability. If NULL, all do
         @return void
        **/
       static void checkHolesTextureBackProject(
         const cv::Mat& inImage,
         const std::vector<cv::MatND>& inHistogram,
-        const std::vector<std::set<unsigned int> >& holesMasksSetVector,
-        const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+        const std::vector<Region>& holesMasksRegionVector,
+        const std::vector<Region>& intermediatePointsRegionVector,
         const std::vector<int>& rectanglesIndices,
         std::vector<float>* probabilitiesVector,
-        std::vector<std::string>* msgs);
+        std::vector<std::string>* msgs,
+        const std::vector<bool>* pending = NULL);
   };
 
 }  // namespace hole_fusion
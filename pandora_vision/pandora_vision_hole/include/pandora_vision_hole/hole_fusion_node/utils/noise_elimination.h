@@ -112,6 +112,17 @@ namespace hole_fusion
        **/
       static void interpolation(const cv::Mat& inImage, cv::Mat* outImage);
 
+      /**
+        @brief Interpolates the noise produced by the depth sensor, giving
+        every black pixel the value of its nearest non-black pixel, found
+        by jump flooding
+        @param[in] inImage [const cv::Mat&] The input image
+        @param[out] outImage [cv::Mat*] The output image
+        @return void
+       **/
+      static void jumpFloodNearest(const cv::Mat& inImage,
+        cv::Mat* outImage);
+
       /**
         @brief Iteration for the interpolateNoise function
         @param[in,out] inImage [cv::Mat*] The input image
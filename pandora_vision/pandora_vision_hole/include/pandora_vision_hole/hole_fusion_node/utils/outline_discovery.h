@@ -75,7 +75,9 @@ namespace hole_fusion
 
       /**
         @brief Implements the brushfire algorithm for all blob keypoints
-        in order to find blobs' outlines
+        in order to find blobs' outlines. Keypoints lying in an area of zero
+        value pixels already flooded for a previous keypoint share its
+        outline and area, so every area of the image is flooded at most once
         @param[in] inKeyPoints [const std::vector<cv::KeyPoint>&] The keypoints
         @param[in] edgesImage [cv::Mat*] The input image
         @param[out] blobsOutlineVector [std::vector<std::vector<cv::Point2f> >*]
@@ -96,7 +98,7 @@ namespace hole_fusion
         @param[in] inPoint [const cv::Point2f&] The input point
         @param[in] inImage [cv::Mat*] The input image
         @param[out] visited [std::set<unsigned int>&] The points between
-        areas of non-zero value pixels.
+        areas of non-zero value pixels. Points already in it are not expanded.
         @return void
        **/
       static void brushfirePoint(const cv::Point2f& inPoint,
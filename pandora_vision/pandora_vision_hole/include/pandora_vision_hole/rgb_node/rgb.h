@@ -43,6 +43,7 @@
 #include "state_manager/state_client_nodelet.h"
 
 #include "pandora_vision_hole/CandidateHolesVectorMsg.h"
+#include "synchronizer/synchronized_frame.h"
 #include "rgb_node/utils/message_conversions.h"
 #include "rgb_node/utils/histogram.h"
 #include "rgb_node/utils/parameters.h"
@@ -78,16 +79,18 @@ namespace rgb
     onInit();
 
     /**
-      @brief Callback for the rgb image received by the synchronizer node.
+      @brief Callback for the frame published by the synchronizer node.
 
-      The rgb image message received by the synchronizer node is unpacked
-      in a cv::Mat image. Holes are then located inside this image and
+      The frame's rgb image is viewed as a cv::Mat image, without being
+      copied. Holes are then located inside this image and
       information about them, along with the rgb image, is then sent to the
       hole fusion node
-      @param msg [const sensor_msgs::Image&] The rgb image message
+      @param msg [const SynchronizedFrameConstPtr&]
+      The synchronized frame
       @return void
       **/
-    void inputRgbImageCallback(const sensor_msgs::ImageConstPtr& inImage);
+    void inputRgbImageCallback(
+      const SynchronizedFrameConstPtr& msg);
 
     /**
       @brief The function called when a parameter is changed
@@ -119,14 +122,15 @@ namespace rgb
     // The private ROS node handle
     ros::NodeHandle privateNodeHandle_;
 
-    // The ROS subscriber for acquisition of the RGB image through the
-    // depth sensor
+    // The ROS subscriber for acquisition of the synchronized frames, which
+    // hold the RGB image of the depth sensor
     ros::Subscriber rgbImageSubscriber_;
 
     // Node's distinct name
     std::string nodeName_;
 
-    // The name of the topic where the rgb image is acquired from
+    // The name of the topic where the synchronized frames, and so the
+    // rgb image, are acquired from
     std::string rgbImageTopic_;
 
     // The ROS publisher ofcandidate holes
@@ -77,10 +77,12 @@
 #include <image_transport/image_transport.h>
 #include "std_msgs/String.h"
 
-#include "utils/timer.h"
-
 // #define DEBUG_SHOW
 // #define DEBUG_TIME
+
+// After DEBUG_TIME, on which its macros depend
+#include "utils/profiler.h"
+
 //  Transforms a float number to string
 #define TOSTR(x)      static_cast< std::ostringstream & >( \
   (std::ostringstream() << std::dec << x)).str()
@@ -56,6 +56,7 @@
 #include "distrib_msgs/FlirLeptonMsg.h"
 #include "pandora_vision_msgs/EnhancedImage.h"
 #include "pandora_vision_msgs/IndexedThermal.h"
+#include "synchronizer/synchronized_frame.h"
 
 #include "hole_fusion_node/utils/message_conversions.h"
 #include "hole_fusion_node/utils/noise_elimination.h"
@@ -110,9 +111,8 @@ namespace pandora_vision_hole
       If the synchronizer node is unlocked, it extracts a depth image from
       the input point cloud's depth measurements, an RGB image from the colour
       measurements of the input point cloud and thermal info.
-      Then publishes these images and thermal info
-      to their respective recipients. Finally, the input point cloud is
-      published directly to the hole fusion node.
+      Then publishes these images, along with the input point cloud, as one
+      synchronized frame, and the thermal info to its recipients.
       @param[in] synchronizedMessage [const pandora_vision_msgs::SynchronizedMsg&]
       The input synchronized thermal and pc info
       @return void
@@ -184,13 +184,46 @@ namespace pandora_vision_hole
     unlockThermalCallback(const std_msgs::EmptyConstPtr& lockMsg);
 
    private:
+    /**
+      @brief Extracts the RGB and the interpolated depth image of a frame
+      from the input point cloud, in a single pass over its buffer
+      @param[out] framePtr [const SynchronizedFramePtr&]
+      The frame whose header, images and isDepth flag are set
+      @param[in] pcMsg [const sensor_msgs::PointCloud2ConstPtr&] The input
+      point cloud
+      @return void
+      **/
     void
     initCallback(
-        PointCloudPtr& pcPtr,
-        sensor_msgs::ImagePtr& rgbImageMessagePtr,
-        sensor_msgs::ImagePtr& depthImageMessagePtr,
+        const SynchronizedFramePtr& framePtr,
+        const sensor_msgs::PointCloud2ConstPtr& pcMsg);
+
+    /**
+      @brief Converts the input point cloud into the one of a frame that
+      is about to be published, once for all its recipients. It is given
+      the dimensions of the images if it is unorganized (simulation) and
+      the depth of the frame's interpolated depth image
+      @param[out] framePtr [const SynchronizedFramePtr&]
+      The frame, whose depth image is already set
+      @param[in] pcMsg [const sensor_msgs::PointCloud2ConstPtr&] The input
+      point cloud
+      @return void
+      **/
+    void
+    setFramePointCloud(
+        const SynchronizedFramePtr& framePtr,
         const sensor_msgs::PointCloud2ConstPtr& pcMsg);
 
+    /**
+      @brief Publishes the images of a frame as an enhanced image
+      @param[in] frame [const SynchronizedFrame&]
+      The frame
+      @return [boost::shared_ptr<pandora_vision_msgs::EnhancedImage>]
+      The published message
+      **/
+    boost::shared_ptr<pandora_vision_msgs::EnhancedImage>
+    publishEnhancedImage(const SynchronizedFrame& frame);
+
     /**
       @brief Variables regarding the point cloud are needed to be set in
       simulation mode: the point cloud's heigth, width and point step.
@@ -266,19 +299,14 @@ namespace pandora_vision_hole
     // topic
     std::string leaveSubscriptionToInputPointCloudTopic_;
 
-    // The publishers which will advertise the
-    // synchronized point cloud, depth and rgb images extracted from the
-    // point cloud
-    ros::Publisher synchronizedPointCloudPublisher_;
-    ros::Publisher synchronizedDepthImagePublisher_;
-    ros::Publisher synchronizedRgbImagePublisher_;
+    // The publisher which will advertise the synchronized frame: the
+    // point cloud, along with the depth and rgb images extracted from it.
+    // Nodelets in the same manager share the published frame
+    ros::Publisher synchronizedFramePublisher_;
     ros::Publisher synchronizedThermalImagePublisher_;
-    // The names of the topic to which the synchronizer node publishes the
-    // synchronized point cloud, depth and rgb images extracted from the
-    // point cloud
-    std::string synchronizedPointCloudTopic_;
-    std::string synchronizedDepthImageTopic_;
-    std::string synchronizedRgbImageTopic_;
+    // The names of the topics to which the synchronizer node publishes the
+    // synchronized frame and thermal image
+    std::string synchronizedFrameTopic_;
     std::string synchronizedThermalImageTopic_;
 
     ros::Publisher thermalOutputReceiverPublisher_;
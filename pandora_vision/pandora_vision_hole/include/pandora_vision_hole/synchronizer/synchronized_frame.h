@@ -0,0 +1,213 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Alexandros Philotheou, Manos Tsardoulias, Angelos Triantafyllidis
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_SYNCHRONIZER_SYNCHRONIZED_FRAME_H
+#define PANDORA_VISION_HOLE_SYNCHRONIZER_SYNCHRONIZED_FRAME_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <ros/message_traits.h>
+#include <ros/serialization.h>
+#include <std_msgs/Header.h>
+#include <sensor_msgs/Image.h>
+#include <pcl/point_types.h>
+#include <pcl_ros/point_cloud.h>
+
+#include "pandora_vision_hole/SynchronizedFrameMsg.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @struct SynchronizedFrame
+    @brief One frame of the depth sensor, as published by the synchronizer.
+    It is a pandora_vision_hole/SynchronizedFrameMsg on the wire, but holds
+    its point cloud already converted to pcl. Nodelets in the same manager
+    share the converted cloud itself; only subscribers in other processes
+    pay for a conversion, as with pcl_ros point clouds
+   **/
+  struct SynchronizedFrame
+  {
+    typedef boost::shared_ptr<SynchronizedFrame> Ptr;
+    typedef boost::shared_ptr<const SynchronizedFrame> ConstPtr;
+
+    SynchronizedFrame() : isDepth(false)
+    {
+    }
+
+    std_msgs::Header header;
+
+    // The input point cloud, with the depth of the interpolated depth
+    // image. Its height and width are set even if the input is
+    // unorganized (simulation)
+    pcl::PointCloud<pcl::PointXYZRGB>::ConstPtr pointCloud;
+
+    // The RGB image extracted from the point cloud
+    sensor_msgs::Image rgbImage;
+
+    // The interpolated depth image extracted from the point cloud
+    sensor_msgs::Image depthImage;
+
+    // Whether the depth image holds valid depth, so that depth analysis
+    // is possible
+    bool isDepth;
+  };
+
+  typedef SynchronizedFrame::Ptr SynchronizedFramePtr;
+  typedef SynchronizedFrame::ConstPtr SynchronizedFrameConstPtr;
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+namespace ros
+{
+namespace message_traits
+{
+  template<>
+  struct MD5Sum<pandora_vision::pandora_vision_hole::SynchronizedFrame>
+  {
+    static const char* value()
+    {
+      return MD5Sum< ::pandora_vision_hole::SynchronizedFrameMsg>::value();
+    }
+
+    static const char* value(
+      const pandora_vision::pandora_vision_hole::SynchronizedFrame&)
+    {
+      return value();
+    }
+  };
+
+  template<>
+  struct DataType<pandora_vision::pandora_vision_hole::SynchronizedFrame>
+  {
+    static const char* value()
+    {
+      return DataType< ::pandora_vision_hole::SynchronizedFrameMsg>::value();
+    }
+
+    static const char* value(
+      const pandora_vision::pandora_vision_hole::SynchronizedFrame&)
+    {
+      return value();
+    }
+  };
+
+  template<>
+  struct Definition<pandora_vision::pandora_vision_hole::SynchronizedFrame>
+  {
+    static const char* value()
+    {
+      return Definition< ::pandora_vision_hole::SynchronizedFrameMsg>::value();
+    }
+
+    static const char* value(
+      const pandora_vision::pandora_vision_hole::SynchronizedFrame&)
+    {
+      return value();
+    }
+  };
+
+  template<>
+  struct HasHeader<pandora_vision::pandora_vision_hole::SynchronizedFrame>
+    : TrueType
+  {
+  };
+}  // namespace message_traits
+
+namespace serialization
+{
+  /**
+    @brief Serializes a frame in the field order of SynchronizedFrameMsg,
+    its point cloud through the pcl_ros serializer
+   **/
+  template<>
+  struct Serializer<pandora_vision::pandora_vision_hole::SynchronizedFrame>
+  {
+    typedef pandora_vision::pandora_vision_hole::SynchronizedFrame Frame;
+    typedef pcl::PointCloud<pcl::PointXYZRGB> Cloud;
+
+    template<typename Stream>
+    inline static void write(Stream& stream, const Frame& m)
+    {
+      stream.next(m.header);
+      stream.next(cloud(m));
+      stream.next(m.rgbImage);
+      stream.next(m.depthImage);
+      stream.next(m.isDepth);
+    }
+
+    template<typename Stream>
+    inline static void read(Stream& stream, Frame& m)
+    {
+      stream.next(m.header);
+      boost::shared_ptr<Cloud> pointCloud(new Cloud);
+      stream.next(*pointCloud);
+      m.pointCloud = pointCloud;
+      stream.next(m.rgbImage);
+      stream.next(m.depthImage);
+      stream.next(m.isDepth);
+    }
+
+    inline static uint32_t serializedLength(const Frame& m)
+    {
+      return serializationLength(m.header)
+        + serializationLength(cloud(m))
+        + serializationLength(m.rgbImage)
+        + serializationLength(m.depthImage)
+        + serializationLength(m.isDepth);
+    }
+
+   private:
+    /**
+      @brief The point cloud of a frame, or an empty one if it has none
+     **/
+    inline static const Cloud& cloud(const Frame& m)
+    {
+      static const Cloud empty;
+      return m.pointCloud ? *m.pointCloud : empty;
+    }
+  };
+}  // namespace serialization
+}  // namespace ros
+
+#endif  // PANDORA_VISION_HOLE_SYNCHRONIZER_SYNCHRONIZED_FRAME_H
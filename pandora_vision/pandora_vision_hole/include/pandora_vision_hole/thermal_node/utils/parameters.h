@@ -151,6 +151,11 @@ namespace thermal
       //  1 for brushfire near
       //  2 for brushfire far
       static int interpolation_method;
+
+      //  Whether the averaging interpolation (method 0) is replaced by
+      //  giving every black pixel the value of its nearest non-black pixel,
+      //  found by jump flooding
+      static bool use_jump_flooding;
     };
 
     //  Parameters specific to the Thermal node
@@ -365,6 +370,10 @@ namespace thermal
         //  Urgent : when depth analysis is not applicable, we can only rely
         //  on RGB analysis
         static float rgb_validity_threshold;
+
+        //  Stop applying filters to a candidate hole as soon as it
+        //  cannot be found valid by the validation process
+        static bool short_circuit_filters;
       };
 
       //  Parameters specific to detection of planes
@@ -374,6 +383,19 @@ namespace thermal
         static int max_iterations;
         static double num_points_to_exclude;
         static double point_to_plane_distance_threshold;
+
+        //  Segment the planes of the whole point cloud once per frame,
+        //  instead of fitting planes to the points of each hole. Off by
+        //  default: the frame's planes are not the ones fitted per hole,
+        //  and the thresholds of the depth filters are tuned to the latter
+        static bool segment_whole_frame;
+
+        //  The least number of points of a plane of the whole point cloud
+        static int min_plane_inliers;
+
+        //  The largest angle, in degrees, between the normals of
+        //  two neighbouring points of one plane
+        static double plane_angular_threshold;
       };
 
       //  Parameters specific to the merging of holes
@@ -393,6 +415,10 @@ namespace thermal
 
       //  The inflation size of holes' bounding rectangles.
       static int rectangle_inflation_size;
+
+      //  The number of holes whose resources are kept between frames.
+      //  Zero disables the cache
+      static int resources_cache_size;
     };
 
 
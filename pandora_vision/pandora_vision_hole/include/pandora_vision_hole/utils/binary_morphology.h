@@ -0,0 +1,194 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_UTILS_BINARY_MORPHOLOGY_H
+#define PANDORA_VISION_HOLE_UTILS_BINARY_MORPHOLOGY_H
+
+#include <bitset>
+#include <vector>
+#include <stdint.h>
+#include <opencv2/opencv.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @class BinaryMorphology
+    @brief Hit-or-miss based operators on binary images. The image is kept
+    bit-packed, the 3x3 neighbourhood of a pixel is encoded as an 8-bit
+    index into lookup tables built from the operator's kernels, and after
+    the first pass only pixels next to a removed one are examined again.
+    An instance holds only its own tables and buffers, so different
+    instances may be used concurrently.
+   **/
+  class BinaryMorphology
+  {
+    public:
+      /**
+        @brief Builds the lookup tables of the thinning and pruning kernels
+       **/
+      BinaryMorphology();
+
+      /**
+        @brief Performs steps of strict pruning (removes more stuff).
+        Equivalent to the kernel based pruning of Morphology, with pixels
+        outside the image considered zero
+        Caution: This method presupposes that the input image @param img is
+        a thinned image
+        @param img [cv::Mat*] The input image in CV_8UC1 format
+        @param steps [int] Number of operator steps
+        @return void
+       **/
+      void pruningStrictIterative(cv::Mat* img, int steps);
+
+      /**
+        @brief Performs steps of thinning
+        (http://homepages.inf.ed.ac.uk/rbf/HIPR2/thin.htm). Equivalent to
+        the kernel based thinning of Morphology: in each step every kernel
+        removes the first pixel it matches in raster order; pixels on the
+        image's borders are left untouched
+        @param inImage [const cv::Mat&] The input image in CV_8UC1 format
+        @param outImage [cv::Mat*] The output image in CV_8UC1 format
+        @param steps [int] Number of operator steps
+        @return void
+       **/
+      void thinning(const cv::Mat& inImage, cv::Mat* outImage, int steps);
+
+      /**
+        @brief pruningStrictIterative on a raw CV_8UC1 buffer, in place
+        @param data [unsigned char*] The first pixel of the image
+        @param rows [int] The image's height
+        @param cols [int] The image's width
+        @param step [size_t] The distance in bytes between two rows
+        @param steps [int] Number of operator steps
+        @return void
+       **/
+      void pruningStrictIterative(unsigned char* data, int rows, int cols,
+        size_t step, int steps);
+
+      /**
+        @brief thinning on a raw CV_8UC1 buffer, in place
+        @param data [unsigned char*] The first pixel of the image
+        @param rows [int] The image's height
+        @param cols [int] The image's width
+        @param step [size_t] The distance in bytes between two rows
+        @param steps [int] Number of operator steps
+        @return void
+       **/
+      void thinning(unsigned char* data, int rows, int cols,
+        size_t step, int steps);
+
+      /**
+        @brief Encodes the 3x3 neighbourhood of a pixel as an 8-bit index.
+        Bit 0 is the upper left neighbour and bits go on in raster order,
+        skipping the center
+        @param neighbourhood [const char [3][3]] The neighbourhood; non-zero
+        entries are set
+        @return unsigned int : The index
+       **/
+      static unsigned int encode(const char neighbourhood[3][3]);
+
+    private:
+      /**
+        @brief Builds the table of the neighbourhoods matched by a kernel
+        whose center is 1
+        @param kernel [const char [3][3]] The kernel; 0 must be unset, 1
+        must be set and 2 is don't care
+        @param table [std::bitset<256>*] The table, OR-ed with the matches
+        @return void
+       **/
+      static void buildTable(const char kernel[3][3], std::bitset<256>* table);
+
+      /**
+        @brief Packs the non-zero pixels of an image into bits_, surrounded
+        by a one pixel wide zero border
+       **/
+      void load(const unsigned char* data, int rows, int cols, size_t step);
+
+      /**
+        @brief The neighbourhood index of a pixel, in image coordinates
+       **/
+      unsigned int neighbourhood(int row, int col) const;
+
+      /**
+        @brief Whether a pixel is set, in image coordinates
+       **/
+      bool isSet(int row, int col) const;
+
+      /**
+        @brief Unsets a pixel both in bits_ and in the image
+       **/
+      void clear(unsigned char* data, size_t step, int row, int col);
+
+      /**
+        @brief Records in matches_ which thinning kernels match a pixel of
+        the interior of the image, and lowers firstMatch_ accordingly
+        @param row [int] The pixel's row
+        @param col [int] The pixel's column
+        @return void
+       **/
+      void updateMatches(int row, int col);
+
+    private:
+      /// The neighbourhoods matched by each of the eight thinning kernels
+      std::bitset<256> thinningTables_[8];
+      /// The neighbourhoods matched by any of the pruning kernels
+      std::bitset<256> pruningTable_;
+
+      int rows_;
+      int cols_;
+      /// The number of 64-bit words of a padded row
+      int stride_;
+      /// The image, one bit per pixel, with a one pixel wide zero border
+      std::vector<uint64_t> bits_;
+      /// Per pixel bits marking the frontiers it is a member of
+      std::vector<unsigned char> queued_;
+      /// The pixels each thinning kernel matches, one bit per pixel
+      std::vector<uint64_t> matches_[8];
+      /// A lower bound of the word of the first match of each kernel
+      int firstMatch_[8];
+  };
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_UTILS_BINARY_MORPHOLOGY_H
@@ -0,0 +1,233 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_UTILS_BRUSHFIRE_H
+#define PANDORA_VISION_HOLE_UTILS_BRUSHFIRE_H
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @class Brushfire
+    @brief Wavefront expansions over the zero-value pixels of an image.
+    Every pixel is stamped with the number of the last flood that reached
+    it, so the visited map is never cleared between floods, and frontiers
+    are kept in one flat queue. The buffers grow to the largest image seen
+    and are reused from then on; use Brushfire::local() so that every
+    thread keeps its own instance.
+   **/
+  class Brushfire
+  {
+    public:
+      Brushfire();
+
+      /**
+        @brief The instance of the calling thread
+       **/
+      static Brushfire& local();
+
+      /**
+        @brief A second instance of the calling thread, for series of
+        floods fenced off by exclude(). Its exclusions outlive reset(), so
+        they are kept away from the floods made through local()
+       **/
+      static Brushfire& localFenced();
+
+      /**
+        @brief Starts labelling the pixels of an image. Floods made from now
+        on are numbered 0, 1, ... by label()
+        @param rows [int] The rows of the image
+        @param cols [int] The columns of the image
+        @return void
+       **/
+      void reset(int rows, int cols);
+
+      /**
+        @brief Keeps every flood from expanding through a pixel, until
+        clearExclusions() is called or the image size changes. Exclusions
+        survive reset(), so that a series of floods can fence off what the
+        previous ones reached by stamping each pixel once
+        @param index [unsigned int] The index (row * cols + col) of the pixel
+        @return void
+       **/
+      void exclude(unsigned int index);
+
+      /**
+        @brief Lifts all the exclusions at once
+        @param rows [int] The rows of the image
+        @param cols [int] The columns of the image
+        @return void
+       **/
+      void clearExclusions(int rows, int cols);
+
+      /**
+        @brief The number of distinct pixels excluded since the last
+        clearExclusions()
+       **/
+      unsigned int excludedCount() const
+      {
+        return excludedCount_;
+      }
+
+      /**
+        @brief Whether a pixel is excluded
+       **/
+      bool excluded(unsigned int index) const
+      {
+        return excluded_[index] == exclusion_;
+      }
+
+      /**
+        @brief Expands from a pixel through the zero-value pixels of an
+        image. The seed is expanded whatever its value. Its results are
+        available through region() and outline() until the next flood
+        @param image [const cv::Mat&] The image, in CV_8UC1 or CV_32FC1 format
+        @param seed [unsigned int] The index of the pixel to start from
+        @param eightConnected [bool] Whether to expand diagonally too
+        @return void
+       **/
+      void flood(const cv::Mat& image, unsigned int seed,
+        bool eightConnected);
+
+      /**
+        @brief The pixels expanded by the last flood, in breadth first
+        order, the seed first
+       **/
+      const std::vector<unsigned int>& region() const
+      {
+        return region_;
+      }
+
+      /**
+        @brief The non-zero value neighbours of the pixels of region(),
+        the seed first if its value is non-zero
+       **/
+      const std::vector<unsigned int>& outline() const
+      {
+        return outline_;
+      }
+
+      /**
+        @brief The number of the last flood since reset() that reached a
+        pixel, or -1 if none did
+       **/
+      int label(unsigned int index) const
+      {
+        return stamps_[index] > base_ ?
+          static_cast<int>(stamps_[index] - base_ - 1) : -1;
+      }
+
+      /**
+        @brief Replaces the zero-value pixels off the image's borders with
+        the mean value of their non-zero 8-neighbours, peeling the zero
+        areas layer by layer from their outside in. A layer sees only the
+        values of the layers outside it, which makes the result identical to
+        repeated NoiseElimination::interpolationIteration calls, in time
+        linear to the number of pixels
+        @param image [cv::Mat*] The image, in CV_32FC1 format
+        @return void
+       **/
+      void meanFill(cv::Mat* image);
+
+      /**
+        @brief Replaces every zero-value pixel with the value of its nearest
+        non-zero pixel, found by jump flooding: log2(size) + 1 passes of
+        9 lookups per pixel, independently of the size of the zero areas.
+        Nearest is exact up to the rare misses of jump flooding
+        @param image [cv::Mat*] The image, in CV_32FC1 format
+        @return void
+       **/
+      void nearestFill(cv::Mat* image);
+
+    private:
+      template <typename T>
+      void expand(const cv::Mat& image, unsigned int seed, bool eightConnected);
+
+      /**
+        @brief Resizes the stamps to an image's size, restarting them if
+        their count is about to wrap
+       **/
+      void prepare(int rows, int cols);
+
+      /**
+        @brief Starts a new flood, returning its stamp
+       **/
+      unsigned int nextStamp();
+
+    private:
+      int rows_;
+      int cols_;
+
+      /// The stamp of the last flood that reached every pixel
+      std::vector<unsigned int> stamps_;
+      /// The last stamp given
+      unsigned int stamp_;
+      /// The last stamp given before reset()
+      unsigned int base_;
+
+      /// The exclusion stamp of every pixel, current if equal to exclusion_
+      std::vector<unsigned int> excluded_;
+      unsigned int exclusion_;
+      unsigned int excludedCount_;
+
+      /// The queue of the last flood
+      std::vector<unsigned int> region_;
+      std::vector<unsigned int> outline_;
+
+      /// The end of every layer of meanFill inside region_ and the
+      /// values of the layer being filled
+      std::vector<unsigned int> layerEnds_;
+      std::vector<float> values_;
+
+      /// The nearest non-zero pixel found for every pixel, before and
+      /// after a pass of nearestFill
+      std::vector<cv::Point> nearest_;
+      std::vector<cv::Point> nearestNext_;
+  };
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_UTILS_BRUSHFIRE_H
@@ -0,0 +1,131 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_UTILS_CURVE_EXTRACTION_H
+#define PANDORA_VISION_HOLE_UTILS_CURVE_EXTRACTION_H
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @struct Curve
+    @brief A 8-connected set of non-zero pixels of a binary image
+   **/
+  struct Curve
+  {
+    /// The indices (row * cols + col) of the curve's pixels, in raster order
+    std::vector<unsigned int> points;
+
+    /// The indices of the curve's two end points that lie the farthest
+    /// apart along it
+    unsigned int first;
+    unsigned int second;
+  };
+
+  /**
+    @class CurveExtraction
+    @brief Extracts the curves of a binary image of thinned edges. Curves are
+    labelled in one raster pass with a union-find over 8-connected pixels,
+    which also counts the neighbours of every pixel: pixels with at most one
+    neighbour are end points and pixels with more than two are junctions.
+    An instance holds only its own buffers, so different instances may be
+    used concurrently.
+   **/
+  class CurveExtraction
+  {
+    public:
+      /**
+        @brief Finds the curves of an image having more than a number of
+        pixels, along with the pair of end points of each
+        @param image [const cv::Mat&] The input image in CV_8UC1 format
+        @param minimumPoints [int] Curves with up to as many pixels are
+        discarded
+        @param curves [std::vector<Curve>*] The curves found, in the raster
+        order of their first pixel
+        @return void
+       **/
+      void extract(const cv::Mat& image, int minimumPoints,
+        std::vector<Curve>* curves);
+
+    private:
+      /**
+        @brief The root of a provisional label, compressing the path to it
+       **/
+      int findRoot(int label);
+
+      /**
+        @brief Joins the sets of two provisional labels
+       **/
+      void join(int first, int second);
+
+      /**
+        @brief Walks a curve breadth first from one of its pixels
+        @param label [int] The label of the curve's pixels in labels_
+        @param start [unsigned int] The index of the pixel to start from
+        @return unsigned int : The index of the last pixel reached, one of
+        the farthest from start
+       **/
+      unsigned int farthest(int label, unsigned int start);
+
+    private:
+      int rows_;
+      int cols_;
+
+      /// The label of every pixel, -1 for zero pixels
+      std::vector<int> labels_;
+      /// The number of non-zero 8-neighbours of every pixel
+      std::vector<unsigned char> degrees_;
+      /// The union-find forest of provisional labels
+      std::vector<int> parents_;
+      /// Whether a pixel has been reached by the current walk
+      std::vector<unsigned char> visited_;
+      /// The queue of the walk
+      std::vector<unsigned int> queue_;
+  };
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_UTILS_CURVE_EXTRACTION_H
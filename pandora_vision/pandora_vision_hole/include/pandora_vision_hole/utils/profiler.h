@@ -0,0 +1,264 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_UTILS_PROFILER_H
+#define PANDORA_VISION_HOLE_UTILS_PROFILER_H
+
+#ifndef DEFINES
+#define DEFINES
+#define PKG_NAME "hole_detector"
+#endif  // DEFINES
+
+#include <stdint.h>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @class Profiler
+    @brief Accumulates the time spent in named probes, arranged in a tree
+    through the name of each probe's parent.
+    A probe is registered once, the first time its site runs, and is
+    identified by an index thereafter. Each thread accumulates its
+    measurements in its own slots, which only it writes, so that
+    measuring takes neither a lock nor a lookup by name. The slots of all
+    threads are summed up when a report is made.
+    Probes are placed through the PROFILE_* macros below, which expand to
+    nothing unless DEBUG_TIME is defined
+   **/
+  class Profiler
+  {
+    public:
+      //!< The maximum number of distinct probes
+      static const int MAX_PROBES = 512;
+
+      /**
+        @struct Statistics
+        @brief The measurements of a probe, summed up over all threads.
+        Times are in nanoseconds
+       **/
+      struct Statistics
+      {
+        std::string name;
+        std::string parent;
+        uint64_t count;
+        uint64_t total;
+        uint64_t min;
+        uint64_t max;
+      };
+
+      /**
+        @brief Registers a probe, or finds the one registered under
+        the same name. The parent of a probe is the one it was first
+        registered with
+        @param[in] name [const char*] The name of the probe
+        @param[in] parent [const char*] The name of its parent probe,
+        empty for a root one
+        @return [int] The probe's index, or -1 if there is no room left
+       **/
+      static int registerProbe(const char* name, const char* parent);
+
+      /**
+        @brief The time of a monotonic clock
+        @return [uint64_t] The time in nanoseconds
+       **/
+      static uint64_t now();
+
+      /**
+        @brief Adds a measurement to the calling thread's slot of a probe
+        @param[in] probe [int] The index of the probe
+        @param[in] duration [uint64_t] The duration in nanoseconds
+        @return void
+       **/
+      static void record(int probe, uint64_t duration);
+
+      /**
+        @brief Called when the scope of a root probe ends. Reports the
+        measurements, at most once per report period
+        @return void
+       **/
+      static void rootDone();
+
+      /**
+        @brief Sums up the measurements of every probe over all threads
+        @return [std::vector<Statistics>] The statistics of the probes,
+        in the order they were registered
+       **/
+      static std::vector<Statistics> collect();
+
+      /**
+        @brief Writes the tree of the probes, starting from the root ones,
+        as [count - min , mean , max - total] in milliseconds
+        @param[out] out [std::ostream&] The stream to write to
+        @return void
+       **/
+      static void writeTree(std::ostream& out);
+
+      /**
+        @brief Writes the statistics of the probes as comma separated
+        values, one probe per line, times in milliseconds
+        @param[out] out [std::ostream&] The stream to write to
+        @return void
+       **/
+      static void writeTrace(std::ostream& out);
+
+      /**
+        @brief Sets the period of the reports on the log, one second
+        by default
+        @param[in] seconds [double] The period, non positive to report
+        each time a root probe's scope ends
+        @return void
+       **/
+      static void setReportPeriod(double seconds);
+
+      /**
+        @brief Sets a file that is rewritten with the trace of the probes
+        each time a report is made
+        @param[in] path [const std::string&] The path of the file, empty for
+        no file
+        @return void
+       **/
+      static void setTraceFile(const std::string& path);
+
+      /**
+        @brief Clears the measurements of all threads. The probes stay
+        registered. Measurements taken meanwhile by other threads may
+        survive it
+        @return void
+       **/
+      static void reset();
+
+    private:
+      Profiler() {}
+  };
+
+  /**
+    @class ScopedProbe
+    @brief Measures the time from its construction until it is stopped or
+    destroyed, whichever comes first
+   **/
+  class ScopedProbe
+  {
+    public:
+      ScopedProbe(int probe, bool root = false)
+        : probe_(probe), root_(root), begin_(Profiler::now())
+      {
+      }
+
+      ~ScopedProbe()
+      {
+        stop();
+      }
+
+      void stop()
+      {
+        if (probe_ < 0)
+        {
+          return;
+        }
+        Profiler::record(probe_, Profiler::now() - begin_);
+        probe_ = -1;
+        if (root_)
+        {
+          Profiler::rootDone();
+        }
+      }
+
+    private:
+      int probe_;
+      bool root_;
+      uint64_t begin_;
+
+      ScopedProbe(const ScopedProbe&);
+      ScopedProbe& operator=(const ScopedProbe&);
+  };
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#define PROFILER_CONCAT_(a, b) a ## b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_(a, b)
+
+#ifdef DEBUG_TIME
+
+//  Measures the rest of the enclosing scope under a probe of a parent probe
+#define PROFILE_SCOPE(name, parent) \
+  static const int PROFILER_CONCAT(profilerProbe, __LINE__) = \
+    ::pandora_vision::pandora_vision_hole::Profiler::registerProbe( \
+      name, parent); \
+  ::pandora_vision::pandora_vision_hole::ScopedProbe \
+    PROFILER_CONCAT(profilerScope, __LINE__)( \
+      PROFILER_CONCAT(profilerProbe, __LINE__))
+
+//  Measures the rest of the enclosing scope under a root probe, reporting
+//  the measurements of all probes when the scope ends
+#define PROFILE_ROOT_SCOPE(name) \
+  static const int PROFILER_CONCAT(profilerProbe, __LINE__) = \
+    ::pandora_vision::pandora_vision_hole::Profiler::registerProbe( \
+      name, ""); \
+  ::pandora_vision::pandora_vision_hole::ScopedProbe \
+    PROFILER_CONCAT(profilerScope, __LINE__)( \
+      PROFILER_CONCAT(profilerProbe, __LINE__), true)
+
+//  Measures from here until the matching PROFILE_END(id) of the same scope
+#define PROFILE_BEGIN(id, name, parent) \
+  static const int PROFILER_CONCAT(id, Probe) = \
+    ::pandora_vision::pandora_vision_hole::Profiler::registerProbe( \
+      name, parent); \
+  ::pandora_vision::pandora_vision_hole::ScopedProbe \
+    id(PROFILER_CONCAT(id, Probe))
+
+#define PROFILE_END(id) id.stop()
+
+#else
+
+#define PROFILE_SCOPE(name, parent)
+#define PROFILE_ROOT_SCOPE(name)
+#define PROFILE_BEGIN(id, name, parent)
+#define PROFILE_END(id)
+
+#endif  // DEBUG_TIME
+
+#endif  // PANDORA_VISION_HOLE_UTILS_PROFILER_H
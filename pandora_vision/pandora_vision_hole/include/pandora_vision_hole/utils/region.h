@@ -0,0 +1,200 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_HOLE_UTILS_REGION_H
+#define PANDORA_VISION_HOLE_UTILS_REGION_H
+
+#include <set>
+#include <vector>
+#include <opencv2/opencv.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @class Region
+    @brief A set of pixels of an image, stored as runs of consecutive
+    pixels of the same row, sorted by row and column. A hole's mask takes
+    one run per row it spans instead of one tree node per pixel, its
+    pixels are visited row by row through the image's memory, and
+    unions, intersections and differences of masks are computed by
+    sweeping through the runs of both.
+    A pixel's index is row * cols + col, as in the masks' sets it replaces
+   **/
+  class Region
+  {
+    public:
+      /**
+        @struct Run
+        @brief The pixels of a row, from column begin up to, but not
+        including, column end
+       **/
+      struct Run
+      {
+        int row;
+        int begin;
+        int end;
+      };
+
+      Region();
+
+      /**
+        @brief An empty region of an image
+        @param cols [int] The columns of the image
+       **/
+      explicit Region(int cols);
+
+      /**
+        @brief The non-zero value pixels of an image
+        @param mask [const cv::Mat&] The image, in CV_8UC1 format
+        @return [Region] The region
+       **/
+      static Region fromMask(const cv::Mat& mask);
+
+      /**
+        @brief The pixels with the given indices
+        @param indices [const std::set<unsigned int>&] The indices
+        @param cols [int] The columns of the image the indices refer to
+        @return [Region] The region
+       **/
+      static Region fromIndices(const std::set<unsigned int>& indices,
+        int cols);
+
+      /**
+        @brief Draws the region onto an image
+        @param mask [cv::Mat*] The image, in CV_8UC1 format, of the size
+        of the region's image
+        @param value [unsigned char] The value of the region's pixels
+        @return void
+       **/
+      void toMask(cv::Mat* mask, unsigned char value = 255) const;
+
+      /**
+        @brief The indices of the region's pixels, in ascending order
+        @param indices [std::vector<unsigned int>*] The indices
+        @return void
+       **/
+      void toIndices(std::vector<unsigned int>* indices) const;
+
+      /**
+        @brief Adds pixels after the ones already in the region. A run that
+        touches or overlaps the last run is merged into it
+        @param row [int] The row of the pixels, not before the last run's
+        @param begin [int] The first column, not before the last run's
+        if the row is the last run's
+        @param end [int] One past the last column
+        @return void
+       **/
+      void append(int row, int begin, int end);
+
+      /**
+        @brief The pixels of either region
+       **/
+      Region unite(const Region& other) const;
+
+      /**
+        @brief The pixels of both regions
+       **/
+      Region intersect(const Region& other) const;
+
+      /**
+        @brief The pixels of this region that are not in the other
+       **/
+      Region subtract(const Region& other) const;
+
+      /**
+        @brief The number of pixels of both regions, without
+        constructing their intersection
+       **/
+      int intersectionArea(const Region& other) const;
+
+      /**
+        @brief Whether a pixel is in the region; logarithmic in the
+        number of runs
+        @param index [unsigned int] The index of the pixel
+       **/
+      bool contains(unsigned int index) const;
+
+      /**
+        @brief The upright rectangle enclosing the region, empty if the
+        region is empty
+       **/
+      cv::Rect boundingBox() const;
+
+      /**
+        @brief The number of pixels of the region
+       **/
+      int area() const
+      {
+        return area_;
+      }
+
+      bool empty() const
+      {
+        return runs_.empty();
+      }
+
+      /**
+        @brief The columns of the image the region lies on
+       **/
+      int cols() const
+      {
+        return cols_;
+      }
+
+      const std::vector<Run>& runs() const
+      {
+        return runs_;
+      }
+
+      void clear();
+
+    private:
+      int cols_;
+      int area_;
+      std::vector<Run> runs_;
+  };
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
+
+#endif  // PANDORA_VISION_HOLE_UTILS_REGION_H
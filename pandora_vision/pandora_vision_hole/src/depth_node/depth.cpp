@@ -84,8 +84,8 @@ namespace depth
     // transactionary affairs with
     getTopicNames();
 
-    // Subscribe to the depth image published by the
-    // rgb_depth_synchronizer node
+    // Subscribe to the frames, holding the depth image, published by the
+    // synchronizer node
     depthImageSubscriber_ = nodeHandle_.subscribe(depthImageTopic_, 1,
       &Depth::inputDepthImageCallback, this);
 
@@ -103,35 +103,33 @@ namespace depth
 
 
   /**
-    @brief Callback for the depth image received by the synchronizer node.
+    @brief Callback for the frame published by the synchronizer node.
 
-    The depth image message received by the synchronizer node is unpacked
-    in a cv::Mat image and stripped of its noise.
+    The frame's interpolated depth image is viewed as a cv::Mat image,
+    without being copied.
     Holes are then located inside this image and information about them,
     along with the denoised image, is then sent to the hole fusion node
-    @param msg [const sensor_msgs::Image&] The depth image message
+    @param msg [const SynchronizedFrameConstPtr&]
+    The synchronized frame
     @return void
    **/
   void
   Depth::
-  inputDepthImageCallback(const sensor_msgs::ImageConstPtr& msg)
+  inputDepthImageCallback(
+      const SynchronizedFrameConstPtr& msg)
   {
-#ifdef DEBUG_TIME
-    Timer::start("inputDepthImageCallback", "", true);
-#endif
+    PROFILE_ROOT_SCOPE("inputDepthImageCallback");
 
-    // Obtain the depth image. Since the image is in a format of
-    // sensor_msgs::Image, it has to be transformed into a cv format in order
-    // to be processed. Its cv format will be CV_32FC1.
-    cv::Mat depthImage;
-    MessageConversions::extractImageFromMessage(*msg, &depthImage,
-      sensor_msgs::image_encodings::TYPE_32FC1);
+    // Obtain the depth image. Its cv format will be CV_32FC1.
+    // Its pixels are those of the frame, which the other nodes in the
+    // manager share as well: they must not be modified
+    cv::Mat depthImage = cv_bridge::toCvShare(msg->depthImage, msg,
+      sensor_msgs::image_encodings::TYPE_32FC1)->image;
 
     // Regardless of the image representation method, the depth node
     // will publish the interpolated depth image of original size
     // to the Hole Fusion node
-    cv::Mat interpolatedDepthImageSent;
-    depthImage.copyTo(interpolatedDepthImageSent);
+    cv::Mat interpolatedDepthImageSent = depthImage;
 
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_depth_image)
@@ -151,9 +149,11 @@ namespace depth
       cv::minMaxIdx(depthImage, &min, &max);
 
       // Obtain the low-low part of the interpolated depth image via
-      // wavelet analysis
+      // wavelet analysis, into an image of its own
+      cv::Mat lowLowDepthImage;
       Wavelets::getLowLow(depthImage, min, max,
-        &depthImage);
+        &lowLowDepthImage);
+      depthImage = lowLowDepthImage;
     }
 
     // Locate potential holes in the interpolated depth image
@@ -171,15 +171,10 @@ namespace depth
       interpolatedDepthImageSent,
       depthCandidateHolesMsgPtr,
       sensor_msgs::image_encodings::TYPE_32FC1,
-      *msg);
+      msg->depthImage);
 
     // Publish the candidate holes message
     candidateHolesPublisher_.publish(depthCandidateHolesMsgPtr);
-
-#ifdef DEBUG_TIME
-    Timer::tick("inputDepthImageCallback");
-    Timer::printAllMeansTree();
-#endif
   }
 
   /**
@@ -192,12 +187,12 @@ namespace depth
   Depth::
   getTopicNames()
   {
-     // Read the name of the topic from where the depth node acquires the
-    // unadulterated depth image and store it in a private member variable
-    if (!privateNodeHandle_.getParam("subscribed_topics/depth_image_topic",
+    // Read the name of the topic from where the depth node acquires the
+    // synchronized frames and store it in a private member variable
+    if (!privateNodeHandle_.getParam("subscribed_topics/synchronized_frame_topic",
         depthImageTopic_))
     {
-       NODELET_FATAL("[%s] Could not find topic depth_image_topic", nodeName_.c_str());
+      NODELET_FATAL("[%s] Could not find topic synchronized_frame_topic", nodeName_.c_str());
       ROS_BREAK();
     }
 
@@ -60,9 +60,7 @@ namespace depth
    **/
   HolesConveyor DepthHoleDetector::findHoles(const cv::Mat& interpolatedDepthImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("findHoles", "inputDepthImageCallback");
-    #endif
+    PROFILE_SCOPE("findHoles", "inputDepthImageCallback");
 
     #ifdef DEBUG_SHOW
     std::vector<cv::Mat> imgs;
@@ -174,10 +172,6 @@ namespace depth
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::tick("findHoles");
-    #endif
-
     return conveyor;
   }
 
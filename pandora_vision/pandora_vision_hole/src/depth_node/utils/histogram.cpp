@@ -65,9 +65,7 @@ namespace depth
     cv::Mat* backprojection,
     const int& secondaryChannel)
   {
-#ifdef DEBUG_TIME
-    Timer::start("applyBackprojection");
-#endif
+    PROFILE_SCOPE("applyBackprojection", "");
 
     // The vector of backprojection images corresponding to each
     // discrete model histogram
@@ -125,10 +123,6 @@ namespace depth
         }
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyBackprojection");
-    #endif
   }
 
 
@@ -146,9 +140,7 @@ namespace depth
     std::vector<cv::MatND>* histogram,
     const int& secondaryChannel)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("getHistogram", "", true);
-    #endif
+    PROFILE_ROOT_SCOPE("getHistogram");
 
     // The path to the package where the wall pictures directory lies in
     std::string packagePath =
@@ -319,10 +311,6 @@ namespace depth
       delete[] wallImagesHSV;
       delete[] histSize;
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("getHistogram");
-    #endif
   }
 
 }  // namespace depth
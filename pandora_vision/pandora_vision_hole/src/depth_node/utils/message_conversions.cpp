@@ -42,6 +42,7 @@
 #include <sensor_msgs/Image.h>
 #include <std_msgs/Float32MultiArray.h>
 
+#include "pandora_vision_common/pandora_vision_utilities/pointcloud_to_image_converter.h"
 #include "pandora_vision_hole/CandidateHolesVectorMsg.h"
 #include "depth_node/utils/message_conversions.h"
 #include "depth_node/utils/holes_conveyor.h"
@@ -88,50 +89,23 @@ namespace depth
   cv::Mat MessageConversions::convertPointCloudMessageToImage(
     const PointCloudConstPtr& pointCloud, int encoding)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("convertPointCloudMessageToImage");
-    #endif
+    PROFILE_SCOPE("convertPointCloudMessageToImage", "");
 
-    // Prepare the output image
-    cv::Mat image(pointCloud->height, pointCloud->width, encoding);
+    cv::Mat image;
 
     // For the depth image
     if (encoding == CV_32FC1)
     {
-      for (unsigned int row = 0; row < pointCloud->height; ++row)
-      {
-        for (unsigned int col = 0; col < pointCloud->width; ++col)
-        {
-          image.at<float>(row, col) =
-            pointCloud->points[col + pointCloud->width * row].z;
-
-          // if element is nan make it a zero
-          if (image.at<float>(row, col) != image.at<float>(row, col))
-          {
-            image.at<float>(row, col) = 0.0;
-          }
-        }
-      }
+      PointCloudToImageConverter::extractImages(*pointCloud, NULL, &image, NULL);
     }
     else if (encoding == CV_8UC3)  // For the rgb image
     {
-      for (unsigned int row = 0; row < pointCloud->height; ++row)
-      {
-        for (unsigned int col = 0; col < pointCloud->width; ++col)
-        {
-          image.at<unsigned char>(row, 3 * col + 2) =
-            pointCloud->points[col + pointCloud->width * row].r;
-          image.at<unsigned char>(row, 3 * col + 1) =
-            pointCloud->points[col + pointCloud->width * row].g;
-          image.at<unsigned char>(row, 3 * col + 0) =
-            pointCloud->points[col + pointCloud->width * row].b;
-        }
-      }
+      PointCloudToImageConverter::extractImages(*pointCloud, &image, NULL, NULL);
+    }
+    else
+    {
+      image.create(pointCloud->height, pointCloud->width, encoding);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("convertPointCloudMessageToImage");
-    #endif
 
     return image;
   }
@@ -197,9 +171,7 @@ namespace depth
     const HolesConveyor& conveyor,
     std::vector< ::pandora_vision_hole::CandidateHoleMsg >* candidateHolesVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createCandidateHolesVector");
-    #endif
+    PROFILE_SCOPE("createCandidateHolesVector", "");
 
     // Fill the pandora_vision_msgs::CandidateHolesVectorMsg's
     // candidateHoles vector
@@ -228,10 +200,6 @@ namespace depth
       // Push back one hole to the holes vector message
       candidateHolesVector->push_back(holeMsg);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createCandidateHolesVector");
-    #endif
   }
 
 
@@ -257,9 +225,7 @@ namespace depth
     const std::string& encoding,
     const sensor_msgs::Image& msg)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createCandidateHolesVectorMessage");
-    #endif
+    PROFILE_SCOPE("createCandidateHolesVectorMessage", "");
 
     // Fill the ::::pandora_vision_hole::CandidateHolesVectorMsg's
     // candidateHoles vector
@@ -276,10 +242,6 @@ namespace depth
     // Fill the pandora_vision_msgs::CandidateHolesVectorMsg's
     // header
     candidateHolesVectorMsg->header = msg.header;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createCandidateHolesVectorMessage");
-    #endif
   }
 
 
@@ -297,19 +259,13 @@ namespace depth
     cv::Mat* image,
     const std::string& encoding)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("extractImageFromMessage");
-    #endif
+    PROFILE_SCOPE("extractImageFromMessage", "");
 
     cv_bridge::CvImagePtr in_msg;
 
     in_msg = cv_bridge::toCvCopy(msg, encoding);
 
     *image = in_msg->image.clone();
-
-    #ifdef DEBUG_TIME
-    Timer::tick("extractImageFromMessage");
-    #endif
   }
 
 
@@ -327,16 +283,10 @@ namespace depth
     const ::pandora_vision_hole::CandidateHolesVectorMsg& msg,
     cv::Mat* image, const std::string& encoding)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("extractDepthImageFromMessageContainer");
-    #endif
+    PROFILE_SCOPE("extractDepthImageFromMessageContainer", "");
 
     sensor_msgs::Image imageMsg = msg.image;
     extractImageFromMessage(imageMsg, image, encoding);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("extractDepthImageFromMessageContainer");
-    #endif
   }
 
 
@@ -367,9 +317,7 @@ namespace depth
     const int& representationMethod,
     const int& raycastKeypointPartitions)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("fromCandidateHoleMsgToConveyor", "unpackMessage");
-    #endif
+    PROFILE_SCOPE("fromCandidateHoleMsgToConveyor", "unpackMessage");
 
     // Normal mode
     if (representationMethod == 0)
@@ -478,10 +426,6 @@ namespace depth
         conveyor->holes.push_back(hole);
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("fromCandidateHoleMsgToConveyor");
-    #endif
   }
 
 
@@ -512,9 +456,7 @@ namespace depth
     const std::string& encoding,
     const int& raycastKeypointPartitions)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("unpackMessage");
-    #endif
+    PROFILE_SCOPE("unpackMessage", "");
 
     // Unpack the image
     extractImageFromMessageContainer(holesMsg, image, encoding);
@@ -526,10 +468,6 @@ namespace depth
       *image,
       representationMethod,
       raycastKeypointPartitions);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("unpackMessage");
-    #endif
   }
 
   /**
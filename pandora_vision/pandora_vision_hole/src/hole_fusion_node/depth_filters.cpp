@@ -36,6 +36,9 @@
  *********************************************************************/
 
 #include "hole_fusion_node/depth_filters.h"
+#include <algorithm>
+#include <boost/bind.hpp>
+#include "hole_fusion_node/hole_workers.h"
 
 /**
   @namespace pandora_vision
@@ -47,50 +50,143 @@ namespace pandora_vision_hole
 {
 namespace hole_fusion
 {
-  /**
-    @brief Checks for valid holes by area / depth comparison
-    @param[in] conveyor [const HolesConveyor&] The candidate holes
-    @param[in] depthImage [const cv::Mat&] The depth image
-    @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-    A vector that holds sets of points; each point is internal to its
-    respective hole
-    @param[out] msgs [std::vector<std::string>*] Messages for debug
-    reasons
-    @param[out] probabilitiesVector [std::vector<float>*] A vector
-    of probabilities, each position of which hints to the certainty degree
-    with which the associated candidate hole is associated.
-    While the returned set may be reduced in size, the size of this vector
-    is the same throughout and equal to the number of keypoints found and
-    published by the rgb node
-    @return void
-   **/
-  void DepthFilters::checkHolesDepthArea(
-    const HolesConveyor& conveyor,
-    const cv::Mat& depthImage,
-    const std::vector<std::set<unsigned int> >& holesMasksSetVector,
-    std::vector<std::string>* msgs,
-    std::vector<float>* probabilitiesVector)
+  namespace
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesDepthArea", "applyFilter");
-    #endif
+    /**
+      @brief Looks for the proportion of the points of a region that lie on
+      one plane. If the planes of the whole point cloud have been segmented
+      for this frame, the points' labels are counted; otherwise planes are
+      fitted to the region's points alone
+      @param[in] points [const Region&] The points
+      @param[in] initialPointCloud [const PointCloudConstPtr&] The point cloud
+      the region lies on
+      @return [float] The number of points on the most populated plane
+      over the number of points, or -1 if the region is empty
+     **/
+    float planeConstitution(
+      const Region& points,
+      const PointCloudConstPtr& initialPointCloud)
+    {
+      if (points.empty())
+      {
+        return -1;
+      }
+
+      PlanesDetection::PlaneLabelsConstPtr framePlanes =
+        PlanesDetection::getFramePlanes(initialPointCloud);
+
+      if (framePlanes)
+      {
+        // The number of the region's points on each plane; the first
+        // counter is for points on no plane
+        std::vector<int> pointsOnPlane(framePlanes->planes + 1, 0);
+
+        for (unsigned int r = 0; r < points.runs().size(); r++)
+        {
+          const Region::Run& run = points.runs()[r];
+          const int* labels = framePlanes->labels.ptr<int>(run.row);
+
+          for (int c = run.begin; c < run.end; c++)
+          {
+            pointsOnPlane[labels[c]]++;
+          }
+        }
+
+        int maxPoints = 0;
+        for (int p = 1; p <= framePlanes->planes; p++)
+        {
+          maxPoints = std::max(maxPoints, pointsOnPlane[p]);
+        }
+
+        return static_cast<float> (maxPoints) / points.area();
+      }
+
+      // Construct the point cloud that will be checked for plane
+      // constitution
+      PointCloudXYZPtr pointsPointCloud (new PointCloudXYZ);
 
-    for (unsigned int i = 0 ; i < conveyor.size() ; i++)
+      pointsPointCloud->width = points.area();
+      pointsPointCloud->height = 1;
+      pointsPointCloud->points.resize
+        (pointsPointCloud->width * pointsPointCloud->height);
+
+      pointsPointCloud->header.frame_id = initialPointCloud->header.frame_id;
+      pointsPointCloud->header.stamp = initialPointCloud->header.stamp;
+
+      int pointCloudPointsIndex = 0;
+      for (unsigned int r = 0; r < points.runs().size(); r++)
+      {
+        const Region::Run& run = points.runs()[r];
+
+        // The run's points lie next to each other in the point cloud
+        const PointCloud::PointType* row =
+          &initialPointCloud->points[run.row * points.cols()];
+
+        for (int c = run.begin; c < run.end; c++)
+        {
+          pointsPointCloud->points[pointCloudPointsIndex].x = row[c].x;
+          pointsPointCloud->points[pointCloudPointsIndex].y = row[c].y;
+          pointsPointCloud->points[pointCloudPointsIndex].z = row[c].z;
+
+          pointCloudPointsIndex++;
+        }
+      }
+
+      // Check if the points are on a plane
+      std::vector<pcl::PointIndices::Ptr> inliersVector;
+      PlanesDetection::locatePlanes(pointsPointCloud, false, &inliersVector);
+
+      // The probability (in all probability) of the points lying on
+      // one plane will be the ratio of
+      // (max points on one plane) / (all points)
+      int maxPoints = 0;
+      for (unsigned int iv = 0; iv < inliersVector.size(); iv++)
+      {
+        if (inliersVector[iv]->indices.size() > maxPoints)
+        {
+          maxPoints = inliersVector[iv]->indices.size();
+        }
+      }
+
+      return static_cast<float> (maxPoints) / points.area();
+    }
+
+    /**
+      @brief Compares the area of one hole against the one expected at its
+      mean depth
+      @param[in] depthImage [const cv::Mat&] The depth image
+      @param[in] holesMasksRegionVector
+      [const std::vector<Region>&] The points inside each
+      hole's outline
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the hole
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void depthArea(
+      const cv::Mat& depthImage,
+      const std::vector<Region>& holesMasksRegionVector,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
     {
       // The mean depth value of the points inside the i-th hole
       float mean = 0.0;
 
-      for (std::set<unsigned int>::iterator it = holesMasksSetVector[i].begin();
-        it != holesMasksSetVector[i].end(); it++)
+      const std::vector<Region::Run>& runs = holesMasksRegionVector[i].runs();
+      for (unsigned int r = 0; r < runs.size(); r++)
       {
-         int x = static_cast<int>(*it) % depthImage.cols;
-         int y = static_cast<int>(*it) / depthImage.cols;
+        const float* row = depthImage.ptr<float>(runs[r].row);
 
-        mean += depthImage.at<float>(y, x);
+        for (int c = runs[r].begin; c < runs[r].end; c++)
+        {
+          mean += row[c];
+        }
       }
 
       // The number of points inside the i-th hole, or else, its area
-      float area = holesMasksSetVector[i].size();
+      float area = holesMasksRegionVector[i].area();
 
       mean /= area;
 
@@ -112,52 +208,33 @@ namespace hole_fusion
         probabilitiesVector->at(i) = 1.0;
       }
 
-      msgs->push_back(TOSTR(low) + std::string(" / ") + TOSTR(high));
+      *msg = TOSTR(low) + std::string(" / ") + TOSTR(high);
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesDepthArea");
-    #endif
-  }
-
-
-
-  /**
-    @brief Checks for valid holes just by the depth difference between
-    the keypoint of the blob and the edges of its bounding box
-    @param[in] depthImage [const cv::Mat&] The depth image
-    @param[in] conveyor [const HolesConveyor&] The candidate holes
-    @param[in] inflatedRectanglesVector
-    [const std::vector<std::vector<cv::Point2f> >&] A vector that holds
-    the vertices of the inflated rectangle that corresponds to a specific
-    hole inside the coveyor
-    @param[in] inflatedRectanglesIndices [const std::vector<int>&]
-    A vector that is used to identify a hole's corresponding inflated
-    rectangle.
-    Used because the rectangles used are inflated rectangles;
-    not all holes possess an inflated rectangle
-    @param[out] msgs [std::vector<std::string>*] Messages for debug reasons
-    @param[out] probabilitiesVector [std::vector<float>*] A vector
-    of probabilities, each position of which hints to the certainty degree
-    with which the associated candidate hole is associated.
-    While the returned set may be reduced in size, the size of this vector
-    is the same throughout and equal to the number of keypoints found and
-    published by the depth and rgb nodes
-    @return void
-   **/
-  void DepthFilters::checkHolesDepthDiff(
-    const cv::Mat& depthImage,
-    const HolesConveyor& conveyor,
-    const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
-    const std::vector<int>& inflatedRectanglesIndices,
-    std::vector<std::string>* msgs,
-    std::vector<float>* probabilitiesVector)
-  {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesDepthDiff", "applyFilter");
-    #endif
-
-    for (unsigned int i = 0 ; i < inflatedRectanglesIndices.size() ; i++)
+    /**
+      @brief Compares the depth of the keypoint of one hole against the
+      mean depth of the vertices of its inflated rectangle
+      @param[in] depthImage [const cv::Mat&] The depth image
+      @param[in] conveyor [const HolesConveyor&] The candidate holes
+      @param[in] inflatedRectanglesVector
+      [const std::vector<std::vector<cv::Point2f> >&] The vertices of each
+      inflated rectangle
+      @param[in] inflatedRectanglesIndices [const std::vector<int>&] The
+      hole of each inflated rectangle
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the inflated rectangle
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void depthDiff(
+      const cv::Mat& depthImage,
+      const HolesConveyor& conveyor,
+      const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
+      const std::vector<int>& inflatedRectanglesIndices,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
     {
       // The mean distance of this hole's bounding box vertices
       float mean = 0.0;
@@ -208,13 +285,220 @@ namespace hole_fusion
         }
       }
 
-      msgs->push_back(TOSTR(
-          probabilitiesVector->at(inflatedRectanglesIndices[i])));
+      *msg = TOSTR(probabilitiesVector->at(inflatedRectanglesIndices[i]));
+    }
+
+    /**
+      @brief Counts the edge points inside the outline of one hole
+      @param[in] edges [const cv::Mat&] The thresholded edges of the
+      interpolated depth image
+      @param[in] holesMasksRegionVector
+      [const std::vector<Region>&] The points inside each
+      hole's outline
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the hole
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void depthHomogeneity(
+      const cv::Mat& edges,
+      const std::vector<Region>& holesMasksRegionVector,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      // The number of non-zero value pixels in the
+      // interpolatedDepthImageEdges image, inside mask i
+      int numWhites = 0;
+
+      const std::vector<Region::Run>& runs = holesMasksRegionVector[i].runs();
+      for (unsigned int r = 0; r < runs.size(); r++)
+      {
+        const unsigned char* row = edges.ptr<unsigned char>(runs[r].row);
+
+        for (int c = runs[r].begin; c < runs[r].end; c++)
+        {
+          if (row[c] != 0)
+          {
+            numWhites++;
+          }
+        }
+      }
+
+      if (holesMasksRegionVector[i].area() > 0)
+      {
+        probabilitiesVector->at(i) =
+          static_cast<float>(numWhites) / (holesMasksRegionVector[i].area());
+      }
+
+      *msg = TOSTR(probabilitiesVector->at(i));
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesDepthDiff");
-    #endif
+    /**
+      @brief Checks whether the intermediate points of one hole lie on
+      one plane. Holes without intermediate points get no message
+      @param[in] initialPointCloud [const PointCloudConstPtr&] The point cloud
+      @param[in] intermediatePointsRegionVector
+      [const std::vector<Region>&] The points between each
+      hole's outline and its bounding rectangle
+      @param[in] inflatedRectanglesIndices [const std::vector<int>&] The
+      hole of each inflated rectangle
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the inflated rectangle
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void outlineToRectanglePlaneConstitution(
+      const PointCloudConstPtr& initialPointCloud,
+      const std::vector<Region>& intermediatePointsRegionVector,
+      const std::vector<int>& inflatedRectanglesIndices,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      float probability = planeConstitution(
+        intermediatePointsRegionVector[i], initialPointCloud);
+
+      if (probability >= 0)
+      {
+        probabilitiesVector->at(inflatedRectanglesIndices[i]) = probability;
+
+        *msg = TOSTR(probabilitiesVector->at(inflatedRectanglesIndices[i]));
+      }
+    }
+
+    /**
+      @brief Checks whether the points on the edges of the inflated
+      rectangle of one hole lie on one plane
+      @param[in] inImage [const cv::Mat&] The input depth image
+      @param[in] initialPointCloud [const PointCloudConstPtr&] The point cloud
+      @param[in] inflatedRectanglesVector
+      [const std::vector<std::vector<cv::Point2f> >&] The vertices of each
+      inflated rectangle
+      @param[in] inflatedRectanglesIndices [const std::vector<int>&] The
+      hole of each inflated rectangle
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the inflated rectangle
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void rectangleEdgesPlaneConstitution(
+      const cv::Mat& inImage,
+      const PointCloudConstPtr& initialPointCloud,
+      const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
+      const std::vector<int>& inflatedRectanglesIndices,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      // The canvas image will hold the rectangle.
+      cv::Mat canvas = cv::Mat::zeros(inImage.size(), CV_8UC1);
+
+      // Draw the rectangle that corresponds to it
+      for (int j = 0; j < 4; j++)
+      {
+        cv::line(
+          canvas,
+          inflatedRectanglesVector[i][j],
+          inflatedRectanglesVector[i][(j + 1) % 4],
+          cv::Scalar(255, 255, 255), 1, 8);
+      }
+
+      // The points that constitute the rectangle.
+      // We will test if these points all lie on one plane.
+      float probability = planeConstitution(
+        Region::fromMask(canvas), initialPointCloud);
+
+      if (probability >= 0)
+      {
+        probabilitiesVector->at(inflatedRectanglesIndices[i]) = probability;
+      }
+
+      *msg = TOSTR(probabilitiesVector->at(inflatedRectanglesIndices[i]));
+    }
+  }  // namespace
+
+  /**
+    @brief Checks for valid holes by area / depth comparison
+    @param[in] conveyor [const HolesConveyor&] The candidate holes
+    @param[in] depthImage [const cv::Mat&] The depth image
+    @param[in] holesMasksRegionVector [const std::vector<Region>&]
+    A vector that holds the region of the points inside each hole
+    @param[out] msgs [std::vector<std::string>*] Messages for debug
+    reasons
+    @param[out] probabilitiesVector [std::vector<float>*] A vector
+    of probabilities, each position of which hints to the certainty degree
+    with which the associated candidate hole is associated.
+    While the returned set may be reduced in size, the size of this vector
+    is the same throughout and equal to the number of keypoints found and
+    published by the rgb node
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
+    @return void
+   **/
+  void DepthFilters::checkHolesDepthArea(
+    const HolesConveyor& conveyor,
+    const cv::Mat& depthImage,
+    const std::vector<Region>& holesMasksRegionVector,
+    std::vector<std::string>* msgs,
+    std::vector<float>* probabilitiesVector,
+    const std::vector<bool>* pending)
+  {
+    PROFILE_SCOPE("checkHolesDepthArea", "applyFilter");
+
+    HoleWorkers::instance().runEntries(conveyor.size(), NULL, pending,
+      boost::bind(&depthArea, boost::cref(depthImage),
+        boost::cref(holesMasksRegionVector), probabilitiesVector, _1, _2),
+      msgs);
+  }
+
+
+
+  /**
+    @brief Checks for valid holes just by the depth difference between
+    the keypoint of the blob and the edges of its bounding box
+    @param[in] depthImage [const cv::Mat&] The depth image
+    @param[in] conveyor [const HolesConveyor&] The candidate holes
+    @param[in] inflatedRectanglesVector
+    [const std::vector<std::vector<cv::Point2f> >&] A vector that holds
+    the vertices of the inflated rectangle that corresponds to a specific
+    hole inside the coveyor
+    @param[in] inflatedRectanglesIndices [const std::vector<int>&]
+    A vector that is used to identify a hole's corresponding inflated
+    rectangle.
+    Used because the rectangles used are inflated rectangles;
+    not all holes possess an inflated rectangle
+    @param[out] msgs [std::vector<std::string>*] Messages for debug reasons
+    @param[out] probabilitiesVector [std::vector<float>*] A vector
+    of probabilities, each position of which hints to the certainty degree
+    with which the associated candidate hole is associated.
+    While the returned set may be reduced in size, the size of this vector
+    is the same throughout and equal to the number of keypoints found and
+    published by the depth and rgb nodes
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
+    @return void
+   **/
+  void DepthFilters::checkHolesDepthDiff(
+    const cv::Mat& depthImage,
+    const HolesConveyor& conveyor,
+    const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
+    const std::vector<int>& inflatedRectanglesIndices,
+    std::vector<std::string>* msgs,
+    std::vector<float>* probabilitiesVector,
+    const std::vector<bool>* pending)
+  {
+    PROFILE_SCOPE("checkHolesDepthDiff", "applyFilter");
+
+    HoleWorkers::instance().runEntries(inflatedRectanglesIndices.size(),
+      &inflatedRectanglesIndices, pending, boost::bind(&depthDiff,
+        boost::cref(depthImage), boost::cref(conveyor),
+        boost::cref(inflatedRectanglesVector),
+        boost::cref(inflatedRectanglesIndices), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 
@@ -222,13 +506,12 @@ namespace hole_fusion
   /**
     @brief Checks the homogeneity of the gradient of an interpolated
     depth image in areas denoted by the points inside the
-    holesMasksSetVector vector
+    holesMasksRegionVector vector
     @param[in] conveyor [const HolesConveyor&] The candidate holes
     @param[in] interpolatedDepthImage [const cv::Mat&] The input
     interpolated depth image
-    @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-    A vector that holds sets of points; each point is internal to its
-    respective hole
+    @param[in] holesMasksRegionVector [const std::vector<Region>&]
+    A vector that holds the region of the points inside each hole
     @param[out] msgs [std::vector<std::string>*] Debug messages
     @param[out] probabilitiesVector [std::vector<float>*] A vector
     of probabilities, each position of which hints to the certainty degree
@@ -236,18 +519,19 @@ namespace hole_fusion
     While the returned set may be reduced in size, the size of this vector
     is the same throughout and equal to the number of keypoints found and
     published by the rgb node
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void DepthFilters::checkHolesDepthHomogeneity(
     const HolesConveyor& conveyor,
     const cv::Mat& interpolatedDepthImage,
-    const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+    const std::vector<Region>& holesMasksRegionVector,
     std::vector<std::string>* msgs,
-    std::vector<float>* probabilitiesVector)
+    std::vector<float>* probabilitiesVector,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesDepthHomogeneity", "applyFilter");
-    #endif
+    PROFILE_SCOPE("checkHolesDepthHomogeneity", "applyFilter");
 
     // Facilitate the edge detection by converting the 32FC1 image
     // values to a range of 0-255
@@ -264,36 +548,10 @@ namespace hole_fusion
     cv::threshold(interpolatedDepthImageEdges, interpolatedDepthImageEdges,
       Parameters::Edge::denoised_edges_threshold, 255, 0);
 
-    // Take a pointer on the interpolatedDepthImageEdges image
-    unsigned char* ptr = interpolatedDepthImageEdges.ptr();
-
-    for (unsigned int i = 0; i < conveyor.size(); i++)
-    {
-      // The number of non-zero value pixels in the
-      // interpolatedDepthImageEdges image, inside mask i
-      int numWhites = 0;
-
-      for (std::set<unsigned int>::iterator it = holesMasksSetVector[i].begin();
-        it != holesMasksSetVector[i].end(); it++)
-      {
-        if (ptr[*it] != 0)
-        {
-          numWhites++;
-        }
-      }
-
-      if (holesMasksSetVector[i].size() > 0)
-      {
-        probabilitiesVector->at(i) =
-          static_cast<float>(numWhites) / (holesMasksSetVector[i].size());
-      }
-
-      msgs->push_back(TOSTR(probabilitiesVector->at(i)));
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesDepthHomogeneity");
-    #endif
+    HoleWorkers::instance().runEntries(conveyor.size(), NULL, pending,
+      boost::bind(&depthHomogeneity, boost::cref(interpolatedDepthImageEdges),
+        boost::cref(holesMasksRegionVector), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 
@@ -305,11 +563,11 @@ namespace hole_fusion
     considered valid, the @param probabilitiesVector hint to the
     validity of the candidate hole through this filter
     @param[in] inImage [const cv::Mat&] The input depth image
-    @param[in] initialPointCloud [const PointCloudPtr&]
+    @param[in] initialPointCloud [const PointCloudConstPtr&]
     The point cloud acquired from the depth sensor, interpolated
-    @param[in] intermediatePointsSetVector
-    [const std::vector<std::set<unsigned int> >& ] A vector that holds for
-    each hole a set of points;
+    @param[in] intermediatePointsRegionVector
+    [const std::vector<Region>& ] A vector that holds for
+    each hole a region of points;
     these points are the points between the hole's outline and its
     bounding rectangle
     @param[in] inflatedRectanglesIndices [const std::vector<int>&] Because
@@ -325,93 +583,31 @@ namespace hole_fusion
     published by the rgb node
     @param[out] msgs [std::vector<std::string>*] Messages for
     debug reasons
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void DepthFilters::checkHolesOutlineToRectanglePlaneConstitution(
     const cv::Mat& inImage,
-    const PointCloudPtr& initialPointCloud,
-    const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+    const PointCloudConstPtr& initialPointCloud,
+    const std::vector<Region>& intermediatePointsRegionVector,
     const std::vector<int>& inflatedRectanglesIndices,
     std::vector<float>* probabilitiesVector,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesOutlineToRectanglePlaneConstitution",
+    PROFILE_SCOPE("checkHolesOutlineToRectanglePlaneConstitution",
       "applyFilter");
-    #endif
 
-    for (unsigned int i = 0; i < inflatedRectanglesIndices.size(); i++)
-    {
-      if (intermediatePointsSetVector[i].size() > 0)
-      {
-        // From each set of intermediate points, construct the point cloud
-        // that will be checked for plane constitution
-        PointCloudXYZPtr intermediatePointsPointCloud (new PointCloudXYZ);
-
-        intermediatePointsPointCloud->width =
-          intermediatePointsSetVector[i].size();
-
-        intermediatePointsPointCloud->height = 1;
-
-        intermediatePointsPointCloud->points.resize
-          (intermediatePointsPointCloud->width
-           * intermediatePointsPointCloud->height);
-
-        intermediatePointsPointCloud->header.frame_id =
-          initialPointCloud->header.frame_id;
-        intermediatePointsPointCloud->header.stamp =
-          initialPointCloud->header.stamp;
-
-        int pointCloudPointsIndex = 0;
-        for (std::set<unsigned int>::iterator
-          it = intermediatePointsSetVector[i].begin();
-          it != intermediatePointsSetVector[i].end(); it++)
-        {
-          intermediatePointsPointCloud->points[pointCloudPointsIndex].x =
-            initialPointCloud->points[*intermediatePointsSetVector[i].find(*it)].x;
-
-          intermediatePointsPointCloud->points[pointCloudPointsIndex].y =
-            initialPointCloud->points[*intermediatePointsSetVector[i].find(*it)].y;
-
-          intermediatePointsPointCloud->points[pointCloudPointsIndex].z =
-            initialPointCloud->points[*intermediatePointsSetVector[i].find(*it)].z;
-
-          pointCloudPointsIndex++;
-        }
-
-        // Check if the intermediatePointsPointCloud's points are on a plane
-        std::vector<pcl::PointIndices::Ptr> inliersVector;
-        int numPlanes = PlanesDetection::locatePlanes(
-          intermediatePointsPointCloud, false, &inliersVector);
-
-        // The probability (in all probability) of the current hole lying on
-        // one plane will be the ratio of the number of intermediate points
-        // that lie on one plane over all the intermediate points
-        // (max points on one plane) / (all intermediate points)
-        int maxPoints = 0;
-        for (unsigned int iv = 0; iv < inliersVector.size(); iv++)
-        {
-          if (inliersVector[iv]->indices.size() > maxPoints)
-          {
-            maxPoints = inliersVector[iv]->indices.size();
-          }
-        }
-
-        if (intermediatePointsSetVector[i].size() > 0)
-        {
-          probabilitiesVector->at(inflatedRectanglesIndices[i]) =
-            static_cast<float> (maxPoints) /
-            intermediatePointsSetVector[i].size();
-        }
-
-        msgs->push_back(TOSTR(
-            probabilitiesVector->at(inflatedRectanglesIndices[i])));
-      }
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesOutlineToRectanglePlaneConstitution");
-    #endif
+    // Holes are shared among the workers, since each one may fit its own
+    // planes
+    HoleWorkers::instance().runEntries(inflatedRectanglesIndices.size(),
+      &inflatedRectanglesIndices, pending,
+      boost::bind(&outlineToRectanglePlaneConstitution,
+        boost::cref(initialPointCloud),
+        boost::cref(intermediatePointsRegionVector),
+        boost::cref(inflatedRectanglesIndices), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 
@@ -422,7 +618,7 @@ namespace hole_fusion
     planes are considered valid, the @param probabilitiesVector hint
     to the validity of the candidate hole through this filter
     @param[in] inImage [const cv::Mat&] The input depth image
-    @param[in] initialPointCloud [const PointCloudPtr&]
+    @param[in] initialPointCloud [const PointCloudConstPtr&]
     The point cloud acquired from the depth sensor, interpolated
     @param[in] inflatedRectanglesVector
     [const std::vector<std::vector<cv::Point2f> >&] A vector that holds
@@ -441,111 +637,30 @@ namespace hole_fusion
     published by the rgb node
     @param[out] msgs [std::vector<std::string>*] Messages for
     debug reasons
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void DepthFilters::checkHolesRectangleEdgesPlaneConstitution(
     const cv::Mat& inImage,
-    const PointCloudPtr& initialPointCloud,
+    const PointCloudConstPtr& initialPointCloud,
     const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
     const std::vector<int>& inflatedRectanglesIndices,
     std::vector<float>* probabilitiesVector,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesRectangleEdgesPlaneConstitution", "applyFilter");
-    #endif
-
+    PROFILE_SCOPE("checkHolesRectangleEdgesPlaneConstitution", "applyFilter");
 
-    // For each inflated rectangle, store in visitedPoints
-    // the points that constitute the rectangle.
-    // We will test if these points all lie on one plane.
-    for (unsigned int i = 0; i < inflatedRectanglesVector.size(); i++)
-    {
-      // The canvas image will hold the rectangles.
-      cv::Mat canvas = cv::Mat::zeros(inImage.size(), CV_8UC1);
-
-      // Draw the rectangle that corresponds to it
-      for (int j = 0; j < 4; j++)
-      {
-        cv::line(
-          canvas,
-          inflatedRectanglesVector[i][j],
-          inflatedRectanglesVector[i][(j + 1) % 4],
-          cv::Scalar(255, 255, 255), 1, 8);
-      }
-
-      std::set<unsigned int> visitedPoints;
-      for (unsigned int rows = 0; rows < inImage.rows; rows++)
-      {
-        for (unsigned int cols = 0; cols < inImage.cols; cols++)
-        {
-          if (canvas.data[rows * inImage.cols + cols] != 0)
-          {
-            visitedPoints.insert(rows * inImage.cols + cols);
-          }
-        }
-      }
-
-      // From each set of points lying on the edges of the rectangle,
-      // construct the point cloud that will be checked for plane constitution
-      PointCloudXYZPtr edgePointsPointCloud (new PointCloudXYZ);
-
-      edgePointsPointCloud->width = visitedPoints.size();
-      edgePointsPointCloud->height = 1;
-      edgePointsPointCloud->points.resize
-        (edgePointsPointCloud->width * edgePointsPointCloud->height);
-
-      edgePointsPointCloud->header.frame_id =
-        initialPointCloud->header.frame_id;
-      edgePointsPointCloud->header.stamp =
-        initialPointCloud->header.stamp;
-
-      int pointCloudPointsIndex = 0;
-      for (std::set<unsigned int>::iterator it = visitedPoints.begin();
-        it != visitedPoints.end(); it++)
-      {
-        edgePointsPointCloud->points[pointCloudPointsIndex].x =
-          initialPointCloud->points[*visitedPoints.find(*it)].x;
-
-        edgePointsPointCloud->points[pointCloudPointsIndex].y =
-          initialPointCloud->points[*visitedPoints.find(*it)].y;
-
-        edgePointsPointCloud->points[pointCloudPointsIndex].z =
-          initialPointCloud->points[*visitedPoints.find(*it)].z;
-
-        pointCloudPointsIndex++;
-      }
-
-      // Check if the edgePointsPointCloud points are on a plane
-      std::vector<pcl::PointIndices::Ptr> inliersVector;
-      int numPlanes = PlanesDetection::locatePlanes(edgePointsPointCloud,
-        false, &inliersVector);
-
-      // The probability (in all probability) of an inflated rectangle
-      // residing on one plane will be the ratio of
-      // (max points on one plane) / (all inflated rectangle points)
-      int maxPoints = 0;
-      for (unsigned int iv = 0; iv < inliersVector.size(); iv++)
-      {
-        if (inliersVector[iv]->indices.size() > maxPoints)
-        {
-          maxPoints = inliersVector[iv]->indices.size();
-        }
-      }
-
-      if (visitedPoints.size() > 0)
-      {
-        probabilitiesVector->at(inflatedRectanglesIndices[i]) =
-          static_cast<float> (maxPoints) / visitedPoints.size();
-      }
-
-      msgs->push_back(TOSTR(
-          probabilitiesVector->at(inflatedRectanglesIndices[i])));
-    }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesRectangleEdgesPlaneConstitution");
-    #endif
+    // Holes are shared among the workers, since each one may fit its own
+    // planes
+    HoleWorkers::instance().runEntries(inflatedRectanglesVector.size(),
+      &inflatedRectanglesIndices, pending,
+      boost::bind(&rectangleEdgesPlaneConstitution, boost::cref(inImage),
+        boost::cref(initialPointCloud), boost::cref(inflatedRectanglesVector),
+        boost::cref(inflatedRectanglesIndices), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 }  // namespace hole_fusion
@@ -43,6 +43,11 @@ namespace pandora_vision_hole
 {
 namespace hole_fusion
 {
+  Filters::FilterStatistics
+    Filters::statistics_[Filters::NUMBER_OF_FILTERS + 1];
+
+
+
   /**
     @brief Applies a specific active filter, either from an RGB
     or a Depth sources.
@@ -56,10 +61,10 @@ namespace hole_fusion
     The rgb image
     @param[in] inHistogram [const std::vector<cv::MatND>&]
     The vector of model histograms
-    @param[in] pointCloud [const PointCloudPtr&]
+    @param[in] pointCloud [const PointCloudConstPtr&]
     The original point cloud that corresponds to the input depth image
-    @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-    A vector that holds sets of points's indices;
+    @param[in] holesMasksRegionVector [const std::vector<Region>&]
+    A vector that holds a region of points for each hole;
     each point is internal to its respective hole
     @param[in] holesMasksImageVector [const std::vector<cv::Mat>&]
     A vector containing masks of the points inside each hole's outline
@@ -71,9 +76,9 @@ namespace hole_fusion
     A vector that is used to identify a hole's corresponding rectangle.
     Used primarily because the rectangles used are inflated rectangles;
     not all holes possess an inflated rectangle
-    @param[in] intermediatePointsSetVector
-    [const std::vector<std::set<unsigned int> >& ] A vector that holds for
-    each hole a set of points' indices; these points are the points
+    @param[in] intermediatePointsRegionVector
+    [const std::vector<Region>& ] A vector that holds for
+    each hole a region of points; these points are the points
     between the hole's outline and its bounding rectangle
     @param[in] intermediatePointsImageVector [const std::vector<cv::Mat>&]
     A vector containing masks of the points outside each hole's outline,
@@ -89,6 +94,8 @@ namespace hole_fusion
     valid by each filter
     @param[out] msgs [std::vector<std::string>*]
     Debug messages
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void Filters::applyFilter(
@@ -97,20 +104,19 @@ namespace hole_fusion
     const cv::Mat& depthImage,
     const cv::Mat& rgbImage,
     const std::vector<cv::MatND>& inHistogram,
-    const PointCloudPtr& pointCloud,
-    const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+    const PointCloudConstPtr& pointCloud,
+    const std::vector<Region>& holesMasksRegionVector,
     const std::vector<cv::Mat>& holesMasksImageVector,
     const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
     const std::vector<int>& inflatedRectanglesIndices,
-    const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+    const std::vector<Region>& intermediatePointsRegionVector,
     const std::vector<cv::Mat>& intermediatePointsImageVector,
     std::vector<float>* probabilitiesVector,
     std::vector<cv::Mat>* imgs,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("applyFilter", "applyFilters");
-    #endif
+    PROFILE_SCOPE("applyFilter", "applyFilters");
 
     std::string windowMsg;
     std::vector<std::string> finalMsgs;
@@ -129,7 +135,8 @@ namespace hole_fusion
             rgbImage,
             holesMasksImageVector,
             probabilitiesVector,
-            &msgs_);
+            &msgs_,
+            pending);
 
           windowMsg = "Filter: Color homogeneity";
           break;
@@ -141,11 +148,12 @@ namespace hole_fusion
         {
           RgbFilters::checkHolesLuminosityDiff(
             rgbImage,
-            holesMasksSetVector,
-            intermediatePointsSetVector,
+            holesMasksRegionVector,
+            intermediatePointsRegionVector,
             inflatedRectanglesIndices,
             probabilitiesVector,
-            &msgs_);
+            &msgs_,
+            pending);
 
           windowMsg = "Filter: Luminosity difference";
           break;
@@ -160,7 +168,8 @@ namespace hole_fusion
             intermediatePointsImageVector,
             inflatedRectanglesIndices,
             probabilitiesVector,
-            &msgs_);
+            &msgs_,
+            pending);
 
           windowMsg = "Filter: Texture difference";
           break;
@@ -171,11 +180,12 @@ namespace hole_fusion
           RgbFilters::checkHolesTextureBackProject(
             rgbImage,
             inHistogram,
-            holesMasksSetVector,
-            intermediatePointsSetVector,
+            holesMasksRegionVector,
+            intermediatePointsRegionVector,
             inflatedRectanglesIndices,
             probabilitiesVector,
-            &msgs_);
+            &msgs_,
+            pending);
 
           windowMsg = "Filter: Texture back project";
           break;
@@ -189,7 +199,8 @@ namespace hole_fusion
             inflatedRectanglesVector,
             inflatedRectanglesIndices,
             &msgs_,
-            probabilitiesVector);
+            probabilitiesVector,
+            pending);
 
           windowMsg = "Filter: Depth difference";
           break;
@@ -206,7 +217,8 @@ namespace hole_fusion
             inflatedRectanglesVector,
             inflatedRectanglesIndices,
             probabilitiesVector,
-            &msgs_);
+            &msgs_,
+            pending);
 
           windowMsg = "Filter: Outline of rectangle on plane";
           break;
@@ -217,9 +229,10 @@ namespace hole_fusion
           DepthFilters::checkHolesDepthArea(
             conveyor,
             depthImage,
-            holesMasksSetVector,
+            holesMasksRegionVector,
             &msgs_,
-            probabilitiesVector);
+            probabilitiesVector,
+            pending);
 
           windowMsg = "Filter: Area / Depth";
           break;
@@ -234,10 +247,11 @@ namespace hole_fusion
           DepthFilters::checkHolesOutlineToRectanglePlaneConstitution(
             depthImage,
             pointCloud,
-            intermediatePointsSetVector,
+            intermediatePointsRegionVector,
             inflatedRectanglesIndices,
             probabilitiesVector,
-            &msgs_);
+            &msgs_,
+            pending);
 
           windowMsg = "Filter: Points around blob to plane";
           break;
@@ -250,9 +264,10 @@ namespace hole_fusion
           DepthFilters::checkHolesDepthHomogeneity(
             conveyor,
             depthImage,
-            holesMasksSetVector,
+            holesMasksRegionVector,
             &msgs_,
-            probabilitiesVector);
+            probabilitiesVector,
+            pending);
 
           windowMsg = "Filter: Depth homogeneity";
           break;
@@ -300,10 +315,6 @@ namespace hole_fusion
       }
     }
     #endif
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyFilter");
-    #endif
   }
 
 
@@ -311,7 +322,10 @@ namespace hole_fusion
   /**
     @brief Applies all active filters, from both RGB and Depth sources.
     The order of execution is derived from the dynamic reconfigure
-    facility.
+    facility. Unless disabled through the short_circuit_filters
+    parameter, once a candidate hole cannot be found valid by
+    HoleValidation::validateHoles, no more filters are applied to it;
+    its remaining probabilities stay as they were.
     @param[in] conveyor [const HolesConveyor&]
     The conveyor of candidateholes
     @param[in] filteringMode [const int&]
@@ -326,10 +340,10 @@ namespace hole_fusion
     The rgb image
     @param[in] inHistogram [const std::vector<cv::MatND>&]
     The vector of model histograms
-    @param[in] pointCloud [const PointCloudPtr&]
+    @param[in] pointCloud [const PointCloudConstPtr&]
     The original point cloud that corresponds to the input depth image
-    @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-    A vector that holds sets of points's indices;
+    @param[in] holesMasksRegionVector [const std::vector<Region>&]
+    A vector that holds a region of points for each hole;
     each point is internal to its respective hole
     @param[in] holesMasksImageVector [const std::vector<cv::Mat>&]
     A vector containing masks of the points inside each hole's outline
@@ -341,9 +355,9 @@ namespace hole_fusion
     A vector that is used to identify a hole's corresponding rectangle.
     Used primarily because the rectangles used are inflated rectangles;
     not all holes possess an inflated rectangle
-    @param[in] intermediatePointsSetVector
-    [const std::vector<std::set<unsigned int> >& ] A vector that holds for
-    each hole a set of points' indices; these points are the points
+    @param[in] intermediatePointsRegionVector
+    [const std::vector<Region>& ] A vector that holds for
+    each hole a region of points; these points are the points
     between the hole's outline and its bounding rectangle
     @param[in] intermediatePointsImageVector [const std::vector<cv::Mat>&]
     A vector containing masks of the points outside each hole's outline,
@@ -362,18 +376,16 @@ namespace hole_fusion
     const cv::Mat& depthImage,
     const cv::Mat& rgbImage,
     const std::vector<cv::MatND>& inHistogram,
-    const PointCloudPtr& pointCloud,
-    const std::vector<std::set<unsigned int> >& holesMasksSetVector,
+    const PointCloudConstPtr& pointCloud,
+    const std::vector<Region>& holesMasksRegionVector,
     const std::vector<cv::Mat>& holesMasksImageVector,
     const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
     const std::vector<int>& inflatedRectanglesIndices,
-    const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+    const std::vector<Region>& intermediatePointsRegionVector,
     const std::vector<cv::Mat>& intermediatePointsImageVector,
     std::vector<std::vector<float> >* probabilitiesVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("applyFilters", "filterHoles");
-    #endif
+    PROFILE_SCOPE("applyFilters", "filterHoles");
 
     // A mapping of the filters' execution order to an identifier for each
     // filter
@@ -476,30 +488,77 @@ namespace hole_fusion
     std::vector<cv::Mat> imgs;
     std::vector<std::string> msgs;
 
-    // Apply each active filter, depending on the interpolation method
-    int counter = 0;
+    // The identifiers of the active filters, in order of execution.
+    // validateHoles looks up the probabilities of a filter by its priority,
+    // so the rows of probabilitiesVector are those of the filters only if
+    // the priorities are 1, 2, ... up to the number of active filters
+    std::vector<int> filters;
+    bool consecutivePriorities = true;
     for (std::map<int, int>::iterator o_it = filtersOrder.begin();
       o_it != filtersOrder.end(); ++o_it)
     {
+      consecutivePriorities = consecutivePriorities &&
+        o_it->first == static_cast<int>(filters.size()) + 1;
+
+      filters.push_back(o_it->second);
+    }
+
+    bool shortCircuit = consecutivePriorities &&
+      Parameters::HoleFusion::Validation::short_circuit_filters;
+
+    // The holes that may still be found valid, and thus need to be
+    // evaluated by the filters that follow
+    std::vector<bool> pending(conveyor.size(), true);
+    int numPending = conveyor.size();
+
+    // Apply each active filter, depending on the interpolation method
+    for (int f = 0; f < filters.size(); f++)
+    {
+      ros::WallTime begin = ros::WallTime::now();
+
       applyFilter(
         conveyor,
-        o_it->second,
+        filters[f],
         depthImage,
         rgbImage,
         inHistogram,
         pointCloud,
-        holesMasksSetVector,
+        holesMasksRegionVector,
         holesMasksImageVector,
         inflatedRectanglesVector,
         inflatedRectanglesIndices,
-        intermediatePointsSetVector,
+        intermediatePointsRegionVector,
         intermediatePointsImageVector,
-        &probabilitiesVector->at(counter),
+        &probabilitiesVector->at(f),
         &imgs,
-        &msgs);
+        &msgs,
+        &pending);
+
+      FilterStatistics& statistics = statistics_[filters[f]];
+      statistics.frames++;
+      statistics.milliseconds +=
+        (ros::WallTime::now() - begin).toSec() * 1000;
+      statistics.evaluated += numPending;
+
+      if (!shortCircuit)
+      {
+        continue;
+      }
+
+      for (unsigned int i = 0; i < conveyor.size(); i++)
+      {
+        if (pending[i] && HoleValidation::isRejected(
+            *probabilitiesVector, filters, f + 1, i, filteringMode))
+        {
+          pending[i] = false;
+          numPending--;
+          statistics.rejected++;
+        }
+      }
+    }
 
-      counter++;
-    }  // o_it iterator ends
+    ROS_DEBUG_STREAM_THROTTLE_NAMED(10, PKG_NAME,
+      "[Hole Fusion node] Filters: " << describeStatistics());
 
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_check_holes)  // Debug
@@ -508,10 +567,63 @@ namespace hole_fusion
         Parameters::Debug::show_check_holes_size, 1);
     }
     #endif
+  }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("applyFilters");
-    #endif
+
+
+
+  /**
+    @brief The running totals of a filter
+    @param[in] filter [const int&] The identifier of the filter, as in
+    applyFilter
+    @return [const FilterStatistics&] The totals
+   **/
+  const Filters::FilterStatistics& Filters::getStatistics(const int& filter)
+  {
+    return statistics_[filter];
+  }
+
+
+
+  /**
+    @brief Zeroes the running totals of all filters
+    @return void
+   **/
+  void Filters::resetStatistics()
+  {
+    for (int f = 0; f <= NUMBER_OF_FILTERS; f++)
+    {
+      statistics_[f] = FilterStatistics();
+    }
+  }
+
+
+
+  /**
+    @brief A one line summary of the running totals of all filters
+    applied so far, for logging
+    @return [std::string] The summary
+   **/
+  std::string Filters::describeStatistics()
+  {
+    std::ostringstream summary;
+
+    for (int f = 1; f <= NUMBER_OF_FILTERS; f++)
+    {
+      const FilterStatistics& statistics = statistics_[f];
+
+      if (statistics.frames == 0)
+      {
+        continue;
+      }
+
+      summary << "#" << f << ": "
+        << statistics.milliseconds / statistics.frames << " ms/frame, "
+        << statistics.rejected << "/" << statistics.evaluated
+        << " holes rejected; ";
+    }
+
+    return summary.str();
   }
 
 }  // namespace hole_fusion
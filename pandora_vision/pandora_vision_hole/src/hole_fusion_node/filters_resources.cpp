@@ -36,6 +36,7 @@
  *********************************************************************/
 
 #include "hole_fusion_node/filters_resources.h"
+#include <algorithm>
 
 /**
   @namespace pandora_vision
@@ -47,6 +48,140 @@ namespace pandora_vision_hole
 {
 namespace hole_fusion
 {
+  namespace
+  {
+    /**
+      @brief Finds the points inside a hole's outline, by flood filling
+      it from the hole's keypoint
+      @param[in] hole [const HoleConveyor&] The hole
+      @param[in] size [const cv::Size&] The size of the image
+      @return [Region] The points inside the hole's outline
+     **/
+    Region fillOutline(const HoleConveyor& hole, const cv::Size& size)
+    {
+      // The image on which the hole's outline will be drawn
+      cv::Mat holeMask = cv::Mat::zeros(size, CV_8UC1);
+
+      // Draw the outline points of the hole onto holeMask
+      for (unsigned int j = 0; j < hole.outline.size(); j++)
+      {
+        holeMask.at<unsigned char>(hole.outline[j].y, hole.outline[j].x) = 255;
+      }
+
+      // The point from which the floodfill will begin
+      cv::Point2f seedPoint(hole.keypoint.pt.x, hole.keypoint.pt.y);
+
+      // Fill the inside of the hole
+      cv::floodFill(holeMask, seedPoint, cv::Scalar(255));
+
+      // The points with non-zero value are the ones inside the hole
+      return Region::fromMask(holeMask);
+    }
+
+
+
+    /**
+      @brief Inflates a hole's bounding rectangle
+      @param[in] hole [const HoleConveyor&] The hole
+      @param[in] size [const cv::Size&] The size of the image
+      @param[in] inflationSize [int] The inflation size in pixels
+      @param[out] inflatedVertices [std::vector<cv::Point2f>*] The vertices
+      of the inflated rectangle. Left empty if it is not within the image's
+      bounds
+      @return [bool] True if the inflated rectangle is within the image's
+      bounds
+     **/
+    bool inflateRectangle(const HoleConveyor& hole, const cv::Size& size,
+      int inflationSize, std::vector<cv::Point2f>* inflatedVertices)
+    {
+      int inflatedVerticesWithinImageLimits = 0;
+
+      float key_y = hole.keypoint.pt.y;
+      float key_x = hole.keypoint.pt.x;
+
+      for (int j = 0; j < 4; j++)
+      {
+        float vert_y = hole.rectangle[j].y;
+        float vert_x = hole.rectangle[j].x;
+
+        double theta = atan2(key_y - vert_y, key_x - vert_x);
+
+        // check if the inflated vertex has gone out of bounds
+        if (vert_x - inflationSize * cos(theta) < size.width &&
+          vert_x - inflationSize * cos(theta) >= 0 &&
+          vert_y - inflationSize * sin(theta) < size.height &&
+          vert_y - inflationSize * sin(theta) >= 0)
+        {
+          inflatedVerticesWithinImageLimits++;
+        }
+
+        inflatedVertices->push_back(
+          cv::Point2f(round(vert_x - inflationSize * cos(theta)),
+            round(vert_y - inflationSize * sin(theta))));
+      }  // end for rectangle's points
+
+      // If one or more vertices are out of bounds discard the whole
+      // inflated rectangle
+      if (inflatedVerticesWithinImageLimits < 4)
+      {
+        inflatedVertices->clear();
+        return false;
+      }
+
+      return true;
+    }
+
+
+
+    /**
+      @brief Finds the points inside a rectangle but outside a hole's
+      outline
+      @param[in] hole [const HoleConveyor&] The hole
+      @param[in] size [const cv::Size&] The size of the image
+      @param[in] rectangle [const std::vector<cv::Point2f>&] The vertices
+      of the (inflated) bounding rectangle of the hole
+      @param[in] holeOutlineFilledRegion [const Region&] The points inside
+      the hole's outline
+      @return [Region] The intermediate points
+     **/
+    Region findIntermediatePoints(const HoleConveyor& hole,
+      const cv::Size& size, const std::vector<cv::Point2f>& rectangle,
+      const Region& holeOutlineFilledRegion)
+    {
+      // An image whose non-zero value pixels are the ones inside the
+      // hole's bounding rectangle
+      cv::Mat rectangleOutlineFilledImage = cv::Mat::zeros(size, CV_8UC1);
+
+      // Draw the bounding rectangle of the hole onto
+      // rectangleOutlineFilledImage
+      for (unsigned int j = 0; j < rectangle.size(); j++)
+      {
+        cv::line(rectangleOutlineFilledImage,
+          rectangle[j],
+          rectangle[(j + 1) % rectangle.size()],
+          cv::Scalar(255, 0, 0), 1, 8);
+      }
+
+      // The brushfire start point is the hole's seedPoint
+      cv::Point2f seedPoint(hole.keypoint.pt.x, hole.keypoint.pt.y);
+
+      // floodFill from the seedPoint to the hole's bounding rectangle
+      // to obtain the points inside it
+      cv::floodFill(rectangleOutlineFilledImage, seedPoint, cv::Scalar(255));
+
+      // The points inside the hole's bounding rectangle but outside
+      // its outline
+      return Region::fromMask(rectangleOutlineFilledImage).subtract(
+        holeOutlineFilledRegion);
+    }
+  }  // namespace
+
+
+
+  ResourcesCache FiltersResources::cache_(0);
+
+
+
   /**
     @brief Each Depth and RGB filter requires the construction of a set
     of vectors which uses to determine the validity of each hole.
@@ -67,9 +202,9 @@ namespace hole_fusion
     needed to be constructed.
     @param[out] holesMasksImageVector [std::vector<cv::Mat>*]
     A vector containing an image (the mask) for each hole
-    @param[out] holesMasksSetVector [std::vector<std::set<unsigned int> >*]
-    A vector that holds sets of points's indices; each set holds the
-    indices of the points inside the outline of each hole
+    @param[out] holesMasksRegionVector [std::vector<Region>*]
+    A vector that holds a region for each hole; each region holds the
+    points inside the outline of each hole
     @param[out] inflatedRectanglesVector
     [std::vector<std::vector<cv::Point2f> >*] The vector that holds the
     vertices of the in-image-bounds inflated rectangles
@@ -80,7 +215,7 @@ namespace hole_fusion
     A vector that holds the image of the intermediate points between
     a hole's outline and its bounding box, for each hole whose identifier
     exists in the @param inflatedRectanglesIndices vector
-    @param[out] intermediatePointsSetVector [std::vector<std::set<int> >*]
+    @param[out] intermediatePointsRegionVector [std::vector<Region>*]
     A vector that holds the intermediate points' between a hole's outline
     and its bounding box, for each hole whose identifier
     exists in the @param inflatedRectanglesIndices vector
@@ -92,22 +227,20 @@ namespace hole_fusion
     const int& inflationSize,
     const int& filteringMode,
     std::vector<cv::Mat>* holesMasksImageVector,
-    std::vector<std::set<unsigned int> >* holesMasksSetVector,
+    std::vector<Region>* holesMasksRegionVector,
     std::vector<std::vector<cv::Point2f> >* inflatedRectanglesVector,
     std::vector<int>* inflatedRectanglesIndices,
     std::vector<cv::Mat>* intermediatePointsImageVector,
-    std::vector<std::set<unsigned int> >* intermediatePointsSetVector)
+    std::vector<Region>* intermediatePointsRegionVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createCheckerRequiredVectors", "filterHoles");
-    #endif
+    PROFILE_SCOPE("createCheckerRequiredVectors", "filterHoles");
 
     // Indicate the necessity of creating particular resources
     bool enable_holesMasksImageVector = false;
-    bool enable_holesMasksSetVector = false;
+    bool enable_holesMasksRegionVector = false;
     bool enable_inflatedRectanglesVectorAndIndices = false;
     bool enable_intermediatePointsImageVector = false;
-    bool enable_intermediatePointsSetVector = false;
+    bool enable_intermediatePointsRegionVector = false;
 
     // If the conditions permit for the depth filters to be applied,
     // create their resources
@@ -124,7 +257,7 @@ namespace hole_fusion
       // hold the indices of points inside holes' outlines
       if (Parameters::Filters::DepthArea::priority > 0)
       {
-        enable_holesMasksSetVector = true;
+        enable_holesMasksRegionVector = true;
       }
 
       // The intermediate points plane constitution filter requires exactly
@@ -133,7 +266,7 @@ namespace hole_fusion
       // their respective (inflated) bounding rectangle
       if (Parameters::Filters::IntermediatePointsPlaneConstitution::priority > 0)
       {
-        enable_intermediatePointsSetVector = true;
+        enable_intermediatePointsRegionVector = true;
         enable_inflatedRectanglesVectorAndIndices = true;
       }
 
@@ -148,7 +281,7 @@ namespace hole_fusion
       // points' indices; these points are the ones inside holes' outlines
       if (Parameters::Filters::DepthHomogeneity::priority > 0)
       {
-        enable_holesMasksSetVector = true;
+        enable_holesMasksRegionVector = true;
       }
 
       // The color homogeneity filter requires a vector of holes' masks
@@ -166,8 +299,8 @@ namespace hole_fusion
       // valid keypoints
       if (Parameters::Filters::LuminosityDiff::rgbd_priority > 0)
       {
-        enable_holesMasksSetVector = true;
-        enable_intermediatePointsSetVector = true;
+        enable_holesMasksRegionVector = true;
+        enable_intermediatePointsRegionVector = true;
         enable_inflatedRectanglesVectorAndIndices = true;
       }
 
@@ -191,8 +324,8 @@ namespace hole_fusion
       // Hence, we also need the construction of inflated rectangles' vectors
       if (Parameters::Filters::TextureBackprojection::rgbd_priority > 0)
       {
-        enable_holesMasksSetVector = true;
-        enable_intermediatePointsSetVector = true;
+        enable_holesMasksRegionVector = true;
+        enable_intermediatePointsRegionVector = true;
         enable_inflatedRectanglesVectorAndIndices = true;
       }
     }
@@ -216,8 +349,8 @@ namespace hole_fusion
       // valid keypoints
       if (Parameters::Filters::LuminosityDiff::rgb_priority > 0)
       {
-        enable_holesMasksSetVector = true;
-        enable_intermediatePointsSetVector = true;
+        enable_holesMasksRegionVector = true;
+        enable_intermediatePointsRegionVector = true;
         enable_inflatedRectanglesVectorAndIndices = true;
       }
 
@@ -241,8 +374,8 @@ namespace hole_fusion
       // Hence, we also need the construction of inflated rectangles' vectors
       if (Parameters::Filters::TextureBackprojection::rgb_priority > 0)
       {
-        enable_holesMasksSetVector = true;
-        enable_intermediatePointsSetVector = true;
+        enable_holesMasksRegionVector = true;
+        enable_intermediatePointsRegionVector = true;
         enable_inflatedRectanglesVectorAndIndices = true;
       }
     }
@@ -255,21 +388,21 @@ namespace hole_fusion
 
     // The generation of image masks presupposes the generation of set masks
     // within method createHolesMasksImageVector
-    if (enable_holesMasksImageVector && !enable_holesMasksSetVector)
+    if (enable_holesMasksImageVector && !enable_holesMasksRegionVector)
     {
       createHolesMasksImageVector(conveyor, image, holesMasksImageVector);
     }
 
-    if (enable_holesMasksSetVector && !enable_holesMasksImageVector)
+    if (enable_holesMasksRegionVector && !enable_holesMasksImageVector)
     {
-      createHolesMasksSetVector(conveyor, image, holesMasksSetVector);
+      createHolesMasksRegionVector(conveyor, image, holesMasksRegionVector);
     }
 
     // Generate both types of masks
-    if (enable_holesMasksSetVector && enable_holesMasksImageVector)
+    if (enable_holesMasksRegionVector && enable_holesMasksImageVector)
     {
       createHolesMasksVectors(conveyor, image,
-        holesMasksImageVector, holesMasksSetVector);
+        holesMasksImageVector, holesMasksRegionVector);
     }
 
     if (enable_inflatedRectanglesVectorAndIndices)
@@ -284,7 +417,7 @@ namespace hole_fusion
     // The generation of image masks presupposes the generation of set masks
     // within method createIntermediateHolesPointsImageVector
     if (enable_intermediatePointsImageVector &&
-      !enable_intermediatePointsSetVector)
+      !enable_intermediatePointsRegionVector)
     {
       // The intermediate points images vector depends on the
       // inflated rectangles vectors, which has been created previously
@@ -295,19 +428,19 @@ namespace hole_fusion
         intermediatePointsImageVector);
     }
 
-    if (enable_intermediatePointsSetVector &&
+    if (enable_intermediatePointsRegionVector &&
       !enable_intermediatePointsImageVector)
     {
       // The intermediate points set vector depends on the
       // inflated rectangles vectors, which has been created previously
-      createIntermediateHolesPointsSetVector(conveyor,
+      createIntermediateHolesPointsRegionVector(conveyor,
         image,
         *inflatedRectanglesVector,
         *inflatedRectanglesIndices,
-        intermediatePointsSetVector);
+        intermediatePointsRegionVector);
     }
 
-    if (enable_intermediatePointsSetVector &&
+    if (enable_intermediatePointsRegionVector &&
       enable_intermediatePointsImageVector)
     {
       // The intermediate points set vector depends on the
@@ -317,12 +450,13 @@ namespace hole_fusion
         *inflatedRectanglesVector,
         *inflatedRectanglesIndices,
         intermediatePointsImageVector,
-        intermediatePointsSetVector);
+        intermediatePointsRegionVector);
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("createCheckerRequiredVectors");
-    #endif
+    ROS_DEBUG_STREAM_THROTTLE_NAMED(10, PKG_NAME,
+      "[Hole Fusion node] Resources cache: " << cache_.size() << " holes, "
+      << cache_.getStatistics().hitRate() * 100 << "% hits, "
+      << cache_.getStatistics().evictions << " evictions");
   }
 
 
@@ -339,23 +473,21 @@ namespace hole_fusion
     masks' size
     @param[out] holesMasksImageVector [std::vector<cv::Mat>*]
     A vector containing an image (the mask) for each hole
-    @param[out] holesMasksSetVector [std::vector<std::set<unsigned int> >*]
-    A vector that holds sets of points;
-    each set holds the inside points of each hole
+    @param[out] holesMasksRegionVector [std::vector<Region>*]
+    A vector that holds a region of points for each hole;
+    each region holds the inside points of each hole
     @return void
    **/
   void FiltersResources::createHolesMasksVectors(
     const HolesConveyor& conveyor,
     const cv::Mat& image,
     std::vector<cv::Mat>* holesMasksImageVector,
-    std::vector<std::set<unsigned int> >* holesMasksSetVector)
+    std::vector<Region>* holesMasksRegionVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createHolesMasksVectors", "createCheckerRequiredVectors");
-    #endif
+    PROFILE_SCOPE("createHolesMasksVectors", "createCheckerRequiredVectors");
 
     // Create the masks' set initially
-    createHolesMasksSetVector(conveyor, image, holesMasksSetVector);
+    createHolesMasksRegionVector(conveyor, image, holesMasksRegionVector);
 
     // Draw each mask set onto an image
     for (unsigned int i = 0; i < conveyor.size(); i++)
@@ -363,23 +495,11 @@ namespace hole_fusion
       // The current hole's image mask
       cv::Mat holeMask = cv::Mat::zeros(image.size(), CV_8UC1);
 
-      // A pointer to the hole mask image
-      unsigned char* ptr = holeMask.ptr();
-
       // Draw the current hole's mask
-      for (std::set<unsigned int>::iterator it =
-        (*holesMasksSetVector)[i].begin();
-        it != (*holesMasksSetVector)[i].end(); it++)
-      {
-        ptr[*it] = 255;
-      }
+      (*holesMasksRegionVector)[i].toMask(&holeMask);
 
       holesMasksImageVector->push_back(holeMask);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createHolesMasksVectors");
-    #endif
   }
 
 
@@ -401,13 +521,12 @@ namespace hole_fusion
     const cv::Mat& image,
     std::vector<cv::Mat>* holesMasksImageVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createHolesMasksImageVector", "createCheckerRequiredVectors");
-    #endif
+    PROFILE_SCOPE("createHolesMasksImageVector",
+      "createCheckerRequiredVectors");
 
     // Create the masks' set initially
-    std::vector<std::set<unsigned int> > holesMasksSetVector;
-    createHolesMasksSetVector(conveyor, image, &holesMasksSetVector);
+    std::vector<Region> holesMasksRegionVector;
+    createHolesMasksRegionVector(conveyor, image, &holesMasksRegionVector);
 
     // Draw each mask set onto an image
     for (unsigned int i = 0; i < conveyor.size(); i++)
@@ -415,22 +534,11 @@ namespace hole_fusion
       // The current hole's image mask
       cv::Mat holeMaskImage = cv::Mat::zeros(image.size(), CV_8UC1);
 
-      // A pointer to the hole mask image
-      unsigned char* ptr = holeMaskImage .ptr();
-
       // Draw the current hole's mask
-      for (std::set<unsigned int>::iterator it = holesMasksSetVector[i].begin();
-        it != holesMasksSetVector[i].end(); it++)
-      {
-        ptr[*it] = 255;
-      }
+      holesMasksRegionVector[i].toMask(&holeMaskImage);
 
       holesMasksImageVector->push_back(holeMaskImage);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createHolesMasksImageVector");
-    #endif
   }
 
 
@@ -442,65 +550,34 @@ namespace hole_fusion
     @param[in] conveyor [const HolesConveyor&] The conveyor of holes
     @param[in] image [const cv::Mat&] An image required to access
     each hole
-    @param[out] holesMasksSetVector [std::vector<std::set<unsigned int> >*]
-    A vector that holds sets of points;
-    each set holds the inside points of each hole
+    @param[out] holesMasksRegionVector [std::vector<Region>*]
+    A vector that holds a region of points for each hole;
+    each region holds the inside points of each hole
     @return void
    **/
-  void FiltersResources::createHolesMasksSetVector(
+  void FiltersResources::createHolesMasksRegionVector(
     const HolesConveyor& conveyor,
     const cv::Mat& image,
-    std::vector<std::set<unsigned int> >* holesMasksSetVector)
+    std::vector<Region>* holesMasksRegionVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createHolesMasksSetVector", "createCheckerRequiredVectors");
-    #endif
+    PROFILE_SCOPE("createHolesMasksRegionVector",
+      "createCheckerRequiredVectors");
 
     for (int i = 0; i < conveyor.size(); i++)
     {
-      // The image on which the i-th hole's outline will be drawn
-      cv::Mat holeMask = cv::Mat::zeros(image.size(), CV_8UC1);
-
-      // Draw the outline points of the i-th hole onto holeMask
-      for (unsigned int j = 0; j < conveyor.holes[i].outline.size(); j++)
-      {
-        holeMask.at<unsigned char>(
-          conveyor.holes[i].outline[j].y,
-          conveyor.holes[i].outline[j].x) = 255;
-      }
-
-      // The set of indices of points inside the i-th hole's outline
-      std::set<unsigned int> holeMaskSet;
-
-      // The point from which the floodfill will begin
-      cv::Point2f seedPoint(
-        conveyor.holes[i].keypoint.pt.x, conveyor.holes[i].keypoint.pt.y);
+      ResourcesCache::Entry scratch;
+      ResourcesCache::Entry* entry =
+        lookup(conveyor.holes[i], image.size(), &scratch);
 
-      // Fill the inside of the i-th hole
-      cv::floodFill(holeMask, seedPoint, cv::Scalar(255));
-
-      // Take a pointer on the mask image
-      unsigned char* ptr = holeMask.ptr();
-
-      // The points with non-zero value are the ones inside the i-th hole.
-      // Insert them into the desired set.
-      for (int rows = 0; rows < holeMask.rows; rows++)
+      // The points inside the i-th hole, unless it has been seen recently
+      if (!entry->hasMask)
       {
-        for (int cols = 0; cols < holeMask.cols; cols++)
-        {
-          if (ptr[rows * holeMask.cols + cols] != 0)
-          {
-            holeMaskSet.insert(rows * holeMask.cols + cols);
-          }
-        }
+        entry->mask = fillOutline(conveyor.holes[i], image.size());
+        entry->hasMask = true;
       }
 
-      holesMasksSetVector->push_back(holeMaskSet);
+      holesMasksRegionVector->push_back(entry->mask);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createHolesMasksSetVector");
-    #endif
   }
 
 
@@ -534,70 +611,33 @@ namespace hole_fusion
     std::vector<std::vector<cv::Point2f> >* inflatedRectanglesVector,
     std::vector<int>* inflatedRectanglesIndices)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createInflatedRectanglesVector",
+    PROFILE_SCOPE("createInflatedRectanglesVector",
       "createCheckerRequiredVectors");
-    #endif
-
-    // Store the vertices of the inside-of-image-bounds inflated bounding
-    // rectangles in the inflatedRectangles vector
-    std::vector<std::vector<cv::Point2f> > inflatedRectangles;
-
-    float key_y;
-    float key_x;
-    float vert_y;
-    float vert_x;
-    double theta;
-    double keypointVertDist;
 
     for (int i = 0; i < conveyor.size(); i++)
     {
-      std::vector<cv::Point2f> inflatedVertices;
-      int inflatedVerticesWithinImageLimits = 0;
-
-      for (int j = 0; j < 4; j++)
-      {
-        key_y = conveyor.holes[i].keypoint.pt.y;
-        key_x = conveyor.holes[i].keypoint.pt.x;
-
-        vert_y = conveyor.holes[i].rectangle[j].y;
-        vert_x = conveyor.holes[i].rectangle[j].x;
-
-        theta = atan2(key_y - vert_y, key_x - vert_x);
-
-        keypointVertDist = sqrt(pow(key_x -vert_x, 2) + pow(key_y -vert_x, 2));
-
-        // check if the inflated vertex has gone out of bounds
-        if (vert_x - inflationSize * cos(theta) < image.cols &&
-          vert_x - inflationSize * cos(theta) >= 0 &&
-          vert_y - inflationSize * sin(theta) < image.rows &&
-          vert_y - inflationSize * sin(theta) >= 0)
-        {
-          inflatedVerticesWithinImageLimits++;
-        }
-
-        inflatedVertices.push_back(
-          cv::Point2f(round(vert_x - inflationSize * cos(theta)),
-            round(vert_y - inflationSize * sin(theta))));
-      }  // end for rectangle's points
+      ResourcesCache::Entry scratch;
+      ResourcesCache::Entry* entry =
+        lookup(conveyor.holes[i], image.size(), &scratch);
 
-      // If one or more vertices are out of bounds discard the whole
-      // inflated rectangle
-      if (inflatedVerticesWithinImageLimits < 4)
+      // Inflate the i-th hole's rectangle, unless it has been seen recently
+      if (!entry->hasInflatedRectangle
+        || entry->inflationSize != inflationSize)
       {
-        inflatedVertices.clear();
-        continue;
+        entry->inflatedRectangle.clear();
+        entry->inflatedRectangleInBounds = inflateRectangle(conveyor.holes[i],
+          image.size(), inflationSize, &entry->inflatedRectangle);
+        entry->inflationSize = inflationSize;
+        entry->hasInflatedRectangle = true;
       }
-      else
+
+      // Inflated rectangles that go beyond the image's bounds are discarded
+      if (entry->inflatedRectangleInBounds)
       {
         inflatedRectanglesIndices->push_back(i);
-        inflatedRectanglesVector->push_back(inflatedVertices);
+        inflatedRectanglesVector->push_back(entry->inflatedRectangle);
       }
     }  // end for each hole
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createInflatedRectanglesVector");
-    #endif
   }
 
 
@@ -626,8 +666,8 @@ namespace hole_fusion
     A vector that holds the image of the intermediate points between
     a hole's outline and its bounding box, for each hole whose identifier
     exists in the @param inflatedRectanglesIndices vector
-    @param[out] intermediatePointsSetVector [std::vector<std::set<int> >*]
-    A vector that holds the intermediate points' indices between a hole's
+    @param[out] intermediatePointsRegionVector [std::vector<Region>*]
+    A vector that holds the intermediate points between a hole's
     outline and its bounding box, for each hole whose identifier
     exists in the @param inflatedRectanglesIndices vector
     @return void
@@ -638,43 +678,29 @@ namespace hole_fusion
     const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
     const std::vector<int>& inflatedRectanglesIndices,
     std::vector<cv::Mat>* intermediatePointsImageVector,
-    std::vector<std::set<unsigned int> >* intermediatePointsSetVector)
+    std::vector<Region>* intermediatePointsRegionVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createIntermediateHolesPointsVectors",
+    PROFILE_SCOPE("createIntermediateHolesPointsVectors",
       "createCheckerRequiredVectors");
-    #endif
 
     // Create the masks' set initially
-    createIntermediateHolesPointsSetVector(
+    createIntermediateHolesPointsRegionVector(
       conveyor,
       image,
       inflatedRectanglesVector,
       inflatedRectanglesIndices,
-      intermediatePointsSetVector);
+      intermediatePointsRegionVector);
 
     for (int i = 0; i < inflatedRectanglesVector.size(); i++)
     {
       // The current hole's intermediate points mask
       cv::Mat intermediatePointsMask = cv::Mat::zeros(image.size(), CV_8UC1);
 
-      // A pointer to the hole mask image
-      unsigned char* ptr = intermediatePointsMask.ptr();
-
       // Draw the intermediate points' mask
-      for (std::set<unsigned int>::iterator it =
-        (*intermediatePointsSetVector)[i].begin();
-        it != (*intermediatePointsSetVector)[i].end(); it++)
-      {
-        ptr[*it] = 255;
-      }
+      (*intermediatePointsRegionVector)[i].toMask(&intermediatePointsMask);
 
       intermediatePointsImageVector->push_back(intermediatePointsMask);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createIntermediateHolesPointsVectors");
-    #endif
   }
 
 
@@ -707,42 +733,28 @@ namespace hole_fusion
     const std::vector<int>& inflatedRectanglesIndices,
     std::vector<cv::Mat>* intermediatePointsImageVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createIntermediateHolesPointsImageVector",
+    PROFILE_SCOPE("createIntermediateHolesPointsImageVector",
       "createCheckerRequiredVectors");
-    #endif
 
     // Create the masks' set initially
-    std::vector<std::set<unsigned int> > intermediatePointsSetVector;
-    createIntermediateHolesPointsSetVector(
+    std::vector<Region> intermediatePointsRegionVector;
+    createIntermediateHolesPointsRegionVector(
       conveyor,
       image,
       inflatedRectanglesVector,
       inflatedRectanglesIndices,
-      &intermediatePointsSetVector);
+      &intermediatePointsRegionVector);
 
     for (int i = 0; i < inflatedRectanglesVector.size(); i++)
     {
       // The current hole's intermediate points mask
       cv::Mat intermediatePointsMask = cv::Mat::zeros(image.size(), CV_8UC1);
 
-      // A pointer to the hole mask image
-      unsigned char* ptr = intermediatePointsMask.ptr();
-
       // Draw the intermediate points' mask
-      for (std::set<unsigned int>::iterator it =
-        intermediatePointsSetVector[i].begin();
-        it != intermediatePointsSetVector[i].end(); it++)
-      {
-        ptr[*it] = 255;
-      }
+      intermediatePointsRegionVector[i].toMask(&intermediatePointsMask);
 
       intermediatePointsImageVector->push_back(intermediatePointsMask);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("createIntermediateHolesPointsImageVector");
-    #endif
   }
 
 
@@ -750,7 +762,7 @@ namespace hole_fusion
   /**
     @brief For each hole, this function finds the points between the hole's
     outline and the rectangle (inflated or not) that corrensponds to it.
-    These points are then stored in a std::set of ints.
+    These points are then stored in a run-length Region.
     @param[in] conveyor [const HolesConveyor&] The conveyor of holes
     @param[in] image [const cv::Mat&] An image needed only for
     its size
@@ -762,133 +774,100 @@ namespace hole_fusion
     is used to identify a hole's corresponding rectangle. Used primarily
     because the rectangles used are inflated rectangles; not all holes
     possess an inflated rectangle
-    @param[out] intermediatePointsSetVector [std::vector<std::set<int> >*]
-    A vector that holds the intermediate points' indices between a hole's
+    @param[out] intermediatePointsRegionVector [std::vector<Region>*]
+    A vector that holds the intermediate points between a hole's
     outline and its bounding box, for each hole whose identifier
     exists in the @param inflatedRectanglesIndices vector
     @return void
    **/
-  void FiltersResources::createIntermediateHolesPointsSetVector(
+  void FiltersResources::createIntermediateHolesPointsRegionVector(
     const HolesConveyor& conveyor,
     const cv::Mat& image,
     const std::vector<std::vector<cv::Point2f> >& inflatedRectanglesVector,
     const std::vector<int>& inflatedRectanglesIndices,
-    std::vector<std::set<unsigned int> >* intermediatePointsSetVector)
+    std::vector<Region>* intermediatePointsRegionVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("createIntermediateHolesPointsSetVector",
+    PROFILE_SCOPE("createIntermediateHolesPointsRegionVector",
       "createCheckerRequiredVectors");
-    #endif
 
     for (int i = 0; i < inflatedRectanglesVector.size(); i++)
     {
-      // The current hole's mask
-      cv::Mat intermediatePointsMask = cv::Mat::zeros(image.size(), CV_8UC1);
-
-      // An image whose non-zero value pixels are the ones inside the
-      // hole's outline
-      cv::Mat holeOutlineFilledImage = cv::Mat::zeros(image.size(), CV_8UC1);
+      const HoleConveyor& hole = conveyor.holes[inflatedRectanglesIndices[i]];
 
+      ResourcesCache::Entry scratch;
+      ResourcesCache::Entry* entry = lookup(hole, image.size(), &scratch);
 
-      // Draw the outline of the i-th hole onto holeOutlineFilledImage
-      for (unsigned int j = 0;
-        j < conveyor.holes[inflatedRectanglesIndices[i]].outline.size(); j++)
+      // The intermediate points are found anew if the hole has not been
+      // seen recently or if its rectangle is not the one they were found for
+      if (!entry->hasIntermediatePoints
+        || entry->intermediateRectangle != inflatedRectanglesVector[i])
       {
-        holeOutlineFilledImage.at<unsigned char>(
-          conveyor.holes[inflatedRectanglesIndices[i]].outline[j].y,
-          conveyor.holes[inflatedRectanglesIndices[i]].outline[j].x) = 255;
-      }
-
-      // The set of indices of points inside the i-th hole's outline
-      std::set<unsigned int> holeOutlineFilledSet;
-
-      // The brushfire start point is the hole's seedPoint
-      cv::Point2f seedPoint(
-        conveyor.holes[inflatedRectanglesIndices[i]].keypoint.pt.x,
-        conveyor.holes[inflatedRectanglesIndices[i]].keypoint.pt.y);
-
-      // floodFill from the seedPoint to the hole's outline
-      // to obtain the points inside it
-      cv::floodFill(holeOutlineFilledImage, seedPoint, cv::Scalar(255));
-
-      // Take a pointer on the hole's mask image
-      unsigned char* ptr = holeOutlineFilledImage.ptr();
-
-      // The points with non-zero value are the ones inside the i-th hole.
-      // Insert them into the desired set.
-      for (int rows = 0; rows < holeOutlineFilledImage.rows; rows++)
-      {
-        for (int cols = 0; cols < holeOutlineFilledImage.cols; cols++)
+        if (!entry->hasMask)
         {
-          if (ptr[rows * holeOutlineFilledImage.cols + cols] != 0)
-          {
-            holeOutlineFilledSet.insert(
-              rows * holeOutlineFilledImage.cols + cols);
-          }
+          entry->mask = fillOutline(hole, image.size());
+          entry->hasMask = true;
         }
-      }
 
-      // holeOutlineFilledSet is now constructed
+        entry->intermediatePoints = findIntermediatePoints(hole,
+          image.size(), inflatedRectanglesVector[i], entry->mask);
+        entry->intermediateRectangle = inflatedRectanglesVector[i];
+        entry->hasIntermediatePoints = true;
+      }
 
+      intermediatePointsRegionVector->push_back(entry->intermediatePoints);
+    }
+  }
 
-      // An image whose non-zero value pixels are the ones inside the
-      // hole's bounding rectangle
-      cv::Mat rectangleOutlineFilledImage =
-        cv::Mat::zeros(image.size(), CV_8UC1);
 
-      // Draw the bounding rectangle of the i-th hole onto
-      // rectangleOutlineFilledImage
-      for (unsigned int j = 0; j < inflatedRectanglesVector[i].size(); j++)
-      {
-        cv::line(rectangleOutlineFilledImage,
-          inflatedRectanglesVector[i][j],
-          inflatedRectanglesVector[i][(j + 1)
-          % inflatedRectanglesVector[i].size()],
-          cv::Scalar(255, 0, 0), 1, 8);
-      }
 
-      // The set of indices of points inside the i-th hole's
-      // bounding rectangle
-      std::set<unsigned int> rectangleOutlineFilledSet;
+  /**
+    @brief The running totals of the cache of holes' resources
+    @return [const ResourcesCache::Statistics&] The totals
+   **/
+  const ResourcesCache::Statistics& FiltersResources::getCacheStatistics()
+  {
+    return cache_.getStatistics();
+  }
 
-      // floodFill from the seedPoint to the hole's bounding rectangle
-      // to obtain the points inside it
-      cv::floodFill(rectangleOutlineFilledImage, seedPoint, cv::Scalar(255));
 
-      // Take a pointer on the rectangle's mask image
-      ptr = rectangleOutlineFilledImage.ptr();
 
-      // The points with non-zero value are the ones inside the i-th hole.
-      // Insert them into the desired set.
-      for (int rows = 0; rows < rectangleOutlineFilledImage.rows; rows++)
-      {
-        for (int cols = 0; cols < rectangleOutlineFilledImage.cols; cols++)
-        {
-          if (ptr[rows * rectangleOutlineFilledImage.cols + cols] != 0)
-          {
-            rectangleOutlineFilledSet.insert(
-              rows * rectangleOutlineFilledImage.cols + cols);
-          }
-        }
-      }
-      // rectangleOutlineFilledSet is now constructed
+  /**
+    @brief Forgets the resources of every hole seen so far and zeroes
+    the running totals of the cache
+    @return void
+   **/
+  void FiltersResources::clearCache()
+  {
+    cache_.clear();
+    cache_.resetStatistics();
+  }
 
 
-      // The final set of points' indices
-      std::set<unsigned int> intermediatePointsSet;
 
-      std::set_difference(rectangleOutlineFilledSet.begin(),
-        rectangleOutlineFilledSet.end(),
-        holeOutlineFilledSet.begin(),
-        holeOutlineFilledSet.end(),
-        std::inserter(intermediatePointsSet, intermediatePointsSet.end()));
+  /**
+    @brief Finds the cached resources of a hole. The cache is resized to
+    Parameters::HoleFusion::resources_cache_size first
+    @param[in] hole [const HoleConveyor&] The hole
+    @param[in] size [const cv::Size&] The size of the image the resources
+    are computed for
+    @param[in] scratch [ResourcesCache::Entry*] An empty entry, returned
+    when the cache is disabled
+    @return [ResourcesCache::Entry*] The hole's entry
+   **/
+  ResourcesCache::Entry* FiltersResources::lookup(const HoleConveyor& hole,
+    const cv::Size& size, ResourcesCache::Entry* scratch)
+  {
+    std::size_t capacity =
+      std::max(Parameters::HoleFusion::resources_cache_size, 0);
 
-      intermediatePointsSetVector->push_back(intermediatePointsSet);
+    if (cache_.capacity() != capacity)
+    {
+      cache_.setCapacity(capacity);
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("createIntermediateHolesPointsSetVector");
-    #endif
+    ResourcesCache::Entry* entry = cache_.lookup(hole, size);
+
+    return entry != NULL ? entry : scratch;
   }
 
 }  // namespace hole_fusion
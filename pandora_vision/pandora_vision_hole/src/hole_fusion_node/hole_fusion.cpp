@@ -77,6 +77,19 @@ namespace hole_fusion
     nodeHandle_.param("rgbd_mode", rgbdMode_, true);
     nodeHandle_.param("rgbdt_mode", rgbdtMode_, true);
 
+    // The probes of the hole detection nodes, present when built with
+    // DEBUG_TIME, report their measurements periodically on the log and,
+    // if a trace file is given, in it as well
+    double profilerReportPeriod;
+    privateNodeHandle_.param("profiler_report_period", profilerReportPeriod, 1.0);
+    Profiler::setReportPeriod(profilerReportPeriod);
+
+    std::string profilerTraceFile;
+    if (privateNodeHandle_.getParam("profiler_trace_file", profilerTraceFile))
+    {
+      Profiler::setTraceFile(profilerTraceFile);
+    }
+
     std::string private_namespace = privateNodeHandle_.getNamespace();
     generalNodeHandle_ = ros::NodeHandle(private_namespace + "/general");
     filtersPriorityNodeHandle_ =  ros::NodeHandle(private_namespace + "/priority");
@@ -206,7 +219,7 @@ namespace hole_fusion
       &HoleFusion::rgbCandidateHolesCallback, this);
 
     // Subscribe to the topic where the synchronizer node publishes
-    // the point cloud
+    // the frames holding the point cloud
     pointCloudSubscriber_= nodeHandle_.subscribe(
       pointCloudTopic_, 1,
       &HoleFusion::pointCloudCallback, this);
@@ -299,9 +312,7 @@ namespace hole_fusion
   void HoleFusion::depthCandidateHolesCallback(
     const ::pandora_vision_hole::CandidateHolesVectorMsgConstPtr& depthCandidateHolesVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("depthCandidateHolesCallback", "", true);
-    #endif
+    PROFILE_ROOT_SCOPE("depthCandidateHolesCallback");
 
     // Clear the current depthHolesConveyor struct
     // (or else keyPoints, rectangles and outlines accumulate)
@@ -330,11 +341,6 @@ namespace hole_fusion
 
       processCandidateHoles();
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("depthCandidateHolesCallback");
-    Timer::printAllMeansTree();
-    #endif
   }
 
   /**
@@ -356,9 +362,7 @@ namespace hole_fusion
     const ::pandora_vision_hole::CandidateHolesVectorMsgConstPtr&
     thermalCandidateHolesVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("thermalCandidateHolesCallback", "", true);
-    #endif
+    PROFILE_ROOT_SCOPE("thermalCandidateHolesCallback");
 
     // Clear the current depthHolesConveyor struct
     // (or else keyPoints, rectangles and outlines accumulate)
@@ -386,11 +390,6 @@ namespace hole_fusion
 
       processCandidateHoles();
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("thermalCandidateHolesCallback");
-    Timer::printAllMeansTree();
-    #endif
   }
 
   /**
@@ -409,9 +408,7 @@ namespace hole_fusion
   std::vector<std::vector<float> > HoleFusion::filterHoles(
     const HolesConveyor& conveyor)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("filterHoles", "processCandidateHoles");
-    #endif
+    PROFILE_SCOPE("filterHoles", "processCandidateHoles");
 
     // A vector of images that each one of them represents the corresponding
     // hole's mask: non-zero value pixels are within a hole's outline points
@@ -419,7 +416,7 @@ namespace hole_fusion
 
     // A vector of sets that each one of them contains indices of points
     // inside the hole's outline
-    std::vector<std::set<unsigned int> > holesMasksSetVector;
+    std::vector<Region> holesMasksRegionVector;
 
     // A vector of vertices of each inflated bounding rectangle.
     std::vector<std::vector<cv::Point2f> > inflatedRectanglesVector;
@@ -431,7 +428,7 @@ namespace hole_fusion
 
     // A vector of sets that each one of them contains indices of points
     // between the hole's outline and its respective bounding box
-    std::vector<std::set<unsigned int> > intermediatePointsSetVector;
+    std::vector<Region> intermediatePointsRegionVector;
 
     // A vector of images that each one of them contains points
     // between the hole's outline and its respective bounding box
@@ -445,11 +442,11 @@ namespace hole_fusion
       Parameters::HoleFusion::rectangle_inflation_size,
       filteringMode_,
       &holesMasksImageVector,
-      &holesMasksSetVector,
+      &holesMasksRegionVector,
       &inflatedRectanglesVector,
       &inflatedRectanglesIndices,
       &intermediatePointsImageVector,
-      &intermediatePointsSetVector);
+      &intermediatePointsRegionVector);
 
     // Initialize the probabilities 2D vector.
 
@@ -557,18 +554,14 @@ namespace hole_fusion
       rgbImage_,
       wallsHistogram_,
       pointCloud_,
-      holesMasksSetVector,
+      holesMasksRegionVector,
       holesMasksImageVector,
       inflatedRectanglesVector,
       inflatedRectanglesIndices,
-      intermediatePointsSetVector,
+      intermediatePointsRegionVector,
       intermediatePointsImageVector,
       &probabilitiesVector2D);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("filterHoles");
-    #endif
-
     // All filters have been applied, all probabilities produced
     return probabilitiesVector2D;
   }
@@ -625,11 +618,11 @@ namespace hole_fusion
   void HoleFusion::getTopicNames()
   {
     // Read the name of the topic from where the Hole Fusion node acquires the
-    // input point cloud
-    if (!privateNodeHandle_.getParam("subscribed_topics/point_cloud_internal_topic",
+    // synchronized frames, holding the input point cloud
+    if (!privateNodeHandle_.getParam("subscribed_topics/synchronized_frame_topic",
         pointCloudTopic_))
     {
-      NODELET_FATAL("[%s] Could not find topic point_cloud_internal_topic",
+      NODELET_FATAL("[%s] Could not find topic synchronized_frame_topic",
           nodeName_.c_str());
       ROS_BREAK();
     }
@@ -1011,6 +1004,10 @@ namespace hole_fusion
     Parameters::HoleFusion::rectangle_inflation_size =
       config.rectangle_inflation_size;
 
+    // The number of holes whose resources are kept between frames
+    Parameters::HoleFusion::resources_cache_size =
+      config.resources_cache_size;
+
     // Depth diff parameters
 
     // 0 for binary probability assignment on positive depth difference
@@ -1046,6 +1043,12 @@ namespace hole_fusion
       config.num_points_to_exclude;
     Parameters::HoleFusion::Planes::point_to_plane_distance_threshold =
       config.point_to_plane_distance_threshold;
+    Parameters::HoleFusion::Planes::segment_whole_frame =
+      config.segment_whole_frame;
+    Parameters::HoleFusion::Planes::min_plane_inliers =
+      config.min_plane_inliers;
+    Parameters::HoleFusion::Planes::plane_angular_threshold =
+      config.plane_angular_threshold;
 
 
     //--------------------------- Merger parameters ----------------------------
@@ -1136,6 +1139,10 @@ namespace hole_fusion
     Parameters::HoleFusion::Validation::validation_process = 1;
     // config.validation_process;
 
+    // Whether filters stop being applied to holes that cannot be valid
+    Parameters::HoleFusion::Validation::short_circuit_filters =
+      config.short_circuit_filters;
+
     // When depth analysis is applicable
     Parameters::HoleFusion::Validation::rgbd_validity_threshold =
       config.rgbd_validity_threshold;
@@ -1149,29 +1156,26 @@ namespace hole_fusion
 
 
   /**
-    @brief Callback for the point cloud that the synchronizer node
+    @brief Callback for the frame that the synchronizer node
     publishes.
 
-    This method interpolates the input point cloud so that depth-based
-    filters using it have an integral input and sets it and header-related
-    variables.
+    This method keeps the frame's point cloud, whose depth the
+    synchronizer has already set to that of the interpolated depth
+    image, and sets header-related variables.
     If the depth and RGB callback counterparts have done
     what must be, it resets the number of ready nodes, unlocks
     the synchronizer and calls for processing of the candidate
     holes.
-    @param[in] msg [const PointCloudPtr&] The message containing
-    the point cloud
+    @param[in] msg [const SynchronizedFrameConstPtr&]
+    The synchronized frame, containing the point cloud
     @return void
    **/
-  void HoleFusion::pointCloudCallback(const PointCloudConstPtr& msg)
+  void HoleFusion::pointCloudCallback(
+    const SynchronizedFrameConstPtr& msg)
   {
-#ifdef DEBUG_TIME
-    Timer::start("pointCloudCallback", "", true);
-#endif
+    PROFILE_ROOT_SCOPE("pointCloudCallback");
 
-    // Convert the header of the point cloud message
-    std_msgs::Header header;
-    pcl_conversions::fromPCL(msg->header, header);
+    const std_msgs::Header& header = msg->header;
 
     // Store the frame_id and timestamp of the point cloud under processing.
     // The respective variables in the headers of the published messages will
@@ -1191,26 +1195,19 @@ namespace hole_fusion
       getParentFrameId();
     }
 
-    // Because the input point cloud is marked as const,
-    // and we need to interpolate the noise in it,
-    // copy the input point cloud to a local one.
-    pcl::copyPointCloud(*msg, *pointCloud_);
-
-    // Extract the depth image from the point cloud message
-    cv::Mat depthImage = MessageConversions::convertPointCloudMessageToImage(
-        msg, CV_32FC1);
-
-    // Interpolate the depthImage
-    cv::Mat interpolatedDepthImage;
-    NoiseElimination::performNoiseElimination(depthImage,
-      &interpolatedDepthImage);
-
-    // The noise elimination method above defines the interpolation method.
-    // Only in interpolation_method of zero can the depth filters through which
-    // each candidate hole is passed be utilized: there is no valid depth
-    // information available if the value of interpolation_method is set to
-    // other than zero.
-    if (Parameters::Depth::interpolation_method == 0)
+    // The synchronizer has already converted the point cloud and set its
+    // depth to that of the interpolated depth image; share it as it is
+    pointCloud_ = msg->pointCloud;
+
+    // The synchronizer has already extracted the depth image from the point
+    // cloud and interpolated its noise; view it without copying
+    cv::Mat interpolatedDepthImage = cv_bridge::toCvShare(
+      msg->depthImage, msg, sensor_msgs::image_encodings::TYPE_32FC1)->image;
+
+    // The noise elimination method of the synchronizer defines whether there
+    // is valid depth information. Only then can the depth filters through
+    // which each candidate hole is passed be utilized.
+    if (msg->isDepth)
     {
       filteringMode_ = RGBD_MODE;
     }
@@ -1219,9 +1216,17 @@ namespace hole_fusion
       filteringMode_ = RGB_ONLY_MODE;
     }
 
-    // Set the interpolatedDepthImage's values as the depth values
-    // of the point cloud
-    setDepthValuesInPointCloud(interpolatedDepthImage, &pointCloud_);
+    // Segment the planes of the interpolated point cloud once, for all the
+    // depth filters and the merger to query
+    if (filteringMode_ == RGBD_MODE
+      && Parameters::HoleFusion::Planes::segment_whole_frame)
+    {
+      PlanesDetection::setFramePlanes(pointCloud_);
+    }
+    else
+    {
+      PlanesDetection::clearFramePlanes();
+    }
 
     // The interpolated point cloud, frame_id and timestamp are set
     numNodesReady_++;
@@ -1237,11 +1242,6 @@ namespace hole_fusion
 
       processCandidateHoles();
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("pointCloudCallback");
-    Timer::printAllMeansTree();
-    #endif
   }
 
 
@@ -1269,9 +1269,7 @@ namespace hole_fusion
   {
     NODELET_INFO("[%s] Processing candidate holes", nodeName_.c_str());
 
-    #ifdef DEBUG_TIME
-    Timer::start("processCandidateHoles", "", true);
-    #endif
+    PROFILE_ROOT_SCOPE("processCandidateHoles");
 
     // if (Parameters::Debug::publish_enhanced_Images)
     // {
@@ -1579,11 +1577,6 @@ namespace hole_fusion
     // regardless of the amount of valid holes
     if (publishingEnhancedHoles_)
       publishEnhancedHoles(uniqueValidHoles, &validHolesMap);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("processCandidateHoles");
-    Timer::printAllMeansTree();
-    #endif
   }
 
 
@@ -1944,9 +1937,7 @@ namespace hole_fusion
     const ::pandora_vision_hole::CandidateHolesVectorMsgConstPtr&
     rgbCandidateHolesVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("rgbCandidateHolesCallback", "", true);
-    #endif
+    PROFILE_ROOT_SCOPE("rgbCandidateHolesCallback");
 
     // Clear the current rgbHolesConveyor struct
     // (or else keyPoints, rectangles and outlines accumulate)
@@ -1974,55 +1965,6 @@ namespace hole_fusion
 
       processCandidateHoles();
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("rgbCandidateHolesCallback");
-    Timer::printAllMeansTree();
-    #endif
-  }
-
-
-
-  /**
-    @brief Sets the depth values of a point cloud according to the
-    values of a depth image.
-
-    Needed by the depth-based filters that employ a point cloud analysis.
-    The values of the point cloud published by the synchronizer node to
-    the hole fusion node contain the unadulterated values of the point
-    cloud directly obtained by the depth sensor,
-    hence they contain NaNs and zero-value pixels that
-    would otherwise, if not for this method, obstruct the function of the
-    above filters.
-    @param[in] inImage [const cv::Mat&] The depth image in CV_32FC1 format
-    @param[out] pointCloudPtr [PointCloudPtr*] The point cloud
-    @return void
-   **/
-  void HoleFusion::setDepthValuesInPointCloud(const cv::Mat& inImage,
-    PointCloudPtr* pointCloudPtr)
-  {
-    #ifdef DEBUG_TIME
-    Timer::start("setDepthValuesInPointCloud", "pointCloudCallback");
-    #endif
-
-    // If the inImage is not of type CV_32FC1, return
-    if (inImage.type() != CV_32FC1)
-    {
-      return;
-    }
-
-    for (unsigned int row = 0; row < (*pointCloudPtr)->height; ++row)
-    {
-      for (unsigned int col = 0; col < (*pointCloudPtr)->width; ++col)
-      {
-        (*pointCloudPtr)->points[col + (*pointCloudPtr)->width * row].z =
-          inImage.at<float>(row, col);
-      }
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("setDepthValuesInPointCloud");
-    #endif
   }
 
 
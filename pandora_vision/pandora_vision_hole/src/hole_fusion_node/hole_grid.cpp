@@ -0,0 +1,253 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include "hole_fusion_node/hole_grid.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  namespace
+  {
+    //  Removes one occurrence of id from ids, not keeping their order
+    void eraseId(std::vector<int>* ids, int id)
+    {
+      std::vector<int>::iterator it = std::find(ids->begin(), ids->end(), id);
+      if (it != ids->end())
+      {
+        *it = ids->back();
+        ids->pop_back();
+      }
+    }
+  }  // namespace
+
+  HoleGrid::HoleGrid(float cellSize) :
+    cellSize_(cellSize), size_(0), stamp_(0)
+  {
+  }
+
+  void HoleGrid::insert(int id, const cv::Rect_<float>& box)
+  {
+    if (id >= static_cast<int>(boxes_.size()))
+    {
+      boxes_.resize(id + 1);
+      indexed_.resize(id + 1, 0);
+      stamps_.resize(id + 1, 0);
+    }
+
+    remove(id);
+
+    boxes_[id] = box;
+    indexed_[id] = 1;
+    size_++;
+
+    int x0, y0, x1, y1;
+    if (!cellRange(box, &x0, &y0, &x1, &y1))
+    {
+      oversized_.push_back(id);
+      return;
+    }
+
+    for (int y = y0; y <= y1; y++)
+    {
+      for (int x = x0; x <= x1; x++)
+      {
+        cells_[Cell(x, y)].push_back(id);
+      }
+    }
+  }
+
+  void HoleGrid::remove(int id)
+  {
+    if (id < 0 || id >= static_cast<int>(indexed_.size()) || !indexed_[id])
+    {
+      return;
+    }
+
+    indexed_[id] = 0;
+    size_--;
+
+    int x0, y0, x1, y1;
+    if (!cellRange(boxes_[id], &x0, &y0, &x1, &y1))
+    {
+      eraseId(&oversized_, id);
+      return;
+    }
+
+    for (int y = y0; y <= y1; y++)
+    {
+      for (int x = x0; x <= x1; x++)
+      {
+        CellMap::iterator cell = cells_.find(Cell(x, y));
+        if (cell == cells_.end())
+        {
+          continue;
+        }
+
+        eraseId(&cell->second, id);
+        if (cell->second.empty())
+        {
+          cells_.erase(cell);
+        }
+      }
+    }
+  }
+
+  void HoleGrid::query(const cv::Rect_<float>& box, float margin,
+    std::vector<int>* ids) const
+  {
+    ids->clear();
+
+    if (size_ == 0)
+    {
+      return;
+    }
+
+    cv::Rect_<float> grown(box.x - margin, box.y - margin,
+      box.width + 2 * margin, box.height + 2 * margin);
+
+    int x0, y0, x1, y1;
+    if (!cellRange(grown, &x0, &y0, &x1, &y1))
+    {
+      // The query spans more cells than there are holes worth visiting
+      for (unsigned int id = 0; id < indexed_.size(); id++)
+      {
+        if (indexed_[id] && near(boxes_[id], box, margin))
+        {
+          ids->push_back(id);
+        }
+      }
+      return;
+    }
+
+    // A new stamp tells the holes reported by this query apart from those
+    // reported by the previous ones
+    if (++stamp_ == 0)
+    {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      stamp_ = 1;
+    }
+
+    for (int y = y0; y <= y1; y++)
+    {
+      for (int x = x0; x <= x1; x++)
+      {
+        CellMap::const_iterator cell = cells_.find(Cell(x, y));
+        if (cell == cells_.end())
+        {
+          continue;
+        }
+
+        for (unsigned int i = 0; i < cell->second.size(); i++)
+        {
+          int id = cell->second[i];
+          if (stamps_[id] != stamp_ && near(boxes_[id], box, margin))
+          {
+            ids->push_back(id);
+          }
+          stamps_[id] = stamp_;
+        }
+      }
+    }
+
+    for (unsigned int i = 0; i < oversized_.size(); i++)
+    {
+      if (near(boxes_[oversized_[i]], box, margin))
+      {
+        ids->push_back(oversized_[i]);
+      }
+    }
+  }
+
+  void HoleGrid::clear()
+  {
+    oversized_.clear();
+    cells_.clear();
+    boxes_.clear();
+    indexed_.clear();
+    stamps_.clear();
+    size_ = 0;
+  }
+
+  bool HoleGrid::cellRange(const cv::Rect_<float>& box,
+    int* x0, int* y0, int* x1, int* y1) const
+  {
+    double left = std::floor(box.x / cellSize_);
+    double top = std::floor(box.y / cellSize_);
+    double right = std::floor((box.x + box.width) / cellSize_);
+    double bottom = std::floor((box.y + box.height) / cellSize_);
+
+    // Not finite coordinates fail the comparisons
+    if (!((right - left + 1) * (bottom - top + 1) <= maxCells_))
+    {
+      return false;
+    }
+
+    // The span is small, but the cells themselves may be far away
+    if (!(std::fabs(left) < 1e9 && std::fabs(top) < 1e9))
+    {
+      return false;
+    }
+
+    *x0 = static_cast<int>(left);
+    *y0 = static_cast<int>(top);
+    *x1 = static_cast<int>(right);
+    *y1 = static_cast<int>(bottom);
+
+    return true;
+  }
+
+  bool HoleGrid::near(const cv::Rect_<float>& a,
+    const cv::Rect_<float>& b, float margin)
+  {
+    return a.x <= b.x + b.width + margin
+      && b.x <= a.x + a.width + margin
+      && a.y <= b.y + b.height + margin
+      && b.y <= a.y + a.height + margin;
+  }
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -36,6 +36,9 @@
  *********************************************************************/
 
 #include "hole_fusion_node/hole_merger.h"
+#include "hole_fusion_node/hole_grid.h"
+#include <algorithm>
+#include <boost/math/special_functions/fpclassify.hpp>
 
 /**
   @namespace pandora_vision
@@ -47,6 +50,389 @@ namespace pandora_vision_hole
 {
 namespace hole_fusion
 {
+  namespace
+  {
+    //  The side of the grid cells that index the holes' masks, in pixels
+    const float MASK_CELL_SIZE = 32.0;
+
+    //  The side of the grid cells that index the holes' outlines on the
+    //  x-y plane of the point cloud, in meters
+    const float OUTLINE_CELL_SIZE = 0.1;
+
+    /**
+      @brief Orders the holes the way the active hole examines them:
+      the holes after it first, then the ones before it, which have
+      already finished examining the others
+     **/
+    struct ExaminationOrder
+    {
+      explicit ExaminationOrder(int activeId) : activeId_(activeId) {}
+
+      bool operator()(int a, int b) const
+      {
+        bool aFinished = a < activeId_;
+        bool bFinished = b < activeId_;
+        return aFinished != bFinished ? bFinished : a < b;
+      }
+
+      int activeId_;
+    };
+
+    /**
+      @brief Finds the box by which a hole is indexed. Two holes can
+      assimilate or amalgamate each other only if their masks overlap,
+      so the box of a mask is that of its pixels. Two holes can be
+      connected only if two points of their outlines are closer than
+      connect_holes_min_distance in real space, which they can not be if
+      they are further apart on the x-y plane of the point cloud, so the
+      box of an outline is that of its points with finite coordinates
+      @param[in] hole [const HoleConveyor&] The hole
+      @param[in] mask [const Region&] The points inside the hole's outline
+      @param[in] pointCloud [const PointCloudConstPtr&] The point cloud
+      @param[in] operationId [int] The merging operation
+      @param[out] box [cv::Rect_<float>*] The hole's box
+      @return [bool] False if the hole has no box: its mask is empty or
+      none of its outline points has a finite depth
+     **/
+    bool holeBox(
+      const HoleConveyor& hole,
+      const Region& mask,
+      const PointCloudConstPtr& pointCloud,
+      int operationId,
+      cv::Rect_<float>* box)
+    {
+      if (operationId != CONNECTION)
+      {
+        if (mask.empty())
+        {
+          return false;
+        }
+
+        // The runs end past their last pixel
+        cv::Rect pixels = mask.boundingBox();
+        *box = cv::Rect_<float>(pixels.x, pixels.y,
+          pixels.width - 1, pixels.height - 1);
+
+        return true;
+      }
+
+      float minX = 0;
+      float minY = 0;
+      float maxX = 0;
+      float maxY = 0;
+      bool found = false;
+
+      for (unsigned int o = 0; o < hole.outline.size(); o++)
+      {
+        const PointCloud::PointType& point = pointCloud->points[
+          static_cast<int>(hole.outline[o].x)
+          + pointCloud->width * static_cast<int>(hole.outline[o].y)];
+
+        if (!boost::math::isfinite(point.x)
+          || !boost::math::isfinite(point.y)
+          || !boost::math::isfinite(point.z))
+        {
+          continue;
+        }
+
+        if (!found)
+        {
+          minX = maxX = point.x;
+          minY = maxY = point.y;
+          found = true;
+        }
+        else
+        {
+          minX = std::min(minX, point.x);
+          maxX = std::max(maxX, point.x);
+          minY = std::min(minY, point.y);
+          maxY = std::max(maxY, point.y);
+        }
+      }
+
+      *box = cv::Rect_<float>(minX, minY, maxX - minX, maxY - minY);
+
+      return found;
+    }
+
+    /**
+      @brief Checks a merged hole through the depth filters that validate
+      merges
+      @param[in] merged [const HolesConveyor&] A conveyor holding only the
+      merged hole
+      @param[in] mask [const Region&] The points inside the merged hole
+      @param[in] image [const cv::Mat&] The interpolated depth image
+      @return [bool] True if the merged hole passed both filters
+     **/
+    bool isMergeValid(
+      const HolesConveyor& merged,
+      const Region& mask,
+      const cv::Mat& image)
+    {
+      // Create the necessary vectors for each hole checker used
+      std::vector<std::string> msgs;
+      std::vector<std::vector<cv::Point2f> > rectanglesVector;
+      std::vector<int> rectanglesIndices;
+
+      // The inflated rectangles vector is used in the checkHolesDepthDiff
+      // checker
+      FiltersResources::createInflatedRectanglesVector(
+        merged,
+        image,
+        Parameters::HoleFusion::rectangle_inflation_size,
+        &rectanglesVector,
+        &rectanglesIndices);
+
+      // The vector of depth-filters-derived probabilities
+      std::vector<std::vector<float> >probabilitiesVector(
+        2,
+        std::vector<float>(1, 0.0));
+
+      // Check the difference between the mean depth of the
+      // vertices of the merged hole's bounding box and the depth of the
+      // merged hole's keypoint
+      DepthFilters::checkHolesDepthDiff(
+        image,
+        merged,
+        rectanglesVector,
+        rectanglesIndices,
+        &msgs,
+        &probabilitiesVector.at(0));
+
+      // Check the depth / area proportion for the merged hole
+      DepthFilters::checkHolesDepthArea(
+        merged,
+        image,
+        std::vector<Region>(1, mask),
+        &msgs,
+        &probabilitiesVector.at(1));
+
+      return probabilitiesVector[0][0]
+        >= Parameters::HoleFusion::Merger::depth_diff_threshold
+        && probabilitiesVector[1][0]
+        >= Parameters::HoleFusion::Merger::depth_area_threshold;
+    }
+
+    /**
+      @brief Has every hole, in turn, {assimilate, amalgamate, connect}
+      the holes it can. After each merge the merging hole examines the
+      others anew. Only the holes whose boxes meet the examining hole's
+      box are examined, in the order the holes are found in the conveyor,
+      starting with the one after it; the boxes are kept in a grid that
+      follows the merges. Skipping the rest does not change the outcome,
+      since none of them could be merged.
+      @param[in,out] rgbdHolesConveyor [HolesConveyor*] The candidate holes
+      @param[in] image [const cv::Mat&] An image used for filters' resources
+      creation and size usage
+      @param[in] pointCloud [const PointCloudConstPtr&] The point cloud, needed
+      only by the connection operation
+      @param[in] operationId [int] The merging operation
+      @param[in] validate [bool] Whether a merge is kept only if the
+      merged hole passes the depth filters
+      @return void
+     **/
+    void mergeIndexedHoles(
+      HolesConveyor* rgbdHolesConveyor,
+      const cv::Mat& image,
+      const PointCloudConstPtr& pointCloud,
+      int operationId,
+      bool validate)
+    {
+      int numHoles = rgbdHolesConveyor->size();
+
+      std::vector<HoleConveyor>& holes = rgbdHolesConveyor->holes;
+
+      // The points inside each hole's outline
+      std::vector<Region> holesMasksRegionVector;
+      FiltersResources::createHolesMasksRegionVector(
+        *rgbdHolesConveyor,
+        image,
+        &holesMasksRegionVector);
+
+      // Whether each hole has been merged into another
+      std::vector<char> isMerged(numHoles, 0);
+
+      // Holes with an empty mask can be assimilated by any hole,
+      // although they have no box
+      std::vector<int> unboxed;
+
+      // Connectable holes may lie apart by up to the connection distance
+      float margin = 0;
+      if (operationId == CONNECTION)
+      {
+        margin = Parameters::HoleFusion::Merger::connect_holes_min_distance;
+      }
+
+      HoleGrid grid(
+        operationId == CONNECTION ? OUTLINE_CELL_SIZE : MASK_CELL_SIZE);
+
+      std::vector<cv::Rect_<float> > boxes(numHoles);
+      std::vector<char> hasBox(numHoles, 0);
+
+      for (int i = 0; i < numHoles; i++)
+      {
+        hasBox[i] = holeBox(holes[i], holesMasksRegionVector[i], pointCloud,
+          operationId, &boxes[i]);
+
+        if (hasBox[i])
+        {
+          grid.insert(i, boxes[i]);
+        }
+        else if (operationId == ASSIMILATION)
+        {
+          unboxed.push_back(i);
+        }
+      }
+
+      std::vector<int> candidates;
+
+      for (int activeId = 0; activeId < numHoles; activeId++)
+      {
+        if (isMerged[activeId])
+        {
+          continue;
+        }
+
+        // The active hole examines the others until it merges none
+        bool hasMerged = true;
+        while (hasMerged)
+        {
+          hasMerged = false;
+
+          candidates.clear();
+          if (hasBox[activeId])
+          {
+            grid.query(boxes[activeId], margin, &candidates);
+          }
+          candidates.insert(candidates.end(), unboxed.begin(), unboxed.end());
+          candidates.erase(
+            std::remove(candidates.begin(), candidates.end(), activeId),
+            candidates.end());
+          std::sort(candidates.begin(), candidates.end(),
+            ExaminationOrder(activeId));
+
+          for (unsigned int c = 0; c < candidates.size() && !hasMerged; c++)
+          {
+            int passiveId = candidates[c];
+
+            // The active and passive holes, at 0 and 1
+            HolesConveyor pair;
+            pair.holes.push_back(holes[activeId]);
+            pair.holes.push_back(holes[passiveId]);
+
+            bool isAble = false;
+
+            if (operationId == ASSIMILATION)
+            {
+              isAble = HoleMerger::isCapableOfAssimilating(
+                holesMasksRegionVector[activeId],
+                holesMasksRegionVector[passiveId]);
+            }
+            else if (operationId == AMALGAMATION)
+            {
+              isAble = HoleMerger::isCapableOfAmalgamating(
+                holesMasksRegionVector[activeId],
+                holesMasksRegionVector[passiveId]);
+            }
+            else if (operationId == CONNECTION)
+            {
+              isAble = HoleMerger::isCapableOfConnecting(pair,
+                0,
+                1,
+                holesMasksRegionVector[activeId],
+                holesMasksRegionVector[passiveId],
+                pointCloud);
+            }
+
+            if (!isAble)
+            {
+              continue;
+            }
+
+            // The active hole's mask as altered by the merge
+            Region mergedMask = holesMasksRegionVector[activeId];
+
+            if (operationId == AMALGAMATION)
+            {
+              HoleMerger::amalgamateOnce(&pair,
+                0,
+                &mergedMask,
+                holesMasksRegionVector[passiveId],
+                image);
+            }
+            else if (operationId == CONNECTION)
+            {
+              HoleMerger::connectOnce(&pair,
+                0, 1,
+                &mergedMask,
+                image);
+            }
+
+            pair.holes.pop_back();
+
+            if (validate && !isMergeValid(pair, mergedMask, image))
+            {
+              continue;
+            }
+
+            // The passive hole is gone
+            isMerged[passiveId] = 1;
+            grid.remove(passiveId);
+            unboxed.erase(
+              std::remove(unboxed.begin(), unboxed.end(), passiveId),
+              unboxed.end());
+
+            // An assimilator stays as it was
+            if (operationId != ASSIMILATION)
+            {
+              holes[activeId] = pair.holes[0];
+
+              // Regenerate the mask from the new outline
+              std::vector<Region> activeMask;
+              FiltersResources::createHolesMasksRegionVector(
+                pair,
+                image,
+                &activeMask);
+              holesMasksRegionVector[activeId] = activeMask[0];
+
+              hasBox[activeId] = holeBox(holes[activeId],
+                holesMasksRegionVector[activeId], pointCloud, operationId,
+                &boxes[activeId]);
+
+              if (hasBox[activeId])
+              {
+                grid.insert(activeId, boxes[activeId]);
+              }
+              else
+              {
+                grid.remove(activeId);
+              }
+            }
+
+            hasMerged = true;
+          }
+        }
+      }
+
+      // Keep the holes that were not merged into others, in their order
+      int numKept = 0;
+      for (int i = 0; i < numHoles; i++)
+      {
+        if (!isMerged[i])
+        {
+          if (numKept != i)
+          {
+            holes[numKept] = holes[i];
+          }
+          numKept++;
+        }
+      }
+      holes.resize(numKept);
+    }
+  }  // namespace
+
+
+
   /**
     @brief Intended to use after the check of the
     isCapableOfAmalgamating function, this function modifies the
@@ -60,11 +446,11 @@ namespace hole_fusion
     amalgamation, only the internals of the amalgamator are modified
     @param[in] amalgamatorId [const int&] The identifier of the
     hole inside the HolesConveyor amalgamator struct
-    @param[in,out] amalgamatorHoleMaskSet [std::set<unsigned int>*]
-    A set that includes the indices of points inside the amalgamator's
+    @param[in,out] amalgamatorHoleMaskRegion [Region*]
+    A region that includes the points inside the amalgamator's
     outline
-    @param[in] amalgamatableHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the amalgamatable's
+    @param[in] amalgamatableHoleMaskRegion [const Region&]
+    A region that includes the points inside the amalgamatable's
     outline
     @param[in] image [const cv::Mat&] An image used for its size
     @return void
@@ -72,13 +458,11 @@ namespace hole_fusion
   void HoleMerger::amalgamateOnce(
     HolesConveyor* conveyor,
     const int& amalgamatorId,
-    std::set<unsigned int>* amalgamatorHoleMaskSet,
-    const std::set<unsigned int>& amalgamatableHoleMaskSet,
+    Region* amalgamatorHoleMaskRegion,
+    const Region& amalgamatableHoleMaskRegion,
     const cv::Mat& image)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("amalgamateOnce", "applyMergeOperation");
-    #endif
+    PROFILE_SCOPE("amalgamateOnce", "applyMergeOperation");
 
 
     // Now, we need to find the combined outline points
@@ -87,24 +471,12 @@ namespace hole_fusion
     // obtain the new outline points
     cv::Mat canvas = cv::Mat::zeros(image.size(), CV_8UC1);
 
-    unsigned char* ptr = canvas.ptr();
+    // The amalgamator's new hole mask is the union of the two masks
+    *amalgamatorHoleMaskRegion =
+      amalgamatorHoleMaskRegion->unite(amalgamatableHoleMaskRegion);
 
-    // Draw the amalgamator's mask onto canvas
-    for (std::set<unsigned int>::iterator it = amalgamatorHoleMaskSet->begin();
-      it != amalgamatorHoleMaskSet->end(); it++)
-    {
-      ptr[*it] = 255;
-    }
-
-    // Draw the amalgamatable's mask onto canvas
-    for (std::set<unsigned int>::iterator it = amalgamatableHoleMaskSet.begin();
-      it != amalgamatableHoleMaskSet.end(); it++)
-    {
-      ptr[*it] = 255;
-
-      // In the meantime, construct the amalgamator's new hole set
-      amalgamatorHoleMaskSet->insert(*it);
-    }
+    // Draw it onto canvas
+    amalgamatorHoleMaskRegion->toMask(&canvas);
 
 
     // Locate the outline of the combined hole
@@ -153,10 +525,6 @@ namespace hole_fusion
 
     conveyor->holes[amalgamatorId].keypoint.pt.x = x / 4;
     conveyor->holes[amalgamatorId].keypoint.pt.y = y / 4;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("amalgamateOnce");
-    #endif
   }
 
 
@@ -170,7 +538,7 @@ namespace hole_fusion
     candidate holes conveyor
     @param[in] image [const cv::Mat&] An image used for filters' resources
     creation and size usage
-    @param[in] pointCloud [const PointCloudPtr] An interpolated point
+    @param[in] pointCloud [const PointCloudConstPtr] An interpolated point
     cloud used in the connection operation; it is used to obtain real world
     distances between holes
     @param[in] operationId [const int&] The identifier of the merging
@@ -181,12 +549,10 @@ namespace hole_fusion
   void HoleMerger::applyMergeOperation(
     HolesConveyor* rgbdHolesConveyor,
     const cv::Mat& image,
-    const PointCloudPtr& pointCloud,
+    const PointCloudConstPtr& pointCloud,
     const int& operationId)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("applyMergeOperation", "mergeHoles");
-    #endif
+    PROFILE_SCOPE("applyMergeOperation", "mergeHoles");
 
     // If there are no candidate holes,
     // or there is only one candidate hole,
@@ -196,293 +562,9 @@ namespace hole_fusion
       return;
     }
 
-    // A vector that indicates when a specific hole has finished
-    // examining all the other holes in the conveyor for merging.
-    // Initialized at 0 for all conveyor entries, the specific hole
-    // that corresponds to a vector's entry is given a 1 when it has
-    // finished examining all other holes.
-    std::vector<int> finishVector(rgbdHolesConveyor->size(), 0);
-
-    // The index of the candidate hole that will
-    // {assimilate, amalgamate, connect} the passiveId-th candidate hole.
-    // The activeId always has a value of 0 due to the implementation's
-    // rationale: The candidate hole that examines each hole in the
-    // rgbdHolesConveyor is always the first one. When it has finished,
-    // it goes back into the rgbdHolesConveyor, at the last position
-    const int activeId = 0;
-
-    // The index of the candidate hole that will be
-    // {assimilated, amalgamated, connected} by / with
-    // the activeId-th candidate hole
-    int passiveId = 1;
-
-    // Is the activeId-th candidate hole able to
-    // {assimilate, amalgamate, connect to} the passiveId-th candidate hole?
-    bool isAble = true;
-
-    // The holesMaskSetVector vector is used in the merging processes
-    std::vector<std::set<unsigned int> > holesMasksSetVector;
-
-    // Indicates the end of the merging process
-    bool isFuseComplete = false;
-
-    while (!isFuseComplete)
-    {
-      // If a(n) {assimilation, amalgamation, connection} did happen,
-      // regenerate the mask sets in order for them to reflect the new
-      // state of holes
-      if (isAble)
-      {
-        FiltersResources::createHolesMasksSetVector(
-          *rgbdHolesConveyor,
-          image,
-          &holesMasksSetVector);
-      }
-
-
-      if (operationId == ASSIMILATION)
-      {
-        // Is the activeId-th candidate hole able to assimilate the
-        // passiveId-th candidate hole?
-        isAble = isCapableOfAssimilating(
-          holesMasksSetVector[activeId],
-          holesMasksSetVector[passiveId]);
-      }
-
-      if (operationId == AMALGAMATION)
-      {
-        // Is the activeId-th candidate hole able to amalgamate the
-        // passiveId-th candidate hole?
-        isAble = isCapableOfAmalgamating(
-          holesMasksSetVector[activeId],
-          holesMasksSetVector[passiveId]);
-      }
-
-      if (operationId == CONNECTION)
-      {
-        // Is the passiveId-th candidate hole able to be connected with the
-        // activeId-th candidate hole?
-        isAble = isCapableOfConnecting(*rgbdHolesConveyor,
-          activeId,
-          passiveId,
-          holesMasksSetVector[activeId],
-          holesMasksSetVector[passiveId],
-          pointCloud);
-      }
-
-
-      if (isAble)
-      {
-        // Copy the original holes conveyor to a temp one.
-        // The temp one will be tested through the hole filters
-        // On success, temp will replace rgbdHolesConveyor,
-        // on failure, rgbdHolesConveyor will remain unchanged
-        HolesConveyor tempHolesConveyor;
-        HolesConveyorUtils::copyTo(*rgbdHolesConveyor, &tempHolesConveyor);
-
-        // Copy the original holes masks set to a temp one.
-        // If the temp conveyor is tested successfully through the hole
-        // filters, temp will replace the original.
-        // On failure, the original will remain unchanged
-        std::vector<std::set<unsigned int> > tempHolesMasksSetVector;
-        tempHolesMasksSetVector = holesMasksSetVector;
-
-        if (operationId == ASSIMILATION)
-        {
-          // Delete the passiveId-th candidate hole
-          HolesConveyorUtils::removeHole(&tempHolesConveyor, passiveId);
-        }
-        else if (operationId == AMALGAMATION)
-        {
-          // Delete the passiveId-th candidate hole,
-          // alter the activeId-th candidate hole so that it has amalgamated
-          // the passiveId-th candidate hole
-          amalgamateOnce(&tempHolesConveyor,
-            activeId,
-            &tempHolesMasksSetVector[activeId],
-            tempHolesMasksSetVector[passiveId],
-            image);
-
-          HolesConveyorUtils::removeHole(&tempHolesConveyor, passiveId);
-        }
-        else if (operationId == CONNECTION)
-        {
-          // Delete the passiveId-th candidate hole,
-          // alter the activeId-th candidate hole so that it has been
-          // connected with the passiveId -th candidate hole
-          connectOnce(&tempHolesConveyor,
-            activeId, passiveId,
-            &tempHolesMasksSetVector[activeId],
-            image);
-
-          HolesConveyorUtils::removeHole(&tempHolesConveyor, passiveId);
-        }
-
-
-        // Since the {assimilator, amalgamator, connector} is able,
-        // delete the assimilable's entries in the vectors needed
-        // for filtering and merging
-        tempHolesMasksSetVector.erase(
-          tempHolesMasksSetVector.begin() + passiveId);
-
-
-        // Obtain the activeId-th candidate hole in order for it
-        // to be checked against the selected filters
-        HolesConveyor ithHole =
-          HolesConveyorUtils::getHole(tempHolesConveyor, activeId);
-
-        // Create the necessary vectors for each hole checker and
-        // merger used
-        std::vector<cv::Mat> imgs;
-        std::vector<std::string> msgs;
-        std::vector<std::vector<cv::Point2f> > rectanglesVector;
-        std::vector<int> rectanglesIndices;
-        std::vector<std::set<unsigned int> > intermediatePointsSetVector;
-
-        // The inflated rectangles vector is used in the
-        // checkHolesDepthDiff and checkHolesRectangleEdgesPlaneConstitution
-        // checkers
-        FiltersResources::createInflatedRectanglesVector(
-          ithHole,
-          image,
-          Parameters::HoleFusion::rectangle_inflation_size,
-          &rectanglesVector,
-          &rectanglesIndices);
-
-        // The vector of depth-filters-derived probabilities
-        std::vector<std::vector<float> >probabilitiesVector(
-          2,
-          std::vector<float>(1, 0.0));
-
-        // Check the difference between the mean depth of the
-        // vertices of the merged hole's bounding box and the depth of the
-        // merged hole's keypoint
-        DepthFilters::checkHolesDepthDiff(
-          image,
-          ithHole,
-          rectanglesVector,
-          rectanglesIndices,
-          &msgs,
-          &probabilitiesVector.at(0));
-
-        // The probability that the merged hole is valid by the above filter
-        float dd = probabilitiesVector[0][0];
-
-
-        // Check the depth / area proportion for the ithHole
-        DepthFilters::checkHolesDepthArea(
-          ithHole,
-          image,
-          tempHolesMasksSetVector,
-          &msgs,
-          &probabilitiesVector.at(1));
-
-        // The probability that the merged hole is valid by the above filter
-        float da = probabilitiesVector[1][0];
-
-
-        // Probabilities threshold for merge acceptance.
-        // In the assimilation operation, the temp conveyor unconditionally
-        // replaces the original conveyor
-        if ((dd >= Parameters::HoleFusion::Merger::depth_diff_threshold
-          && da >= Parameters::HoleFusion::Merger::depth_area_threshold))
-        {
-          // Since the tempHolesConveyor's ithHole has been positively tested,
-          // the tempHolesConveyor is now the new rgbdHolesConveyor
-          HolesConveyorUtils::replace(tempHolesConveyor, rgbdHolesConveyor);
-
-          // ..and the new holesMasksSetVector is the positively tested
-          // temp one
-          holesMasksSetVector = tempHolesMasksSetVector;
-
-          // Delete the passiveId-th entry of the finishVector since the
-          // passiveId-th hole has been absorbed by the activeId-th hole
-          finishVector.erase(finishVector.begin() + passiveId);
-
-          // Because of the merge happening, the activeId-th
-          // candidate hole must re-examine all the other holes
-          passiveId = 1;
-        }
-        else  // rgbdHolesConveyor remains unchanged
-        {
-          // passiveId-th hole not merged. let's see about the next one
-          passiveId++;
-        }
-      }
-      else  // isAble == false
-      {
-        // passiveId-th hole not merged. let's see about the next one
-        passiveId++;
-      }
-
-      // If the passiveId-th hole was the last one to be checked for merge,
-      // the one doing the merge is rendered obsolete, so go to the next one
-      // by moving the current activeId-th candidate hole to the back
-      // of the rgbdHolesConveyor. This way the new activeId-th candidate
-      // hole still has a value of 0, but now points to the candidate hole
-      // next to the one that was moved back
-      if (passiveId >= rgbdHolesConveyor->size())
-      {
-        // No meaning moving to the back of the rgbdHolesConveyor if
-        // there is only one candidate hole
-        if (rgbdHolesConveyor->size() > 1)
-        {
-          // activeId-th hole candidate finished examining the rest of the
-          // hole candidates. move it to the back of the rgbdHolesConveyor
-          HolesConveyorUtils::append(
-            HolesConveyorUtils::getHole(*rgbdHolesConveyor, activeId),
-            rgbdHolesConveyor);
-
-          // Remove the activeId-th candidate hole from its former position
-          HolesConveyorUtils::removeHole(rgbdHolesConveyor, activeId);
-
-          // Remove the activeId-th set from its position and append it
-          holesMasksSetVector.push_back(holesMasksSetVector[activeId]);
-          holesMasksSetVector.erase(holesMasksSetVector.begin() + activeId);
-
-          // Since the candidate hole was appended at the end of the
-          // rgbdHolesConveyor, the finish vector needs to be shifted
-          // once to the left because the value 1 is always set at the end
-          // of the finishVector vector. See below.
-          std::rotate(finishVector.begin(), finishVector.begin() + 1,
-            finishVector.end());
-
-          // Return the passive's candidate hole identifier to the
-          // next of the active's candidate hole identifier, which is 0
-          passiveId = 1;
-        }
-
-        // Since the ith candidate hole was appended at the end of the
-        // rgbdHolesConveyor, the position to which it corresponds in the
-        // finishVector is at the end of the vector.
-        // Place the value of 1 in the last position, indicating that the
-        // previously activeId-th candidate hole has finished examining all
-        // other candidate holes for merging
-        std::vector<int>::iterator finishVectorIterator =
-          finishVector.end() - 1;
-
-        *finishVectorIterator = 1;
-
-        // Count how many aces there are in the finishVector
-        // If they amount to the size of the vector, that means that
-        // each hole has finished examining the others, and the current
-        // operation is complete
-        int numAces = 0;
-        for (int i = 0; i < finishVector.size(); i++)
-        {
-          numAces += finishVector[i];
-        }
-
-        if (numAces == finishVector.size())
-        {
-          isFuseComplete = true;
-        }
-      }
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyMergeOperation");
-    #endif
+    // Every merge is validated through the depth filters
+    mergeIndexedHoles(rgbdHolesConveyor, image, pointCloud, operationId,
+      true);
   }
 
 
@@ -507,203 +589,20 @@ namespace hole_fusion
     const cv::Mat& image,
     const int& operationId)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("applyMergeOperation", "mergeHoles");
-    #endif
+    PROFILE_SCOPE("applyMergeOperation", "mergeHoles");
 
     // If there are no candidate holes,
     // or there is only one candidate hole,
-    // there is no meaning to this operation
-    if (rgbdHolesConveyor->size() < 2)
+    // there is no meaning to this operation.
+    // Without a point cloud holes can not be connected
+    if (rgbdHolesConveyor->size() < 2
+      || (operationId != ASSIMILATION && operationId != AMALGAMATION))
     {
       return;
     }
 
-    // A vector that indicates when a specific hole has finished
-    // examining all the other holes in the conveyor for merging.
-    // Initialized at 0 for all conveyor entries, the specific hole
-    // that corresponds to a vector's entry is given a 1 when it has
-    // finished examining all other holes.
-    std::vector<int> finishVector(rgbdHolesConveyor->size(), 0);
-
-    // The index of the candidate hole that will
-    // {assimilate, amalgamate} the passiveId-th candidate hole.
-    // The activeId always has a value of 0 due to the implementation's
-    // rationale: The candidate hole that examines each hole in the
-    // rgbdHolesConveyor is always the first one. When it has finished,
-    // it goes back into the rgbdHolesConveyor, at the last position
-    const int activeId = 0;
-
-    // The index of the candidate hole that will be
-    // {assimilated, amalgamated} by / with
-    // the activeId-th candidate hole
-    int passiveId = 1;
-
-    bool isFuseComplete = false;
-    while (!isFuseComplete)
-    {
-      // The holesMaskSetVector vector is used in the merging processes
-      std::vector<std::set<unsigned int> > holesMasksSetVector;
-      FiltersResources::createHolesMasksSetVector(
-        *rgbdHolesConveyor,
-        image,
-        &holesMasksSetVector);
-
-
-      // Is the activeId-th candidate hole able to
-      // {assimilate, amalgamate} the passiveId-th candidate hole?
-      bool isAble = false;
-
-      if (operationId == ASSIMILATION)
-      {
-        // Is the activeId-th candidate hole able to assimilate the
-        // passiveId-th candidate hole?
-        isAble = isCapableOfAssimilating(
-          holesMasksSetVector[activeId],
-          holesMasksSetVector[passiveId]);
-      }
-      if (operationId == AMALGAMATION)
-      {
-        // Is the activeId-th candidate hole able to amalgamate the
-        // passiveId-th candidate hole?
-        isAble = isCapableOfAmalgamating(
-          holesMasksSetVector[activeId],
-          holesMasksSetVector[passiveId]);
-      }
-
-      if (isAble)
-      {
-        // Copy the original holes conveyor to a temp one.
-        // The temp one will be tested through the hole filters
-        // On success, temp will replace rgbdHolesConveyor,
-        // on failure, rgbdHolesConveyor will remain unchanged
-        HolesConveyor tempHolesConveyor;
-        HolesConveyorUtils::copyTo(*rgbdHolesConveyor, &tempHolesConveyor);
-
-        // Copy the original holes masks set to a temp one.
-        // If the temp conveyor is tested successfully through the hole
-        // filters, temp will replace the original.
-        // On failure, the original will remain unchanged
-        std::vector<std::set<unsigned int> > tempHolesMasksSetVector;
-        tempHolesMasksSetVector = holesMasksSetVector;
-
-        if (operationId == ASSIMILATION)
-        {
-          // Delete the passiveId-th candidate hole
-          HolesConveyorUtils::removeHole(&tempHolesConveyor, passiveId);
-        }
-        else if (operationId == AMALGAMATION)
-        {
-          // Delete the passiveId-th candidate hole,
-          // alter the activeId-th candidate hole so that it has amalgamated
-          // the passiveId-th candidate hole
-          amalgamateOnce(&tempHolesConveyor,
-            activeId,
-            &tempHolesMasksSetVector[activeId],
-            tempHolesMasksSetVector[passiveId],
-            image);
-
-          HolesConveyorUtils::removeHole(&tempHolesConveyor, passiveId);
-        }
-
-        // Since the {assimilator, amalgamator} is able,
-        // delete the assimilable's entries in the vectors needed
-        // for filtering and merging
-        tempHolesMasksSetVector.erase(
-          tempHolesMasksSetVector.begin() + passiveId);
-
-        // Since the merge has been uncondionally happened,
-        // the tempHolesConveyor is now the new rgbdHolesConveyor
-        HolesConveyorUtils::replace(tempHolesConveyor, rgbdHolesConveyor);
-
-        // ..and the new holesMasksSetVector is the positively tested
-        // temp one
-        holesMasksSetVector = tempHolesMasksSetVector;
-
-        // Delete the passiveId-th entry of the finishVector since the
-        // passiveId-th hole has been absorbed by the activeId-th hole
-        finishVector.erase(finishVector.begin() + passiveId);
-
-        // Because of the merge happening, the activeId-th
-        // candidate hole must re-examine all the other holes
-        passiveId = 1;
-      }
-      else  // isAble == false
-      {
-        // passiveId-th hole not merged. let's see about the next one
-        passiveId++;
-      }
-
-      // If the passiveId-th hole was the last one to be checked for merge,
-      // the one doing the merge is rendered obsolete, so go to the next one
-      // by moving the current activeId-th candidate hole to the back
-      // of the rgbdHolesConveyor. This way the new activeId-th candidate
-      // hole still has a value of 0, but now points to the candidate hole
-      // next to the one that was moved back
-      if (passiveId >= rgbdHolesConveyor->size())
-      {
-        // No meaning moving to the back of the rgbdHolesConveyor if
-        // there is only one candidate hole
-        if (rgbdHolesConveyor->size() > 1)
-        {
-          // activeId-th hole candidate finished examining the rest of the
-          // hole candidates. move it to the back of the rgbdHolesConveyor
-          HolesConveyorUtils::append(
-            HolesConveyorUtils::getHole(*rgbdHolesConveyor, activeId),
-            rgbdHolesConveyor);
-
-          // Remove the activeId-th candidate hole from its former position
-          HolesConveyorUtils::removeHole(rgbdHolesConveyor, activeId);
-
-
-          // Remove the activeId-th set from its position and append it
-          holesMasksSetVector.push_back(holesMasksSetVector[activeId]);
-          holesMasksSetVector.erase(holesMasksSetVector.begin() + activeId);
-
-
-          // Since the candidate hole was appended at the end of the
-          // rgbdHolesConveyor, the finish vector needs to be shifted
-          // once to the left because the value 1 is always set at the end
-          // of the finishVector vector. See below.
-          std::rotate(finishVector.begin(), finishVector.begin() + 1,
-            finishVector.end());
-
-          // Return the passive's candidate hole identifier to the
-          // next of the active's candidate hole identifier, which is 0
-          passiveId = 1;
-        }
-
-        // Since the ith candidate hole was appended at the end of the
-        // rgbdHolesConveyor, the position to which it corresponds in the
-        // finishVector is at the end of the vector.
-        // Place the value of 1 in the last position, indicating that the
-        // previously activeId-th candidate hole has finished examining all
-        // other candidate holes for merging
-        std::vector<int>::iterator finishVectorIterator =
-          finishVector.end() - 1;
-
-        *finishVectorIterator = 1;
-
-        // Count how many aces there are in the finishVector
-        // If they amount to the size of the vector, that means that
-        // each hole has finished examining the others, and the current
-        // operation is complete
-        int numAces = 0;
-        for (int i = 0; i < finishVector.size(); i++)
-        {
-          numAces += finishVector[i];
-        }
-
-        if (numAces == finishVector.size())
-        {
-          isFuseComplete = true;
-        }
-      }
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyMergeOperation");
-    #endif
+    mergeIndexedHoles(rgbdHolesConveyor, image, PointCloudConstPtr(),
+      operationId, false);
   }
 
 
@@ -722,8 +621,8 @@ namespace hole_fusion
     the HolesConveyor connectables struct
     @param[in] connectableId [const int&] The identifier of the hole inside
     the HolesConveyor connectables struct
-    @param[in] connectorHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the connector's
+    @param[in] connectorHoleMaskRegion [const Region&]
+    A region that includes the points inside the connector's
     outline
     @param[in] image [const cv::Mat&] An image required only for its size
     @return void
@@ -732,12 +631,10 @@ namespace hole_fusion
     HolesConveyor* conveyor,
     const int& connectorId,
     const int& connectableId,
-    std::set<unsigned int>* connectorHoleMaskSet,
+    Region* connectorHoleMaskRegion,
     const cv::Mat& image)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("connectOnce", "applyMergeOperation");
-    #endif
+    PROFILE_SCOPE("connectOnce", "applyMergeOperation");
 
     // The connection rationale is as follows:
     // Since the two holes are not overlapping each other,
@@ -749,7 +646,6 @@ namespace hole_fusion
 
     // The image on which the hole's outline connection will be drawn
     cv::Mat canvas = cv::Mat::zeros(image.size(), CV_8UC1);
-    unsigned char* ptr = canvas.ptr();
 
     for (int i = 0; i < conveyor->holes[connectorId].outline.size(); i++)
     {
@@ -762,23 +658,8 @@ namespace hole_fusion
       }
     }
 
-    // Construct the connector's new hole mask
-    // First, clear the former one
-    connectorHoleMaskSet->erase(
-      connectorHoleMaskSet->begin(),
-      connectorHoleMaskSet->end());
-
-    for (int rows = 0; rows < canvas.rows; rows++)
-    {
-      for (int cols = 0; cols < canvas.cols; cols++)
-      {
-        unsigned int ind = cols + rows * image.cols;
-        if (ptr[ind] != 0)
-        {
-          connectorHoleMaskSet->insert(ptr[ind]);
-        }
-      }
-    }
+    // Construct the connector's new hole mask, replacing the former one
+    *connectorHoleMaskRegion = Region::fromMask(canvas);
 
 
     // Locate the outline of the combined hole
@@ -825,10 +706,6 @@ namespace hole_fusion
     conveyor->holes[connectorId].keypoint.pt.y =
       (conveyor->holes[connectorId].keypoint.pt.y
        + conveyor->holes[connectableId].keypoint.pt.y) / 2;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("connectOnce");
-    #endif
   }
 
 
@@ -841,58 +718,40 @@ namespace hole_fusion
     points intersect with the amalgamator's outline, but not in their
     entirety, and the area of the amalgamator is larger than the area
     of the amalgamatable
-    @param[in] amalgamatorHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the amalgamator's
+    @param[in] amalgamatorHoleMaskRegion [const Region&]
+    A region that includes the points inside the amalgamator's
     outline
-    @param[in] amalgamatableHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the amalgamatable's
+    @param[in] amalgamatableHoleMaskRegion [const Region&]
+    A region that includes the points inside the amalgamatable's
     outline
     @return [bool] True if the amalgamator is capable of amalgamating
     the amalgamatable
    **/
   bool HoleMerger::isCapableOfAmalgamating(
-    const std::set<unsigned int>& amalgamatorHoleMaskSet,
-    const std::set<unsigned int>& amalgamatableHoleMaskSet)
+    const Region& amalgamatorHoleMaskRegion,
+    const Region& amalgamatableHoleMaskRegion)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("isCapableOfAmalgamating", "applyMergeOperation");
-    #endif
+    PROFILE_SCOPE("isCapableOfAmalgamating", "applyMergeOperation");
 
     // If the amalgatamable's area is larger than the amalgamator's,
     // this amalgamator is not capable of amalgamating the amalgamatable
-    if (amalgamatorHoleMaskSet.size() < amalgamatableHoleMaskSet.size())
+    if (amalgamatorHoleMaskRegion.area() < amalgamatableHoleMaskRegion.area())
     {
       return false;
     }
 
-    // Keep the size of the input assimilatorHoleMaskSet for
-    // comparing against it
-    int amalgamatorHoleMaskSetSize = amalgamatorHoleMaskSet.size();
-
-    // Clone the amalgamator's hole mask set.
-    std::set<unsigned int> summation = amalgamatorHoleMaskSet;
+    // The number of points the two holes have in common
+    int overlap =
+      amalgamatorHoleMaskRegion.intersectionArea(amalgamatableHoleMaskRegion);
 
-    // Try to insert every element of the amalgamatable hole mask set into
-    // the amalgamator's set.
     // This amalgamator can amalgamate the amalgamatable if and only if the
     // amalgamatable is not entirely inside the amalgamator or
     // the amalgamatable and the amalgamator are not not connected
-    for (std::set<unsigned int>::iterator it = amalgamatableHoleMaskSet.begin();
-      it != amalgamatableHoleMaskSet.end(); it++)
-    {
-      summation.insert(*it);
-    }
-
-    if ((summation.size() == amalgamatorHoleMaskSetSize) || (summation.size() ==
-          amalgamatorHoleMaskSetSize + amalgamatableHoleMaskSet.size()))
+    if (overlap == amalgamatableHoleMaskRegion.area() || overlap == 0)
     {
       return false;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("isCapableOfAmalgamating");
-    #endif
-
     return true;
   }
 
@@ -903,58 +762,37 @@ namespace hole_fusion
     is capable of assimilating another hole assigned the role of
     the assimilable. It checks whether the assimilable's outline
     points reside entirely inside the assimilator's outline.
-    @param[in] assimilatorHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the assimilator's
+    @param[in] assimilatorHoleMaskRegion [const Region&]
+    A region that includes the points inside the assimilator's
     outline
-    @param[in] assimilableHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the assimilable's
+    @param[in] assimilableHoleMaskRegion [const Region&]
+    A region that includes the points inside the assimilable's
     outline
     @return [bool] True if all of the outline points of the assimilable
     hole are inside the outline of the assimilator
    **/
   bool HoleMerger::isCapableOfAssimilating(
-    const std::set<unsigned int>& assimilatorHoleMaskSet,
-    const std::set<unsigned int>& assimilableHoleMaskSet)
+    const Region& assimilatorHoleMaskRegion,
+    const Region& assimilableHoleMaskRegion)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("isCapableOfAssimilating", "applyMergeOperation");
-    #endif
+    PROFILE_SCOPE("isCapableOfAssimilating", "applyMergeOperation");
 
     // If the assimilable's area is larger than the assimilator's,
     // this assimilator is not capable of assimilating the assimilatable
-    if (assimilatorHoleMaskSet.size() < assimilableHoleMaskSet.size())
+    if (assimilatorHoleMaskRegion.area() < assimilableHoleMaskRegion.area())
     {
       return false;
     }
 
-    // Keep the size of the input assimilatorHoleMaskSet for
-    // comparing against it
-    int assimilatorHoleMaskSetSize = assimilatorHoleMaskSet.size();
-
-    // Clone the assimilator's hole mask set.
-    std::set<unsigned int> summation = assimilatorHoleMaskSet;
-
-    // Try to insert every element of the assimilable hole mask set into
-    // the assimilator's set.
     // This assimilator can assimilate the assimilable if and only if the
-    // assimilable is inside the assimilator, in other words, if the
-    // assimilator's hole mask set size remains unchanged after the
-    // insertion of the assimilable's elements into it
-    for (std::set<unsigned int>::iterator it = assimilableHoleMaskSet.begin();
-      it != assimilableHoleMaskSet.end(); it++)
+    // assimilable is inside the assimilator, in other words, if all of the
+    // assimilable's points are common to the two holes
+    if (assimilatorHoleMaskRegion.intersectionArea(assimilableHoleMaskRegion)
+      != assimilableHoleMaskRegion.area())
     {
-      summation.insert(*it);
-
-      if (summation.size () != assimilatorHoleMaskSetSize)
-      {
-        return false;
-      }
+      return false;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("isCapableOfAssimilating");
-    #endif
-
     return true;
   }
 
@@ -975,13 +813,13 @@ namespace hole_fusion
     that acts as the connector inside the connectors HolesConveyor
     @param[in] connectableId [const int&] The index of the specific hole
     that acts as the connectable inside the connectables HolesConveyor
-    @param[in] connectorHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the connector's
+    @param[in] connectorHoleMaskRegion [const Region&]
+    A region that includes the points inside the connector's
     outline
-    @param[in] connectableHoleMaskSet [const std::set<unsigned int>&]
-    A set that includes the indices of points inside the connectable's
+    @param[in] connectableHoleMaskRegion [const Region&]
+    A region that includes the points inside the connectable's
     outline
-    @param[in] pointCloud [const PointCloudPtr&] The point cloud
+    @param[in] pointCloud [const PointCloudConstPtr&] The point cloud
     obtained from the depth sensor, used to measure distances in real
     space
     @return [bool] True if the connectable is capable of being connected
@@ -991,40 +829,24 @@ namespace hole_fusion
     const HolesConveyor& conveyor,
     const int& connectorId,
     const int& connectableId,
-    const std::set<unsigned int>& connectorHoleMaskSet,
-    const std::set<unsigned int>& connectableHoleMaskSet,
-    const PointCloudPtr& pointCloud)
+    const Region& connectorHoleMaskRegion,
+    const Region& connectableHoleMaskRegion,
+    const PointCloudConstPtr& pointCloud)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("isCapableOfConnecting", "applyMergeOperation");
-    #endif
+    PROFILE_SCOPE("isCapableOfConnecting", "applyMergeOperation");
 
     // If the connectable's area is greater than the connector's,
     // this connectable is not capable of being connected with the connector
-    if (connectorHoleMaskSet.size() < connectableHoleMaskSet.size())
+    if (connectorHoleMaskRegion.area() < connectableHoleMaskRegion.area())
     {
       return false;
     }
 
-    // Keep the size of the input assimilatorHoleMaskSet for
-    // comparing against it
-    int connectorHoleMaskSetSize = connectorHoleMaskSet.size();
-
-    // Clone the connector's hole mask set.
-    std::set<unsigned int> summation = connectorHoleMaskSet;
-
-    // Try to insert every element of the assimilable hole mask set into
-    // the connector's set.
     // This connectable can be connected with the connector if and only if the
-    // connectable is outside of the connector
-    for (std::set<unsigned int>::iterator it = connectableHoleMaskSet.begin();
-      it != connectableHoleMaskSet.end(); it++)
-    {
-      summation.insert(*it);
-    }
-
-    if (summation.size () !=
-      (connectorHoleMaskSetSize + connectableHoleMaskSet.size()))
+    // connectable is outside of the connector, in other words, if the two
+    // holes have no points in common
+    if (connectorHoleMaskRegion.intersectionArea(connectableHoleMaskRegion)
+      != 0)
     {
       return false;
     }
@@ -1116,10 +938,6 @@ namespace hole_fusion
     }
 
 
-    #ifdef DEBUG_TIME
-    Timer::tick("isCapableOfConnecting");
-    #endif
-
     return true;
   }
 
@@ -1145,18 +963,16 @@ namespace hole_fusion
     not possible, and so merges will happen unconditionally.
     @param[in] interpolatedDepthImage [const cv::Mat&]
     The interpolated depth image
-    @param[in] pointCloud [const PointCloudPtr&]
+    @param[in] pointCloud [const PointCloudConstPtr&]
     The interpolated point cloud. Needed in the connection process.
     @return void
    **/
   void HoleMerger::mergeHoles(HolesConveyor* conveyor,
     const int& filteringMethod,
     const cv::Mat& interpolatedDepthImage,
-    const PointCloudPtr& pointCloud)
+    const PointCloudConstPtr& pointCloud)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("mergeHoles", "processCandidateHoles");
-    #endif
+    PROFILE_SCOPE("mergeHoles", "processCandidateHoles");
 
     // Keep a copy of the initial (not merged) candidate holes for
     // debugging and exibition purposes
@@ -1246,10 +1062,6 @@ namespace hole_fusion
         canvases, titles, Parameters::Debug::show_merge_holes_size, 1);
     }
     #endif
-
-    #ifdef DEBUG_TIME
-    Timer::tick("mergeHoles");
-    #endif
   }
 
 }  // namespace hole_fusion
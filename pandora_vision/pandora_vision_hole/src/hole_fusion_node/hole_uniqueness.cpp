@@ -55,9 +55,7 @@ namespace hole_fusion
    **/
   void HoleUniqueness::makeHolesUnique(HolesConveyor* conveyor)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("makeHolesUniqueA", "processCandidateHoles");
-    #endif
+    PROFILE_SCOPE("makeHolesUniqueA", "processCandidateHoles");
 
     // A container in which one of every duplicate hole will be inserted
     HolesConveyor uniqueDuplicates;
@@ -140,10 +138,6 @@ namespace hole_fusion
 
     // Add one copy of each duplicate hole deleted to the conveyor container
     HolesConveyorUtils::append(uniqueDuplicates, conveyor);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("makeHolesUniqueA");
-    #endif
   }
 
 
@@ -169,9 +163,7 @@ namespace hole_fusion
   void HoleUniqueness::makeHolesUnique(HolesConveyor* conveyor,
     std::map<int, float>* validHolesMap)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("makeHolesUniqueB", "processCandidateHoles");
-    #endif
+    PROFILE_SCOPE("makeHolesUniqueB", "processCandidateHoles");
 
     // Each set inside the map refers a valid hole inside the conveyor conveyor.
     // The entries of each set are indices to valid holes inside
@@ -319,10 +311,6 @@ namespace hole_fusion
     // unique holes found.
     HolesConveyorUtils::replace(uniqueHoles, conveyor);
     *validHolesMap = finalMap;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("makeHolesUniqueB");
-    #endif
   }
 
 }  // namespace hole_fusion
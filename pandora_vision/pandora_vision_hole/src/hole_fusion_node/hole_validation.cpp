@@ -70,9 +70,7 @@ namespace hole_fusion
     const std::vector<std::vector<float> >& probabilitiesVector2D,
     const int& filteringMode)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("validateHoles", "processCandidateHoles");
-    #endif
+    PROFILE_SCOPE("validateHoles", "processCandidateHoles");
 
     // The map of holes' indices that are valid and
     // their respective validity probability that will be returned
@@ -110,10 +108,6 @@ namespace hole_fusion
         }
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("validateHoles");
-    #endif
-
     return valid;
   }
 
@@ -145,10 +139,8 @@ namespace hole_fusion
     const std::vector<std::vector<float> >& probabilitiesVector2D,
     const int& filteringMode)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("validateHolesViaThresholdedWeighting",
+    PROFILE_SCOPE("validateHolesViaThresholdedWeighting",
       "processCandidateHoles");
-    #endif
 
     // The map of holes' indices that are valid and
     // their respective validity probability that will be returned
@@ -440,10 +432,6 @@ namespace hole_fusion
       }
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("validateHolesViaThresholdedWeighting");
-    #endif
-
     return valid;
   }
 
@@ -470,9 +458,7 @@ namespace hole_fusion
     const std::vector<std::vector<float> >& probabilitiesVector2D,
     const int& filteringMode)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("validateHolesViaThresholding", "processCandidateHoles");
-    #endif
+    PROFILE_SCOPE("validateHolesViaThresholding", "processCandidateHoles");
 
     // The map of holes' indices that are valid and
     // their respective validity probability that will be returned
@@ -712,10 +698,6 @@ namespace hole_fusion
       }
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("validateHolesViaThresholding");
-    #endif
-
     // Return the valid set
     return valid;
   }
@@ -741,9 +723,7 @@ namespace hole_fusion
     const std::vector<std::vector<float> >& probabilitiesVector2D,
     const int& filteringMode)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("validateHolesViaWeighting", "validateHoles");
-    #endif
+    PROFILE_SCOPE("validateHolesViaWeighting", "validateHoles");
 
     // The map of holes' indices that are valid and
     // their respective validity probability that will be returned
@@ -928,13 +908,138 @@ namespace hole_fusion
       }
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("validateHolesViaWeighting");
-    #endif
-
     return valid;
   }
 
+
+
+
+  /**
+    @brief Tells whether a candidate hole is bound to be found invalid
+    by validateHoles, whatever the probabilities of the filters not yet
+    applied to it turn out to be. All probabilities are taken to be at
+    most 1. Filters that have not been applied yet need not be applied
+    to a hole for which this returns true
+    @param[in] probabilitiesVector2D
+    [const std::vector<std::vector<float> >&]
+    A two dimensional vector containing the probabilities of
+    validity of each candidate hole. Each row of it pertains to a specific
+    filter applied, in order of priority, each column to a particular hole
+    @param[in] filters [const std::vector<int>&] The identifiers of all
+    the active filters, in order of priority, as in Filters::applyFilter
+    @param[in] applied [const int&] The number of filters applied so far
+    @param[in] hole [const int&] The index of the candidate hole
+    @param[in] filteringMode [const int&] 0 for when Depth and RGB analysis
+    is applicable, 1 for when only RGB analysis is applicable
+    @return [bool] True if the candidate hole cannot be valid
+   **/
+  bool HoleValidation::isRejected(
+    const std::vector<std::vector<float> >& probabilitiesVector2D,
+    const std::vector<int>& filters,
+    const int& applied,
+    const int& hole,
+    const int& filteringMode)
+  {
+    int process = Parameters::HoleFusion::Validation::validation_process;
+
+    // Any probability below its filter's threshold invalidates the hole
+    if (process == VALIDATION_VIA_THRESHOLDING
+      || process == VALIDATION_VIA_THRESHOLDED_WEIGHTING)
+    {
+      for (int f = 0; f < applied; f++)
+      {
+        if (probabilitiesVector2D[f][hole] <
+          filterThreshold(filters[f], filteringMode))
+        {
+          return true;
+        }
+      }
+    }
+
+    // The weighted sum cannot exceed the one obtained if all filters not
+    // yet applied gave a probability of 1
+    if (process == VALIDATION_VIA_WEIGHTING
+      || process == VALIDATION_VIA_THRESHOLDED_WEIGHTING)
+    {
+      float threshold = 0.0;
+
+      if (filteringMode == RGBD_MODE)
+      {
+        threshold = Parameters::HoleFusion::Validation::rgbd_validity_threshold;
+      }
+      else if (filteringMode == RGB_ONLY_MODE)
+      {
+        threshold = Parameters::HoleFusion::Validation::rgb_validity_threshold;
+      }
+      else
+      {
+        return false;
+      }
+
+      double bound = 0.0;
+      for (int f = 0; f < filters.size(); f++)
+      {
+        bound += pow(2, f) * (f < applied ? probabilitiesVector2D[f][hole] : 1);
+      }
+      bound /= (pow(2, filters.size()) - 1);
+
+      // Leave a margin for the rounding of the single precision sum
+      // of validateHoles
+      if (bound + 1e-4 < threshold)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+
+
+  /**
+    @brief The threshold that the probability of a filter is compared
+    against, when validating via (thresholded weighting) thresholding
+    @param[in] filter [const int&] The identifier of the filter, as in
+    Filters::applyFilter
+    @param[in] filteringMode [const int&] 0 for when Depth and RGB analysis
+    is applicable, 1 for when only RGB analysis is applicable
+    @return [float] The threshold, 0 for an unknown filter
+   **/
+  float HoleValidation::filterThreshold(
+    const int& filter,
+    const int& filteringMode)
+  {
+    bool rgbd = filteringMode == RGBD_MODE;
+
+    switch (filter)
+    {
+      case 1 :
+        return rgbd ? Parameters::Filters::ColourHomogeneity::rgbd_threshold
+          : Parameters::Filters::ColourHomogeneity::rgb_threshold;
+      case 2 :
+        return rgbd ? Parameters::Filters::LuminosityDiff::rgbd_threshold
+          : Parameters::Filters::LuminosityDiff::rgb_threshold;
+      case 3 :
+        return rgbd ? Parameters::Filters::TextureDiff::rgbd_threshold
+          : Parameters::Filters::TextureDiff::rgb_threshold;
+      case 4 :
+        return rgbd ? Parameters::Filters::TextureBackprojection::rgbd_threshold
+          : Parameters::Filters::TextureBackprojection::rgb_threshold;
+      case 5 :
+        return Parameters::Filters::DepthDiff::threshold;
+      case 6 :
+        return Parameters::Filters::RectanglePlaneConstitution::threshold;
+      case 7 :
+        return Parameters::Filters::DepthArea::threshold;
+      case 8 :
+        return Parameters::Filters::IntermediatePointsPlaneConstitution::threshold;
+      case 9 :
+        return Parameters::Filters::DepthHomogeneity::threshold;
+      default :
+        return 0.0;
+    }
+  }
+
 }  // namespace hole_fusion
 }  // namespace pandora_vision_hole
 }  // namespace pandora_vision
@@ -0,0 +1,290 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include "hole_fusion_node/hole_workers.h"
+#include <algorithm>
+#include <exception>
+#include <boost/bind.hpp>
+#include "hole_fusion_node/utils/defines.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  namespace
+  {
+    /**
+      @brief Runs the task of an index, keeping a failing task from taking
+      down the thread that runs it
+      @param task [const HoleWorkers::Task&] The task
+      @param index [int] The index
+      @return void
+     **/
+    void runTask(const HoleWorkers::Task& task, int index)
+    {
+      try
+      {
+        task(index);
+      }
+      catch (const std::exception& e)
+      {
+        ROS_ERROR_NAMED(PKG_NAME,
+          "[Hole Fusion node] Hole task %d failed: %s", index, e.what());
+      }
+    }
+
+    /**
+      @brief Runs the task of the entry a task index stands for
+      @param task [const HoleWorkers::EntryTask&] The task of each entry
+      @param entries [const std::vector<int>&] The entries to run
+      @param msgs [std::vector<std::string>*] The messages of all entries
+      @param index [int] The task index
+      @return void
+     **/
+    void runEntry(const HoleWorkers::EntryTask& task,
+      const std::vector<int>& entries, std::vector<std::string>* msgs,
+      int index)
+    {
+      task(entries[index], &msgs->at(entries[index]));
+    }
+  }  // namespace
+
+  HoleWorkers::HoleWorkers(int threads) :
+    task_(NULL), count_(0), next_(0), pending_(0), batch_(0),
+    stopping_(false)
+  {
+    for (int i = 0; i < threads; i++)
+    {
+      threads_.create_thread(boost::bind(&HoleWorkers::work, this));
+    }
+  }
+
+
+
+  HoleWorkers::~HoleWorkers()
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_all();
+    threads_.join_all();
+  }
+
+
+
+  /**
+    @brief The pool shared by the filters of the Hole Fusion node,
+    sized to the hardware concurrency
+   **/
+  HoleWorkers& HoleWorkers::instance()
+  {
+    static HoleWorkers workers(std::max(
+        static_cast<int>(boost::thread::hardware_concurrency()) - 1, 0));
+
+    return workers;
+  }
+
+
+
+  /**
+    @brief Runs a task for the indices 0 .. count - 1 and returns when
+    all of them are done. Concurrent calls are served one after the other
+    @param count [int] The number of indices
+    @param task [const Task&] The task. It is called from several threads
+    at once, so it must only write to state of its own index
+    @return void
+   **/
+  void HoleWorkers::run(int count, const Task& task)
+  {
+    if (count <= 0)
+    {
+      return;
+    }
+
+    boost::mutex::scoped_lock runLock(runMutex_);
+
+    // Not worth waking anyone up
+    if (threads_.size() == 0 || count == 1)
+    {
+      for (int i = 0; i < count; i++)
+      {
+        runTask(task, i);
+      }
+      return;
+    }
+
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      task_ = &task;
+      count_ = count;
+      next_ = 0;
+      pending_ = count;
+      batch_++;
+    }
+    wake_.notify_all();
+
+    drain();
+
+    boost::mutex::scoped_lock lock(mutex_);
+    while (pending_ > 0)
+    {
+      done_.wait(lock);
+    }
+    task_ = NULL;
+  }
+
+
+
+  /**
+    @brief Runs the task of a filter for those of its entries whose
+    hole is still pending, and appends the entries' messages to msgs
+    in the order of the entries. Skipped entries get a "-" message and
+    entries that leave their message empty get none
+    @param count [int] The number of entries
+    @param holes [const std::vector<int>*] The hole of each entry,
+    e.g. the inflated rectangles' indices. If NULL, entry i is hole i
+    @param pending [const std::vector<bool>*] Which holes still need to
+    be evaluated. If NULL, all of them do
+    @param task [const EntryTask&] The task of each entry
+    @param msgs [std::vector<std::string>*] The messages
+    @return void
+   **/
+  void HoleWorkers::runEntries(int count, const std::vector<int>* holes,
+    const std::vector<bool>* pending, const EntryTask& task,
+    std::vector<std::string>* msgs)
+  {
+    std::vector<std::string> entryMsgs(count);
+    std::vector<int> entries;
+
+    for (int i = 0; i < count; i++)
+    {
+      int hole = holes != NULL ? holes->at(i) : i;
+
+      if (pending == NULL || pending->at(hole))
+      {
+        entries.push_back(i);
+      }
+      else
+      {
+        entryMsgs[i] = "-";
+      }
+    }
+
+    run(entries.size(), boost::bind(&runEntry,
+        boost::cref(task), boost::cref(entries), &entryMsgs, _1));
+
+    for (int i = 0; i < count; i++)
+    {
+      if (!entryMsgs[i].empty())
+      {
+        msgs->push_back(entryMsgs[i]);
+      }
+    }
+  }
+
+
+
+  /**
+    @brief The loop of each worker thread
+    @return void
+   **/
+  void HoleWorkers::work()
+  {
+    unsigned long seen = 0;
+
+    while (true)
+    {
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        while (!stopping_ && batch_ == seen)
+        {
+          wake_.wait(lock);
+        }
+        if (stopping_)
+        {
+          return;
+        }
+        seen = batch_;
+      }
+
+      drain();
+    }
+  }
+
+
+
+  /**
+    @brief Claims and runs the tasks of the current batch until none
+    is left
+    @return void
+   **/
+  void HoleWorkers::drain()
+  {
+    while (true)
+    {
+      int index;
+      const Task* task;
+      {
+        boost::mutex::scoped_lock lock(mutex_);
+        if (next_ >= count_)
+        {
+          return;
+        }
+        index = next_++;
+        task = task_;
+      }
+
+      runTask(*task, index);
+
+      boost::mutex::scoped_lock lock(mutex_);
+      if (--pending_ == 0)
+      {
+        done_.notify_all();
+      }
+    }
+  }
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -47,6 +47,21 @@ namespace pandora_vision_hole
 {
 namespace hole_fusion
 {
+  namespace
+  {
+    //  The depth change, relative to depth, over which neighbouring points
+    //  are not smoothed together when estimating normals
+    const float NORMALS_MAX_DEPTH_CHANGE_FACTOR = 0.02;
+
+    //  The size of the area over which normals are smoothed, in pixels
+    const float NORMALS_SMOOTHING_SIZE = 10.0;
+  }  // namespace
+
+  boost::mutex PlanesDetection::framePlanesMutex_;
+  PlanesDetection::PlaneLabelsConstPtr PlanesDetection::framePlanes_;
+
+
+
   /**
     @brief Applies a voxel grid filtering
     (http://pointclouds.org/documentation/tutorials/voxel_grid.php)
@@ -56,9 +71,7 @@ namespace hole_fusion
   PointCloudXYZPtr PlanesDetection::applyVoxelGridFilter(
     const PointCloudXYZPtr& cloudIn)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("applyVoxelGridFilter", "locatePlanes");
-    #endif
+    PROFILE_SCOPE("applyVoxelGridFilter", "locatePlanes");
 
     // The output filtered cloud
     PointCloudXYZPtr cloudOut (new PointCloudXYZ());
@@ -70,10 +83,6 @@ namespace hole_fusion
     sor.setLeafSize(leafSize, leafSize, leafSize);
     sor.filter(*cloudOut);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("applyVoxelGridFilter");
-    #endif
-
     return cloudOut;
   }
 
@@ -96,21 +105,16 @@ namespace hole_fusion
     const bool& applyVoxelFilter,
     std::vector<pcl::PointIndices::Ptr>* inliersVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("locatePlanes", "checkHolesRectangleOutline");
-    #endif
+    PROFILE_SCOPE("locatePlanes", "checkHolesRectangleOutline");
 
-    PointCloudXYZPtr inCloud (new PointCloudXYZ);
+    // The input cloud is only read, so it needs no copy
+    PointCloudXYZPtr inCloud = inputCloud;
 
     // Apply voxel filtering
     if (applyVoxelFilter)
     {
       inCloud = applyVoxelGridFilter(inputCloud);
     }
-    else
-    {
-      copyPointCloud(*inputCloud, *inCloud);
-    }
 
     // The vector of planar point clouds
     std::vector<PointCloudXYZPtr> planesVectorOut;
@@ -122,10 +126,6 @@ namespace hole_fusion
     locatePlanesUsingSACSegmentation(inCloud,
       &planesVectorOut, &coefficientsVectorOut, inliersVector);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("locatePlanes");
-    #endif
-
     return planesVectorOut.size();
   }
 
@@ -151,9 +151,7 @@ namespace hole_fusion
     std::vector<pcl::ModelCoefficients>* coefficientsVector,
     std::vector<pcl::PointIndices::Ptr>* inliersVector)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("locatePlanesUsingSACSegmentation", "locatePlanes");
-    #endif
+    PROFILE_SCOPE("locatePlanesUsingSACSegmentation", "locatePlanes");
 
     pcl::console::setVerbosityLevel(pcl::console::L_ALWAYS);
 
@@ -173,9 +171,9 @@ namespace hole_fusion
     seg.setDistanceThreshold(
       Parameters::HoleFusion::Planes::point_to_plane_distance_threshold);
 
-    // Copy the input cloud to a point cloud that we will be processing
-    PointCloudXYZPtr pointCloudProcessed (new PointCloudXYZ);
-    pcl::copyPointCloud(*cloudIn, *pointCloudProcessed);
+    // The point cloud that we will be processing. Each plane found is
+    // extracted into a new cloud, so cloudIn itself is never changed
+    PointCloudXYZPtr pointCloudProcessed = cloudIn;
 
     int i = 0;
     int nr_points = static_cast<int> (pointCloudProcessed->points.size());
@@ -236,15 +234,131 @@ namespace hole_fusion
       // pointCloudProcessed is now without cloud_p, that is,
       // without the points that were
       // found to lie on the largest planar component of pointCloudProcessed
-      pcl::copyPointCloud(*cloud_f, *pointCloudProcessed);
+      pointCloudProcessed = cloud_f;
 
       // Increment the number of planes found
       i++;
     }
+  }
+
+
+
+  /**
+    @brief Segments the planes of a whole organized point cloud in one
+    pass, from the normals found over its integral images. Clouds that
+    are not organized get no planes
+    @param[in] cloud [const PointCloudConstPtr&] The point cloud
+    @return [PlaneLabelsConstPtr] The plane of each point
+   **/
+  PlanesDetection::PlaneLabelsConstPtr PlanesDetection::segmentOrganizedPlanes(
+    const PointCloudConstPtr& cloud)
+  {
+    PROFILE_SCOPE("segmentOrganizedPlanes", "pointCloudCallback");
+
+    boost::shared_ptr<PlaneLabels> planeLabels(new PlaneLabels);
+    planeLabels->cloud = cloud.get();
+    planeLabels->labels = cv::Mat::zeros(cloud->height, cloud->width, CV_32SC1);
+    planeLabels->planes = 0;
+
+    if (cloud->isOrganized())
+    {
+      // The normals of the points, over integral images of the cloud
+      pcl::PointCloud<pcl::Normal>::Ptr normals(
+        new pcl::PointCloud<pcl::Normal>);
+
+      pcl::IntegralImageNormalEstimation<PointCloud::PointType, pcl::Normal>
+        normalEstimation;
+      normalEstimation.setNormalEstimationMethod(
+        normalEstimation.AVERAGE_3D_GRADIENT);
+      normalEstimation.setMaxDepthChangeFactor(
+        NORMALS_MAX_DEPTH_CHANGE_FACTOR);
+      normalEstimation.setNormalSmoothingSize(NORMALS_SMOOTHING_SIZE);
+      normalEstimation.setInputCloud(cloud);
+      normalEstimation.compute(*normals);
+
+      // Grow planes over neighbouring points of similar normals
+      pcl::OrganizedMultiPlaneSegmentation
+        <PointCloud::PointType, pcl::Normal, pcl::Label> segmentation;
+      segmentation.setMinInliers(
+        Parameters::HoleFusion::Planes::min_plane_inliers);
+      segmentation.setAngularThreshold(
+        Parameters::HoleFusion::Planes::plane_angular_threshold * M_PI / 180);
+      segmentation.setDistanceThreshold(
+        Parameters::HoleFusion::Planes::point_to_plane_distance_threshold);
+      segmentation.setInputNormals(normals);
+      segmentation.setInputCloud(cloud);
+
+      std::vector<pcl::ModelCoefficients> coefficientsVector;
+      std::vector<pcl::PointIndices> inliersVector;
+      segmentation.segment(coefficientsVector, inliersVector);
+
+      // The labels image is continuous, so a point's index in the cloud is
+      // its index in the image
+      int* labels = planeLabels->labels.ptr<int>();
+
+      for (unsigned int p = 0; p < inliersVector.size(); p++)
+      {
+        for (unsigned int i = 0; i < inliersVector[p].indices.size(); i++)
+        {
+          labels[inliersVector[p].indices[i]] = p + 1;
+        }
+      }
+
+      planeLabels->planes = inliersVector.size();
+    }
+
+    return planeLabels;
+  }
+
+
+
+  /**
+    @brief Segments the planes of the point cloud of the current frame,
+    for getFramePlanes to return them. The point cloud is not to be
+    changed until the next call
+    @param[in] cloud [const PointCloudConstPtr&] The point cloud
+    @return void
+   **/
+  void PlanesDetection::setFramePlanes(const PointCloudConstPtr& cloud)
+  {
+    PlaneLabelsConstPtr planeLabels = segmentOrganizedPlanes(cloud);
+
+    boost::mutex::scoped_lock lock(framePlanesMutex_);
+    framePlanes_ = planeLabels;
+  }
+
+
+
+  /**
+    @brief Forgets the planes of the current frame
+    @return void
+   **/
+  void PlanesDetection::clearFramePlanes()
+  {
+    boost::mutex::scoped_lock lock(framePlanesMutex_);
+    framePlanes_.reset();
+  }
+
+
+
+  /**
+    @brief The planes of the current frame
+    @param[in] cloud [const PointCloudConstPtr&] The point cloud whose
+    planes are needed
+    @return [PlaneLabelsConstPtr] The planes set by setFramePlanes,
+    or NULL if they were not segmented from this point cloud
+   **/
+  PlanesDetection::PlaneLabelsConstPtr PlanesDetection::getFramePlanes(
+    const PointCloudConstPtr& cloud)
+  {
+    boost::mutex::scoped_lock lock(framePlanesMutex_);
+
+    if (framePlanes_ && framePlanes_->cloud == cloud.get())
+    {
+      return framePlanes_;
+    }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("locatePlanesUsingSACSegmentation");
-    #endif
+    return PlaneLabelsConstPtr();
   }
 
 }  // namespace hole_fusion
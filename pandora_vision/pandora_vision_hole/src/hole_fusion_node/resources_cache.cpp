@@ -0,0 +1,235 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include "hole_fusion_node/resources_cache.h"
+#include <boost/functional/hash.hpp>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  namespace
+  {
+    void hashPoints(const std::vector<cv::Point2f>& points, std::size_t* seed)
+    {
+      boost::hash_combine(*seed, points.size());
+      for (unsigned int i = 0; i < points.size(); i++)
+      {
+        boost::hash_combine(*seed, points[i].x);
+        boost::hash_combine(*seed, points[i].y);
+      }
+    }
+  }  // namespace
+
+
+
+  ResourcesCache::Entry::Entry() :
+    hasMask(false),
+    hasInflatedRectangle(false),
+    inflationSize(0),
+    inflatedRectangleInBounds(false),
+    hasIntermediatePoints(false)
+  {
+  }
+
+
+
+  ResourcesCache::Statistics::Statistics() :
+    hits(0),
+    misses(0),
+    evictions(0)
+  {
+  }
+
+
+
+  /**
+    @brief The fraction of the lookups that were hits
+    @return [double] The hit rate, or 0 if there were no lookups
+   **/
+  double ResourcesCache::Statistics::hitRate() const
+  {
+    if (hits + misses == 0)
+    {
+      return 0.0;
+    }
+
+    return static_cast<double>(hits) / (hits + misses);
+  }
+
+
+
+  bool ResourcesCache::Descriptor::operator==(const Descriptor& other) const
+  {
+    return imageSize == other.imageSize
+      && seed == other.seed
+      && rectangle == other.rectangle
+      && outline == other.outline;
+  }
+
+
+
+  /**
+    @param capacity [std::size_t] The maximum number of holes kept.
+    Zero disables the cache
+   **/
+  ResourcesCache::ResourcesCache(std::size_t capacity) :
+    capacity_(capacity)
+  {
+  }
+
+
+
+  /**
+    @brief Finds the entry of a hole, creating an empty one if the hole
+    has not been seen recently. The entry stays valid until the next
+    call of lookup, setCapacity or clear
+    @param[in] hole [const HoleConveyor&] The hole
+    @param[in] imageSize [const cv::Size&] The size of the images the
+    resources are computed for
+    @return [Entry*] The hole's entry, or NULL if the cache is disabled
+   **/
+  ResourcesCache::Entry* ResourcesCache::lookup(const HoleConveyor& hole,
+    const cv::Size& imageSize)
+  {
+    if (capacity_ == 0)
+    {
+      return NULL;
+    }
+
+    Descriptor descriptor;
+    descriptor.imageSize = imageSize;
+    // cv::floodFill is seeded from the keypoint rounded to its integer
+    // pixel, so keypoints within the same pixel share their resources
+    descriptor.seed = cv::Point(cvRound(hole.keypoint.pt.x),
+      cvRound(hole.keypoint.pt.y));
+    descriptor.rectangle = hole.rectangle;
+    descriptor.outline = hole.outline;
+
+    std::size_t key = 0;
+    boost::hash_combine(key, imageSize.width);
+    boost::hash_combine(key, imageSize.height);
+    boost::hash_combine(key, descriptor.seed.x);
+    boost::hash_combine(key, descriptor.seed.y);
+    hashPoints(descriptor.rectangle, &key);
+    hashPoints(descriptor.outline, &key);
+
+    NodeIndex::iterator found = index_.find(key);
+
+    if (found != index_.end())
+    {
+      // Most recently used first
+      entries_.splice(entries_.begin(), entries_, found->second);
+
+      if (found->second->descriptor == descriptor)
+      {
+        statistics_.hits++;
+        return &found->second->entry;
+      }
+
+      // A different hole with the same hash takes over the node
+      statistics_.misses++;
+      found->second->descriptor = descriptor;
+      found->second->entry = Entry();
+      return &found->second->entry;
+    }
+
+    statistics_.misses++;
+    shrink(capacity_ - 1);
+
+    entries_.push_front(Node());
+    entries_.front().key = key;
+    entries_.front().descriptor = descriptor;
+    index_[key] = entries_.begin();
+
+    return &entries_.front().entry;
+  }
+
+
+
+  /**
+    @brief Changes the maximum number of holes kept, evicting the least
+    recently used ones if there are more
+    @param capacity [std::size_t] The new capacity. Zero disables the
+    cache
+    @return void
+   **/
+  void ResourcesCache::setCapacity(std::size_t capacity)
+  {
+    capacity_ = capacity;
+    shrink(capacity_);
+  }
+
+
+
+  /**
+    @brief Forgets every hole
+    @return void
+   **/
+  void ResourcesCache::clear()
+  {
+    entries_.clear();
+    index_.clear();
+  }
+
+
+
+  /**
+    @brief Evicts the least recently used holes until at most capacity
+    of them are left
+    @param capacity [std::size_t] The number of holes to keep
+    @return void
+   **/
+  void ResourcesCache::shrink(std::size_t capacity)
+  {
+    while (entries_.size() > capacity)
+    {
+      index_.erase(entries_.back().key);
+      entries_.pop_back();
+      statistics_.evictions++;
+    }
+  }
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
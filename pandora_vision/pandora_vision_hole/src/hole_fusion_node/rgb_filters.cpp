@@ -36,6 +36,8 @@
  *********************************************************************/
 
 #include "hole_fusion_node/rgb_filters.h"
+#include <boost/bind.hpp>
+#include "hole_fusion_node/hole_workers.h"
 
 /**
   @namespace pandora_vision
@@ -47,6 +49,316 @@ namespace pandora_vision_hole
 {
 namespace hole_fusion
 {
+  namespace
+  {
+    /**
+      @brief The histogram settings of checkHolesTextureDiff
+     **/
+    struct TextureHistogram
+    {
+      int histSize[2];
+      float h_ranges[2];
+      float sec_ranges[2];
+      const float* ranges[2];
+      int channels[2];
+    };
+
+    /**
+      @brief Sums the values of the pixels of a region, row by row
+      @param[in] image [const cv::Mat&] The image, in CV_8UC1 format
+      @param[in] region [const Region&] The region
+      @return [int] The sum
+     **/
+    int regionSum(const cv::Mat& image, const Region& region)
+    {
+      int sum = 0;
+
+      const std::vector<Region::Run>& runs = region.runs();
+      for (unsigned int r = 0; r < runs.size(); r++)
+      {
+        const unsigned char* row = image.ptr<unsigned char>(runs[r].row);
+
+        for (int c = runs[r].begin; c < runs[r].end; c++)
+        {
+          sum += row[c];
+        }
+      }
+
+      return sum;
+    }
+
+    /**
+      @brief Counts the colours inside the mask of one hole
+      @param[in] reducedImage [const cv::Mat&] The colour reduced RGB image
+      @param[in] holesMasksImageVector [const std::vector<cv::Mat>&] The
+      masks of the points inside each hole's outline
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the hole
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void colorHomogeneity(
+      const cv::Mat& reducedImage,
+      const std::vector<cv::Mat>& holesMasksImageVector,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      // Sets featuring all the different colours found inside each image mask
+      std::set<unsigned char> blueColourSet;
+      std::set<unsigned char> greenColourSet;
+      std::set<unsigned char> redColourSet;
+
+      for (int rows = 0; rows < reducedImage.rows; rows++)
+      {
+        const unsigned char* mask = holesMasksImageVector[i].ptr(rows);
+        const cv::Vec3b* colour = reducedImage.ptr<cv::Vec3b>(rows);
+
+        for (int cols = 0; cols < reducedImage.cols; cols++)
+        {
+          // Collect the different values of colour components for the
+          // points of the current mask
+          if (mask[cols] != 0)
+          {
+            blueColourSet.insert(colour[cols].val[0]);
+            greenColourSet.insert(colour[cols].val[1]);
+            redColourSet.insert(colour[cols].val[2]);
+          }
+        }
+      }
+
+      // The number of distinct colours inside the mask
+      int numberOfColours =
+        blueColourSet.size() * greenColourSet.size() * redColourSet.size();
+
+      // Threshold the number of colours
+      if (numberOfColours < 1024)
+      {
+        numberOfColours = 0;
+      }
+
+      probabilitiesVector->at(i) = static_cast<float>(numberOfColours) / 4096;
+
+      *msg = TOSTR(probabilitiesVector->at(i));
+    }
+
+    /**
+      @brief Compares the mean luminosity inside the outline of one hole
+      against the one of its intermediate points
+      @param[in] luminosityImage [const cv::Mat&] The luminosity image
+      @param[in] holesMasksRegionVector
+      [const std::vector<Region>&] The points inside each
+      hole's outline
+      @param[in] intermediatePointsRegionVector
+      [const std::vector<Region>&] The points between each
+      hole's outline and its bounding rectangle
+      @param[in] rectanglesIndices [const std::vector<int>&] The hole of
+      each inflated rectangle
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the inflated rectangle
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void luminosityDiff(
+      const cv::Mat& luminosityImage,
+      const std::vector<Region>& holesMasksRegionVector,
+      const std::vector<Region>& intermediatePointsRegionVector,
+      const std::vector<int>& rectanglesIndices,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      // The current hole's inside points luminosity sum
+      int blobLuminosity = regionSum(luminosityImage,
+        holesMasksRegionVector[rectanglesIndices[i]]);
+
+      // The current hole's intermediate points luminosity sum
+      int boundingBoxLuminosity = regionSum(luminosityImage,
+        intermediatePointsRegionVector[i]);
+
+      // Mean luminosity of the inside points of the current hole
+      float meanBlobLuminosity = 0.0;
+      if (holesMasksRegionVector[rectanglesIndices[i]].area() > 0)
+      {
+        meanBlobLuminosity = static_cast<float> (blobLuminosity)
+          / holesMasksRegionVector[rectanglesIndices[i]].area();
+      }
+
+
+      // Mean luminosity of the intermediate points
+      float meanBoundingBoxLuminosity = 0.0;
+      if (intermediatePointsRegionVector[i].area() > 0)
+      {
+        meanBoundingBoxLuminosity = static_cast<float> (boundingBoxLuminosity)
+          / intermediatePointsRegionVector[i].area();
+      }
+
+
+      // If the luminosity of the inside of the candidate hole is greater
+      // than the luminosity of the points beyond it and restricted by the
+      // edges of its bounding box, it surely is not a hole
+      if (meanBlobLuminosity < meanBoundingBoxLuminosity
+        && meanBoundingBoxLuminosity > 0)
+      {
+        probabilitiesVector->at(rectanglesIndices[i]) =
+          1 - meanBlobLuminosity / meanBoundingBoxLuminosity;
+      }
+
+      *msg = TOSTR(probabilitiesVector->at(rectanglesIndices[i]));
+    }
+
+    /**
+      @brief Compares the backprojection inside the outline of one hole
+      against the one of its intermediate points
+      @param[in] watersheded [const cv::Mat&] The watersheded backprojection
+      @param[in] holesMasksRegionVector
+      [const std::vector<Region>&] The points inside each
+      hole's outline
+      @param[in] intermediatePointsRegionVector
+      [const std::vector<Region>&] The points between each
+      hole's outline and its bounding rectangle
+      @param[in] rectanglesIndices [const std::vector<int>&] The hole of
+      each inflated rectangle
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the inflated rectangle
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void textureBackProject(
+      const cv::Mat& watersheded,
+      const std::vector<Region>& holesMasksRegionVector,
+      const std::vector<Region>& intermediatePointsRegionVector,
+      const std::vector<int>& rectanglesIndices,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      float blobSum = static_cast<float>(regionSum(watersheded,
+          holesMasksRegionVector[rectanglesIndices[i]])) / 255;
+
+      float blobToRectangleSum = static_cast<float>(regionSum(watersheded,
+          intermediatePointsRegionVector[i])) / 255;
+
+      // The average probability of the points consisting the inflated
+      // rectangle matching the histograms in the inHistogram
+      float rectangleMatchProbability = 0.0;
+      if (intermediatePointsRegionVector[i].area() > 0)
+      {
+        rectangleMatchProbability =
+          blobToRectangleSum / intermediatePointsRegionVector[i].area();
+      }
+
+      // The average probability of the points inside the blob's outline
+      // matching the histograms in the inHistogram
+      float blobMatchProbability = 0.0;
+      if (holesMasksRegionVector[rectanglesIndices[i]].area() > 0)
+      {
+        blobMatchProbability =
+          blobSum / holesMasksRegionVector[rectanglesIndices[i]].area();
+      }
+
+      // This blob is considered valid, with a non zero validity probability,
+      // if the points consisting the inflated rectangle have a greater
+      // resemblance (through the probability-expressing values of the
+      // back project cv::MatND) to the inHistogram than the one of the points
+      // inside the blob's outline
+      if (rectangleMatchProbability > blobMatchProbability)
+      {
+        probabilitiesVector->at(rectanglesIndices[i]) =
+          rectangleMatchProbability - blobMatchProbability;
+      }
+
+      *msg = TOSTR(probabilitiesVector->at(rectanglesIndices[i]));
+    }
+
+    /**
+      @brief Compares the histograms of the inside and of the intermediate
+      points of one hole against the model histograms
+      @param[in] inImageHSV [const cv::Mat&] The input image in HSV format
+      @param[in] setup [const TextureHistogram&] The histogram settings
+      @param[in] inHistogram [const std::vector<cv::MatND>&] The vector of
+      model histograms
+      @param[in] holesMasksImageVector [const std::vector<cv::Mat>&] The
+      masks of the points inside each hole's outline
+      @param[in] intermediatePointsImageVector [const std::vector<cv::Mat>&]
+      The masks of the points between each hole's outline and its bounding
+      rectangle
+      @param[in] rectanglesIndices [const std::vector<int>&] The hole of
+      each inflated rectangle
+      @param[out] probabilitiesVector [std::vector<float>*] The
+      probabilities of all holes
+      @param[in] i [int] The index of the inflated rectangle
+      @param[out] msg [std::string*] The debug message of the hole
+      @return void
+     **/
+    void textureDiff(
+      const cv::Mat& inImageHSV,
+      const TextureHistogram& setup,
+      const std::vector<cv::MatND>& inHistogram,
+      const std::vector<cv::Mat>& holesMasksImageVector,
+      const std::vector<cv::Mat>& intermediatePointsImageVector,
+      const std::vector<int>& rectanglesIndices,
+      std::vector<float>* probabilitiesVector,
+      int i,
+      std::string* msg)
+    {
+      // Produce the histogram for the points in between the blob's outline
+      // and the inflated rectangle's edges
+      cv::MatND blobToRectangleHistogram;
+      cv::calcHist(&inImageHSV, 1, setup.channels,
+        intermediatePointsImageVector[i], blobToRectangleHistogram, 2,
+        setup.histSize, const_cast<const float**>(setup.ranges), true, false);
+
+
+      // Produce the histogram for the points inside the outline of the blob
+      cv::MatND blobHistogram;
+      cv::calcHist(&inImageHSV, 1, setup.channels,
+        holesMasksImageVector[rectanglesIndices[i]], blobHistogram, 2,
+        setup.histSize, const_cast<const float**>(setup.ranges), true, false);
+
+      // For each input histogram compute the largest probability
+
+      float maxProbability = 0.0;
+      for (int h = 0; h < inHistogram.size(); h++)
+      {
+        // Find the correlation between the model histogram and the histogram
+        // of the inflated rectangle
+        double rectangleToModelCorrelation = cv::compareHist(
+          blobToRectangleHistogram, inHistogram[h], CV_COMP_HELLINGER);
+
+        // Find the correlation between the model histogram and the histogram
+        // of the points inside the blob
+        double blobToModelCorrelation = cv::compareHist(
+          blobHistogram, inHistogram[h], CV_COMP_HELLINGER);
+
+        // This blob is considered valid if there is a correlation between
+        // the histogram of the external to the hole's outline points
+        // and the model histogram (inHistogram) greater than a threshold and,
+        // simultaneously, the correlation between the histogram of the points
+        // inside the hole's outline points and the model histogram is lower
+        // than a threshold.
+        // CAUTION: The use of the CV_COMP_HELLINGER for histogram comparison
+        // inverts the inequality checks
+        if (blobToModelCorrelation >=
+          Parameters::Filters::TextureDiff::mismatch_texture_threshold &&
+          rectangleToModelCorrelation < blobToModelCorrelation)
+        {
+          if (blobToModelCorrelation - rectangleToModelCorrelation > maxProbability)
+          {
+            maxProbability = blobToModelCorrelation - rectangleToModelCorrelation;
+          }
+        }
+      }
+
+      probabilitiesVector->at(rectanglesIndices[i]) = maxProbability;
+
+      *msg = TOSTR(probabilitiesVector->at(rectanglesIndices[i]));
+    }
+  }  // namespace
+
   /**
     @brief Checks for colour homogeneity in a region where points are
     constrained inside each hole. The colors of the image are reduced
@@ -63,17 +375,18 @@ namespace hole_fusion
     number of keypoints found and published by the rgb node
     @param[in,out] msgs [std::vector<std::string>*] Messages for
     debug reasons
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void RgbFilters::checkHolesColorHomogeneity(
     const cv::Mat& inImage,
     const std::vector<cv::Mat>& holesMasksImageVector,
     std::vector<float>* probabilitiesVector,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesColorHomogeneity", "applyFilter");
-    #endif
+    PROFILE_SCOPE("checkHolesColorHomogeneity", "applyFilter");
 
     // Copy the input image to inImage_ so as to get a pointer on it
     cv::Mat inImage_;
@@ -99,46 +412,12 @@ namespace hole_fusion
     }
 
 
-    for (unsigned int i = 0; i < holesMasksImageVector.size(); i++)
-    {
-      // Sets featuring all the different colours found inside each image mask
-      std::set<unsigned char> blueColourSet;
-      std::set<unsigned char> greenColourSet;
-      std::set<unsigned char> redColourSet;
-
-      for (int rows = 0; rows < inImage_.rows; rows++)
-      {
-        for (int cols = 0; cols < inImage_.cols; cols++)
-        {
-          // Collect the different values of colour components for the
-          // points of the current mask
-          if (holesMasksImageVector[i].at<unsigned char>(rows, cols) != 0)
-          {
-            blueColourSet.insert(inImage_.at<cv::Vec3b>(rows, cols).val[0]);
-            greenColourSet.insert(inImage_.at<cv::Vec3b>(rows, cols).val[1]);
-            redColourSet.insert(inImage_.at<cv::Vec3b>(rows, cols).val[2]);
-          }
-        }
-      }
-
-      // The number of distinct colours inside the mask
-      int numberOfColours =
-        blueColourSet.size() * greenColourSet.size() * redColourSet.size();
-
-      // Threshold the number of colours
-      if (numberOfColours < 1024)
-      {
-        numberOfColours = 0;
-      }
-
-      probabilitiesVector->at(i) = static_cast<float>(numberOfColours) / 4096;
-
-      msgs->push_back(TOSTR(probabilitiesVector->at(i)));
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesColorHomogeneity");
-    #endif
+    // Each hole scans the whole of inImage_, so holes are shared among
+    // the workers
+    HoleWorkers::instance().runEntries(holesMasksImageVector.size(), NULL,
+      pending, boost::bind(&colorHomogeneity, boost::cref(inImage_),
+        boost::cref(holesMasksImageVector), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 
@@ -149,12 +428,12 @@ namespace hole_fusion
     outside the hole's outline and
     (2) the points inside the hole's outline.
     @param[in] inImage [const cv::Mat&] The RGB image in CV_8UC3 format
-    @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-    A vector that holds sets of points's indices;
+    @param[in] holesMasksRegionVector [const std::vector<Region>&]
+    A vector that holds a region of points for each hole;
     each point is internal to its respective hole
-    @param[in] intermediatePointsSetVector
-    [const std::vector<std::set<unsigned int> >& ] A vector that holds for each
-    hole a set of points' indices; these points are the points between
+    @param[in] intermediatePointsRegionVector
+    [const std::vector<Region>& ] A vector that holds for each
+    hole a region of points; these points are the points between
     the hole's outline and its bounding rectangle
     @param[in] rectanglesIndices [const std::vector<int>&] A vector that
     is used to identify a hole's corresponding rectangle. Used primarily
@@ -167,19 +446,20 @@ namespace hole_fusion
     number of keypoints found and published by the rgb node
     @param[out] msgs [std::vector<std::string>*] Messages for
     debug reasons
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void RgbFilters::checkHolesLuminosityDiff(
     const cv::Mat& inImage,
-    const std::vector<std::set<unsigned int> >& holesMasksSetVector,
-    const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+    const std::vector<Region>& holesMasksRegionVector,
+    const std::vector<Region>& intermediatePointsRegionVector,
     const std::vector<int>& rectanglesIndices,
     std::vector<float>* probabilitiesVector,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesLuminosityDiff", "applyFilter");
-    #endif
+    PROFILE_SCOPE("checkHolesLuminosityDiff", "applyFilter");
 
     // In order to find the luminosity
     // convert the input RGB image to YCrCb format.
@@ -194,66 +474,17 @@ namespace hole_fusion
     cv::Mat luminosityImage(inImage.size(), CV_8UC1);
     luminosityImage = channels[0];
 
-    unsigned char* ptr = luminosityImage.ptr();
-
     // For each inflated rectangle, calculate the luminosity of
     // (1) the points between the blob's outline and the edges of the
     // inflated rectangle and
     // (2) the points inside the blob's outline
-    for (unsigned int i = 0; i < rectanglesIndices.size(); i++)
-    {
-      // The current hole's inside points luminosity sum
-      int blobLuminosity = 0;
-      for (std::set<unsigned int>::iterator h_it =
-        holesMasksSetVector[rectanglesIndices[i]].begin();
-        h_it != holesMasksSetVector[rectanglesIndices[i]].end(); h_it++)
-      {
-        blobLuminosity += ptr[*h_it];
-      }
-
-      // The current hole's intermediate points luminosity sum
-      int boundingBoxLuminosity = 0;
-      for (std::set<unsigned int>::iterator i_it =
-        intermediatePointsSetVector[i].begin();
-        i_it != intermediatePointsSetVector[i].end(); i_it++)
-      {
-        boundingBoxLuminosity += ptr[*i_it];
-      }
-
-      // Mean luminosity of the inside points of the current hole
-      float meanBlobLuminosity = 0.0;
-      if (holesMasksSetVector[rectanglesIndices[i]].size() > 0)
-      {
-        meanBlobLuminosity = static_cast<float> (blobLuminosity)
-          / holesMasksSetVector[rectanglesIndices[i]].size();
-      }
-
-
-      // Mean luminosity of the intermediate points
-      float meanBoundingBoxLuminosity = 0.0;
-      if (intermediatePointsSetVector[i].size() > 0)
-      {
-        meanBoundingBoxLuminosity = static_cast<float> (boundingBoxLuminosity)
-          / intermediatePointsSetVector[i].size();
-      }
-
-
-      // If the luminosity of the inside of the candidate hole is greater
-      // than the luminosity of the points beyond it and restricted by the
-      // edges of its bounding box, it surely is not a hole
-      if (meanBlobLuminosity < meanBoundingBoxLuminosity
-        && meanBoundingBoxLuminosity > 0)
-      {
-        probabilitiesVector->at(rectanglesIndices[i]) =
-          1 - meanBlobLuminosity / meanBoundingBoxLuminosity;
-      }
-
-      msgs->push_back(TOSTR(probabilitiesVector->at(rectanglesIndices[i])));
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesLuminosityDiff");
-    #endif
+    HoleWorkers::instance().runEntries(rectanglesIndices.size(),
+      &rectanglesIndices, pending, boost::bind(&luminosityDiff,
+        boost::cref(luminosityImage),
+        boost::cref(holesMasksRegionVector),
+        boost::cref(intermediatePointsRegionVector),
+        boost::cref(rectanglesIndices), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 
@@ -270,12 +501,11 @@ namespace hole_fusion
     @param[in] inImage [const cv::Mat&] The input RGB image in CV_8UC3 format
     @param[in] inHistogram [const std::vector<cv::MatND>&]
     The vector of model histograms
-    @param[in] holesMasksSetVector [const std::vector<std::set<unsigned int> >&]
-    A vector that holds sets of points; each point is internal to its
-    respective hole
-    @param[in] intermediatePointsSetVector
-    [const std::vector<std::set<unsigned int> >& ] A vector that holds for each
-    hole a set of points' indices; these points are the points between
+    @param[in] holesMasksRegionVector [const std::vector<Region>&]
+    A vector that holds the region of the points inside each hole
+    @param[in] intermediatePointsRegionVector
+    [const std::vector<Region>& ] A vector that holds for each
+    hole a region of points; these points are the points between
     the hole's outline and its bounding rectangle
     @param[in] rectanglesIndices [const std::vector<int>&] A vector that
     is used to identify a hole's corresponding rectangle. Used primarily
@@ -287,20 +517,21 @@ namespace hole_fusion
     size, the size of this vector is the same throughout and equal to the
     number of keypoints found and published by the rgb node
     @param[in,out] msgs [std::vector<std::string>*] Messages for debug reasons
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void RgbFilters::checkHolesTextureBackProject(
     const cv::Mat& inImage,
     const std::vector<cv::MatND>& inHistogram,
-    const std::vector<std::set<unsigned int> >& holesMasksSetVector,
-    const std::vector<std::set<unsigned int> >& intermediatePointsSetVector,
+    const std::vector<Region>& holesMasksRegionVector,
+    const std::vector<Region>& intermediatePointsRegionVector,
     const std::vector<int>& rectanglesIndices,
     std::vector<float>* probabilitiesVector,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesTextureBackProject", "applyFilter");
-    #endif
+    PROFILE_SCOPE("checkHolesTextureBackProject", "applyFilter");
 
     // Obtain the backprojection of the inImage, according to the inHistogram
     cv::Mat backProject = cv::Mat::zeros(inImage.size(), CV_8UC1);
@@ -320,67 +551,18 @@ namespace hole_fusion
     }
     #endif
 
-    // Obtain a pointer on watersheded
-    unsigned char* ptr = watersheded.ptr();
-
     // For each inflated rectangle, calculate the probabilities of
     // (1) the points between the blob's outline and the edges of the
     // inflated rectangle and
     // (2) the points inside the blob's outline
     // based on the watersheded image
-    for (unsigned int i = 0; i < rectanglesIndices.size(); i++)
-    {
-      float blobSum = 0.0;
-      for (std::set<unsigned int>::iterator h_it =
-        holesMasksSetVector[rectanglesIndices[i]].begin();
-        h_it != holesMasksSetVector[rectanglesIndices[i]].end(); h_it++)
-      {
-        blobSum += static_cast<float>(ptr[*h_it]) / 255;
-      }
-
-      float blobToRectangleSum = 0.0;
-      for (std::set<unsigned int>::iterator i_it =
-        intermediatePointsSetVector[i].begin();
-        i_it != intermediatePointsSetVector[i].end(); i_it++)
-      {
-        blobToRectangleSum += static_cast<float>(ptr[*i_it]) / 255;
-      }
-
-      // The average probability of the points consisting the inflated
-      // rectangle matching the histograms in the inHistogram
-      float rectangleMatchProbability = 0.0;
-      if (intermediatePointsSetVector[i].size() > 0)
-      {
-        rectangleMatchProbability =
-          blobToRectangleSum / intermediatePointsSetVector[i].size();
-      }
-
-      // The average probability of the points inside the blob's outline
-      // matching the histograms in the inHistogram
-      float blobMatchProbability = 0.0;
-      if (holesMasksSetVector[rectanglesIndices[i]].size() > 0)
-      {
-        blobMatchProbability =
-          blobSum / holesMasksSetVector[rectanglesIndices[i]].size();
-      }
-
-      // This blob is considered valid, with a non zero validity probability,
-      // if the points consisting the inflated rectangle have a greater
-      // resemblance (through the probability-expressing values of the
-      // back project cv::MatND) to the inHistogram than the one of the points
-      // inside the blob's outline
-      if (rectangleMatchProbability > blobMatchProbability)
-      {
-        probabilitiesVector->at(rectanglesIndices[i]) =
-          rectangleMatchProbability - blobMatchProbability;
-      }
-
-      msgs->push_back(TOSTR(probabilitiesVector->at(rectanglesIndices[i])));
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesTextureBackProject");
-    #endif
+    HoleWorkers::instance().runEntries(rectanglesIndices.size(),
+      &rectanglesIndices, pending, boost::bind(&textureBackProject,
+        boost::cref(watersheded),
+        boost::cref(holesMasksRegionVector),
+        boost::cref(intermediatePointsRegionVector),
+        boost::cref(rectanglesIndices), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 
@@ -411,6 +593,8 @@ namespace hole_fusion
     size, the size of this vector is the same throughout and equal to the
     number of keypoints found and published by the rgb node
     @param[in,out] msgs [std::vector<std::string>*] Messages for debug reasons
+    @param[in] pending [const std::vector<bool>*] Which holes still need
+    to be evaluated; the rest keep their probability. If NULL, all do
     @return void
    **/
   void RgbFilters::checkHolesTextureDiff(
@@ -420,106 +604,50 @@ namespace hole_fusion
     const std::vector<cv::Mat>& intermediatePointsImageVector,
     const std::vector<int>& rectanglesIndices,
     std::vector<float>* probabilitiesVector,
-    std::vector<std::string>* msgs)
+    std::vector<std::string>* msgs,
+    const std::vector<bool>* pending)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("checkHolesTextureDiff", "applyFilter");
-    #endif
-
-    // Since not all rectangles may make it, store the indices
-    // of the original keypoints that correspond to valid inflated rectangles
-    // in the validKeyPointsIndices vector
-    std::vector<unsigned int> validKeyPointsIndices;
+    PROFILE_SCOPE("checkHolesTextureDiff", "applyFilter");
 
     // inImage transformed from BGR format to HSV
     cv::Mat inImageHSV;
     cv::cvtColor(inImage, inImageHSV, cv::COLOR_BGR2HSV);
 
-    int* histSize = new int[2];
+    TextureHistogram setup;
 
     // The first value will always be with regard to Hue
-    histSize[0] = Parameters::Histogram::number_of_hue_bins;
-
-    // Histogram-related parameters
-    int v_bins = Parameters::Histogram::number_of_value_bins;
+    setup.histSize[0] = Parameters::Histogram::number_of_hue_bins;
 
     if (Parameters::Histogram::secondary_channel == 1)
     {
-      histSize[1] = Parameters::Histogram::number_of_saturation_bins;
+      setup.histSize[1] = Parameters::Histogram::number_of_saturation_bins;
     }
 
     if (Parameters::Histogram::secondary_channel == 2)
     {
-      histSize[1] = Parameters::Histogram::number_of_value_bins;
+      setup.histSize[1] = Parameters::Histogram::number_of_value_bins;
     }
 
     // hue varies from 0 to 179, saturation or value from 0 to 255
-    float h_ranges[] = { 0, 180 };
-    float sec_ranges[] = { 0, 256 };
+    setup.h_ranges[0] = 0;
+    setup.h_ranges[1] = 180;
+    setup.sec_ranges[0] = 0;
+    setup.sec_ranges[1] = 256;
 
-    const float* ranges[] = { h_ranges, sec_ranges };
+    setup.ranges[0] = setup.h_ranges;
+    setup.ranges[1] = setup.sec_ranges;
 
     // Use the 0-th and secondaryChannel-st channels
-    int channels[] = { 0, Parameters::Histogram::secondary_channel };
-
-
-    for (unsigned int i = 0; i < rectanglesIndices.size(); i++)
-    {
-      // Produce the histogram for the points in between the blob's outline
-      // and the inflated rectangle's edges
-      cv::MatND blobToRectangleHistogram;
-      cv::calcHist(&inImageHSV, 1, channels, intermediatePointsImageVector[i],
-        blobToRectangleHistogram, 2, histSize, ranges, true, false);
-
-
-      // Produce the histogram for the points inside the outline of the blob
-      cv::MatND blobHistogram;
-      cv::calcHist(&inImageHSV, 1, channels,
-        holesMasksImageVector[rectanglesIndices[i]],
-        blobHistogram, 2, histSize, ranges, true, false);
-
-      // For each input histogram compute the largest probability
-
-      float maxProbability = 0.0;
-      for (int h = 0; h < inHistogram.size(); h++)
-      {
-        // Find the correlation between the model histogram and the histogram
-        // of the inflated rectangle
-        double rectangleToModelCorrelation = cv::compareHist(
-          blobToRectangleHistogram, inHistogram[h], CV_COMP_HELLINGER);
-
-        // Find the correlation between the model histogram and the histogram
-        // of the points inside the blob
-        double blobToModelCorrelation = cv::compareHist(
-          blobHistogram, inHistogram[h], CV_COMP_HELLINGER);
-
-        // This blob is considered valid if there is a correlation between
-        // the histogram of the external to the hole's outline points
-        // and the model histogram (inHistogram) greater than a threshold and,
-        // simultaneously, the correlation between the histogram of the points
-        // inside the hole's outline points and the model histogram is lower
-        // than a threshold.
-        // CAUTION: The use of the CV_COMP_HELLINGER for histogram comparison
-        // inverts the inequality checks
-        if (blobToModelCorrelation >=
-          Parameters::Filters::TextureDiff::mismatch_texture_threshold &&
-          rectangleToModelCorrelation < blobToModelCorrelation)
-        {
-          if (blobToModelCorrelation - rectangleToModelCorrelation > maxProbability)
-          {
-            maxProbability = blobToModelCorrelation - rectangleToModelCorrelation;
-          }
-        }
-      }
-
-      probabilitiesVector->at(rectanglesIndices[i]) = maxProbability;
-
-      msgs->push_back(TOSTR(probabilitiesVector->at(rectanglesIndices[i])));
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("checkHolesTextureDiff");
-    #endif
+    setup.channels[0] = 0;
+    setup.channels[1] = Parameters::Histogram::secondary_channel;
+
+    HoleWorkers::instance().runEntries(rectanglesIndices.size(),
+      &rectanglesIndices, pending, boost::bind(&textureDiff,
+        boost::cref(inImageHSV), boost::cref(setup),
+        boost::cref(inHistogram), boost::cref(holesMasksImageVector),
+        boost::cref(intermediatePointsImageVector),
+        boost::cref(rectanglesIndices), probabilitiesVector, _1, _2),
+      msgs);
   }
 
 }  // namespace hole_fusion
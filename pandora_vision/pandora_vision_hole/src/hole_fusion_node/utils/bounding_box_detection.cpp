@@ -67,9 +67,7 @@ namespace hole_fusion
     const std::vector<float>& blobsArea,
     std::vector<std::vector<cv::Point2f> >* outRectangles)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("findRotatedBoundingBoxesFromOutline", "validateBlobs");
-    #endif
+    PROFILE_SCOPE("findRotatedBoundingBoxesFromOutline", "validateBlobs");
 
     // Find the rotated rectangles for each blob based on its outline
     std::vector<cv::RotatedRect> minRect;
@@ -128,10 +126,6 @@ namespace hole_fusion
       // Push back the 4 vertices of rectangle i
       outRectangles->push_back(rect_points_vector);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("findRotatedBoundingBoxesFromOutline");
-    #endif
   }
 
 }  // namespace hole_fusion
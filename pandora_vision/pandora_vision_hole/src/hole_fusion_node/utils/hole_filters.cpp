@@ -69,9 +69,7 @@ namespace hole_fusion
     const int& detectionMethod,
     HolesConveyor* conveyor)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("validateBlobs", "findHoles");
-    #endif
+    PROFILE_SCOPE("validateBlobs", "findHoles");
 
     switch (detectionMethod)
     {
@@ -159,10 +157,6 @@ namespace hole_fusion
     // The end product here is a struct (conveyor) of keypoints,
     // a set of rectangles that enclose them  and the outline of
     // each blob found.
-
-    #ifdef DEBUG_TIME
-    Timer::tick("validateBlobs");
-    #endif
   }
 
 
@@ -195,9 +189,7 @@ namespace hole_fusion
     const std::vector<std::vector<cv::Point2f> >& inContours,
     HolesConveyor* conveyor)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("validateKeypointsToRectangles", "validateBlobs");
-    #endif
+    PROFILE_SCOPE("validateKeypointsToRectangles", "validateBlobs");
 
     for (int keypointId = 0; keypointId < inKeyPoints.size(); keypointId++)
     {
@@ -263,10 +255,6 @@ namespace hole_fusion
       // If the keypoint has no rectangle attached to it,
       // do not insert the hole it corresponds to in struct hole
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("validateKeypointsToRectangles");
-    #endif
   }
 
 }  // namespace hole_fusion
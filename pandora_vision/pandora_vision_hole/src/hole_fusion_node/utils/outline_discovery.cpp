@@ -36,6 +36,7 @@
  *********************************************************************/
 
 #include "hole_fusion_node/utils/outline_discovery.h"
+#include "utils/brushfire.h"
 
 /**
   @namespace pandora_vision
@@ -63,119 +64,41 @@ namespace hole_fusion
     std::vector<cv::Point2f>* blobOutlineVector,
     float* blobArea)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("brushfireKeypoint", "validateBlobs");
-    #endif
-
-    // Get a pointer on the edges image
-    unsigned char* ptr = edgesImage->ptr();
-
-    // The sets needed by the brushfire implementation
-    std::set<unsigned int> current, next, visited;
+    PROFILE_SCOPE("brushfireKeypoint", "validateBlobs");
 
-    // The indices of the blob's outline points stored in a set.
-    // If the blobOutlineVector was used, in it there would be redundant copies
-    // of each outline point
-    std::set<unsigned int> blobOutlineSet;
+    Brushfire& brushfire = Brushfire::local();
 
-    current.insert(
+    brushfire.flood(*edgesImage,
       static_cast<int>(round(inKeyPoint.pt.y) * edgesImage->cols)
-      + static_cast<int>(round(inKeyPoint.pt.x)));
-
-    visited.insert(
-      static_cast<int>(round(inKeyPoint.pt.y) * edgesImage->cols)
-      + static_cast<int>(round(inKeyPoint.pt.x)));
-
-    while (current.size() != 0)
-    {
-      for (std::set<unsigned int>::iterator it = current.begin();
-        it != current.end(); it++)
-      {
-        // Sweep the neighbors of the current point
-        for (int m = -1; m < 2; m++)
-        {
-          for (int n = -1; n < 2; n++)
-          {
-            // This check is needed because it is possible to access
-            // a point diagonal to the current one
-            // that goes out of the image's borders (value == 0),
-            // while it shouldn't.
-            // E.g. this happens when there are "cracks" to the border of a
-            // 1-pixel border
-            if (abs(m) + abs(n) < 2)
-            {
-              // Column-wise coordinate
-              int x = static_cast<int>(*it) % edgesImage->cols + m;
-
-              // Row-wise coordinate
-              int y = static_cast<int>(*it) / edgesImage->cols + n;
-
-              // The index of this neighbor inside image edgesImage
-              int ind = y * edgesImage->cols + x;
-
-              // If this neighbor is not within the image's borders,
-              // discard it and move on
-              if (x < 0 || y < 0 ||
-                x > edgesImage->cols - 1 || y > edgesImage->rows - 1)
-              {
-                continue;
-              }
-
-              // The value of the point with index ind in edgesImage
-              char v = ptr[ind];
-
-              // If this neighbor is a blank pixel and
-              // it has not been visited, put it in set "next"
-              if ((v == 0) && visited.find(ind) == visited.end())
-              {
-                next.insert(ind);
-              }
-
-              // If this neighbor has a non-zero value, it is an outline point
-              if (v != 0)
-              {
-                blobOutlineSet.insert(ind);
-              }
-
-              // Whatever the condition, this neighbor has been visited
-              visited.insert(ind);
-            }
-          }
-        }
-      }
+      + static_cast<int>(round(inKeyPoint.pt.x)), false);
 
-      // The set of all future points becomes the one with which the
-      // brushfire will begin
-      current.swap(next);
-
-      // Clear set "next" for the next iteration
-      next.clear();
-    }
+    // The outline points are reported in raster order
+    std::vector<unsigned int> outline = brushfire.outline();
+    std::sort(outline.begin(), outline.end());
 
-    // Fill the blobOutlineVector with the
-    // transformed content of the blobOutlineSet
-    for (std::set<unsigned int>::iterator it = blobOutlineSet.begin();
-      it != blobOutlineSet.end(); it++)
+    for (unsigned int i = 0; i < outline.size(); i++)
     {
       blobOutlineVector->push_back(
         cv::Point2f(
-          static_cast<int>(*it) % edgesImage->cols,
-          static_cast<int>(*it) / edgesImage->cols));
+          static_cast<int>(outline[i]) % edgesImage->cols,
+          static_cast<int>(outline[i]) / edgesImage->cols));
     }
 
-    // The area of the blob is essentialy the number of points visited
-    *blobArea = static_cast<float>(visited.size());
-
-    #ifdef DEBUG_TIME
-    Timer::tick("brushfireKeypoint");
-    #endif
+    // The area of the blob is essentialy the number of points visited.
+    // A non-zero seed is both in the region and in the outline
+    unsigned int seed = brushfire.region()[0];
+    *blobArea = static_cast<float>(
+      brushfire.region().size() + brushfire.outline().size()
+      - (edgesImage->ptr()[seed] != 0 ? 1 : 0));
   }
 
 
 
   /**
     @brief Implements the brushfire algorithm for all blob keypoints
-    in order to find blobs' outlines
+    in order to find blobs' outlines. Keypoints lying in an area of zero
+    value pixels already flooded for a previous keypoint share its outline
+    and area, so every area of the image is flooded at most once
     @param[in] inKeyPoints [const std::vector<cv::KeyPoint>&] The keypoints
     @param[in] edgesImage [cv::Mat*] The input image
     @param[out] blobsOutlineVector [std::vector<std::vector<cv::Point2f> >*]
@@ -189,12 +112,33 @@ namespace hole_fusion
     std::vector<std::vector<cv::Point2f> >* blobsOutlineVector,
     std::vector<float>* blobsArea)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("brushfireKeypoint", "validateBlobs");
-    #endif
+    PROFILE_SCOPE("brushfireKeypoint", "validateBlobs");
+
+    Brushfire& brushfire = Brushfire::local();
+    brushfire.reset(edgesImage->rows, edgesImage->cols);
+
+    // The position in the output vectors of the result of every flood, or
+    // -1 if the flood started on an outline pixel and may have expanded
+    // into more than one area
+    std::vector<int> floodResults;
 
     for (int keypointId = 0; keypointId < inKeyPoints.size(); keypointId++)
     {
+      unsigned int seed =
+        static_cast<int>(round(inKeyPoints[keypointId].pt.y)
+          * edgesImage->cols)
+        + static_cast<int>(round(inKeyPoints[keypointId].pt.x));
+
+      int flood = brushfire.label(seed);
+      if (edgesImage->ptr()[seed] == 0 && flood >= 0
+        && floodResults[flood] >= 0)
+      {
+        blobsOutlineVector->push_back(
+          (*blobsOutlineVector)[floodResults[flood]]);
+        blobsArea->push_back((*blobsArea)[floodResults[flood]]);
+        continue;
+      }
+
       // The outline points of the current blob
       std::vector<cv::Point2f> blobOutlineVector;
 
@@ -205,16 +149,15 @@ namespace hole_fusion
       brushfireKeypoint(
         inKeyPoints[keypointId], edgesImage, &blobOutlineVector, &blobArea);
 
+      floodResults.push_back(edgesImage->ptr()[seed] == 0 ?
+        static_cast<int>(blobsArea->size()) : -1);
+
       // Push back the blobOutlineVector to the overall outline points vector
       blobsOutlineVector->push_back(blobOutlineVector);
 
       // Push back the area of the blob to the overall areas vector
       blobsArea->push_back(blobArea);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("brushfireKeypoint");
-    #endif
   }
 
 
@@ -226,7 +169,7 @@ namespace hole_fusion
     @param[in] inPoint [const cv::Point2f&] The input point
     @param[in] inImage [cv::Mat*] The input image
     @param[out] visited [std::set<unsigned int>*] The points between two
-    areas of non-zero value pixels.
+    areas of non-zero value pixels. Points already in it are not expanded.
     @return void
    **/
   void OutlineDiscovery::brushfirePoint(
@@ -234,84 +177,44 @@ namespace hole_fusion
     cv::Mat* inImage,
     std::set<unsigned int>* visited)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("brushfirePoint");
-    #endif
-
-    // Get a pointer on the input image
-    unsigned char* ptr = inImage->ptr();
-
-    // The sets needed by the brushfire implementation
-    std::set<unsigned int> current, next;
-
-    current.insert(static_cast<int>(round(inPoint.y) * inImage->cols)
-      + static_cast<int>(round(inPoint.x)));
-    visited->insert(static_cast<int>(round(inPoint.y) * inImage->cols)
-      + static_cast<int>(round(inPoint.x)));
-
-    while (current.size() != 0)
+    PROFILE_SCOPE("brushfirePoint", "");
+
+    Brushfire& brushfire = Brushfire::localFenced();
+    brushfire.reset(inImage->rows, inImage->cols);
+
+    // The exclusions of the brushfire are the pixels of visited, each one
+    // stamped once, after the flood that reached it. The set is stamped
+    // anew only when it does not match them, i.e. it was emptied or filled
+    // by someone else since the previous call
+    if (visited->size() != brushfire.excludedCount()
+      || (!visited->empty() && (!brushfire.excluded(*visited->begin())
+          || !brushfire.excluded(*visited->rbegin()))))
     {
-      for (std::set<unsigned int>::iterator it = current.begin() ;
-        it != current.end() ; it++)
+      brushfire.clearExclusions(inImage->rows, inImage->cols);
+      for (std::set<unsigned int>::iterator it = visited->begin();
+        it != visited->end(); it++)
       {
-        // sweep the neighbors of the current point
-        for (int m = -1; m < 2; m++)
-        {
-          for (int n = -1; n < 2; n++)
-          {
-            // This check is needed because it is possible to access
-            // a point diagonal to the current one
-            // that goes out of the image's borders (value == 0),
-            // while it shouldn't.
-            // E.g. this happens when there are "cracks" to the border of a
-            // 1-pixel border
-            if (abs(m) + abs(n) < 2)
-            {
-              // Column-wise coordinate
-              int x = static_cast<int>(*it) % inImage->cols + m;
-
-              // Row-wise coordinate
-              int y = static_cast<int>(*it) / inImage->cols + n;
-
-              // The index of this neighbor inside image inImage
-              int ind = y * inImage->cols + x;
-
-              // If this neighbor is not within the image's borders,
-              // discard it and move on
-              if (x < 0 || y < 0 ||
-                x > inImage->cols - 1 || y > inImage->rows - 1)
-              {
-                continue;
-              }
-
-              // The value of the point with index ind in edgesImage
-              char v = ptr[ind];
-
-              // If this neighbor is a blank pixel and
-              // it has not been visited, put it in set "next"
-              if ((v == 0) && visited->find(ind) == visited->end())
-              {
-                next.insert(ind);
-              }
-
-              // Whatever the condition, this neighbor has been visited
-              visited->insert(ind);
-            }
-          }
-        }
+        brushfire.exclude(*it);
       }
+    }
 
-      // The set of all future points becomes the one with which the
-      // brushfire will begin
-      current.swap(next);
+    brushfire.flood(*inImage,
+      static_cast<int>(round(inPoint.y) * inImage->cols)
+      + static_cast<int>(round(inPoint.x)), false);
 
-      // Clear set "next" for the next iteration
-      next.clear();
+    const std::vector<unsigned int>& region = brushfire.region();
+    const std::vector<unsigned int>& outline = brushfire.outline();
+    for (unsigned int i = 0; i < region.size(); i++)
+    {
+      brushfire.exclude(region[i]);
+    }
+    for (unsigned int i = 0; i < outline.size(); i++)
+    {
+      brushfire.exclude(outline[i]);
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("brushfirePoint");
-    #endif
+    visited->insert(region.begin(), region.end());
+    visited->insert(outline.begin(), outline.end());
   }
 
 
@@ -328,9 +231,7 @@ namespace hole_fusion
   void OutlineDiscovery::getOutlineOfMask(const cv::Mat& image,
     std::vector<cv::Point2f>* outline)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("getOutlineFromMask", "mergeHoles");
-    #endif
+    PROFILE_SCOPE("getOutlineFromMask", "mergeHoles");
 
     if (image.type() != CV_8UC1)
     {
@@ -360,10 +261,6 @@ namespace hole_fusion
       }
     }
 
-
-    #ifdef DEBUG_TIME
-    Timer::tick("getOutlineFromMask");
-    #endif
   }
 
 
@@ -403,9 +300,7 @@ namespace hole_fusion
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::start("getShapesClearBorder", "denoiseEdges");
-    #endif
+    PROFILE_SCOPE("getShapesClearBorder", "denoiseEdges");
 
     // Kernels for obtaining boundary pixels
     static const char kernels[8][3][3] = {
@@ -571,10 +466,6 @@ namespace hole_fusion
 
     bordersImage.copyTo(*inImage);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("getShapesClearBorder");
-    #endif
-
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_get_shapes_clear_border)  // Debug
     {
@@ -630,9 +521,7 @@ namespace hole_fusion
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::start("getShapesClearBorderSimple", "denoiseEdges");
-    #endif
+    PROFILE_SCOPE("getShapesClearBorderSimple", "denoiseEdges");
 
     cv::Mat floodFilledImage;
     inImage->copyTo(floodFilledImage);
@@ -718,10 +607,6 @@ namespace hole_fusion
 
     bordersImage.copyTo(*inImage);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("getShapesClearBorderSimple");
-    #endif
-
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_get_shapes_clear_border)  // Debug
     {
@@ -767,9 +652,7 @@ namespace hole_fusion
     std::vector<cv::Point2f>* blobOutlineVector,
     float* blobArea)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("raycastKeypoint");
-    #endif
+    PROFILE_SCOPE("raycastKeypoint", "");
 
     // Get a pointer on edgesImage
     unsigned char* ptr = edgesImage->ptr();
@@ -936,10 +819,6 @@ namespace hole_fusion
 
     // The final outline points vector
     *blobOutlineVector = keypointOutline;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("raycastKeypoint");
-    #endif
   }
 
 
@@ -966,9 +845,7 @@ namespace hole_fusion
     std::vector<std::vector<cv::Point2f> >* blobsOutlineVector,
     std::vector<float>* blobsArea)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("raycastKeypoint", "validateBlobs");
-    #endif
+    PROFILE_SCOPE("raycastKeypoint", "validateBlobs");
 
     for (int i = 0; i < inKeyPoints.size(); i++)
     {
@@ -992,10 +869,6 @@ namespace hole_fusion
       // Push the blob's outline back into the vector of blobs' outline points
       blobsOutlineVector->push_back(keypointOutline);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("raycastKeypoint");
-    #endif
   }
 }  // namespace hole_fusion
 }  // namespace pandora_vision_hole
@@ -50,9 +50,7 @@ namespace hole_fusion
   cv::Mat Wavelets::convCols(const cv::Mat& in,
     const std::vector<float>& kernel)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("convCols", "getLowLow");
-    #endif
+    PROFILE_SCOPE("convCols", "getLowLow");
 
     int length = in.rows + kernel.size() - 1;
 
@@ -76,19 +74,13 @@ namespace hole_fusion
       }
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("convCols");
-    #endif
-
     return temp;
   }
 
   cv::Mat Wavelets::convRows(const cv::Mat& in,
     const std::vector<float>& kernel)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("convRows", "getLowLow");
-    #endif
+    PROFILE_SCOPE("convRows", "getLowLow");
 
     int length = in.cols + kernel.size() - 1;
 
@@ -112,10 +104,6 @@ namespace hole_fusion
       }
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("convRows");
-    #endif
-
     return temp;
   }
 
@@ -168,9 +156,7 @@ namespace hole_fusion
     const double& min, const double& max,
     cv::Mat* outImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("getLowLow", "inputDepthImageCallback");
-    #endif
+    PROFILE_SCOPE("getLowLow", "inputDepthImageCallback");
 
     cv::Mat temp = cv::Mat(inImage.size(), CV_8UC1);
 
@@ -202,10 +188,6 @@ namespace hole_fusion
     // After obtaining the low-low, reverse the scale operation, in an
     // attempt to approximate the initial depth image's values
     *outImage = wave.getLowLow(doubled, H0) * (max - min);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("getLowLow");
-    #endif
   }
 
 
@@ -220,9 +202,7 @@ namespace hole_fusion
    **/
   void Wavelets::getLowLow(const cv::Mat& inImage, cv::Mat* outImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("getLowLow", "inputRgbImageCallback");
-    #endif
+    PROFILE_SCOPE("getLowLow", "inputRgbImageCallback");
 
     Wavelets wave;
 
@@ -271,10 +251,6 @@ namespace hole_fusion
 
     // Copy out to the output image
     out.copyTo(*outImage);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("getLowLow");
-    #endif
   }
 
 }  // namespace hole_fusion
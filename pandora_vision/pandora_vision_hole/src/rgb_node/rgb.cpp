@@ -89,8 +89,8 @@ namespace rgb
     Histogram::getHistogram(&wallsHistogram_,
       Parameters::Histogram::secondary_channel);
 
-    // Subscribe to the RGB image published by the
-    // rgb_depth_synchronizer node
+    // Subscribe to the frames, holding the RGB image, published by the
+    // synchronizer node
     rgbImageSubscriber_= nodeHandle_.subscribe(rgbImageTopic_, 1,
       &Rgb::inputRgbImageCallback, this);
 
@@ -132,29 +132,28 @@ namespace rgb
 
 
   /**
-    @brief Callback for the rgb image received by the synchronizer node.
+    @brief Callback for the frame published by the synchronizer node.
 
-    The rgb image message received by the synchronizer node is unpacked
-    in a cv::Mat image. Holes are then located inside this image and
+    The frame's rgb image is viewed as a cv::Mat image, without being
+    copied. Holes are then located inside this image and
     information about them, along with the rgb image, is then sent to the
     hole fusion node
-    @param msg [const sensor_msgs::Image&] The rgb image message
+    @param msg [const SynchronizedFrameConstPtr&]
+    The synchronized frame
     @return void
   **/
   void
   Rgb::
-  inputRgbImageCallback(const sensor_msgs::ImageConstPtr& msg)
+  inputRgbImageCallback(
+    const SynchronizedFrameConstPtr& msg)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("inputRgbImageCallback", "", true);
-    #endif
+    PROFILE_ROOT_SCOPE("inputRgbImageCallback");
 
-    // Obtain the rgb image. Since the image is in a format of
-    // sensor_msgs::Image, it has to be transformed into a cv format in order
-    // to be processed. Its cv format will be CV_8UC3.
-    cv::Mat rgbImage;
-    MessageConversions::extractImageFromMessage(*msg, &rgbImage,
-      sensor_msgs::image_encodings::BGR8);
+    // Obtain the rgb image. Its cv format will be CV_8UC3.
+    // Its pixels are those of the frame, which the other nodes in the
+    // manager share as well: they must not be modified
+    cv::Mat rgbImage = cv_bridge::toCvShare(msg->rgbImage, msg,
+      sensor_msgs::image_encodings::BGR8)->image;
 
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_rgb_image)
@@ -165,15 +164,17 @@ namespace rgb
 
     // Regardless of the image representation method, the RGB node
     // will publish the RGB image of original size to the Hole Fusion node
-    cv::Mat rgbImageSent;
-    rgbImage.copyTo(rgbImageSent);
+    cv::Mat rgbImageSent = rgbImage;
 
     // A value of 1 means that the rgb image is subtituted by its
     // low-low, wavelet analysis driven, part
     if (Parameters::Image::image_representation_method == 1)
     {
-      // Obtain the low-low part of the rgb image via wavelet analysis
-      Wavelets::getLowLow(rgbImage, &rgbImage);
+      // Obtain the low-low part of the rgb image via wavelet analysis,
+      // into an image of its own
+      cv::Mat lowLowRgbImage;
+      Wavelets::getLowLow(rgbImage, &lowLowRgbImage);
+      rgbImage = lowLowRgbImage;
     }
 
     // Locate potential holes in the rgb image
@@ -189,15 +190,10 @@ namespace rgb
         conveyor,
         rgbImageSent,
         rgbCandidateHolesMsgPtr,
-        sensor_msgs::image_encodings::TYPE_8UC3, *msg);
+        sensor_msgs::image_encodings::TYPE_8UC3, msg->rgbImage);
 
     // Publish the candidate holes message
     candidateHolesPublisher_.publish(rgbCandidateHolesMsgPtr);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("inputRgbImageCallback");
-    Timer::printAllMeansTree();
-    #endif
   }
 
   /**
@@ -211,11 +207,11 @@ namespace rgb
   getTopicNames()
   {
     // Read the name of the topic from where the rgb node acquires the
-    // rgb image and store it in a private member variable
-    if (!privateNodeHandle_.getParam("subscribed_topics/rgb_image_topic",
+    // synchronized frames and store it in a private member variable
+    if (!privateNodeHandle_.getParam("subscribed_topics/synchronized_frame_topic",
         rgbImageTopic_))
     {
-      NODELET_FATAL("[%s] Could not find topic rgb_image_topic", nodeName_.c_str());
+      NODELET_FATAL("[%s] Could not find topic synchronized_frame_topic", nodeName_.c_str());
       ROS_BREAK();
     }
     // Read the name of the topic to which the rgb node will be publishing
@@ -63,9 +63,7 @@ namespace rgb
   HolesConveyor RgbHoleDetector::findHoles(const cv::Mat& rgbImage,
     const std::vector<cv::MatND>& histogram)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("findHoles", "inputRgbImageCallback");
-    #endif
+    PROFILE_SCOPE("findHoles", "inputRgbImageCallback");
 
     #ifdef DEBUG_SHOW
     std::string msg;
@@ -162,10 +160,6 @@ namespace rgb
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::tick("findHoles");
-    #endif
-
     return conveyor;
   }
 
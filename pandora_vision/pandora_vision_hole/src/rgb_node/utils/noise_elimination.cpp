@@ -36,6 +36,7 @@
  *********************************************************************/
 
 #include "rgb_node/utils/noise_elimination.h"
+#include "utils/brushfire.h"
 
 /**
   @namespace pandora_vision
@@ -65,40 +66,27 @@ namespace rgb
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("brushfireNear", "performNoiseElimination");
-    #endif
+    PROFILE_SCOPE("brushfireNear", "performNoiseElimination");
 
     inImage.copyTo(*outImage);
 
-    bool finished = false;
+    Brushfire& brushfire = Brushfire::local();
+    brushfire.reset(outImage->rows, outImage->cols);
 
-    while (!finished)
+    // Each concentration of black pixels is met once, at its first pixel in
+    // raster order. One whose value could not be found stays black, but it
+    // is labelled and will not be flooded again
+    for (unsigned int i = 1; i < outImage->rows - 1; i++)
     {
-      finished = true;
-
-      for (unsigned int i = 1; i < outImage->rows - 1; i++)
+      for (unsigned int j = 1; j < outImage->cols - 1; j++)
       {
-        for (unsigned int j = 1; j < outImage->cols - 1; j++)
+        if (outImage->at<float>(i, j) == 0.0  // Found black
+          && brushfire.label(i * outImage->cols + j) < 0)
         {
-          if (outImage->at<float>(i, j) == 0.0)  // Found black
-          {
-            brushfireNearStep(outImage, i * outImage->cols + j);
-            finished = false;
-            break;
-          }
-        }
-
-        if (!finished)
-        {
-          break;
+          brushfireNearStep(outImage, i * outImage->cols + j);
         }
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("brushfireNear");
-    #endif
   }
 
 
@@ -121,51 +109,12 @@ namespace rgb
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("brushfireNearStep");
-    #endif
-
-    int x = index / image->cols;
-    int y = index % image->cols;
+    PROFILE_SCOPE("brushfireNearStep", "");
 
-    std::vector<int> current, next;
-    std::set<int> visited;
+    Brushfire& brushfire = Brushfire::local();
+    brushfire.flood(*image, index, true);
 
-    current.push_back(x * image->cols + y);
-    visited.insert(x * image->cols + y);
-
-    while (current.size() != 0)
-    {
-      for (int i = 0; i < current.size(); i++)
-      {
-        for (int m = -1 ; m < 2 ; m++)
-        {
-          for (int n = -1 ; n < 2 ; n++)
-          {
-            x = current[i] / image->cols + m;
-            y = current[i] % image->cols + n;
-
-            // Boundaries check.
-            // If a neighboring points goes out of bounds, discard it
-            if (x < 0 || y < 0 ||
-              x > image->rows - 1 || y > image->cols - 1)
-            {
-              continue;
-            }
-
-            if ((image->at<float>(x, y) == 0.0) &&
-              visited.find(x * image->cols + y) == visited.end())
-            {
-              next.push_back(x * image->cols + y);
-              visited.insert(x * image->cols + y);
-            }
-          }
-        }
-      }
-
-      current.swap(next);
-      next.clear();
-    }
+    const std::vector<unsigned int>& visited = brushfire.region();
 
     // Find the lowest non-zero value outside this concentration of
     // zero-value pixels
@@ -174,11 +123,10 @@ namespace rgb
     float val = 0.0;
     const float noise = 0.0;
 
-    for (std::set<int>::iterator it = visited.begin();
-      it != visited.end(); it++)
+    for (unsigned int i = 0; i < visited.size(); i++)
     {
-      x = *it / image->cols;
-      y = *it % image->cols;
+      int x = visited[i] / image->cols;
+      int y = visited[i] % image->cols;
 
       // Because we will check for the value of neighboring points,
       // if a point happens to be on the edges, it probably won't have any
@@ -212,16 +160,12 @@ namespace rgb
       // Now that the lowest value of non-zero neighboring pixels of
       // this black concentration of pixels has been found,
       // assign it to the whole of the concentration
-      for (std::set<int>::iterator it = visited.begin();
-        it != visited.end(); it++)
+      for (unsigned int i = 0; i < visited.size(); i++)
       {
-        image->at<float>(*it / image->cols, *it % image->cols) = lower;
+        image->at<float>(visited[i] / image->cols, visited[i] % image->cols) =
+          lower;
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("brushfireNearStep");
-    #endif
   }
 
 
@@ -241,9 +185,7 @@ namespace rgb
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("chooseInterpolationMethod");
-    #endif
+    PROFILE_SCOPE("chooseInterpolationMethod", "");
 
     // The number of zero value pixels
     unsigned int blacks = 0;
@@ -284,10 +226,6 @@ namespace rgb
     {
       Parameters::Depth::interpolation_method = 0;
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("chooseInterpolationMethod");
-    #endif
   }
 
 
@@ -308,9 +246,7 @@ namespace rgb
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("interpolateImageBorders");
-    #endif
+    PROFILE_SCOPE("interpolateImageBorders", "");
 
     // interpolate the pixels at the edges of the inImage
     // interpolate the rows
@@ -345,10 +281,6 @@ namespace rgb
     // bottom right
     inImage->at<float>(inImage->rows - 1, inImage->cols - 1) =
       inImage->at<float>(inImage->rows - 2, inImage->cols - 2);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("interpolateImageBorders");
-    #endif
   }
 
 
@@ -494,21 +426,45 @@ namespace rgb
   void NoiseElimination::interpolation(const cv::Mat& inImage,
     cv::Mat* outImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("interpolation", "performNoiseElimination");
-    #endif
+    PROFILE_SCOPE("interpolation", "performNoiseElimination");
 
     inImage.copyTo(*outImage);
 
     // in the end, only pixels adjacent to the edge of the
-    // image are left black
-    while (interpolationIteration(outImage)){}
+    // image are left black. The same as iterating interpolationIteration
+    // until no pixel changes, with every pixel visited once
+    Brushfire::local().meanFill(outImage);
 
     interpolateImageBorders(outImage);
+  }
+
+
 
-    #ifdef DEBUG_TIME
-    Timer::tick("interpolation");
-    #endif
+  /**
+    @brief Interpolates the noise produced by the depth sensor, giving
+    every black pixel the value of its nearest non-black pixel. The nearest
+    pixels are found by jump flooding, whose cost does not depend on the
+    size of the black areas
+    @param[in] inImage [const cv::Mat&] The input image
+    @param[out] outImage [cv::Mat*] The output image
+    @return void
+   **/
+  void NoiseElimination::jumpFloodNearest(const cv::Mat& inImage,
+    cv::Mat* outImage)
+  {
+    if (inImage.type() != CV_32FC1)
+    {
+      ROS_ERROR_NAMED(PKG_NAME,
+        "NoiseElimination::jumpFloodNearest : Inappropriate image type.");
+
+      return;
+    }
+
+    PROFILE_SCOPE("jumpFloodNearest", "performNoiseElimination");
+
+    inImage.copyTo(*outImage);
+
+    Brushfire::local().nearestFill(outImage);
   }
 
 
@@ -555,9 +511,7 @@ namespace rgb
   void NoiseElimination::performNoiseElimination(const cv::Mat& inImage,
     cv::Mat* outImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("performNoiseElimination", "findHoles");
-    #endif
+    PROFILE_SCOPE("performNoiseElimination", "findHoles");
 
     chooseInterpolationMethod(inImage);
 
@@ -565,7 +519,14 @@ namespace rgb
     {
       case 0:  // Thinning-like interpolation
         {
-          interpolation(inImage, outImage);
+          if (Parameters::Depth::use_jump_flooding)
+          {
+            jumpFloodNearest(inImage, outImage);
+          }
+          else
+          {
+            interpolation(inImage, outImage);
+          }
           break;
         }
       case 1:  // Produce the near brushfire image
@@ -579,10 +540,6 @@ namespace rgb
           break;
         }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("performNoiseElimination");
-    #endif
   }
 
 
@@ -596,9 +553,7 @@ namespace rgb
   void NoiseElimination::transformNoiseToWhite(const cv::Mat& inImage,
     cv::Mat* outImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("transformNoiseToWhite", "performNoiseElimination");
-    #endif
+    PROFILE_SCOPE("transformNoiseToWhite", "performNoiseElimination");
 
     inImage.copyTo(*outImage);
 
@@ -612,10 +567,6 @@ namespace rgb
         }
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("transformNoiseToWhite");
-    #endif
   }
 
 }  // namespace rgb
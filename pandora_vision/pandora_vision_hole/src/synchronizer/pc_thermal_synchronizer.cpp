@@ -43,10 +43,9 @@
 #include <pluginlib/class_list_macros.h>
 #include <sensor_msgs/PointCloud2.h>
 #include <sensor_msgs/Image.h>
-#include <pcl_ros/point_cloud.h>
-#include <pcl/conversions.h>
 
 #include "distrib_msgs/FlirLeptonMsg.h"
+#include "pandora_vision_common/pandora_vision_utilities/pointcloud_to_image_converter.h"
 
 #include "hole_fusion_node/utils/defines.h"
 #include "hole_fusion_node/utils/noise_elimination.h"
@@ -94,6 +93,8 @@ namespace pandora_vision_hole
     nh_.param("rgbd_mode", rgbdMode_, false);
     nh_.param("rgbdt_mode", rgbdtMode_, false);
     private_nh_.param("simulating", simulating_, false);
+    private_nh_.param("use_jump_flooding",
+      hole_fusion::Parameters::Depth::use_jump_flooding, false);
 
     // The synchronizer node starts off in life locked, waiting for the
     // hole fusion node to unlock him
@@ -179,22 +180,12 @@ namespace pandora_vision_hole
  *                                 Publishers                                 *
  ******************************************************************************/
 
-    //if (rgbdMode_ || rgbdtMode_j
-    //{
-    //  // Advertise the synchronized point cloud
-      synchronizedPointCloudPublisher_ = nh_.advertise
-        <PointCloud>(synchronizedPointCloudTopic_, 1);
-    //}
-
     //if (rgbdMode_ || rgbdtMode_)
     //{
-      // Advertise the synchronized depth image
-      synchronizedDepthImagePublisher_ = nh_.advertise
-        <sensor_msgs::Image>(synchronizedDepthImageTopic_, 1);
-
-      // Advertise the synchronized rgb image
-      synchronizedRgbImagePublisher_ = nh_.advertise
-        <sensor_msgs::Image>(synchronizedRgbImageTopic_, 1);
+      // Advertise the synchronized frame: the point cloud and the depth
+      // and rgb images extracted from it
+      synchronizedFramePublisher_ = nh_.advertise
+        < SynchronizedFrame >(synchronizedFrameTopic_, 1);
     //}
 
     //if (rgbdtMode_ || thermalMode_)
@@ -232,25 +223,20 @@ namespace pandora_vision_hole
   PcThermalSynchronizer::
   inputPointCloudCallback(const sensor_msgs::PointCloud2ConstPtr& pcMsg)
   {
-    sensor_msgs::ImagePtr rgbImageMessagePtr, depthImageMessagePtr;
-    PointCloudPtr pointCloudPtr;
-    initCallback(pointCloudPtr, rgbImageMessagePtr, depthImageMessagePtr, pcMsg);
+    SynchronizedFramePtr framePtr(
+        new SynchronizedFrame );
+    initCallback(framePtr, pcMsg);
 
-    boost::shared_ptr<pandora_vision_msgs::EnhancedImage> enhancedImagePtr(
-        new pandora_vision_msgs::EnhancedImage );
-    enhancedImagePtr->header = pcMsg->header;
-    enhancedImagePtr->rgbImage = *rgbImageMessagePtr;
-    enhancedImagePtr->depthImage = *depthImageMessagePtr;
-    enhancedImagePtr->isDepth = (hole_fusion::Parameters::Depth::interpolation_method == 0);
-
-    enhancedImagePublisher_.publish(enhancedImagePtr);
+    publishEnhancedImage(*framePtr);
 
     if (!holeFusionLocked_)
     {
       holeFusionLocked_ = true;
-      synchronizedPointCloudPublisher_.publish(pointCloudPtr);
-      synchronizedRgbImagePublisher_.publish(rgbImageMessagePtr);
-      synchronizedDepthImagePublisher_.publish(depthImageMessagePtr);
+
+      // The frame is not to be modified once published: the nodelets in
+      // the same manager receive this very message
+      setFramePointCloud(framePtr, pcMsg);
+      synchronizedFramePublisher_.publish(framePtr);
 
       // inputPointCloudSubscriber_.shutdown();
     }
@@ -263,9 +249,8 @@ namespace pandora_vision_hole
     If the synchronizer node is unlocked, it extracts a depth image from
     the input point cloud's depth measurements, an RGB image from the colour
     measurements of the input point cloud and thermal info.
-    Then publishes these images
-    to their respective recipients. Finally, the input point cloud is
-    published directly to the hole fusion node.
+    Then publishes these images, along with the input point cloud, as one
+    synchronized frame, and the thermal info to its recipients.
     @param[in] synchronizedMessage [pandora_vision_msgs::SynchronizedMsg&]
     the input synchronized thermal and pc info
     @return void
@@ -276,18 +261,12 @@ namespace pandora_vision_hole
       const sensor_msgs::PointCloud2ConstPtr& pcMsg,
       const distrib_msgs::FlirLeptonMsgConstPtr& thermalMsg)
   {
-    sensor_msgs::ImagePtr rgbImageMessagePtr, depthImageMessagePtr;
-    PointCloudPtr pointCloudPtr;
-    initCallback(pointCloudPtr, rgbImageMessagePtr, depthImageMessagePtr, pcMsg);
+    SynchronizedFramePtr framePtr(
+        new SynchronizedFrame );
+    initCallback(framePtr, pcMsg);
 
-    boost::shared_ptr<pandora_vision_msgs::EnhancedImage> enhancedImagePtr(
-        new pandora_vision_msgs::EnhancedImage );
-    enhancedImagePtr->header = pcMsg->header;
-    enhancedImagePtr->rgbImage = *rgbImageMessagePtr;
-    enhancedImagePtr->depthImage = *depthImageMessagePtr;
-    enhancedImagePtr->isDepth = (hole_fusion::Parameters::Depth::interpolation_method == 0);
-
-    enhancedImagePublisher_.publish(enhancedImagePtr);
+    boost::shared_ptr<pandora_vision_msgs::EnhancedImage> enhancedImagePtr =
+      publishEnhancedImage(*framePtr);
 
     if (!thermalLocked_ || !holeFusionLocked_)
     {
@@ -303,9 +282,8 @@ namespace pandora_vision_hole
         if (rgbdtMode_)
           thermalIndex->data = thermalIndex->data + "hole";
 
-        synchronizedPointCloudPublisher_.publish(pointCloudPtr);
-        synchronizedRgbImagePublisher_.publish(rgbImageMessagePtr);
-        synchronizedDepthImagePublisher_.publish(depthImageMessagePtr);
+        setFramePointCloud(framePtr, pcMsg);
+        synchronizedFramePublisher_.publish(framePtr);
       }
 
       if ((thermalMode_ && !thermalLocked_) || (rgbdtMode_ && !holeFusionLocked_))
@@ -441,53 +419,41 @@ namespace pandora_vision_hole
     // }
   }
 
+  /**
+    @brief Extracts the RGB and the interpolated depth image of a frame
+    from the input point cloud, in a single pass over its buffer
+    @param[out] framePtr [const SynchronizedFramePtr&]
+    The frame whose header, images and isDepth flag are set
+    @param[in] pcMsg [const sensor_msgs::PointCloud2ConstPtr&] The input
+    point cloud
+    @return void
+   **/
   void
   PcThermalSynchronizer::
   initCallback(
-      PointCloudPtr& pcPtr,
-      sensor_msgs::ImagePtr& rgbImageMessagePtr,
-      sensor_msgs::ImagePtr& depthImageMessagePtr,
+      const SynchronizedFramePtr& framePtr,
       const sensor_msgs::PointCloud2ConstPtr& pcMsg)
   {
-    // Exctract the pointcloud from the message and convert it
-    // to PointCloud<T>::Ptr type.
-    // pcl::PCLPointCloud2 pcl_pc;
-    // pcl_conversions::toPCL(*pcMsg, pcl_pc);
-    pcPtr = boost::make_shared<PointCloud>();
-    pcl::fromROSMsg(*pcMsg, *pcPtr);
+    framePtr->header = pcMsg->header;
 
-    if (simulating_)
-    {
-      // The input point cloud is unorganized, in other words,
-      // simulation is running. Variables are needed to be set in order for
-      // the point cloud to be functionally exploitable.
-      if (pcPtr->height == 1)
-      {
-        // The point cloud's height
-        pcPtr->height = hole_fusion::Parameters::Image::HEIGHT;
+    // Extract the RGB and depth images from the point cloud, in a single
+    // pass over the message's buffer
+    cv::Mat rgbImage, depthImage;
+    PointCloudToImageConverter::extractImages(*pcMsg, &rgbImage, &depthImage, NULL);
 
-        // The point cloud's width
-        pcPtr->width = hole_fusion::Parameters::Image::WIDTH;
-      }
+    // The input point cloud is unorganized, in other words,
+    // simulation is running: shape the images after the parameters
+    if (simulating_ && pcMsg->height == 1)
+    {
+      rgbImage = rgbImage.reshape(0, hole_fusion::Parameters::Image::HEIGHT);
+      depthImage = depthImage.reshape(0, hole_fusion::Parameters::Image::HEIGHT);
     }
 
-    // Extract the RGB image from the point cloud
-
-    // cv::Mat rgbImage = hole_fusion::MessageConversions::convertPointCloudMessageToImage(
-    //   pcPtr, CV_8UC3);
-    // cv_bridge::CvImagePtr rgbImageConverter( new cv_bridge::CvImage() );
-    // rgbImageConverter->header = pcMsg->header;
-    // rgbImageConverter->encoding = sensor_msgs::image_encodings::BGR8;
-    // rgbImageConverter->image = rgbImage;
-    // rgbImageMessagePtr = rgbImageConverter->toImageMsg();
+    // The images are converted straight into the frame's fields
+    cv_bridge::CvImage rgbImageConverter(pcMsg->header,
+      sensor_msgs::image_encodings::BGR8, rgbImage);
+    rgbImageConverter.toImageMsg(framePtr->rgbImage);
 
-    rgbImageMessagePtr = boost::make_shared<sensor_msgs::Image>();
-    pcl::toROSMsg(*pcMsg, *rgbImageMessagePtr);
-    rgbImageMessagePtr->header = pcMsg->header;
-
-    // Extract the depth image from the point cloud
-    cv::Mat depthImage = hole_fusion::MessageConversions::convertPointCloudMessageToImage(
-        pcPtr, CV_32FC1);
     cv::Mat interpolatedDepthImage;
     hole_fusion::NoiseElimination::performNoiseElimination(depthImage, &interpolatedDepthImage);
 
@@ -498,15 +464,82 @@ namespace pandora_vision_hole
     }
 #endif
 
-    cv_bridge::CvImagePtr depthImageConverter(new cv_bridge::CvImage());
-    depthImageConverter->header = pcMsg->header;
-    depthImageConverter->encoding = sensor_msgs::image_encodings::TYPE_32FC1;
-    depthImageConverter->image = interpolatedDepthImage;
-    depthImageMessagePtr = depthImageConverter->toImageMsg();
+    cv_bridge::CvImage depthImageConverter(pcMsg->header,
+      sensor_msgs::image_encodings::TYPE_32FC1, interpolatedDepthImage);
+    depthImageConverter.toImageMsg(framePtr->depthImage);
 
-    // depthImageMessagePtr = boost::make_shared<sensor_msgs::Image>();
-    // MessageConversions::toROSDepthMsg(*pcMsg, *depthImageMessagePtr);
-    // depthImageMessagePtr->header = pcMsg->header;
+    // The noise elimination above chooses the interpolation method; only
+    // the first one keeps the depth measurements
+    framePtr->isDepth = (hole_fusion::Parameters::Depth::interpolation_method == 0);
+  }
+
+  /**
+    @brief Converts the input point cloud into the one of a frame that is
+    about to be published, once for all its recipients. It is given the
+    dimensions of the images if it is unorganized (simulation) and the
+    depth of the frame's interpolated depth image, so that the depth-based
+    filters using it have an integral input
+    @param[out] framePtr [const SynchronizedFramePtr&] The frame, whose
+    depth image is already set
+    @param[in] pcMsg [const sensor_msgs::PointCloud2ConstPtr&] The input
+    point cloud
+    @return void
+   **/
+  void
+  PcThermalSynchronizer::
+  setFramePointCloud(
+      const SynchronizedFramePtr& framePtr,
+      const sensor_msgs::PointCloud2ConstPtr& pcMsg)
+  {
+    PointCloudPtr pointCloudPtr(new PointCloud);
+    pcl::fromROSMsg(*pcMsg, *pointCloudPtr);
+
+    if (simulating_ && pcMsg->height == 1)
+    {
+      // Variables are needed to be set in order for the point cloud
+      // to be functionally exploitable
+      pointCloudPtr->height = hole_fusion::Parameters::Image::HEIGHT;
+      pointCloudPtr->width = hole_fusion::Parameters::Image::WIDTH;
+    }
+
+    // The depth values of the input point cloud contain NaNs and
+    // zero-value pixels, which the interpolated depth image does not
+    cv::Mat depthImage = cv_bridge::toCvShare(framePtr->depthImage, framePtr,
+      sensor_msgs::image_encodings::TYPE_32FC1)->image;
+
+    for (unsigned int row = 0; row < pointCloudPtr->height; ++row)
+    {
+      const float* depth = depthImage.ptr<float>(row);
+      for (unsigned int col = 0; col < pointCloudPtr->width; ++col)
+      {
+        pointCloudPtr->points[col + pointCloudPtr->width * row].z = depth[col];
+      }
+    }
+
+    framePtr->pointCloud = pointCloudPtr;
+  }
+
+  /**
+    @brief Publishes the images of a frame as an enhanced image
+    @param[in] frame [const SynchronizedFrame&]
+    The frame
+    @return [boost::shared_ptr<pandora_vision_msgs::EnhancedImage>]
+    The published message
+   **/
+  boost::shared_ptr<pandora_vision_msgs::EnhancedImage>
+  PcThermalSynchronizer::
+  publishEnhancedImage(const SynchronizedFrame& frame)
+  {
+    boost::shared_ptr<pandora_vision_msgs::EnhancedImage> enhancedImagePtr(
+        new pandora_vision_msgs::EnhancedImage );
+    enhancedImagePtr->header = frame.header;
+    enhancedImagePtr->rgbImage = frame.rgbImage;
+    enhancedImagePtr->depthImage = frame.depthImage;
+    enhancedImagePtr->isDepth = frame.isDepth;
+
+    enhancedImagePublisher_.publish(enhancedImagePtr);
+
+    return enhancedImagePtr;
   }
 
 
@@ -612,34 +645,12 @@ namespace pandora_vision_hole
     if (rgbdMode_ || rgbdtMode_)
     {
       // Read the name of the topic that the synchronizer node will be publishing
-      // the input point cloud to
-      if (!private_nh_.getParam("published_topics/point_cloud_internal_topic",
-            synchronizedPointCloudTopic_))
-      {
-        NODELET_FATAL(
-            "[%s] Could not find topic point_cloud_internal_topic", nodeName_.c_str());
-        ROS_BREAK();
-      }
-    }
-
-    if (rgbdMode_ || rgbdtMode_)
-    {
-      // Read the name of the topic that the synchronizer node will be publishing
-      // the depth image extracted from the input point cloud to
-      if (!private_nh_.getParam("published_topics/depth_image_topic",
-            synchronizedDepthImageTopic_))
-      {
-        NODELET_FATAL(
-          "[%s] Could not find topic depth_image_topic", nodeName_.c_str());
-        ROS_BREAK();
-      }
-      // Read the name of the topic that the synchronizer node will be publishing
-      // the depth image extracted from the input point cloud to
-      if (!private_nh_.getParam("published_topics/rgb_image_topic",
-            synchronizedRgbImageTopic_))
+      // the synchronized frame to
+      if (!private_nh_.getParam("published_topics/synchronized_frame_topic",
+            synchronizedFrameTopic_))
       {
         NODELET_FATAL(
-          "[%s] Could not find topic rgb_image_topic", nodeName_.c_str());
+            "[%s] Could not find topic synchronized_frame_topic", nodeName_.c_str());
         ROS_BREAK();
       }
     }
@@ -224,9 +224,7 @@ namespace thermal
 
     NODELET_INFO("[%s] callback", nodeName_.c_str());
 
-#ifdef DEBUG_TIME
-    Timer::start("inputThermalImageCallback", "", true);
-#endif
+    PROFILE_ROOT_SCOPE("inputThermalImageCallback");
 
     //  Obtain the thermal message and extract the temperature information.
     //  Convert this
@@ -437,11 +435,6 @@ namespace thermal
       NODELET_WARN("[%s] Did not find thermal with high enough probability",
           nodeName_.c_str());
     }
-
-#ifdef DEBUG_TIME
-    Timer::tick("inputThermalImageCallback");
-    Timer::printAllMeansTree();
-#endif
   }
 
   void
@@ -61,9 +61,7 @@ namespace thermal
   HolesConveyor ThermalHoleDetector::findHoles(const cv::Mat& thermalImage)
 
   {
-    #ifdef DEBUG_TIME
-    Timer::start("findHoles", "inputThermalImageCallback");
-    #endif
+    PROFILE_SCOPE("findHoles", "inputThermalImageCallback");
 
     #ifdef DEBUG_SHOW
     std::vector<cv::Mat> imgs;
@@ -175,10 +173,6 @@ namespace thermal
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::tick("findHoles");
-    #endif
-
     return conveyor;
   }
 
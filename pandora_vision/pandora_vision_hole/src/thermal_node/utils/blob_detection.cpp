@@ -56,9 +56,7 @@ namespace thermal
   void BlobDetection::detectBlobs(const cv::Mat& inImage,
     std::vector<cv::KeyPoint>* keyPointsOut)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("detectBlobs", "findHoles");
-    #endif
+    PROFILE_SCOPE("detectBlobs", "findHoles");
 
     cv::SimpleBlobDetector::Params params;
 
@@ -99,10 +97,6 @@ namespace thermal
         keyPointsOut->push_back(keyPoints[keypointId]);
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("detectBlobs");
-    #endif
   }
 
 }  // namespace thermal
@@ -36,6 +36,7 @@
  *********************************************************************/
 
 #include "thermal_node/utils/edge_detection.h"
+#include "utils/curve_extraction.h"
 
 /**
   @namespace pandora_vision
@@ -63,9 +64,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("applyCanny", "computeEdges");
-    #endif
+    PROFILE_SCOPE("applyCanny", "computeEdges");
 
     inImage.copyTo(*outImage);
 
@@ -81,10 +80,6 @@ namespace thermal
       Parameters::Edge::canny_low_threshold,
       Parameters::Edge::canny_low_threshold * Parameters::Edge::canny_ratio,
       Parameters::Edge::canny_kernel_size);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyCanny");
-    #endif
   }
 
 
@@ -105,9 +100,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("applyScharr", "computeEdges");
-    #endif
+    PROFILE_SCOPE("applyScharr", "computeEdges");
 
     // appropriate values for scale, delta and ddepth
     int scale = 1;
@@ -137,10 +130,6 @@ namespace thermal
     cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, grad_g);
 
     *outImage = grad_g;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyScharr");
-    #endif
   }
 
 
@@ -161,9 +150,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("applySobel", "computeEdges");
-    #endif
+    PROFILE_SCOPE("applySobel", "computeEdges");
 
     // appropriate values for scale, delta and ddepth
     int scale = 1;
@@ -193,10 +180,6 @@ namespace thermal
     cv::addWeighted(abs_grad_x, 0.5, abs_grad_y, 0.5, 0, grad_g);
 
     *outImage = grad_g;
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applySobel");
-    #endif
   }
 
 
@@ -217,9 +200,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("applyLaplacian", "computeEdges");
-    #endif
+    PROFILE_SCOPE("applyLaplacian", "computeEdges");
 
     // appropriate values for scale, delta and ddepth
     int scale = 1;
@@ -234,10 +215,6 @@ namespace thermal
 
     cv::Laplacian(edges, *outImage, ddepth, 1, scale, delta, cv::BORDER_DEFAULT);
     convertScaleAbs(*outImage, *outImage);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyLaplacian");
-    #endif
   }
 
 
@@ -251,9 +228,7 @@ namespace thermal
    **/
   void EdgeDetection::applyEdgeContamination(cv::Mat* inImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("applyEdgeContamination", "denoiseEdges");
-    #endif
+    PROFILE_SCOPE("applyEdgeContamination", "denoiseEdges");
 
     int rows = inImage->rows;
     int cols = inImage->cols;
@@ -366,10 +341,6 @@ namespace thermal
       current.swap(next);
       next.clear();
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("applyEdgeContamination");
-    #endif
   }
 
 
@@ -400,9 +371,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("computeEdges", "findHoles");
-    #endif
+    PROFILE_SCOPE("computeEdges", "findHoles");
 
     // The input depth image, in CV_8UC1 format
     cv::Mat visualizableDepthImage = Visualization::scaleImageForVisualization(
@@ -427,10 +396,6 @@ namespace thermal
     // Denoise the edges found
     denoisedDepthImageEdges.copyTo(*edges);
     denoiseEdges(edges);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("computeEdges");
-    #endif
   }
 
   /**
@@ -459,9 +424,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("computeEdges", "findHoles");
-    #endif
+    PROFILE_SCOPE("computeEdges", "findHoles");
 
     // The input thermal image, in CV_8UC1 format
     cv::Mat visualizableDepthImage = Visualization::scaleImageForVisualization(
@@ -488,10 +451,6 @@ namespace thermal
     // Denoise the edges found
     denoisedDepthImageEdges.copyTo(*edges);
     denoiseEdges(edges);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("computeEdges");
-    #endif
   }
 
   /**
@@ -528,9 +487,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("computeRgbEdges", "findHoles");
-    #endif
+    PROFILE_SCOPE("computeRgbEdges", "findHoles");
 
     // The edges are detected on the segmented RGB image
     if (extractionMethod == 0)
@@ -553,10 +510,6 @@ namespace thermal
 
     // Denoise the edges image
     denoiseEdges(edges);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("computeRgbEdges");
-    #endif
   }
 
 
@@ -599,9 +552,7 @@ namespace thermal
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::start("connectPairs", "denoiseEdges");
-    #endif
+    PROFILE_SCOPE("connectPairs", "denoiseEdges");
 
     // Connects each pair of points via a line
     if (method == 0)
@@ -618,16 +569,11 @@ namespace thermal
     // Connects each pair of points via an arc
     else if (method == 1)
     {
-      // The input image. On it the elliptical arcs will be drawn
-      cv::Mat inImageDrawnOnce;
-
       // The image on which only the elliptical arcs will be drawn
       cv::Mat addedArcs = cv::Mat::zeros(inImage->size(), CV_8UC1);
 
       for (unsigned int i = 0; i < pairs.size(); i++)
       {
-        inImage->copyTo(inImageDrawnOnce);
-
         // The euclidean distance of the pair
         float pairsDistance = sqrt(
           pow((pairs[i].first.x - pairs[i].second.x), 2) +
@@ -872,39 +818,25 @@ namespace thermal
             }
           }
 
-          // Draw the elliptical curve on the inImageDrawnOnce image
+          // Draw the elliptical curve on the addedArcs image
           // size arg 1: length of the major axis. always pairsDistance / 2
           // size arg 2: length of the minor axis.
           cv::ellipse(
-            inImageDrawnOnce,
+            addedArcs,
             bisectorPoint,
             cv::Size(majorAxis, minorAxis),
             pairsAngle * 180 / M_PI,
             0,
             180,
             cv::Scalar(255, 255, 255));
-
-          for (unsigned int rows = 0; rows < inImage->rows; rows++)
-          {
-            for (unsigned int cols = 0; cols < inImage->cols; cols++)
-            {
-              if (inImageDrawnOnce.at<unsigned char>(rows, cols) != 0 &&
-                inImage->at<unsigned char>(rows, cols) == 0)
-              {
-                addedArcs.at<uchar>(rows, cols) = 255;
-              }
-            }
-          }
         }
       }
 
+      // Only the arcs' points that were zero in the input image are added
+      addedArcs.setTo(0, *inImage);
       *inImage += addedArcs;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("connectPairs");
-    #endif
-
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_connect_pairs)  // Debug
     {
@@ -962,13 +894,9 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("denoiseEdges", "computeEdges");
-    #endif
+    PROFILE_SCOPE("denoiseEdges", "computeEdges");
 
-    #ifdef DEBUG_TIME
-    Timer::start("Sector #1", "denoiseEdges");
-    #endif
+    PROFILE_BEGIN(sector1, "Sector #1", "denoiseEdges");
 
     #ifdef DEBUG_SHOW
     std::vector<cv::Mat> imgs;
@@ -994,13 +922,9 @@ namespace thermal
 
     applyEdgeContamination(&contaminatedEdges);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("Sector #1");
-    #endif
+    PROFILE_END(sector1);
 
-    #ifdef DEBUG_TIME
-    Timer::start("Sector #2", "denoiseEdges");
-    #endif
+    PROFILE_BEGIN(sector2, "Sector #2", "denoiseEdges");
 
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_denoise_edges)  // Debug
@@ -1075,40 +999,40 @@ namespace thermal
     cv::Mat closedLines;
     thinnedClosedLines.copyTo(closedLines);
 
-    bool finished = false;
-
-    while (!finished)
+    // Starting from the thinned closed shapes, add every pixel of the
+    // contaminated edges connected to them, in one breadth first pass
+    std::vector<unsigned int> grown;
+    for (int rows = 0; rows < img->rows; rows++)
     {
-      cv::Mat marker;
-      closedLines.copyTo(marker);
-
-      for (int rows = 1; rows < img->rows - 1; rows++)
+      for (int cols = 0; cols < img->cols; cols++)
       {
-        for (int cols = 1; cols < img->cols - 1; cols++)
+        if (closedLines.at<unsigned char>(rows, cols) != 0
+          && contaminatedEdges.at<unsigned char>(rows, cols) != 0)
         {
-          if (closedLines.at<unsigned char>(rows, cols) == 0
-            && contaminatedEdges.at<unsigned char>(rows, cols) == 255)
-          {
-            for (int r = -1; r < 2; r++)
-            {
-              for (int c = -1; c < 2; c++)
-              {
-                if (contaminatedEdges.at<unsigned char>(rows + r, cols + c) != 0
-                  && closedLines.at<unsigned char>(rows + r, cols + c) != 0)
-                {
-                  closedLines.at<unsigned char>(rows, cols) = 255;
-                }
-              }
-            }
-          }
+          grown.push_back(rows * img->cols + cols);
         }
       }
+    }
 
-      // The operation has finished when all the original closed shapes have
-      // been found
-      if (cv::countNonZero(closedLines - marker) == 0)
+    for (unsigned int i = 0; i < grown.size(); i++)
+    {
+      int row = grown[i] / img->cols;
+      int col = grown[i] % img->cols;
+      for (int r = row - 1; r < row + 2; r++)
       {
-        finished = true;
+        for (int c = col - 1; c < col + 2; c++)
+        {
+          if (r < 1 || r >= img->rows - 1 || c < 1 || c >= img->cols - 1)
+          {
+            continue;
+          }
+          if (closedLines.at<unsigned char>(r, c) == 0
+            && contaminatedEdges.at<unsigned char>(r, c) == 255)
+          {
+            closedLines.at<unsigned char>(r, c) = 255;
+            grown.push_back(r * img->cols + c);
+          }
+        }
       }
     }
 
@@ -1136,13 +1060,9 @@ namespace thermal
     }
     #endif
 
-    #ifdef DEBUG_TIME
-    Timer::tick("Sector #2");
-    #endif
+    PROFILE_END(sector2);
 
-    #ifdef DEBUG_TIME
-    Timer::start("Sector #3");
-    #endif
+    PROFILE_BEGIN(sector3, "Sector #3", "denoiseEdges");
 
     // In the image that features only open-ended shapes, find their end points.
     // if they are eligible for connection,
@@ -1172,13 +1092,9 @@ namespace thermal
     // shapes are not needed.
     Morphology::pruningStrictIterative(&thinnedOpenLines, 1000);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("Sector #3");
-    #endif
+    PROFILE_END(sector3);
 
-    #ifdef DEBUG_TIME
-    Timer::start("Sector #4");
-    #endif
+    PROFILE_BEGIN(sector4, "Sector #4", "denoiseEdges");
 
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_denoise_edges)  // Debug
@@ -1210,9 +1126,7 @@ namespace thermal
     // Extract only the outer border of closed shapes
     OutlineDiscovery::getShapesClearBorderSimple(img);
 
-    #ifdef DEBUG_TIME
-    Timer::tick("Sector #4");
-    #endif
+    PROFILE_END(sector4);
 
     #ifdef DEBUG_SHOW
     if (Parameters::Debug::show_denoise_edges)  // Debug
@@ -1230,10 +1144,6 @@ namespace thermal
         Parameters::Debug::show_denoise_edges_size, 1);
     }
     #endif
-
-    #ifdef DEBUG_TIME
-    Timer::tick("denoiseEdges");
-    #endif
   }
 
 
@@ -1309,9 +1219,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("floodFillPostprocess", "produceEdgesViaSegmentation");
-    #endif
+    PROFILE_SCOPE("floodFillPostprocess", "produceEdgesViaSegmentation");
 
     cv::RNG rng = cv::theRNG();
     cv::Mat mask = cv::Mat::zeros(image->rows + 2, image->cols + 2, CV_8UC1);
@@ -1334,238 +1242,6 @@ namespace thermal
         }
       }
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("floodFillPostprocess");
-    #endif
-  }
-
-
-
-  /**
-    @brief Identifies in which curve a point lies on and returns the
-    curve's two end-points.
-    @param[in] img [cv::Mat*] The input binary image
-    @param[in] x_ [const int&] The x coordinate of the point
-    @param[in] y_ [const int&] The y coordinate of the point
-    @param[out] ret [std::set<unsigned int>&] The points that represent the
-    curve on which the point lies on
-    @return edgePoints [std::pair<GraphNode, GraphNode>*] The curve's pair of
-    end points
-   **/
-  std::pair<GraphNode, GraphNode> EdgeDetection::identifyCurveAndEndpoints(
-    cv::Mat* img, const int& x_, const int& y_, std::set<unsigned int>* ret)
-  {
-    #ifdef DEBUG_TIME
-    Timer::start("identifyCurveAndEndpoints", "identifyCurvesAndEndpoints");
-    #endif
-
-    std::vector<unsigned int> current, next;
-    std::set<unsigned int> currs;
-    std::vector<GraphNode*> nodes;
-    std::vector<GraphNode*> originCurr, originNext;
-    GraphNode* father = new GraphNode(x_, y_);
-
-    ret->insert(x_ * img->cols + y_);
-    current.push_back(x_ * img->cols + y_);
-    originCurr.push_back(father);
-    nodes.clear();
-    nodes.push_back(father);
-    father->dist = 0;
-    unsigned int stepCounter = 0;
-    while (current.size() != 0)
-    {
-      next.clear();
-      originNext.clear();
-      for (unsigned int i = 0 ; i < current.size() ; i++)
-      {
-        std::vector<unsigned int> currNext;
-        int x = current[i] / img->cols;
-        int y = current[i] % img->cols;
-        img->at<unsigned char>(x, y) = 0;
-        unsigned int counter = 0;
-        if (img->at<unsigned char>(x - 1, y - 1) != 0 &&
-          currs.find((x-1) * img->cols + y - 1) == currs.end() &&
-          ret->find((x-1) * img->cols + y - 1) == ret->end())
-        {
-          next.push_back((x-1) * img->cols + y - 1);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x-1) * img->cols + y - 1);
-          counter++;
-        }
-        if (img->at<unsigned char>(x - 1, y) != 0 &&
-          currs.find((x-1) * img->cols + y) == currs.end() &&
-          ret->find((x-1) * img->cols + y) == ret->end())
-        {
-          next.push_back((x-1) * img->cols + y);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x-1) * img->cols + y);
-          counter++;
-        }
-        if (img->at<unsigned char>(x - 1, y + 1) != 0 &&
-          currs.find((x-1) * img->cols + y + 1) == currs.end() &&
-          ret->find((x-1) * img->cols + y + 1) == ret->end())
-        {
-          next.push_back((x-1) * img->cols + y + 1);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x-1) * img->cols + y + 1);
-          counter++;
-        }
-
-        if (img->at<unsigned char>(x, y - 1) != 0 &&
-          currs.find((x) * img->cols + y - 1) == currs.end() &&
-          ret->find((x) * img->cols + y - 1) == ret->end())
-        {
-          next.push_back((x) * img->cols + y - 1);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x) * img->cols + y - 1);
-          counter++;
-        }
-        if (img->at<unsigned char>(x, y + 1) != 0 &&
-          currs.find((x) * img->cols + y + 1) == currs.end() &&
-          ret->find((x) * img->cols + y + 1) == ret->end())
-        {
-          next.push_back((x) * img->cols + y + 1);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x) * img->cols + y + 1);
-          counter++;
-        }
-
-        if (img->at<unsigned char>(x + 1, y - 1) != 0 &&
-          currs.find((x+1) * img->cols + y - 1) == currs.end() &&
-          ret->find((x+1) * img->cols + y - 1) == ret->end())
-        {
-          next.push_back((x+1) * img->cols + y - 1);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x+1) * img->cols + y - 1);
-          counter++;
-        }
-        if (img->at<unsigned char>(x + 1, y) != 0 &&
-          currs.find((x+1) * img->cols + y) == currs.end() &&
-          ret->find((x+1) * img->cols + y) == ret->end())
-        {
-          next.push_back((x+1) * img->cols + y);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x+1) * img->cols + y);
-          counter++;
-        }
-        if (img->at<unsigned char>(x + 1, y + 1) != 0 &&
-          currs.find((x+1) * img->cols + y + 1) == currs.end() &&
-          ret->find((x+1) * img->cols + y + 1) == ret->end())
-        {
-          next.push_back((x+1) * img->cols + y + 1);
-          originNext.push_back(originCurr[i]);
-          currNext.push_back(originNext.size() - 1);
-          ret->insert((x+1) * img->cols + y + 1);
-          counter++;
-        }
-
-        if (counter == 0)  // This is edge
-        {
-          GraphNode* temp = new GraphNode(x, y);
-          nodes.push_back(temp);
-
-          originCurr[i]->connections.push_back(temp);
-          temp->connections.push_back(originCurr[i]);
-
-          temp->dist = stepCounter - originCurr[i]->dist;
-
-          originCurr[i]->dists.push_back(temp->dist);
-          temp->dists.push_back(temp->dist);
-        }
-        else if (counter >= 2)  // This is joint
-        {
-          GraphNode* temp = new GraphNode(x, y);
-          nodes.push_back(temp);
-          originCurr[i]->connections.push_back(temp);
-          temp->connections.push_back(originCurr[i]);
-          temp->dist = stepCounter - originCurr[i]->dist;
-          originCurr[i]->dists.push_back(temp->dist);
-          temp->dists.push_back(temp->dist);
-          for (unsigned int j = 0 ; j < currNext.size() ; j++)
-          {
-            originNext[currNext[j]] = temp;
-          }
-        }
-
-        currNext.clear();
-      }
-      stepCounter++;
-      current.swap(next);
-      currs.clear();
-      for (unsigned int k = 0 ; k < current.size() ; k++)
-      {
-        currs.insert(current[k]);
-      }
-      originCurr.swap(originNext);
-    }
-
-    std::pair<GraphNode, GraphNode> edgePoints;
-
-    // Find larger dist between nodes
-    int maxDist = 0;
-
-    for (unsigned int i = 0 ; i < nodes.size(); i++)
-    {
-      std::vector<GraphNode*> current, next;
-      std::map<GraphNode*, int> dists;
-      std::set<GraphNode*> visited;
-
-      current.push_back(nodes[i]);
-      visited.insert(nodes[i]);
-      for (unsigned int kk = 0 ; kk < nodes.size() ; kk++)
-      {
-        dists.insert(std::pair<GraphNode*, int>(nodes[i], 0));
-      }
-      while (current.size() != 0)
-      {
-        next.clear();
-        for (unsigned int c = 0 ; c < current.size() ; c++)
-        {
-          for (unsigned int n = 0 ; n < current[c]->connections.size(); n++)
-          {
-            if (visited.find(current[c]->connections[n]) == visited.end())
-            {
-              visited.insert(current[c]->connections[n]);
-              dists[current[c]->connections[n]] +=
-                dists[current[c]] + current[c]->dists[n];
-              next.push_back(current[c]->connections[n]);
-            }
-          }
-        }
-        current.swap(next);
-      }
-      for (unsigned int d = 0 ; d < nodes.size(); d++)
-      {
-        if (dists[nodes[d]] > maxDist)
-        {
-          maxDist = dists[nodes[d]];
-          edgePoints.first.x = nodes[i]->x;
-          edgePoints.first.y = nodes[i]->y;
-          edgePoints.second.x = nodes[d]->x;
-          edgePoints.second.y = nodes[d]->y;
-        }
-      }
-    }
-
-    // Delete pointers inside nodes
-    for (unsigned int d = 0 ; d < nodes.size(); d++)
-    {
-      delete nodes[d];
-    }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("identifyCurveAndEndpoints");
-    #endif
-
-    return edgePoints;
   }
 
 
@@ -1573,6 +1249,8 @@ namespace thermal
   /**
     @brief Given an image of CV_8UC1 format, this method locates and
     identifies all continuous curves, along with their end-points.
+    Curves are labelled in a single pass over the image and the end-points
+    of each are the two lying the farthest apart along it.
     CAUTION: the length of each curve must exceed a certain threshold.
     @param[in,out] image [cv::Mat*] The image whose curves and their
     endpoints one wishes to locate and identify. CAUTION: image is cleared
@@ -1587,55 +1265,32 @@ namespace thermal
     std::vector<std::set<unsigned int> >* lines,
     std::vector<std::pair<GraphNode, GraphNode> >* endPoints)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("identifyCurvesAndEndpoints", "denoiseEdges");
-    #endif
+    PROFILE_SCOPE("identifyCurvesAndEndpoints", "denoiseEdges");
 
-    bool hasFinished = false;
+    std::vector<Curve> curves;
+    CurveExtraction extraction;
+    extraction.extract(*image, Parameters::Outline::minimum_curve_points,
+      &curves);
 
-    while (!hasFinished)
+    for (unsigned int i = 0; i < curves.size(); i++)
     {
-      hasFinished = true;
-      for (unsigned int i = 1 ; i < image->rows - 1; i++)
+      // Push the indices of the points constituting the curve into the
+      // overall curves' indices vector. They are already sorted.
+      lines->push_back(std::set<unsigned int>());
+      std::set<unsigned int>& line = lines->back();
+      for (unsigned int p = 0; p < curves[i].points.size(); p++)
       {
-        for (unsigned int j = 1 ; j < image->cols - 1; j++)
-        {
-          // A point is potentially located along a curve only if its value
-          // is non-zero; otherwise it is not a point!
-          if (image->at<unsigned char> (i, j) != 0)
-          {
-            // Locate the indices of the points that constitute the curve on
-            // which point (i, j) is located, along with the end points of it.
-            std::set<unsigned int> ret;
-            std::pair<GraphNode, GraphNode> pts =
-              identifyCurveAndEndpoints(image, i, j, &ret);
-
-            if (ret.size() > Parameters::Outline::minimum_curve_points)
-            {
-              // Push the indices of the points constituting the curve on which
-              // point (i, j) is located, into the overall curves' indices vector.
-              lines->push_back(ret);
-
-              // Push the end-points of the curve into the overall vector of
-              // end-points
-              endPoints->push_back(pts);
-            }
-
-            hasFinished = false;
-            break;
-          }
-        }
-
-        if (!hasFinished)
-        {
-          break;
-        }
+        line.insert(line.end(), curves[i].points[p]);
       }
+
+      // Push the end-points of the curve into the overall vector of
+      // end-points
+      endPoints->push_back(std::make_pair(
+          GraphNode(curves[i].first / image->cols, curves[i].first % image->cols),
+          GraphNode(curves[i].second / image->cols, curves[i].second % image->cols)));
     }
 
-    #ifdef DEBUG_TIME
-    Timer::tick("identifyCurvesAndEndpoints");
-    #endif
+    image->setTo(0);
   }
 
 
@@ -1668,9 +1323,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("produceEdgesViaBackprojection", "computeRgbEdges");
-    #endif
+    PROFILE_SCOPE("produceEdgesViaBackprojection", "computeRgbEdges");
 
     // Backprojection of the RGB inImage
     cv::Mat backprojectedFrame = cv::Mat::zeros(inImage.size(), CV_8UC1);
@@ -1683,10 +1336,6 @@ namespace thermal
     // Locate the inImage's edges by watersheding it based on its
     // backprojection
     watershedViaBackprojection(inImage, backprojectedFrame, true, outImage);
-
-    #ifdef DEBUG_TIME
-    Timer::tick("produceEdgesViaBackprojection");
-    #endif
   }
 
 
@@ -1711,9 +1360,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("produceEdgesViaSegmentation", "computeRgbEdges");
-    #endif
+    PROFILE_SCOPE("produceEdgesViaSegmentation", "computeRgbEdges");
 
     #ifdef DEBUG_SHOW
     std::string msg;
@@ -1814,10 +1461,6 @@ namespace thermal
         Parameters::Debug::show_produce_edges_size, 1);
     }
     #endif
-
-    #ifdef DEBUG_TIME
-    Timer::tick("produceEdgesViaSegmentation");
-    #endif
   }
 
 
@@ -1838,9 +1481,7 @@ namespace thermal
       return;
     }
 
-    #ifdef DEBUG_TIME
-    Timer::start("segmentation", "produceEdgesViaSegmentation");
-    #endif
+    PROFILE_SCOPE("segmentation", "produceEdgesViaSegmentation");
 
     // Termination criteria for the segmentation below
     cv::TermCriteria criteria(
@@ -1854,10 +1495,6 @@ namespace thermal
       Parameters::Rgb::color_window_radius,
       Parameters::Rgb::maximum_level_pyramid_segmentation,
       criteria);
-
-      #ifdef DEBUG_TIME
-      Timer::tick("segmentation");
-      #endif
   }
 
 
@@ -1873,9 +1510,7 @@ namespace thermal
   void EdgeDetection::watershedViaBackprojection(const cv::Mat& inImage,
     const cv::Mat& backproject, const bool& edges, cv::Mat* outImage)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("watershedViaBackprojection");
-    #endif
+    PROFILE_SCOPE("watershedViaBackprojection", "");
 
     #ifdef DEBUG_SHOW
     std::string msg;
@@ -2078,10 +1713,6 @@ namespace thermal
         Parameters::Debug::show_produce_edges_size, 1);
     }
     #endif
-
-    #ifdef DEBUG_TIME
-    Timer::tick("watershedViaBackprojection");
-    #endif
   }
 
 }  // namespace thermal
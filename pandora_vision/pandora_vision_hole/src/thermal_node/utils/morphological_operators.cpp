@@ -36,6 +36,7 @@
  *********************************************************************/
 
 #include "thermal_node/utils/morphological_operators.h"
+#include "utils/binary_morphology.h"
 
 /**
   @namespace pandora_vision
@@ -57,9 +58,7 @@ namespace thermal
   void Morphology::closing(cv::Mat* img, const int& steps,
     const bool& visualize)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("closing");
-    #endif
+    PROFILE_SCOPE("closing", "");
 
     for (unsigned int i = 0; i < steps; i++)
     {
@@ -71,9 +70,6 @@ namespace thermal
       dilation(img, 1);
       erosion(img, 1);
     }
-    #ifdef DEBUG_TIME
-    Timer::tick("closing");
-    #endif
   }
 
 
@@ -88,14 +84,12 @@ namespace thermal
   void Morphology::dilation(cv::Mat* img, const int& steps,
     const bool& visualize)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("dilation", "denoiseEdges");
-    #endif
+    PROFILE_SCOPE("dilation", "denoiseEdges");
 
     cv::Mat helper;
     img->copyTo(helper);
 
-    static unsigned int p = 0;
+    unsigned int p = 0;
 
     for (unsigned int s = 0 ; s < steps ; s++)
     {
@@ -271,10 +265,6 @@ namespace thermal
 
       helper.copyTo(*img);
     }
-
-    #ifdef DEBUG_TIME
-    Timer::tick("dilation");
-    #endif
   }
 
 
@@ -290,14 +280,12 @@ namespace thermal
   void Morphology::dilationRelative(cv::Mat* img, const int& steps,
     const bool& visualize)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("dilation", "checkHolesTextureBackProject");
-    #endif
+    PROFILE_SCOPE("dilation", "checkHolesTextureBackProject");
 
     cv::Mat helper;
     img->copyTo(helper);
 
-    static unsigned int p = 0;
+    unsigned int p = 0;
 
     for (unsigned int s = 0 ; s < steps ; s++)
     {
@@ -493,9 +481,6 @@ namespace thermal
 
       helper.copyTo(*img);
     }
-    #ifdef DEBUG_TIME
-    Timer::tick("dilation");
-    #endif
   }
 
 
@@ -510,14 +495,12 @@ namespace thermal
   void Morphology::erosion(cv::Mat* img, const int& steps,
     const bool& visualize)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("erosion");
-    #endif
+    PROFILE_SCOPE("erosion", "");
 
     cv::Mat helper;
     img->copyTo(helper);
 
-    static unsigned int p = 0;
+    unsigned int p = 0;
 
     for (unsigned int s = 0 ; s < steps ; s++)
     {
@@ -693,9 +676,6 @@ namespace thermal
 
       helper.copyTo(*img);
     }
-    #ifdef DEBUG_TIME
-    Timer::tick("erosion");
-    #endif
   }
 
 
@@ -712,8 +692,7 @@ namespace thermal
   bool Morphology::kernelCheck(const char kernel[3][3], const cv::Mat& img,
     const cv::Point& center)
   {
-    static unsigned char *ptr;
-    ptr = (unsigned char *) img.data;
+    const unsigned char* ptr = img.data;
 
     for (int i = -1; i <= 1; i++)
     {
@@ -746,9 +725,7 @@ namespace thermal
   void Morphology::opening(cv::Mat* img, const int& steps,
     const bool& visualize)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("opening");
-    #endif
+    PROFILE_SCOPE("opening", "");
 
     for (unsigned int i = 0; i < steps; i++)
     {
@@ -760,9 +737,6 @@ namespace thermal
       erosion(img, 1);
       dilation(img, 1);
     }
-    #ifdef DEBUG_TIME
-    Timer::tick("opening");
-    #endif
   }
 
 
@@ -777,193 +751,10 @@ namespace thermal
    **/
   void Morphology::pruningStrictIterative(cv::Mat* img, const int& steps)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("pruningStrictIterative", "denoiseEdges");
-    #endif
-
-    static const unsigned int nOfKernels = 9;
-
-    static const char kernels[9][3][3] = {
-      { {0, 0, 0},
-        {0, 1, 0},
-        {0, 0, 0} },
-
-      { {1, 2, 0},
-        {2, 1, 0},
-        {0, 0, 0} },
-
-      { {2, 1, 2},
-        {0, 1, 0},
-        {0, 0, 0} },
-
-      { {0, 2, 1},
-        {0, 1, 2},
-        {0, 0, 0} },
-
-      { {2, 0, 0},
-        {1, 1, 0},
-        {2, 0, 0} },
-
-      { {0, 0, 2},
-        {0, 1, 1},
-        {0, 0, 2} },
+    PROFILE_SCOPE("pruningStrictIterative", "denoiseEdges");
 
-      { {0, 0, 0},
-        {2, 1, 0},
-        {1, 2, 0} },
-
-      { {0, 0, 0},
-        {0, 1, 0},
-        {2, 1, 2} },
-
-      { {0, 0, 0},
-        {0, 1, 2},
-        {0, 2, 1} }
-    };
-
-    std::set<unsigned int> current, next;
-
-    for (unsigned int rows = 1; rows < img->rows - 1; rows++)
-    {
-      for (unsigned int cols = 1; cols < img->cols - 1; cols++)
-      {
-        if (img->at<unsigned char>(rows, cols) != 0)
-        {
-          // Check for initial stuff
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(cols, rows)))
-            {
-              current.insert(rows * img->cols + cols);
-              break;
-            }
-          }
-        }
-      }
-    }
-
-    bool isRunning;
-    for (unsigned int s = 0; s < steps; s++)
-    {
-      next.clear();
-      isRunning = false;
-
-      for (std::set<unsigned int>::iterator it = current.begin() ;
-        it != current.end() ; it++)
-      {
-        static unsigned int x = 0;
-        static unsigned int y = 0;
-        x = *it / img->cols;
-        y = *it % img->cols;
-
-        img->at<unsigned char>(x, y) = 0;
-
-        if (img->at<unsigned char>(x - 1, y - 1) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y - 1, x - 1)))
-            {
-              isRunning = true;
-              next.insert((x - 1) * img->cols + (y - 1) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x - 1, y) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y, x - 1)))
-            {
-              isRunning = true;
-              next.insert((x - 1) * img->cols + (y) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x - 1, y + 1) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y + 1, x - 1)))
-            {
-              isRunning = true;
-              next.insert((x - 1) * img->cols + (y + 1) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x, y - 1) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y - 1, x)))
-            {
-              isRunning = true;
-              next.insert((x) * img->cols + (y - 1) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x, y + 1) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y + 1, x)))
-            {
-              isRunning = true;
-              next.insert((x) * img->cols + (y + 1) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x + 1, y - 1) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y - 1, x + 1)))
-            {
-              isRunning = true;
-              next.insert((x + 1) * img->cols + (y - 1) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x + 1, y) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y, x + 1)))
-            {
-              isRunning = true;
-              next.insert((x + 1) * img->cols + (y) );
-              break;
-            }
-          }
-        }
-        if (img->at<unsigned char>(x + 1, y + 1) != 0)
-        {
-          for (unsigned int i = 0 ; i < nOfKernels ; i++)
-          {
-            if (kernelCheck(kernels[i], *img, cv::Point(y + 1, x + 1)))
-            {
-              isRunning = true;
-              next.insert((x + 1) * img->cols + (y + 1) );
-              break;
-            }
-          }
-        }
-      }
-      if (!isRunning)
-      {
-        break;
-      }
-      next.swap(current);
-    }
-    #ifdef DEBUG_TIME
-    Timer::tick("pruningStrictIterative");
-    #endif
+    BinaryMorphology morphology;
+    morphology.pruningStrictIterative(img, steps);
   }
 
 
@@ -980,98 +771,10 @@ namespace thermal
   void Morphology::thinning(const cv::Mat& inImage, cv::Mat* outImage,
     const int& steps, const bool& visualize)
   {
-    #ifdef DEBUG_TIME
-    Timer::start("thinning", "denoiseEdges");
-    #endif
-
-    static const char kernels[8][3][3] = {
-      { {0, 0, 0},
-        {2, 1, 2},
-        {1, 1, 1} },
-
-      { {2, 0, 0},
-        {1, 1, 0},
-        {2, 1, 2} },
-
-      { {1, 2, 0},
-        {1, 1, 0},
-        {1, 2, 0} },
-
-      { {2, 1, 2},
-        {1, 1, 0},
-        {2, 0, 0} },
-
-      { {1, 1, 1},
-        {2, 1, 2},
-        {0, 0, 0} },
-
-      { {2, 1, 2},
-        {0, 1, 1},
-        {0, 0, 2} },
-
-      { {0, 2, 1},
-        {0, 1, 1},
-        {0, 2, 1} },
-
-      { {0, 0, 2},
-        {0, 1, 1},
-        {2, 1, 2} }
-    };
-
-    inImage.copyTo(*outImage);
-
-    // if the image is saturated by the thinning operator,
-    // cease its operation
-    bool isRunning;
-    static unsigned int limit = 0;
-
-    unsigned int *pts =
-      new unsigned int[outImage->cols * outImage->rows];
-
-    limit = 0;
-
-    for (unsigned int rows = 1; rows < outImage->rows - 1; rows++)
-    {
-      for (unsigned int cols = 1; cols < outImage->cols - 1; cols++)
-      {
-        if (inImage.data[rows * inImage.cols + cols] != 0)
-        {
-          pts[limit]= rows * inImage.cols + cols;
-          limit++;
-        }
-      }
-    }
-
-    for (unsigned int s = 0; s < steps; s++)
-    {
-      isRunning = false;
-
-      for (int kernelId = 0; kernelId < 8; kernelId++)
-      {
-        for (unsigned int i = 0; i < limit; i++)
-        {
-          if (kernelCheck(kernels[kernelId], *outImage,
-              cv::Point(pts[i] % outImage->cols, pts[i] / outImage->cols)))
-          {
-            outImage->data[pts[i]] = 0;
-            isRunning = true;
-            break;
-          }
-        }
-      }
-
-      if (!isRunning)
-      {
-        break;
-      }
-    }
-
-    // Delete pointer pts
-    delete[] pts;
+    PROFILE_SCOPE("thinning", "denoiseEdges");
 
-    #ifdef DEBUG_TIME
-    Timer::tick("thinning");
-    #endif
+    BinaryMorphology morphology;
+    morphology.thinning(inImage, outImage, steps);
   }
 
 }  // namespace thermal
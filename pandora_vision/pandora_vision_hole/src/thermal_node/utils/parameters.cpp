@@ -125,6 +125,11 @@ namespace thermal
   // 2 for brushfire far
   int Parameters::Depth::interpolation_method = 0;
 
+  // Whether the averaging interpolation (method 0) is replaced by giving
+  // every black pixel the value of its nearest non-black pixel, found by
+  // jump flooding
+  bool Parameters::Depth::use_jump_flooding = false;
+
   ////////////////// Parameters specific to the Thermal node ////////////////////
 
   // The thermal detection method
@@ -291,12 +296,18 @@ namespace thermal
   // on RGB analysis
   float Parameters::HoleFusion::Validation::rgb_validity_threshold = 0.40;
 
+  // Stop applying filters to holes that cannot be found valid
+  bool Parameters::HoleFusion::Validation::short_circuit_filters = true;
+
 
   // Plane detection parameters
   float Parameters::HoleFusion::Planes::filter_leaf_size = 0.1;
   int Parameters::HoleFusion::Planes::max_iterations = 1000;
   double Parameters::HoleFusion::Planes::num_points_to_exclude = 0.2;
   double Parameters::HoleFusion::Planes::point_to_plane_distance_threshold = 0.08;
+  bool Parameters::HoleFusion::Planes::segment_whole_frame = false;
+  int Parameters::HoleFusion::Planes::min_plane_inliers = 300;
+  double Parameters::HoleFusion::Planes::plane_angular_threshold = 3.0;
 
   // Option to enable or disable the merging of holes
   bool Parameters::HoleFusion::Merger::merge_holes = true;
@@ -312,6 +323,9 @@ namespace thermal
   // The inflation size of holes' bounding rectangles
   int Parameters::HoleFusion::rectangle_inflation_size = 10;
 
+  // The number of holes whose resources are kept between frames
+  int Parameters::HoleFusion::resources_cache_size = 64;
+
 
 
   ////////////////// Image representation specific parameters //////////////////
@@ -0,0 +1,469 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "utils/binary_morphology.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace
+{
+  /// The kernels of thinning, applied in this order
+  const char kThinningKernels[8][3][3] = {
+    { {0, 0, 0},
+      {2, 1, 2},
+      {1, 1, 1} },
+
+    { {2, 0, 0},
+      {1, 1, 0},
+      {2, 1, 2} },
+
+    { {1, 2, 0},
+      {1, 1, 0},
+      {1, 2, 0} },
+
+    { {2, 1, 2},
+      {1, 1, 0},
+      {2, 0, 0} },
+
+    { {1, 1, 1},
+      {2, 1, 2},
+      {0, 0, 0} },
+
+    { {2, 1, 2},
+      {0, 1, 1},
+      {0, 0, 2} },
+
+    { {0, 2, 1},
+      {0, 1, 1},
+      {0, 2, 1} },
+
+    { {0, 0, 2},
+      {0, 1, 1},
+      {2, 1, 2} }
+  };
+
+  /// The kernels of pruning: an isolated pixel and the eight end points
+  const char kPruningKernels[9][3][3] = {
+    { {0, 0, 0},
+      {0, 1, 0},
+      {0, 0, 0} },
+
+    { {1, 2, 0},
+      {2, 1, 0},
+      {0, 0, 0} },
+
+    { {2, 1, 2},
+      {0, 1, 0},
+      {0, 0, 0} },
+
+    { {0, 2, 1},
+      {0, 1, 2},
+      {0, 0, 0} },
+
+    { {2, 0, 0},
+      {1, 1, 0},
+      {2, 0, 0} },
+
+    { {0, 0, 2},
+      {0, 1, 1},
+      {0, 0, 2} },
+
+    { {0, 0, 0},
+      {2, 1, 0},
+      {1, 2, 0} },
+
+    { {0, 0, 0},
+      {0, 1, 0},
+      {2, 1, 2} },
+
+    { {0, 0, 0},
+      {0, 1, 2},
+      {0, 2, 1} }
+  };
+
+  /// The mark of the next frontier of pruning in queued_
+  const unsigned char kNext = 2;
+
+  /// The (row, column) offsets of the neighbours, in the order of the index bits
+  const int kNeighbourRows[8] = {-1, -1, -1, 0, 0, 1, 1, 1};
+  const int kNeighbourCols[8] = {-1, 0, 1, -1, 1, -1, 0, 1};
+}  // namespace
+
+  BinaryMorphology::BinaryMorphology() :
+    rows_(0), cols_(0), stride_(0)
+  {
+    for (int k = 0; k < 8; k++)
+    {
+      buildTable(kThinningKernels[k], &thinningTables_[k]);
+      firstMatch_[k] = 0;
+    }
+    for (int k = 0; k < 9; k++)
+    {
+      buildTable(kPruningKernels[k], &pruningTable_);
+    }
+  }
+
+
+
+  unsigned int BinaryMorphology::encode(const char neighbourhood[3][3])
+  {
+    unsigned int index = 0;
+    for (int n = 0; n < 8; n++)
+    {
+      if (neighbourhood[kNeighbourRows[n] + 1][kNeighbourCols[n] + 1] != 0)
+      {
+        index |= 1 << n;
+      }
+    }
+    return index;
+  }
+
+
+
+  void BinaryMorphology::buildTable(const char kernel[3][3],
+    std::bitset<256>* table)
+  {
+    for (unsigned int index = 0; index < 256; index++)
+    {
+      bool matches = true;
+      for (int n = 0; n < 8 && matches; n++)
+      {
+        char expected = kernel[kNeighbourRows[n] + 1][kNeighbourCols[n] + 1];
+        bool set = (index >> n) & 1;
+        if ((expected == 0 && set) || (expected == 1 && !set))
+        {
+          matches = false;
+        }
+      }
+      if (matches)
+      {
+        table->set(index);
+      }
+    }
+  }
+
+
+
+  void BinaryMorphology::load(const unsigned char* data, int rows, int cols,
+    size_t step)
+  {
+    rows_ = rows;
+    cols_ = cols;
+    stride_ = (cols + 2 + 63) / 64;
+
+    bits_.assign(static_cast<size_t>(rows + 2) * stride_, 0);
+    queued_.assign(static_cast<size_t>(rows) * cols, 0);
+
+    for (int row = 0; row < rows; row++)
+    {
+      const unsigned char* pixel = data + row * step;
+      uint64_t* padded = &bits_[(row + 1) * stride_];
+      for (int col = 0; col < cols; col++)
+      {
+        if (pixel[col] != 0)
+        {
+          padded[(col + 1) >> 6] |= static_cast<uint64_t>(1) << ((col + 1) & 63);
+        }
+      }
+    }
+  }
+
+
+
+  unsigned int BinaryMorphology::neighbourhood(int row, int col) const
+  {
+    // In padded coordinates the neighbours of (row, col) span the rows
+    // row .. row + 2 and the bits col .. col + 2
+    const int word = col >> 6;
+    const int shift = col & 63;
+
+    unsigned int index = 0;
+    for (int r = 0; r < 3; r++)
+    {
+      const uint64_t* padded = &bits_[(row + r) * stride_ + word];
+      uint64_t window = padded[0] >> shift;
+      if (shift > 61)
+      {
+        window |= padded[1] << (64 - shift);
+      }
+      window &= 7;
+
+      if (r == 0)
+      {
+        index |= window;
+      }
+      else if (r == 1)
+      {
+        index |= (window & 1) << 3 | (window >> 2) << 4;
+      }
+      else
+      {
+        index |= window << 5;
+      }
+    }
+    return index;
+  }
+
+
+
+  bool BinaryMorphology::isSet(int row, int col) const
+  {
+    return (bits_[(row + 1) * stride_ + ((col + 1) >> 6)]
+      >> ((col + 1) & 63)) & 1;
+  }
+
+
+
+  void BinaryMorphology::clear(unsigned char* data, size_t step,
+    int row, int col)
+  {
+    bits_[(row + 1) * stride_ + ((col + 1) >> 6)] &=
+      ~(static_cast<uint64_t>(1) << ((col + 1) & 63));
+    data[row * step + col] = 0;
+  }
+
+
+
+  void BinaryMorphology::pruningStrictIterative(cv::Mat* img, int steps)
+  {
+    pruningStrictIterative(img->data, img->rows, img->cols, img->step, steps);
+  }
+
+
+
+  void BinaryMorphology::pruningStrictIterative(unsigned char* data,
+    int rows, int cols, size_t step, int steps)
+  {
+    if (rows < 3 || cols < 3)
+    {
+      return;
+    }
+    load(data, rows, cols, step);
+
+    // The end points of the interior of the image, in raster order
+    std::vector<int> current, next;
+    for (int row = 1; row < rows - 1; row++)
+    {
+      const uint64_t* padded = &bits_[(row + 1) * stride_];
+      for (int word = 0; word < stride_; word++)
+      {
+        uint64_t bits = padded[word];
+        while (bits != 0)
+        {
+          int col = word * 64 + __builtin_ctzll(bits) - 1;
+          bits &= bits - 1;
+          if (col >= 1 && col < cols - 1 &&
+            pruningTable_[neighbourhood(row, col)])
+          {
+            current.push_back(row * cols + col);
+          }
+        }
+      }
+    }
+
+    // End points are removed one after the other in raster order; the
+    // neighbours they leave as new end points are removed in the next step
+    for (int s = 0; s < steps; s++)
+    {
+      bool isRunning = false;
+      next.clear();
+
+      for (size_t i = 0; i < current.size(); i++)
+      {
+        int row = current[i] / cols;
+        int col = current[i] % cols;
+        clear(data, step, row, col);
+
+        for (int n = 0; n < 8; n++)
+        {
+          int r = row + kNeighbourRows[n];
+          int c = col + kNeighbourCols[n];
+          if (r < 0 || r >= rows || c < 0 || c >= cols || !isSet(r, c))
+          {
+            continue;
+          }
+          if (pruningTable_[neighbourhood(r, c)])
+          {
+            isRunning = true;
+            int index = r * cols + c;
+            if (!(queued_[index] & kNext))
+            {
+              queued_[index] |= kNext;
+              next.push_back(index);
+            }
+          }
+        }
+      }
+      if (!isRunning)
+      {
+        break;
+      }
+
+      for (size_t i = 0; i < next.size(); i++)
+      {
+        queued_[next[i]] = 0;
+      }
+      std::sort(next.begin(), next.end());
+      next.swap(current);
+    }
+  }
+
+
+
+  void BinaryMorphology::thinning(const cv::Mat& inImage, cv::Mat* outImage,
+    int steps)
+  {
+    inImage.copyTo(*outImage);
+    thinning(outImage->data, outImage->rows, outImage->cols, outImage->step,
+      steps);
+  }
+
+
+
+  void BinaryMorphology::thinning(unsigned char* data, int rows, int cols,
+    size_t step, int steps)
+  {
+    if (rows < 3 || cols < 3)
+    {
+      return;
+    }
+    load(data, rows, cols, step);
+
+    // Each kernel removes the first pixel of the interior it matches, in
+    // raster order. The pixels every kernel matches are kept as bits, so
+    // that the first one is found by skipping empty words, and only the
+    // neighbourhood of a removed pixel has to be examined again.
+    const int words = (rows * cols + 63) / 64;
+    for (int k = 0; k < 8; k++)
+    {
+      matches_[k].assign(words, 0);
+      firstMatch_[k] = 0;
+    }
+    for (int row = 1; row < rows - 1; row++)
+    {
+      const uint64_t* padded = &bits_[(row + 1) * stride_];
+      for (int word = 0; word < stride_; word++)
+      {
+        uint64_t bits = padded[word];
+        while (bits != 0)
+        {
+          int col = word * 64 + __builtin_ctzll(bits) - 1;
+          bits &= bits - 1;
+          if (col >= 1 && col < cols - 1)
+          {
+            updateMatches(row, col);
+          }
+        }
+      }
+    }
+
+    for (int s = 0; s < steps; s++)
+    {
+      bool isRunning = false;
+
+      for (int k = 0; k < 8; k++)
+      {
+        std::vector<uint64_t>& matches = matches_[k];
+        int& word = firstMatch_[k];
+        while (word < words && matches[word] == 0)
+        {
+          word++;
+        }
+        if (word == words)
+        {
+          continue;
+        }
+
+        int index = word * 64 + __builtin_ctzll(matches[word]);
+        int row = index / cols;
+        int col = index % cols;
+        clear(data, step, row, col);
+        isRunning = true;
+
+        updateMatches(row, col);
+        for (int n = 0; n < 8; n++)
+        {
+          int r = row + kNeighbourRows[n];
+          int c = col + kNeighbourCols[n];
+          if (r >= 1 && r < rows - 1 && c >= 1 && c < cols - 1)
+          {
+            updateMatches(r, c);
+          }
+        }
+      }
+      if (!isRunning)
+      {
+        break;
+      }
+    }
+  }
+
+
+
+  void BinaryMorphology::updateMatches(int row, int col)
+  {
+    const int pixel = row * cols_ + col;
+    const int word = pixel >> 6;
+    const uint64_t bit = static_cast<uint64_t>(1) << (pixel & 63);
+    const bool set = isSet(row, col);
+    const unsigned int index = set ? neighbourhood(row, col) : 0;
+
+    for (int k = 0; k < 8; k++)
+    {
+      if (set && thinningTables_[k][index])
+      {
+        matches_[k][word] |= bit;
+        firstMatch_[k] = std::min(firstMatch_[k], word);
+      }
+      else
+      {
+        matches_[k][word] &= ~bit;
+      }
+    }
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
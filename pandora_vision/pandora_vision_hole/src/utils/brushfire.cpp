@@ -0,0 +1,420 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include <boost/thread/tss.hpp>
+
+#include "utils/brushfire.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  namespace
+  {
+    boost::thread_specific_ptr<Brushfire> localInstance;
+    boost::thread_specific_ptr<Brushfire> localFencedInstance;
+  }
+
+  Brushfire::Brushfire() :
+    rows_(0), cols_(0), stamp_(0), base_(0), exclusion_(1), excludedCount_(0)
+  {
+  }
+
+  Brushfire& Brushfire::local()
+  {
+    if (localInstance.get() == NULL)
+    {
+      localInstance.reset(new Brushfire);
+    }
+    return *localInstance;
+  }
+
+  Brushfire& Brushfire::localFenced()
+  {
+    if (localFencedInstance.get() == NULL)
+    {
+      localFencedInstance.reset(new Brushfire);
+    }
+    return *localFencedInstance;
+  }
+
+  void Brushfire::prepare(int rows, int cols)
+  {
+    if (rows != rows_ || cols != cols_)
+    {
+      rows_ = rows;
+      cols_ = cols;
+      stamps_.assign(rows * cols, 0);
+      stamp_ = 0;
+      base_ = 0;
+      excluded_.assign(rows * cols, 0);
+      exclusion_ = 1;
+      excludedCount_ = 0;
+    }
+  }
+
+  unsigned int Brushfire::nextStamp()
+  {
+    if (stamp_ == std::numeric_limits<unsigned int>::max())
+    {
+      std::fill(stamps_.begin(), stamps_.end(), 0);
+      stamp_ = 0;
+      base_ = 0;
+    }
+    return ++stamp_;
+  }
+
+  void Brushfire::reset(int rows, int cols)
+  {
+    prepare(rows, cols);
+    base_ = stamp_;
+  }
+
+  void Brushfire::exclude(unsigned int index)
+  {
+    if (excluded_[index] != exclusion_)
+    {
+      excluded_[index] = exclusion_;
+      excludedCount_++;
+    }
+  }
+
+  void Brushfire::clearExclusions(int rows, int cols)
+  {
+    prepare(rows, cols);
+    if (exclusion_ == std::numeric_limits<unsigned int>::max())
+    {
+      std::fill(excluded_.begin(), excluded_.end(), 0);
+      exclusion_ = 0;
+    }
+    exclusion_++;
+    excludedCount_ = 0;
+  }
+
+  void Brushfire::flood(const cv::Mat& image, unsigned int seed,
+    bool eightConnected)
+  {
+    if (image.depth() == CV_32F)
+    {
+      expand<float>(image, seed, eightConnected);
+    }
+    else
+    {
+      expand<unsigned char>(image, seed, eightConnected);
+    }
+  }
+
+  template <typename T>
+  void Brushfire::expand(const cv::Mat& image, unsigned int seed,
+    bool eightConnected)
+  {
+    prepare(image.rows, image.cols);
+    const unsigned int stamp = nextStamp();
+
+    region_.clear();
+    outline_.clear();
+
+    stamps_[seed] = stamp;
+    region_.push_back(seed);
+    if (image.ptr<T>(seed / cols_)[seed % cols_] != 0)
+    {
+      outline_.push_back(seed);
+    }
+
+    // region_ is the queue itself: everything before head has been expanded
+    for (unsigned int head = 0; head < region_.size(); head++)
+    {
+      const int row = region_[head] / cols_;
+      const int col = region_[head] % cols_;
+
+      for (int m = -1; m < 2; m++)
+      {
+        const int y = row + m;
+        if (y < 0 || y >= rows_)
+        {
+          continue;
+        }
+        const T* pixel = image.ptr<T>(y);
+
+        for (int n = -1; n < 2; n++)
+        {
+          const int x = col + n;
+          if (x < 0 || x >= cols_ || (m == 0 && n == 0)
+            || (!eightConnected && m != 0 && n != 0))
+          {
+            continue;
+          }
+          const unsigned int index = y * cols_ + x;
+          if (stamps_[index] == stamp || excluded_[index] == exclusion_)
+          {
+            continue;
+          }
+          stamps_[index] = stamp;
+
+          if (pixel[x] == 0)
+          {
+            region_.push_back(index);
+          }
+          else
+          {
+            outline_.push_back(index);
+          }
+        }
+      }
+    }
+  }
+
+  void Brushfire::meanFill(cv::Mat* image)
+  {
+    prepare(image->rows, image->cols);
+    const unsigned int stamp = nextStamp();
+
+    region_.clear();
+    layerEnds_.clear();
+
+    // The first layer: zero-value pixels next to non-zero ones
+    for (int row = 1; row < rows_ - 1; row++)
+    {
+      const float* up = image->ptr<float>(row - 1);
+      const float* pixel = image->ptr<float>(row);
+      const float* down = image->ptr<float>(row + 1);
+
+      for (int col = 1; col < cols_ - 1; col++)
+      {
+        if (pixel[col] == 0.0
+          && (up[col - 1] != 0.0 || up[col] != 0.0 || up[col + 1] != 0.0
+            || pixel[col - 1] != 0.0 || pixel[col + 1] != 0.0
+            || down[col - 1] != 0.0 || down[col] != 0.0
+            || down[col + 1] != 0.0))
+        {
+          stamps_[row * cols_ + col] = stamp;
+          region_.push_back(row * cols_ + col);
+        }
+      }
+    }
+
+    // Every next layer: the zero-value pixels next to the previous one
+    unsigned int head = 0;
+    while (head < region_.size())
+    {
+      const unsigned int end = region_.size();
+      layerEnds_.push_back(end);
+
+      for (; head < end; head++)
+      {
+        const int row = region_[head] / cols_;
+        const int col = region_[head] % cols_;
+
+        for (int y = std::max(row - 1, 1); y <= std::min(row + 1, rows_ - 2);
+          y++)
+        {
+          const float* pixel = image->ptr<float>(y);
+          for (int x = std::max(col - 1, 1);
+            x <= std::min(col + 1, cols_ - 2); x++)
+          {
+            const unsigned int index = y * cols_ + x;
+            if (pixel[x] == 0.0 && stamps_[index] != stamp)
+            {
+              stamps_[index] = stamp;
+              region_.push_back(index);
+            }
+          }
+        }
+      }
+    }
+
+    // Fill the layers from the outside in. The neighbours are summed in the
+    // order of NoiseElimination::interpolateZeroPixel, so that the values
+    // come out the same to the last bit
+    const int rowOffsets[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    const int colOffsets[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+    unsigned int begin = 0;
+    for (unsigned int layer = 0; layer < layerEnds_.size(); layer++)
+    {
+      const unsigned int end = layerEnds_[layer];
+      values_.resize(end - begin);
+
+      for (unsigned int i = begin; i < end; i++)
+      {
+        const int row = region_[i] / cols_;
+        const int col = region_[i] % cols_;
+
+        float sum = 0.0;
+        int count = 0;
+        for (int n = 0; n < 8; n++)
+        {
+          float value =
+            image->ptr<float>(row + rowOffsets[n])[col + colOffsets[n]];
+          if (value != 0.0)
+          {
+            sum += value;
+            count++;
+          }
+        }
+        values_[i - begin] = sum / count;
+      }
+
+      for (unsigned int i = begin; i < end; i++)
+      {
+        image->ptr<float>(region_[i] / cols_)[region_[i] % cols_] =
+          values_[i - begin];
+      }
+      begin = end;
+    }
+  }
+
+  void Brushfire::nearestFill(cv::Mat* image)
+  {
+    const int rows = image->rows;
+    const int cols = image->cols;
+
+    nearest_.resize(rows * cols);
+    nearestNext_.resize(rows * cols);
+
+    bool seeds = false;
+    for (int row = 0; row < rows; row++)
+    {
+      const float* pixel = image->ptr<float>(row);
+      for (int col = 0; col < cols; col++)
+      {
+        if (pixel[col] != 0.0)
+        {
+          nearest_[row * cols + col] = cv::Point(col, row);
+          seeds = true;
+        }
+        else
+        {
+          nearest_[row * cols + col] = cv::Point(-1, -1);
+        }
+      }
+    }
+    if (!seeds)
+    {
+      return;
+    }
+
+    // Steps of half the image's size down to one, plus one more pass of
+    // step one, which mends most of the misses of the larger steps
+    int step = 1;
+    while (step * 2 < std::max(rows, cols))
+    {
+      step *= 2;
+    }
+
+    for (int unitPasses = 0; unitPasses < 2;)
+    {
+      for (int row = 0; row < rows; row++)
+      {
+        for (int col = 0; col < cols; col++)
+        {
+          cv::Point best = nearest_[row * cols + col];
+          nearestNext_[row * cols + col] = best;
+
+          // Non-zero pixels are their own nearest
+          if (best.x == col && best.y == row)
+          {
+            continue;
+          }
+          int bestDistance = std::numeric_limits<int>::max();
+          if (best.x >= 0)
+          {
+            bestDistance = (best.y - row) * (best.y - row)
+              + (best.x - col) * (best.x - col);
+          }
+
+          for (int y = row - step; y <= row + step; y += step)
+          {
+            if (y < 0 || y >= rows)
+            {
+              continue;
+            }
+            const cv::Point* candidates = &nearest_[y * cols];
+
+            for (int x = col - step; x <= col + step; x += step)
+            {
+              if (x < 0 || x >= cols || candidates[x].x < 0)
+              {
+                continue;
+              }
+              int distance = (candidates[x].y - row) * (candidates[x].y - row)
+                + (candidates[x].x - col) * (candidates[x].x - col);
+              if (distance < bestDistance)
+              {
+                bestDistance = distance;
+                best = candidates[x];
+              }
+            }
+          }
+          nearestNext_[row * cols + col] = best;
+        }
+      }
+      nearest_.swap(nearestNext_);
+
+      if (step > 1)
+      {
+        step /= 2;
+      }
+      else
+      {
+        unitPasses++;
+      }
+    }
+
+    for (int row = 0; row < rows; row++)
+    {
+      float* pixel = image->ptr<float>(row);
+      for (int col = 0; col < cols; col++)
+      {
+        if (pixel[col] == 0.0)
+        {
+          const cv::Point& seed = nearest_[row * cols + col];
+          pixel[col] = image->ptr<float>(seed.y)[seed.x];
+        }
+      }
+    }
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -0,0 +1,225 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <vector>
+
+#include "utils/curve_extraction.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  void CurveExtraction::extract(const cv::Mat& image, int minimumPoints,
+    std::vector<Curve>* curves)
+  {
+    rows_ = image.rows;
+    cols_ = image.cols;
+    labels_.assign(rows_ * cols_, -1);
+    degrees_.assign(rows_ * cols_, 0);
+    visited_.assign(rows_ * cols_, 0);
+    parents_.clear();
+
+    // Label the pixels, joining the labels of the neighbours already met
+    // (left, upper left, upper, upper right) and counting neighbours
+    std::vector<unsigned int> pixels;
+    const int previousRows[4] = {0, -1, -1, -1};
+    const int previousCols[4] = {-1, -1, 0, 1};
+
+    for (int row = 0; row < rows_; row++)
+    {
+      const unsigned char* pixel = image.ptr<unsigned char>(row);
+      for (int col = 0; col < cols_; col++)
+      {
+        if (pixel[col] == 0)
+        {
+          continue;
+        }
+        unsigned int index = row * cols_ + col;
+        int label = -1;
+
+        for (int n = 0; n < 4; n++)
+        {
+          int r = row + previousRows[n];
+          int c = col + previousCols[n];
+          if (r < 0 || c < 0 || c >= cols_)
+          {
+            continue;
+          }
+          int neighbour = labels_[r * cols_ + c];
+          if (neighbour < 0)
+          {
+            continue;
+          }
+          degrees_[r * cols_ + c]++;
+          degrees_[index]++;
+          if (label < 0)
+          {
+            label = neighbour;
+          }
+          else
+          {
+            join(label, neighbour);
+          }
+        }
+        if (label < 0)
+        {
+          label = parents_.size();
+          parents_.push_back(label);
+        }
+        labels_[index] = label;
+        pixels.push_back(index);
+      }
+    }
+
+    // Gather the pixels of each curve, relabelling them by curve
+    std::vector<int> curveOfRoot(parents_.size(), -1);
+    std::vector<std::vector<unsigned int> > points;
+    for (unsigned int i = 0; i < pixels.size(); i++)
+    {
+      int root = findRoot(labels_[pixels[i]]);
+      if (curveOfRoot[root] < 0)
+      {
+        curveOfRoot[root] = points.size();
+        points.push_back(std::vector<unsigned int>());
+      }
+      labels_[pixels[i]] = curveOfRoot[root];
+      points[curveOfRoot[root]].push_back(pixels[i]);
+    }
+
+    for (unsigned int label = 0; label < points.size(); label++)
+    {
+      if (static_cast<int>(points[label].size()) <= minimumPoints)
+      {
+        continue;
+      }
+      curves->push_back(Curve());
+      Curve& curve = curves->back();
+      curve.points.swap(points[label]);
+
+      // A walk from an end point (or any pixel, if the curve is closed)
+      // ends at an end point; a walk from that ends at the farthest one
+      unsigned int start = curve.points[0];
+      for (unsigned int i = 0; i < curve.points.size(); i++)
+      {
+        if (degrees_[curve.points[i]] <= 1)
+        {
+          start = curve.points[i];
+          break;
+        }
+      }
+      curve.first = farthest(label, start);
+      curve.second = farthest(label, curve.first);
+    }
+  }
+
+
+
+  int CurveExtraction::findRoot(int label)
+  {
+    int root = label;
+    while (parents_[root] != root)
+    {
+      root = parents_[root];
+    }
+    while (parents_[label] != root)
+    {
+      int next = parents_[label];
+      parents_[label] = root;
+      label = next;
+    }
+    return root;
+  }
+
+
+
+  void CurveExtraction::join(int first, int second)
+  {
+    first = findRoot(first);
+    second = findRoot(second);
+    if (first < second)
+    {
+      parents_[second] = first;
+    }
+    else if (second < first)
+    {
+      parents_[first] = second;
+    }
+  }
+
+
+
+  unsigned int CurveExtraction::farthest(int label, unsigned int start)
+  {
+    queue_.clear();
+    queue_.push_back(start);
+    visited_[start] = 1;
+
+    for (unsigned int head = 0; head < queue_.size(); head++)
+    {
+      int row = queue_[head] / cols_;
+      int col = queue_[head] % cols_;
+      for (int r = row - 1; r <= row + 1; r++)
+      {
+        for (int c = col - 1; c <= col + 1; c++)
+        {
+          if (r < 0 || r >= rows_ || c < 0 || c >= cols_)
+          {
+            continue;
+          }
+          unsigned int index = r * cols_ + c;
+          if (!visited_[index] && labels_[index] == label)
+          {
+            visited_[index] = 1;
+            queue_.push_back(index);
+          }
+        }
+      }
+    }
+
+    for (unsigned int i = 0; i < queue_.size(); i++)
+    {
+      visited_[queue_[i]] = 0;
+    }
+    return queue_.back();
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -0,0 +1,393 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include "utils/profiler.h"
+#include <time.h>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <boost/thread/mutex.hpp>
+#include <ros/ros.h>
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  namespace
+  {
+    // The minimum of a probe that has not been measured
+    const uint64_t NO_MIN = std::numeric_limits<uint64_t>::max();
+
+    /**
+      @struct Slot
+      @brief The measurements of a probe by a single thread. Only that
+      thread writes them; they are read and written through relaxed atomic
+      operations so that a report never reads a torn value
+     **/
+    struct Slot
+    {
+      uint64_t count;
+      uint64_t total;
+      uint64_t min;
+      uint64_t max;
+    };
+
+    /**
+      @struct ThreadSlots
+      @brief The slots of all probes of a thread
+     **/
+    struct ThreadSlots
+    {
+      ThreadSlots()
+      {
+        for (int i = 0; i < Profiler::MAX_PROBES; i++)
+        {
+          slots[i].count = 0;
+          slots[i].total = 0;
+          slots[i].min = NO_MIN;
+          slots[i].max = 0;
+        }
+      }
+
+      Slot slots[Profiler::MAX_PROBES];
+    };
+
+    inline uint64_t load(const uint64_t* value)
+    {
+      return __atomic_load_n(value, __ATOMIC_RELAXED);
+    }
+
+    inline void store(uint64_t* value, uint64_t newValue)
+    {
+      __atomic_store_n(value, newValue, __ATOMIC_RELAXED);
+    }
+
+    /**
+      @struct Registry
+      @brief The probes and the slots of every thread that has measured
+      something. The slots of a thread outlive it, so that its measurements
+      stay in the reports
+     **/
+    struct Registry
+    {
+      Registry() : probes(0), reportPeriod(1000000000ULL), lastReport(0) {}
+
+      // Guards the registration of probes and threads
+      boost::mutex mutex;
+
+      int probes;
+      std::string names[Profiler::MAX_PROBES];
+      std::string parents[Profiler::MAX_PROBES];
+      std::vector<ThreadSlots*> threads;
+
+      // Guards the reports
+      boost::mutex reportMutex;
+
+      uint64_t reportPeriod;
+      uint64_t lastReport;
+      std::string traceFile;
+    };
+
+    Registry& registry()
+    {
+      static Registry registry;
+      return registry;
+    }
+
+    // The slots of the calling thread, set on its first measurement
+    __thread ThreadSlots* threadSlots = NULL;
+
+    /**
+      @brief Writes a probe and its children, each one indented
+      under its parent
+      @param[in] probe [int] The index of the probe
+      @param[in] statistics [const std::vector<Profiler::Statistics>&]
+      The statistics of all probes
+      @param[in] indentation [const std::string&] The indentation of
+      the probe
+      @param[out] out [std::ostream&] The stream to write to
+      @return void
+     **/
+    void writeSubtree(int probe,
+      const std::vector<Profiler::Statistics>& statistics,
+      const std::string& indentation,
+      std::ostream& out)
+    {
+      const Profiler::Statistics& s = statistics[probe];
+      out << indentation << s.name << " [" << s.count << " - ";
+      if (s.count > 0)
+      {
+        out << s.min / 1e6 << " , " << s.total / 1e6 / s.count << " , "
+          << s.max / 1e6;
+      }
+      else
+      {
+        out << "- , - , -";
+      }
+      out << " - " << s.total / 1e6 << "]\n";
+
+      for (unsigned int i = 0; i < statistics.size(); i++)
+      {
+        if (static_cast<int>(i) != probe && statistics[i].parent == s.name)
+        {
+          writeSubtree(i, statistics, indentation + "|-", out);
+        }
+      }
+    }
+  }  // namespace
+
+
+
+  int Profiler::registerProbe(const char* name, const char* parent)
+  {
+    Registry& r = registry();
+    boost::mutex::scoped_lock lock(r.mutex);
+
+    for (int i = 0; i < r.probes; i++)
+    {
+      if (r.names[i] == name)
+      {
+        return i;
+      }
+    }
+
+    if (r.probes == MAX_PROBES)
+    {
+      ROS_WARN_NAMED(PKG_NAME,
+        "[Profiler] No room left for probe %s", name);
+      return -1;
+    }
+
+    r.names[r.probes] = name;
+    r.parents[r.probes] = parent;
+    return r.probes++;
+  }
+
+
+
+  uint64_t Profiler::now()
+  {
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + time.tv_nsec;
+  }
+
+
+
+  void Profiler::record(int probe, uint64_t duration)
+  {
+    if (threadSlots == NULL)
+    {
+      threadSlots = new ThreadSlots;
+
+      Registry& r = registry();
+      boost::mutex::scoped_lock lock(r.mutex);
+      r.threads.push_back(threadSlots);
+    }
+
+    Slot& slot = threadSlots->slots[probe];
+    store(&slot.count, slot.count + 1);
+    store(&slot.total, slot.total + duration);
+    if (duration < slot.min)
+    {
+      store(&slot.min, duration);
+    }
+    if (duration > slot.max)
+    {
+      store(&slot.max, duration);
+    }
+  }
+
+
+
+  void Profiler::rootDone()
+  {
+    Registry& r = registry();
+
+    // A report in progress in another thread covers this one too
+    boost::mutex::scoped_try_lock lock(r.reportMutex);
+    if (!lock.owns_lock())
+    {
+      return;
+    }
+
+    uint64_t time = now();
+    if (r.lastReport != 0 && time - r.lastReport < r.reportPeriod)
+    {
+      return;
+    }
+    r.lastReport = time;
+
+    std::ostringstream tree;
+    writeTree(tree);
+    ROS_INFO_STREAM_NAMED(PKG_NAME,
+      "Probes : [count - min , mean , max - total] (ms)\n" << tree.str());
+
+    if (!r.traceFile.empty())
+    {
+      std::ofstream trace(r.traceFile.c_str());
+      writeTrace(trace);
+    }
+  }
+
+
+
+  std::vector<Profiler::Statistics> Profiler::collect()
+  {
+    Registry& r = registry();
+    boost::mutex::scoped_lock lock(r.mutex);
+
+    std::vector<Statistics> statistics(r.probes);
+    for (int i = 0; i < r.probes; i++)
+    {
+      Statistics& s = statistics[i];
+      s.name = r.names[i];
+      s.parent = r.parents[i];
+      s.count = 0;
+      s.total = 0;
+      s.min = NO_MIN;
+      s.max = 0;
+
+      for (unsigned int t = 0; t < r.threads.size(); t++)
+      {
+        const Slot& slot = r.threads[t]->slots[i];
+        s.count += load(&slot.count);
+        s.total += load(&slot.total);
+        s.min = std::min(s.min, load(&slot.min));
+        s.max = std::max(s.max, load(&slot.max));
+      }
+    }
+
+    return statistics;
+  }
+
+
+
+  void Profiler::writeTree(std::ostream& out)
+  {
+    std::vector<Statistics> statistics = collect();
+
+    for (unsigned int i = 0; i < statistics.size(); i++)
+    {
+      // Roots are the probes without a parent, or with one never registered
+      bool root = true;
+      for (unsigned int j = 0; j < statistics.size(); j++)
+      {
+        if (j != i && statistics[j].name == statistics[i].parent)
+        {
+          root = false;
+          break;
+        }
+      }
+
+      if (root)
+      {
+        writeSubtree(i, statistics, "", out);
+      }
+    }
+  }
+
+
+
+  void Profiler::writeTrace(std::ostream& out)
+  {
+    std::vector<Statistics> statistics = collect();
+
+    out << "probe,parent,count,total,min,mean,max\n";
+    for (unsigned int i = 0; i < statistics.size(); i++)
+    {
+      const Statistics& s = statistics[i];
+      out << s.name << "," << s.parent << "," << s.count << ","
+        << s.total / 1e6;
+      if (s.count > 0)
+      {
+        out << "," << s.min / 1e6 << "," << s.total / 1e6 / s.count
+          << "," << s.max / 1e6;
+      }
+      else
+      {
+        out << ",,,";
+      }
+      out << "\n";
+    }
+  }
+
+
+
+  void Profiler::setReportPeriod(double seconds)
+  {
+    Registry& r = registry();
+    boost::mutex::scoped_lock lock(r.reportMutex);
+    r.reportPeriod = seconds > 0 ? static_cast<uint64_t>(seconds * 1e9) : 0;
+  }
+
+
+
+  void Profiler::setTraceFile(const std::string& path)
+  {
+    Registry& r = registry();
+    boost::mutex::scoped_lock lock(r.reportMutex);
+    r.traceFile = path;
+  }
+
+
+
+  void Profiler::reset()
+  {
+    Registry& r = registry();
+    boost::mutex::scoped_lock lock(r.mutex);
+
+    for (unsigned int t = 0; t < r.threads.size(); t++)
+    {
+      for (int i = 0; i < MAX_PROBES; i++)
+      {
+        Slot& slot = r.threads[t]->slots[i];
+        store(&slot.count, 0);
+        store(&slot.total, 0);
+        store(&slot.min, NO_MIN);
+        store(&slot.max, 0);
+      }
+    }
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -0,0 +1,332 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <set>
+#include <vector>
+
+#include "utils/region.h"
+
+/**
+  @namespace pandora_vision
+  @brief The main namespace for PANDORA vision
+ **/
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  namespace
+  {
+    /**
+      @brief Orders runs, and pixels taken as runs of one, by row and
+      first column
+     **/
+    struct RunOrder
+    {
+      bool operator()(const Region::Run& a, const Region::Run& b) const
+      {
+        return a.row < b.row || (a.row == b.row && a.begin < b.begin);
+      }
+    };
+  }
+
+  Region::Region() :
+    cols_(0), area_(0)
+  {
+  }
+
+  Region::Region(int cols) :
+    cols_(cols), area_(0)
+  {
+  }
+
+  Region Region::fromMask(const cv::Mat& mask)
+  {
+    Region region(mask.cols);
+
+    for (int rows = 0; rows < mask.rows; rows++)
+    {
+      const unsigned char* ptr = mask.ptr<unsigned char>(rows);
+
+      int cols = 0;
+      while (cols < mask.cols)
+      {
+        if (ptr[cols] == 0)
+        {
+          cols++;
+          continue;
+        }
+
+        int begin = cols;
+        while (cols < mask.cols && ptr[cols] != 0)
+        {
+          cols++;
+        }
+
+        Run run = {rows, begin, cols};
+        region.runs_.push_back(run);
+        region.area_ += cols - begin;
+      }
+    }
+
+    return region;
+  }
+
+  Region Region::fromIndices(const std::set<unsigned int>& indices,
+    int cols)
+  {
+    Region region(cols);
+
+    for (std::set<unsigned int>::const_iterator it = indices.begin();
+      it != indices.end(); it++)
+    {
+      int col = *it % cols;
+      region.append(*it / cols, col, col + 1);
+    }
+
+    return region;
+  }
+
+  void Region::toMask(cv::Mat* mask, unsigned char value) const
+  {
+    for (unsigned int r = 0; r < runs_.size(); r++)
+    {
+      unsigned char* ptr = mask->ptr<unsigned char>(runs_[r].row);
+      std::memset(ptr + runs_[r].begin, value, runs_[r].end - runs_[r].begin);
+    }
+  }
+
+  void Region::toIndices(std::vector<unsigned int>* indices) const
+  {
+    indices->reserve(indices->size() + area_);
+
+    for (unsigned int r = 0; r < runs_.size(); r++)
+    {
+      unsigned int first = runs_[r].row * cols_;
+      for (int c = runs_[r].begin; c < runs_[r].end; c++)
+      {
+        indices->push_back(first + c);
+      }
+    }
+  }
+
+  void Region::append(int row, int begin, int end)
+  {
+    if (begin >= end)
+    {
+      return;
+    }
+
+    if (!runs_.empty() && runs_.back().row == row
+      && begin <= runs_.back().end)
+    {
+      if (end > runs_.back().end)
+      {
+        area_ += end - runs_.back().end;
+        runs_.back().end = end;
+      }
+      return;
+    }
+
+    Run run = {row, begin, end};
+    runs_.push_back(run);
+    area_ += end - begin;
+  }
+
+  Region Region::unite(const Region& other) const
+  {
+    Region region(cols_);
+    region.runs_.reserve(runs_.size() + other.runs_.size());
+
+    RunOrder before;
+    unsigned int i = 0;
+    unsigned int j = 0;
+
+    // Merge the two lists of runs in order; append() joins the runs that
+    // touch or overlap
+    while (i < runs_.size() || j < other.runs_.size())
+    {
+      const Run& run = (j == other.runs_.size()
+        || (i < runs_.size() && before(runs_[i], other.runs_[j]))) ?
+        runs_[i++] : other.runs_[j++];
+
+      region.append(run.row, run.begin, run.end);
+    }
+
+    return region;
+  }
+
+  Region Region::intersect(const Region& other) const
+  {
+    Region region(cols_);
+
+    unsigned int i = 0;
+    unsigned int j = 0;
+
+    while (i < runs_.size() && j < other.runs_.size())
+    {
+      const Run& a = runs_[i];
+      const Run& b = other.runs_[j];
+
+      if (a.row != b.row)
+      {
+        a.row < b.row ? i++ : j++;
+        continue;
+      }
+
+      region.append(a.row, std::max(a.begin, b.begin), std::min(a.end, b.end));
+
+      // The run that ends first cannot overlap any later run of the other
+      a.end < b.end ? i++ : j++;
+    }
+
+    return region;
+  }
+
+  Region Region::subtract(const Region& other) const
+  {
+    Region region(cols_);
+
+    unsigned int j = 0;
+
+    for (unsigned int i = 0; i < runs_.size(); i++)
+    {
+      const Run& a = runs_[i];
+      int begin = a.begin;
+
+      // Skip the other's runs that end before this one begins
+      while (j < other.runs_.size() && (other.runs_[j].row < a.row
+          || (other.runs_[j].row == a.row && other.runs_[j].end <= begin)))
+      {
+        j++;
+      }
+
+      // Cut out the other's runs that overlap this one. They may overlap
+      // the next run of this region too, so j stays where it is
+      for (unsigned int k = j; k < other.runs_.size()
+        && other.runs_[k].row == a.row && other.runs_[k].begin < a.end; k++)
+      {
+        region.append(a.row, begin, other.runs_[k].begin);
+        begin = std::max(begin, other.runs_[k].end);
+      }
+
+      region.append(a.row, begin, a.end);
+    }
+
+    return region;
+  }
+
+  int Region::intersectionArea(const Region& other) const
+  {
+    int area = 0;
+
+    unsigned int i = 0;
+    unsigned int j = 0;
+
+    while (i < runs_.size() && j < other.runs_.size())
+    {
+      const Run& a = runs_[i];
+      const Run& b = other.runs_[j];
+
+      if (a.row != b.row)
+      {
+        a.row < b.row ? i++ : j++;
+        continue;
+      }
+
+      area += std::max(0, std::min(a.end, b.end) - std::max(a.begin, b.begin));
+
+      a.end < b.end ? i++ : j++;
+    }
+
+    return area;
+  }
+
+  bool Region::contains(unsigned int index) const
+  {
+    if (cols_ == 0)
+    {
+      return false;
+    }
+
+    Run pixel = {static_cast<int>(index / cols_),
+      static_cast<int>(index % cols_), 0};
+    pixel.end = pixel.begin + 1;
+
+    // The first run that begins after the pixel; the pixel can only be in
+    // the one before it
+    std::vector<Run>::const_iterator it =
+      std::upper_bound(runs_.begin(), runs_.end(), pixel, RunOrder());
+
+    if (it == runs_.begin())
+    {
+      return false;
+    }
+
+    --it;
+    return it->row == pixel.row && pixel.begin < it->end;
+  }
+
+  cv::Rect Region::boundingBox() const
+  {
+    if (runs_.empty())
+    {
+      return cv::Rect();
+    }
+
+    int left = runs_[0].begin;
+    int right = runs_[0].end;
+
+    for (unsigned int r = 1; r < runs_.size(); r++)
+    {
+      left = std::min(left, runs_[r].begin);
+      right = std::max(right, runs_[r].end);
+    }
+
+    return cv::Rect(left, runs_.front().row,
+      right - left, runs_.back().row - runs_.front().row + 1);
+  }
+
+  void Region::clear()
+  {
+    runs_.clear();
+    area_ = 0;
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
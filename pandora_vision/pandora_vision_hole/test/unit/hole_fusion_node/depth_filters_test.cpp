@@ -326,12 +326,12 @@ namespace hole_fusion
   TEST_F ( DepthFiltersTest, checkHolesDepthAreaTest )
   {
     // Generate the vector of holes' mask (set)
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
+    std::vector< Region > holesMasksRegionVector;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     // Needed vectors by the DepthFilters::checkHolesDepthDiff method
     std::vector<std::string> msgs;
@@ -341,7 +341,7 @@ namespace hole_fusion
     DepthFilters::checkHolesDepthArea(
       conveyor,
       squares_,
-      holesMasksSetVector,
+      holesMasksRegionVector,
       &msgs,
       &probabilitiesVector );
 
@@ -515,12 +515,12 @@ namespace hole_fusion
   TEST_F ( DepthFiltersTest, checkHolesDepthHomogeneityTest)
   {
     // Generate the vector of holes' mask (set)
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
+    std::vector< Region > holesMasksRegionVector;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     // Needed vectors by the DepthFilters::checkHolesDepthHomogeneity method
     std::vector<std::string> msgs;
@@ -530,7 +530,7 @@ namespace hole_fusion
     DepthFilters::checkHolesDepthHomogeneity(
       conveyor,
       squares_,
-      holesMasksSetVector,
+      holesMasksRegionVector,
       &msgs,
       &probabilitiesVector );
 
@@ -558,14 +558,14 @@ namespace hole_fusion
       &inflatedRectanglesIndices_0 );
 
     // Generate the intermediate points set vector
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_0;
+    std::vector< Region > intermediatePointsRegionVector_0;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // Needed vectors by the
     // DepthFilters::checkHolesOutlineToRectanglePlaneConstitution method
@@ -576,7 +576,7 @@ namespace hole_fusion
     DepthFilters::checkHolesOutlineToRectanglePlaneConstitution(
       squares_,
       cloud,
-      intermediatePointsSetVector_0,
+      intermediatePointsRegionVector_0,
       inflatedRectanglesIndices_0,
       &probabilitiesVector_0,
       &msgs );
@@ -600,14 +600,14 @@ namespace hole_fusion
       &inflatedRectanglesIndices_10 );
 
     // Generate the intermediate points set vector
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_10;
+    std::vector< Region > intermediatePointsRegionVector_10;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       inflatedRectanglesVector_10,
       inflatedRectanglesIndices_10,
-      &intermediatePointsSetVector_10 );
+      &intermediatePointsRegionVector_10 );
 
     // Needed vectors by the
     // DepthFilters::checkHolesOutlineToRectanglePlaneConstitution method
@@ -618,7 +618,7 @@ namespace hole_fusion
     DepthFilters::checkHolesOutlineToRectanglePlaneConstitution(
       squares_,
       cloud,
-      intermediatePointsSetVector_10,
+      intermediatePointsRegionVector_10,
       inflatedRectanglesIndices_10,
       &probabilitiesVector_10,
       &msgs );
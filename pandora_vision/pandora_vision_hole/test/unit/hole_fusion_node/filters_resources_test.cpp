@@ -197,11 +197,11 @@ namespace hole_fusion
 
     // The needed resources
     std::vector< cv::Mat > holesMasksImageVector;
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
+    std::vector< Region > holesMasksRegionVector;
     std::vector< std::vector< cv::Point2f > > inflatedRectanglesVector;
     std::vector< int > inflatedRectanglesIndices;
     std::vector< cv::Mat > intermediatePointsImageVector;
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector;
+    std::vector< Region > intermediatePointsRegionVector;
 
     for ( int a = 0; a < 2; a++ )
     {
@@ -246,11 +246,11 @@ namespace hole_fusion
                         2,
                         RGBD_MODE,
                         &holesMasksImageVector,
-                        &holesMasksSetVector,
+                        &holesMasksRegionVector,
                         &inflatedRectanglesVector,
                         &inflatedRectanglesIndices,
                         &intermediatePointsImageVector,
-                        &intermediatePointsSetVector );
+                        &intermediatePointsRegionVector );
 
 
                       // Inquire about holesMasksImageVector
@@ -286,23 +286,23 @@ namespace hole_fusion
                       }
 
 
-                      // Inquire about holesMasksSetVector
+                      // Inquire about holesMasksRegionVector
                       if ( b == 1 || d == 1 || f == 1 || i == 1 )
                       {
                         // There should be three masks of holes
-                        EXPECT_EQ ( 3, holesMasksSetVector.size() );
+                        EXPECT_EQ ( 3, holesMasksRegionVector.size() );
 
-                        for ( int j = 0; j < holesMasksSetVector.size(); j++ )
+                        for ( int j = 0; j < holesMasksRegionVector.size(); j++ )
                         {
                           // Each mask should have 100 X 100 points
-                          EXPECT_EQ ( 10000, holesMasksSetVector[j].size() );
+                          EXPECT_EQ ( 10000, holesMasksRegionVector[j].area() );
                         }
                       }
                       else if ( b != 1 && d != 1 && f != 1 && i != 1 )
                       {
                         // No masks if the corresponding filters to variables
                         // b, d, f and i are disabled
-                        EXPECT_EQ ( 0, holesMasksSetVector.size() );
+                        EXPECT_EQ ( 0, holesMasksRegionVector.size() );
                       }
 
 
@@ -373,35 +373,35 @@ namespace hole_fusion
                       }
 
 
-                      // Inquire about intermediatePointsSetVector
+                      // Inquire about intermediatePointsRegionVector
                       if ( b == 1 || d == 1 || g == 1 )
                       {
                         // There should be two masks of intermediate points
-                        EXPECT_EQ ( 2, intermediatePointsSetVector.size() );
+                        EXPECT_EQ ( 2, intermediatePointsRegionVector.size() );
 
                         for ( int j = 0;
-                          j < intermediatePointsSetVector.size(); j++ )
+                          j < intermediatePointsRegionVector.size(); j++ )
                         {
                           // There should be more than 400 intermediate points
                           EXPECT_LT ( 400,
-                            intermediatePointsSetVector[j].size() );
+                            intermediatePointsRegionVector[j].area() );
                         }
                       }
                       else
                       {
                         // No masks if the corresponding filters to variables
                         // b, d and g are disabled
-                        EXPECT_EQ ( 0, intermediatePointsSetVector.size() );
+                        EXPECT_EQ ( 0, intermediatePointsRegionVector.size() );
                       }
 
 
                       // Clear the vectors for the next run
                       holesMasksImageVector.clear();
-                      holesMasksSetVector.clear();
+                      holesMasksRegionVector.clear();
                       inflatedRectanglesVector.clear();
                       inflatedRectanglesIndices.clear();
                       intermediatePointsImageVector.clear();
-                      intermediatePointsSetVector.clear();
+                      intermediatePointsRegionVector.clear();
 
                     }
                   }
@@ -417,11 +417,11 @@ namespace hole_fusion
 
     // The needed resources
     holesMasksImageVector.clear();
-    holesMasksSetVector.clear();
+    holesMasksRegionVector.clear();
     inflatedRectanglesVector.clear();
     inflatedRectanglesIndices.clear();
     intermediatePointsImageVector.clear();
-    intermediatePointsSetVector.clear();
+    intermediatePointsRegionVector.clear();
 
     for ( int a = 0; a < 2; a++ )
     {
@@ -446,11 +446,11 @@ namespace hole_fusion
               2,
               RGB_ONLY_MODE,
               &holesMasksImageVector,
-              &holesMasksSetVector,
+              &holesMasksRegionVector,
               &inflatedRectanglesVector,
               &inflatedRectanglesIndices,
               &intermediatePointsImageVector,
-              &intermediatePointsSetVector );
+              &intermediatePointsRegionVector );
 
 
             // Inquire about holesMasksImageVector
@@ -486,23 +486,23 @@ namespace hole_fusion
             }
 
 
-            // Inquire about holesMasksSetVector
+            // Inquire about holesMasksRegionVector
             if ( b == 1 || d == 1 )
             {
               // There should be three masks of holes
-              EXPECT_EQ ( 3, holesMasksSetVector.size() );
+              EXPECT_EQ ( 3, holesMasksRegionVector.size() );
 
-              for ( int j = 0; j < holesMasksSetVector.size(); j++ )
+              for ( int j = 0; j < holesMasksRegionVector.size(); j++ )
               {
                 // Each mask should have 100 X 100 points
-                EXPECT_EQ ( 10000, holesMasksSetVector[j].size() );
+                EXPECT_EQ ( 10000, holesMasksRegionVector[j].area() );
               }
             }
             else if ( b != 1 && d != 1 )
             {
               // No masks if the corresponding filters to variables
               // b, d, f and i are disabled
-              EXPECT_EQ ( 0, holesMasksSetVector.size() );
+              EXPECT_EQ ( 0, holesMasksRegionVector.size() );
             }
 
 
@@ -571,35 +571,35 @@ namespace hole_fusion
             }
 
 
-            // Inquire about intermediatePointsSetVector
+            // Inquire about intermediatePointsRegionVector
             if ( b == 1 || d == 1 )
             {
               // There should be two masks of intermediate points
-              EXPECT_EQ ( 2, intermediatePointsSetVector.size() );
+              EXPECT_EQ ( 2, intermediatePointsRegionVector.size() );
 
               for ( int j = 0;
-                j < intermediatePointsSetVector.size(); j++ )
+                j < intermediatePointsRegionVector.size(); j++ )
               {
                 // There should be more than 400 intermediate points
                 EXPECT_LT ( 400,
-                  intermediatePointsSetVector[j].size() );
+                  intermediatePointsRegionVector[j].area() );
               }
             }
             else
             {
               // No masks if the corresponding filters to variables
               // b, d and g are disabled
-              EXPECT_EQ ( 0, intermediatePointsSetVector.size() );
+              EXPECT_EQ ( 0, intermediatePointsRegionVector.size() );
             }
 
 
             // Clear the vectors for the next run
             holesMasksImageVector.clear();
-            holesMasksSetVector.clear();
+            holesMasksRegionVector.clear();
             inflatedRectanglesVector.clear();
             inflatedRectanglesIndices.clear();
             intermediatePointsImageVector.clear();
-            intermediatePointsSetVector.clear();
+            intermediatePointsRegionVector.clear();
 
           }
         }
@@ -616,7 +616,7 @@ namespace hole_fusion
     std::vector< cv::Mat > holesMasksImageVector;
 
     // The indices of points inside the holes in conveyor
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
+    std::vector< Region > holesMasksRegionVector;
 
 
     // Run FiltersResources::createHolesMasksVectors
@@ -624,11 +624,11 @@ namespace hole_fusion
       conveyor,
       squares_,
       &holesMasksImageVector,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     // There should be three masks in total
     EXPECT_EQ ( 3, holesMasksImageVector.size() );
-    EXPECT_EQ ( 3, holesMasksSetVector.size() );
+    EXPECT_EQ ( 3, holesMasksRegionVector.size() );
 
     // The number of non-zero value pixels in all of the images
     int nonZero = 0;
@@ -652,7 +652,7 @@ namespace hole_fusion
 
     for ( int h = 0; h < conveyor.size(); h++ )
     {
-      EXPECT_EQ ( 10000, holesMasksSetVector[h].size() );
+      EXPECT_EQ ( 10000, holesMasksRegionVector[h].area() );
     }
 
   }
@@ -703,35 +703,29 @@ namespace hole_fusion
 
 
 
-  //! Tests FiltersResources::createHolesMasksSetVector
-  TEST_F ( FiltersResourcesTest, createHolesMasksSetVectorTest )
+  //! Tests FiltersResources::createHolesMasksRegionVector
+  TEST_F ( FiltersResourcesTest, createHolesMasksRegionVectorTest )
   {
     // The indices of points inside the holes in conveyor
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
+    std::vector< Region > holesMasksRegionVector;
 
-    // Run FiltersResources::createHolesMasksSetVector
-    FiltersResources::createHolesMasksSetVector(
+    // Run FiltersResources::createHolesMasksRegionVector
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
 
     for ( int h = 0; h < conveyor.size(); h++ )
     {
       // Each mask should have 100 X 100 points
-      EXPECT_EQ ( 10000, holesMasksSetVector[h].size() );
+      EXPECT_EQ ( 10000, holesMasksRegionVector[h].area() );
 
       // Uncomment for visual inspection
       /*
        *
        *      cv::Mat img = cv::Mat::zeros( HEIGHT, WIDTH, CV_8UC1 );
-       *      unsigned char* ptr = img.ptr();
-       *
-       *      for ( std::set<unsigned int>::iterator it = holesMasksSetVector[h].begin();
-       *        it != holesMasksSetVector[h].end(); it++ )
-       *      {
-       *        ptr[*it] = 255;
-       *      }
+       *      holesMasksRegionVector[h].toMask( &img );
        *
        *      Visualization::show ( "Mask", img, 0 );
        *
@@ -830,7 +824,7 @@ namespace hole_fusion
     std::vector< cv::Mat > intermediatePointsImageVector_0;
 
     // The intermediate points vector for all holes
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_0;
+    std::vector< Region > intermediatePointsRegionVector_0;
 
     // Run FiltersResources::createIntermediateHolesPointsVectors
     FiltersResources::createIntermediateHolesPointsVectors(
@@ -839,11 +833,11 @@ namespace hole_fusion
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
       &intermediatePointsImageVector_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // Intermediate points positions should only exist for all of the holes
     ASSERT_EQ ( 3, intermediatePointsImageVector_0.size() );
-    ASSERT_EQ ( 3, intermediatePointsSetVector_0.size() );
+    ASSERT_EQ ( 3, intermediatePointsRegionVector_0.size() );
 
     // The total number of intermediate points in all of the images
     int nonZeroImage = 0;
@@ -866,9 +860,9 @@ namespace hole_fusion
     EXPECT_EQ ( 0, nonZeroImage );
 
     // There shouldn't be any intermediate points for inflation size equal to 0
-    for ( int i = 0; i < intermediatePointsSetVector_0.size(); i++ )
+    for ( int i = 0; i < intermediatePointsRegionVector_0.size(); i++ )
     {
-      EXPECT_EQ ( 0, intermediatePointsSetVector_0[i].size() );
+      EXPECT_EQ ( 0, intermediatePointsRegionVector_0[i].area() );
     }
 
 
@@ -889,7 +883,7 @@ namespace hole_fusion
     std::vector< cv::Mat > intermediatePointsImageVector_2;
 
     // The intermediate points vector for all holes
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_2;
+    std::vector< Region > intermediatePointsRegionVector_2;
 
     // Run FiltersResources::createIntermediateHolesPointsVectors
     FiltersResources::createIntermediateHolesPointsVectors(
@@ -898,12 +892,12 @@ namespace hole_fusion
       inflatedRectanglesVector_2,
       inflatedRectanglesIndices_2,
       &intermediatePointsImageVector_2,
-      &intermediatePointsSetVector_2 );
+      &intermediatePointsRegionVector_2 );
 
     // Intermediate points positions should only exist for all of the holes
     // whose iflated rectangle is within the image's bounds
     ASSERT_EQ ( 2, intermediatePointsImageVector_2.size() );
-    ASSERT_EQ ( 2, intermediatePointsSetVector_2.size() );
+    ASSERT_EQ ( 2, intermediatePointsRegionVector_2.size() );
 
     // The total number of intermediate points in all of the images
     nonZeroImage = 0;
@@ -926,9 +920,9 @@ namespace hole_fusion
     EXPECT_LT ( 2 * 400, nonZeroImage );
 
     // There shouldn't be any intermediate points for inflation size equal to 0
-    for ( int i = 0; i < intermediatePointsSetVector_2.size(); i++ )
+    for ( int i = 0; i < intermediatePointsRegionVector_2.size(); i++ )
     {
-      EXPECT_LT ( 400, intermediatePointsSetVector_2[i].size() );
+      EXPECT_LT ( 400, intermediatePointsRegionVector_2[i].area() );
     }
 
   }
@@ -1039,8 +1033,8 @@ namespace hole_fusion
 
 
 
-  //! Tests FiltersResources::createIntermediateHolesPointsSetVector
-  TEST_F ( FiltersResourcesTest, createIntermediateHolesPointsSetVectorTest )
+  //! Tests FiltersResources::createIntermediateHolesPointsRegionVector
+  TEST_F ( FiltersResourcesTest, createIntermediateHolesPointsRegionVectorTest )
   {
     // First off, we need to obtain the inflated rectangles vector and the
     // corresponding vector of indices of holes with valid inflated rectangles
@@ -1056,23 +1050,23 @@ namespace hole_fusion
       &inflatedRectanglesIndices_0 );
 
     // The intermediate points vector for all holes
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_0;
+    std::vector< Region > intermediatePointsRegionVector_0;
 
-    // Run FiltersResources::createIntermediateHolesPointsSetVector
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    // Run FiltersResources::createIntermediateHolesPointsRegionVector
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // Intermediate points positions should exist for all of the holes
-    ASSERT_EQ ( 3, intermediatePointsSetVector_0.size() );
+    ASSERT_EQ ( 3, intermediatePointsRegionVector_0.size() );
 
     // There shouldn't be any intermediate points for inflation size equal to 0
-    for ( int i = 0; i < intermediatePointsSetVector_0.size(); i++ )
+    for ( int i = 0; i < intermediatePointsRegionVector_0.size(); i++ )
     {
-      EXPECT_EQ ( 0, intermediatePointsSetVector_0[i].size() );
+      EXPECT_EQ ( 0, intermediatePointsRegionVector_0[i].area() );
     }
 
     // First off, we need to obtain the inflated rectangles vector and the
@@ -1089,39 +1083,32 @@ namespace hole_fusion
       &inflatedRectanglesIndices_2 );
 
     // The intermediate points vector for all holes
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_2;
+    std::vector< Region > intermediatePointsRegionVector_2;
 
-    // Run FiltersResources::createIntermediateHolesPointsSetVector
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    // Run FiltersResources::createIntermediateHolesPointsRegionVector
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       inflatedRectanglesVector_2,
       inflatedRectanglesIndices_2,
-      &intermediatePointsSetVector_2 );
+      &intermediatePointsRegionVector_2 );
 
     // Intermediate points should only exist for the two holes
-    ASSERT_EQ ( 2, intermediatePointsSetVector_2.size() );
+    ASSERT_EQ ( 2, intermediatePointsRegionVector_2.size() );
 
     // There should be more than 4 X 100 intermediate points
-    for ( int i = 0; i < intermediatePointsSetVector_2.size(); i++ )
+    for ( int i = 0; i < intermediatePointsRegionVector_2.size(); i++ )
     {
-      EXPECT_LT ( 400, intermediatePointsSetVector_2[i].size() );
+      EXPECT_LT ( 400, intermediatePointsRegionVector_2[i].area() );
     }
 
     // Uncomment for visual inspection
     /*
-     *    for ( int h = 0; h < intermediatePointsSetVector_2.size(); h++ )
+     *    for ( int h = 0; h < intermediatePointsRegionVector_2.size(); h++ )
      *    {
      *
      *      cv::Mat img = cv::Mat::zeros( HEIGHT, WIDTH, CV_8UC1 );
-     *      unsigned char* ptr = img.ptr();
-     *
-     *      for ( std::set<unsigned int>::iterator it =
-     *        intermediatePointsSetVector_2[h].begin();
-     *        it != intermediatePointsSetVector_2[h].end(); it++ )
-     *      {
-     *        ptr[*it] = 255;
-     *      }
+     *      intermediatePointsRegionVector_2[h].toMask( &img );
      *
      *      Visualization::show ( "Intermediate Points", img, 0 );
      *    }
@@ -1129,6 +1116,89 @@ namespace hole_fusion
      */
   }
 
+
+
+
+  //! Tests that FiltersResources reuses the resources of the holes
+  //! of the previous frame
+  TEST_F ( FiltersResourcesTest, resourcesCacheTest )
+  {
+    FiltersResources::clearCache();
+
+    // The resources computed without the cache
+    Parameters::HoleFusion::resources_cache_size = 0;
+
+    std::vector< Region > uncachedMasks;
+    FiltersResources::createHolesMasksRegionVector(
+      conveyor,
+      squares_,
+      &uncachedMasks );
+
+    std::vector< std::vector< cv::Point2f > > inflatedRectanglesVector;
+    std::vector< int > inflatedRectanglesIndices;
+    FiltersResources::createInflatedRectanglesVector(
+      conveyor,
+      squares_,
+      2,
+      &inflatedRectanglesVector,
+      &inflatedRectanglesIndices );
+
+    std::vector< Region > uncachedIntermediatePoints;
+    FiltersResources::createIntermediateHolesPointsRegionVector(
+      conveyor,
+      squares_,
+      inflatedRectanglesVector,
+      inflatedRectanglesIndices,
+      &uncachedIntermediatePoints );
+
+    EXPECT_EQ ( 0, FiltersResources::getCacheStatistics().misses );
+
+    // Two frames with the same holes
+    Parameters::HoleFusion::resources_cache_size = 64;
+
+    for ( int frame = 0; frame < 2; frame++ )
+    {
+      std::vector< Region > masks;
+      FiltersResources::createHolesMasksRegionVector(
+        conveyor,
+        squares_,
+        &masks );
+
+      std::vector< Region > intermediatePoints;
+      FiltersResources::createIntermediateHolesPointsRegionVector(
+        conveyor,
+        squares_,
+        inflatedRectanglesVector,
+        inflatedRectanglesIndices,
+        &intermediatePoints );
+
+      ASSERT_EQ ( uncachedMasks.size(), masks.size() );
+      for ( int h = 0; h < masks.size(); h++ )
+      {
+        std::vector< unsigned int > expected, actual;
+        uncachedMasks[h].toIndices( &expected );
+        masks[h].toIndices( &actual );
+        EXPECT_EQ ( expected, actual );
+      }
+
+      ASSERT_EQ ( uncachedIntermediatePoints.size(),
+        intermediatePoints.size() );
+      for ( int h = 0; h < intermediatePoints.size(); h++ )
+      {
+        std::vector< unsigned int > expected, actual;
+        uncachedIntermediatePoints[h].toIndices( &expected );
+        intermediatePoints[h].toIndices( &actual );
+        EXPECT_EQ ( expected, actual );
+      }
+    }
+
+    // Only the masks of the first frame missed the cache
+    EXPECT_EQ ( 3, FiltersResources::getCacheStatistics().misses );
+    EXPECT_EQ ( 7, FiltersResources::getCacheStatistics().hits );
+
+    FiltersResources::clearCache();
+  }
+
 } // hole_fusion
 } // namespace pandora_vision_hole
 } // namespace pandora_vision
@@ -521,12 +521,12 @@ namespace hole_fusion
     // Inflations size : 0
 
     // Create the needed by the Filters::applyFilter method vectors
-    std::vector< std::set<unsigned int > > holesMasksSetVector_0;
+    std::vector< Region > holesMasksRegionVector_0;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       depthSquares_,
-      &holesMasksSetVector_0);
+      &holesMasksRegionVector_0);
 
     // The vector of mask images
     std::vector< cv::Mat > holesMasksImageVector_0;
@@ -547,14 +547,14 @@ namespace hole_fusion
       &inflatedRectanglesIndices_0 );
 
     // The intermediate points vector of sets
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_0;
+    std::vector< Region > intermediatePointsRegionVector_0;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       depthSquares_,
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // The intermediate points vector of images
     std::vector< cv::Mat > intermediatePointsImageVector_0;
@@ -592,11 +592,11 @@ namespace hole_fusion
         rgbSquares_,
         histogram,
         cloud,
-        holesMasksSetVector_0,
+        holesMasksRegionVector_0,
         holesMasksImageVector_0,
         inflatedRectanglesVector_0,
         inflatedRectanglesIndices_0,
-        intermediatePointsSetVector_0,
+        intermediatePointsRegionVector_0,
         intermediatePointsImageVector_0,
         &probabilitiesVector_0,
         &imgs,
@@ -618,7 +618,7 @@ namespace hole_fusion
       if ( f == 2 )
       {
         // All probabilities amount to zero: the size of each set inside the
-        // intermediatePointsSetVector_0 vector is zero
+        // intermediatePointsRegionVector_0 vector is zero
         for ( int i = 0; i < probabilitiesVector_0.size(); i++ )
         {
           EXPECT_EQ ( 0.0, probabilitiesVector_0[i] );
@@ -688,12 +688,12 @@ namespace hole_fusion
     // Inflations size : 10
 
     // Create the needed by the Filters::applyFilter method vectors
-    std::vector< std::set<unsigned int > > holesMasksSetVector_10;
+    std::vector< Region > holesMasksRegionVector_10;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       depthSquares_,
-      &holesMasksSetVector_10);
+      &holesMasksRegionVector_10);
 
     // The vector of mask images
     std::vector< cv::Mat > holesMasksImageVector_10;
@@ -713,14 +713,14 @@ namespace hole_fusion
       &inflatedRectanglesVector_10,
       &inflatedRectanglesIndices_10 );
 
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_10;
+    std::vector< Region > intermediatePointsRegionVector_10;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       depthSquares_,
       inflatedRectanglesVector_10,
       inflatedRectanglesIndices_10,
-      &intermediatePointsSetVector_10 );
+      &intermediatePointsRegionVector_10 );
 
     // The intermediate points vector of images
     std::vector< cv::Mat > intermediatePointsImageVector_10;
@@ -755,11 +755,11 @@ namespace hole_fusion
         rgbSquares_,
         histogram,
         cloud,
-        holesMasksSetVector_10,
+        holesMasksRegionVector_10,
         holesMasksImageVector_10,
         inflatedRectanglesVector_10,
         inflatedRectanglesIndices_10,
-        intermediatePointsSetVector_10,
+        intermediatePointsRegionVector_10,
         intermediatePointsImageVector_10,
         &probabilitiesVector_10,
         &imgs,
@@ -854,15 +854,19 @@ namespace hole_fusion
   //! Tests Filters::applyFiltersTest:
   TEST_F ( FiltersTest, applyFiltersTest )
   {
+    // The probabilities of every filter are checked for every hole,
+    // so no filter may be skipped
+    Parameters::HoleFusion::Validation::short_circuit_filters = false;
+
     /////////////////////////// Inflations size : 0 ////////////////////////////
 
     // Create the needed by the Filters::applyFilters method vectors
-    std::vector< std::set<unsigned int > > holesMasksSetVector_0;
+    std::vector< Region > holesMasksRegionVector_0;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       depthSquares_,
-      &holesMasksSetVector_0);
+      &holesMasksRegionVector_0);
 
     // The vector of mask images
     std::vector< cv::Mat > holesMasksImageVector_0;
@@ -883,14 +887,14 @@ namespace hole_fusion
       &inflatedRectanglesIndices_0 );
 
     // The intermediate points vector of sets
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_0;
+    std::vector< Region > intermediatePointsRegionVector_0;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       depthSquares_,
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // The intermediate points vector of images
     std::vector< cv::Mat > intermediatePointsImageVector_0;
@@ -937,11 +941,11 @@ namespace hole_fusion
       rgbSquares_,
       histogram,
       cloud,
-      holesMasksSetVector_0,
+      holesMasksRegionVector_0,
       holesMasksImageVector_0,
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
-      intermediatePointsSetVector_0,
+      intermediatePointsRegionVector_0,
       intermediatePointsImageVector_0,
       &probabilitiesVector2D_0_RGBD_MODE );
 
@@ -1006,7 +1010,7 @@ namespace hole_fusion
       if (f == Parameters::Filters::LuminosityDiff::rgbd_priority - 1)
       {
         // All probabilities amount to zero: the size of each set inside the
-        // intermediatePointsSetVector_0 vector is zero
+        // intermediatePointsRegionVector_0 vector is zero
         EXPECT_EQ ( 0.0, probabilitiesVector2D_0_RGBD_MODE[f][0] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_0_RGBD_MODE[f][1] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_0_RGBD_MODE[f][2] );
@@ -1042,11 +1046,11 @@ namespace hole_fusion
       rgbSquares_,
       histogram,
       cloud,
-      holesMasksSetVector_0,
+      holesMasksRegionVector_0,
       holesMasksImageVector_0,
       inflatedRectanglesVector_0,
       inflatedRectanglesIndices_0,
-      intermediatePointsSetVector_0,
+      intermediatePointsRegionVector_0,
       intermediatePointsImageVector_0,
       &probabilitiesVector2D_0_RGB_ONLY_MODE );
 
@@ -1065,7 +1069,7 @@ namespace hole_fusion
       if (f == Parameters::Filters::LuminosityDiff::rgb_priority - 1)
       {
         // All probabilities amount to zero: the size of each set inside the
-        // intermediatePointsSetVector_0 vector is zero
+        // intermediatePointsRegionVector_0 vector is zero
         EXPECT_EQ ( 0.0, probabilitiesVector2D_0_RGB_ONLY_MODE[f][0] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_0_RGB_ONLY_MODE[f][1] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_0_RGB_ONLY_MODE[f][2] );
@@ -1077,12 +1081,12 @@ namespace hole_fusion
     ////////////////////////// Inflations size : 10 ////////////////////////////
 
     // Create the needed by the Filters::applyFilters method vectors
-    std::vector< std::set<unsigned int > > holesMasksSetVector_10;
+    std::vector< Region > holesMasksRegionVector_10;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       depthSquares_,
-      &holesMasksSetVector_10);
+      &holesMasksRegionVector_10);
 
     // The vector of mask images
     std::vector< cv::Mat > holesMasksImageVector_10;
@@ -1103,14 +1107,14 @@ namespace hole_fusion
       &inflatedRectanglesIndices_10 );
 
     // The intermediate points vector of sets
-    std::vector< std::set< unsigned int > > intermediatePointsSetVector_10;
+    std::vector< Region > intermediatePointsRegionVector_10;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       depthSquares_,
       inflatedRectanglesVector_10,
       inflatedRectanglesIndices_10,
-      &intermediatePointsSetVector_10 );
+      &intermediatePointsRegionVector_10 );
 
     // The intermediate points vector of images
     std::vector< cv::Mat > intermediatePointsImageVector_10;
@@ -1155,11 +1159,11 @@ namespace hole_fusion
       rgbSquares_,
       histogram,
       cloud,
-      holesMasksSetVector_10,
+      holesMasksRegionVector_10,
       holesMasksImageVector_10,
       inflatedRectanglesVector_10,
       inflatedRectanglesIndices_10,
-      intermediatePointsSetVector_10,
+      intermediatePointsRegionVector_10,
       intermediatePointsImageVector_10,
       &probabilitiesVector2D_10_RGBD_MODE );
 
@@ -1224,7 +1228,7 @@ namespace hole_fusion
       if (f == Parameters::Filters::LuminosityDiff::rgbd_priority - 1)
       {
         // All probabilities amount to zero: the size of each set inside the
-        // intermediatePointsSetVector_0 vector is zero
+        // intermediatePointsRegionVector_0 vector is zero
         EXPECT_EQ ( 0.0, probabilitiesVector2D_10_RGBD_MODE[f][0] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_10_RGBD_MODE[f][1] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_10_RGBD_MODE[f][2] );
@@ -1260,11 +1264,11 @@ namespace hole_fusion
       rgbSquares_,
       histogram,
       cloud,
-      holesMasksSetVector_10,
+      holesMasksRegionVector_10,
       holesMasksImageVector_10,
       inflatedRectanglesVector_10,
       inflatedRectanglesIndices_10,
-      intermediatePointsSetVector_10,
+      intermediatePointsRegionVector_10,
       intermediatePointsImageVector_10,
       &probabilitiesVector2D_10_RGB_ONLY_MODE );
 
@@ -1283,7 +1287,7 @@ namespace hole_fusion
       if (f == Parameters::Filters::LuminosityDiff::rgb_priority - 1)
       {
         // All probabilities amount to zero: the size of each set inside the
-        // intermediatePointsSetVector_0 vector is zero
+        // intermediatePointsRegionVector_0 vector is zero
         EXPECT_EQ ( 0.0, probabilitiesVector2D_10_RGB_ONLY_MODE[f][0] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_10_RGB_ONLY_MODE[f][1] );
         EXPECT_EQ ( 0.0, probabilitiesVector2D_10_RGB_ONLY_MODE[f][2] );
@@ -1292,6 +1296,143 @@ namespace hole_fusion
       }
     }
   }
+
+
+
+  //! Tests that Filters::applyFilters does not alter the validation
+  //! of holes when it stops applying filters to holes that cannot be valid
+  TEST_F ( FiltersTest, applyFiltersShortCircuitTest )
+  {
+    // Create the needed by the Filters::applyFilters method vectors
+    std::vector< Region > holesMasksRegionVector;
+
+    FiltersResources::createHolesMasksRegionVector(
+      conveyor,
+      depthSquares_,
+      &holesMasksRegionVector);
+
+    // The vector of mask images
+    std::vector< cv::Mat > holesMasksImageVector;
+
+    FiltersResources::createHolesMasksImageVector(
+      conveyor,
+      depthSquares_,
+      &holesMasksImageVector );
+
+    std::vector< std::vector< cv::Point2f > > inflatedRectanglesVector;
+    std::vector< int > inflatedRectanglesIndices;
+
+    FiltersResources::createInflatedRectanglesVector(
+      conveyor,
+      depthSquares_,
+      10,
+      &inflatedRectanglesVector,
+      &inflatedRectanglesIndices );
+
+    // The intermediate points vector of sets
+    std::vector< Region > intermediatePointsRegionVector;
+
+    FiltersResources::createIntermediateHolesPointsRegionVector(
+      conveyor,
+      depthSquares_,
+      inflatedRectanglesVector,
+      inflatedRectanglesIndices,
+      &intermediatePointsRegionVector );
+
+    // The intermediate points vector of images
+    std::vector< cv::Mat > intermediatePointsImageVector;
+
+    FiltersResources::createIntermediateHolesPointsImageVector(
+      conveyor,
+      depthSquares_,
+      inflatedRectanglesVector,
+      inflatedRectanglesIndices,
+      &intermediatePointsImageVector );
+
+    // Set the order of the filters' execution in random
+    Parameters::Filters::DepthDiff::priority = 1;
+    Parameters::Filters::ColourHomogeneity::rgbd_priority = 2;
+    Parameters::Filters::RectanglePlaneConstitution::priority = 3;
+    Parameters::Filters::LuminosityDiff::rgbd_priority = 4;
+    Parameters::Filters::DepthArea::priority = 5;
+    Parameters::Filters::DepthHomogeneity::priority = 6;
+    Parameters::Filters::IntermediatePointsPlaneConstitution::priority = 7;
+    Parameters::Filters::TextureDiff::rgbd_priority = 0;
+    Parameters::Filters::TextureBackprojection::rgbd_priority = 0;
+
+    // A dummy histogram
+    std::vector<cv::MatND> histogram;
+
+    int filteringMode = RGBD_MODE;
+
+    for ( int vp = VALIDATION_VIA_THRESHOLDING;
+      vp <= VALIDATION_VIA_THRESHOLDED_WEIGHTING; vp++ )
+    {
+      Parameters::HoleFusion::Validation::validation_process = vp;
+
+      std::map<int, float> valid[2];
+
+      for ( int shortCircuit = 0; shortCircuit < 2; shortCircuit++ )
+      {
+        Parameters::HoleFusion::Validation::short_circuit_filters =
+          shortCircuit;
+
+        Filters::resetStatistics();
+
+        std::vector<std::vector<float> > probabilitiesVector2D(
+          7, std::vector< float >( conveyor.size(), 0.0 ) );
+
+        Filters::applyFilters(
+          conveyor,
+          filteringMode,
+          depthSquares_,
+          rgbSquares_,
+          histogram,
+          cloud,
+          holesMasksRegionVector,
+          holesMasksImageVector,
+          inflatedRectanglesVector,
+          inflatedRectanglesIndices,
+          intermediatePointsRegionVector,
+          intermediatePointsImageVector,
+          &probabilitiesVector2D );
+
+        valid[shortCircuit] =
+          HoleValidation::validateHoles(probabilitiesVector2D, filteringMode);
+
+        // Each active filter has been applied once
+        EXPECT_EQ ( 1, Filters::getStatistics(5).frames );
+        EXPECT_EQ ( 1, Filters::getStatistics(8).frames );
+        EXPECT_EQ ( 0, Filters::getStatistics(3).frames );
+
+        if ( !shortCircuit )
+        {
+          EXPECT_EQ ( conveyor.size(), Filters::getStatistics(8).evaluated );
+          EXPECT_EQ ( 0, Filters::getStatistics(5).rejected );
+        }
+      }
+
+      // The same holes are valid, with the same validity probabilities
+      ASSERT_EQ ( valid[0].size(), valid[1].size() );
+      for ( std::map<int, float>::iterator it = valid[0].begin();
+        it != valid[0].end(); it++ )
+      {
+        ASSERT_EQ ( 1, valid[1].count(it->first) );
+        EXPECT_EQ ( it->second, valid[1][it->first] );
+      }
+
+      // The depth difference filter, applied first, finds no depth
+      // difference for most holes, which cannot pass its threshold
+      if ( vp == VALIDATION_VIA_THRESHOLDING )
+      {
+        EXPECT_LT ( 0, Filters::getStatistics(5).rejected );
+        EXPECT_GT ( conveyor.size(), Filters::getStatistics(8).evaluated );
+      }
+    }
+
+    Parameters::HoleFusion::Validation::short_circuit_filters = true;
+  }
+  }
 }  // namespace hole_fusion
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
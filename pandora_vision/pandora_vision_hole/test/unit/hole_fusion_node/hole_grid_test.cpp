@@ -0,0 +1,159 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include "hole_fusion_node/hole_grid.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  namespace
+  {
+    std::vector<int> sortedQuery(const HoleGrid& grid,
+      const cv::Rect_<float>& box, float margin)
+    {
+      std::vector<int> ids;
+      grid.query(box, margin, &ids);
+      std::sort(ids.begin(), ids.end());
+      return ids;
+    }
+
+    bool near(const cv::Rect_<float>& a, const cv::Rect_<float>& b,
+      float margin)
+    {
+      return a.x <= b.x + b.width + margin && b.x <= a.x + a.width + margin
+        && a.y <= b.y + b.height + margin && b.y <= a.y + a.height + margin;
+    }
+  }  // namespace
+
+
+
+  //! Tests HoleGrid::insert, HoleGrid::remove and HoleGrid::query
+  TEST ( HoleGridTest, queryTest )
+  {
+    HoleGrid grid(10);
+
+    grid.insert(0, cv::Rect_<float>(0, 0, 5, 5));
+    grid.insert(1, cv::Rect_<float>(20, 20, 30, 30));
+    grid.insert(2, cv::Rect_<float>(-15, 100, 0, 0));
+    EXPECT_EQ ( 3, grid.size() );
+
+    // Closed boxes that merely touch do meet
+    std::vector<int> ids = sortedQuery(grid, cv::Rect_<float>(5, 5, 15, 15), 0);
+    ASSERT_EQ ( 2, ids.size() );
+    EXPECT_EQ ( 0, ids[0] );
+    EXPECT_EQ ( 1, ids[1] );
+
+    // A margin reaches over empty cells, to negative coordinates too
+    EXPECT_TRUE ( sortedQuery(grid, cv::Rect_<float>(-5, 90, 1, 1), 0).empty() );
+    ids = sortedQuery(grid, cv::Rect_<float>(-5, 90, 1, 1), 10);
+    ASSERT_EQ ( 1, ids.size() );
+    EXPECT_EQ ( 2, ids[0] );
+
+    // Moving and removing holes
+    grid.insert(0, cv::Rect_<float>(200, 200, 5, 5));
+    EXPECT_EQ ( 3, grid.size() );
+    ids = sortedQuery(grid, cv::Rect_<float>(5, 5, 15, 15), 0);
+    ASSERT_EQ ( 1, ids.size() );
+    EXPECT_EQ ( 1, ids[0] );
+
+    grid.remove(1);
+    grid.remove(1);
+    EXPECT_EQ ( 2, grid.size() );
+    EXPECT_TRUE ( sortedQuery(grid, cv::Rect_<float>(5, 5, 15, 15), 0).empty() );
+
+    // A box spanning more cells than are kept per box is still found
+    grid.insert(3, cv::Rect_<float>(-1e6, -1e6, 2e6, 2e6));
+    ids = sortedQuery(grid, cv::Rect_<float>(200, 200, 1, 1), 0);
+    ASSERT_EQ ( 2, ids.size() );
+    EXPECT_EQ ( 0, ids[0] );
+    EXPECT_EQ ( 3, ids[1] );
+
+    grid.clear();
+    EXPECT_EQ ( 0, grid.size() );
+    EXPECT_TRUE ( sortedQuery(grid, cv::Rect_<float>(200, 200, 1, 1), 0).empty() );
+  }
+
+
+
+  //! Compares HoleGrid::query with testing every box
+  TEST ( HoleGridTest, bruteForceTest )
+  {
+    srand(5);
+
+    HoleGrid grid(16);
+    std::vector<cv::Rect_<float> > boxes;
+
+    for ( int i = 0; i < 500; i++ )
+    {
+      boxes.push_back(cv::Rect_<float>(
+          rand() % 640, rand() % 480, rand() % 60, rand() % 60));
+      grid.insert(i, boxes[i]);
+    }
+
+    // Remove every third box
+    for ( int i = 0; i < 500; i += 3 )
+    {
+      grid.remove(i);
+    }
+
+    for ( int q = 0; q < 200; q++ )
+    {
+      cv::Rect_<float> box(rand() % 640, rand() % 480, rand() % 100, rand() % 100);
+      float margin = rand() % 20;
+
+      std::vector<int> expected;
+      for ( int i = 0; i < 500; i++ )
+      {
+        if ( i % 3 != 0 && near(boxes[i], box, margin) )
+        {
+          expected.push_back(i);
+        }
+      }
+
+      EXPECT_EQ ( expected, sortedQuery(grid, box, margin) );
+    }
+  }
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -35,6 +35,7 @@
  * Author: Alexandros Philotheou
  *********************************************************************/
 
+#include <iostream>
 #include "hole_fusion_node/hole_merger.h"
 #include "gtest/gtest.h"
 
@@ -795,18 +796,18 @@ namespace hole_fusion
     // Construct the hole mask sets for all the holes
     // Here, the main square will be the assimilator, amalgamator and connector
 
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
-    FiltersResources::createHolesMasksSetVector(
+    std::vector< Region > holesMasksRegionVector;
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     for ( int i = 1; i < conveyor.size(); i++ )
     {
       // Run HoleMerger::isCapableOfAssimilating
       bool result = HoleMerger::isCapableOfAssimilating(
-        holesMasksSetVector[0],
-        holesMasksSetVector[i] );
+        holesMasksRegionVector[0],
+        holesMasksRegionVector[i] );
 
       // The main square should be able to assimilate only the assimilable
       if ( i == 1 )
@@ -828,18 +829,18 @@ namespace hole_fusion
     // Construct the hole mask sets for all the holes
     // Here, the main square will be the assimilator, amalgamator and connector
 
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
-    FiltersResources::createHolesMasksSetVector(
+    std::vector< Region > holesMasksRegionVector;
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     for ( int i = 1; i < conveyor.size(); i++ )
     {
       // Run HoleMerger::isCapableOfAmalgamating
       bool result = HoleMerger::isCapableOfAmalgamating (
-        holesMasksSetVector[0],
-        holesMasksSetVector[i] );
+        holesMasksRegionVector[0],
+        holesMasksRegionVector[i] );
 
       // The main square should be able to amalgamate only the amalgamatable
       if ( i == 2 )
@@ -861,19 +862,19 @@ namespace hole_fusion
     // Construct the hole mask sets for all the holes
     // Here, the main square will be the assimilator, amalgamator and connector
 
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
-    FiltersResources::createHolesMasksSetVector(
+    std::vector< Region > holesMasksRegionVector;
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     // Keep a backup of the original amalgamator
     HolesConveyor amalgamator = HolesConveyorUtils::getHole( conveyor, 0 );
 
     HoleMerger::amalgamateOnce(&conveyor,
       0,
-      &holesMasksSetVector[0],
-      holesMasksSetVector[2],
+      &holesMasksRegionVector[0],
+      holesMasksRegionVector[2],
       squares_ );
 
     // The amalgamator should have grown in terms of outline points
@@ -896,11 +897,11 @@ namespace hole_fusion
     // Construct the hole mask sets for all the holes
     // Here, the main square will be the assimilator, amalgamator and connector
 
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
-    FiltersResources::createHolesMasksSetVector(
+    std::vector< Region > holesMasksRegionVector;
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     // Modify the connection parameters
     Parameters::HoleFusion::Merger::connect_holes_min_distance = 3;
@@ -913,8 +914,8 @@ namespace hole_fusion
         conveyor,
         0,
         i,
-        holesMasksSetVector[0],
-        holesMasksSetVector[i],
+        holesMasksRegionVector[0],
+        holesMasksRegionVector[i],
         cloud );
 
       // The main square should be able to amalgamate only the amalgamatable
@@ -941,8 +942,8 @@ namespace hole_fusion
         conveyor,
         0,
         i,
-        holesMasksSetVector[0],
-        holesMasksSetVector[i],
+        holesMasksRegionVector[0],
+        holesMasksRegionVector[i],
         cloud );
 
       // The main square should be able to connect only with the connectable
@@ -969,8 +970,8 @@ namespace hole_fusion
         conveyor,
         0,
         i,
-        holesMasksSetVector[0],
-        holesMasksSetVector[i],
+        holesMasksRegionVector[0],
+        holesMasksRegionVector[i],
         cloud );
 
       // The connectable should not be able to be connected with the
@@ -991,11 +992,11 @@ namespace hole_fusion
     // Construct the hole mask sets for all the holes
     // Here, the main square will be the assimilator, amalgamator and connector
 
-    std::vector< std::set< unsigned int > > holesMasksSetVector;
-    FiltersResources::createHolesMasksSetVector(
+    std::vector< Region > holesMasksRegionVector;
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector );
+      &holesMasksRegionVector );
 
     // Keep a backup of the original amalgamator
     HolesConveyor connector = HolesConveyorUtils::getHole( conveyor, 0 );
@@ -1005,7 +1006,7 @@ namespace hole_fusion
       &conveyor,
       0,
       3,
-      &holesMasksSetVector[0],
+      &holesMasksRegionVector[0],
       squares_ );
 
     // The connector should have grown in terms of outline points
@@ -1067,6 +1068,73 @@ namespace hole_fusion
     EXPECT_EQ ( 3, conveyor.size() );
   }
 
+
+
+  //! Merges hundreds of holes, most of which are far from each other
+  TEST_F ( HoleMergerTest, manyHolesTest )
+  {
+    // Hosts of 12 x 12 pixels every 24 pixels. Every fourth host has a
+    // hole inside it, to be assimilated, and every fourth, starting from the
+    // second, has a hole on its right edge, to be amalgamated
+    for ( int numHosts = 100; numHosts <= 400; numHosts *= 2 )
+    {
+      HolesConveyor holes;
+      HolesConveyor expected;
+
+      for ( int h = 0; h < numHosts; h++ )
+      {
+        cv::Point2f upperLeft( 24 * ( h % 26 ), 24 * ( h / 26 ) );
+
+        HolesConveyorUtils::append(
+          getConveyor( upperLeft, 12, 12 ), &holes );
+        HolesConveyorUtils::append(
+          getConveyor( upperLeft, 12, 12 ), &expected );
+
+        if ( h % 4 == 0 )
+        {
+          HolesConveyorUtils::append(
+            getConveyor( upperLeft + cv::Point2f( 4, 4 ), 4, 4 ), &holes );
+        }
+        else if ( h % 4 == 1 )
+        {
+          HolesConveyorUtils::append(
+            getConveyor( upperLeft + cv::Point2f( 9, 3 ), 6, 6 ), &holes );
+          HolesConveyorUtils::append(
+            getConveyor( upperLeft + cv::Point2f( 9, 3 ), 6, 6 ), &expected );
+        }
+      }
+
+      int numHoles = holes.size();
+
+      ros::WallTime begin = ros::WallTime::now();
+      HoleMerger::applyMergeOperationWithoutValidation(
+        &holes, squares_, ASSIMILATION );
+      double assimilationTime = (ros::WallTime::now() - begin).toSec() * 1000;
+
+      // Only the holes inside the hosts are gone, the rest keep their order
+      ASSERT_EQ ( expected.size(), holes.size() );
+      for ( int i = 0; i < holes.size(); i++ )
+      {
+        EXPECT_EQ ( expected.holes[i].keypoint.pt.x,
+          holes.holes[i].keypoint.pt.x );
+        EXPECT_EQ ( expected.holes[i].keypoint.pt.y,
+          holes.holes[i].keypoint.pt.y );
+      }
+
+      begin = ros::WallTime::now();
+      HoleMerger::applyMergeOperationWithoutValidation(
+        &holes, squares_, AMALGAMATION );
+      double amalgamationTime = (ros::WallTime::now() - begin).toSec() * 1000;
+
+      // Each host has absorbed the hole on its edge
+      EXPECT_EQ ( numHosts, holes.size() );
+
+      std::cout << "[ BENCHMARK ] " << numHoles << " holes: assimilation "
+        << assimilationTime << " ms, amalgamation "
+        << amalgamationTime << " ms" << std::endl;
+    }
+  }
+
 }  // namespace hole_fusion
 }  // namespace pandora_vision_hole
 }  // namespace pandora_vision
@@ -1136,6 +1136,98 @@ namespace hole_fusion
     ASSERT_EQ ( 1.0, v_it->second);
   }
 
+
+
+  //! Tests HoleValidation::isRejected
+  TEST_F ( HoleValidationTest, isRejectedTest )
+  {
+    Parameters::Filters::ColourHomogeneity::rgb_priority = 1;
+    Parameters::Filters::LuminosityDiff::rgb_priority = 2;
+    Parameters::Filters::TextureBackprojection::rgb_priority = 3;
+    Parameters::Filters::TextureDiff::rgb_priority = 4;
+
+    Parameters::Filters::ColourHomogeneity::rgb_threshold = 0.7;
+    Parameters::Filters::LuminosityDiff::rgb_threshold = 0.7;
+    Parameters::Filters::TextureBackprojection::rgb_threshold = 0.7;
+    Parameters::Filters::TextureDiff::rgb_threshold = 0.7;
+
+    Parameters::HoleFusion::Validation::rgb_validity_threshold = 0.6;
+
+    // The filters' identifiers, in order of priority
+    std::vector< int > filters;
+    filters.push_back( 1 );
+    filters.push_back( 2 );
+    filters.push_back( 4 );
+    filters.push_back( 3 );
+
+    // Three holes: one that no filter favours, one that all filters
+    // favour and one that only the first filter favours
+    std::vector< std::vector< float > > probabilities(
+      4, std::vector< float >( 3, 0.0 ) );
+    for ( int f = 0; f < 4; f++ )
+    {
+      probabilities[f][1] = 1.0;
+    }
+    probabilities[0][2] = 0.9;
+
+    // Via thresholding, a hole is rejected by the first filter it fails
+    Parameters::HoleFusion::Validation::validation_process =
+      VALIDATION_VIA_THRESHOLDING;
+
+    EXPECT_FALSE ( HoleValidation::isRejected(
+        probabilities, filters, 0, 0, RGB_ONLY_MODE ) );
+    EXPECT_TRUE ( HoleValidation::isRejected(
+        probabilities, filters, 1, 0, RGB_ONLY_MODE ) );
+    EXPECT_FALSE ( HoleValidation::isRejected(
+        probabilities, filters, 1, 2, RGB_ONLY_MODE ) );
+    EXPECT_TRUE ( HoleValidation::isRejected(
+        probabilities, filters, 2, 2, RGB_ONLY_MODE ) );
+
+    // Via weighting, a hole is rejected when even probabilities of 1 from
+    // the rest of the filters cannot lift it over the validity threshold:
+    // (4 + 8) / 15 > 0.6 > 8 / 15
+    Parameters::HoleFusion::Validation::validation_process =
+      VALIDATION_VIA_WEIGHTING;
+
+    EXPECT_FALSE ( HoleValidation::isRejected(
+        probabilities, filters, 2, 0, RGB_ONLY_MODE ) );
+    EXPECT_TRUE ( HoleValidation::isRejected(
+        probabilities, filters, 3, 0, RGB_ONLY_MODE ) );
+
+    // Whatever the validation process and the number of filters applied,
+    // a rejected hole is not valid, even if the filters that follow give
+    // it their highest probability
+    for ( int vp = 0; vp < 3; vp++ )
+    {
+      Parameters::HoleFusion::Validation::validation_process = vp;
+
+      for ( int applied = 0; applied <= 4; applied++ )
+      {
+        std::vector< std::vector< float > > best = probabilities;
+        for ( int f = applied; f < 4; f++ )
+        {
+          best[f].assign( 3, 1.0 );
+        }
+
+        std::map< int, float > validityMap =
+          HoleValidation::validateHoles( best, RGB_ONLY_MODE );
+
+        for ( int hole = 0; hole < 3; hole++ )
+        {
+          if ( HoleValidation::isRejected(
+              probabilities, filters, applied, hole, RGB_ONLY_MODE ) )
+          {
+            EXPECT_EQ ( 0, validityMap.count( hole ) );
+          }
+        }
+
+        // The hole that all filters favour is never rejected
+        EXPECT_FALSE ( HoleValidation::isRejected(
+            probabilities, filters, applied, 1, RGB_ONLY_MODE ) );
+      }
+    }
+  }
+
 }  // namespace hole_fusion
 }  // namespace pandora_vision_hole
 }  // namespace pandora_vision
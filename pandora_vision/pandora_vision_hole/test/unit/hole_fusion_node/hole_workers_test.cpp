@@ -0,0 +1,139 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include "hole_fusion_node/hole_workers.h"
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  /**
+    @brief Counts the times a task of an index is run
+   **/
+  void count(std::vector<int>* runs, int index)
+  {
+    (*runs)[index]++;
+  }
+
+  /**
+    @brief Writes the index of an entry as its message
+   **/
+  void describe(int entry, std::string* msg)
+  {
+    *msg = entry == 2 ? "" : std::string(1, 'a' + entry);
+  }
+
+
+
+  //! Tests HoleWorkers::run
+  TEST ( HoleWorkersTest, runTest )
+  {
+    HoleWorkers workers(3);
+
+    EXPECT_EQ ( 4, workers.size() );
+
+    // Every index is run exactly once, batch after batch
+    for ( int batch = 0; batch < 100; batch++ )
+    {
+      std::vector<int> runs(batch, 0);
+
+      workers.run(batch, boost::bind(&count, &runs, _1));
+
+      for ( int i = 0; i < batch; i++ )
+      {
+        ASSERT_EQ ( 1, runs[i] );
+      }
+    }
+
+    // A pool without threads runs everything on the caller's thread
+    HoleWorkers serial(0);
+
+    std::vector<int> runs(10, 0);
+    serial.run(10, boost::bind(&count, &runs, _1));
+
+    for ( int i = 0; i < 10; i++ )
+    {
+      EXPECT_EQ ( 1, runs[i] );
+    }
+  }
+
+
+
+  //! Tests HoleWorkers::runEntries
+  TEST ( HoleWorkersTest, runEntriesTest )
+  {
+    HoleWorkers workers(3);
+
+    // Entry i refers to hole holes[i]
+    std::vector<int> holes;
+    holes.push_back(4);
+    holes.push_back(0);
+    holes.push_back(3);
+    holes.push_back(1);
+
+    std::vector<bool> pending(5, true);
+    pending[0] = false;
+
+    std::vector<std::string> msgs;
+    workers.runEntries(holes.size(), &holes, &pending, &describe, &msgs);
+
+    // Entries are reported in order, the skipped one with a "-" and the
+    // one with an empty message not at all
+    ASSERT_EQ ( 3, msgs.size() );
+    EXPECT_EQ ( "a", msgs[0] );
+    EXPECT_EQ ( "-", msgs[1] );
+    EXPECT_EQ ( "d", msgs[2] );
+
+    // Without a mapping entries are holes, and without a pending vector
+    // all of them are run
+    msgs.clear();
+    workers.runEntries(2, NULL, NULL, &describe, &msgs);
+
+    ASSERT_EQ ( 2, msgs.size() );
+    EXPECT_EQ ( "a", msgs[0] );
+    EXPECT_EQ ( "b", msgs[1] );
+  }
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
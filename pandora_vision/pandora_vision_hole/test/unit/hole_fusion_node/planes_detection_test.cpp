@@ -175,6 +175,92 @@ namespace hole_fusion
     EXPECT_EQ ( WIDTH * HEIGHT / 4, inliersVector[1]->indices.size() );
   }
 
+
+
+  /**
+    @brief An organized point cloud, as seen by a depth sensor, of two walls
+    parallel to the image plane: one at a depth of 1.0 for the left quarter
+    of the image and one at a depth of 2.0 for the rest of it
+   **/
+  PointCloudPtr twoWalls ( int width, int height )
+  {
+    PointCloudPtr walls ( new PointCloud );
+    walls->width = width;
+    walls->height = height;
+    walls->resize ( width * height );
+
+    for ( int rows = 0; rows < height; rows++ )
+    {
+      for ( int cols = 0; cols < width; cols++ )
+      {
+        PointCloud::PointType& point = walls->at ( cols, rows );
+
+        point.z = cols < width / 4 ? 1.0 : 2.0;
+        point.x = ( cols - width / 2 ) * 0.002 * point.z;
+        point.y = ( rows - height / 2 ) * 0.002 * point.z;
+      }
+    }
+
+    return walls;
+  }
+
+
+
+  //! Tests PlanesDetection::segmentOrganizedPlanes
+  TEST_F ( PlanesDetectionTest, segmentOrganizedPlanesTest )
+  {
+    PointCloudPtr walls = twoWalls ( WIDTH, HEIGHT );
+
+    PlanesDetection::PlaneLabelsConstPtr planes =
+      PlanesDetection::segmentOrganizedPlanes ( walls );
+
+    // There should be two planes detected
+    ASSERT_EQ ( 2, planes->planes );
+    ASSERT_EQ ( HEIGHT, planes->labels.rows );
+    ASSERT_EQ ( WIDTH, planes->labels.cols );
+
+    // Points well inside each wall lie on that wall's plane
+    int nearWall = planes->labels.at<int>( HEIGHT / 2, WIDTH / 8 );
+    int farWall = planes->labels.at<int>( HEIGHT / 2, WIDTH / 2 );
+
+    EXPECT_NE ( 0, nearWall );
+    EXPECT_NE ( 0, farWall );
+    EXPECT_NE ( nearWall, farWall );
+
+    EXPECT_EQ ( nearWall, planes->labels.at<int>( 20, 20 ) );
+    EXPECT_EQ ( farWall, planes->labels.at<int>( HEIGHT - 20, WIDTH - 20 ) );
+
+    // A cloud that is not organized has no planes
+    PointCloudPtr unorganized ( new PointCloud ( *walls ) );
+    unorganized->width = WIDTH * HEIGHT;
+    unorganized->height = 1;
+
+    EXPECT_EQ ( 0,
+      PlanesDetection::segmentOrganizedPlanes ( unorganized )->planes );
+  }
+
+
+
+  //! Tests PlanesDetection::setFramePlanes and
+  //! PlanesDetection::getFramePlanes
+  TEST_F ( PlanesDetectionTest, framePlanesTest )
+  {
+    PointCloudPtr walls = twoWalls ( WIDTH, HEIGHT );
+    PointCloudPtr otherWalls = twoWalls ( WIDTH, HEIGHT );
+
+    PlanesDetection::setFramePlanes ( walls );
+
+    ASSERT_TRUE ( PlanesDetection::getFramePlanes ( walls ) );
+    EXPECT_EQ ( 2, PlanesDetection::getFramePlanes ( walls )->planes );
+
+    // The planes are those of the frame's point cloud only
+    EXPECT_FALSE ( PlanesDetection::getFramePlanes ( otherWalls ) );
+
+    PlanesDetection::clearFramePlanes();
+
+    EXPECT_FALSE ( PlanesDetection::getFramePlanes ( walls ) );
+  }
+
 }  // namespace hole_fusion
 }  // namespace pandora_vision_hole
 }  // namespace pandora_vision
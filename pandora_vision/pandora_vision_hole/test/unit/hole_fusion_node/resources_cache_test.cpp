@@ -0,0 +1,144 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include "hole_fusion_node/resources_cache.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace hole_fusion
+{
+  /**
+    @brief A square hole of side 2 * radius around a point
+   **/
+  HoleConveyor square(float x, float y, float radius)
+  {
+    HoleConveyor hole;
+    hole.keypoint.pt = cv::Point2f(x, y);
+
+    hole.rectangle.push_back(cv::Point2f(x - radius, y - radius));
+    hole.rectangle.push_back(cv::Point2f(x + radius, y - radius));
+    hole.rectangle.push_back(cv::Point2f(x + radius, y + radius));
+    hole.rectangle.push_back(cv::Point2f(x - radius, y + radius));
+
+    hole.outline = hole.rectangle;
+
+    return hole;
+  }
+
+
+
+  //! Tests ResourcesCache::lookup
+  TEST ( ResourcesCacheTest, lookupTest )
+  {
+    ResourcesCache cache(4);
+    cv::Size size(640, 480);
+
+    ResourcesCache::Entry* entry = cache.lookup(square(100, 100, 10), size);
+    ASSERT_TRUE ( entry != NULL );
+    EXPECT_FALSE ( entry->hasMask );
+    entry->hasMask = true;
+
+    // The same hole in the next frame
+    entry = cache.lookup(square(100, 100, 10), size);
+    EXPECT_TRUE ( entry->hasMask );
+
+    // The floodfill seed is the same pixel
+    HoleConveyor shifted = square(100, 100, 10);
+    shifted.keypoint.pt.x += 0.2;
+    EXPECT_TRUE ( cache.lookup(shifted, size)->hasMask );
+
+    // A different outline, rectangle or image size is a different hole
+    HoleConveyor moved = square(100, 100, 10);
+    moved.outline[0].x += 1;
+    EXPECT_FALSE ( cache.lookup(moved, size)->hasMask );
+    moved = square(100, 100, 10);
+    moved.rectangle[2].y -= 1;
+    EXPECT_FALSE ( cache.lookup(moved, size)->hasMask );
+    EXPECT_FALSE ( cache.lookup(square(100, 100, 10),
+        cv::Size(320, 240))->hasMask );
+
+    EXPECT_EQ ( 2, cache.getStatistics().hits );
+    EXPECT_EQ ( 4, cache.getStatistics().misses );
+    EXPECT_FLOAT_EQ ( 2.0 / 6, cache.getStatistics().hitRate() );
+  }
+
+
+
+  //! Tests the least recently used eviction of ResourcesCache
+  TEST ( ResourcesCacheTest, evictionTest )
+  {
+    ResourcesCache cache(3);
+    cv::Size size(640, 480);
+
+    for ( int i = 0; i < 3; i++ )
+    {
+      cache.lookup(square(50 + 50 * i, 100, 10), size)->hasMask = true;
+    }
+
+    // Using the first hole makes the second the least recently used
+    EXPECT_TRUE ( cache.lookup(square(50, 100, 10), size)->hasMask );
+
+    cache.lookup(square(300, 100, 10), size)->hasMask = true;
+    EXPECT_EQ ( 3, cache.size() );
+    EXPECT_EQ ( 1, cache.getStatistics().evictions );
+
+    EXPECT_TRUE ( cache.lookup(square(50, 100, 10), size)->hasMask );
+    EXPECT_TRUE ( cache.lookup(square(150, 100, 10), size)->hasMask );
+    EXPECT_FALSE ( cache.lookup(square(100, 100, 10), size)->hasMask );
+
+    // Shrinking keeps the most recently used holes
+    cache.setCapacity(1);
+    EXPECT_EQ ( 1, cache.size() );
+    EXPECT_FALSE ( cache.lookup(square(150, 100, 10), size)->hasMask );
+
+    // A zero capacity disables the cache
+    cache.setCapacity(0);
+    EXPECT_EQ ( 0, cache.size() );
+    EXPECT_TRUE ( cache.lookup(square(50, 100, 10), size) == NULL );
+
+    cache.setCapacity(2);
+    cache.lookup(square(50, 100, 10), size);
+    cache.clear();
+    EXPECT_EQ ( 0, cache.size() );
+  }
+
+}  // namespace hole_fusion
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -401,12 +401,12 @@ namespace hole_fusion
     // Generate the needed resources for an inflation size of value 0
 
     // The vector of set masks
-    std::vector< std::set< unsigned int > > holesMasksSetVector_0;
+    std::vector< Region > holesMasksRegionVector_0;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector_0 );
+      &holesMasksRegionVector_0 );
 
     // The vectors of inflated rectangles and in-bounds inflated rectangles'
     // indices
@@ -421,14 +421,14 @@ namespace hole_fusion
       &rectanglesIndices_0 );
 
     // The intermediate points vector of sets
-    std::vector<std::set<unsigned int> > intermediatePointsSetVector_0;
+    std::vector<Region> intermediatePointsRegionVector_0;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       rectanglesVector_0,
       rectanglesIndices_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // The vector of probabilities returned
     std::vector< float > probabilitiesVector_0( conveyor.size(), 0.0 );
@@ -437,14 +437,14 @@ namespace hole_fusion
     // Run RgbFilters::checkHolesLuminosityDiff
     RgbFilters::checkHolesLuminosityDiff(
       squares_,
-      holesMasksSetVector_0,
-      intermediatePointsSetVector_0,
+      holesMasksRegionVector_0,
+      intermediatePointsRegionVector_0,
       rectanglesIndices_0,
       &probabilitiesVector_0,
       &msgs);
 
     // All probabilities amount to zero: the size of each set inside the
-    // intermediatePointsSetVector_0 vector is zero
+    // intermediatePointsRegionVector_0 vector is zero
     for ( int i = 0; i < probabilitiesVector_0.size(); i++ )
     {
       EXPECT_EQ ( 0.0, probabilitiesVector_0[i] );
@@ -454,12 +454,12 @@ namespace hole_fusion
     // Generate the needed resources for an inflation size of value 10
 
     // The vector of set masks
-    std::vector< std::set< unsigned int > > holesMasksSetVector_10;
+    std::vector< Region > holesMasksRegionVector_10;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector_10 );
+      &holesMasksRegionVector_10 );
 
     // The vectors of inflated rectangles and in-bounds inflated rectangles'
     // indices
@@ -474,14 +474,14 @@ namespace hole_fusion
       &rectanglesIndices_10 );
 
     // The intermediate points vector of sets
-    std::vector< std::set< unsigned int> > intermediatePointsSetVector_10;
+    std::vector< Region > intermediatePointsRegionVector_10;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       rectanglesVector_10,
       rectanglesIndices_10,
-      &intermediatePointsSetVector_10 );
+      &intermediatePointsRegionVector_10 );
 
     // The vector of probabilities returned
     std::vector< float > probabilitiesVector_10( conveyor.size(), 0.0 );
@@ -490,8 +490,8 @@ namespace hole_fusion
     // Run RgbFilters::checkHolesLuminosityDiff
     RgbFilters::checkHolesLuminosityDiff(
       squares_,
-      holesMasksSetVector_10,
-      intermediatePointsSetVector_10,
+      holesMasksRegionVector_10,
+      intermediatePointsRegionVector_10,
       rectanglesIndices_10,
       &probabilitiesVector_10,
       &msgs);
@@ -515,12 +515,12 @@ namespace hole_fusion
     // Generate the needed resources for an inflation size of value 0
 
     // The vector of set masks
-    std::vector< std::set< unsigned int > > holesMasksSetVector_0;
+    std::vector< Region > holesMasksRegionVector_0;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector_0 );
+      &holesMasksRegionVector_0 );
 
     // The vectors of inflated rectangles and in-bounds inflated rectangles'
     // indices
@@ -535,14 +535,14 @@ namespace hole_fusion
       &rectanglesIndices_0 );
 
     // The intermediate points vector of sets
-    std::vector<std::set<unsigned int> > intermediatePointsSetVector_0;
+    std::vector<Region> intermediatePointsRegionVector_0;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       rectanglesVector_0,
       rectanglesIndices_0,
-      &intermediatePointsSetVector_0 );
+      &intermediatePointsRegionVector_0 );
 
     // The vector of probabilities returned
     std::vector< float > probabilitiesVector_0( conveyor.size(), 0.0 );
@@ -557,14 +557,14 @@ namespace hole_fusion
     RgbFilters::checkHolesTextureBackProject(
       squares_,
       histogram,
-      holesMasksSetVector_0,
-      intermediatePointsSetVector_0,
+      holesMasksRegionVector_0,
+      intermediatePointsRegionVector_0,
       rectanglesIndices_0,
       &probabilitiesVector_0,
       &msgs);
 
     // All probabilities amount to zero: the size of each set inside the
-    // intermediatePointsSetVector_0 vector is zero
+    // intermediatePointsRegionVector_0 vector is zero
     for ( int i = 0; i < probabilitiesVector_0.size(); i++ )
     {
       EXPECT_EQ ( 0.0, probabilitiesVector_0[i] );
@@ -574,12 +574,12 @@ namespace hole_fusion
     // Generate the needed resources for an inflation size of value 10
 
     // The vector of set masks
-    std::vector< std::set< unsigned int > > holesMasksSetVector_10;
+    std::vector< Region > holesMasksRegionVector_10;
 
-    FiltersResources::createHolesMasksSetVector(
+    FiltersResources::createHolesMasksRegionVector(
       conveyor,
       squares_,
-      &holesMasksSetVector_10 );
+      &holesMasksRegionVector_10 );
 
     // The vectors of inflated rectangles and in-bounds inflated rectangles'
     // indices
@@ -594,14 +594,14 @@ namespace hole_fusion
       &rectanglesIndices_10 );
 
     // The intermediate points vector of sets
-    std::vector< std::set< unsigned int> > intermediatePointsSetVector_10;
+    std::vector< Region > intermediatePointsRegionVector_10;
 
-    FiltersResources::createIntermediateHolesPointsSetVector(
+    FiltersResources::createIntermediateHolesPointsRegionVector(
       conveyor,
       squares_,
       rectanglesVector_10,
       rectanglesIndices_10,
-      &intermediatePointsSetVector_10 );
+      &intermediatePointsRegionVector_10 );
 
     // The vector of probabilities returned
     std::vector< float > probabilitiesVector_10( conveyor.size(), 0.0 );
@@ -611,8 +611,8 @@ namespace hole_fusion
     RgbFilters::checkHolesTextureBackProject(
       squares_,
       histogram,
-      holesMasksSetVector_10,
-      intermediatePointsSetVector_10,
+      holesMasksRegionVector_10,
+      intermediatePointsRegionVector_10,
       rectanglesIndices_10,
       &probabilitiesVector_10,
       &msgs);
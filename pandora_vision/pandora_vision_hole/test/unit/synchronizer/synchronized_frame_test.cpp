@@ -0,0 +1,155 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2014, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Author: Alexandros Philotheou
+ *********************************************************************/
+
+#include <vector>
+#include <boost/shared_array.hpp>
+#include <ros/serialization.h>
+
+#include "synchronizer/synchronized_frame.h"
+#include "gtest/gtest.h"
+
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  typedef pcl::PointCloud<pcl::PointXYZRGB> Cloud;
+  typedef ::pandora_vision_hole::SynchronizedFrameMsg FrameMsg;
+
+  /**
+    @brief A frame of a small organized point cloud and its two images
+   **/
+  SynchronizedFramePtr smallFrame()
+  {
+    SynchronizedFramePtr frame(new SynchronizedFrame);
+    frame->header.frame_id = "/kinect_frame";
+    frame->header.stamp = ros::Time(12, 34);
+
+    boost::shared_ptr<Cloud> cloud(new Cloud);
+    cloud->header.frame_id = "/kinect_frame";
+    cloud->height = 3;
+    cloud->width = 4;
+    cloud->resize(12);
+    for (unsigned int i = 0; i < cloud->size(); i++)
+    {
+      cloud->points[i].x = i;
+      cloud->points[i].y = 2.0 * i;
+      cloud->points[i].z = 0.5 + i;
+      cloud->points[i].r = i;
+    }
+    frame->pointCloud = cloud;
+
+    frame->rgbImage.height = 3;
+    frame->rgbImage.width = 4;
+    frame->rgbImage.encoding = "bgr8";
+    frame->rgbImage.step = 12;
+    frame->rgbImage.data.assign(36, 7);
+
+    frame->depthImage.height = 3;
+    frame->depthImage.width = 4;
+    frame->depthImage.encoding = "32FC1";
+    frame->depthImage.step = 16;
+    frame->depthImage.data.assign(48, 3);
+
+    frame->isDepth = true;
+    return frame;
+  }
+
+  //! A frame travels between processes as a SynchronizedFrameMsg
+  TEST(SynchronizedFrameTest, serializesAsSynchronizedFrameMsg)
+  {
+    SynchronizedFramePtr frame = smallFrame();
+
+    EXPECT_STREQ(ros::message_traits::md5sum<FrameMsg>(),
+      ros::message_traits::md5sum<SynchronizedFrame>());
+    EXPECT_STREQ(ros::message_traits::datatype<FrameMsg>(),
+      ros::message_traits::datatype<SynchronizedFrame>());
+
+    uint32_t length = ros::serialization::serializationLength(*frame);
+    boost::shared_array<uint8_t> buffer(new uint8_t[length]);
+    ros::serialization::OStream out(buffer.get(), length);
+    ros::serialization::serialize(out, *frame);
+    EXPECT_EQ(0u, out.getLength());
+
+    // The message generated from the .msg reads it
+    FrameMsg msg;
+    ros::serialization::IStream in(buffer.get(), length);
+    ros::serialization::deserialize(in, msg);
+
+    EXPECT_EQ(frame->header.stamp, msg.header.stamp);
+    EXPECT_EQ(3u, msg.pointCloud.height);
+    EXPECT_EQ(4u, msg.pointCloud.width);
+    EXPECT_EQ(frame->rgbImage.data, msg.rgbImage.data);
+    EXPECT_EQ(frame->depthImage.data, msg.depthImage.data);
+    EXPECT_TRUE(msg.isDepth);
+
+    // And so does the frame, converting the point cloud back to pcl
+    SynchronizedFrame copy;
+    ros::serialization::IStream again(buffer.get(), length);
+    ros::serialization::deserialize(again, copy);
+
+    ASSERT_TRUE(copy.pointCloud);
+    ASSERT_EQ(frame->pointCloud->size(), copy.pointCloud->size());
+    EXPECT_EQ(3u, copy.pointCloud->height);
+    for (unsigned int i = 0; i < copy.pointCloud->size(); i++)
+    {
+      EXPECT_EQ(frame->pointCloud->points[i].z, copy.pointCloud->points[i].z);
+      EXPECT_EQ(frame->pointCloud->points[i].r, copy.pointCloud->points[i].r);
+    }
+    EXPECT_EQ(frame->depthImage.data, copy.depthImage.data);
+    EXPECT_TRUE(copy.isDepth);
+  }
+
+  //! A frame without a point cloud still serializes, with an empty one
+  TEST(SynchronizedFrameTest, serializesWithoutPointCloud)
+  {
+    SynchronizedFrame frame;
+
+    uint32_t length = ros::serialization::serializationLength(frame);
+    boost::shared_array<uint8_t> buffer(new uint8_t[length]);
+    ros::serialization::OStream out(buffer.get(), length);
+    ros::serialization::serialize(out, frame);
+
+    FrameMsg msg;
+    ros::serialization::IStream in(buffer.get(), length);
+    ros::serialization::deserialize(in, msg);
+    EXPECT_TRUE(msg.pointCloud.data.empty());
+    EXPECT_FALSE(msg.isDepth);
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
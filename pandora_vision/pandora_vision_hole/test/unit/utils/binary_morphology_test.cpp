@@ -0,0 +1,348 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <iostream>
+#include <set>
+#include <vector>
+#include <ros/ros.h>
+#include "utils/binary_morphology.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace
+{
+  const char kThinningKernels[8][3][3] = {
+    { {0, 0, 0}, {2, 1, 2}, {1, 1, 1} },
+    { {2, 0, 0}, {1, 1, 0}, {2, 1, 2} },
+    { {1, 2, 0}, {1, 1, 0}, {1, 2, 0} },
+    { {2, 1, 2}, {1, 1, 0}, {2, 0, 0} },
+    { {1, 1, 1}, {2, 1, 2}, {0, 0, 0} },
+    { {2, 1, 2}, {0, 1, 1}, {0, 0, 2} },
+    { {0, 2, 1}, {0, 1, 1}, {0, 2, 1} },
+    { {0, 0, 2}, {0, 1, 1}, {2, 1, 2} }
+  };
+
+  const char kPruningKernels[9][3][3] = {
+    { {0, 0, 0}, {0, 1, 0}, {0, 0, 0} },
+    { {1, 2, 0}, {2, 1, 0}, {0, 0, 0} },
+    { {2, 1, 2}, {0, 1, 0}, {0, 0, 0} },
+    { {0, 2, 1}, {0, 1, 2}, {0, 0, 0} },
+    { {2, 0, 0}, {1, 1, 0}, {2, 0, 0} },
+    { {0, 0, 2}, {0, 1, 1}, {0, 0, 2} },
+    { {0, 0, 0}, {2, 1, 0}, {1, 2, 0} },
+    { {0, 0, 0}, {0, 1, 0}, {2, 1, 2} },
+    { {0, 0, 0}, {0, 1, 2}, {0, 2, 1} }
+  };
+
+  /**
+    @brief The per pixel kernel check the operators were built on
+   **/
+  bool kernelCheck(const char kernel[3][3], const cv::Mat& img,
+    int row, int col)
+  {
+    for (int j = -1; j <= 1; j++)
+    {
+      for (int i = -1; i <= 1; i++)
+      {
+        unsigned char pixel = img.at<unsigned char>(row + j, col + i);
+        if ((kernel[j + 1][i + 1] == 0 && pixel != 0) ||
+          (kernel[j + 1][i + 1] == 1 && pixel == 0))
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  bool isEndPoint(const cv::Mat& img, int row, int col)
+  {
+    for (int k = 0; k < 9; k++)
+    {
+      if (kernelCheck(kPruningKernels[k], img, row, col))
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+    @brief Strict pruning as implemented by checking every kernel on the
+    neighbours of each removed pixel
+   **/
+  void referencePruning(cv::Mat* img, int steps)
+  {
+    std::set<int> current, next;
+    for (int row = 1; row < img->rows - 1; row++)
+    {
+      for (int col = 1; col < img->cols - 1; col++)
+      {
+        if (img->at<unsigned char>(row, col) != 0 && isEndPoint(*img, row, col))
+        {
+          current.insert(row * img->cols + col);
+        }
+      }
+    }
+
+    for (int s = 0; s < steps; s++)
+    {
+      bool isRunning = false;
+      next.clear();
+      for (std::set<int>::iterator it = current.begin(); it != current.end(); ++it)
+      {
+        int row = *it / img->cols;
+        int col = *it % img->cols;
+        img->at<unsigned char>(row, col) = 0;
+        for (int j = -1; j <= 1; j++)
+        {
+          for (int i = -1; i <= 1; i++)
+          {
+            if ((i != 0 || j != 0) && img->at<unsigned char>(row + j, col + i) != 0 &&
+              isEndPoint(*img, row + j, col + i))
+            {
+              isRunning = true;
+              next.insert((row + j) * img->cols + col + i);
+            }
+          }
+        }
+      }
+      if (!isRunning)
+      {
+        break;
+      }
+      next.swap(current);
+    }
+  }
+
+  /**
+    @brief Thinning as implemented by Morphology: in each step every kernel
+    removes the first pixel of the interior it matches, in raster order
+   **/
+  void referenceThinning(const cv::Mat& inImage, cv::Mat* outImage, int steps)
+  {
+    inImage.copyTo(*outImage);
+    for (int s = 0; s < steps; s++)
+    {
+      bool isRunning = false;
+      for (int k = 0; k < 8; k++)
+      {
+        bool removed = false;
+        for (int row = 1; row < outImage->rows - 1 && !removed; row++)
+        {
+          for (int col = 1; col < outImage->cols - 1 && !removed; col++)
+          {
+            if (outImage->at<unsigned char>(row, col) != 0 &&
+              kernelCheck(kThinningKernels[k], *outImage, row, col))
+            {
+              outImage->at<unsigned char>(row, col) = 0;
+              removed = true;
+            }
+          }
+        }
+        isRunning = isRunning || removed;
+      }
+      if (!isRunning)
+      {
+        break;
+      }
+    }
+  }
+
+  /**
+    @brief Draws random walks of width 1 to 3 pixels, kept two pixels away
+    from the image's borders, resembling the edges of a depth image
+   **/
+  cv::Mat randomEdges(int rows, int cols, int walks, uint64 seed)
+  {
+    cv::RNG rng(seed);
+    cv::Mat edges = cv::Mat::zeros(rows, cols, CV_8UC1);
+    for (int w = 0; w < walks; w++)
+    {
+      int row = rng.uniform(2, rows - 2);
+      int col = rng.uniform(2, cols - 2);
+      int rowStep = rng.uniform(-1, 2);
+      int colStep = rng.uniform(-1, 2);
+      int width = rng.uniform(1, 4);
+      int length = rng.uniform(10, 120);
+      for (int i = 0; i < length; i++)
+      {
+        for (int t = 0; t < width; t++)
+        {
+          if (row + t >= 2 && row + t < rows - 2 && col >= 2 && col < cols - 2)
+          {
+            edges.at<unsigned char>(row + t, col) = 255;
+          }
+        }
+        row += rowStep;
+        col += colStep;
+        if (rng.uniform(0, 4) == 0)
+        {
+          rowStep = rng.uniform(-1, 2);
+          colStep = rng.uniform(-1, 2);
+        }
+      }
+    }
+    return edges;
+  }
+
+  void expectEqual(const cv::Mat& expected, const cv::Mat& actual)
+  {
+    ASSERT_EQ(expected.rows, actual.rows);
+    ASSERT_EQ(expected.cols, actual.cols);
+    int differences = 0;
+    for (int row = 0; row < expected.rows; row++)
+    {
+      for (int col = 0; col < expected.cols; col++)
+      {
+        if (expected.at<unsigned char>(row, col) != actual.at<unsigned char>(row, col))
+        {
+          differences++;
+        }
+      }
+    }
+    EXPECT_EQ(0, differences);
+  }
+}  // namespace
+
+  //! The index of a neighbourhood has bit 0 at its upper left corner
+  TEST(BinaryMorphologyTest, encode)
+  {
+    const char upperLeft[3][3] = { {1, 0, 0}, {0, 1, 0}, {0, 0, 0} };
+    const char lowerRight[3][3] = { {0, 0, 0}, {0, 1, 0}, {0, 0, 1} };
+    const char cross[3][3] = { {0, 1, 0}, {1, 1, 1}, {0, 1, 0} };
+
+    EXPECT_EQ(1u, BinaryMorphology::encode(upperLeft));
+    EXPECT_EQ(128u, BinaryMorphology::encode(lowerRight));
+    EXPECT_EQ(2u | 8u | 16u | 64u, BinaryMorphology::encode(cross));
+  }
+
+  //! Pruning removes the same pixels as the kernel based implementation
+  TEST(BinaryMorphologyTest, pruningIsEqualToReference)
+  {
+    BinaryMorphology morphology;
+    for (int seed = 0; seed < 20; seed++)
+    {
+      for (int steps = 1; steps <= 1000; steps *= 10)
+      {
+        cv::Mat expected = randomEdges(120, 160, 40, seed);
+        cv::Mat actual = expected.clone();
+
+        referencePruning(&expected, steps);
+        morphology.pruningStrictIterative(&actual, steps);
+
+        expectEqual(expected, actual);
+      }
+    }
+  }
+
+  //! Thinning removes the same pixels as the kernel based implementation
+  TEST(BinaryMorphologyTest, thinningIsEqualToReference)
+  {
+    BinaryMorphology morphology;
+    for (int seed = 0; seed < 20; seed++)
+    {
+      for (int steps = 1; steps <= 1000; steps *= 10)
+      {
+        cv::Mat edges = randomEdges(120, 160, 40, seed);
+        cv::Mat expected, actual;
+
+        referenceThinning(edges, &expected, steps);
+        morphology.thinning(edges, &actual, steps);
+
+        expectEqual(expected, actual);
+      }
+    }
+  }
+
+  //! Each kernel removes at most one pixel per step
+  TEST(BinaryMorphologyTest, thinningOfThickLine)
+  {
+    cv::Mat thickLine = cv::Mat::zeros(480, 640, CV_8UC1);
+    for (int col = 0; col < thickLine.cols; col++)
+    {
+      thickLine.at<unsigned char>(99, col) = 255;
+      thickLine.at<unsigned char>(100, col) = 255;
+      thickLine.at<unsigned char>(101, col) = 255;
+    }
+
+    BinaryMorphology morphology;
+    cv::Mat thinned;
+    for (int steps = 1; steps <= 100; steps *= 10)
+    {
+      morphology.thinning(thickLine, &thinned, steps);
+      int removed = 3 * thickLine.cols - cv::countNonZero(thinned);
+      EXPECT_LT(0, removed);
+      EXPECT_GE(8 * steps, removed);
+    }
+  }
+
+  //! Compares the engine with the per pixel kernel checks on depth-like edges
+  TEST(BinaryMorphologyTest, benchmarkThinningAndPruning)
+  {
+    const int iterations = 5;
+    cv::Mat edges = randomEdges(480, 640, 300, 42);
+    BinaryMorphology morphology;
+    cv::Mat expected, actual;
+
+    ros::WallTime begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      referenceThinning(edges, &expected, 100);
+      referencePruning(&expected, 1000);
+    }
+    double referenceTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      morphology.thinning(edges, &actual, 100);
+      morphology.pruningStrictIterative(&actual, 1000);
+    }
+    double engineTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    expectEqual(expected, actual);
+
+    std::cout << "[ BENCHMARK ] kernel checks:       " << referenceTime << " ms/frame" << std::endl;
+    std::cout << "[ BENCHMARK ] lookup table engine: " << engineTime << " ms/frame" << std::endl;
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -0,0 +1,437 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <vector>
+#include <ros/ros.h>
+#include "utils/brushfire.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace
+{
+  /**
+    @brief The set based 4-connected brushfire from a keypoint, as
+    OutlineDiscovery::brushfireKeypoint used to implement it
+   **/
+  void referenceKeypoint(const cv::Mat& image, unsigned int seed,
+    std::vector<unsigned int>* outline, unsigned int* area)
+  {
+    std::set<unsigned int> current, next, visited, outlineSet;
+    current.insert(seed);
+    visited.insert(seed);
+
+    while (current.size() != 0)
+    {
+      for (std::set<unsigned int>::iterator it = current.begin();
+        it != current.end(); it++)
+      {
+        for (int m = -1; m < 2; m++)
+        {
+          for (int n = -1; n < 2; n++)
+          {
+            if (abs(m) + abs(n) >= 2)
+            {
+              continue;
+            }
+            int x = static_cast<int>(*it) % image.cols + m;
+            int y = static_cast<int>(*it) / image.cols + n;
+            if (x < 0 || y < 0 || x > image.cols - 1 || y > image.rows - 1)
+            {
+              continue;
+            }
+            unsigned int ind = y * image.cols + x;
+            if (image.ptr()[ind] == 0 && visited.find(ind) == visited.end())
+            {
+              next.insert(ind);
+            }
+            if (image.ptr()[ind] != 0)
+            {
+              outlineSet.insert(ind);
+            }
+            visited.insert(ind);
+          }
+        }
+      }
+      current.swap(next);
+      next.clear();
+    }
+
+    outline->assign(outlineSet.begin(), outlineSet.end());
+    *area = visited.size();
+  }
+
+  /**
+    @brief NoiseElimination::interpolation as iterations over the whole
+    image until no pixel changes
+   **/
+  void referenceInterpolation(cv::Mat* image)
+  {
+    const int rowOffsets[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+    const int colOffsets[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+    bool changed = true;
+    while (changed)
+    {
+      changed = false;
+      cv::Mat marker = image->clone();
+      for (int row = 1; row < image->rows - 1; row++)
+      {
+        for (int col = 1; col < image->cols - 1; col++)
+        {
+          if (image->at<float>(row, col) != 0.0)
+          {
+            continue;
+          }
+          float sum = 0.0;
+          int count = 0;
+          for (int n = 0; n < 8; n++)
+          {
+            float value =
+              image->at<float>(row + rowOffsets[n], col + colOffsets[n]);
+            if (value != 0.0)
+            {
+              sum += value;
+              count++;
+            }
+          }
+          if (count > 0)
+          {
+            marker.at<float>(row, col) = sum / count;
+            changed = true;
+          }
+        }
+      }
+      *image = marker;
+    }
+  }
+
+  /**
+    @brief Outlines of rectangles and stray segments, the kind of image
+    blob keypoints are flooded on
+   **/
+  cv::Mat randomEdges(int rows, int cols, int shapes, int seed)
+  {
+    cv::Mat image = cv::Mat::zeros(rows, cols, CV_8UC1);
+    cv::RNG rng(seed);
+    for (int i = 0; i < shapes; i++)
+    {
+      int top = rng.uniform(0, rows - 2);
+      int left = rng.uniform(0, cols - 2);
+      int bottom = std::min(rows - 1, top + rng.uniform(2, 80));
+      int right = std::min(cols - 1, left + rng.uniform(2, 80));
+      bool closed = rng.uniform(0, 4) != 0;
+
+      for (int col = left; col <= right; col++)
+      {
+        image.at<unsigned char>(top, col) = 255;
+        if (closed)
+        {
+          image.at<unsigned char>(bottom, col) = 255;
+        }
+      }
+      for (int row = top; row <= bottom && closed; row++)
+      {
+        image.at<unsigned char>(row, left) = 255;
+        image.at<unsigned char>(row, right) = 255;
+      }
+    }
+    return image;
+  }
+
+  /**
+    @brief A depth image with black areas of every size
+   **/
+  cv::Mat randomDepth(int rows, int cols, int holes, int seed)
+  {
+    cv::Mat image = cv::Mat::zeros(rows, cols, CV_32FC1);
+    cv::RNG rng(seed);
+    for (int row = 0; row < rows; row++)
+    {
+      for (int col = 0; col < cols; col++)
+      {
+        image.at<float>(row, col) =
+          0.5 + 0.01 * rng.uniform(0, 300) + 0.001 * col;
+      }
+    }
+    for (int i = 0; i < holes; i++)
+    {
+      int top = rng.uniform(0, rows - 1);
+      int left = rng.uniform(0, cols - 1);
+      int size = i % 10 == 0 ? rng.uniform(50, 150) : rng.uniform(1, 20);
+      for (int row = top; row < std::min(rows, top + size); row++)
+      {
+        for (int col = left; col < std::min(cols, left + size); col++)
+        {
+          image.at<float>(row, col) = 0.0;
+        }
+      }
+    }
+    return image;
+  }
+}  // namespace
+
+  //! A flood finds the outline and area the set based brushfire finds
+  TEST(BrushfireTest, floodIsEqualToReference)
+  {
+    cv::Mat edges = randomEdges(120, 160, 40, 7);
+    Brushfire brushfire;
+    cv::RNG rng(11);
+
+    for (int i = 0; i < 200; i++)
+    {
+      unsigned int seed = rng.uniform(0, edges.rows * edges.cols);
+
+      std::vector<unsigned int> expectedOutline;
+      unsigned int expectedArea;
+      referenceKeypoint(edges, seed, &expectedOutline, &expectedArea);
+
+      brushfire.flood(edges, seed, false);
+      std::vector<unsigned int> outline = brushfire.outline();
+      std::sort(outline.begin(), outline.end());
+
+      EXPECT_EQ(seed, brushfire.region()[0]);
+      EXPECT_EQ(expectedOutline, outline);
+      EXPECT_EQ(expectedArea, brushfire.region().size() + outline.size()
+        - (edges.ptr()[seed] != 0 ? 1 : 0));
+    }
+  }
+
+  //! Pixels keep the number of the last flood that reached them
+  TEST(BrushfireTest, labelsFloodsSinceReset)
+  {
+    cv::Mat image = cv::Mat::zeros(10, 10, CV_8UC1);
+    for (int row = 0; row < 10; row++)
+    {
+      image.at<unsigned char>(row, 5) = 255;
+    }
+    Brushfire brushfire;
+
+    brushfire.flood(image, 0, false);
+    brushfire.reset(10, 10);
+    EXPECT_EQ(-1, brushfire.label(0));
+
+    brushfire.flood(image, 0, false);
+    brushfire.flood(image, 9, true);
+    EXPECT_EQ(0, brushfire.label(44));
+    EXPECT_EQ(1, brushfire.label(99));
+    EXPECT_EQ(40u, brushfire.region().size());
+    EXPECT_EQ(10u, brushfire.outline().size());
+
+    // An excluded pixel is not expanded
+    brushfire.reset(10, 10);
+    for (int col = 0; col < 5; col++)
+    {
+      brushfire.exclude(50 + col);
+    }
+    brushfire.flood(image, 0, false);
+    EXPECT_EQ(25u, brushfire.region().size());
+    EXPECT_EQ(-1, brushfire.label(60));
+    EXPECT_EQ(5u, brushfire.excludedCount());
+
+    // Exclusions outlive reset() and are lifted by clearExclusions()
+    brushfire.reset(10, 10);
+    brushfire.exclude(50);
+    brushfire.flood(image, 60, false);
+    EXPECT_EQ(20u, brushfire.region().size());
+    EXPECT_EQ(-1, brushfire.label(0));
+    EXPECT_EQ(5u, brushfire.excludedCount());
+
+    brushfire.clearExclusions(10, 10);
+    EXPECT_FALSE(brushfire.excluded(50));
+    EXPECT_EQ(0u, brushfire.excludedCount());
+    brushfire.flood(image, 0, false);
+    EXPECT_EQ(50u, brushfire.region().size());
+  }
+
+  //! The layered fill gives the values of the iterative interpolation
+  TEST(BrushfireTest, meanFillIsEqualToReference)
+  {
+    cv::Mat depth = randomDepth(120, 160, 60, 3);
+    cv::Mat expected = depth.clone();
+    cv::Mat actual = depth.clone();
+
+    referenceInterpolation(&expected);
+    Brushfire().meanFill(&actual);
+
+    for (int row = 0; row < depth.rows; row++)
+    {
+      for (int col = 0; col < depth.cols; col++)
+      {
+        ASSERT_EQ(expected.at<float>(row, col), actual.at<float>(row, col))
+          << "at " << row << ", " << col;
+      }
+    }
+  }
+
+  //! Black pixels take the value of a non-black pixel nearest to them
+  TEST(BrushfireTest, nearestFillFindsNearestPixels)
+  {
+    const int rows = 60;
+    const int cols = 80;
+    cv::Mat depth = cv::Mat::zeros(rows, cols, CV_32FC1);
+    cv::RNG rng(5);
+
+    // Every seed's value is its index, so that it can be told apart
+    std::vector<unsigned int> seeds;
+    for (int i = 0; i < 40; i++)
+    {
+      unsigned int seed = rng.uniform(0, rows * cols);
+      depth.at<float>(seed / cols, seed % cols) = seed + 1;
+      seeds.push_back(seed);
+    }
+
+    cv::Mat filled = depth.clone();
+    Brushfire().nearestFill(&filled);
+
+    int misses = 0;
+    for (int row = 0; row < rows; row++)
+    {
+      for (int col = 0; col < cols; col++)
+      {
+        double nearest = std::numeric_limits<double>::max();
+        for (unsigned int i = 0; i < seeds.size(); i++)
+        {
+          double dy = static_cast<int>(seeds[i] / cols) - row;
+          double dx = static_cast<int>(seeds[i] % cols) - col;
+          nearest = std::min(nearest, dy * dy + dx * dx);
+        }
+
+        unsigned int found =
+          static_cast<unsigned int>(filled.at<float>(row, col)) - 1;
+        ASSERT_LT(found, static_cast<unsigned int>(rows * cols));
+        ASSERT_NE(0.0, depth.at<float>(found / cols, found % cols));
+
+        double dy = static_cast<int>(found / cols) - row;
+        double dx = static_cast<int>(found % cols) - col;
+        if (dy * dy + dx * dx != nearest)
+        {
+          misses++;
+        }
+      }
+    }
+
+    // Jump flooding may rarely settle for a slightly farther pixel
+    EXPECT_LE(misses, rows * cols / 1000);
+  }
+
+  //! An image without non-zero pixels is left as it is
+  TEST(BrushfireTest, nearestFillOfBlackImage)
+  {
+    cv::Mat depth = cv::Mat::zeros(10, 10, CV_32FC1);
+    Brushfire().nearestFill(&depth);
+    EXPECT_EQ(0.0, depth.at<float>(5, 5));
+  }
+
+  //! Compares the set based brushfire and iterative interpolation with the
+  //! bitmap based ones on frames of the depth sensor's size
+  TEST(BrushfireTest, benchmarkKeypointsAndInterpolation)
+  {
+    const int iterations = 3;
+    cv::Mat edges = randomEdges(480, 640, 300, 42);
+    cv::Mat depth = randomDepth(480, 640, 400, 42);
+    Brushfire brushfire;
+
+    std::vector<unsigned int> seeds;
+    cv::RNG rng(1);
+    for (int i = 0; i < 100; i++)
+    {
+      seeds.push_back(rng.uniform(0, edges.rows * edges.cols));
+    }
+
+    std::vector<unsigned int> outline;
+    unsigned int area;
+    ros::WallTime begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      for (unsigned int s = 0; s < seeds.size(); s++)
+      {
+        referenceKeypoint(edges, seeds[s], &outline, &area);
+      }
+    }
+    double setTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      for (unsigned int s = 0; s < seeds.size(); s++)
+      {
+        brushfire.flood(edges, seeds[s], false);
+      }
+    }
+    double floodTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    cv::Mat interpolated;
+    begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      interpolated = depth.clone();
+      referenceInterpolation(&interpolated);
+    }
+    double iterativeTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      interpolated = depth.clone();
+      brushfire.meanFill(&interpolated);
+    }
+    double layeredTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    begin = ros::WallTime::now();
+    for (int i = 0; i < iterations; i++)
+    {
+      interpolated = depth.clone();
+      brushfire.nearestFill(&interpolated);
+    }
+    double jumpFloodTime = (ros::WallTime::now() - begin).toSec() * 1000 / iterations;
+
+    std::cout << "[ BENCHMARK ] set based keypoint floods: " << setTime << " ms/frame" << std::endl;
+    std::cout << "[ BENCHMARK ] bitmap keypoint floods:    " << floodTime << " ms/frame" << std::endl;
+    std::cout << "[ BENCHMARK ] iterative interpolation:   " << iterativeTime << " ms/frame" << std::endl;
+    std::cout << "[ BENCHMARK ] layered interpolation:     " << layeredTime << " ms/frame" << std::endl;
+    std::cout << "[ BENCHMARK ] jump flooding nearest:     " << jumpFloodTime << " ms/frame" << std::endl;
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -0,0 +1,182 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <algorithm>
+#include <vector>
+#include "utils/curve_extraction.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+  /**
+    @class CurveExtractionTest
+    @brief Tests the integrity of methods of class CurveExtraction
+   **/
+  class CurveExtractionTest : public ::testing::Test
+  {
+    protected:
+      CurveExtractionTest() {}
+
+      virtual void SetUp()
+      {
+        image_ = cv::Mat::zeros(HEIGHT, WIDTH, CV_8UC1);
+      }
+
+      void drawRow(int row, int fromCol, int toCol)
+      {
+        for (int col = fromCol; col <= toCol; col++)
+        {
+          image_.at<unsigned char>(row, col) = 255;
+        }
+      }
+
+      void drawCol(int col, int fromRow, int toRow)
+      {
+        for (int row = fromRow; row <= toRow; row++)
+        {
+          image_.at<unsigned char>(row, col) = 255;
+        }
+      }
+
+      unsigned int index(int row, int col)
+      {
+        return row * WIDTH + col;
+      }
+
+      static const int WIDTH = 640;
+      static const int HEIGHT = 480;
+
+      cv::Mat image_;
+      CurveExtraction extraction_;
+  };
+
+  //! Curves touching diagonally are one, curves apart are different
+  TEST_F(CurveExtractionTest, labelsEightConnectedCurves)
+  {
+    drawRow(10, 10, 19);
+    image_.at<unsigned char>(11, 20) = 255;
+    drawRow(12, 21, 30);
+
+    drawCol(100, 100, 149);
+
+    std::vector<Curve> curves;
+    extraction_.extract(image_, 0, &curves);
+
+    ASSERT_EQ(2u, curves.size());
+    EXPECT_EQ(21u, curves[0].points.size());
+    EXPECT_EQ(50u, curves[1].points.size());
+
+    // Points are in raster order
+    for (unsigned int i = 1; i < curves[0].points.size(); i++)
+    {
+      EXPECT_LT(curves[0].points[i - 1], curves[0].points[i]);
+    }
+  }
+
+  //! Curves with up to minimumPoints pixels are discarded
+  TEST_F(CurveExtractionTest, discardsShortCurves)
+  {
+    drawRow(10, 10, 19);
+    drawRow(20, 10, 20);
+
+    std::vector<Curve> curves;
+    extraction_.extract(image_, 10, &curves);
+
+    ASSERT_EQ(1u, curves.size());
+    EXPECT_EQ(11u, curves[0].points.size());
+  }
+
+  //! A U shaped curve is labelled as one, although its legs meet only at
+  //! its bottom, and its end points are the tips of its legs
+  TEST_F(CurveExtractionTest, findsEndPointsOfU)
+  {
+    drawCol(100, 100, 200);
+    drawRow(200, 101, 199);
+    drawCol(200, 100, 200);
+
+    std::vector<Curve> curves;
+    extraction_.extract(image_, 0, &curves);
+
+    ASSERT_EQ(1u, curves.size());
+    EXPECT_EQ(101u + 99u + 101u, curves[0].points.size());
+
+    unsigned int first = std::min(curves[0].first, curves[0].second);
+    unsigned int second = std::max(curves[0].first, curves[0].second);
+    EXPECT_EQ(index(100, 100), first);
+    EXPECT_EQ(index(100, 200), second);
+  }
+
+  //! Of the three end points of a T, the two farthest apart along it are
+  //! chosen
+  TEST_F(CurveExtractionTest, findsFarthestEndPointsOfT)
+  {
+    drawRow(100, 100, 300);
+    drawCol(150, 101, 300);
+
+    std::vector<Curve> curves;
+    extraction_.extract(image_, 0, &curves);
+
+    ASSERT_EQ(1u, curves.size());
+
+    unsigned int first = std::min(curves[0].first, curves[0].second);
+    unsigned int second = std::max(curves[0].first, curves[0].second);
+    EXPECT_EQ(index(100, 300), first);
+    EXPECT_EQ(index(300, 150), second);
+  }
+
+  //! Curves lying on the image's borders are handled
+  TEST_F(CurveExtractionTest, handlesBorders)
+  {
+    drawRow(0, 0, WIDTH - 1);
+    drawCol(WIDTH - 1, 1, HEIGHT - 1);
+
+    std::vector<Curve> curves;
+    extraction_.extract(image_, 0, &curves);
+
+    ASSERT_EQ(1u, curves.size());
+    EXPECT_EQ(static_cast<unsigned int>(WIDTH + HEIGHT - 1), curves[0].points.size());
+
+    unsigned int first = std::min(curves[0].first, curves[0].second);
+    unsigned int second = std::max(curves[0].first, curves[0].second);
+    EXPECT_EQ(index(0, 0), first);
+    EXPECT_EQ(index(HEIGHT - 1, WIDTH - 1), second);
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
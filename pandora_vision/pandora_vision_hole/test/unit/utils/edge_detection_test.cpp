@@ -35,6 +35,7 @@
  * Author: Alexandros Philotheou
  *********************************************************************/
 
+#include <algorithm>
 #include "rgb_node/utils/edge_detection.h"
 #include "gtest/gtest.h"
 
@@ -1134,8 +1135,9 @@ namespace rgb
 
 
 
-  //! Tests EdgeDetection::identifyCurveAndEndpoints
-  TEST_F ( EdgeDetectionTest, identifyCurveAndEndpoints )
+  //! Tests the end points EdgeDetection::identifyCurvesAndEndpoints finds
+  //! for a single curve
+  TEST_F ( EdgeDetectionTest, identifyCurveEndpoints )
   {
     // A gamma shape
     cv::Mat gamma = cv::Mat::zeros( squares_.size(), CV_8UC1 );
@@ -1150,41 +1152,41 @@ namespace rgb
       gamma.at< unsigned char >( 300, cols ) = 255;
     }
 
-    std::set< unsigned int > ret;
-
-    // Find the end points of a curve where a point trully lies on
-    std::pair< GraphNode, GraphNode > p_valid =
-      EdgeDetection::identifyCurveAndEndpoints ( &gamma, 300, 451, &ret);
+    std::vector< std::set< unsigned int > > lines;
+    std::vector< std::pair< GraphNode, GraphNode > > endPoints;
 
-    // The point should lie on a curve.
-    // The curve should indeed be a curve: it is constituted by points
-    EXPECT_LT ( 0, ret.size() );
+    EdgeDetection::identifyCurvesAndEndpoints( &gamma, &lines, &endPoints );
 
-    // The first end point's coordinates
-    EXPECT_EQ ( p_valid.first.x, 300 );
-    EXPECT_EQ ( p_valid.first.y, 499 );
+    // The gamma is a single curve, and the point ( 300, 451 ) lies on it
+    ASSERT_EQ ( 1, lines.size() );
+    ASSERT_EQ ( 1, endPoints.size() );
+    EXPECT_EQ ( 299, lines[0].size() );
+    EXPECT_EQ ( 1, lines[0].count( 300 * gamma.cols + 451 ) );
 
-    // The second end point's coordinates
-    EXPECT_EQ ( p_valid.second.x, 399 );
-    EXPECT_EQ ( p_valid.second.y, 300 );
+    // Its end points are the ends of its two arms, in either order
+    GraphNode first = endPoints[0].first;
+    GraphNode second = endPoints[0].second;
+    if ( first.x != 300 )
+    {
+      std::swap( first, second );
+    }
 
+    EXPECT_EQ ( first.x, 300 );
+    EXPECT_EQ ( first.y, 499 );
 
-    ret.clear();
+    EXPECT_EQ ( second.x, 399 );
+    EXPECT_EQ ( second.y, 300 );
 
-    // Find the end points of a curve where a point trully lies on
-    std::pair< GraphNode, GraphNode > p_invalid =
-      EdgeDetection::identifyCurveAndEndpoints ( &gamma, 100, 200, &ret);
 
-    // The point should not lie on a curve.
-    EXPECT_EQ ( 1, ret.size() );
+    // An image without curves
+    cv::Mat blank = cv::Mat::zeros( squares_.size(), CV_8UC1 );
+    lines.clear();
+    endPoints.clear();
 
-    // The first end point's coordinates will be the origin
-    EXPECT_EQ ( p_invalid.first.x, 0 );
-    EXPECT_EQ ( p_invalid.first.y, 0 );
+    EdgeDetection::identifyCurvesAndEndpoints( &blank, &lines, &endPoints );
 
-    // The second end point's coordinates will be also be the origin
-    EXPECT_EQ ( p_invalid.second.x, 0 );
-    EXPECT_EQ ( p_invalid.second.y, 0 );
+    EXPECT_EQ ( 0, lines.size() );
+    EXPECT_EQ ( 0, endPoints.size() );
   }
 
 
@@ -574,6 +574,31 @@ namespace rgb
 
 
 
+  //! Tests NoiseElimination::performeNoiseElimination with jump flooding
+  TEST_F ( NoiseEliminationTest, performeNoiseEliminationJumpFloodingTest )
+  {
+    // interpolationMethod0 is interpolated by jump flooding
+    Parameters::Depth::use_jump_flooding = true;
+
+    cv::Mat interpolated;
+    NoiseElimination::performNoiseElimination(
+      interpolationMethod0, &interpolated );
+
+    Parameters::Depth::use_jump_flooding = false;
+
+    // The result is the one of NoiseElimination::jumpFloodNearest
+    cv::Mat expected;
+    NoiseElimination::jumpFloodNearest( interpolationMethod0, &expected );
+
+    ASSERT_EQ ( 0, Parameters::Depth::interpolation_method );
+    EXPECT_EQ ( 0, cv::countNonZero( interpolated != expected ) );
+
+    // There shouldn't be any black pixels in interpolated
+    EXPECT_EQ ( WIDTH * HEIGHT, cv::countNonZero( interpolated ) );
+  }
+
+
+
   //! Tests NoiseElimination::transformNoiseToWhite
   TEST_F ( NoiseEliminationTest, transformNoiseToWhiteTest )
   {
@@ -429,6 +429,22 @@ namespace rgb
     EXPECT_EQ ( 9996, visited_1.size() );
 
 
+    // Points already visited fence off the following calls on the same set
+    std::set< unsigned int > visitedBoth;
+    OutlineDiscovery::brushfirePoint ( p_0, &squares_, &visitedBoth );
+    OutlineDiscovery::brushfirePoint ( p_1, &squares_, &visitedBoth );
+    EXPECT_EQ ( 19992, visitedBoth.size() );
+
+    OutlineDiscovery::brushfirePoint
+      ( cv::Point2f ( 151, 102 ), &squares_, &visitedBoth );
+    EXPECT_EQ ( 19992, visitedBoth.size() );
+
+    // A set filled elsewhere is honoured too
+    std::set< unsigned int > fenced ( visited_0 );
+    OutlineDiscovery::brushfirePoint ( p_0, &squares_, &fenced );
+    EXPECT_EQ ( visited_0, fenced );
+
+
     /***************************************************************************
      * Test corners_
      **************************************************************************/
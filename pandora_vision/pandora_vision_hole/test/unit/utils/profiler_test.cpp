@@ -0,0 +1,180 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#define DEBUG_TIME
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
+#include <ros/ros.h>
+#include "utils/profiler.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace
+{
+  /**
+    @brief The statistics of a probe, by name
+   **/
+  Profiler::Statistics statisticsOf(const std::string& name)
+  {
+    std::vector<Profiler::Statistics> statistics = Profiler::collect();
+    for (unsigned int i = 0; i < statistics.size(); i++)
+    {
+      if (statistics[i].name == name)
+      {
+        return statistics[i];
+      }
+    }
+    ADD_FAILURE() << "No probe " << name;
+    return Profiler::Statistics();
+  }
+
+  void inner()
+  {
+    PROFILE_SCOPE("inner", "outer");
+  }
+
+  void outer(int calls)
+  {
+    PROFILE_SCOPE("outer", "");
+
+    for (int i = 0; i < calls; i++)
+    {
+      inner();
+    }
+  }
+
+  void threaded(int calls)
+  {
+    for (int i = 0; i < calls; i++)
+    {
+      PROFILE_SCOPE("threaded", "");
+    }
+  }
+
+  //! Tests the counts and the hierarchy of nested scopes
+  TEST(ProfilerTest, scopesTest)
+  {
+    Profiler::reset();
+
+    outer(3);
+    outer(2);
+
+    Profiler::Statistics o = statisticsOf("outer");
+    Profiler::Statistics i = statisticsOf("inner");
+
+    EXPECT_EQ(2u, o.count);
+    EXPECT_EQ(5u, i.count);
+    EXPECT_EQ("", o.parent);
+    EXPECT_EQ("outer", i.parent);
+    EXPECT_LE(o.min, o.max);
+    EXPECT_LE(i.total, o.total);
+
+    // The same name is the same probe, whichever its site
+    EXPECT_EQ(Profiler::registerProbe("outer", "elsewhere"),
+      Profiler::registerProbe("outer", ""));
+
+    std::ostringstream tree;
+    Profiler::writeTree(tree);
+    std::string lines = "\n" + tree.str();
+    EXPECT_NE(std::string::npos, lines.find("\nouter [2 - "));
+    EXPECT_NE(std::string::npos, lines.find("\n|-inner [5 - "));
+  }
+
+  //! Tests that the measurements of all threads are summed up
+  TEST(ProfilerTest, threadsTest)
+  {
+    Profiler::reset();
+
+    boost::thread_group threads;
+    for (int t = 0; t < 4; t++)
+    {
+      threads.create_thread(boost::bind(&threaded, 1000));
+    }
+    threaded(1000);
+    threads.join_all();
+
+    EXPECT_EQ(5000u, statisticsOf("threaded").count);
+  }
+
+  //! Tests that a probe stops when it is ended, before its scope does
+  TEST(ProfilerTest, beginEndTest)
+  {
+    Profiler::reset();
+
+    {
+      PROFILE_BEGIN(first, "first", "");
+      PROFILE_END(first);
+
+      boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+
+      PROFILE_BEGIN(second, "second", "");
+      boost::this_thread::sleep(boost::posix_time::milliseconds(10));
+      PROFILE_END(second);
+    }
+
+    Profiler::Statistics first = statisticsOf("first");
+    Profiler::Statistics second = statisticsOf("second");
+
+    EXPECT_EQ(1u, first.count);
+    EXPECT_EQ(1u, second.count);
+    EXPECT_LT(first.total, 50000000u);
+    EXPECT_GE(second.total, 10000000u);
+    EXPECT_LT(second.total, 50000000u);
+  }
+
+  //! Tests the trace of the probes
+  TEST(ProfilerTest, traceTest)
+  {
+    Profiler::reset();
+    outer(1);
+
+    std::ostringstream trace;
+    Profiler::writeTrace(trace);
+
+    EXPECT_EQ(0u, trace.str().find("probe,parent,count,total,min,mean,max\n"));
+    EXPECT_NE(std::string::npos, trace.str().find("\ninner,outer,1,"));
+  }
+}  // namespace
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -0,0 +1,304 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors: Tsirigotis Christos
+ *********************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <vector>
+#include <ros/ros.h>
+#include "utils/region.h"
+#include "gtest/gtest.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_hole
+{
+namespace
+{
+  /**
+    @brief A mask of a few random blobs and stripes
+   **/
+  cv::Mat randomMask(cv::RNG* rng, int rows, int cols)
+  {
+    cv::Mat mask = cv::Mat::zeros(rows, cols, CV_8UC1);
+
+    for (int b = 0; b < 6; b++)
+    {
+      int top = rng->uniform(0, rows);
+      int left = rng->uniform(0, cols);
+      int height = rng->uniform(1, rows / 2);
+      int width = rng->uniform(1, cols / 2);
+
+      for (int r = top; r < std::min(rows, top + height); r++)
+      {
+        for (int c = left; c < std::min(cols, left + width); c++)
+        {
+          // Leave gaps so that rows hold more than one run
+          if ((c + r) % 7 != 0)
+          {
+            mask.at<unsigned char>(r, c) = 255;
+          }
+        }
+      }
+    }
+
+    return mask;
+  }
+
+  std::set<unsigned int> maskSet(const cv::Mat& mask)
+  {
+    std::set<unsigned int> set;
+    for (int i = 0; i < mask.rows * mask.cols; i++)
+    {
+      if (mask.ptr()[i] != 0)
+      {
+        set.insert(i);
+      }
+    }
+    return set;
+  }
+
+  std::set<unsigned int> regionSet(const Region& region)
+  {
+    std::vector<unsigned int> indices;
+    region.toIndices(&indices);
+    return std::set<unsigned int>(indices.begin(), indices.end());
+  }
+
+  /**
+    @brief Whether the runs are sorted, non-empty and neither touch nor
+    overlap each other
+   **/
+  bool isCanonical(const Region& region)
+  {
+    const std::vector<Region::Run>& runs = region.runs();
+    for (unsigned int r = 0; r < runs.size(); r++)
+    {
+      if (runs[r].begin >= runs[r].end)
+      {
+        return false;
+      }
+      if (r > 0 && (runs[r].row < runs[r - 1].row
+          || (runs[r].row == runs[r - 1].row
+            && runs[r].begin <= runs[r - 1].end)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}  // namespace
+
+  TEST(RegionTest, maskRoundTrip)
+  {
+    cv::RNG rng(17);
+    for (int t = 0; t < 20; t++)
+    {
+      cv::Mat mask = randomMask(&rng, 48, 64);
+      Region region = Region::fromMask(mask);
+
+      EXPECT_TRUE(isCanonical(region));
+      EXPECT_EQ(64, region.cols());
+
+      std::set<unsigned int> expected = maskSet(mask);
+      EXPECT_EQ(expected.size(), region.area());
+      EXPECT_TRUE(expected == regionSet(region));
+
+      cv::Mat drawn = cv::Mat::zeros(48, 64, CV_8UC1);
+      region.toMask(&drawn);
+      EXPECT_TRUE(expected == maskSet(drawn));
+
+      Region fromIndices = Region::fromIndices(expected, 64);
+      EXPECT_TRUE(isCanonical(fromIndices));
+      EXPECT_EQ(region.runs().size(), fromIndices.runs().size());
+      EXPECT_TRUE(expected == regionSet(fromIndices));
+    }
+  }
+
+  TEST(RegionTest, setOperations)
+  {
+    cv::RNG rng(29);
+    for (int t = 0; t < 50; t++)
+    {
+      cv::Mat maskA = randomMask(&rng, 40, 50);
+      cv::Mat maskB = randomMask(&rng, 40, 50);
+      Region a = Region::fromMask(maskA);
+      Region b = Region::fromMask(maskB);
+      std::set<unsigned int> setA = maskSet(maskA);
+      std::set<unsigned int> setB = maskSet(maskB);
+
+      std::set<unsigned int> united, intersection, difference;
+      std::set_union(setA.begin(), setA.end(), setB.begin(), setB.end(),
+        std::inserter(united, united.end()));
+      std::set_intersection(setA.begin(), setA.end(), setB.begin(), setB.end(),
+        std::inserter(intersection, intersection.end()));
+      std::set_difference(setA.begin(), setA.end(), setB.begin(), setB.end(),
+        std::inserter(difference, difference.end()));
+
+      Region u = a.unite(b);
+      Region i = a.intersect(b);
+      Region d = a.subtract(b);
+
+      EXPECT_TRUE(isCanonical(u));
+      EXPECT_TRUE(isCanonical(i));
+      EXPECT_TRUE(isCanonical(d));
+
+      EXPECT_TRUE(united == regionSet(u));
+      EXPECT_TRUE(intersection == regionSet(i));
+      EXPECT_TRUE(difference == regionSet(d));
+
+      EXPECT_EQ(united.size(), u.area());
+      EXPECT_EQ(intersection.size(), i.area());
+      EXPECT_EQ(difference.size(), d.area());
+      EXPECT_EQ(intersection.size(), a.intersectionArea(b));
+      EXPECT_EQ(intersection.size(), b.intersectionArea(a));
+    }
+  }
+
+  TEST(RegionTest, containsAndBoundingBox)
+  {
+    cv::RNG rng(41);
+    for (int t = 0; t < 20; t++)
+    {
+      cv::Mat mask = randomMask(&rng, 30, 40);
+      Region region = Region::fromMask(mask);
+
+      int top = 30, bottom = -1, left = 40, right = -1;
+      for (int r = 0; r < 30; r++)
+      {
+        for (int c = 0; c < 40; c++)
+        {
+          bool inside = mask.at<unsigned char>(r, c) != 0;
+          EXPECT_EQ(inside, region.contains(r * 40 + c));
+          if (inside)
+          {
+            top = std::min(top, r);
+            bottom = std::max(bottom, r);
+            left = std::min(left, c);
+            right = std::max(right, c);
+          }
+        }
+      }
+
+      cv::Rect box = region.boundingBox();
+      EXPECT_EQ(left, box.x);
+      EXPECT_EQ(top, box.y);
+      EXPECT_EQ(right - left + 1, box.width);
+      EXPECT_EQ(bottom - top + 1, box.height);
+    }
+  }
+
+  TEST(RegionTest, emptyRegions)
+  {
+    Region empty(10);
+    Region full = Region::fromMask(cv::Mat(5, 10, CV_8UC1, cv::Scalar(255)));
+
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(0, empty.area());
+    EXPECT_EQ(50, full.area());
+    EXPECT_EQ(5, full.runs().size());
+    EXPECT_EQ(0, empty.boundingBox().area());
+    EXPECT_FALSE(empty.contains(0));
+
+    EXPECT_EQ(50, empty.unite(full).area());
+    EXPECT_EQ(0, empty.intersect(full).area());
+    EXPECT_EQ(0, full.subtract(full).area());
+    EXPECT_EQ(50, full.subtract(empty).area());
+    EXPECT_EQ(0, full.intersectionArea(empty));
+
+    // Runs that touch are joined, runs of different rows are not
+    Region region(10);
+    region.append(0, 2, 5);
+    region.append(0, 5, 10);
+    region.append(1, 0, 3);
+    region.append(1, 1, 2);
+    EXPECT_EQ(2, region.runs().size());
+    EXPECT_EQ(11, region.area());
+  }
+
+  TEST(RegionTest, benchmarkMergeChecks)
+  {
+    cv::RNG rng(5);
+    std::vector<cv::Mat> masks;
+    for (int m = 0; m < 8; m++)
+    {
+      masks.push_back(randomMask(&rng, 240, 320));
+    }
+
+    std::vector<std::set<unsigned int> > sets;
+    std::vector<Region> regions;
+    for (int m = 0; m < masks.size(); m++)
+    {
+      sets.push_back(maskSet(masks[m]));
+      regions.push_back(Region::fromMask(masks[m]));
+    }
+
+    // The overlap test of the holes' merger, once by cloning a set and
+    // inserting the other's indices into it and once through the runs
+    ros::WallTime begin = ros::WallTime::now();
+    int setOverlaps = 0;
+    for (int a = 0; a < sets.size(); a++)
+    {
+      for (int b = 0; b < sets.size(); b++)
+      {
+        std::set<unsigned int> summation = sets[a];
+        summation.insert(sets[b].begin(), sets[b].end());
+        setOverlaps += summation.size() != sets[a].size() + sets[b].size();
+      }
+    }
+    double setTime = (ros::WallTime::now() - begin).toSec() * 1000;
+
+    begin = ros::WallTime::now();
+    int regionOverlaps = 0;
+    for (int a = 0; a < regions.size(); a++)
+    {
+      for (int b = 0; b < regions.size(); b++)
+      {
+        regionOverlaps += regions[a].intersectionArea(regions[b]) > 0;
+      }
+    }
+    double regionTime = (ros::WallTime::now() - begin).toSec() * 1000;
+
+    EXPECT_EQ(setOverlaps, regionOverlaps);
+
+    std::cout << "[ BENCHMARK ] set overlap checks:    " << setTime << " ms" << std::endl;
+    std::cout << "[ BENCHMARK ] region overlap checks: " << regionTime << " ms" << std::endl;
+  }
+
+}  // namespace pandora_vision_hole
+}  // namespace pandora_vision
@@ -56,6 +56,8 @@ namespace pandora_vision_landoltc
   {
     VisionPreProcessor::initialize(ns, handler);
     setImageEncoding(sensor_msgs::image_encodings::BGR8);
+    // The detector draws its findings on the frame
+    setMutableImage(true);
   }
 
 }  // namespace pandora_vision_landoltc
@@ -72,6 +72,18 @@ namespace pandora_vision_obstacle
     virtual bool preProcess(const PointCloud2ConstPtr& input,
         const CVMatStampedPtr& output);
 
+    /**
+      * @brief Subscribes to the point cloud and advertises the elevation map
+      * image again when the handler makes the preprocessor a stage again.
+      */
+    virtual void activate();
+
+    /**
+      * @brief Unsubscribes from the point cloud and unadvertises the elevation
+      * map image while the preprocessor is parked.
+      */
+    virtual void park();
+
     /**
       * @brief Converts an Point Cloud to a local elevation map in OpenCV matrix
       * format.
@@ -96,6 +108,9 @@ namespace pandora_vision_obstacle
    private:
     ros::Publisher imagePublisher_;
 
+    /// The topic the elevation map image is published on.
+    std::string publishedImageTopic_;
+
     /// The maximum distance of a point from the range sensor.
     double maxAllowedDist_;
 
@@ -88,20 +88,34 @@ namespace pandora_vision_obstacle
       ROS_BREAK();
     }
 
-    std::string topic;
-    if (!this->getProcessorNodeHandle().getParam("published_image_topic", topic))
+    if (!this->getProcessorNodeHandle().getParam("published_image_topic", publishedImageTopic_))
     {
       ROS_ERROR_STREAM("[" + this->getName() + "] preprocessor nh processor : Could not "
           << "retrieve the name of the topic to publish!");
       ROS_BREAK();
     }
-    imagePublisher_ = this->getPublicNodeHandle().advertise<sensor_msgs::Image>(topic, 1);
+    imagePublisher_ = this->getPublicNodeHandle().advertise<sensor_msgs::Image>(publishedImageTopic_, 1);
 
     tf::StampedTransform tfTransform;
     tfListener_.waitForTransform("/world", "/map", ros::Time::now(), ros::Duration(2));
     tfListener_.lookupTransform("/world", "/map", ros::Time::now(), tfTransform);
   }
 
+  void
+  HardObstaclePreProcessor::activate()
+  {
+    sensor_processor::PreProcessor<sensor_msgs::PointCloud2, CVMatStamped>::activate();
+    if (!imagePublisher_)
+      imagePublisher_ = this->getPublicNodeHandle().advertise<sensor_msgs::Image>(publishedImageTopic_, 1);
+  }
+
+  void
+  HardObstaclePreProcessor::park()
+  {
+    sensor_processor::PreProcessor<sensor_msgs::PointCloud2, CVMatStamped>::park();
+    imagePublisher_.shutdown();
+  }
+
   void HardObstaclePreProcessor::reconfCallback(const ::pandora_vision_obstacle::elevation_mapConfig params,
       uint32_t level)
   {
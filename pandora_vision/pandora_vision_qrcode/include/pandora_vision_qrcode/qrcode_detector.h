@@ -92,7 +92,8 @@ namespace pandora_vision_qrcode
 
     /**
       * @brief Detects qrcodes and stores them in a vector.
-      * @param frame [cv::Mat] The image in which the QRs are detected
+      * @param frame [cv::Mat] The image in which the QRs are detected, BGR
+      * or grayscale. It is not modified
       * @return void
       */
     std::vector<POIPtr> detectQrCode(const cv::Mat& frame);
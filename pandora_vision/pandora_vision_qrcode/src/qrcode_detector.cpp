@@ -122,14 +122,16 @@ namespace pandora_vision_qrcode
     */
   std::vector<POIPtr> QrCodeDetector::detectQrCode(const cv::Mat& frame)
   {
-    cv::Mat grayFrame;
+    cv::Mat inputGray;
 
     if (frame.channels() == 3)
-      cv::cvtColor(frame, grayFrame, CV_BGR2GRAY);
+      cv::cvtColor(frame, inputGray, CV_BGR2GRAY);
     else
-      frame.copyTo(grayFrame);
-    cv::Mat blured;
-    normalize(grayFrame, grayFrame, 255, 0, cv::NORM_MINMAX);
+      inputGray = frame;
+    // The input may be shared with other detectors, so it is not
+    // normalized in place
+    cv::Mat grayFrame, blured;
+    normalize(inputGray, grayFrame, 255, 0, cv::NORM_MINMAX);
     cv::GaussianBlur(grayFrame, blured, cv::Size(0, 0), gaussianSharpenBlur_);
     cv::addWeighted(grayFrame, 1 + gaussianSharpenWeight_, blured,
         -gaussianSharpenWeight_, 0, grayFrame);
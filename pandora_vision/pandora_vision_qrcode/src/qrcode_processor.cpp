@@ -127,7 +127,11 @@ namespace pandora_vision_qrcode
     output->frameWidth = input->getImage().cols;
     output->frameHeight = input->getImage().rows;
 
-    output->pois = detectorPtr_->detectQrCode(input->getImage());
+    // The grayscale frame may have been already computed by another node
+    if (input->derivatives)
+      output->pois = detectorPtr_->detectQrCode(input->derivatives->getGray());
+    else
+      output->pois = detectorPtr_->detectQrCode(input->getImage());
 
     if (output->pois.empty())
     {
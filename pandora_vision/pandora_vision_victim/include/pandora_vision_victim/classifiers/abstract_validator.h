@@ -46,11 +46,13 @@
 #include <opencv2/opencv.hpp>
 
 #include <ros/ros.h>
+#include <boost/shared_ptr.hpp>
 
 #include "pandora_vision_victim/feature_extractors/feature_extraction.h"
 #include "pandora_vision_victim/feature_extractors/rgb_feature_extraction.h"
 #include "pandora_vision_victim/feature_extractors/depth_feature_extraction.h"
 #include "pandora_vision_victim/utilities/feature_extraction_utilities.h"
+#include "pandora_vision_victim/utilities/platt_scaling.h"
 
 /**
  * @namespace pandora_vision
@@ -105,6 +107,72 @@ namespace pandora_vision_victim
       void calculatePredictionProbability(const cv::Mat& rgbImage, const cv::Mat& depthImage,
                                           float* classLabel, float* probability);
 
+      /**
+       * @brief This function classifies a set of images at once. Their
+       * feature vectors are stacked in one matrix, which is normalized and
+       * passed to the classifier in a single call.
+       * @param images [const std::vector<cv::Mat>&] The frames to be
+       * processed, e.g. the regions of the holes of a frame.
+       * @param classLabels [std::vector<float>*] The predicted class label of
+       * each frame.
+       * @param probabilities [std::vector<float>*] The classification
+       * probability of each frame.
+       * @return void
+       */
+      void calculatePredictionProbabilities(const std::vector<cv::Mat>& images,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
+      /**
+       * @brief This function classifies a set of rgb and depth frame pairs
+       * at once.
+       * @param rgbImages [const std::vector<cv::Mat>&] The rgb frames to be
+       * processed.
+       * @param depthImages [const std::vector<cv::Mat>&] The depth frames to
+       * be processed, one for each rgb frame.
+       * @param classLabels [std::vector<float>*] The predicted class label of
+       * each pair.
+       * @param probabilities [std::vector<float>*] The classification
+       * probability of each pair.
+       * @return void
+       */
+      void calculatePredictionProbabilities(const std::vector<cv::Mat>& rgbImages,
+          const std::vector<cv::Mat>& depthImages,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
+      /**
+       * @brief This function classifies a set of regions of a frame at once.
+       * Their features are extracted from the whole frame, which lets the
+       * feature extractors share work between the regions.
+       * @param frame [const cv::Mat&] The frame the regions belong to.
+       * @param regions [const std::vector<cv::Rect>&] The regions to be
+       * processed, e.g. the bounding boxes of the holes of the frame.
+       * @param classLabels [std::vector<float>*] The predicted class label of
+       * each region.
+       * @param probabilities [std::vector<float>*] The classification
+       * probability of each region.
+       * @return void
+       */
+      void calculatePredictionProbabilities(const cv::Mat& frame,
+          const std::vector<cv::Rect>& regions,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
+      /**
+       * @brief This function classifies a set of regions of an rgb and a
+       * depth frame at once.
+       * @param rgbFrame [const cv::Mat&] The rgb frame.
+       * @param depthFrame [const cv::Mat&] The depth frame.
+       * @param regions [const std::vector<cv::Rect>&] The regions to be
+       * processed, the same in both frames.
+       * @param classLabels [std::vector<float>*] The predicted class label of
+       * each region.
+       * @param probabilities [std::vector<float>*] The classification
+       * probability of each region.
+       * @return void
+       */
+      void calculatePredictionProbabilities(const cv::Mat& rgbFrame,
+          const cv::Mat& depthFrame, const std::vector<cv::Rect>& regions,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
       /**
        * @brief This function returns the type of the classifier.
        * @return [const std:;string&] The type of the classifier.
@@ -142,6 +210,65 @@ namespace pandora_vision_victim
        */
       virtual void predict(const cv::Mat& featuresMat, float* classLabel, float* probability) = 0;
 
+      /**
+       * @brief This function predicts the class labels and the classification
+       * probabilities of a set of feature vectors. By default every row is
+       * predicted on its own; classifiers that can process many samples at
+       * once override it.
+       * @param featuresMat [const cv::Mat&] The feature vectors, one per row.
+       * @param classLabels [std::vector<float>*] The predicted class labels.
+       * @param probabilities [std::vector<float>*] The classification
+       * probabilities.
+       * @return void
+       */
+      virtual void predict(const cv::Mat& featuresMat,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
+      /**
+       * @brief This function calculates the classification probabilities of
+       * a set of feature vectors according to the decision function values
+       * of a classifier, with Platt Scaling if it is used and with the
+       * probability scaling and translation otherwise.
+       * @param predictions [const cv::Mat&] The classifier predictions, a
+       * CV_64FC1 column.
+       * @param classLabels [const std::vector<float>&] The estimated class
+       * labels.
+       * @param probabilities [std::vector<float>*] The classification
+       * probabilities.
+       * @return void
+       */
+      void transformPredictionsToProbabilities(const cv::Mat& predictions,
+          const std::vector<float>& classLabels,
+          std::vector<float>* probabilities);
+
+    private:
+      /**
+       * @brief Appends the features of a frame to a row of the features
+       * matrix, allocating the matrix when its first row is written.
+       * @param featureVector [const std::vector<double>&] The features.
+       * @param row [int] The row of the features matrix.
+       * @param col [int] The column where the features start.
+       * @param numRows [int] The number of rows of the features matrix.
+       * @param numCols [int] The number of columns of the features matrix, if
+       * it is known; otherwise the size of the feature vector is used.
+       * @param featuresMat [cv::Mat*] The features matrix.
+       * @return void
+       */
+      static void setFeatures(const std::vector<double>& featureVector,
+          int row, int col, int numRows, int numCols, cv::Mat* featuresMat);
+
+      /**
+       * @brief Normalizes a features matrix, converts it to CV_32FC1 and
+       * predicts the class label and probability of each of its rows.
+       * @param featuresMat [cv::Mat*] The features matrix.
+       * @param classLabels [std::vector<float>*] The predicted class labels.
+       * @param probabilities [std::vector<float>*] The classification
+       * probabilities.
+       * @return void
+       */
+      void classifyFeatures(cv::Mat* featuresMat,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
     protected:
       std::string imageType_;
 
@@ -173,6 +300,15 @@ namespace pandora_vision_victim
       /// vector contains standard values. If min-max normalization is used,
       /// this vector contains max values.
       std::vector<double> normalizationParamTwoVec_;
+
+      /// Variables used for the transformation of the classifier prediction to
+      /// probabilities.
+      double probabilityScaling_;
+      double probabilityTranslation_;
+
+      boost::shared_ptr<PlattScaling> plattScalingPtr_;
+
+      bool usePlattScaling_;
   };
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
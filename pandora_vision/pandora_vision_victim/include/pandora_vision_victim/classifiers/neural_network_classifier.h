@@ -47,6 +47,7 @@
 
 #include "pandora_vision_victim/feature_extractors/feature_extraction.h"
 #include "pandora_vision_victim/utilities/file_utilities.h"
+#include "pandora_vision_victim/utilities/neural_network_model.h"
 
 namespace pandora_vision
 {
@@ -102,7 +103,7 @@ namespace pandora_vision_victim
        */
       virtual void load(const std::string& classifierFile)
       {
-        classifierPtr_->load(classifierFile.c_str());
+        classifierPtr_->loadModel(classifierFile);
       }
 
     protected:
@@ -110,7 +111,7 @@ namespace pandora_vision_victim
       cv::ANN_MLP_TrainParams NeuralNetworkParams_;
 
       /// The Pointer to the classifier object
-      boost::shared_ptr<CvANN_MLP> classifierPtr_;
+      boost::shared_ptr<NeuralNetworkModel> classifierPtr_;
   };
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
@@ -40,11 +40,13 @@
 #define PANDORA_VISION_VICTIM_CLASSIFIERS_NEURAL_NETWORK_VALIDATOR_H
 
 #include <string>
+#include <vector>
 
 #include <opencv2/opencv.hpp>
 #include <ros/ros.h>
 
 #include "pandora_vision_victim/classifiers/abstract_validator.h"
+#include "pandora_vision_victim/utilities/neural_network_model.h"
 
 /**
  * @namespace pandora_vision
@@ -83,9 +85,17 @@ namespace pandora_vision_victim
       virtual void predict(const cv::Mat& featuresMat,
           float* classLabel, float* probability);
 
+      /**
+       * @brief Function that makes a prediction for all the feature vectors
+       * with a single forward pass of the network
+       * @return void
+       */
+      virtual void predict(const cv::Mat& featuresMat,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
+
     private:
       /// The OpenCV Neural Network classifier.
-      CvANN_MLP neuralNetworkValidator_;
+      NeuralNetworkModel neuralNetworkValidator_;
   };
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
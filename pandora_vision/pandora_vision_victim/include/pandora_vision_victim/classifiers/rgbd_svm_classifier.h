@@ -54,6 +54,7 @@
 
 #include "pandora_vision_victim/classifiers/abstract_classifier.h"
 #include "pandora_vision_victim/utilities/platt_scaling.h"
+#include "pandora_vision_victim/utilities/svm_model.h"
 #include "pandora_vision_victim/utilities/principal_component_analysis.h"
 
 
@@ -115,7 +116,7 @@ namespace pandora_vision_victim
        */
       virtual void load(const std::string& classifierFile)
       {
-        classifierPtr_->load(classifierFile.c_str());
+        classifierPtr_->loadModel(classifierFile);
       }
 
     private:
@@ -143,7 +144,7 @@ namespace pandora_vision_victim
       int numDepthFeatures_;
 
       /// The Pointer to the classifier object
-      boost::shared_ptr<CvSVM> classifierPtr_;
+      boost::shared_ptr<SvmModel> classifierPtr_;
 
       /// The pointers to the Platt Scaling object.
       boost::shared_ptr<PlattScaling> plattScalingPtr_;
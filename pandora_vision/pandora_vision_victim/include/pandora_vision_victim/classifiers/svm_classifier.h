@@ -46,6 +46,7 @@
 
 #include "pandora_vision_victim/classifiers/abstract_classifier.h"
 #include "pandora_vision_victim/utilities/platt_scaling.h"
+#include "pandora_vision_victim/utilities/svm_model.h"
 #include "pandora_vision_victim/utilities/principal_component_analysis.h"
 
 namespace pandora_vision
@@ -95,7 +96,7 @@ namespace pandora_vision_victim
        */
       virtual void load(const std::string& classifierFile)
       {
-        classifierPtr_->load(classifierFile.c_str());
+        classifierPtr_->loadModel(classifierFile);
       }
 
     private:
@@ -108,7 +109,7 @@ namespace pandora_vision_victim
       bool usePlattScaling_;
 
       /// The Pointer to the classifier object
-      boost::shared_ptr<CvSVM> classifierPtr_;
+      boost::shared_ptr<SvmModel> classifierPtr_;
 
       /// The pointers to the Platt Scaling object.
       boost::shared_ptr<PlattScaling> plattScalingPtr_;
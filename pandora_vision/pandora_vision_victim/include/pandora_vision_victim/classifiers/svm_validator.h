@@ -41,6 +41,7 @@
 #define PANDORA_VISION_VICTIM_CLASSIFIERS_SVM_VALIDATOR_H
 
 #include <string>
+#include <vector>
 
 #include <opencv2/opencv.hpp>
 #include <ros/ros.h>
@@ -48,6 +49,7 @@
 
 #include "pandora_vision_victim/classifiers/abstract_validator.h"
 #include "pandora_vision_victim/utilities/platt_scaling.h"
+#include "pandora_vision_victim/utilities/svm_model.h"
 #include "pandora_vision_victim/utilities/principal_component_analysis.h"
 
 /**
@@ -87,32 +89,21 @@ namespace pandora_vision_victim
       virtual void predict(const cv::Mat& featuresMat,
           float* classLabel, float* prediction);
 
-    private:
       /**
-       * @brief This function calculates the classification probability
-       * according to the SVM prediction.
-       * @param prediction [float] The SVM prediction.
-       * @param classLabel [float] The estimated class label.
-       * @return [float] The classification probability.
+       * @brief Predicts the decision function values of all the feature
+       * vectors, and from them their class labels and probabilities
+       * @return void
        */
-      float transformPredictionToProbability(float prediction, float classLabel);
+      virtual void predict(const cv::Mat& featuresMat,
+          std::vector<float>* classLabels, std::vector<float>* probabilities);
 
     private:
       /// The OpenCV SVM classifier.
-      CvSVM svmValidator_;
+      SvmModel svmValidator_;
 
       /// Parameters for the OpenCV SVM classifier.
       CvSVMParams svmParams_;
 
-      /// Variables used for the transformation of the classifier prediction to
-      /// probabilities.
-      double probabilityScaling_;
-      double probabilityTranslation_;
-
-      boost::shared_ptr<PlattScaling> plattScalingPtr_;
-
-      bool usePlattScaling_;
-
       bool doPcaAnalysis_;
 
       boost::shared_ptr<PrincipalComponentAnalysis> pcaPtr_;
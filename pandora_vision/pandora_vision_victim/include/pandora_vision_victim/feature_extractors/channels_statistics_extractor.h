@@ -50,6 +50,76 @@ namespace pandora_vision
 {
 namespace pandora_vision_victim
 {
+  /**
+   * @class ChannelsStatisticsFrame
+   * @brief The planes of a whole frame whose regions go through the
+   * channels statistics, together with the integral images of the planes
+   * and of their squares. The mean and standard deviation of a plane over
+   * any region of the frame then take a few lookups instead of a pass over
+   * the region.
+   */
+  class ChannelsStatisticsFrame
+  {
+    public:
+      /**
+       * @brief Keeps a color frame, computes its HSV planes and their
+       * integral images.
+       * @param frame [const cv::Mat&] The color frame.
+       * @return void
+       */
+      void setColorFrame(const cv::Mat& frame);
+
+      /**
+       * @brief Keeps a depth frame, computes its grayscale plane and the
+       * integral images of that plane.
+       * @param frame [const cv::Mat&] The depth frame.
+       * @return void
+       */
+      void setDepthFrame(const cv::Mat& frame);
+
+      /**
+       * @brief Computes the mean and standard deviation of a plane over a
+       * region of the frame, in the order of MeanStdDevExtractor.
+       * @param plane [int] The index of the plane.
+       * @param region [const cv::Rect&] The region of the frame.
+       * @return [std::vector<double>] The mean and standard deviation
+       * vector.
+       */
+      std::vector<double> meanStdDev(int plane, const cv::Rect& region) const;
+
+      const cv::Mat& getFrame() const
+      {
+        return frame_;
+      }
+
+      const std::vector<cv::Mat>& getPlanes() const
+      {
+        return planes_;
+      }
+
+    private:
+      /**
+       * @brief Computes the integral images of the planes and of their
+       * squares.
+       * @return void
+       */
+      void computeIntegralImages();
+
+    private:
+      /// The frame the regions are taken from.
+      cv::Mat frame_;
+
+      /// The HSV planes of a color frame or the grayscale plane of a depth
+      /// frame.
+      std::vector<cv::Mat> planes_;
+
+      /// The integral image of each plane.
+      std::vector<cv::Mat> sums_;
+
+      /// The integral image of the square of each plane.
+      std::vector<cv::Mat> squareSums_;
+  };
+
   class ChannelsStatisticsExtractor
   {
     public:
@@ -74,6 +144,68 @@ namespace pandora_vision_victim
        */
       static void findDepthChannelsStatisticsFeatures(const cv::Mat& src,
           std::vector<double>* depthStatisticsVector);
+
+      /**
+       * @brief This function extracts color related statistic features from a
+       * region of a color frame. The mean and standard deviation come from
+       * the integral images of the frame, the rest of the features from the
+       * region itself, so they match those of the cropped region.
+       * @param frame [const ChannelsStatisticsFrame&] The color frame.
+       * @param region [const cv::Rect&] The region to be processed.
+       * @param colorStatisticsVector [std::vector<double>*] The color
+       * statistics vector.
+       * @return void
+       */
+      static void findColorChannelsStatisticsFeatures(
+          const ChannelsStatisticsFrame& frame, const cv::Rect& region,
+          std::vector<double>* colorStatisticsVector);
+
+      /**
+       * @brief This function extracts color related statistic features from a
+       * region of a depth frame, the way the color overload does.
+       * @param frame [const ChannelsStatisticsFrame&] The depth frame.
+       * @param region [const cv::Rect&] The region to be processed.
+       * @param depthStatisticsVector [std::vector<double>*] The depth
+       * statistics vector.
+       * @return void
+       */
+      static void findDepthChannelsStatisticsFeatures(
+          const ChannelsStatisticsFrame& frame, const cv::Rect& region,
+          std::vector<double>* depthStatisticsVector);
+
+    private:
+      /**
+       * @brief This function appends the color statistics to a feature
+       * vector, given the HSV planes of an image and their mean and standard
+       * deviation.
+       * @param rgbFrame [const cv::Mat&] The color image.
+       * @param hsvPlanes [const std::vector<cv::Mat>&] The Hue, Saturation
+       * and Value planes of the image.
+       * @param meanStd [const std::vector<std::vector<double> >&] The mean
+       * and standard deviation of each plane.
+       * @param colorStatisticsVector [std::vector<double>*] The color
+       * statistics vector.
+       * @return void
+       */
+      static void appendColorChannelsStatistics(const cv::Mat& rgbFrame,
+          const std::vector<cv::Mat>& hsvPlanes,
+          const std::vector<std::vector<double> >& meanStd,
+          std::vector<double>* colorStatisticsVector);
+
+      /**
+       * @brief This function appends the depth statistics to a feature
+       * vector, given the grayscale plane of an image and its mean and
+       * standard deviation.
+       * @param grayFrame [const cv::Mat&] The grayscale plane of the image.
+       * @param meanStd [const std::vector<double>&] The mean and standard
+       * deviation of the plane.
+       * @param depthStatisticsVector [std::vector<double>*] The depth
+       * statistics vector.
+       * @return void
+       */
+      static void appendDepthChannelsStatistics(const cv::Mat& grayFrame,
+          const std::vector<double>& meanStd,
+          std::vector<double>* depthStatisticsVector);
   };
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
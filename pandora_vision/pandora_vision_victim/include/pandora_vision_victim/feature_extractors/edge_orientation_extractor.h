@@ -65,13 +65,14 @@ namespace pandora_vision_victim
   {
     public:
       /**
-      @brief This is the function which divides the image 
-      into 16 subblocks and calls the findLocalEdgeFeatures to compute the 
-      features of the current subblock
-      @param currFrame [cv::Mat] the current subblock.
+      @brief This is the function which divides the image into subblocks
+      and computes the edge histogram features of each one of them, in a
+      single pass over the whole image
+      @param currFrame [cv::Mat] the current grayscale image.
       @param colsBlockSize [int] the cols size of the subblock.
       @param rowsBlockSize [int] the rows size of the subblock.
-      @return [std::vector<double>] the computed  80 edgeFeatures vector.
+      @return [std::vector<double>] the computed 5 edgeFeatures of each
+      subblock, subblocks ordered column by column.
       **/
       static void partition(const cv::Mat& currFrame, int colsBlockSize,
           int rowsBlockSize, std::vector<double>* localEdgeFeatures);
@@ -42,6 +42,8 @@
 #include <vector>
 #include <map>
 
+#include <stdint.h>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/filesystem.hpp>
 
@@ -77,11 +79,39 @@ namespace pandora_vision_victim
 
       /**
        * @brief This function extracts features according to the predefined
-       * feature extraction algorithms.
+       * feature extraction algorithms and keeps them as the feature vector.
        * @param inImage [const cv::Mat&] Frame to extract features from.
        * @ return void
        */
-      virtual void extractFeatures(const cv::Mat& inImage);
+      void extractFeatures(const cv::Mat& inImage);
+
+      /**
+       * @brief This function extracts features according to the predefined
+       * feature extraction algorithms. It leaves the members untouched, so
+       * several images can be processed at once unless
+       * parallelExtractionSafe() says otherwise.
+       * @param inImage [const cv::Mat&] Frame to extract features from.
+       * @param featureVector [std::vector<double>*] The extracted features.
+       * @return void
+       */
+      virtual void extractFeatures(const cv::Mat& inImage,
+          std::vector<double>* featureVector);
+
+      /**
+       * @brief This function extracts the features of several regions of a
+       * frame. By default every region is cropped and goes through
+       * extractFeatures on its own; extractors that can share work between
+       * the regions of a frame override it.
+       * @param frame [const cv::Mat&] The frame the regions belong to.
+       * @param regions [const std::vector<cv::Rect>&] The regions to extract
+       * features from.
+       * @param featureVectors [std::vector<std::vector<double> >*] The
+       * extracted features of each region.
+       * @return void
+       */
+      virtual void extractFeatures(const cv::Mat& frame,
+          const std::vector<cv::Rect>& regions,
+          std::vector<std::vector<double> >* featureVectors);
 
       /**
        * @brief
@@ -96,7 +126,10 @@ namespace pandora_vision_victim
 
       /**
        * @brief This function constructs the features matrix, i.e. the feature
-       * vectors of a set of images.
+       * vectors of a set of images. The images are processed by a pool of
+       * threads, and feature vectors are reused from the feature cache when
+       * the same region of the same image was processed before with the
+       * same configuration.
        * @param directory [const boost::filesystem::path&] The directory that
        * contains the set of images for the feature extraction.
        * @param annotationsFile [const std::string&] The name of the file that
@@ -170,6 +203,48 @@ namespace pandora_vision_victim
        */
       std::vector<cv::Mat> getBagOfWordsDescriptors() const;
 
+    protected:
+      /**
+       * @brief Reads the feature extraction threads and feature cache
+       * parameters of a classifier.
+       * @param paramFile [const std::string&] The file the parameters are
+       * read from.
+       * @param classifierNode [const cv::FileNode&] The parameters of the
+       * classifier.
+       * @return void
+       */
+      void loadExtractionParameters(const std::string& paramFile,
+          const cv::FileNode& classifierNode);
+
+      /**
+       * @brief This function checks whether several images can go through
+       * extractFeatures at once. Visualization and the Bag of Words
+       * descriptor matcher are not thread safe.
+       * @return [bool] Variable declaring whether features can be extracted
+       * in parallel or not.
+       */
+      bool parallelExtractionSafe();
+
+      /**
+       * @brief Computes the key of the feature cache for the current
+       * configuration, i.e. the chosen features, their sizes, the contents of
+       * the parameter file and the Bag of Words vocabulary.
+       * @return [uint64_t] The key of the configuration.
+       */
+      uint64_t featureConfigurationKey();
+
+    private:
+      struct ExtractionJob;
+
+      /**
+       * @brief The loop of each feature extraction thread. It claims images
+       * one at a time and writes the features of each to its row of the
+       * features matrix.
+       * @param job [ExtractionJob*] The shared state of the extraction.
+       * @return void
+       */
+      void extractionWorker(ExtractionJob* job);
+
     protected:
       /// The number of features used.
       int numFeatures_;
@@ -186,9 +261,20 @@ namespace pandora_vision_victim
       /// Dictionary size used for bag of words model.
       int dictionarySize_;
 
+      /// The number of threads extracting features from a set of images.
+      /// If 0, the hardware concurrency is used.
+      int numExtractionThreads_;
+
+      /// Flag indicating whether extracted features are kept in a cache file
+      /// and reused.
+      bool useFeatureCache_;
+
       /// String containing the package path.
       std::string packagePath_;
 
+      /// The file the feature extraction parameters are read from.
+      std::string paramFile_;
+
       /// String indicating the type of the processed images.
       std::string imageType_;
 
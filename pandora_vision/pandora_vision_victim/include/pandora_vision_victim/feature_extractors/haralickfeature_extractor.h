@@ -50,6 +50,54 @@ namespace pandora_vision_victim
   class HaralickFeaturesExtractor
   {
     public:
+      /// The number of gray levels of the GLCM matrices
+      static const int NUM_GRAY_LEVELS = 256;
+
+      /// The number of directions over which the features are averaged
+      static const int NUM_DIRECTIONS = 4;
+
+      /// The number of Haralick features of each direction
+      static const int NUM_HARALICK_FEATURES = 13;
+
+      /**
+       * @brief The co-occurrence counts of the gray levels of an image,
+       * for each one of the directions of findHaralickFeatures. The counts
+       * are symmetric with respect to the main diagonal.
+       */
+      struct GLCMCounts
+      {
+        GLCMCounts();
+
+        /// The counts of each direction, indexed by row * 256 + column
+        std::vector<unsigned int> counts[NUM_DIRECTIONS];
+        /// The indices of the non-zero counts of each direction
+        std::vector<int> nonZero[NUM_DIRECTIONS];
+        /// The sum of the counts of each direction
+        unsigned int total[NUM_DIRECTIONS];
+      };
+
+      /**
+       * @brief Function for calculating the co-occurrence counts of all
+       * directions in a single pass over the image.
+       * @param in [cv::Mat&] A grayscale image with 8 bit values.
+       * @param glcm [GLCMCounts*] The counts, which must be empty.
+       * @return void
+       */
+      static void calculateGLCMCounts(const cv::Mat& in, GLCMCounts* glcm);
+
+      /**
+       * @brief Function for calculating all the Haralick features of a
+       * direction in a single sweep over its non-zero co-occurrence counts.
+       * The features are those of the getX functions below, in the order
+       * of findHaralickFeatures.
+       * @param glcm [GLCMCounts&] The co-occurrence counts
+       * @param direction [int] The direction
+       * @param features [double*] The NUM_HARALICK_FEATURES features
+       * @return void
+       */
+      static void getHaralickStatistics(const GLCMCounts& glcm, int direction,
+          double* features);
+
       /**
        * @brief Function for calculating the normalized GLCM matrix.
        * The returned matrix is symmetric with respect to the main diagonal.
@@ -40,6 +40,7 @@
 
 
 #include <string>
+#include <vector>
 
 #include "pandora_vision_victim/feature_extractors/feature_extraction.h"
 #include "pandora_vision_victim/feature_extractors/channels_statistics_extractor.h"
@@ -75,9 +76,44 @@ namespace pandora_vision_victim
        * @brief This function extracts features from RGB images according to
        * a predefined set of feature extraction algorithms.
        * @param inImage [const cv::Mat&] RGB frame to extract features from.
+       * @param featureVector [std::vector<double>*] The extracted features.
        * @return void
        */
-      virtual void extractFeatures(const cv::Mat& inImage);
+      virtual void extractFeatures(const cv::Mat& inImage,
+          std::vector<double>* featureVector);
+
+      /**
+       * @brief This function extracts features from several regions of a
+       * RGB frame. The channels statistics of the regions come from the
+       * integral images of the whole frame, the rest of the features from
+       * each cropped region.
+       * @param frame [const cv::Mat&] The frame the regions belong to.
+       * @param regions [const std::vector<cv::Rect>&] The regions to extract
+       * features from.
+       * @param featureVectors [std::vector<std::vector<double> >*] The
+       * extracted features of each region.
+       * @return void
+       */
+      virtual void extractFeatures(const cv::Mat& frame,
+          const std::vector<cv::Rect>& regions,
+          std::vector<std::vector<double> >* featureVectors);
+
+      using FeatureExtraction::extractFeatures;
+
+    private:
+      /**
+       * @brief This function extracts features from a RGB image, using the
+       * given channels statistics if there are any.
+       * @param inImage [const cv::Mat&] RGB frame to extract features from.
+       * @param channelsStatisticsFeatureVector [const std::vector<double>*]
+       * The channels statistics of the image, or NULL if they are to be
+       * computed from the image.
+       * @param featureVector [std::vector<double>*] The extracted features.
+       * @return void
+       */
+      void extractRegionFeatures(const cv::Mat& inImage,
+          const std::vector<double>* channelsStatisticsFeatureVector,
+          std::vector<double>* featureVector);
   };
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
@@ -0,0 +1,152 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_VICTIM_UTILITIES_BINARY_MODEL_FILE_H
+#define PANDORA_VISION_VICTIM_UTILITIES_BINARY_MODEL_FILE_H
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * @namespace pandora_vision
+ * @brief The main namespace for PANDORA vision
+ */
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+   * @class BinaryModelFile
+   * @brief A binary file of named matrices, the compact counterpart of the
+   * FileStorage files that hold the parameters of the victim models. The
+   * file starts with a versioned header, and every matrix is stored as a
+   * small entry header followed by its continuous data, aligned to 8 bytes.
+   * The file is memory mapped when it is opened, and its matrices are
+   * returned as headers over the mapping, so they are used in place.
+   */
+  class BinaryModelFile
+  {
+    public:
+      /**
+       * @brief Maps the file and indexes its matrices, if it is a binary
+       * model file of a version that can be read.
+       * @param fileName [const std::string&] The path of the file.
+       */
+      explicit BinaryModelFile(const std::string& fileName);
+
+      /**
+       * @brief Destructor. Unmaps the file.
+       */
+      ~BinaryModelFile();
+
+      /**
+       * @brief Whether the file was mapped and indexed successfully.
+       */
+      bool isOpen() const
+      {
+        return mapping_ != NULL;
+      }
+
+      /**
+       * @brief Returns a matrix of the file. The matrix refers to the
+       * mapped file, so it must not outlive this object and must not be
+       * written to; clone it to keep it.
+       * @param name [const std::string&] The name of the matrix.
+       * @return [cv::Mat] The matrix, or an empty matrix if the file has no
+       * matrix with this name.
+       */
+      cv::Mat matrix(const std::string& name) const;
+
+      /**
+       * @brief Writes a set of matrices to a binary model file. The file is
+       * written under a temporary name and renamed into place, so that a
+       * reader never maps a half written file.
+       * @param fileName [const std::string&] The path of the file.
+       * @param nameVec [const std::vector<std::string>&] The names of the
+       * matrices.
+       * @param matVec [const std::vector<cv::Mat>&] The matrices.
+       * @return [bool] Whether the file was written successfully.
+       */
+      static bool write(const std::string& fileName,
+          const std::vector<std::string>& nameVec,
+          const std::vector<cv::Mat>& matVec);
+
+      /**
+       * @brief Checks whether a file starts with the header of a binary
+       * model file.
+       * @param fileName [const std::string&] The path of the file.
+       * @return [bool] Whether the file is a binary model file.
+       */
+      static bool isBinaryModelFile(const std::string& fileName);
+
+      /**
+       * @brief Returns the name of the binary counterpart of a FileStorage
+       * file, i.e. the same name with a .bin extension.
+       * @param fileName [const std::string&] The path of the FileStorage
+       * file.
+       * @return [std::string] The path of the binary model file.
+       */
+      static std::string binaryFileName(const std::string& fileName);
+
+    private:
+      /**
+       * @brief Unmaps the file and clears its index.
+       * @return void
+       */
+      void unmap();
+
+      // Matrices refer to the mapping, so the file is not copyable.
+      BinaryModelFile(const BinaryModelFile&);
+      BinaryModelFile& operator=(const BinaryModelFile&);
+
+    private:
+      /// The mapped file and its size in bytes.
+      void* mapping_;
+      size_t mappingSize_;
+
+      /// The matrices of the mapped file, by name.
+      std::map<std::string, cv::Mat> index_;
+  };
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
+#endif  // PANDORA_VISION_VICTIM_UTILITIES_BINARY_MODEL_FILE_H
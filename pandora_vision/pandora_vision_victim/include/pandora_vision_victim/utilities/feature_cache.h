@@ -0,0 +1,172 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_VICTIM_UTILITIES_FEATURE_CACHE_H
+#define PANDORA_VISION_VICTIM_UTILITIES_FEATURE_CACHE_H
+
+#include <stdint.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/unordered_map.hpp>
+
+/**
+ * @namespace pandora_vision
+ * @brief The main namespace for PANDORA vision
+ */
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+   * @class FeatureCache
+   * @brief A binary file of feature vectors, addressed by a hash of the
+   * content they were extracted from. The file is memory mapped when it is
+   * opened, so lookups copy straight from the page cache, and it is only
+   * valid for the extractor configuration it was written with.
+   */
+  class FeatureCache
+  {
+    public:
+      /**
+       * @brief Opens the cache file, if it exists and was written with the
+       * same configuration and feature vector size.
+       * @param fileName [const std::string&] The path of the cache file.
+       * @param configurationKey [uint64_t] A hash of the extractor
+       * configuration that produced the feature vectors.
+       * @param numFeatures [int] The size of the feature vectors.
+       */
+      FeatureCache(const std::string& fileName, uint64_t configurationKey,
+          int numFeatures);
+
+      /**
+       * @brief Destructor. Unmaps the cache file.
+       */
+      ~FeatureCache();
+
+      /**
+       * @brief Computes the 64 bit FNV-1a hash of a block of memory.
+       * @param data [const void*] The block of memory.
+       * @param size [size_t] Its size in bytes.
+       * @param seed [uint64_t] The hash to continue from, so that several
+       * blocks can be hashed as one.
+       * @return [uint64_t] The hash.
+       */
+      static uint64_t hash(const void* data, size_t size,
+          uint64_t seed = 14695981039346656037ULL);
+
+      /**
+       * @brief Copies the feature vector stored under a key. Safe to call
+       * from several threads at once.
+       * @param key [uint64_t] The key of the feature vector.
+       * @param featureVector [double*] Where the numFeatures values of the
+       * feature vector are copied to.
+       * @return [bool] Whether the key was found in the cache file.
+       */
+      bool find(uint64_t key, double* featureVector) const;
+
+      /**
+       * @brief Stores a feature vector, to be written by the next save().
+       * Safe to call from several threads at once.
+       * @param key [uint64_t] The key of the feature vector.
+       * @param featureVector [const std::vector<double>&] The feature
+       * vector. It is ignored unless it has numFeatures values.
+       * @return void
+       */
+      void insert(uint64_t key, const std::vector<double>& featureVector);
+
+      /**
+       * @brief Rewrites the cache file with the mapped and the inserted
+       * feature vectors and maps it again.
+       * @return [bool] Whether the file was written successfully.
+       */
+      bool save();
+
+      /**
+       * @brief The number of feature vectors in the cache file.
+       */
+      int size() const
+      {
+        return index_.size();
+      }
+
+    private:
+      /**
+       * @brief Maps the cache file and indexes its records, unless it
+       * belongs to another configuration.
+       * @return void
+       */
+      void map();
+
+      /**
+       * @brief Unmaps the cache file and clears its index.
+       * @return void
+       */
+      void unmap();
+
+    private:
+      /// The path of the cache file.
+      std::string fileName_;
+
+      /// The hash of the extractor configuration.
+      uint64_t configurationKey_;
+
+      /// The size of the feature vectors.
+      int numFeatures_;
+
+      /// The mapped cache file and its size in bytes.
+      void* mapping_;
+      size_t mappingSize_;
+
+      /// The feature vectors of the mapped file, by key.
+      boost::unordered_map<uint64_t, const double*> index_;
+
+      /// Guards the inserted feature vectors.
+      boost::mutex mutex_;
+
+      /// The keys and values of the inserted feature vectors.
+      std::vector<uint64_t> insertedKeys_;
+      std::vector<double> insertedValues_;
+  };
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
+#endif  // PANDORA_VISION_VICTIM_UTILITIES_FEATURE_CACHE_H
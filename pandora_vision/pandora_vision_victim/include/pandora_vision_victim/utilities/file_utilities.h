@@ -49,12 +49,15 @@
 #include <boost/lambda/bind.hpp>
 #include <boost/algorithm/string.hpp>
 #include <boost/filesystem.hpp>
+#include <boost/shared_ptr.hpp>
 
 #include <opencv2/opencv.hpp>
 
 #include <ros/ros.h>
 #include <ros/package.h>
 
+#include "pandora_vision_victim/utilities/binary_model_file.h"
+
 /**
  * @namespace pandora_vision
  * @brief The main namespace for PANDORA vision
@@ -110,6 +113,72 @@ namespace file_utilities
                  const cv::Mat& featuresMat,
                  const cv::Mat& labelsMat);
 
+  /**
+   * @brief Function that saves a matrix to a binary model file.
+   * @param fileName [const std::string&] The name of the file to be created.
+   * @param varName [const std::string&] The name of the matrix.
+   * @param src [const cv::Mat&] The matrix to be saved.
+   * @return [bool] Variable indicating whether the saving was successful or
+   * not.
+   */
+  bool saveMatToBinaryFile(const std::string& fileName,
+                           const std::string& varName,
+                           const cv::Mat& src);
+
+  /**
+   * @brief Function that saves a set of model parameters both in a
+   * FileStorage file and in its binary counterpart, i.e. the file with the
+   * same name and a .bin extension.
+   * @param fileName [const std::string&] The name of the FileStorage file to
+   * be created.
+   * @param varNameVec [const std::vector<std::string>&] The names of the
+   * matrices to be saved.
+   * @param dataVec [const std::vector<cv::Mat>&] The matrices to be saved.
+   * @return void
+   */
+  void saveModelToFile(const std::string& fileName,
+      const std::vector<std::string>& varNameVec,
+      const std::vector<cv::Mat>& dataVec);
+
+  /**
+   * @brief Function that loads a set of model parameters from a binary model
+   * file, without parsing. The given file is used if it is a binary model
+   * file itself; otherwise its binary counterpart is used, as long as it is
+   * at least as recent as the given file. The loaded matrices refer to the
+   * mapped file, which the caller keeps for as long as it uses them.
+   * @param fileName [const std::string&] The name of the file to be loaded.
+   * @param varNameVec [const std::vector<std::string>&] The names of the
+   * matrices to be loaded.
+   * @param dataVec [std::vector<cv::Mat>*] The loaded matrices.
+   * @param modelFilePtr [boost::shared_ptr<BinaryModelFile>*] The mapped
+   * binary model file, or NULL if none was loaded.
+   * @return [bool] Variable indicating whether a binary model file with all
+   * the matrices was found or not.
+   */
+  bool loadModelFromBinaryFile(const std::string& fileName,
+      const std::vector<std::string>& varNameVec,
+      std::vector<cv::Mat>* dataVec,
+      boost::shared_ptr<BinaryModelFile>* modelFilePtr);
+
+  /**
+   * @brief Function that loads a set of model parameters, from a binary
+   * model file if loadModelFromBinaryFile finds one and from the given
+   * FileStorage file otherwise.
+   * @param fileName [const std::string&] The name of the file to be loaded.
+   * @param varNameVec [const std::vector<std::string>&] The names of the
+   * matrices to be loaded.
+   * @param dataVec [std::vector<cv::Mat>*] The loaded matrices.
+   * @param modelFilePtr [boost::shared_ptr<BinaryModelFile>*] The mapped
+   * binary model file the matrices refer to, or NULL if they were read from
+   * the FileStorage file.
+   * @return [bool] Variable indicating whether all the matrices were found
+   * or not.
+   */
+  bool loadModelFromFile(const std::string& fileName,
+      const std::vector<std::string>& varNameVec,
+      std::vector<cv::Mat>* dataVec,
+      boost::shared_ptr<BinaryModelFile>* modelFilePtr);
+
   /**
    * @brief Function that loads a set of descriptors to be used for training.
    * @param dataMatFile [const std::string&] The name of the file to read the
@@ -125,14 +194,18 @@ namespace file_utilities
       std::vector<cv::Mat>* descriptorsVec);
 
   /**
-  @brief Function that loads the necessary files for the training
+  @brief Function that loads the necessary files for the training, either
+  from FileStorage or from binary model files
   @param [std::string] training_mat_file, name of the file that contains the training data
   @param [std::string] labels_mat_file, name of the file that contains the labels of each class
   of the training data
+  @param [boost::shared_ptr<BinaryModelFile>*] modelFilePtr, the mapped binary model file the
+  loaded matrix may refer to. If it is NULL, the matrix never refers to a mapped file.
   @return void
   **/
   cv::Mat loadFiles(const std::string& dataMatFile,
-                    const std::string& nameTag);
+                    const std::string& nameTag,
+                    boost::shared_ptr<BinaryModelFile>* modelFilePtr = NULL);
 
   /**
   @brief Function that checks if a file exists
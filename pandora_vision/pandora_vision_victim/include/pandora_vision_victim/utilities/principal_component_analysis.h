@@ -42,6 +42,9 @@
 #include <vector>
 
 #include <opencv2/opencv.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "pandora_vision_victim/utilities/binary_model_file.h"
 
 /**
  * @namespace pandora_vision
@@ -111,6 +114,9 @@ namespace pandora_vision_victim
       void load(const std::string& fileName);
     private:
       cv::PCA pca_;
+
+      /// The binary model file the loaded principal components refer to.
+      boost::shared_ptr<BinaryModelFile> modelFile_;
   };
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
@@ -0,0 +1,121 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#ifndef PANDORA_VISION_VICTIM_UTILITIES_SVM_MODEL_H
+#define PANDORA_VISION_VICTIM_UTILITIES_SVM_MODEL_H
+
+#include <string>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "pandora_vision_victim/utilities/binary_model_file.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+   * @class SvmModel
+   * @brief An OpenCV SVM classifier that also exposes the state CvSVM
+   * keeps to itself, i.e. its class labels, and that can be stored in a
+   * binary model file. A model loaded from a binary model file uses its
+   * support vectors and decision functions in place, so it can predict but
+   * must not be trained again.
+   */
+  class SvmModel : public CvSVM
+  {
+    public:
+      /**
+       * @brief This function saves the model in a FileStorage file and, if
+       * it is a classifier over all the variables, in its binary
+       * counterpart, i.e. the file with the same name and a .bin extension.
+       * @param fileName [const std::string&] The name of the FileStorage
+       * file.
+       * @return void
+       */
+      void saveModel(const std::string& fileName) const;
+
+      /**
+       * @brief This function loads the model from the binary counterpart of
+       * a FileStorage file, if file_utilities::loadModelFromBinaryFile
+       * finds one, and from the FileStorage file otherwise. The prediction
+       * is still done by CvSVM.
+       * @param fileName [const std::string&] The name of the FileStorage
+       * file.
+       * @return void
+       */
+      void loadModel(const std::string& fileName);
+
+      /**
+       * @brief This function computes the decision function value of each
+       * row of a set of feature vectors, and derives its class label from
+       * the sign of that value, the way CvSVM::predict does for two classes.
+       * The linear, polynomial and RBF kernels of all the rows are evaluated
+       * against all the support vectors at once; other kernels fall back to
+       * CvSVM::predict for each row.
+       * @param samples [const cv::Mat&] The feature vectors, one per row.
+       * @param classLabels [std::vector<float>*] The predicted class labels.
+       * @param decisionValues [cv::Mat*] The decision function values, a
+       * CV_64FC1 column.
+       * @return void
+       */
+      void predictDecisionValues(const cv::Mat& samples,
+          std::vector<float>* classLabels, cv::Mat* decisionValues) const;
+
+    private:
+      /**
+       * @brief This function rebuilds the model from the matrices of a
+       * binary model file.
+       * @param dataVec [const std::vector<cv::Mat>&] The matrices, in the
+       * order of the model's names.
+       * @return [bool] Variable indicating whether the matrices hold a valid
+       * model or not.
+       */
+      bool setModel(const std::vector<cv::Mat>& dataVec);
+
+    private:
+      /// The binary model file the support vectors and the decision
+      /// functions refer to.
+      boost::shared_ptr<BinaryModelFile> modelFile_;
+  };
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
+#endif  // PANDORA_VISION_VICTIM_UTILITIES_SVM_MODEL_H
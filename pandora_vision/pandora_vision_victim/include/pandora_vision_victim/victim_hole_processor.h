@@ -64,6 +64,19 @@ namespace pandora_vision_victim
       virtual bool process(const EnhancedImageStampedConstPtr& input,
         const POIsStampedPtr& output);
 
+      /**
+      @brief Advertises the debug images again when the handler makes the
+      processor a stage again
+      @return void
+      **/
+      virtual void activate();
+
+      /**
+      @brief Unadvertises the debug images while the processor is parked
+      @return void
+      **/
+      virtual void park();
+
     private:
       /**
       @brief This method check in which state we are, according to
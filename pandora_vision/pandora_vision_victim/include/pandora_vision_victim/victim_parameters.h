@@ -94,8 +94,9 @@ namespace pandora_vision_victim
 
   struct DetectionImages
   {
-    // EnhancedMat rgb;
-    // EnhancedMat depth;
+    /// The whole frames the masks are taken from.
+    EnhancedMat rgb;
+    EnhancedMat depth;
     std::vector<EnhancedMat> rgbMasks;
     std::vector<EnhancedMat> depthMasks;
   };
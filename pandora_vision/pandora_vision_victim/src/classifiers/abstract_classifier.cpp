@@ -72,10 +72,10 @@ namespace pandora_vision_victim
     filesDirectory_ = packagePath_ + "/data/";
 
     const std::string filePrefix = filesDirectory_ + imageType_ + "_";
-    trainingFeaturesMatrixFile_ = filePrefix + "training_features_matrix.xml";
-    testFeaturesMatrixFile_ = filePrefix + "test_features_matrix.xml";
-    trainingLabelsMatrixFile_ = filePrefix + "training_labels_matrix.xml";
-    testLabelsMatrixFile_ = filePrefix + "test_labels_matrix.xml";
+    trainingFeaturesMatrixFile_ = filePrefix + "training_features_matrix.bin";
+    testFeaturesMatrixFile_ = filePrefix + "test_features_matrix.bin";
+    trainingLabelsMatrixFile_ = filePrefix + "training_labels_matrix.bin";
+    testLabelsMatrixFile_ = filePrefix + "test_labels_matrix.bin";
     resultsFile_ = filePrefix + classifierType_ + "_results.xml";
     classifierFile_ = filePrefix + classifierType_ +  "_classifier.xml";
 
@@ -211,12 +211,12 @@ namespace pandora_vision_victim
     std::string normalizationParamOnePath = filesDirectory_ + normalizationParamOne;
     std::string normalizationParamTwoPath = filesDirectory_ + normalizationParamTwo;
 
-    file_utilities::saveToFile(normalizationParamOnePath,
-        normalizationParamOneTag,
-        cv::Mat(normalizationParamOneVector));
-    file_utilities::saveToFile(normalizationParamTwoPath,
-        normalizationParamTwoTag,
-        cv::Mat(normalizationParamTwoVector));
+    file_utilities::saveModelToFile(normalizationParamOnePath,
+        std::vector<std::string>(1, normalizationParamOneTag),
+        std::vector<cv::Mat>(1, cv::Mat(normalizationParamOneVector)));
+    file_utilities::saveModelToFile(normalizationParamTwoPath,
+        std::vector<std::string>(1, normalizationParamTwoTag),
+        std::vector<cv::Mat>(1, cv::Mat(normalizationParamTwoVector)));
   }
 
   /**
@@ -391,6 +391,9 @@ namespace pandora_vision_victim
     cv::Mat trainingLabelsMat = cv::Mat::zeros(numTrainingFiles, 1, CV_64FC1);
     cv::Mat testFeaturesMat = cv::Mat::zeros(numTestFiles, numFeatures_, CV_64FC1);
     cv::Mat testLabelsMat = cv::Mat::zeros(numTestFiles, 1, CV_64FC1);
+    // The binary files the loaded matrices refer to.
+    boost::shared_ptr<BinaryModelFile> trainingFeaturesFile, trainingLabelsFile;
+    boost::shared_ptr<BinaryModelFile> testFeaturesFile, testLabelsFile;
 
     if (loadClassifierModel_ && file_utilities::exist(classifierFile_.c_str()))
     {
@@ -426,16 +429,18 @@ namespace pandora_vision_victim
           std::cout << "Save bag of words vocabulary" << std::endl;
           const std::string bagOfWordsFile = imageType_ + "_" + classifierType_ + "_bag_of_words.xml";
           const std::string bagOfWordsFilePath = filesDirectory_ + bagOfWordsFile;
-          file_utilities::saveToFile(bagOfWordsFilePath, "bag_of_words",
-              featureExtraction_[imageType_]->getBagOfWordsVocabulary());
+          file_utilities::saveModelToFile(bagOfWordsFilePath,
+              std::vector<std::string>(1, "bag_of_words"),
+              std::vector<cv::Mat>(1,
+                featureExtraction_[imageType_]->getBagOfWordsVocabulary()));
         }
       }
       else
       {
         trainingFeaturesMat = file_utilities::loadFiles(
-            trainingFeaturesMatrixFile_, "training_features_mat");
+            trainingFeaturesMatrixFile_, "training_features_mat", &trainingFeaturesFile);
         trainingLabelsMat = file_utilities::loadFiles(
-            trainingLabelsMatrixFile_, "training_labels_mat");
+            trainingLabelsMatrixFile_, "training_labels_mat", &trainingLabelsFile);
       }
 
       // Start Training Process
@@ -466,9 +471,9 @@ namespace pandora_vision_victim
     else
     {
       testFeaturesMat = file_utilities::loadFiles(
-          testFeaturesMatrixFile_, "test_features_mat");
+          testFeaturesMatrixFile_, "test_features_mat", &testFeaturesFile);
       testLabelsMat = file_utilities::loadFiles(
-          testLabelsMatrixFile_, "test_labels_mat");
+          testLabelsMatrixFile_, "test_labels_mat", &testLabelsFile);
     }
 
     cv::Mat results = cv::Mat::zeros(numTestFiles, 1, CV_32FC1);
@@ -36,6 +36,7 @@
  *   Kofinas Miltiadis <mkofinas@gmail.com>
  *********************************************************************/
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -92,6 +93,9 @@ namespace pandora_vision_victim
 
     cv::FileNode classifierNode = fs[classifierType_];
     typeOfNormalization_ = static_cast<int>(classifierNode["type_of_normalization"]);
+    probabilityScaling_ = 1.0;
+    probabilityTranslation_ = 0.0;
+    usePlattScaling_ = false;
 
     fs.release();
 
@@ -202,57 +206,144 @@ namespace pandora_vision_victim
   void AbstractValidator::calculatePredictionProbability(const cv::Mat& inImage,
       float* classLabel, float* probability)
   {
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracting features");
-    extractFeatures(inImage);
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracted Features");
-    if (!featureVector_.empty())
-      featureVector_.clear();
-    featureVector_ = featureExtraction_[imageType_]->getFeatureVector();
-
-    cv::Mat featuresMat = cv::Mat(featureVector_);
-    // Make features matrix a row vector.
-    if (featuresMat.cols == 1)
-      transpose(featuresMat, featuresMat);
-    /// Normalize the data
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Normalize features");
-    if (typeOfNormalization_ == 1)
+    std::vector<cv::Mat> images(1, inImage);
+    std::vector<float> classLabels, probabilities;
+    calculatePredictionProbabilities(images, &classLabels, &probabilities);
+    *classLabel = classLabels[0];
+    *probability = probabilities[0];
+  }
+
+  void AbstractValidator::calculatePredictionProbability(const cv::Mat& rgbImage,
+      const cv::Mat& depthImage, float* classLabel, float* probability)
+  {
+    std::vector<cv::Mat> rgbImages(1, rgbImage);
+    std::vector<cv::Mat> depthImages(1, depthImage);
+    std::vector<float> classLabels, probabilities;
+    calculatePredictionProbabilities(rgbImages, depthImages, &classLabels,
+        &probabilities);
+    *classLabel = classLabels[0];
+    *probability = probabilities[0];
+  }
+
+  void AbstractValidator::calculatePredictionProbabilities(
+      const std::vector<cv::Mat>& images,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
+  {
+    classLabels->clear();
+    probabilities->clear();
+    if (images.empty())
+      return;
+
+    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracting features of "
+        << images.size() << " images");
+    cv::Mat featuresMat;
+    for (int ii = 0; ii < images.size(); ii++)
     {
-      double newMin = -1.0;
-      double newMax = 1.0;
-      featureExtractionUtilities_->performMinMaxNormalization(newMax, newMin,
-          &featuresMat, normalizationParamOneVec_, normalizationParamTwoVec_);
+      featureExtraction_[imageType_]->extractFeatures(images[ii], &featureVector_);
+      setFeatures(featureVector_, ii, 0, images.size(), 0, &featuresMat);
     }
-    else if (typeOfNormalization_ == 2)
+    classifyFeatures(&featuresMat, classLabels, probabilities);
+  }
+
+  void AbstractValidator::calculatePredictionProbabilities(
+      const std::vector<cv::Mat>& rgbImages,
+      const std::vector<cv::Mat>& depthImages,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
+  {
+    classLabels->clear();
+    probabilities->clear();
+    if (rgbImages.empty() || rgbImages.size() != depthImages.size())
+      return;
+
+    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracting features of "
+        << rgbImages.size() << " image pairs");
+    cv::Mat featuresMat;
+    std::vector<double> depthFeatureVector;
+    for (int ii = 0; ii < rgbImages.size(); ii++)
     {
-      featureExtractionUtilities_->performZScoreNormalization(
-          &featuresMat, normalizationParamOneVec_, normalizationParamTwoVec_);
+      featureExtraction_["rgb"]->extractFeatures(rgbImages[ii], &featureVector_);
+      featureExtraction_["depth"]->extractFeatures(depthImages[ii],
+          &depthFeatureVector);
+      int numRgbFeatures = featureVector_.size();
+      int numFeatures = numRgbFeatures + depthFeatureVector.size();
+      setFeatures(featureVector_, ii, 0, rgbImages.size(), numFeatures,
+          &featuresMat);
+      setFeatures(depthFeatureVector, ii, numRgbFeatures, rgbImages.size(),
+          numFeatures, &featuresMat);
     }
+    classifyFeatures(&featuresMat, classLabels, probabilities);
+  }
 
-    featuresMat.convertTo(featuresMat, CV_32FC1);
+  void AbstractValidator::calculatePredictionProbabilities(
+      const cv::Mat& frame, const std::vector<cv::Rect>& regions,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
+  {
+    classLabels->clear();
+    probabilities->clear();
+    if (regions.empty())
+      return;
 
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Predict image class and probability");
-    predict(featuresMat, classLabel, probability);
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Class Label = " << *classLabel);
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Probability = " << *probability);
+    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracting features of "
+        << regions.size() << " regions");
+    std::vector<std::vector<double> > featureVectors;
+    featureExtraction_[imageType_]->extractFeatures(frame, regions,
+        &featureVectors);
+    cv::Mat featuresMat;
+    for (int ii = 0; ii < featureVectors.size(); ii++)
+      setFeatures(featureVectors[ii], ii, 0, featureVectors.size(), 0,
+          &featuresMat);
+    classifyFeatures(&featuresMat, classLabels, probabilities);
   }
 
-  void AbstractValidator::calculatePredictionProbability(const cv::Mat& rgbImage,
-      const cv::Mat& depthImage, float* classLabel, float* probability)
+  void AbstractValidator::calculatePredictionProbabilities(
+      const cv::Mat& rgbFrame, const cv::Mat& depthFrame,
+      const std::vector<cv::Rect>& regions,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
+  {
+    classLabels->clear();
+    probabilities->clear();
+    if (regions.empty())
+      return;
+
+    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracting features of "
+        << regions.size() << " region pairs");
+    std::vector<std::vector<double> > rgbFeatureVectors, depthFeatureVectors;
+    featureExtraction_["rgb"]->extractFeatures(rgbFrame, regions,
+        &rgbFeatureVectors);
+    featureExtraction_["depth"]->extractFeatures(depthFrame, regions,
+        &depthFeatureVectors);
+    cv::Mat featuresMat;
+    for (int ii = 0; ii < regions.size(); ii++)
+    {
+      int numRgbFeatures = rgbFeatureVectors[ii].size();
+      int numFeatures = numRgbFeatures + depthFeatureVectors[ii].size();
+      setFeatures(rgbFeatureVectors[ii], ii, 0, regions.size(), numFeatures,
+          &featuresMat);
+      setFeatures(depthFeatureVectors[ii], ii, numRgbFeatures, regions.size(),
+          numFeatures, &featuresMat);
+    }
+    classifyFeatures(&featuresMat, classLabels, probabilities);
+  }
+
+  void AbstractValidator::setFeatures(const std::vector<double>& featureVector,
+      int row, int col, int numRows, int numCols, cv::Mat* featuresMat)
+  {
+    if (featuresMat->empty())
+    {
+      if (numCols == 0)
+        numCols = featureVector.size();
+      *featuresMat = cv::Mat::zeros(numRows, numCols, CV_64FC1);
+    }
+    double* featuresRow = featuresMat->ptr<double>(row) + col;
+    int numFeatures = std::min(static_cast<int>(featureVector.size()),
+        featuresMat->cols - col);
+    std::copy(featureVector.begin(), featureVector.begin() + numFeatures,
+        featuresRow);
+  }
+
+  void AbstractValidator::classifyFeatures(cv::Mat* featuresMat,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
   {
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracting features");
-    extractFeatures(rgbImage, "rgb");
-    extractFeatures(depthImage, "depth");
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Extracted Features");
-    if (!featureVector_.empty())
-      featureVector_.clear();
-    featureVector_ = featureExtraction_["rgb"]->getFeatureVector();
-    std::vector<double> depthFeatureVector = featureExtraction_["depth"]->getFeatureVector();
-    featureVector_.insert(featureVector_.end(), depthFeatureVector.begin(), depthFeatureVector.end());
-
-    cv::Mat featuresMat = cv::Mat(featureVector_);
-    // Make features matrix a row vector.
-    if (featuresMat.cols == 1)
-      transpose(featuresMat, featuresMat);
     /// Normalize the data
     ROS_INFO_STREAM(nodeMessagePrefix_ << ": Normalize features");
     if (typeOfNormalization_ == 1)
@@ -260,20 +351,57 @@ namespace pandora_vision_victim
       double newMin = -1.0;
       double newMax = 1.0;
       featureExtractionUtilities_->performMinMaxNormalization(newMax, newMin,
-          &featuresMat, normalizationParamOneVec_, normalizationParamTwoVec_);
+          featuresMat, normalizationParamOneVec_, normalizationParamTwoVec_);
     }
     else if (typeOfNormalization_ == 2)
     {
       featureExtractionUtilities_->performZScoreNormalization(
-          &featuresMat, normalizationParamOneVec_, normalizationParamTwoVec_);
+          featuresMat, normalizationParamOneVec_, normalizationParamTwoVec_);
     }
 
-    featuresMat.convertTo(featuresMat, CV_32FC1);
+    featuresMat->convertTo(*featuresMat, CV_32FC1);
 
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Predict image class and probability");
-    predict(featuresMat, classLabel, probability);
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Class Label = " << *classLabel);
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Probability = " << *probability);
+    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Predict image classes and probabilities");
+    predict(*featuresMat, classLabels, probabilities);
+    for (int ii = 0; ii < classLabels->size(); ii++)
+    {
+      ROS_INFO_STREAM(nodeMessagePrefix_ << ": Class Label = " << (*classLabels)[ii]
+          << ", Probability = " << (*probabilities)[ii]);
+    }
+  }
+
+  void AbstractValidator::predict(const cv::Mat& featuresMat,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
+  {
+    classLabels->resize(featuresMat.rows);
+    probabilities->resize(featuresMat.rows);
+    for (int ii = 0; ii < featuresMat.rows; ii++)
+      predict(featuresMat.row(ii), &(*classLabels)[ii], &(*probabilities)[ii]);
+  }
+
+  void AbstractValidator::transformPredictionsToProbabilities(const cv::Mat& predictions,
+      const std::vector<float>& classLabels, std::vector<float>* probabilities)
+  {
+    cv::Mat absPredictions = cv::abs(predictions);
+    if (usePlattScaling_)
+    {
+      for (int ii = 0; ii < absPredictions.rows; ii++)
+        absPredictions.at<double>(ii) *= classLabels[ii];
+      *probabilities = plattScalingPtr_->sigmoidPredict(absPredictions);
+    }
+    else
+    {
+      probabilities->resize(absPredictions.rows);
+      for (int ii = 0; ii < absPredictions.rows; ii++)
+      {
+        // Normalize probability to [-1,1]
+        float probability = static_cast<float>(std::tanh(
+            probabilityScaling_ * absPredictions.at<double>(ii) -
+            probabilityTranslation_));
+        // Normalize probability to [0,1]
+        (*probabilities)[ii] = (1.0f + probability) / 2.0f;
+      }
+    }
   }
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
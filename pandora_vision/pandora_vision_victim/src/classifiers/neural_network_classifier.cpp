@@ -186,7 +186,7 @@ namespace pandora_vision_victim
       cv::TermCriteria(CV_TERMCRIT_ITER + CV_TERMCRIT_EPS, maxIter, epsilon);
 
     // Initialize the pointer to the Neural Network Classifier object.
-    classifierPtr_.reset(new CvANN_MLP());
+    classifierPtr_.reset(new NeuralNetworkModel());
 
     // Create the Neural Network with the specified topology.
     classifierPtr_->create(layerSizes, CvANN_MLP::SIGMOID_SYM,
@@ -229,7 +229,7 @@ namespace pandora_vision_victim
 
     classifierPtr_->train(trainingSetFeatures, trainingSetLabels,
         cv::Mat(), cv::Mat(), NeuralNetworkParams_, CvANN_MLP::NO_INPUT_SCALE + CvANN_MLP::NO_OUTPUT_SCALE);
-    classifierPtr_->save(classifierFileDest.c_str());
+    classifierPtr_->saveModel(classifierFileDest);
     return true;
   }
 
@@ -37,6 +37,7 @@
  *********************************************************************/
 
 #include <string>
+#include <vector>
 
 #include <ros/console.h>
 
@@ -64,7 +65,7 @@ namespace pandora_vision_victim
     ROS_INFO_STREAM(nodeMessagePrefix_ << ": Creating " << imageType
         << " " << classifierType << " Validator instance");
 
-    neuralNetworkValidator_.load(classifierPath_.c_str());
+    neuralNetworkValidator_.loadModel(classifierPath_);
     if (!neuralNetworkValidator_.get_layer_count())
     {
       ROS_FATAL("Could not read the classifier %s\n", classifierPath_.c_str());
@@ -98,6 +99,25 @@ namespace pandora_vision_victim
     *probability = outputs.at<float>(0, 0);
     *classLabel = *probability > 0.0f ? 1.0f : -1.0f;
   }
+
+  /**
+   * @brief Function that makes a prediction for all the feature vectors
+   * with a single forward pass of the network
+   * @return void
+   */
+  void NeuralNetworkValidator::predict(const cv::Mat& featuresMat,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
+  {
+    cv::Mat outputs;
+    neuralNetworkValidator_.predict(featuresMat, outputs);
+    probabilities->resize(outputs.rows);
+    classLabels->resize(outputs.rows);
+    for (int ii = 0; ii < outputs.rows; ii++)
+    {
+      (*probabilities)[ii] = outputs.at<float>(ii, 0);
+      (*classLabels)[ii] = (*probabilities)[ii] > 0.0f ? 1.0f : -1.0f;
+    }
+  }
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
 
@@ -194,7 +194,7 @@ namespace pandora_vision_victim
       plattScalingPtr_.reset(new PlattScaling());
     }
 
-    classifierPtr_.reset(new CvSVM());
+    classifierPtr_.reset(new SvmModel());
 
     numRgbFeatures_ =  featureExtraction_["rgb"]->getFeatureNumber();
     numDepthFeatures_ =  featureExtraction_["depth"]->getFeatureNumber();
@@ -319,7 +319,7 @@ namespace pandora_vision_victim
       plattScalingPtr_->save(plattParametersFile);
     }
 
-    classifierPtr_->save(classifierFile_.c_str());
+    classifierPtr_->saveModel(classifierFile_);
     return true;
   }
 
@@ -361,6 +361,9 @@ namespace pandora_vision_victim
     cv::Mat trainingLabelsMat = cv::Mat::zeros(numTrainingFiles, 1, CV_64FC1);
     cv::Mat testFeaturesMat = cv::Mat::zeros(numTestFiles, numFeatures_, CV_64FC1);
     cv::Mat testLabelsMat = cv::Mat::zeros(numTestFiles, 1, CV_64FC1);
+    // The binary files the loaded matrices refer to.
+    boost::shared_ptr<BinaryModelFile> trainingFeaturesFile, trainingLabelsFile;
+    boost::shared_ptr<BinaryModelFile> testFeaturesFile, testLabelsFile;
 
     if (loadClassifierModel_ && file_utilities::exist(classifierFile_.c_str()))
     {
@@ -412,17 +415,19 @@ namespace pandora_vision_victim
             std::cout << "Save bag of words vocabulary" << std::endl;
             const std::string bagOfWordsFile = imageType_ + "_" + imageTypesVec[ii] +"_svm_bag_of_words.xml";
             const std::string bagOfWordsFilePath = filesDirectory_  + bagOfWordsFile;
-            file_utilities::saveToFile(bagOfWordsFilePath, "bag_of_words",
-                featureExtraction_[imageTypesVec[ii]]->getBagOfWordsVocabulary());
+            file_utilities::saveModelToFile(bagOfWordsFilePath,
+                std::vector<std::string>(1, "bag_of_words"),
+                std::vector<cv::Mat>(1,
+                  featureExtraction_[imageTypesVec[ii]]->getBagOfWordsVocabulary()));
           }
         }
       }
       else
       {
         trainingFeaturesMat = file_utilities::loadFiles(
-            trainingFeaturesMatrixFile_, "training_features_mat");
+            trainingFeaturesMatrixFile_, "training_features_mat", &trainingFeaturesFile);
         trainingLabelsMat = file_utilities::loadFiles(
-            trainingLabelsMatrixFile_, "training_labels_mat");
+            trainingLabelsMatrixFile_, "training_labels_mat", &trainingLabelsFile);
       }
 
       // Start Training Process
@@ -462,9 +467,9 @@ namespace pandora_vision_victim
     else
     {
       testFeaturesMat = file_utilities::loadFiles(
-          testFeaturesMatrixFile_, "test_features_mat");
+          testFeaturesMatrixFile_, "test_features_mat", &testFeaturesFile);
       testLabelsMat = file_utilities::loadFiles(
-          testLabelsMatrixFile_, "test_labels_mat");
+          testLabelsMatrixFile_, "test_labels_mat", &testLabelsFile);
     }
 
     cv::Mat results = cv::Mat::zeros(numTestFiles, 1, CV_64FC1);
@@ -197,7 +197,7 @@ namespace pandora_vision_victim
       pcaPtr_.reset(new PrincipalComponentAnalysis());
     }
 
-    classifierPtr_.reset(new CvSVM());
+    classifierPtr_.reset(new SvmModel());
 
     ROS_INFO("Created %s %s Training Instance.", imageType_.c_str(), classifierType_.c_str());
   }
@@ -286,7 +286,7 @@ namespace pandora_vision_victim
       plattScalingPtr_->save(plattParametersFile);
     }
 
-    classifierPtr_->save(classifierFile_.c_str());
+    classifierPtr_->saveModel(classifierFile_);
     return true;
   }
 
@@ -38,6 +38,7 @@
  *********************************************************************/
 
 #include <string>
+#include <vector>
 
 #include <ros/console.h>
 
@@ -66,7 +67,7 @@ namespace pandora_vision_victim
     ROS_INFO_STREAM(nodeMessagePrefix_ << ": Creating " << imageType
         << " " << classifierType << " Validator instance");
 
-    svmValidator_.load(classifierPath_.c_str());
+    svmValidator_.loadModel(classifierPath_);
 
     double probabilityScaling;
     if (!nh.getParam(classifierType_ + "/" + imageType_ + "/probability_scaling", probabilityScaling))
@@ -143,50 +144,34 @@ namespace pandora_vision_victim
   void SvmValidator::predict(const cv::Mat& featuresMat,
       float* classLabel, float* probability)
   {
-    cv::Mat projectedFeaturesMat;
-    if (doPcaAnalysis_)
-    {
-      pcaPtr_->project(featuresMat, &projectedFeaturesMat);
-    }
-    else
-    {
-      projectedFeaturesMat = featuresMat.clone();
-    }
-
-    *classLabel = svmValidator_.predict(projectedFeaturesMat, false);
-    float prediction;
-    prediction = svmValidator_.predict(projectedFeaturesMat, true);
-
-    *probability = transformPredictionToProbability(prediction, *classLabel);
+    std::vector<float> classLabels, probabilities;
+    predict(featuresMat, &classLabels, &probabilities);
+    *classLabel = classLabels[0];
+    *probability = probabilities[0];
   }
 
   /**
-   * @brief This function calculates the classification probability according to
-   * the classifier prediction.
-   * @param prediction [float] The classifier prediction.
-   * @return [float] The classification probability.
+   * @brief Predicts the decision function values of all the feature vectors,
+   * and from them their class labels and probabilities
+   * @return void
    */
-  float SvmValidator::transformPredictionToProbability(float prediction,
-      float classLabel)
+  void SvmValidator::predict(const cv::Mat& featuresMat,
+      std::vector<float>* classLabels, std::vector<float>* probabilities)
   {
-    ROS_INFO_STREAM(nodeMessagePrefix_ << ": Prediction = " << prediction);
-
-    double absPrediction = fabs(prediction);
-    float probability;
-    if (usePlattScaling_)
+    cv::Mat projectedFeaturesMat;
+    if (doPcaAnalysis_)
     {
-      ROS_INFO_STREAM(nodeMessagePrefix_ << ": Use Platt Scaling to estimate probability");
-      probability = plattScalingPtr_->sigmoidPredict(absPrediction * classLabel);
+      pcaPtr_->project(featuresMat, &projectedFeaturesMat);
     }
     else
     {
-      // Normalize probability to [-1,1]
-      probability = static_cast<float>(std::tanh(
-          probabilityScaling_ * absPrediction - probabilityTranslation_));
-      // Normalize probability to [0,1]
-      probability = (1.0f + probability) / 2.0f;
+      projectedFeaturesMat = featuresMat;
     }
-    return probability;
+
+    cv::Mat predictions;
+    svmValidator_.predictDecisionValues(projectedFeaturesMat, classLabels,
+        &predictions);
+    transformPredictionsToProbabilities(predictions, *classLabels, probabilities);
   }
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
@@ -37,6 +37,8 @@
  *   Kofinas Miltiadis <mkofinas@gmail.com>
  *********************************************************************/
 
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "pandora_vision_victim/feature_extractors/channels_statistics_extractor.h"
@@ -45,6 +47,85 @@ namespace pandora_vision
 {
 namespace pandora_vision_victim
 {
+namespace
+{
+  /**
+   * @brief Computes the sum of the pixels of a region from an integral
+   * image.
+   */
+  double regionSum(const cv::Mat& integralImage, const cv::Rect& region)
+  {
+    return integralImage.at<double>(region.y + region.height,
+                                    region.x + region.width)
+      - integralImage.at<double>(region.y, region.x + region.width)
+      - integralImage.at<double>(region.y + region.height, region.x)
+      + integralImage.at<double>(region.y, region.x);
+  }
+}  // namespace
+
+  /**
+   * @brief Keeps a color frame, computes its HSV planes and their integral
+   * images.
+   * @param frame [const cv::Mat&] The color frame.
+   * @return void
+   */
+  void ChannelsStatisticsFrame::setColorFrame(const cv::Mat& frame)
+  {
+    frame_ = frame;
+    cv::Mat hsvFrame;
+    cv::cvtColor(frame, hsvFrame, CV_BGR2HSV);
+    cv::split(hsvFrame, planes_);
+    computeIntegralImages();
+  }
+
+  /**
+   * @brief Keeps a depth frame, computes its grayscale plane and the
+   * integral images of that plane.
+   * @param frame [const cv::Mat&] The depth frame.
+   * @return void
+   */
+  void ChannelsStatisticsFrame::setDepthFrame(const cv::Mat& frame)
+  {
+    frame_ = frame;
+    planes_.assign(1, frame);
+    if (frame.channels() != 1)
+      cv::cvtColor(frame, planes_[0], CV_BGR2GRAY);
+    computeIntegralImages();
+  }
+
+  /**
+   * @brief Computes the mean and standard deviation of a plane over a
+   * region of the frame, in the order of MeanStdDevExtractor.
+   * @param plane [int] The index of the plane.
+   * @param region [const cv::Rect&] The region of the frame.
+   * @return [std::vector<double>] The mean and standard deviation vector.
+   */
+  std::vector<double> ChannelsStatisticsFrame::meanStdDev(int plane,
+      const cv::Rect& region) const
+  {
+    double area = region.area();
+    double mean = regionSum(sums_[plane], region) / area;
+    double variance = regionSum(squareSums_[plane], region) / area
+      - mean * mean;
+
+    std::vector<double> meanStdDevVector;
+    meanStdDevVector.push_back(mean);
+    meanStdDevVector.push_back(std::sqrt(std::max(variance, 0.0)));
+    return meanStdDevVector;
+  }
+
+  /**
+   * @brief Computes the integral images of the planes and of their squares.
+   * @return void
+   */
+  void ChannelsStatisticsFrame::computeIntegralImages()
+  {
+    sums_.resize(planes_.size());
+    squareSums_.resize(planes_.size());
+    for (int ii = 0; ii < planes_.size(); ii++)
+      cv::integral(planes_[ii], sums_[ii], squareSums_[ii], CV_64F);
+  }
+
   /**
    * @brief This function extracts color related statistic features from a
    * color image.
@@ -67,6 +148,99 @@ namespace pandora_vision_victim
     std::vector<cv::Mat> hsvPlanes;
     split(hsvFrame, hsvPlanes);
 
+    /// Find the mean value and standard deviation value of every color
+    /// component.
+    std::vector<std::vector<double> > meanStd;
+    for (int ii = 0; ii < hsvPlanes.size(); ii++)
+      meanStd.push_back(MeanStdDevExtractor(&hsvPlanes[ii]).extract());
+
+    appendColorChannelsStatistics(rgbFrame, hsvPlanes, meanStd,
+        colorStatisticsVector);
+  }
+
+  /**
+   * @brief This function extracts color related statistic features from a
+   * region of a color frame.
+   * @param frame [const ChannelsStatisticsFrame&] The color frame.
+   * @param region [const cv::Rect&] The region to be processed.
+   * @param colorStatisticsVector [std::vector<double>*] The color
+   * statistics vector.
+   * @return void
+   */
+  void ChannelsStatisticsExtractor::findColorChannelsStatisticsFeatures(
+      const ChannelsStatisticsFrame& frame, const cv::Rect& region,
+      std::vector<double>* colorStatisticsVector)
+  {
+    /// The HSV transform works on each pixel on its own, so the planes of
+    /// the region are the regions of the planes of the frame.
+    std::vector<cv::Mat> hsvPlanes;
+    std::vector<std::vector<double> > meanStd;
+    for (int ii = 0; ii < frame.getPlanes().size(); ii++)
+    {
+      hsvPlanes.push_back(frame.getPlanes()[ii](region));
+      meanStd.push_back(frame.meanStdDev(ii, region));
+    }
+
+    appendColorChannelsStatistics(frame.getFrame()(region), hsvPlanes,
+        meanStd, colorStatisticsVector);
+  }
+
+  /**
+   * @brief This function extracts color related statistic features from a
+   * depth image.
+   * @param src [const cv::Mat&] Depth image to be processed.
+   * @param depthStatisticsVector [std::vector<double>*] The depth
+   * statistics vector.
+   * @return void
+   */
+  void ChannelsStatisticsExtractor::findDepthChannelsStatisticsFeatures(
+      const cv::Mat& src, std::vector<double>* depthStatisticsVector)
+  {
+    cv::Mat inFrame = src.clone();
+
+    if (inFrame.channels() != 1)
+    cv::cvtColor(inFrame, inFrame, CV_BGR2GRAY);
+
+    /// Find the mean and standard deviation value of the image.
+    std::vector<double> meanStd = MeanStdDevExtractor(&inFrame).extract();
+
+    appendDepthChannelsStatistics(inFrame, meanStd, depthStatisticsVector);
+  }
+
+  /**
+   * @brief This function extracts color related statistic features from a
+   * region of a depth frame.
+   * @param frame [const ChannelsStatisticsFrame&] The depth frame.
+   * @param region [const cv::Rect&] The region to be processed.
+   * @param depthStatisticsVector [std::vector<double>*] The depth
+   * statistics vector.
+   * @return void
+   */
+  void ChannelsStatisticsExtractor::findDepthChannelsStatisticsFeatures(
+      const ChannelsStatisticsFrame& frame, const cv::Rect& region,
+      std::vector<double>* depthStatisticsVector)
+  {
+    appendDepthChannelsStatistics(frame.getPlanes()[0](region),
+        frame.meanStdDev(0, region), depthStatisticsVector);
+  }
+
+  /**
+   * @brief This function appends the color statistics to a feature vector,
+   * given the HSV planes of an image and their mean and standard deviation.
+   * @param rgbFrame [const cv::Mat&] The color image.
+   * @param hsvPlanes [const std::vector<cv::Mat>&] The Hue, Saturation and
+   * Value planes of the image.
+   * @param meanStd [const std::vector<std::vector<double> >&] The mean and
+   * standard deviation of each plane.
+   * @param colorStatisticsVector [std::vector<double>*] The color
+   * statistics vector.
+   * @return void
+   */
+  void ChannelsStatisticsExtractor::appendColorChannelsStatistics(
+      const cv::Mat& rgbFrame, const std::vector<cv::Mat>& hsvPlanes,
+      const std::vector<std::vector<double> >& meanStd,
+      std::vector<double>* colorStatisticsVector)
+  {
     int hueBins = 180;
     int saturationBins = 256;
     int valueBins = 256;
@@ -93,12 +267,6 @@ namespace pandora_vision_victim
     cv::calcHist(&hsvPlanes[2], 1, 0, cv::Mat(), valueHistogram, 1, &valueBins,
         &valueHistogramRange, uniform, accumulate);
 
-    /// Find the mean value and standard deviation value of every color
-    /// component.
-    std::vector<double> meanStdH = MeanStdDevExtractor(&hsvPlanes[0]).extract();
-    std::vector<double> meanStdS = MeanStdDevExtractor(&hsvPlanes[1]).extract();
-    std::vector<double> meanStdV = MeanStdDevExtractor(&hsvPlanes[2]).extract();
-
     /// Find the dominant color component and their density values
     std::vector<double> domValH = DominantColorExtractor(&hueHistogram).extract();
     std::vector<double> domValS = DominantColorExtractor(&saturationHistogram).extract();
@@ -106,19 +274,19 @@ namespace pandora_vision_victim
 
     /// Compute the first 6 Fourier Transform coefficints of the
     /// Hue and Saturation color components.
-    std::vector<double> dftH = DFTCoeffsExtractor(&hsvPlanes[0]).extract();
-    std::vector<double> dftS = DFTCoeffsExtractor(&hsvPlanes[1]).extract();
+    cv::Mat huePlane = hsvPlanes[0];
+    cv::Mat saturationPlane = hsvPlanes[1];
+    std::vector<double> dftH = DFTCoeffsExtractor(&huePlane).extract();
+    std::vector<double> dftS = DFTCoeffsExtractor(&saturationPlane).extract();
 
     /// Compute the colour angles of the R, G, B color components.
-    std::vector<double> colorAnglesAndStd = ColorAnglesExtractor(&rgbFrame).extract();
+    cv::Mat rgbImage = rgbFrame;
+    std::vector<double> colorAnglesAndStd = ColorAnglesExtractor(&rgbImage).extract();
 
     /// Append all features to the output feature vector.
-    colorStatisticsVector->insert(colorStatisticsVector->end(),
-                                  meanStdH.begin(), meanStdH.end());
-    colorStatisticsVector->insert(colorStatisticsVector->end(),
-                                  meanStdS.begin(), meanStdS.end());
-    colorStatisticsVector->insert(colorStatisticsVector->end(),
-                                  meanStdV.begin(), meanStdV.end());
+    for (int ii = 0; ii < meanStd.size(); ii++)
+      colorStatisticsVector->insert(colorStatisticsVector->end(),
+                                    meanStd[ii].begin(), meanStd[ii].end());
     colorStatisticsVector->insert(colorStatisticsVector->end(),
                                   domValH.begin(), domValH.end());
     colorStatisticsVector->insert(colorStatisticsVector->end(),
@@ -141,21 +309,20 @@ namespace pandora_vision_victim
   }
 
   /**
-   * @brief This function extracts color related statistic features from a
-   * depth image.
-   * @param src [const cv::Mat&] Depth image to be processed.
+   * @brief This function appends the depth statistics to a feature vector,
+   * given the grayscale plane of an image and its mean and standard
+   * deviation.
+   * @param grayFrame [const cv::Mat&] The grayscale plane of the image.
+   * @param meanStd [const std::vector<double>&] The mean and standard
+   * deviation of the plane.
    * @param depthStatisticsVector [std::vector<double>*] The depth
    * statistics vector.
    * @return void
    */
-  void ChannelsStatisticsExtractor::findDepthChannelsStatisticsFeatures(
-      const cv::Mat& src, std::vector<double>* depthStatisticsVector)
+  void ChannelsStatisticsExtractor::appendDepthChannelsStatistics(
+      const cv::Mat& grayFrame, const std::vector<double>& meanStd,
+      std::vector<double>* depthStatisticsVector)
   {
-    cv::Mat inFrame = src.clone();
-
-    if (inFrame.channels() != 1)
-    cv::cvtColor(inFrame, inFrame, CV_BGR2GRAY);
-
     int grayscaleBins = 256;
     /// Set the histogram ranges.
     float grayscaleRanges[] = {0, 256};
@@ -166,17 +333,15 @@ namespace pandora_vision_victim
 
     cv::Mat grayscaleHistogram;
     /// Compute the histograms for every color component.
-    cv::calcHist(&inFrame, 1, 0, cv::Mat(), grayscaleHistogram, 1,
+    cv::calcHist(&grayFrame, 1, 0, cv::Mat(), grayscaleHistogram, 1,
         &grayscaleBins, &grayscaleHistogramRange, uniform, accumulate);
 
-    /// Find the mean and standard deviation value of the image.
-    std::vector<double> meanStd = MeanStdDevExtractor(&inFrame).extract();
-
     /// Find the dominant color and its density value.
     std::vector<double> domVal = DominantColorExtractor(&grayscaleHistogram).extract();
 
     /// Compute the first 6 Fourier Transform coefficints of the image.
-    std::vector<double> dft = DFTCoeffsExtractor(&inFrame).extract();
+    cv::Mat grayImage = grayFrame;
+    std::vector<double> dft = DFTCoeffsExtractor(&grayImage).extract();
 
     /// Append all features to the output feature vector.
     depthStatisticsVector->insert(depthStatisticsVector->end(),
@@ -37,8 +37,8 @@
  *   Kofinas Miltiadis <mkofinas@gmail.com>
  *********************************************************************/
 
+#include <algorithm>
 #include <vector>
-#include <limits>
 
 #include "pandora_vision_victim/feature_extractors/edge_orientation_extractor.h"
 
@@ -53,9 +53,9 @@ namespace pandora_vision_victim
   **/
   void EdgeOrientationExtractor::findEdgeFeatures(const cv::Mat& inImage, std::vector<double>* edgeFeatures)
   {
-    cv::Mat src = inImage.clone();
+    cv::Mat src;
     // ROS_INFO("ENTER find edge features");
-    GaussianBlur(src, src, cv::Size(3, 3), 0, 0, cv::BORDER_DEFAULT);
+    GaussianBlur(inImage, src, cv::Size(3, 3), 0, 0, cv::BORDER_DEFAULT);
     if (src.channels() !=1)
       cvtColor(src, src, CV_BGR2GRAY);
 
@@ -86,141 +86,116 @@ namespace pandora_vision_victim
   }
 
   /**
-  @brief This is the function which divides the image
-  into 16 subblocks and calls the findLocalEdgeFeatures to compute the
-  features of the current subblock
-  @param currFrame [cv::Mat]: the current subblock.
+  @brief This is the function which divides the image into subblocks
+  and computes the edge histogram features of each one of them.
+  The orientation responses and the edges of the whole image are found
+  in a single pass, and each edge pixel is binned into the histogram of
+  its subblock.
+  @param currFrame [cv::Mat]: the current grayscale image.
   @param colsBlockSize [int]: the cols size of the subblock.
   @param rowsBlockSize [int]: the rows size of the subblock.
-  @return [std::vector<double>] the computed  1x80 edgeFeatures vector.
+  @return [std::vector<double>] the computed 1x5 edgeFeatures of each
+  subblock, subblocks ordered column by column.
   **/
   void EdgeOrientationExtractor::partition(const cv::Mat& currFrame,
         int colsBlockSize, int rowsBlockSize, std::vector<double>* localEdgeFeatures)
   {
-    // ROS_INFO("ENTER PARTITION");
-    std::vector<double> temp;
-    // std::vector<double> edgeFeatures;
-
-    for (int ii = 0; ii < currFrame.cols; ii += colsBlockSize)
-    {
-      for (int jj = 0; jj < currFrame.rows; jj += rowsBlockSize)
-      {
-        temp.clear();
-        cv::Mat subblock(currFrame, cv::Rect(ii, jj, colsBlockSize,
-                          rowsBlockSize));
+    const int orientations = 5;
+    int colsBlocks = (currFrame.cols + colsBlockSize - 1) / colsBlockSize;
+    int rowsBlocks = (currFrame.rows + rowsBlockSize - 1) / rowsBlockSize;
 
-        //!< Do stuff with subblock here
-        findLocalEdgeFeatures(subblock, &temp);
-        for (int kk = 0; kk < 5; kk++)
-          localEdgeFeatures->push_back(temp[kk]);
-      }
-    }
-  }
-
-  /**
-  @brief This is the function which  computes the edge histogram
-  feature of the current subblock.
-  @param currFrame [cv::Mat] the current subblock.
-  @return [std::vector<double>] the computed 1x5 edgeFeatures vector.
-  **/
-  void EdgeOrientationExtractor::findLocalEdgeFeatures(const cv::Mat& currFrame,
-                                                       std::vector<double>* localEdgeFeatures )
-  {
-    // ROS_INFO("ENTER FIND LOCAL EDGE");
-    cv::Mat img;
-    currFrame.convertTo(img, CV_64F);
-
-    /// Build a vector of the same size of the image and 5 dimensions
-    /// to save the gradients
-    std::vector<cv::Mat> convImg(5);
-
-    ///  Define the Scharr filters for the 5 types of edges
-    std::vector<cv::Mat> kernel(5);
-    /* double vals[5][9] = {1, 2, 1, 0, 0, 0, -1, -2, -1, -1, 0, 1, -2, 0, 2, -1,
-                  0, 1, 2, 2, -1, 2, -1, -1, -1, -1, -1, -1, 2, 2, -1, -1, 2,
-                  -1, -1, -1, -1, 0, 1, 0, 0, 0, 1, 0, -1}; */
-    double vals[5][9] = {-3, -10, -3, 0, 0, 0, 3, 10, 3, -3, 0, 3, -10, 0, 10, -3,
-                  0, 3, 0, 3, 10, -3, 0, 3, -10, -3, 0, -10, -3, 0, -3,
-                  0, 3, 0, 3, 10, -3, 0, 3, 0, 0, 0, 3, 0, -3};
+    /// Detect the edges; only they are binned
+    cv::Mat edges;
+    Canny(currFrame, edges, 0, 30, 3);
 
-    for (int ii = 0; ii < kernel.size(); ii++)
-      kernel[ii] = cv::Mat(3, 3, CV_64F, vals[ii]);
+    /// The orientation filters see zeros beyond the image's borders
+    cv::Mat padded;
+    copyMakeBorder(currFrame, padded, 1, 1, 1, 1, cv::BORDER_CONSTANT,
+        cv::Scalar(0));
 
-    /// Iterate over the posible directions and apply the filters
+    /// The edge pixels of each orientation in each subblock, subblocks
+    /// ordered column by column
+    std::vector<int> counts(colsBlocks * rowsBlocks * orientations, 0);
 
-    for (int ii = 0; ii < kernel.size(); ii++)
+    for (int jj = 0; jj < currFrame.rows; jj++)
     {
-      conv2(img, kernel[ii], CONVOLUTION_SAME, &convImg[ii]);
-      convImg[ii]=abs(convImg[ii]);
-    }
+      const uchar* edgesRow = edges.ptr<uchar>(jj);
+      const uchar* up = padded.ptr<uchar>(jj);
+      const uchar* mid = padded.ptr<uchar>(jj + 1);
+      const uchar* down = padded.ptr<uchar>(jj + 2);
+      int rowsBlock = jj / rowsBlockSize;
 
-    /// Calculate the max sobel gradient and save the type of the orientation
-    double maxVal;
-    cv::Mat maxGrad = cv::Mat::zeros(convImg[0].rows, convImg[0].cols, CV_64F);
-    for (int jj = 0; jj < convImg[0].rows; jj++)
-    {
-      for (int kk = 0; kk < convImg[0].cols; kk++)
+      for (int kk = 0; kk < currFrame.cols; kk++)
       {
-        double maxVal= - std::numeric_limits<double>::infinity();
-        for (int ii = 0; ii < convImg.size(); ii++)
+        if (edgesRow[kk] == 0)
+          continue;
+
+        /// The 3x3 neighbourhood of the pixel
+        int a = up[kk], b = up[kk + 1], c = up[kk + 2];
+        int d = mid[kk], f = mid[kk + 2];
+        int g = down[kk], h = down[kk + 1], i = down[kk + 2];
+
+        ///  The responses of the Scharr filters for the 5 types of edges:
+        ///  horizontal, vertical, 45 degrees, 135 degrees and non
+        ///  directional
+        int response[orientations] = {
+          3 * (g - a) + 10 * (h - b) + 3 * (i - c),
+          3 * (c - a) + 10 * (f - d) + 3 * (i - g),
+          10 * (c - g) + 3 * (b - d) + 3 * (f - h),
+          10 * (i - a) + 3 * (f - b) + 3 * (h - d),
+          3 * (c + g - a - i)};
+
+        /// The orientation of the maximum absolute response, the first
+        /// one among equal ones
+        int maxGrad = 0;
+        int maxVal = abs(response[0]);
+        for (int ii = 1; ii < orientations; ii++)
         {
-          if (maxVal < convImg[ii].at<double>(jj, kk))
+          if (maxVal < abs(response[ii]))
           {
-            maxVal = convImg[ii].at<double>(jj, kk);
-            maxGrad.at<double>(jj, kk) = ii+1;
+            maxVal = abs(response[ii]);
+            maxGrad = ii;
           }
         }
+
+        int block = (kk / colsBlockSize) * rowsBlocks + rowsBlock;
+        counts[block * orientations + maxGrad]++;
       }
     }
-    /// Detect the edges
-    cv::Mat edges;
-    Canny(currFrame, edges, 0, 30, 3);
-    edges.convertTo(edges, CV_64F);
-    for (int ii = 0; ii < edges.rows; ii++)
+
+    for (int ii = 0; ii < colsBlocks; ii++)
     {
-      for (int jj = 0; jj < edges.cols; jj++)
+      int blockCols = std::min(colsBlockSize, currFrame.cols - ii * colsBlockSize);
+      for (int jj = 0; jj < rowsBlocks; jj++)
       {
-        if (edges.at<double>(ii, jj) == 255)
-          edges.at<double>(ii, jj)=1;
+        int blockRows = std::min(rowsBlockSize, currFrame.rows - jj * rowsBlockSize);
+        const int* blockCounts = &counts[(ii * rowsBlocks + jj) * orientations];
+
+        for (int kk = 0; kk < orientations; kk++)
+          localEdgeFeatures->push_back(static_cast<double>(blockCounts[kk]) /
+              (blockRows * blockCols));
+
+        #ifdef SHOW_DEBUG_IMAGE
+        cv::Mat hist = cv::Mat::zeros(orientations + 1, 1, CV_32F);
+        for (int kk = 0; kk < orientations; kk++)
+          hist.at<float>(kk + 1) = blockCounts[kk];
+        show_histogramm(orientations + 1, hist, "Edge Histogramm");
+        #endif
       }
     }
+  }
 
-    /// multiply against the types of orientations detected by the Sobel masks
-    cv::Mat data = cv::Mat::zeros(convImg[0].rows, convImg[0].cols, CV_64F);
-    for (int jj = 0; jj < data.rows; jj++)
-    {
-      for (int kk = 0; kk < data.cols; kk++)
-        data.at<double>(jj, kk) = maxGrad.at<double>(jj, kk) *
-                                  edges.at<double>(jj, kk);
-    }
-
-    data.convertTo(data, CV_32F);
-
-    /// Establish the number of bins
-    int bins = 6;
-
-    /// Set the range
-    float range[] = { 0, 6 };
-
-    const float* histRange = { range };
-
-    bool uniform = true;
-    bool accumulate = false;
-
-    cv::Mat hist;
-    cv::calcHist(&data, 1, 0, cv::Mat(), hist, 1, &bins, &histRange, uniform,
-                accumulate);
-
-    show_histogramm(bins, hist, "Edge Histogramm");
-
-    /// save the final edgeFeatures for the 5 types of oriented gradients
-    // std::vector<double> edgeFeatures(5);
-
-    for (int ii = 1; ii < 6; ii++)
-    {
-      localEdgeFeatures->push_back(static_cast<double> (hist.at<float>(ii)) / (data.rows *data.cols));
-      // (*localEdgeFeatures)[ii-1]=hist.at<float>(ii) / (data.rows *data.cols);
-    }
+  /**
+  @brief This is the function which  computes the edge histogram
+  feature of the current subblock.
+  @param currFrame [cv::Mat] the current subblock.
+  @return [std::vector<double>] the computed 1x5 edgeFeatures vector.
+  **/
+  void EdgeOrientationExtractor::findLocalEdgeFeatures(const cv::Mat& currFrame,
+                                                       std::vector<double>* localEdgeFeatures )
+  {
+    /// The subblock is a single block of itself
+    partition(currFrame, currFrame.cols, currFrame.rows, localEdgeFeatures);
 
     if (localEdgeFeatures->size() != 5)
     {
@@ -35,10 +35,19 @@
  * Author: Kofinas Miltiadis <mkofinas@gmail.com>
  *********************************************************************/
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <vector>
 #include <string>
 
+#include <boost/bind.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/thread.hpp>
+
 #include "pandora_vision_victim/feature_extractors/feature_extraction.h"
+#include "pandora_vision_victim/utilities/feature_cache.h"
 #include "pandora_vision_victim/utilities/file_utilities.h"
 
 /**
@@ -49,6 +58,55 @@ namespace pandora_vision
 {
 namespace pandora_vision_victim
 {
+namespace
+{
+  /// Part of the key of the feature cache. It must be increased whenever
+  /// the output of a feature extractor changes.
+  const int FEATURES_VERSION = 1;
+
+  /**
+   * @brief Reads a whole file in memory.
+   */
+  bool readFile(const std::string& fileName, std::vector<uchar>* buffer)
+  {
+    std::ifstream inFile(fileName.c_str(), std::ifstream::binary);
+    if (!inFile)
+      return false;
+    inFile.seekg(0, std::ifstream::end);
+    std::streamoff size = inFile.tellg();
+    inFile.seekg(0, std::ifstream::beg);
+    if (size <= 0)
+      return false;
+    buffer->resize(size);
+    inFile.read(reinterpret_cast<char*>(&(*buffer)[0]), size);
+    return !inFile.fail();
+  }
+}  // namespace
+
+  /**
+   * @brief The state shared by the feature extraction threads of
+   * constructFeaturesMatrix.
+   */
+  struct FeatureExtraction::ExtractionJob
+  {
+    const boost::filesystem::path* directory;
+    const std::vector<std::string>* annotatedImages;
+    const std::vector<cv::Rect>* boundingBox;
+    const std::vector<int>* classAttributes;
+    cv::Mat* featuresMat;
+    FeatureCache* cache;
+    bool serialize;
+
+    /// Guards the members that follow and the standard output.
+    boost::mutex mutex;
+    int next;
+    int numCached;
+    int numExtracted;
+
+    /// Serializes extractFeatures when it is not thread safe.
+    boost::mutex extractionMutex;
+  };
+
   /**
    * @brief Default Constructor
    */
@@ -62,6 +120,9 @@ namespace pandora_vision_victim
       chosenFeatureTypesMap_.clear();
 
     packagePath_ = ros::package::getPath("pandora_vision_victim");
+
+    numExtractionThreads_ = 0;
+    useFeatureCache_ = false;
   }
 
   /**
@@ -73,12 +134,114 @@ namespace pandora_vision_victim
 
   /**
    * @brief This function extracts features according to the predefined
-   * feature extraction algorithms.
+   * feature extraction algorithms and keeps them as the feature vector.
    * @param inImage [const cv::Mat&] Frame to extract features from.
    * @return void
    */
   void FeatureExtraction::extractFeatures(const cv::Mat& inImage)
   {
+    extractFeatures(inImage, &featureVector_);
+  }
+
+  /**
+   * @brief This function extracts features according to the predefined
+   * feature extraction algorithms.
+   * @param inImage [const cv::Mat&] Frame to extract features from.
+   * @param featureVector [std::vector<double>*] The extracted features.
+   * @return void
+   */
+  void FeatureExtraction::extractFeatures(const cv::Mat& inImage,
+      std::vector<double>* featureVector)
+  {
+    featureVector->clear();
+  }
+
+  /**
+   * @brief This function extracts the features of several regions of a
+   * frame, each one from its cropped region.
+   * @param frame [const cv::Mat&] The frame the regions belong to.
+   * @param regions [const std::vector<cv::Rect>&] The regions to extract
+   * features from.
+   * @param featureVectors [std::vector<std::vector<double> >*] The
+   * extracted features of each region.
+   * @return void
+   */
+  void FeatureExtraction::extractFeatures(const cv::Mat& frame,
+      const std::vector<cv::Rect>& regions,
+      std::vector<std::vector<double> >* featureVectors)
+  {
+    featureVectors->resize(regions.size());
+    for (int ii = 0; ii < regions.size(); ii++)
+      extractFeatures(frame(regions[ii]), &(*featureVectors)[ii]);
+  }
+
+  /**
+   * @brief Reads the feature extraction threads and feature cache
+   * parameters of a classifier.
+   * @param paramFile [const std::string&] The file the parameters are
+   * read from.
+   * @param classifierNode [const cv::FileNode&] The parameters of the
+   * classifier.
+   * @return void
+   */
+  void FeatureExtraction::loadExtractionParameters(const std::string& paramFile,
+      const cv::FileNode& classifierNode)
+  {
+    paramFile_ = paramFile;
+
+    if (!classifierNode["feature_extraction_threads"].empty())
+      numExtractionThreads_ =
+        static_cast<int>(classifierNode["feature_extraction_threads"]);
+
+    std::string featureCache = classifierNode["use_feature_cache"];
+    useFeatureCache_ = featureCache.compare("true") == 0;
+  }
+
+  /**
+   * @brief This function checks whether several images can go through
+   * extractFeatures at once.
+   * @return [bool] Variable declaring whether features can be extracted in
+   * parallel or not.
+   */
+  bool FeatureExtraction::parallelExtractionSafe()
+  {
+    return !visualization_ && !chosenFeatureTypesMap_["sift"];
+  }
+
+  /**
+   * @brief Computes the key of the feature cache for the current
+   * configuration.
+   * @return [uint64_t] The key of the configuration.
+   */
+  uint64_t FeatureExtraction::featureConfigurationKey()
+  {
+    std::ostringstream configuration;
+    configuration << FEATURES_VERSION << ";" << imageType_ << ";"
+                  << numFeatures_ << ";" << dictionarySize_;
+    for (std::map<std::string, bool>::const_iterator it =
+        chosenFeatureTypesMap_.begin(); it != chosenFeatureTypesMap_.end(); ++it)
+      configuration << ";" << it->first << "=" << it->second;
+    const std::string configurationString = configuration.str();
+    uint64_t key = FeatureCache::hash(configurationString.data(),
+        configurationString.size());
+
+    // The extractors read more parameters than the ones above from the
+    // parameter file, e.g. the histogram channels, bins and ranges, so all
+    // of its contents are part of the key.
+    std::ifstream paramStream(paramFile_.c_str(), std::ios::binary);
+    const std::string paramContents(
+        (std::istreambuf_iterator<char>(paramStream)),
+        std::istreambuf_iterator<char>());
+    key = FeatureCache::hash(paramContents.data(), paramContents.size(), key);
+
+    if (chosenFeatureTypesMap_["sift"])
+    {
+      cv::Mat vocabulary = getBagOfWordsVocabulary();
+      for (int ii = 0; ii < vocabulary.rows; ii++)
+        key = FeatureCache::hash(vocabulary.ptr(ii),
+            vocabulary.cols * vocabulary.elemSize(), key);
+    }
+    return key;
   }
 
   /**
@@ -114,7 +277,10 @@ namespace pandora_vision_victim
 
   /**
    * @brief This function constructs the features matrix, i.e. the feature
-   * vectors of a set of images.
+   * vectors of a set of images. The images are processed by a pool of
+   * threads, and feature vectors are reused from the feature cache when
+   * the same region of the same image was processed before with the same
+   * configuration.
    * @param directory [const boost::filesystem::path&] The directory that
    * contains the set of images for the feature extraction.
    * @param annotationsFile [const std::string&] The name of the file that
@@ -129,7 +295,6 @@ namespace pandora_vision_victim
       const std::string& annotationsFile,
       cv::Mat* featuresMat, cv::Mat* labelsMat)
   {
-    cv::Mat image, imageROI;
     std::vector<std::string> annotatedImages;
     std::vector<cv::Rect> boundingBox;
     std::vector<int> classAttributes;
@@ -138,37 +303,138 @@ namespace pandora_vision_victim
         annotationsFile, &boundingBox, &annotatedImages, &classAttributes);
     std::cout << "Iterate over dataset images" << std::endl;
 
-    if (successfulFileLoad)
+    if (!successfulFileLoad)
+    {
+      std::cout << "Unsuccessful annotations file load. Exiting!";
+      exit(1);
+    }
+
+    std::cout << "Read class attributes from annotation file." << std::endl;
+    for (int ii = 0; ii < classAttributes.size(); ii++)
+      labelsMat->at<double>(ii) =  classAttributes[ii];
+
+    boost::scoped_ptr<FeatureCache> cache;
+    if (useFeatureCache_)
     {
-      std::cout << "Read class attributes from annotation file." << std::endl;
-      for (int ii = 0; ii < classAttributes.size(); ii++)
-        labelsMat->at<double>(ii) =  classAttributes[ii];
+      const std::string cacheFile = packagePath_ + "/data/" + imageType_ +
+        "features_cache.bin";
+      cache.reset(new FeatureCache(cacheFile, featureConfigurationKey(),
+            numFeatures_));
+      std::cout << "Feature cache " << cacheFile << " holds " << cache->size()
+                << " feature vectors" << std::endl;
+    }
 
-      for (int ii = 0; ii < annotatedImages.size(); ii++)
+    ExtractionJob job;
+    job.directory = &directory;
+    job.annotatedImages = &annotatedImages;
+    job.boundingBox = &boundingBox;
+    job.classAttributes = &classAttributes;
+    job.featuresMat = featuresMat;
+    job.cache = cache.get();
+    job.serialize = !parallelExtractionSafe();
+    job.next = 0;
+    job.numCached = 0;
+    job.numExtracted = 0;
+
+    int numThreads = numExtractionThreads_;
+    if (numThreads <= 0)
+      numThreads = std::max(static_cast<int>(
+            boost::thread::hardware_concurrency()), 1);
+    numThreads = std::min(numThreads,
+        std::max(static_cast<int>(annotatedImages.size()), 1));
+
+    boost::thread_group workers;
+    for (int ii = 1; ii < numThreads; ii++)
+      workers.create_thread(boost::bind(&FeatureExtraction::extractionWorker,
+            this, &job));
+    extractionWorker(&job);
+    workers.join_all();
+
+    std::cout << "Extracted the features of " << job.numExtracted
+              << " images and reused those of " << job.numCached
+              << " images, using " << numThreads << " threads" << std::endl;
+
+    if (cache)
+      cache->save();
+  }
+
+  /**
+   * @brief The loop of each feature extraction thread.
+   * @param job [ExtractionJob*] The shared state of the extraction.
+   * @return void
+   */
+  void FeatureExtraction::extractionWorker(ExtractionJob* job)
+  {
+    std::vector<uchar> buffer;
+    std::vector<double> featureVector;
+    while (true)
+    {
+      int ii;
+      {
+        boost::mutex::scoped_lock lock(job->mutex);
+        if (job->next >= job->annotatedImages->size())
+          return;
+        ii = job->next++;
+      }
+
+      const std::string& imageName = (*job->annotatedImages)[ii];
+      const cv::Rect& roi = (*job->boundingBox)[ii];
+      std::string imageAbsolutePath = job->directory->string() + "/" + imageName;
+      if (!readFile(imageAbsolutePath, &buffer))
       {
-        std::string imageAbsolutePath = directory.string() + "/" + annotatedImages[ii];
-        image = cv::imread(imageAbsolutePath);
-        if (!image.data)
+        boost::mutex::scoped_lock lock(job->mutex);
+        std::cout << "Error reading file " << imageName << std::endl;
+        continue;
+      }
+
+      // The same region of the same file content gives the same features,
+      // whatever the name of the file.
+      uint64_t key = 0;
+      if (job->cache != NULL)
+      {
+        const int roiValues[4] = {roi.x, roi.y, roi.width, roi.height};
+        key = FeatureCache::hash(&buffer[0], buffer.size());
+        key = FeatureCache::hash(roiValues, sizeof(roiValues), key);
+        if (job->cache->find(key, job->featuresMat->ptr<double>(ii)))
         {
-          std::cout << "Error reading file " << annotatedImages[ii] << std::endl;
+          boost::mutex::scoped_lock lock(job->mutex);
+          job->numCached++;
           continue;
         }
+      }
 
-        imageROI = image(boundingBox[ii]);
-        extractFeatures(imageROI);
-
-        std::cout << "Feature vector of image " << annotatedImages[ii]
-                  << ": Size = " << featureVector_.size()
-                  << ", Class = " << classAttributes[ii] << std::endl;
+      cv::Mat image = cv::imdecode(buffer, CV_LOAD_IMAGE_COLOR);
+      if (!image.data)
+      {
+        boost::mutex::scoped_lock lock(job->mutex);
+        std::cout << "Error reading file " << imageName << std::endl;
+        continue;
+      }
 
-        for (int jj = 0; jj < featureVector_.size(); jj++)
-          featuresMat->at<double>(ii, jj) = featureVector_[jj];
+      cv::Mat imageROI = image(roi);
+      if (job->serialize)
+      {
+        boost::mutex::scoped_lock lock(job->extractionMutex);
+        extractFeatures(imageROI, &featureVector);
       }
-    }
-    else
-    {
-      std::cout << "Unsuccessful annotations file load. Exiting!";
-      exit(1);
+      else
+      {
+        extractFeatures(imageROI, &featureVector);
+      }
+
+      double* featuresRow = job->featuresMat->ptr<double>(ii);
+      int numValues = std::min(static_cast<int>(featureVector.size()),
+          job->featuresMat->cols);
+      std::copy(featureVector.begin(), featureVector.begin() + numValues,
+          featuresRow);
+      if (job->cache != NULL)
+        job->cache->insert(key, featureVector);
+
+      boost::mutex::scoped_lock lock(job->mutex);
+      job->numExtracted++;
+      std::cout << "Feature vector of image " << imageName
+                << ": Size = " << featureVector.size()
+                << ", Class = " << (*job->classAttributes)[ii] << std::endl;
     }
   }
 
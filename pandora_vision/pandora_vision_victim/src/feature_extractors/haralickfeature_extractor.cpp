@@ -510,6 +510,206 @@ namespace pandora_vision_victim
     *feat2 = f13;
   }
 
+  namespace
+  {
+    /**
+     * @brief Adds a pair of gray levels to the symmetric co-occurrence counts
+     * of a direction, noting the counts that stop being zero.
+     * @param first [int] The gray level of the first pixel
+     * @param second [int] The gray level of the second pixel
+     * @param counts [unsigned int*] The counts of the direction
+     * @param nonZero [std::vector<int>*] The indices of the non-zero counts
+     * @return void
+     */
+    inline void addPair(int first, int second, unsigned int* counts,
+        std::vector<int>* nonZero)
+    {
+      const int levels = HaralickFeaturesExtractor::NUM_GRAY_LEVELS;
+      int index = first * levels + second;
+      if (counts[index] == 0)
+        nonZero->push_back(index);
+      if (first == second)
+      {
+        counts[index] += 2;
+        return;
+      }
+      counts[index] += 1;
+
+      int transposed = second * levels + first;
+      if (counts[transposed] == 0)
+        nonZero->push_back(transposed);
+      counts[transposed] += 1;
+    }
+
+    /**
+     * @brief Function for calculating the entropy of a distribution
+     * @param p [const std::vector<double>&] The distribution
+     * @return [double] The entropy
+     */
+    double entropyOf(const std::vector<double>& p)
+    {
+      double sum = 0;
+      for (int i = 0; i < p.size(); i++)
+      {
+        if (p[i] != 0)
+          sum += p[i] * log(p[i]);
+      }
+      return -sum;
+    }
+  }  // namespace
+
+  HaralickFeaturesExtractor::GLCMCounts::GLCMCounts()
+  {
+    for (int ii = 0; ii < NUM_DIRECTIONS; ii++)
+    {
+      counts[ii].assign(NUM_GRAY_LEVELS * NUM_GRAY_LEVELS, 0);
+      total[ii] = 0;
+    }
+  }
+
+  /**
+   * @brief Function for calculating the co-occurrence counts of all
+   * directions in a single pass over the image.
+   * @param in [cv::Mat&] A grayscale image with 8 bit values.
+   * @param glcm [GLCMCounts*] The counts, which must be empty.
+   * @return void
+   */
+  void HaralickFeaturesExtractor::calculateGLCMCounts(const cv::Mat& in,
+      GLCMCounts* glcm)
+  {
+    // The directions of findHaralickFeatures: (x, y + 1), (x + 1, y),
+    // (x + 1, y + 1) and (x + 1, y - 1)
+    unsigned int* down = &glcm->counts[0][0];
+    unsigned int* right = &glcm->counts[1][0];
+    unsigned int* downRight = &glcm->counts[2][0];
+    unsigned int* upRight = &glcm->counts[3][0];
+
+    for (int y = 0; y < in.rows; y++)
+    {
+      const uchar* row = in.ptr<uchar>(y);
+      const uchar* below = (y + 1 < in.rows) ? in.ptr<uchar>(y + 1) : NULL;
+      const uchar* above = (y > 0) ? in.ptr<uchar>(y - 1) : NULL;
+
+      for (int x = 0; x < in.cols; x++)
+      {
+        int level = row[x];
+
+        if (below != NULL)
+          addPair(level, below[x], down, &glcm->nonZero[0]);
+
+        if (x + 1 < in.cols)
+        {
+          addPair(level, row[x + 1], right, &glcm->nonZero[1]);
+          if (below != NULL)
+            addPair(level, below[x + 1], downRight, &glcm->nonZero[2]);
+          if (above != NULL)
+            addPair(level, above[x + 1], upRight, &glcm->nonZero[3]);
+        }
+      }
+    }
+
+    // Each pair is counted in both orders
+    glcm->total[0] = 2 * (in.rows - 1) * in.cols;
+    glcm->total[1] = 2 * in.rows * (in.cols - 1);
+    glcm->total[2] = 2 * (in.rows - 1) * (in.cols - 1);
+    glcm->total[3] = glcm->total[2];
+  }
+
+  /**
+   * @brief Function for calculating all the Haralick features of a
+   * direction in a single sweep over its non-zero co-occurrence counts.
+   * The features are those of the getX functions above, in the order
+   * of findHaralickFeatures.
+   * @param glcm [GLCMCounts&] The co-occurrence counts
+   * @param direction [int] The direction
+   * @param features [double*] The NUM_HARALICK_FEATURES features
+   * @return void
+   */
+  void HaralickFeaturesExtractor::getHaralickStatistics(const GLCMCounts& glcm,
+      int direction, double* features)
+  {
+    const std::vector<unsigned int>& counts = glcm.counts[direction];
+    const std::vector<int>& nonZero = glcm.nonZero[direction];
+    const double norm = 1.0 / glcm.total[direction];
+
+    double angularSecondMoment = 0;
+    double contrast = 0;
+    double entropy = 0;
+    double mean = 0;
+    double squaresMean = 0;
+    double productsMean = 0;
+    double homogeneity = 0;
+
+    // The distributions of the sum and of the absolute difference of the
+    // gray levels, and the marginal distribution, the same for both axes
+    std::vector<double> sums(2 * NUM_GRAY_LEVELS - 1, 0.0);
+    std::vector<double> differences(NUM_GRAY_LEVELS, 0.0);
+    std::vector<double> marginal(NUM_GRAY_LEVELS, 0.0);
+
+    for (int ii = 0; ii < nonZero.size(); ii++)
+    {
+      int y = nonZero[ii] / NUM_GRAY_LEVELS;
+      int x = nonZero[ii] % NUM_GRAY_LEVELS;
+      double p = counts[nonZero[ii]] * norm;
+      double difference = y - x;
+
+      angularSecondMoment += p * p;
+      contrast += difference * difference * p;
+      entropy -= p * log(p);
+      mean += y * p;
+      squaresMean += static_cast<double>(y) * y * p;
+      productsMean += static_cast<double>(y) * x * p;
+      homogeneity += p / (1.0 + difference * difference);
+
+      sums[x + y] += p;
+      differences[abs(y - x)] += p;
+      marginal[y] += p;
+    }
+
+    double variance = squaresMean - mean * mean;
+    double correlation = (productsMean - mean * mean) / variance;
+
+    double sumAverage = 0;
+    for (int i = 0; i < sums.size(); i++)
+      sumAverage += i * sums[i];
+
+    double sumVariance = 0;
+    for (int i = 0; i < sums.size(); i++)
+      sumVariance += (i - sumAverage) * (i - sumAverage) * sums[i];
+
+    double differenceAverage = 0;
+    for (int i = 0; i < differences.size(); i++)
+      differenceAverage += i * differences[i];
+
+    double differenceVariance = 0;
+    for (int i = 0; i < differences.size(); i++)
+    {
+      differenceVariance += (i - differenceAverage) * (i - differenceAverage)
+        * differences[i];
+    }
+
+    // The GLCM is symmetric, so HX equals HY. Both HXY1 and HXY2, the
+    // entropies of p(i, j) and of px(i) * py(j) against log(px(i) * py(j)),
+    // sum up to HX + HY
+    double marginalEntropy = entropyOf(marginal);
+    double marginalsEntropy = 2 * marginalEntropy;
+
+    features[0] = angularSecondMoment;
+    features[1] = contrast;
+    features[2] = entropy;
+    features[3] = variance;
+    features[4] = correlation;
+    features[5] = homogeneity;
+    features[6] = sumAverage;
+    features[7] = sumVariance;
+    features[8] = entropyOf(sums);
+    features[9] = differenceVariance;
+    features[10] = entropyOf(differences);
+    features[11] = (entropy - marginalsEntropy) / marginalEntropy;
+    features[12] = sqrt(std::max(0.0,
+          1 - exp(-2 * (marginalsEntropy - entropy))));
+  }
+
   /**
    * @brief This is the main function called to extract haralick features
    * @param image [cv::Mat&] The current frame to be processed
@@ -519,51 +719,27 @@ namespace pandora_vision_victim
    */
   void HaralickFeaturesExtractor::findHaralickFeatures(const cv::Mat& image, std::vector<double>* haralickFeatures)
   {
-    // ROS_INFO("ENTER FIND HARALICK");
-    cv::Mat temp = cv::Mat(image.rows, image.cols, CV_8UC1);
-    cv::Mat out;
-    const int arrayLength = 4;
-    const int xOffset[4] = {0, 1, 1, 1};
-    const int yOffset[arrayLength] = {1, 0, 1, -1};
-    const int numHaralickFeatures = 13;
-    double haralickFeaturesArray[numHaralickFeatures] = {0.0};
-
-    for (int ii = 0; ii < arrayLength; ii++)
-    {
-      if (image.channels() != 1)
-      {
-        cv::cvtColor(image, temp, CV_BGR2GRAY);
-        out = calculateGLCM(xOffset[ii], yOffset[ii], temp);
-      }
-      else
-      {
-        out = calculateGLCM(xOffset[ii], yOffset[ii], image);
-      }
+    cv::Mat gray = image;
+    if (image.channels() != 1)
+      cv::cvtColor(image, gray, CV_BGR2GRAY);
 
-      haralickFeaturesArray[0] += getAngularSecondMoment(out);
-      haralickFeaturesArray[1] += getContrast(out);
-      haralickFeaturesArray[2] += getEntropy(out);
-      haralickFeaturesArray[3] += getVariance(out);
-      haralickFeaturesArray[4] += getCorrelation(out);
-      haralickFeaturesArray[5] += getHomogeneity(out);
-      double f7 = getSumAverage(out);
-      haralickFeaturesArray[6] += f7;
-      haralickFeaturesArray[7] += getSumVariance(out, f7);
-      haralickFeaturesArray[8] += getSumEntropy(out);
-      haralickFeaturesArray[9] += getDifferenceVariance(out);
-      haralickFeaturesArray[10] += getDifferenceEntropy(out);
+    GLCMCounts glcm;
+    calculateGLCMCounts(gray, &glcm);
 
-      double feat1, feat2;
-      getInfoMeasuresCorr(out, &feat1, &feat2);
-      haralickFeaturesArray[11] += feat1;
-      haralickFeaturesArray[12] += feat2;
+    double haralickFeaturesArray[NUM_HARALICK_FEATURES] = {0.0};
+    for (int ii = 0; ii < NUM_DIRECTIONS; ii++)
+    {
+      double features[NUM_HARALICK_FEATURES];
+      getHaralickStatistics(glcm, ii, features);
+      for (int jj = 0; jj < NUM_HARALICK_FEATURES; jj++)
+        haralickFeaturesArray[jj] += features[jj];
     }
-    for (int ii = 0; ii < numHaralickFeatures; ii++)
+    for (int ii = 0; ii < NUM_HARALICK_FEATURES; ii++)
     {
-      haralickFeatures->push_back(haralickFeaturesArray[ii] / arrayLength);
+      haralickFeatures->push_back(haralickFeaturesArray[ii] / NUM_DIRECTIONS);
     }
 
-    if (haralickFeatures->size() != numHaralickFeatures)
+    if (haralickFeatures->size() != NUM_HARALICK_FEATURES)
     {
       ROS_FATAL("Clean the vector:HARALICK");
       ROS_INFO_STREAM("vector's size"<< haralickFeatures->size() );
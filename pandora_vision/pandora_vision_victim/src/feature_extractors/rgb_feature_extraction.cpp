@@ -103,6 +103,8 @@ namespace pandora_vision_victim
 
     dictionarySize_ = static_cast<int>(classifierNode["dictionary_size"]);
 
+    loadExtractionParameters(paramFile, classifierNode);
+
     fs.release();
 
 
@@ -136,7 +138,7 @@ namespace pandora_vision_victim
     {
       boost::shared_ptr<FeatureExtractorFactory> histPtr(new
         HistogramExtractor(fs));
-      featureFactoryPtrMap_["histogram"] = histPtr;
+      featureFactoryPtrMap_["color_histograms"] = histPtr;
     }
 
     if (extractHaralickFeatures)
@@ -164,22 +166,79 @@ namespace pandora_vision_victim
    * @brief This function extracts features from RGB images according to
    * a predefined set of feature extraction algorithms.
    * @param inImage [const cv::Mat&] RGB frame to extract features from.
+   * @param featureVector [std::vector<double>*] The extracted features.
+   * @return void
+   */
+  void RgbFeatureExtraction::extractFeatures(const cv::Mat& inImage,
+      std::vector<double>* featureVector)
+  {
+    extractRegionFeatures(inImage, NULL, featureVector);
+  }
+
+  /**
+   * @brief This function extracts features from several regions of a RGB
+   * frame, with the channels statistics taken from the integral images of
+   * the whole frame.
+   * @param frame [const cv::Mat&] The frame the regions belong to.
+   * @param regions [const std::vector<cv::Rect>&] The regions to extract
+   * features from.
+   * @param featureVectors [std::vector<std::vector<double> >*] The
+   * extracted features of each region.
    * @return void
    */
-  void RgbFeatureExtraction::extractFeatures(const cv::Mat& inImage)
+  void RgbFeatureExtraction::extractFeatures(const cv::Mat& frame,
+      const std::vector<cv::Rect>& regions,
+      std::vector<std::vector<double> >* featureVectors)
+  {
+    if (chosenFeatureTypesMap_["channels_statistics"] == false)
+    {
+      FeatureExtraction::extractFeatures(frame, regions, featureVectors);
+      return;
+    }
+
+    ChannelsStatisticsFrame statisticsFrame;
+    statisticsFrame.setColorFrame(frame);
+    featureVectors->resize(regions.size());
+    for (int ii = 0; ii < regions.size(); ii++)
+    {
+      std::vector<double> channelsStatisticsFeatureVector;
+      ChannelsStatisticsExtractor::findColorChannelsStatisticsFeatures(
+          statisticsFrame, regions[ii], &channelsStatisticsFeatureVector);
+      extractRegionFeatures(frame(regions[ii]),
+          &channelsStatisticsFeatureVector, &(*featureVectors)[ii]);
+    }
+  }
+
+  /**
+   * @brief This function extracts features from a RGB image, using the
+   * given channels statistics if there are any.
+   * @param inImage [const cv::Mat&] RGB frame to extract features from.
+   * @param channelsStatisticsFeatureVector [const std::vector<double>*] The
+   * channels statistics of the image, or NULL if they are to be computed
+   * from the image.
+   * @param featureVector [std::vector<double>*] The extracted features.
+   * @return void
+   */
+  void RgbFeatureExtraction::extractRegionFeatures(const cv::Mat& inImage,
+      const std::vector<double>* channelsStatisticsFeatureVector,
+      std::vector<double>* featureVector)
   {
     /// Clear feature vector
-    if (!featureVector_.empty())
-      featureVector_.clear();
+    featureVector->clear();
     if (chosenFeatureTypesMap_["channels_statistics"] == true)
     {
       /// Extract Color Statistics features from RGB image
-      std::vector<double> channelsStatisticsFeatureVector;
-      ChannelsStatisticsExtractor::findColorChannelsStatisticsFeatures(inImage,
-          &channelsStatisticsFeatureVector);
+      std::vector<double> ownChannelsStatisticsFeatureVector;
+      if (channelsStatisticsFeatureVector == NULL)
+      {
+        ChannelsStatisticsExtractor::findColorChannelsStatisticsFeatures(inImage,
+            &ownChannelsStatisticsFeatureVector);
+        channelsStatisticsFeatureVector = &ownChannelsStatisticsFeatureVector;
+      }
       /// Append Color Statistics features to RGB feature vector.
-      for (int ii = 0; ii < channelsStatisticsFeatureVector.size(); ii++)
-        featureVector_.push_back(channelsStatisticsFeatureVector[ii]);
+      featureVector->insert(featureVector->end(),
+          channelsStatisticsFeatureVector->begin(),
+          channelsStatisticsFeatureVector->end());
     }
 
 
@@ -191,7 +250,7 @@ namespace pandora_vision_victim
           &edgeOrientationFeatureVector);
       /// Append Edge Orientation features to RGB feature vector.
       for (int ii = 0; ii < edgeOrientationFeatureVector.size(); ii++)
-        featureVector_.push_back(edgeOrientationFeatureVector[ii]);
+        featureVector->push_back(edgeOrientationFeatureVector[ii]);
     }
 
     if (chosenFeatureTypesMap_["haralick"] == true)
@@ -202,7 +261,7 @@ namespace pandora_vision_victim
           &haralickFeatureVector);
       /// Append Haralick features to RGB feature vector.
       for (int ii = 0; ii < haralickFeatureVector.size(); ii++)
-        featureVector_.push_back(haralickFeatureVector[ii]);
+        featureVector->push_back(haralickFeatureVector[ii]);
     }
 
     if (chosenFeatureTypesMap_["sift"] == true)
@@ -214,12 +273,12 @@ namespace pandora_vision_victim
         bowTrainerPtr_->plotDescriptor(siftDescriptors);
       /// Append SIFT features to RGB feature vector.
       for (int ii = 0; ii < siftDescriptors.cols; ii++)
-        featureVector_.push_back(siftDescriptors.at<float>(ii));
+        featureVector->push_back(siftDescriptors.at<float>(ii));
       if (siftDescriptors.cols == 0)
       {
         for (int ii = 0; ii < dictionarySize_; ii++)
         {
-          featureVector_.push_back(0.0);
+          featureVector->push_back(0.0);
         }
       }
     }
@@ -230,7 +289,7 @@ namespace pandora_vision_victim
       featureFactoryPtrMap_["hog"]->extractFeatures(inImage, &hogDescriptors);
       /// Append HOG features to RGB feature vector.
       for (int ii = 0; ii < hogDescriptors.size(); ii++)
-        featureVector_.push_back(hogDescriptors.at(ii));
+        featureVector->push_back(hogDescriptors.at(ii));
     }
     if (chosenFeatureTypesMap_["color_histograms"] == true)
     {
@@ -243,7 +302,7 @@ namespace pandora_vision_victim
         featureFactoryPtrMap_["color_histograms"]->plotFeatures(
             colorHistogramFeatures);
        for (int ii = 0; ii < colorHistogramFeatures.cols; ii++)
-         featureVector_.push_back(colorHistogramFeatures.at<float>(ii));
+         featureVector->push_back(colorHistogramFeatures.at<float>(ii));
     }
   }
 }  // namespace pandora_vision_victim
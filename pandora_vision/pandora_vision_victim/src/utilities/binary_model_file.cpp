@@ -0,0 +1,326 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "pandora_vision_victim/utilities/binary_model_file.h"
+
+/**
+ * @namespace pandora_vision
+ * @brief The main namespace for PANDORA vision
+ */
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+namespace
+{
+  // The magic of the binary training matrices, which held a single unnamed
+  // matrix and no version. Those count as version 1 and are not read.
+  const char MODEL_MAGIC[4] = {'P', 'V', 'M', 'B'};
+  const uint32_t MODEL_VERSION = 2;
+  const size_t MAX_NAME_LENGTH = 48;
+  const size_t DATA_ALIGNMENT = 8;
+
+  /**
+   * @brief The header of a binary model file. It is followed by numEntries
+   * entries, in native byte order.
+   */
+  struct ModelHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint32_t numEntries;
+    uint32_t reserved;
+  };
+
+  /**
+   * @brief The header of an entry of a binary model file. It is followed by
+   * the rows * cols elements of the matrix, padded to DATA_ALIGNMENT bytes.
+   */
+  struct EntryHeader
+  {
+    char name[MAX_NAME_LENGTH];
+    int32_t type;
+    int32_t rows;
+    int32_t cols;
+    uint32_t reserved;
+  };
+
+  /**
+   * @brief The size of the data of an entry, including its padding.
+   */
+  size_t paddedDataSize(int type, int rows, int cols)
+  {
+    size_t dataSize = static_cast<size_t>(rows) * cols * CV_ELEM_SIZE(type);
+    return (dataSize + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+  }
+}  // namespace
+
+  /**
+   * @brief Maps the file and indexes its matrices, if it is a binary model
+   * file of a version that can be read.
+   * @param fileName [const std::string&] The path of the file.
+   */
+  BinaryModelFile::BinaryModelFile(const std::string& fileName)
+    : mapping_(NULL), mappingSize_(0)
+  {
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 ||
+        static_cast<size_t>(fileStat.st_size) < sizeof(ModelHeader))
+    {
+      close(fd);
+      return;
+    }
+    size_t fileSize = fileStat.st_size;
+    void* mapping = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+      return;
+
+    mapping_ = mapping;
+    mappingSize_ = fileSize;
+
+    const ModelHeader* header = static_cast<const ModelHeader*>(mapping);
+    if (std::memcmp(header->magic, MODEL_MAGIC, sizeof(MODEL_MAGIC)) != 0 ||
+        header->version != MODEL_VERSION)
+    {
+      std::cout << fileName << " is not a binary model file of version "
+                << MODEL_VERSION << "." << std::endl;
+      unmap();
+      return;
+    }
+
+    char* data = static_cast<char*>(mapping);
+    size_t offset = sizeof(ModelHeader);
+    for (uint32_t ii = 0; ii < header->numEntries; ii++)
+    {
+      if (fileSize - offset < sizeof(EntryHeader))
+        break;
+      const EntryHeader* entry =
+        reinterpret_cast<const EntryHeader*>(data + offset);
+      offset += sizeof(EntryHeader);
+
+      if (entry->type != CV_MAT_TYPE(entry->type) ||
+          entry->rows < 0 || entry->cols < 0)
+        break;
+      size_t dataSize = paddedDataSize(entry->type, entry->rows, entry->cols);
+      if (fileSize - offset < dataSize)
+        break;
+
+      std::string name(entry->name,
+          strnlen(entry->name, MAX_NAME_LENGTH));
+      if (entry->rows > 0 && entry->cols > 0)
+        index_[name] = cv::Mat(entry->rows, entry->cols, entry->type,
+            data + offset);
+      else
+        index_[name] = cv::Mat();
+      offset += dataSize;
+    }
+
+    if (index_.size() != header->numEntries)
+    {
+      std::cout << fileName << " is truncated or corrupted." << std::endl;
+      unmap();
+    }
+  }
+
+  /**
+   * @brief Destructor. Unmaps the file.
+   */
+  BinaryModelFile::~BinaryModelFile()
+  {
+    unmap();
+  }
+
+  /**
+   * @brief Returns a matrix of the file, as a header over the mapped file.
+   * @param name [const std::string&] The name of the matrix.
+   * @return [cv::Mat] The matrix, or an empty matrix if the file has no
+   * matrix with this name.
+   */
+  cv::Mat BinaryModelFile::matrix(const std::string& name) const
+  {
+    std::map<std::string, cv::Mat>::const_iterator it = index_.find(name);
+    if (it == index_.end())
+      return cv::Mat();
+    return it->second;
+  }
+
+  /**
+   * @brief Writes a set of matrices to a binary model file, under a
+   * temporary name that is renamed into place.
+   * @param fileName [const std::string&] The path of the file.
+   * @param nameVec [const std::vector<std::string>&] The names of the
+   * matrices.
+   * @param matVec [const std::vector<cv::Mat>&] The matrices.
+   * @return [bool] Whether the file was written successfully.
+   */
+  bool BinaryModelFile::write(const std::string& fileName,
+      const std::vector<std::string>& nameVec,
+      const std::vector<cv::Mat>& matVec)
+  {
+    if (nameVec.size() != matVec.size())
+    {
+      std::cout << "ERROR: Name vector and data vector have different size"
+                << std::endl;
+      return false;
+    }
+    for (size_t ii = 0; ii < nameVec.size(); ii++)
+    {
+      if (nameVec[ii].size() >= MAX_NAME_LENGTH || matVec[ii].dims > 2)
+      {
+        std::cout << "ERROR: Matrix " << nameVec[ii]
+                  << " cannot be saved in a binary model file" << std::endl;
+        return false;
+      }
+    }
+
+    const std::string tempFileName = fileName + ".tmp";
+    std::ofstream out(tempFileName.c_str(),
+        std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!out)
+    {
+      std::cout << "Cannot write binary model file " << tempFileName
+                << std::endl;
+      return false;
+    }
+
+    ModelHeader header;
+    std::memcpy(header.magic, MODEL_MAGIC, sizeof(MODEL_MAGIC));
+    header.version = MODEL_VERSION;
+    header.numEntries = nameVec.size();
+    header.reserved = 0;
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const char padding[DATA_ALIGNMENT] = {0};
+    for (size_t ii = 0; ii < nameVec.size(); ii++)
+    {
+      const cv::Mat& mat = matVec[ii];
+      EntryHeader entry;
+      std::memset(&entry, 0, sizeof(entry));
+      std::memcpy(entry.name, nameVec[ii].data(), nameVec[ii].size());
+      entry.type = mat.type();
+      entry.rows = mat.rows;
+      entry.cols = mat.cols;
+      out.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+
+      const size_t rowSize = mat.cols * mat.elemSize();
+      for (int jj = 0; jj < mat.rows; jj++)
+        out.write(reinterpret_cast<const char*>(mat.ptr(jj)), rowSize);
+      out.write(padding,
+          paddedDataSize(mat.type(), mat.rows, mat.cols) - mat.rows * rowSize);
+    }
+    out.close();
+    if (!out)
+    {
+      std::cout << "Cannot write binary model file " << tempFileName
+                << std::endl;
+      std::remove(tempFileName.c_str());
+      return false;
+    }
+
+    if (std::rename(tempFileName.c_str(), fileName.c_str()) != 0)
+    {
+      std::cout << "Cannot replace binary model file " << fileName
+                << std::endl;
+      std::remove(tempFileName.c_str());
+      return false;
+    }
+    return true;
+  }
+
+  /**
+   * @brief Checks whether a file starts with the header of a binary model
+   * file.
+   * @param fileName [const std::string&] The path of the file.
+   * @return [bool] Whether the file is a binary model file.
+   */
+  bool BinaryModelFile::isBinaryModelFile(const std::string& fileName)
+  {
+    std::ifstream in(fileName.c_str(), std::ifstream::in | std::ifstream::binary);
+    char magic[sizeof(MODEL_MAGIC)];
+    if (!in.read(magic, sizeof(magic)))
+      return false;
+    return std::memcmp(magic, MODEL_MAGIC, sizeof(MODEL_MAGIC)) == 0;
+  }
+
+  /**
+   * @brief Returns the name of the binary counterpart of a FileStorage file.
+   * @param fileName [const std::string&] The path of the FileStorage file.
+   * @return [std::string] The path of the binary model file.
+   */
+  std::string BinaryModelFile::binaryFileName(const std::string& fileName)
+  {
+    boost::filesystem::path path(fileName);
+    return path.replace_extension(".bin").string();
+  }
+
+  /**
+   * @brief Unmaps the file and clears its index.
+   * @return void
+   */
+  void BinaryModelFile::unmap()
+  {
+    index_.clear();
+    if (mapping_ != NULL)
+      munmap(mapping_, mappingSize_);
+    mapping_ = NULL;
+    mappingSize_ = 0;
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
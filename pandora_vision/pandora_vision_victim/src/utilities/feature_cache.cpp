@@ -0,0 +1,311 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <boost/unordered_set.hpp>
+
+#include "pandora_vision_victim/utilities/feature_cache.h"
+
+/**
+ * @namespace pandora_vision
+ * @brief The main namespace for PANDORA vision
+ */
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+namespace
+{
+  const char CACHE_MAGIC[4] = {'P', 'V', 'F', 'C'};
+  const uint32_t CACHE_VERSION = 1;
+
+  /**
+   * @brief The header of a cache file. It is followed by numRecords records,
+   * each a uint64_t key and numFeatures doubles, in native byte order.
+   */
+  struct CacheHeader
+  {
+    char magic[4];
+    uint32_t version;
+    uint64_t configurationKey;
+    uint32_t numFeatures;
+    uint32_t reserved;
+    uint64_t numRecords;
+  };
+
+  /**
+   * @brief Writes a record of a cache file.
+   */
+  void writeRecord(std::ofstream* out, uint64_t key, const double* values,
+      int numFeatures)
+  {
+    out->write(reinterpret_cast<const char*>(&key), sizeof(key));
+    out->write(reinterpret_cast<const char*>(values),
+        numFeatures * sizeof(double));
+  }
+}  // namespace
+
+  /**
+   * @brief Opens the cache file, if it exists and was written with the
+   * same configuration and feature vector size.
+   * @param fileName [const std::string&] The path of the cache file.
+   * @param configurationKey [uint64_t] A hash of the extractor
+   * configuration that produced the feature vectors.
+   * @param numFeatures [int] The size of the feature vectors.
+   */
+  FeatureCache::FeatureCache(const std::string& fileName,
+      uint64_t configurationKey, int numFeatures)
+    : fileName_(fileName), configurationKey_(configurationKey),
+      numFeatures_(numFeatures), mapping_(NULL), mappingSize_(0)
+  {
+    map();
+  }
+
+  /**
+   * @brief Destructor. Unmaps the cache file.
+   */
+  FeatureCache::~FeatureCache()
+  {
+    unmap();
+  }
+
+  /**
+   * @brief Computes the 64 bit FNV-1a hash of a block of memory.
+   * @param data [const void*] The block of memory.
+   * @param size [size_t] Its size in bytes.
+   * @param seed [uint64_t] The hash to continue from.
+   * @return [uint64_t] The hash.
+   */
+  uint64_t FeatureCache::hash(const void* data, size_t size, uint64_t seed)
+  {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t ii = 0; ii < size; ii++)
+    {
+      hash ^= bytes[ii];
+      hash *= 1099511628211ULL;
+    }
+    return hash;
+  }
+
+  /**
+   * @brief Copies the feature vector stored under a key.
+   * @param key [uint64_t] The key of the feature vector.
+   * @param featureVector [double*] Where the feature vector is copied to.
+   * @return [bool] Whether the key was found in the cache file.
+   */
+  bool FeatureCache::find(uint64_t key, double* featureVector) const
+  {
+    boost::unordered_map<uint64_t, const double*>::const_iterator it =
+      index_.find(key);
+    if (it == index_.end())
+      return false;
+    std::memcpy(featureVector, it->second, numFeatures_ * sizeof(double));
+    return true;
+  }
+
+  /**
+   * @brief Stores a feature vector, to be written by the next save().
+   * @param key [uint64_t] The key of the feature vector.
+   * @param featureVector [const std::vector<double>&] The feature vector.
+   * @return void
+   */
+  void FeatureCache::insert(uint64_t key,
+      const std::vector<double>& featureVector)
+  {
+    if (featureVector.size() != static_cast<size_t>(numFeatures_))
+      return;
+    boost::mutex::scoped_lock lock(mutex_);
+    insertedKeys_.push_back(key);
+    insertedValues_.insert(insertedValues_.end(), featureVector.begin(),
+        featureVector.end());
+  }
+
+  /**
+   * @brief Rewrites the cache file with the mapped and the inserted
+   * feature vectors and maps it again.
+   * @return [bool] Whether the file was written successfully.
+   */
+  bool FeatureCache::save()
+  {
+    boost::mutex::scoped_lock lock(mutex_);
+    if (insertedKeys_.empty())
+      return true;
+
+    // Records of the mapped file come first, in their order, followed by
+    // the inserted ones that are new.
+    boost::unordered_set<uint64_t> written;
+    std::vector<size_t> newRecords;
+    for (size_t ii = 0; ii < insertedKeys_.size(); ii++)
+    {
+      if (index_.find(insertedKeys_[ii]) == index_.end() &&
+          written.insert(insertedKeys_[ii]).second)
+        newRecords.push_back(ii);
+    }
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.configurationKey = configurationKey_;
+    header.numFeatures = numFeatures_;
+    header.reserved = 0;
+    header.numRecords = index_.size() + newRecords.size();
+
+    const std::string tempFileName = fileName_ + ".tmp";
+    std::ofstream out(tempFileName.c_str(),
+        std::ofstream::out | std::ofstream::binary | std::ofstream::trunc);
+    if (!out)
+    {
+      std::cout << "Cannot write feature cache " << tempFileName << std::endl;
+      return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    const size_t recordSize = sizeof(uint64_t) + numFeatures_ * sizeof(double);
+    const char* records = static_cast<const char*>(mapping_) + sizeof(header);
+    for (size_t ii = 0; ii < index_.size(); ii++)
+    {
+      const char* record = records + ii * recordSize;
+      uint64_t key;
+      std::memcpy(&key, record, sizeof(key));
+      writeRecord(&out, key,
+          reinterpret_cast<const double*>(record + sizeof(key)), numFeatures_);
+    }
+    for (size_t ii = 0; ii < newRecords.size(); ii++)
+    {
+      size_t record = newRecords[ii];
+      writeRecord(&out, insertedKeys_[record],
+          &insertedValues_[record * numFeatures_], numFeatures_);
+    }
+    out.close();
+    if (!out)
+    {
+      std::cout << "Cannot write feature cache " << tempFileName << std::endl;
+      std::remove(tempFileName.c_str());
+      return false;
+    }
+
+    unmap();
+    if (std::rename(tempFileName.c_str(), fileName_.c_str()) != 0)
+    {
+      std::cout << "Cannot replace feature cache " << fileName_ << std::endl;
+      std::remove(tempFileName.c_str());
+    }
+    insertedKeys_.clear();
+    insertedValues_.clear();
+    map();
+    return true;
+  }
+
+  /**
+   * @brief Maps the cache file and indexes its records, unless it belongs
+   * to another configuration.
+   * @return void
+   */
+  void FeatureCache::map()
+  {
+    int fd = open(fileName_.c_str(), O_RDONLY);
+    if (fd < 0)
+      return;
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 ||
+        static_cast<size_t>(fileStat.st_size) < sizeof(CacheHeader))
+    {
+      close(fd);
+      return;
+    }
+    size_t fileSize = fileStat.st_size;
+    void* mapping = mmap(NULL, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+      return;
+
+    const CacheHeader* header = static_cast<const CacheHeader*>(mapping);
+    const size_t recordSize = sizeof(uint64_t) + numFeatures_ * sizeof(double);
+    if (std::memcmp(header->magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header->version != CACHE_VERSION ||
+        header->configurationKey != configurationKey_ ||
+        header->numFeatures != static_cast<uint32_t>(numFeatures_) ||
+        (fileSize - sizeof(CacheHeader)) / recordSize < header->numRecords)
+    {
+      std::cout << "Feature cache " << fileName_ << " belongs to another "
+                << "configuration and will be replaced." << std::endl;
+      munmap(mapping, fileSize);
+      return;
+    }
+
+    mapping_ = mapping;
+    mappingSize_ = fileSize;
+    const char* records = static_cast<const char*>(mapping) + sizeof(CacheHeader);
+    index_.rehash(header->numRecords);
+    for (uint64_t ii = 0; ii < header->numRecords; ii++)
+    {
+      const char* record = records + ii * recordSize;
+      uint64_t key;
+      std::memcpy(&key, record, sizeof(key));
+      index_[key] = reinterpret_cast<const double*>(record + sizeof(key));
+    }
+  }
+
+  /**
+   * @brief Unmaps the cache file and clears its index.
+   * @return void
+   */
+  void FeatureCache::unmap()
+  {
+    index_.clear();
+    if (mapping_ != NULL)
+      munmap(mapping_, mappingSize_);
+    mapping_ = NULL;
+    mappingSize_ = 0;
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
@@ -37,6 +37,7 @@
  *   Protopapas Marios <protopapas_marios@hotmail.com>
  *********************************************************************/
 
+#include <ctime>
 #include <vector>
 #include <string>
 #include <algorithm>
@@ -69,13 +70,13 @@ namespace file_utilities
     std::string filesDirectory = packagePath + "/data/";
 
     std::string varName = prefix + "features_mat";
-    saveToFile(featuresFileName, varName, featuresMat);
+    saveMatToBinaryFile(featuresFileName, varName, featuresMat);
 
     std::cout << "The path to the features files is : " << featuresFileName << std::endl;
     std::cout << "[Cols, Rows] = " << featuresMat.size() << std::endl;
 
     varName = prefix + "labels_mat";
-    saveToFile(labelsFileName, varName, labelsMat);
+    saveMatToBinaryFile(labelsFileName, varName, labelsMat);
 
     std::cout << "The path to the training labels files is : " << labelsFileName << std::endl;
     std::cout << "[Cols, Rows] = " << labelsMat.size() << std::endl;
@@ -183,6 +184,146 @@ namespace file_utilities
     }
   }
 
+  /**
+   * @brief Function that saves a matrix to a binary model file.
+   * @param fileName [const std::string&] The name of the file to be created.
+   * @param varName [const std::string&] The name of the matrix.
+   * @param src [const cv::Mat&] The matrix to be saved.
+   * @return [bool] Variable indicating whether the saving was successful or
+   * not.
+   */
+  bool saveMatToBinaryFile(const std::string& fileName,
+                           const std::string& varName,
+                           const cv::Mat& src)
+  {
+    return BinaryModelFile::write(fileName,
+        std::vector<std::string>(1, varName), std::vector<cv::Mat>(1, src));
+  }
+
+  /**
+   * @brief Function that saves a set of model parameters both in a
+   * FileStorage file and in its binary counterpart, i.e. the file with the
+   * same name and a .bin extension.
+   * @param fileName [const std::string&] The name of the FileStorage file to
+   * be created.
+   * @param varNameVec [const std::vector<std::string>&] The names of the
+   * matrices to be saved.
+   * @param dataVec [const std::vector<cv::Mat>&] The matrices to be saved.
+   * @return void
+   */
+  void saveModelToFile(const std::string& fileName,
+      const std::vector<std::string>& varNameVec,
+      const std::vector<cv::Mat>& dataVec)
+  {
+    saveDataToFile(fileName, varNameVec, dataVec);
+    BinaryModelFile::write(BinaryModelFile::binaryFileName(fileName),
+        varNameVec, dataVec);
+  }
+
+  /**
+   * @brief Function that loads a set of model parameters from a binary model
+   * file, without parsing. The given file is used if it is a binary model
+   * file itself; otherwise its binary counterpart is used, as long as it is
+   * at least as recent as the given file. The loaded matrices refer to the
+   * mapped file, which the caller keeps for as long as it uses them.
+   * @param fileName [const std::string&] The name of the file to be loaded.
+   * @param varNameVec [const std::vector<std::string>&] The names of the
+   * matrices to be loaded.
+   * @param dataVec [std::vector<cv::Mat>*] The loaded matrices.
+   * @param modelFilePtr [boost::shared_ptr<BinaryModelFile>*] The mapped
+   * binary model file, or NULL if none was loaded.
+   * @return [bool] Variable indicating whether a binary model file with all
+   * the matrices was found or not.
+   */
+  bool loadModelFromBinaryFile(const std::string& fileName,
+      const std::vector<std::string>& varNameVec,
+      std::vector<cv::Mat>* dataVec,
+      boost::shared_ptr<BinaryModelFile>* modelFilePtr)
+  {
+    dataVec->clear();
+    modelFilePtr->reset();
+
+    std::string binaryFileName = fileName;
+    if (!BinaryModelFile::isBinaryModelFile(fileName))
+    {
+      binaryFileName = BinaryModelFile::binaryFileName(fileName);
+      boost::system::error_code error;
+      std::time_t binaryTime = boost::filesystem::last_write_time(
+          binaryFileName, error);
+      if (error)
+        return false;
+      std::time_t fileTime = boost::filesystem::last_write_time(fileName, error);
+      if (!error && binaryTime < fileTime)
+      {
+        std::cout << binaryFileName << " is older than " << fileName
+                  << " and will be ignored." << std::endl;
+        return false;
+      }
+    }
+
+    boost::shared_ptr<BinaryModelFile> modelFile(
+        new BinaryModelFile(binaryFileName));
+    if (!modelFile->isOpen())
+      return false;
+    for (int ii = 0; ii < varNameVec.size(); ii++)
+    {
+      cv::Mat dataMat = modelFile->matrix(varNameVec[ii]);
+      if (!dataMat.data)
+      {
+        dataVec->clear();
+        return false;
+      }
+      dataVec->push_back(dataMat);
+    }
+    *modelFilePtr = modelFile;
+    return true;
+  }
+
+  /**
+   * @brief Function that loads a set of model parameters, from a binary
+   * model file if loadModelFromBinaryFile finds one and from the given
+   * FileStorage file otherwise.
+   * @param fileName [const std::string&] The name of the file to be loaded.
+   * @param varNameVec [const std::vector<std::string>&] The names of the
+   * matrices to be loaded.
+   * @param dataVec [std::vector<cv::Mat>*] The loaded matrices.
+   * @param modelFilePtr [boost::shared_ptr<BinaryModelFile>*] The mapped
+   * binary model file the matrices refer to, or NULL if they were read from
+   * the FileStorage file.
+   * @return [bool] Variable indicating whether all the matrices were found
+   * or not.
+   */
+  bool loadModelFromFile(const std::string& fileName,
+      const std::vector<std::string>& varNameVec,
+      std::vector<cv::Mat>* dataVec,
+      boost::shared_ptr<BinaryModelFile>* modelFilePtr)
+  {
+    if (loadModelFromBinaryFile(fileName, varNameVec, dataVec, modelFilePtr))
+      return true;
+    // FileStorage cannot parse a binary file, e.g. one of an older version.
+    if (BinaryModelFile::isBinaryModelFile(fileName) ||
+        boost::filesystem::extension(fileName) == ".bin")
+      return false;
+
+    cv::FileStorage fs;
+    if (!fs.open(fileName, cv::FileStorage::READ))
+      return false;
+    for (int ii = 0; ii < varNameVec.size(); ii++)
+    {
+      cv::Mat dataMat;
+      fs[varNameVec[ii]] >> dataMat;
+      if (!dataMat.data)
+      {
+        fs.release();
+        dataVec->clear();
+        return false;
+      }
+      dataVec->push_back(dataMat);
+    }
+    fs.release();
+    return true;
+  }
+
   /**
    * @brief Function that loads a set of descriptors to be used for training.
    * @param dataMatFile [const std::string&] The name of the file to read the
@@ -222,32 +363,42 @@ namespace file_utilities
   }
 
   /**
-  @brief Function that loads the necessary files for the training
+  @brief Function that loads the necessary files for the training, either
+  from FileStorage or from binary model files
   @param [std::string] training_mat_file, name of the file that contains the training data
   @param [std::string] labels_mat_file, name of the file that contains the labels of each class
   of the training data
+  @param [boost::shared_ptr<BinaryModelFile>*] modelFilePtr, the mapped binary model file the
+  loaded matrix may refer to. If it is NULL, the matrix never refers to a mapped file.
   @return void
   **/
   cv::Mat loadFiles(const std::string& dataMatFile,
-                    const std::string& nameTag)
+                    const std::string& nameTag,
+                    boost::shared_ptr<BinaryModelFile>* modelFilePtr)
   {
-    cv::FileStorage fs1;
+    std::vector<cv::Mat> dataVec;
+    boost::shared_ptr<BinaryModelFile> modelFile;
     cv::Mat dataMat;
-    fs1.open(dataMatFile, cv::FileStorage::READ);
-    fs1[nameTag] >> dataMat;
-    fs1.release();
+    if (loadModelFromFile(dataMatFile, std::vector<std::string>(1, nameTag),
+          &dataVec, &modelFile))
+      dataMat = dataVec[0];
 
     if (dataMat.data)
     {
       std::cout << dataMatFile << " was loaded successfully." << std::endl;
       std::cout << "Size = " << dataMat.size() << std::endl;
-      dataMat.convertTo(dataMat, CV_32FC1);
+      if (dataMat.type() != CV_32FC1)
+        dataMat.convertTo(dataMat, CV_32FC1);
+      else if (modelFile && modelFilePtr == NULL)
+        dataMat = dataMat.clone();
     }
     else
     {
       std::cout << dataMatFile << " was not loaded successfully."
                 << std::endl;
     }
+    if (modelFilePtr != NULL)
+      *modelFilePtr = modelFile;
     return dataMat;
   }
 
@@ -0,0 +1,196 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "pandora_vision_victim/utilities/file_utilities.h"
+#include "pandora_vision_victim/utilities/neural_network_model.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+namespace
+{
+  /**
+   * @brief The names of the matrices of a binary Neural Network model file.
+   * The activation holds the activation function and its two parameters,
+   * and the weights hold all the weight arrays of the network one after
+   * the other.
+   */
+  std::vector<std::string> modelMatrixNames()
+  {
+    std::vector<std::string> names;
+    names.push_back("layer_sizes");
+    names.push_back("activation");
+    names.push_back("weights");
+    return names;
+  }
+
+  /**
+   * @brief Computes the sizes of the weight arrays of a network, in the
+   * order CvANN_MLP::create lays them out: the input scale, the weights
+   * and biases of every layer, the output scale and the inverse output
+   * scale.
+   * @param layerSizes [const int*] The number of neurons of each layer.
+   * @param layerCount [int] The number of layers.
+   * @return [std::vector<int>] The number of weights in each array.
+   */
+  std::vector<int> weightCounts(const int* layerSizes, int layerCount)
+  {
+    std::vector<int> counts;
+    counts.push_back(2 * layerSizes[0]);
+    for (int ii = 1; ii < layerCount; ii++)
+      counts.push_back((layerSizes[ii - 1] + 1) * layerSizes[ii]);
+    counts.push_back(2 * layerSizes[layerCount - 1]);
+    counts.push_back(2 * layerSizes[layerCount - 1]);
+    return counts;
+  }
+}  // namespace
+
+  /**
+   * @brief This function saves the model in a FileStorage file and in its
+   * binary counterpart.
+   * @param fileName [const std::string&] The name of the FileStorage file.
+   * @return void
+   */
+  void NeuralNetworkModel::saveModel(const std::string& fileName) const
+  {
+    save(fileName.c_str());
+    if (layer_sizes == NULL || weights == NULL)
+      return;
+
+    const int layerCount = layer_sizes->cols;
+    std::vector<int> counts = weightCounts(layer_sizes->data.i, layerCount);
+
+    cv::Mat layerSizes(1, layerCount, CV_32SC1, layer_sizes->data.i);
+
+    cv::Mat activation(1, 3, CV_64FC1);
+    activation.at<double>(0) = activ_func;
+    activation.at<double>(1) = f_param1;
+    activation.at<double>(2) = f_param2;
+
+    cv::Mat weightsMat(1, std::accumulate(counts.begin(), counts.end(), 0),
+        CV_64FC1);
+    double* weight = weightsMat.ptr<double>(0);
+    for (size_t ii = 0; ii < counts.size(); ii++)
+    {
+      std::copy(weights[ii], weights[ii] + counts[ii], weight);
+      weight += counts[ii];
+    }
+
+    std::vector<cv::Mat> dataVec;
+    dataVec.push_back(layerSizes);
+    dataVec.push_back(activation);
+    dataVec.push_back(weightsMat);
+    BinaryModelFile::write(BinaryModelFile::binaryFileName(fileName),
+        modelMatrixNames(), dataVec);
+  }
+
+  /**
+   * @brief This function loads the model from the binary counterpart of a
+   * FileStorage file, if there is a recent one, and from the FileStorage
+   * file otherwise.
+   * @param fileName [const std::string&] The name of the FileStorage file.
+   * @return void
+   */
+  void NeuralNetworkModel::loadModel(const std::string& fileName)
+  {
+    std::vector<cv::Mat> dataVec;
+    boost::shared_ptr<BinaryModelFile> modelFile;
+    if (file_utilities::loadModelFromBinaryFile(fileName, modelMatrixNames(),
+          &dataVec, &modelFile) && setModel(dataVec))
+    {
+      modelFile_ = modelFile;
+      return;
+    }
+    load(fileName.c_str());
+    modelFile_.reset();
+  }
+
+  /**
+   * @brief This function rebuilds the model from the matrices of a binary
+   * model file, the way CvANN_MLP::read does from a FileStorage file.
+   * @param dataVec [const std::vector<cv::Mat>&] The matrices, in the order
+   * of the model's names.
+   * @return [bool] Variable indicating whether the matrices hold a valid
+   * model or not.
+   */
+  bool NeuralNetworkModel::setModel(const std::vector<cv::Mat>& dataVec)
+  {
+    const cv::Mat& layerSizes = dataVec[0];
+    const cv::Mat& activation = dataVec[1];
+    const cv::Mat& weightsMat = dataVec[2];
+
+    if (layerSizes.type() != CV_32SC1 || layerSizes.rows != 1 ||
+        layerSizes.cols < 2 || activation.type() != CV_64FC1 ||
+        activation.total() != 3 || weightsMat.type() != CV_64FC1)
+      return false;
+    const int layerCount = layerSizes.cols;
+    for (int ii = 0; ii < layerCount; ii++)
+      if (layerSizes.at<int>(ii) < 1)
+        return false;
+    std::vector<int> counts = weightCounts(layerSizes.ptr<int>(0), layerCount);
+    if (weightsMat.total() !=
+        static_cast<size_t>(std::accumulate(counts.begin(), counts.end(), 0)))
+      return false;
+    const int activationFunction = cvRound(activation.at<double>(0));
+    if (activationFunction != IDENTITY && activationFunction != SIGMOID_SYM &&
+        activationFunction != GAUSSIAN)
+      return false;
+
+    create(layerSizes, activationFunction, activation.at<double>(1),
+        activation.at<double>(2));
+
+    // CvANN_MLP::predict only reads the weights, so they are used in place
+    // instead of in the buffer that create allocated.
+    cvReleaseMat(&wbuf);
+    double* weight = const_cast<double*>(weightsMat.ptr<double>(0));
+    for (size_t ii = 0; ii < counts.size(); ii++)
+    {
+      weights[ii] = weight;
+      weight += counts[ii];
+    }
+    return true;
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
@@ -42,6 +42,8 @@
 #include <vector>
 #include <opencv2/opencv.hpp>
 
+#include "pandora_vision_victim/utilities/binary_model_file.h"
+#include "pandora_vision_victim/utilities/file_utilities.h"
 #include "pandora_vision_victim/utilities/platt_scaling.h"
 
 namespace pandora_vision
@@ -228,6 +230,19 @@ namespace pandora_vision_victim
 
   void PlattScaling::load(const std::string& fileName)
   {
+    std::vector<std::string> parameterNames;
+    parameterNames.push_back("A");
+    parameterNames.push_back("B");
+    std::vector<cv::Mat> parameters;
+    boost::shared_ptr<BinaryModelFile> modelFile;
+    if (file_utilities::loadModelFromBinaryFile(fileName, parameterNames,
+          &parameters, &modelFile))
+    {
+      A_ = parameters[0].at<double>(0, 0);
+      B_ = parameters[1].at<double>(0, 0);
+      return;
+    }
+
     cv::FileStorage fs(fileName, cv::FileStorage::READ);
     fs["A"] >> A_;
     fs["B"] >> B_;
@@ -240,6 +255,15 @@ namespace pandora_vision_victim
     fs << "A" << A_;
     fs << "B" << B_;
     fs.release();
+
+    std::vector<std::string> parameterNames;
+    parameterNames.push_back("A");
+    parameterNames.push_back("B");
+    std::vector<cv::Mat> parameters;
+    parameters.push_back(cv::Mat(1, 1, CV_64FC1, cv::Scalar(A_)));
+    parameters.push_back(cv::Mat(1, 1, CV_64FC1, cv::Scalar(B_)));
+    BinaryModelFile::write(BinaryModelFile::binaryFileName(fileName),
+        parameterNames, parameters);
   }
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
@@ -35,9 +35,11 @@
  * Author: Kofinas Miltiadis <mkofinas@gmail.com>
  *********************************************************************/
 
+#include <iostream>
 #include <string>
 #include <vector>
 
+#include "pandora_vision_victim/utilities/file_utilities.h"
 #include "pandora_vision_victim/utilities/principal_component_analysis.h"
 
 /**
@@ -65,6 +67,9 @@ namespace pandora_vision_victim
 
   void PrincipalComponentAnalysis::performPCA(const cv::Mat& featuresMat)
   {
+    // Loaded components refer to a read only file, so they are not reused.
+    pca_ = cv::PCA();
+    modelFile_.reset();
     pca_.computeVar(featuresMat, cv::Mat(), CV_PCA_DATA_AS_ROW, 0.95);
   }
 
@@ -76,20 +81,35 @@ namespace pandora_vision_victim
 
   void PrincipalComponentAnalysis::save(const std::string& fileName)
   {
-      cv::FileStorage fs(fileName, cv::FileStorage::WRITE);
-      fs << "mean" << pca_.mean;
-      fs << "eigenvectors" << pca_.eigenvectors;
-      fs << "eigenvalues" << pca_.eigenvalues;
-      fs.release();
+      std::vector<std::string> varNameVec;
+      varNameVec.push_back("mean");
+      varNameVec.push_back("eigenvectors");
+      varNameVec.push_back("eigenvalues");
+      std::vector<cv::Mat> dataVec;
+      dataVec.push_back(pca_.mean);
+      dataVec.push_back(pca_.eigenvectors);
+      dataVec.push_back(pca_.eigenvalues);
+      file_utilities::saveModelToFile(fileName, varNameVec, dataVec);
   }
 
   void PrincipalComponentAnalysis::load(const std::string& fileName)
   {
-      cv::FileStorage fs(fileName, cv::FileStorage::READ);
-      fs["mean"] >> pca_.mean;
-      fs["eigenvectors"] >> pca_.eigenvectors;
-      fs["eigenvalues"] >> pca_.eigenvalues;
-      fs.release();
+      std::vector<std::string> varNameVec;
+      varNameVec.push_back("mean");
+      varNameVec.push_back("eigenvectors");
+      varNameVec.push_back("eigenvalues");
+      std::vector<cv::Mat> dataVec;
+      boost::shared_ptr<BinaryModelFile> modelFile;
+      if (!file_utilities::loadModelFromFile(fileName, varNameVec, &dataVec,
+            &modelFile))
+      {
+        std::cout << fileName << " was not loaded successfully." << std::endl;
+        return;
+      }
+      pca_.mean = dataVec[0];
+      pca_.eigenvectors = dataVec[1];
+      pca_.eigenvalues = dataVec[2];
+      modelFile_ = modelFile;
   }
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
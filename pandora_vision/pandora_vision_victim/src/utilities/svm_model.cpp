@@ -0,0 +1,339 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *   Protopapas Marios <protopapas_marios@hotmail.com>
+ *********************************************************************/
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "pandora_vision_victim/utilities/file_utilities.h"
+#include "pandora_vision_victim/utilities/svm_model.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+namespace
+{
+  /**
+   * @brief The names of the matrices of a binary SVM model file. The
+   * parameters are the SVM type, the kernel type, degree, gamma, coef0, C,
+   * nu and p, and every decision function has a rho, a number of support
+   * vectors and one alpha and support vector index for each of them.
+   */
+  std::vector<std::string> modelMatrixNames()
+  {
+    std::vector<std::string> names;
+    names.push_back("svm_parameters");
+    names.push_back("class_labels");
+    names.push_back("support_vectors");
+    names.push_back("rho");
+    names.push_back("sv_count");
+    names.push_back("alpha");
+    names.push_back("sv_index");
+    return names;
+  }
+}  // namespace
+
+  /**
+   * @brief This function saves the model in a FileStorage file and, if it
+   * is a classifier over all the variables, in its binary counterpart.
+   * @param fileName [const std::string&] The name of the FileStorage file.
+   * @return void
+   */
+  void SvmModel::saveModel(const std::string& fileName) const
+  {
+    save(fileName.c_str());
+
+    // Regression and one class models, as well as models trained on a
+    // subset of the variables, are only kept in the FileStorage file.
+    if ((params.svm_type != C_SVC && params.svm_type != NU_SVC) ||
+        class_labels == NULL || var_idx != NULL || decision_func == NULL)
+      return;
+
+    const int classCount = class_labels->cols;
+    const int functionCount = classCount * (classCount - 1) / 2;
+    int alphaCount = 0;
+    for (int ii = 0; ii < functionCount; ii++)
+      alphaCount += decision_func[ii].sv_count;
+
+    cv::Mat parameters(1, 8, CV_64FC1);
+    double* parameter = parameters.ptr<double>(0);
+    parameter[0] = params.svm_type;
+    parameter[1] = params.kernel_type;
+    parameter[2] = params.degree;
+    parameter[3] = params.gamma;
+    parameter[4] = params.coef0;
+    parameter[5] = params.C;
+    parameter[6] = params.nu;
+    parameter[7] = params.p;
+
+    cv::Mat classLabels(1, classCount, CV_32SC1, class_labels->data.i);
+
+    cv::Mat supportVectors(sv_total, var_all, CV_32FC1);
+    for (int ii = 0; ii < sv_total; ii++)
+      std::copy(sv[ii], sv[ii] + var_all, supportVectors.ptr<float>(ii));
+
+    cv::Mat rho(1, functionCount, CV_64FC1);
+    cv::Mat svCount(1, functionCount, CV_32SC1);
+    cv::Mat alpha(1, alphaCount, CV_64FC1);
+    cv::Mat svIndex(1, alphaCount, CV_32SC1);
+    int offset = 0;
+    for (int ii = 0; ii < functionCount; ii++)
+    {
+      const CvSVMDecisionFunc& function = decision_func[ii];
+      rho.at<double>(ii) = function.rho;
+      svCount.at<int>(ii) = function.sv_count;
+      std::copy(function.alpha, function.alpha + function.sv_count,
+          alpha.ptr<double>(0) + offset);
+      std::copy(function.sv_index, function.sv_index + function.sv_count,
+          svIndex.ptr<int>(0) + offset);
+      offset += function.sv_count;
+    }
+
+    std::vector<cv::Mat> dataVec;
+    dataVec.push_back(parameters);
+    dataVec.push_back(classLabels);
+    dataVec.push_back(supportVectors);
+    dataVec.push_back(rho);
+    dataVec.push_back(svCount);
+    dataVec.push_back(alpha);
+    dataVec.push_back(svIndex);
+    BinaryModelFile::write(BinaryModelFile::binaryFileName(fileName),
+        modelMatrixNames(), dataVec);
+  }
+
+  /**
+   * @brief This function loads the model from the binary counterpart of a
+   * FileStorage file, if there is a recent one, and from the FileStorage
+   * file otherwise.
+   * @param fileName [const std::string&] The name of the FileStorage file.
+   * @return void
+   */
+  void SvmModel::loadModel(const std::string& fileName)
+  {
+    std::vector<cv::Mat> dataVec;
+    boost::shared_ptr<BinaryModelFile> modelFile;
+    if (file_utilities::loadModelFromBinaryFile(fileName, modelMatrixNames(),
+          &dataVec, &modelFile) && setModel(dataVec))
+    {
+      modelFile_ = modelFile;
+      return;
+    }
+    load(fileName.c_str());
+    modelFile_.reset();
+  }
+
+  /**
+   * @brief This function rebuilds the model from the matrices of a binary
+   * model file, the way CvSVM::read does from a FileStorage file.
+   * @param dataVec [const std::vector<cv::Mat>&] The matrices, in the order
+   * of the model's names.
+   * @return [bool] Variable indicating whether the matrices hold a valid
+   * model or not.
+   */
+  bool SvmModel::setModel(const std::vector<cv::Mat>& dataVec)
+  {
+    const cv::Mat& parameters = dataVec[0];
+    const cv::Mat& classLabels = dataVec[1];
+    const cv::Mat& supportVectors = dataVec[2];
+    const cv::Mat& rho = dataVec[3];
+    const cv::Mat& svCount = dataVec[4];
+    const cv::Mat& alpha = dataVec[5];
+    const cv::Mat& svIndex = dataVec[6];
+
+    if (parameters.type() != CV_64FC1 || parameters.total() != 8 ||
+        classLabels.type() != CV_32SC1 || classLabels.total() < 2 ||
+        supportVectors.type() != CV_32FC1 || rho.type() != CV_64FC1 ||
+        svCount.type() != CV_32SC1 || alpha.type() != CV_64FC1 ||
+        svIndex.type() != CV_32SC1)
+      return false;
+
+    const int classCount = classLabels.total();
+    const int functionCount = classCount * (classCount - 1) / 2;
+    if (rho.total() != static_cast<size_t>(functionCount) ||
+        svCount.total() != static_cast<size_t>(functionCount))
+      return false;
+    int alphaCount = 0;
+    for (int ii = 0; ii < functionCount; ii++)
+    {
+      if (svCount.at<int>(ii) <= 0)
+        return false;
+      alphaCount += svCount.at<int>(ii);
+    }
+    if (alpha.total() != static_cast<size_t>(alphaCount) ||
+        svIndex.total() != static_cast<size_t>(alphaCount))
+      return false;
+    for (int ii = 0; ii < alphaCount; ii++)
+      if (svIndex.at<int>(ii) < 0 || svIndex.at<int>(ii) >= supportVectors.rows)
+        return false;
+
+    clear();
+
+    const double* parameter = parameters.ptr<double>(0);
+    CvSVMParams svmParams;
+    svmParams.svm_type = cvRound(parameter[0]);
+    svmParams.kernel_type = cvRound(parameter[1]);
+    svmParams.degree = parameter[2];
+    svmParams.gamma = parameter[3];
+    svmParams.coef0 = parameter[4];
+    svmParams.C = parameter[5];
+    svmParams.nu = parameter[6];
+    svmParams.p = parameter[7];
+    params = svmParams;
+
+    var_all = supportVectors.cols;
+    sv_total = supportVectors.rows;
+    class_labels = cvCreateMat(1, classCount, CV_32SC1);
+    std::copy(classLabels.ptr<int>(0), classLabels.ptr<int>(0) + classCount,
+        class_labels->data.i);
+
+    // CvSVM::predict only reads the support vectors and the coefficients of
+    // the decision functions, so they are used in place. Only the arrays
+    // that CvSVM::clear releases are allocated.
+    int blockSize = std::max(1 << 16, sv_total * static_cast<int>(sizeof(sv[0])));
+    storage = cvCreateMemStorage(blockSize + sizeof(CvMemBlock) +
+        sizeof(CvSeqBlock));
+    sv = static_cast<float**>(cvMemStorageAlloc(storage,
+          sv_total * sizeof(sv[0])));
+    for (int ii = 0; ii < sv_total; ii++)
+      sv[ii] = const_cast<float*>(supportVectors.ptr<float>(ii));
+
+    decision_func = static_cast<CvSVMDecisionFunc*>(
+        cvAlloc(functionCount * sizeof(decision_func[0])));
+    int offset = 0;
+    for (int ii = 0; ii < functionCount; ii++)
+    {
+      CvSVMDecisionFunc& function = decision_func[ii];
+      function.rho = rho.at<double>(ii);
+      function.sv_count = svCount.at<int>(ii);
+      function.alpha = const_cast<double*>(alpha.ptr<double>(0)) + offset;
+      function.sv_index = const_cast<int*>(svIndex.ptr<int>(0)) + offset;
+      offset += function.sv_count;
+    }
+
+    create_kernel();
+    return true;
+  }
+
+  /**
+   * @brief This function computes the decision function value of each
+   * row of a set of feature vectors, and derives its class label from
+   * the sign of that value, the way CvSVM::predict does for two classes.
+   * The linear, polynomial and RBF kernels are evaluated for all the rows
+   * against all the support vectors with one matrix product; the other
+   * kernels and the models over a subset of the variables go through
+   * CvSVM::predict one row at a time.
+   * @param samples [const cv::Mat&] The feature vectors, one per row.
+   * @param classLabels [std::vector<float>*] The predicted class labels.
+   * @param decisionValues [cv::Mat*] The decision function values, a
+   * CV_64FC1 column.
+   * @return void
+   */
+  void SvmModel::predictDecisionValues(const cv::Mat& samples,
+      std::vector<float>* classLabels, cv::Mat* decisionValues) const
+  {
+    CV_Assert(class_labels != NULL && class_labels->cols == 2);
+
+    if (var_idx != NULL || (params.kernel_type != LINEAR &&
+          params.kernel_type != POLY && params.kernel_type != RBF))
+    {
+      decisionValues->create(samples.rows, 1, CV_64FC1);
+      for (int ii = 0; ii < samples.rows; ii++)
+        decisionValues->at<double>(ii) = predict(samples.row(ii), true);
+    }
+    else
+    {
+      CV_Assert(samples.cols == var_all);
+
+      cv::Mat sampleVectors;
+      samples.convertTo(sampleVectors, CV_64FC1);
+      cv::Mat supportVectors(sv_total, var_all, CV_64FC1);
+      for (int ii = 0; ii < sv_total; ii++)
+        std::copy(sv[ii], sv[ii] + var_all, supportVectors.ptr<double>(ii));
+
+      // The kernel matrix holds the kernel of every sample with every
+      // support vector, starting from their dot products.
+      cv::Mat kernel;
+      cv::gemm(sampleVectors, supportVectors, 1.0, cv::Mat(), 0.0, kernel,
+          cv::GEMM_2_T);
+      if (params.kernel_type == POLY)
+      {
+        kernel.convertTo(kernel, CV_64FC1, params.gamma, params.coef0);
+        cv::pow(kernel, params.degree, kernel);
+      }
+      else if (params.kernel_type == RBF)
+      {
+        // |x - y|^2 = |x|^2 + |y|^2 - 2 x.y
+        cv::Mat sampleNorms, supportVectorNorms;
+        cv::reduce(sampleVectors.mul(sampleVectors), sampleNorms, 1,
+            CV_REDUCE_SUM);
+        cv::reduce(supportVectors.mul(supportVectors), supportVectorNorms, 1,
+            CV_REDUCE_SUM);
+        for (int ii = 0; ii < kernel.rows; ii++)
+        {
+          double* row = kernel.ptr<double>(ii);
+          for (int jj = 0; jj < kernel.cols; jj++)
+            row[jj] = -params.gamma * (sampleNorms.at<double>(ii) +
+                supportVectorNorms.at<double>(jj) - 2.0 * row[jj]);
+        }
+        cv::exp(kernel, kernel);
+      }
+
+      // The coefficients of the decision function, scattered to the support
+      // vectors they belong to.
+      const CvSVMDecisionFunc& function = decision_func[0];
+      cv::Mat alpha = cv::Mat::zeros(sv_total, 1, CV_64FC1);
+      for (int ii = 0; ii < function.sv_count; ii++)
+        alpha.at<double>(function.sv_index[ii]) += function.alpha[ii];
+
+      cv::gemm(kernel, alpha, 1.0, cv::Mat(), 0.0, *decisionValues);
+      *decisionValues -= function.rho;
+    }
+
+    classLabels->resize(samples.rows);
+    for (int ii = 0; ii < samples.rows; ii++)
+    {
+      // CvSVM votes for its first class when the decision value is positive
+      // and for its second one otherwise.
+      (*classLabels)[ii] = static_cast<float>(
+          class_labels->data.i[decisionValues->at<double>(ii) > 0 ? 0 : 1]);
+    }
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
@@ -58,11 +58,7 @@ namespace pandora_vision_victim
     paramsPtr_.reset( new VictimParameters(processor_nh) );
     paramsPtr_->configVictim(processor_nh);
 
-    _debugVictimsPublisher = image_transport::ImageTransport(processor_nh).
-      advertise(paramsPtr_->victimDebugImg, 1, true);
-
-    interpolatedDepthPublisher_ = image_transport::ImageTransport(processor_nh).
-      advertise(paramsPtr_->interpolatedDepthImg, 1, true);
+    activate();
 
     std::string rgbClassifierType;
     if (!processor_nh.getParam("rgb_classifier", rgbClassifierType))
@@ -109,6 +105,33 @@ namespace pandora_vision_victim
   VictimHoleProcessor::VictimHoleProcessor() : sensor_processor::Processor<EnhancedImageStamped,
     POIsStamped>() {}
 
+  /**
+  @brief Advertises the debug images again when the handler makes the
+  processor a stage again
+  @return void
+  **/
+  void
+  VictimHoleProcessor::activate()
+  {
+    if (!_debugVictimsPublisher)
+      _debugVictimsPublisher = image_transport::ImageTransport(this->getProcessorNodeHandle()).
+        advertise(paramsPtr_->victimDebugImg, 1, true);
+    if (!interpolatedDepthPublisher_)
+      interpolatedDepthPublisher_ = image_transport::ImageTransport(this->getProcessorNodeHandle()).
+        advertise(paramsPtr_->interpolatedDepthImg, 1, true);
+  }
+
+  /**
+  @brief Unadvertises the debug images while the processor is parked
+  @return void
+  **/
+  void
+  VictimHoleProcessor::park()
+  {
+    _debugVictimsPublisher.shutdown();
+    interpolatedDepthPublisher_.shutdown();
+  }
+
   /**
   @brief This method check in which state we are, according to
   the information sent from hole_detector_node
@@ -135,6 +158,8 @@ namespace pandora_vision_victim
       rgbd_svm_p.clear();
     }
     DetectionImages imgs;
+    imgs.rgb.img = input->getRgbImage();
+    imgs.depth.img = input->getDepthImage();
     int stateIndicator = 2;  //  * input->getDepth() + (input->getRegions().size() > 0) + 1;
     DetectionMode detectionMode;
     switch (stateIndicator)
@@ -177,6 +202,7 @@ namespace pandora_vision_victim
 
       EnhancedMat emat;
       emat.img = input->getRgbImage()(rect);
+      emat.bounding_box = rect;
       emat.keypoint = cv::Point2f(input->getRegion(i).x, input->getRegion(i).y);
       imgs.rgbMasks.push_back(emat);
 
@@ -390,18 +416,27 @@ namespace pandora_vision_victim
     std::vector<VictimPOIPtr> depth_svm_probabilities;
     std::vector<VictimPOIPtr> rgbd_svm_probabilities;
 
-    float probability, classLabel;
+    // The regions of all the holes are classified with one call per
+    // validator, so that their features are extracted from the whole frame
+    // and are normalized and predicted together.
+    std::vector<cv::Rect> rgbRegions, depthRegions;
+    for (int i = 0 ; i < imgs.rgbMasks.size(); i++)
+      rgbRegions.push_back(imgs.rgbMasks[i].bounding_box);
+    for (int i = 0 ; i < imgs.depthMasks.size(); i++)
+      depthRegions.push_back(imgs.depthMasks[i].bounding_box);
+    std::vector<float> probabilities, classLabels;
 
     if (detectionMode == GOT_HOLES || detectionMode == GOT_HOLES_AND_DEPTH)  // || detectionMode == GOT_RGB
     {
-      for (int i = 0 ; i < imgs.rgbMasks.size(); i++)
+      rgbValidatorPtr_->calculatePredictionProbabilities(imgs.rgb.img, rgbRegions,
+          &classLabels, &probabilities);
+      for (int i = 0 ; i < classLabels.size(); i++)
       {
-        VictimPOIPtr temp(new VictimPOI);
-        rgbValidatorPtr_->calculatePredictionProbability(imgs.rgbMasks.at(i).img, &classLabel, &probability);
-        if (classLabel == 1)
+        if (classLabels[i] == 1)
         {
-          temp->setProbability(probability);
-          temp->setClassLabel(classLabel);
+          VictimPOIPtr temp(new VictimPOI);
+          temp->setProbability(probabilities[i]);
+          temp->setClassLabel(classLabels[i]);
           temp->setPoint(imgs.rgbMasks[i].keypoint);
           temp->setSource(RGB_SVM);
           temp->setWidth(imgs.rgbMasks[i].bounding_box.width);
@@ -416,14 +451,15 @@ namespace pandora_vision_victim
     {
       if (!paramsPtr_->rgbdEnabled)
       {
-        for (int i = 0 ; i < imgs.depthMasks.size(); i++)
+        depthValidatorPtr_->calculatePredictionProbabilities(imgs.depth.img,
+            depthRegions, &classLabels, &probabilities);
+        for (int i = 0 ; i < classLabels.size(); i++)
         {
-          VictimPOIPtr temp(new VictimPOI);
-          depthValidatorPtr_->calculatePredictionProbability(imgs.depthMasks.at(i).img, &classLabel, &probability);
-          if (classLabel == 1)
+          if (classLabels[i] == 1)
           {
-            temp->setProbability(probability);
-            temp->setClassLabel(classLabel);
+            VictimPOIPtr temp(new VictimPOI);
+            temp->setProbability(probabilities[i]);
+            temp->setClassLabel(classLabels[i]);
             temp->setPoint(imgs.depthMasks[i].keypoint);
             temp->setSource(DEPTH_SVM);
             temp->setWidth(imgs.depthMasks[i].bounding_box.width);
@@ -437,16 +473,15 @@ namespace pandora_vision_victim
       {
         if (imgs.depthMasks.size() == imgs.rgbMasks.size())
         {
-          for (int i = 0 ; i < imgs.depthMasks.size(); i++)
+          rgbdValidatorPtr_->calculatePredictionProbabilities(imgs.rgb.img,
+              imgs.depth.img, depthRegions, &classLabels, &probabilities);
+          for (int i = 0 ; i < classLabels.size(); i++)
           {
-            VictimPOIPtr temp(new VictimPOI);
-            rgbdValidatorPtr_->calculatePredictionProbability(imgs.rgbMasks.at(i).img,
-                                                            imgs.depthMasks.at(i).img,
-                                                            &classLabel, &probability);
-            if (classLabel == 1)
+            if (classLabels[i] == 1)
             {
-              temp->setProbability(probability);
-              temp->setClassLabel(classLabel);
+              VictimPOIPtr temp(new VictimPOI);
+              temp->setProbability(probabilities[i]);
+              temp->setClassLabel(classLabels[i]);
               temp->setPoint(imgs.depthMasks[i].keypoint);
               temp->setSource(RGBD_SVM);
               temp->setWidth(imgs.depthMasks[i].bounding_box.width);
@@ -0,0 +1,143 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *********************************************************************/
+
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "gtest/gtest.h"
+
+#include "pandora_vision_victim/feature_extractors/channels_statistics_extractor.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+    @class ChannelsStatisticsExtractorTest
+    @brief Tests the integrity of methods of class ChannelsStatisticsExtractor
+   **/
+  class ChannelsStatisticsExtractorTest : public ::testing::Test
+  {
+    protected:
+      ChannelsStatisticsExtractorTest() {}
+
+      /// Fills the frames with noise and picks regions of them, including
+      /// ones on the borders of the frames
+      virtual void SetUp()
+      {
+        cv::RNG rng(12345);
+        rgbFrame.create(120, 160, CV_8UC3);
+        rng.fill(rgbFrame, cv::RNG::UNIFORM, 0, 256);
+        depthFrame.create(120, 160, CV_8UC1);
+        rng.fill(depthFrame, cv::RNG::UNIFORM, 0, 256);
+
+        regions.push_back(cv::Rect(0, 0, 160, 120));
+        regions.push_back(cv::Rect(0, 0, 31, 17));
+        regions.push_back(cv::Rect(40, 25, 64, 48));
+        regions.push_back(cv::Rect(129, 90, 31, 30));
+        regions.push_back(cv::Rect(75, 60, 3, 5));
+      }
+
+      /// Checks that the features of the regions of a frame are those of
+      /// the cropped regions
+      void expectEqualFeatures(const std::vector<double>& croppedFeatures,
+          const std::vector<double>& regionFeatures)
+      {
+        ASSERT_EQ(croppedFeatures.size(), regionFeatures.size());
+        for (int ii = 0; ii < croppedFeatures.size(); ii++)
+          EXPECT_NEAR(croppedFeatures[ii], regionFeatures[ii], 1e-6);
+      }
+
+      /// The frames the regions are taken from
+      cv::Mat rgbFrame, depthFrame;
+
+      /// The regions of the frames
+      std::vector<cv::Rect> regions;
+  };
+
+  /// Tests ChannelsStatisticsFrame::meanStdDev
+  TEST_F(ChannelsStatisticsExtractorTest, meanStdDev)
+  {
+    ChannelsStatisticsFrame frame;
+    frame.setDepthFrame(depthFrame);
+    for (int ii = 0; ii < regions.size(); ii++)
+    {
+      cv::Mat region = depthFrame(regions[ii]);
+      std::vector<double> expected = MeanStdDevExtractor(&region).extract();
+      expectEqualFeatures(expected, frame.meanStdDev(0, regions[ii]));
+    }
+  }
+
+  /// Tests that the color statistics of the regions of a frame match the
+  /// color statistics of the cropped regions
+  TEST_F(ChannelsStatisticsExtractorTest, findColorChannelsStatisticsFeatures)
+  {
+    ChannelsStatisticsFrame frame;
+    frame.setColorFrame(rgbFrame);
+    for (int ii = 0; ii < regions.size(); ii++)
+    {
+      std::vector<double> croppedFeatures, regionFeatures;
+      ChannelsStatisticsExtractor::findColorChannelsStatisticsFeatures(
+          rgbFrame(regions[ii]), &croppedFeatures);
+      ChannelsStatisticsExtractor::findColorChannelsStatisticsFeatures(
+          frame, regions[ii], &regionFeatures);
+      EXPECT_EQ(28, regionFeatures.size());
+      expectEqualFeatures(croppedFeatures, regionFeatures);
+    }
+  }
+
+  /// Tests that the depth statistics of the regions of a frame match the
+  /// depth statistics of the cropped regions
+  TEST_F(ChannelsStatisticsExtractorTest, findDepthChannelsStatisticsFeatures)
+  {
+    ChannelsStatisticsFrame frame;
+    frame.setDepthFrame(depthFrame);
+    for (int ii = 0; ii < regions.size(); ii++)
+    {
+      std::vector<double> croppedFeatures, regionFeatures;
+      ChannelsStatisticsExtractor::findDepthChannelsStatisticsFeatures(
+          depthFrame(regions[ii]), &croppedFeatures);
+      ChannelsStatisticsExtractor::findDepthChannelsStatisticsFeatures(
+          frame, regions[ii], &regionFeatures);
+      EXPECT_EQ(10, regionFeatures.size());
+      expectEqualFeatures(croppedFeatures, regionFeatures);
+    }
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
@@ -266,6 +266,38 @@ namespace pandora_vision_victim
     EXPECT_EQ(0, out[4]);
   }
 
+  /// Tests that the subblocks' histograms partition the whole image's one
+  TEST_F(EdgeOrientationExtractorTest, PartitionedCircle)
+  {
+    std::vector<double> whole;
+    EdgeOrientationExtractor::findLocalEdgeFeatures(circle, &whole);
+    ASSERT_EQ(5, whole.size());
+
+    std::vector<double> blocks;
+    EdgeOrientationExtractor::partition(circle, WIDTH / 4, HEIGHT / 4, &blocks);
+    ASSERT_EQ(80, blocks.size());
+
+    double blockArea = (WIDTH / 4) * (HEIGHT / 4);
+    for (int ii = 0; ii < 5; ii++)
+    {
+      double edges = 0;
+      for (int jj = 0; jj < 16; jj++)
+        edges += blocks[jj * 5 + ii] * blockArea;
+      EXPECT_NEAR(whole[ii] * HEIGHT * WIDTH, edges, 1e-6);
+    }
+
+    // The circle is centered, so its edges lie in the four middle subblocks
+    for (int jj = 0; jj < 16; jj++)
+    {
+      int col = jj / 4;
+      int row = jj % 4;
+      if ((col == 1 || col == 2) && (row == 1 || row == 2))
+        continue;
+      for (int ii = 0; ii < 5; ii++)
+        EXPECT_EQ(0, blocks[jj * 5 + ii]);
+    }
+  }
+
   /*
   TEST_F ( EdgeOrientationExtractorTest, CurvedEdges)
   {
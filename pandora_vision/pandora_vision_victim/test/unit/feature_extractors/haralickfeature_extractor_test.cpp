@@ -35,6 +35,9 @@
  * Author: Marios Protopapas
  *********************************************************************/
 
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -175,5 +178,64 @@ namespace pandora_vision_victim
     EXPECT_EQ(sum, out);
   }
 
+  /// Tests that the fused statistics of the co-occurrence counts agree with
+  /// the statistics of the normalized GLCM matrices
+  TEST_F(HaralickFeaturesExtractorTest, fusedStatistics)
+  {
+    // A textured image: a gradient, stripes and noise
+    cv::Mat image = cv::Mat::zeros(37, 53, CV_8U);
+    std::srand(7);
+    for (int y = 0; y < image.rows; y++)
+      for (int x = 0; x < image.cols; x++)
+        image.at<uchar>(y, x) = (3 * x + 5 * y + ((x / 4) % 2) * 60
+            + std::rand() % 40) % 256;
+
+    HaralickFeaturesExtractor::GLCMCounts glcm;
+    HaralickFeaturesExtractor::calculateGLCMCounts(image, &glcm);
+
+    const int xOffset[4] = {0, 1, 1, 1};
+    const int yOffset[4] = {1, 0, 1, -1};
+
+    for (int ii = 0; ii < HaralickFeaturesExtractor::NUM_DIRECTIONS; ii++)
+    {
+      cv::Mat out = HaralickFeaturesExtractor::calculateGLCM(xOffset[ii],
+          yOffset[ii], image);
+
+      // The counts, normalized, are the GLCM matrix
+      for (int y = 0; y < out.rows; y++)
+        for (int x = 0; x < out.cols; x++)
+          ASSERT_NEAR(out.at<double>(y, x),
+              glcm.counts[ii][y * 256 + x] /
+              static_cast<double>(glcm.total[ii]), 1e-12);
+
+      double expected[HaralickFeaturesExtractor::NUM_HARALICK_FEATURES];
+      expected[0] = HaralickFeaturesExtractor::getAngularSecondMoment(out);
+      expected[1] = HaralickFeaturesExtractor::getContrast(out);
+      expected[2] = HaralickFeaturesExtractor::getEntropy(out);
+      expected[3] = HaralickFeaturesExtractor::getVariance(out);
+      expected[4] = HaralickFeaturesExtractor::getCorrelation(out);
+      expected[5] = HaralickFeaturesExtractor::getHomogeneity(out);
+      expected[6] = HaralickFeaturesExtractor::getSumAverage(out);
+      expected[7] = HaralickFeaturesExtractor::getSumVariance(out,
+          expected[6]);
+      expected[8] = HaralickFeaturesExtractor::getSumEntropy(out);
+      expected[9] = HaralickFeaturesExtractor::getDifferenceVariance(out);
+      expected[10] = HaralickFeaturesExtractor::getDifferenceEntropy(out);
+      HaralickFeaturesExtractor::getInfoMeasuresCorr(out, &expected[11],
+          &expected[12]);
+
+      double features[HaralickFeaturesExtractor::NUM_HARALICK_FEATURES];
+      HaralickFeaturesExtractor::getHaralickStatistics(glcm, ii, features);
+
+      for (int jj = 0; jj < HaralickFeaturesExtractor::NUM_HARALICK_FEATURES;
+          jj++)
+      {
+        EXPECT_NEAR(expected[jj], features[jj],
+            1e-9 * std::max(1.0, std::fabs(expected[jj])))
+          << "direction " << ii << ", feature " << jj;
+      }
+    }
+  }
+
 }  // namespace pandora_vision_victim
 }  // namespace pandora_vision
@@ -0,0 +1,144 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *********************************************************************/
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <opencv2/opencv.hpp>
+
+#include "gtest/gtest.h"
+
+#include "pandora_vision_victim/utilities/binary_model_file.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+    @class BinaryModelFileTest
+    @brief Tests the integrity of methods of class BinaryModelFile
+   **/
+  class BinaryModelFileTest : public ::testing::Test
+  {
+    protected:
+      BinaryModelFileTest() {}
+
+      /// Picks a model file that does not exist yet and fills the matrices
+      virtual void SetUp()
+      {
+        fileName = (boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path("binary_model_%%%%%%%%.bin")).string();
+
+        names.push_back("mean");
+        matrices.push_back(cv::Mat(1, 3, CV_32FC1));
+        for (int jj = 0; jj < 3; jj++)
+          matrices[0].at<float>(0, jj) = jj / 4.0f;
+
+        names.push_back("eigenvectors");
+        matrices.push_back(cv::Mat(3, 2, CV_64FC1));
+        for (int ii = 0; ii < 3; ii++)
+          for (int jj = 0; jj < 2; jj++)
+            matrices[1].at<double>(ii, jj) = ii * 10.0 + jj / 3.0;
+
+        names.push_back("labels");
+        matrices.push_back(cv::Mat(5, 1, CV_8UC1));
+        for (int ii = 0; ii < 5; ii++)
+          matrices[2].at<unsigned char>(ii, 0) = ii;
+      }
+
+      virtual void TearDown()
+      {
+        std::remove(fileName.c_str());
+      }
+
+      std::string fileName;
+      std::vector<std::string> names;
+      std::vector<cv::Mat> matrices;
+  };
+
+  TEST_F(BinaryModelFileTest, binaryFileName)
+  {
+    EXPECT_EQ("/data/rgb_svm_pca_parameters.bin",
+        BinaryModelFile::binaryFileName("/data/rgb_svm_pca_parameters.xml"));
+    EXPECT_EQ("/data/rgb_bag_of_words.bin",
+        BinaryModelFile::binaryFileName("/data/rgb_bag_of_words.bin"));
+  }
+
+  TEST_F(BinaryModelFileTest, savedMatricesAreLoaded)
+  {
+    ASSERT_TRUE(BinaryModelFile::write(fileName, names, matrices));
+    EXPECT_TRUE(BinaryModelFile::isBinaryModelFile(fileName));
+
+    BinaryModelFile modelFile(fileName);
+    ASSERT_TRUE(modelFile.isOpen());
+    EXPECT_TRUE(modelFile.matrix("std_dev").empty());
+    for (int kk = 0; kk < names.size(); kk++)
+    {
+      cv::Mat loaded = modelFile.matrix(names[kk]);
+      ASSERT_EQ(matrices[kk].type(), loaded.type());
+      ASSERT_EQ(matrices[kk].rows, loaded.rows);
+      ASSERT_EQ(matrices[kk].cols, loaded.cols);
+      // Matrices are used in place, aligned for their elements
+      EXPECT_EQ(0u, reinterpret_cast<size_t>(loaded.data) % 8);
+      const size_t rowSize = loaded.cols * loaded.elemSize();
+      for (int ii = 0; ii < loaded.rows; ii++)
+        EXPECT_EQ(0, std::memcmp(matrices[kk].ptr(ii), loaded.ptr(ii), rowSize));
+    }
+  }
+
+  TEST_F(BinaryModelFileTest, otherFilesAreRejected)
+  {
+    {
+      std::ofstream out(fileName.c_str());
+      out << "%YAML:1.0\nmean: 1\n";
+    }
+    EXPECT_FALSE(BinaryModelFile::isBinaryModelFile(fileName));
+    EXPECT_FALSE(BinaryModelFile(fileName).isOpen());
+
+    ASSERT_TRUE(BinaryModelFile::write(fileName, names, matrices));
+    boost::filesystem::resize_file(fileName,
+        boost::filesystem::file_size(fileName) - 8);
+    EXPECT_TRUE(BinaryModelFile::isBinaryModelFile(fileName));
+    EXPECT_FALSE(BinaryModelFile(fileName).isOpen());
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
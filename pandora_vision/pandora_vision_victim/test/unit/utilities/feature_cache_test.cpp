@@ -0,0 +1,148 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *********************************************************************/
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "gtest/gtest.h"
+
+#include "pandora_vision_victim/utilities/feature_cache.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+    @class FeatureCacheTest
+    @brief Tests the integrity of methods of class FeatureCache
+   **/
+  class FeatureCacheTest : public ::testing::Test
+  {
+    protected:
+      FeatureCacheTest() {}
+
+      /// Picks a cache file that does not exist yet
+      virtual void SetUp()
+      {
+        fileName = (boost::filesystem::temp_directory_path() /
+            boost::filesystem::unique_path("feature_cache_%%%%%%%%.bin")).string();
+
+        for (int ii = 0; ii < 3; ii++)
+        {
+          features.push_back(std::vector<double>());
+          for (int jj = 0; jj < 5; jj++)
+            features[ii].push_back(ii * 10.0 + jj / 4.0);
+        }
+      }
+
+      virtual void TearDown()
+      {
+        std::remove(fileName.c_str());
+      }
+
+      std::string fileName;
+      std::vector<std::vector<double> > features;
+  };
+
+  TEST_F(FeatureCacheTest, hashContinues)
+  {
+    const char data[] = "feature cache";
+    uint64_t whole = FeatureCache::hash(data, sizeof(data));
+    uint64_t parts = FeatureCache::hash(data + 7, sizeof(data) - 7,
+        FeatureCache::hash(data, 7));
+    EXPECT_EQ(whole, parts);
+    EXPECT_NE(whole, FeatureCache::hash(data, sizeof(data) - 1));
+  }
+
+  TEST_F(FeatureCacheTest, savedVectorsAreFound)
+  {
+    {
+      FeatureCache cache(fileName, 42, 5);
+      EXPECT_EQ(0, cache.size());
+      cache.insert(1, features[0]);
+      cache.insert(2, features[1]);
+      // Vectors of the wrong size are not stored
+      cache.insert(3, std::vector<double>(4, 1.0));
+
+      double values[5];
+      // Inserted vectors are found only after they are saved
+      EXPECT_FALSE(cache.find(1, values));
+      ASSERT_TRUE(cache.save());
+      EXPECT_EQ(2, cache.size());
+      EXPECT_TRUE(cache.find(1, values));
+    }
+
+    FeatureCache cache(fileName, 42, 5);
+    ASSERT_EQ(2, cache.size());
+    cache.insert(2, features[1]);
+    cache.insert(4, features[2]);
+    ASSERT_TRUE(cache.save());
+    ASSERT_EQ(3, cache.size());
+
+    double values[5];
+    EXPECT_FALSE(cache.find(3, values));
+    const uint64_t keys[3] = {1, 2, 4};
+    for (int ii = 0; ii < 3; ii++)
+    {
+      ASSERT_TRUE(cache.find(keys[ii], values));
+      for (int jj = 0; jj < 5; jj++)
+        EXPECT_EQ(features[ii][jj], values[jj]);
+    }
+  }
+
+  TEST_F(FeatureCacheTest, otherConfigurationIsIgnored)
+  {
+    {
+      FeatureCache cache(fileName, 42, 5);
+      cache.insert(1, features[0]);
+      ASSERT_TRUE(cache.save());
+    }
+
+    double values[5];
+    FeatureCache otherKey(fileName, 43, 5);
+    EXPECT_EQ(0, otherKey.size());
+    EXPECT_FALSE(otherKey.find(1, values));
+
+    FeatureCache otherSize(fileName, 42, 4);
+    EXPECT_EQ(0, otherSize.size());
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision
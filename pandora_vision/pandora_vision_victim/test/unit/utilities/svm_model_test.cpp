@@ -0,0 +1,146 @@
+/*********************************************************************
+ *
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2015, P.A.N.D.O.R.A. Team.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the P.A.N.D.O.R.A. Team nor the names of its
+ *     contributors may be used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *
+ * Authors:
+ *   Kofinas Miltiadis <mkofinas@gmail.com>
+ *********************************************************************/
+
+#include <cmath>
+#include <vector>
+
+#include <opencv2/opencv.hpp>
+
+#include "gtest/gtest.h"
+
+#include "pandora_vision_victim/utilities/svm_model.h"
+
+namespace pandora_vision
+{
+namespace pandora_vision_victim
+{
+  /**
+    @class SvmModelTest
+    @brief Tests the integrity of methods of class SvmModel
+   **/
+  class SvmModelTest : public ::testing::Test
+  {
+    protected:
+      SvmModelTest() {}
+
+      /// Draws two overlapping clusters of feature vectors, one per class,
+      /// and the feature vectors to be predicted
+      virtual void SetUp()
+      {
+        cv::RNG rng(12345);
+        trainingData.create(200, 5, CV_32FC1);
+        trainingLabels.create(200, 1, CV_32FC1);
+        for (int ii = 0; ii < trainingData.rows; ii++)
+        {
+          float label = ii % 2 ? 1.0f : -1.0f;
+          trainingLabels.at<float>(ii) = label;
+          for (int jj = 0; jj < trainingData.cols; jj++)
+            trainingData.at<float>(ii, jj) = 0.4f * label + rng.gaussian(0.5);
+        }
+
+        samples.create(50, 5, CV_32FC1);
+        rng.fill(samples, cv::RNG::UNIFORM, -1.5, 1.5);
+      }
+
+      /// Trains a model with a kernel and checks that its decision values
+      /// and class labels for all the samples at once are those of
+      /// CvSVM::predict for each sample on its own
+      void checkBatchPrediction(int kernelType)
+      {
+        CvSVMParams params;
+        params.svm_type = CvSVM::C_SVC;
+        params.kernel_type = kernelType;
+        params.degree = 2;
+        params.gamma = 0.3;
+        params.coef0 = 0.5;
+        params.C = 1;
+        params.term_crit = cvTermCriteria(CV_TERMCRIT_ITER + CV_TERMCRIT_EPS,
+            1000, 1e-6);
+        SvmModel model;
+        ASSERT_TRUE(model.train(trainingData, trainingLabels, cv::Mat(),
+              cv::Mat(), params));
+
+        std::vector<float> classLabels;
+        cv::Mat decisionValues;
+        model.predictDecisionValues(samples, &classLabels, &decisionValues);
+
+        ASSERT_EQ(samples.rows, decisionValues.rows);
+        ASSERT_EQ(samples.rows, classLabels.size());
+        for (int ii = 0; ii < samples.rows; ii++)
+        {
+          float decisionValue = model.predict(samples.row(ii), true);
+          EXPECT_NEAR(decisionValue, decisionValues.at<double>(ii),
+              1e-4 * (1.0 + std::fabs(decisionValue)));
+          if (std::fabs(decisionValue) > 1e-3)
+            EXPECT_EQ(model.predict(samples.row(ii)), classLabels[ii]);
+        }
+      }
+
+      /// The feature vectors and the class labels the models are trained on
+      cv::Mat trainingData, trainingLabels;
+
+      /// The feature vectors to be predicted
+      cv::Mat samples;
+  };
+
+  /// Tests SvmModel::predictDecisionValues with a linear kernel
+  TEST_F(SvmModelTest, predictDecisionValuesLinear)
+  {
+    checkBatchPrediction(CvSVM::LINEAR);
+  }
+
+  /// Tests SvmModel::predictDecisionValues with a polynomial kernel
+  TEST_F(SvmModelTest, predictDecisionValuesPoly)
+  {
+    checkBatchPrediction(CvSVM::POLY);
+  }
+
+  /// Tests SvmModel::predictDecisionValues with an RBF kernel
+  TEST_F(SvmModelTest, predictDecisionValuesRbf)
+  {
+    checkBatchPrediction(CvSVM::RBF);
+  }
+
+  /// Tests SvmModel::predictDecisionValues with a sigmoid kernel, which is
+  /// predicted one row at a time
+  TEST_F(SvmModelTest, predictDecisionValuesSigmoid)
+  {
+    checkBatchPrediction(CvSVM::SIGMOID);
+  }
+}  // namespace pandora_vision_victim
+}  // namespace pandora_vision